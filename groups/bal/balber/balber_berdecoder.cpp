@@ -43,6 +43,7 @@ BerDecoder::BerDecoder(const BerDecoderOptions *options,
 , d_currentDepth             (0)
 , d_numUnknownElementsSkipped(0)
 , d_topNode                  (0)
+, d_isSeekable               (false)
 {
 }
 
@@ -271,11 +272,25 @@ int BerDecoder_Node::skipField()
 
     if (BerUtil::e_INDEFINITE_LENGTH != d_expectedLength ) {
 
-        // We would do this, but not every streambuf is seekable:
-        //..
-        //  d_decoder->d_streamBuf->pubseekoff(d_expectedLength,
-        //                                     bsl::ios_base::cur,
-        //..                                   bsl::ios_base::in);
+        if (d_decoder->d_isSeekable) {
+            // The input is contiguous memory, so the contents can be skipped
+            // without being read.  Note that the seek fails, leaving the
+            // position unchanged, if it would pass the end of the input.
+
+            if (bsl::streambuf::pos_type(-1) ==
+                   d_decoder->d_streamBuf->pubseekoff(d_expectedLength,
+                                                      bsl::ios_base::cur,
+                                                      bsl::ios_base::in)) {
+                return logError("Error reading stream while skipping field");
+                                                                      // RETURN
+            }
+
+            d_consumedBodyBytes += d_expectedLength;
+
+            return BerDecoder::e_BER_SUCCESS;                         // RETURN
+        }
+
+        // Not every streambuf is seekable, so read and discard the contents.
 
         char buffer[1024];
         int  remainLength = d_expectedLength;
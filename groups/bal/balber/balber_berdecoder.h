@@ -20,19 +20,73 @@ BSLS_IDENT("$Id: $")
 //@CLASSES:
 //  balber::BerDecoder: BER decoder
 //
-//@SEE_ALSO: balber_berencoder, bdem_bdemdecoder, balxml_decoder
+//@SEE_ALSO: balber_berencoder, balber_berelementindex, balxml_decoder
 //
 //@DESCRIPTION: This component defines a single class, 'balber::BerDecoder',
 // that contains a parameterized 'decode' function.  The 'decode' function
 // decodes data read from a specified stream and loads the corresponding object
 // to an object of the parameterized type.  The 'decode' method is overloaded
-// for two types of input streams:
+// for three types of input:
 //: o 'bsl::streambuf'
 //: o 'bsl::istream'
+//: o a contiguous buffer, specified by address and length
 //
 // This class decodes objects based on the X.690 BER specification and is
 // restricted to types supported by the 'bdlat' framework.
 //
+///Decoding From Contiguous Memory
+///-------------------------------
+// The decoder reads identifier octets, length octets, and the contents of
+// primitive values one octet at a time using 'bsl::streambuf::sbumpc' and
+// 'sgetc'.  These functions are inline and operate directly on the get area
+// of the stream buffer; a virtual function ('underflow' or 'uflow') is called
+// only when the get area is exhausted.  Bulk reads (e.g., of strings) use
+// 'sgetn', which makes a single virtual call per value.  Consequently, the
+// cost of reading from a stream buffer depends mostly on how often its get
+// area must be refilled: a stream buffer that exposes its entire input as a
+// single get area is read by pointer arithmetic alone, whereas one that
+// supplies its input in small segments (for example, a 'btlb::Blob' having
+// small buffers) pays a virtual call at the end of each segment.
+//
+// When the input is already in a contiguous buffer, the 'decode' overload
+// taking the address and length of that buffer should be used.  It exposes
+// the whole buffer as a single get area, so that no virtual call is made
+// except for bulk reads, and, because the input is known to be seekable, it
+// also skips unknown elements having a definite length by repositioning the
+// input rather than by copying their contents into a scratch buffer.  Input
+// held in a 'btlb::Blob' whose data spans multiple buffers continues to be
+// decoded through 'btlb::InBlobStreamBuf'.
+//
+///Decoding Selected Attributes
+///----------------------------
+// A client that needs only a few attributes of a large sequence can avoid
+// decoding the rest of it.  The 'decodeAttribute' method decodes a single
+// element, nested directly in an encoded sequence, into the corresponding
+// attribute of a sequence object, leaving the other attributes of that object
+// unchanged.  The location of each such element is found, without decoding
+// any contents, using a 'balber::BerElementIndex' (see
+// 'balber_berelementindex').  For example, given a 'bsl::vector<char>',
+// 'data', holding the encoding of a 'usage::EmployeeRecord' in which the
+// 'age' attribute has the id 1:
+//..
+//  balber::BerElementIndex index;
+//  int rc = index.load(&data[0], data.size());
+//  assert(0 == rc);
+//
+//  const int i = index.find(1);
+//  assert(0 <= i);
+//
+//  usage::EmployeeRecord obj;
+//  balber::BerDecoder    decoder;
+//  rc = decoder.decodeAttribute(index.buffer() + index.child(i).offset(),
+//                               index.child(i).length(),
+//                               &obj,
+//                               1);
+//  assert(0 == rc);
+//..
+// Indexing is cheapest for encodings that use definite lengths, in which each
+// element, however large, is stepped over in constant time.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -157,6 +211,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlb_variant.h>
 #endif
 
+#ifndef INCLUDED_BDLSB_FIXEDMEMINSTREAMBUF
+#include <bdlsb_fixedmeminstreambuf.h>
+#endif
+
 #ifndef INCLUDED_BDLSB_MEMOUTSTREAMBUF
 #include <bdlsb_memoutstreambuf.h>
 #endif
@@ -270,6 +328,10 @@ class BerDecoder {
 
     BerDecoder_Node                 *d_topNode;      // last node
 
+    bool                             d_isSeekable;   // 'true' if the input
+                                                     // is known to support
+                                                     // relative seeking
+
     // NOT IMPLEMENTED
     BerDecoder(const BerDecoder&);             // = delete;
     BerDecoder& operator=(const BerDecoder&);  // = delete;
@@ -293,6 +355,12 @@ class BerDecoder {
         // Return the stream used for logging.  If stream has not been created
         // yet, it will be created during this call.
 
+    template <typename TYPE>
+    int decodeAttributeImp(TYPE *sequence, int attributeId);
+        // Decode the element at the current position of the input into the
+        // attribute having the specified 'attributeId' of the specified
+        // 'sequence'.  Return 0 on success, and a non-zero value otherwise.
+
   public:
     // CREATORS
     BerDecoder(const BerDecoderOptions *options = 0,
@@ -321,6 +389,33 @@ class BerDecoder {
         // Return 0 on success, and a non-zero value otherwise.  If the
         // decoding fails 'stream' will be invalidated.
 
+    template <typename TYPE>
+    int decode(const char *buffer, bsl::size_t length, TYPE *variable);
+        // Decode an object of parameterized 'TYPE' from the specified
+        // 'buffer' of the specified 'length' and load the result into the
+        // specified 'variable'.  Return 0 on success, and a non-zero value
+        // otherwise.  The behavior is undefined unless 'buffer' refers to at
+        // least 'length' contiguous bytes.  Note that the octets following
+        // the encoded object, if any, are not examined.  See
+        // {Decoding From Contiguous Memory}.
+
+    template <typename TYPE>
+    int decodeAttribute(const char  *buffer,
+                        bsl::size_t  length,
+                        TYPE        *sequence,
+                        int          attributeId);
+        // Decode the single BER element at the start of the specified
+        // 'buffer' of the specified 'length' into the attribute having the
+        // specified 'attributeId' of the specified 'sequence', after first
+        // resetting that attribute to its default value.  The element must
+        // have a context-specific tag whose number is 'attributeId', as do
+        // the elements nested in an encoded sequence.  The other attributes
+        // of 'sequence' are not modified.  Return 0 on success, and a
+        // non-zero value otherwise.  The behavior is undefined unless 'buffer'
+        // refers to at least 'length' contiguous bytes and the parameterized
+        // 'TYPE' is a 'bdlat' sequence type.  See
+        // {Decoding Selected Attributes}.
+
     void setNumUnknownElementsSkipped(int value);
         // Set the number of unknown elements skipped by the decoder during the
         // current decoding operation to the specified 'value'.  The behavior
@@ -570,6 +665,24 @@ class BerDecoder_UniversalElementVisitor {
     int operator()(TYPE *variable);
 };
 
+                     // ==================================
+                     // class BerDecoder_AttributeResetter
+                     // ==================================
+
+class BerDecoder_AttributeResetter {
+    // This class is a manipulator that resets the attribute of a sequence to
+    // which it is applied to its default value.
+
+  public:
+    // MANIPULATORS
+    template <typename TYPE, typename INFO>
+    int operator()(TYPE *attribute, const INFO&) const
+    {
+        bdlat_ValueTypeFunctions::reset(attribute);
+        return 0;
+    }
+};
+
                           // =======================
                           // class BerDecoder_Zeroer
                           // =======================
@@ -676,6 +789,96 @@ int BerDecoder::decode(bsl::istream& stream, TYPE *variable)
     return 0;
 }
 
+template <typename TYPE>
+int BerDecoder::decode(const char *buffer, bsl::size_t length, TYPE *variable)
+{
+    BSLS_ASSERT(buffer || 0 == length);
+
+    bdlsb::FixedMemInStreamBuf streamBuf(buffer, length);
+
+    d_isSeekable = true;
+    const int rc = this->decode(&streamBuf, variable);
+    d_isSeekable = false;
+
+    return rc;
+}
+
+template <typename TYPE>
+int BerDecoder::decodeAttribute(const char  *buffer,
+                                bsl::size_t  length,
+                                TYPE        *sequence,
+                                int          attributeId)
+{
+    BSLS_ASSERT(buffer || 0 == length);
+    BSLS_ASSERT(sequence);
+    BSLS_ASSERT(0 == d_streamBuf);
+
+    bdlsb::FixedMemInStreamBuf streamBuf(buffer, length);
+
+    d_streamBuf                 = &streamBuf;
+    d_isSeekable                = true;
+    d_currentDepth              = 0;
+    d_severity                  = e_BER_SUCCESS;
+    d_numUnknownElementsSkipped = 0;
+
+    if (d_logStream != 0) {
+        d_logStream->reset();
+    }
+
+    d_topNode = 0;
+
+    int rc;
+
+    if (! d_options) {
+        // Create temporary options object
+        BerDecoderOptions options; d_options = &options;
+        BerDecoder_Zeroer zeroer(&d_options);
+        rc = decodeAttributeImp(sequence, attributeId);
+    }
+    else {
+        rc = decodeAttributeImp(sequence, attributeId);
+    }
+
+    d_streamBuf  = 0;
+    d_isSeekable = false;
+    return rc;
+}
+
+template <typename TYPE>
+int BerDecoder::decodeAttributeImp(TYPE *sequence, int attributeId)
+{
+    BerDecoder_Node node(this);
+
+    int rc = node.readTagHeader();
+    if (rc != e_BER_SUCCESS) {
+        return rc;  // error message is already logged
+    }
+
+    if (node.tagClass() != BerConstants::e_CONTEXT_SPECIFIC) {
+        return node.logError("Expected CONTEXT tag class for attribute");
+    }
+
+    if (node.tagNumber() != attributeId
+     || !bdlat_SequenceFunctions::hasAttribute(*sequence, attributeId)) {
+        return node.logError("Unexpected tag number for attribute");
+    }
+
+    BerDecoder_AttributeResetter resetter;
+    bdlat_SequenceFunctions::manipulateAttribute(sequence,
+                                                 resetter,
+                                                 attributeId);
+
+    BerDecoder_NodeVisitor visitor(&node);
+    rc = bdlat_SequenceFunctions::manipulateAttribute(sequence,
+                                                      visitor,
+                                                      attributeId);
+    if (rc != e_BER_SUCCESS) {
+        return rc;  // error message is already logged
+    }
+
+    return node.readTagTrailer();
+}
+
 template <typename TYPE>
 int BerDecoder::decode(bsl::streambuf *streamBuf, TYPE *variable)
 {
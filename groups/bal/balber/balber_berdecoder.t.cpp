@@ -10,6 +10,7 @@
 
 #include <balber_berdecoder.h>
 
+#include <balber_berelementindex.h>   // for testing only
 #include <balber_berencoder.h>        // for testing only
 
 #include <bdlat_attributeinfo.h>
@@ -53,6 +54,10 @@ using namespace bsl;  // automatically added by script
 // ----------------------------------------------------------------------------
 //
 //
+// [19] int decode(const char *buffer, size_t length, TYPE *variable);
+// [20] int decodeAttribute(const char *, size_t, TYPE *, int);
+// [-2] PERFORMANCE TEST: CONTIGUOUS AND SEGMENTED INPUT
+// [-3] PERFORMANCE TEST: SELECTIVE DECODING
 
 // ----------------------------------------------------------------------------
 
@@ -295,6 +300,50 @@ void printDiagnostic(balber::BerDecoder & decoder)
 //                     GLOBAL HELPER CLASSES FOR TESTING
 // ----------------------------------------------------------------------------
 
+class SegmentedInStreamBuf : public bsl::streambuf {
+    // This class provides an input stream buffer over a contiguous buffer
+    // that exposes at most a fixed number of characters in its get area at a
+    // time, in the manner of a stream buffer over a sequence of small
+    // buffers, so that 'underflow' is called at the end of each segment.
+
+    // DATA
+    const char *d_end_p;          // end of the input
+    int         d_segmentLength;  // maximum length of the get area
+
+  protected:
+    // PROTECTED MANIPULATORS
+    virtual int_type underflow()
+        // Make the next segment of the input the get area and return its
+        // first character, or return 'traits_type::eof()' if the input is
+        // exhausted.
+    {
+        char *next = egptr();
+        if (next == d_end_p) {
+            return traits_type::eof();                                // RETURN
+        }
+
+        char *end = d_end_p - next > d_segmentLength
+                  ? next + d_segmentLength
+                  : const_cast<char *>(d_end_p);
+        setg(next, next, end);
+        return traits_type::to_int_type(*next);
+    }
+
+  public:
+    // CREATORS
+    SegmentedInStreamBuf(const char  *buffer,
+                         bsl::size_t  length,
+                         int          segmentLength)
+        // Create a stream buffer reading from the specified 'buffer' of the
+        // specified 'length' in segments of the specified 'segmentLength'.
+    : d_end_p(buffer + length)
+    , d_segmentLength(segmentLength)
+    {
+        char *begin = const_cast<char *>(buffer);
+        setg(begin, begin, begin);
+    }
+};
+
 // The code below was generated using the following command:
 //..
 // bas_codegen.pl --m msg --noTestDrivers --noTimestamps -p test test_codec.xsd
@@ -10058,6 +10107,358 @@ int main(int argc, char *argv[])
     bsl::cout << "TEST " << __FILE__ << " CASE " << test << bsl::endl;;
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 20: {
+        // --------------------------------------------------------------------
+        // TESTING 'decodeAttribute'
+        //
+        // Concerns:
+        //: 1 An attribute decoded from the element located by an index has
+        //:   the value of the corresponding attribute of the encoded object,
+        //:   for encodings having definite and indefinite lengths.
+        //:
+        //: 2 Other attributes of the target object are not modified, and the
+        //:   decoded attribute is reset first (so that an array attribute is
+        //:   not appended to).
+        //:
+        //: 3 Attributes of a nested sequence can be decoded by indexing the
+        //:   element of that sequence in turn.
+        //:
+        //: 4 An element whose tag is not context-specific, whose tag number
+        //:   differs from the specified attribute id, or that names an
+        //:   attribute the sequence does not have, is reported as an error,
+        //:   as is truncated input.
+        //
+        // Plan:
+        //: 1 Encode an 'Employee' with and without definite lengths, index
+        //:   the encodings, decode the 'age' and 'homeAddress' attributes
+        //:   into an object having a non-default 'name', and verify the
+        //:   result.  (C-1..2)
+        //:
+        //: 2 Index the 'homeAddress' element, and decode its 'city'
+        //:   attribute alone.  (C-3)
+        //:
+        //: 3 Decode the array attribute of a 'BigRecord' into an object whose
+        //:   array is already populated, and verify that the array has the
+        //:   encoded value.  (C-2)
+        //:
+        //: 4 Decode each of a table of invalid elements, and verify failure.
+        //:   (C-4)
+        //
+        // Testing:
+        //   int decodeAttribute(const char *, size_t, TYPE *, int);
+        // --------------------------------------------------------------------
+
+        if (verbose) bsl::cout << "\nTESTING 'decodeAttribute'"
+                               << "\n========================="
+                               << bsl::endl;
+
+        test::Employee employee;
+        employee.name()                 = "Bob";
+        employee.homeAddress().street() = "Some Street";
+        employee.homeAddress().city()   = "Some City";
+        employee.homeAddress().state()  = "Some State";
+        employee.age()                  = 21;
+
+        if (verbose) bsl::cout << "\nTesting sequence attributes."
+                               << bsl::endl;
+
+        for (int definite = 0; definite < 2; ++definite) {
+            balber::BerEncoderOptions encoderOptions;
+            encoderOptions.setEncodeDefiniteLength(1 == definite);
+
+            balber::BerEncoder     mE(&encoderOptions);
+            bdlsb::MemOutStreamBuf osb;
+            ASSERTV(definite, 0 == mE.encode(&osb, employee));
+
+            balber::BerElementIndex index;
+            ASSERTV(definite, 0 == index.load(osb.data(), osb.length()));
+            ASSERTV(definite, 3 == index.numChildren());
+
+            const int ageIndex     = index.find(
+                                        test::Employee::ATTRIBUTE_ID_AGE);
+            const int addressIndex = index.find(
+                               test::Employee::ATTRIBUTE_ID_HOME_ADDRESS);
+            ASSERTV(definite, 0 <= ageIndex);
+            ASSERTV(definite, 0 <= addressIndex);
+
+            const balber::BerElementRef& AGE     = index.child(ageIndex);
+            const balber::BerElementRef& ADDRESS = index.child(addressIndex);
+
+            test::Employee value;
+            value.name() = "Alice";
+
+            balber::BerDecoder mX;
+
+            ASSERTV(definite, 0 == mX.decodeAttribute(
+                                       index.buffer() + AGE.offset(),
+                                       AGE.length(),
+                                       &value,
+                                       test::Employee::ATTRIBUTE_ID_AGE));
+            printDiagnostic(mX);
+
+            ASSERTV(definite, 0 == mX.decodeAttribute(
+                              index.buffer() + ADDRESS.offset(),
+                              ADDRESS.length(),
+                              &value,
+                              test::Employee::ATTRIBUTE_ID_HOME_ADDRESS));
+            printDiagnostic(mX);
+
+            ASSERTV(definite, "Alice"               == value.name());
+            ASSERTV(definite, employee.age()        == value.age());
+            ASSERTV(definite, employee.homeAddress() == value.homeAddress());
+
+            balber::BerElementIndex addressIdx;
+            ASSERTV(definite, 0 == addressIdx.load(
+                                         index.buffer() + ADDRESS.offset(),
+                                         ADDRESS.length()));
+
+            const int cityIndex = addressIdx.find(
+                                          test::Address::ATTRIBUTE_ID_CITY);
+            ASSERTV(definite, 0 <= cityIndex);
+
+            const balber::BerElementRef& CITY = addressIdx.child(cityIndex);
+
+            test::Address address;
+            ASSERTV(definite, 0 == mX.decodeAttribute(
+                                  addressIdx.buffer() + CITY.offset(),
+                                  CITY.length(),
+                                  &address,
+                                  test::Address::ATTRIBUTE_ID_CITY));
+            ASSERTV(definite, "Some City" == address.city());
+            ASSERTV(definite, address.street().empty());
+            ASSERTV(definite, address.state().empty());
+        }
+
+        if (verbose) bsl::cout << "\nTesting array attributes." << bsl::endl;
+        {
+            test::BasicRecord basicRec;
+            basicRec.i1() = 11;
+            basicRec.s()  = "Hello";
+
+            test::BigRecord bigRec;
+            bigRec.name() = "Big";
+            for (int i = 0; i < 3; ++i) {
+                bigRec.array().push_back(basicRec);
+                ++basicRec.i1();
+            }
+
+            bdlsb::MemOutStreamBuf osb;
+            ASSERT(0 == encoder.encode(&osb, bigRec));
+
+            balber::BerElementIndex index;
+            ASSERT(0 == index.load(osb.data(), osb.length()));
+
+            const balber::BerElementRef& ARRAY = index.child(
+                          index.find(test::BigRecord::ATTRIBUTE_ID_ARRAY));
+
+            test::BigRecord value(bigRec);
+            ASSERT(bigRec == value);
+
+            balber::BerDecoder mX;
+            ASSERT(0 == mX.decodeAttribute(
+                                     index.buffer() + ARRAY.offset(),
+                                     ARRAY.length(),
+                                     &value,
+                                     test::BigRecord::ATTRIBUTE_ID_ARRAY));
+            ASSERTV(value.array().size(), bigRec == value);
+        }
+
+        if (verbose) bsl::cout << "\nTesting invalid elements." << bsl::endl;
+        {
+            static const struct {
+                int         d_line;
+                const char *d_data;
+                int         d_attributeId;
+            } DATA[] = {
+                //Line Data                 Attribute Id
+                //==== ====                 ============
+                { L_,  "020122",            0            },
+                { L_,  "800122",            1            },
+                { L_,  "820122",            2            },
+                { L_,  "8001",              0            },
+                { L_,  "",                  0            },
+                { L_,  "8105 48656C6C6F",   0            },
+            };
+
+            static const int DATA_LEN = sizeof(DATA) / sizeof(DATA[0]);
+
+            for (int i = 0; i < DATA_LEN; ++i) {
+                const int LINE = DATA[i].d_line;
+                const int ID   = DATA[i].d_attributeId;
+
+                const bsl::vector<char> data = loadFromHex(DATA[i].d_data);
+
+                test::MySequence   value;
+                balber::BerDecoder mX;
+
+                ASSERTV(LINE, 0 != mX.decodeAttribute(
+                                                data.empty() ? 0 : &data[0],
+                                                data.size(),
+                                                &value,
+                                                ID));
+            }
+
+            const bsl::vector<char> data = loadFromHex("800122");
+
+            test::MySequence   value;
+            balber::BerDecoder mX;
+
+            ASSERT(0 == mX.decodeAttribute(&data[0], data.size(), &value, 0));
+            ASSERT(34 == value.attribute1());
+        }
+
+        if (verbose) bsl::cout << "\nEnd of test." << bsl::endl;
+      } break;
+      case 19: {
+        // --------------------------------------------------------------------
+        // TESTING 'decode' FROM CONTIGUOUS MEMORY
+        //
+        // Concerns:
+        //: 1 Decoding from a contiguous buffer produces the same value as
+        //:   decoding the same octets from a stream buffer.
+        //:
+        //: 2 Unknown elements having either a definite or an indefinite
+        //:   length are skipped, and counted, when skipping is enabled.
+        //:
+        //: 3 An unknown element whose definite length extends past the end
+        //:   of the buffer is reported as an error rather than skipped.
+        //:
+        //: 4 An empty or truncated buffer is reported as an error.
+        //
+        // Plan:
+        //: 1 Decode a large encoded message from a contiguous buffer and
+        //:   compare with the original value.  (C-1)
+        //:
+        //: 2 Using a table of encodings of a sequence, some with unknown
+        //:   elements, decode each from a contiguous buffer and verify the
+        //:   value and the number of skipped elements.  (C-2)
+        //:
+        //: 3 Decode encodings whose unknown element is longer than the
+        //:   remaining input, and verify failure.  (C-3)
+        //:
+        //: 4 Decode every proper prefix of an encoding, and verify failure.
+        //:   (C-4)
+        //
+        // Testing:
+        //   int decode(const char *buffer, size_t length, TYPE *variable);
+        // --------------------------------------------------------------------
+
+        if (verbose) bsl::cout << "\nTESTING 'decode' FROM CONTIGUOUS MEMORY"
+                               << "\n======================================="
+                               << bsl::endl;
+
+        if (verbose) bsl::cout << "\nTesting a large message." << bsl::endl;
+        {
+            test::BasicRecord basicRec;
+            basicRec.i1() = 11;
+            basicRec.i2() = 22;
+            basicRec.dt() = bdlt::DatetimeTz(
+                                   bdlt::Datetime(bdlt::Date(2007, 9, 3),
+                                                  bdlt::Time(16, 30)), 0);
+            basicRec.s()  = "The quick brown fox jumped over the lazy dog.";
+
+            test::BigRecord bigRec;
+            bigRec.name() = "This record is so big, it has its own gravity.";
+            for (int i = 0; i < 50; ++i) {
+                bigRec.array().push_back(basicRec);
+            }
+
+            test::TimingRequest valueOut;
+            valueOut.makeBig(bigRec);
+
+            bdlsb::MemOutStreamBuf osb;
+            ASSERT(0 == encoder.encode(&osb, valueOut));
+
+            test::TimingRequest valueIn;
+            ASSERT(0 == decoder.decode(osb.data(), osb.length(), &valueIn));
+            printDiagnostic(decoder);
+            ASSERT(valueOut == valueIn);
+
+            SegmentedInStreamBuf isb(osb.data(), osb.length(), 7);
+            test::TimingRequest  valueIn2;
+            ASSERT(0 == decoder.decode(&isb, &valueIn2));
+            ASSERT(valueOut == valueIn2);
+        }
+
+        test::MySequence valueOut;
+        valueOut.attribute1() = 34;
+        valueOut.attribute2() = "Hello";
+
+        if (verbose) bsl::cout << "\nTesting unknown elements." << bsl::endl;
+        {
+            static const struct {
+                int         d_line;
+                const char *d_data;
+                int         d_numUnknownElements;
+            } DATA[] = {
+                //Line Data                                      Num Unknown
+                //==== ====                                      ===========
+                { L_,  "300A 800122         810548656C6C6F"           , 0 },
+                { L_,  "300D 820199         800122 810548656C6C6F"    , 1 },
+                { L_,  "300F A203820199     800122 810548656C6C6F"    , 1 },
+                { L_,  "3011 A2808201990000 800122 810548656C6C6F"    , 1 },
+                { L_,  "3013 8204DEADBEEF   800122 810548656C6C6F"
+                       "     830100"                                  , 2 },
+                { L_,  "3080 820199         800122 810548656C6C6F 0000",1 },
+                { L_,  "3080 A203820199     800122 810548656C6C6F 0000",1 },
+            };
+
+            static const int DATA_LEN = sizeof(DATA) / sizeof(DATA[0]);
+
+            for (int i = 0; i < DATA_LEN; ++i) {
+                const int   LINE        = DATA[i].d_line;
+                const int   NUM_UNKNOWN = DATA[i].d_numUnknownElements;
+
+                const bsl::vector<char> data = loadFromHex(DATA[i].d_data);
+
+                test::MySequence valueIn;
+
+                balber::BerDecoder mX;
+                ASSERTV(LINE, 0 == mX.decode(&data[0], data.size(), &valueIn));
+                printDiagnostic(mX);
+
+                ASSERTV(LINE, NUM_UNKNOWN, mX.numUnknownElementsSkipped(),
+                        NUM_UNKNOWN == mX.numUnknownElementsSkipped());
+                ASSERTV(LINE, valueOut == valueIn);
+            }
+        }
+
+        if (verbose) bsl::cout << "\nTesting overlong unknown elements."
+                               << bsl::endl;
+        {
+            static const char *DATA[] = {
+                "300B 800122 810548656C6C6F 8205",
+                "300C 800122 810548656C6C6F 820599",
+                "300E 800122 810548656C6C6F A2048203",
+            };
+
+            static const int DATA_LEN = sizeof(DATA) / sizeof(DATA[0]);
+
+            for (int i = 0; i < DATA_LEN; ++i) {
+                const bsl::vector<char> data = loadFromHex(DATA[i]);
+
+                test::MySequence   valueIn;
+                balber::BerDecoder mX;
+
+                ASSERTV(i, 0 != mX.decode(&data[0], data.size(), &valueIn));
+            }
+        }
+
+        if (verbose) bsl::cout << "\nTesting truncated input." << bsl::endl;
+        {
+            const bsl::vector<char> data =
+                         loadFromHex("300D 820199 800122 810548656C6C6F");
+
+            for (bsl::size_t length = 0; length < data.size(); ++length) {
+                test::MySequence   valueIn;
+                balber::BerDecoder mX;
+
+                ASSERTV(length, 0 != mX.decode(&data[0], length, &valueIn));
+            }
+        }
+
+        if (verbose) bsl::cout << "\nEnd of test." << bsl::endl;
+      } break;
       case 18: {
         // --------------------------------------------------------------------
         // TESTING USAGE EXAMPLE
@@ -14255,8 +14656,169 @@ int main(int argc, char *argv[])
         bsl::cout << "    balber::BerDecoder: "
                   << elapsed          << " seconds, "
                   << (reps / elapsed) << " reps/sec" << bsl::endl;
+      } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: CONTIGUOUS AND SEGMENTED INPUT
+        //   Measure the number of messages decoded per second when the input
+        //   is a contiguous buffer, and when it is supplied by a stream
+        //   buffer in segments of a given size.  Optionally specify the
+        //   number of repetitions, the array size of the message, and the
+        //   segment size on the command line:
+        //..
+        //  balber_berdecoder.t -2 [reps] [arraySize] [segmentSize]
+        //..
+        // --------------------------------------------------------------------
 
-        delete[] inRequests;
+        const int reps        = argc > 2 ? bsl::atoi(argv[2]) : 1000;
+        const int arraySize   = argc > 3 ? bsl::atoi(argv[3]) : 200;
+        const int segmentSize = argc > 4 ? bsl::atoi(argv[4]) : 64;
+
+        bsl::cout << "PERFORMANCE TEST: CONTIGUOUS AND SEGMENTED INPUT"
+                  << bsl::endl
+                  << "  " << reps << " repetitions, array size of "
+                  << arraySize << ", segment size of " << segmentSize
+                  << bsl::endl;
+
+        test::BasicRecord basicRec;
+        basicRec.i1() = 11;
+        basicRec.i2() = 22;
+        basicRec.dt() = bdlt::DatetimeTz(
+                                   bdlt::Datetime(bdlt::Date(2007, 9, 3),
+                                                  bdlt::Time(16, 30)), 0);
+        basicRec.s()  = "The quick brown fox jumped over the lazy dog.";
+
+        test::BigRecord bigRec;
+        bigRec.name() = "This record is so big, it has its own gravity.";
+        for (int i = 0; i < arraySize; ++i) {
+            bigRec.array().push_back(basicRec);
+        }
+
+        test::TimingRequest request;
+        request.makeBig(bigRec);
+
+        bdlsb::MemOutStreamBuf osb;
+        ASSERT(0 == encoder.encode(&osb, request));
+
+        test::TimingRequest value;
+        bsls::Stopwatch     stopwatch;
+
+        stopwatch.start();
+        for (int i = 0; i < reps; ++i) {
+            balber::BerDecoder decoder;
+            decoder.decode(osb.data(), osb.length(), &value);
+        }
+        stopwatch.stop();
+        ASSERT(request == value);
+
+        double elapsed = stopwatch.elapsedTime();
+        bsl::cout << "    contiguous: "
+                  << elapsed          << " seconds, "
+                  << (reps / elapsed) << " msgs/sec" << bsl::endl;
+
+        stopwatch.reset();
+        stopwatch.start();
+        for (int i = 0; i < reps; ++i) {
+            SegmentedInStreamBuf isb(osb.data(), osb.length(), segmentSize);
+            balber::BerDecoder   decoder;
+            decoder.decode(&isb, &value);
+        }
+        stopwatch.stop();
+        ASSERT(request == value);
+
+        elapsed = stopwatch.elapsedTime();
+        bsl::cout << "    segmented:  "
+                  << elapsed          << " seconds, "
+                  << (reps / elapsed) << " msgs/sec" << bsl::endl;
+      } break;
+      case -3: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: SELECTIVE DECODING
+        //   Measure the number of messages per second from which a single
+        //   attribute is obtained by decoding the whole message, and by
+        //   indexing the message and decoding only that attribute, for
+        //   encodings having definite and indefinite lengths.  Optionally
+        //   specify the number of repetitions and the array size of the
+        //   message on the command line:
+        //..
+        //  balber_berdecoder.t -3 [reps] [arraySize]
+        //..
+        // --------------------------------------------------------------------
+
+        const int reps      = argc > 2 ? bsl::atoi(argv[2]) : 1000;
+        const int arraySize = argc > 3 ? bsl::atoi(argv[3]) : 200;
+
+        bsl::cout << "PERFORMANCE TEST: SELECTIVE DECODING" << bsl::endl
+                  << "  " << reps << " repetitions, array size of "
+                  << arraySize << bsl::endl;
+
+        test::BasicRecord basicRec;
+        basicRec.i1() = 11;
+        basicRec.i2() = 22;
+        basicRec.dt() = bdlt::DatetimeTz(
+                                   bdlt::Datetime(bdlt::Date(2007, 9, 3),
+                                                  bdlt::Time(16, 30)), 0);
+        basicRec.s()  = "The quick brown fox jumped over the lazy dog.";
+
+        test::BigRecord bigRec;
+        bigRec.name() = "This record is so big, it has its own gravity.";
+        for (int i = 0; i < arraySize; ++i) {
+            bigRec.array().push_back(basicRec);
+        }
+
+        for (int definite = 0; definite < 2; ++definite) {
+            balber::BerEncoderOptions encoderOptions;
+            encoderOptions.setEncodeDefiniteLength(1 == definite);
+
+            balber::BerEncoder     mE(&encoderOptions);
+            bdlsb::MemOutStreamBuf osb;
+            ASSERT(0 == mE.encode(&osb, bigRec));
+
+            bsl::cout << (definite ? "  definite length:"
+                                   : "  indefinite length:")
+                      << bsl::endl;
+
+            test::BigRecord value;
+            bsls::Stopwatch stopwatch;
+
+            stopwatch.start();
+            for (int i = 0; i < reps; ++i) {
+                balber::BerDecoder decoder;
+                decoder.decode(osb.data(), osb.length(), &value);
+            }
+            stopwatch.stop();
+            ASSERT(bigRec.name() == value.name());
+
+            double elapsed = stopwatch.elapsedTime();
+            bsl::cout << "    full decode:      "
+                      << elapsed          << " seconds, "
+                      << (reps / elapsed) << " msgs/sec" << bsl::endl;
+
+            test::BigRecord         partial;
+            balber::BerElementIndex index;
+
+            stopwatch.reset();
+            stopwatch.start();
+            for (int i = 0; i < reps; ++i) {
+                index.load(osb.data(), osb.length());
+
+                const balber::BerElementRef& NAME = index.child(
+                           index.find(test::BigRecord::ATTRIBUTE_ID_NAME));
+
+                balber::BerDecoder decoder;
+                decoder.decodeAttribute(index.buffer() + NAME.offset(),
+                                        NAME.length(),
+                                        &partial,
+                                        test::BigRecord::ATTRIBUTE_ID_NAME);
+            }
+            stopwatch.stop();
+            ASSERT(bigRec.name() == partial.name());
+
+            elapsed = stopwatch.elapsedTime();
+            bsl::cout << "    selective decode: "
+                      << elapsed          << " seconds, "
+                      << (reps / elapsed) << " msgs/sec" << bsl::endl;
+        }
       } break;
       default: {
         bsl::cerr << "WARNING: CASE `" << test << "' NOT FOUND." << bsl::endl;
@@ -0,0 +1,270 @@
+// balber_berelementindex.cpp                                         -*-C++-*-
+#include <balber_berelementindex.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(balber_berelementindex_cpp,"$Id$ $CSID$")
+
+#include <balber_berutil.h>
+
+#include <bdlsb_fixedmeminstreambuf.h>
+
+#include <bsl_climits.h>
+
+namespace BloombergLP {
+namespace {
+
+int readHeader(balber::BerElementRef      *result,
+               bdlsb::FixedMemInStreamBuf *streamBuf,
+               int                        *position,
+               int                         length)
+    // Read the identifier and length octets of the BER element at the
+    // specified '*position' in the specified 'streamBuf' holding the
+    // specified 'length' octets, advance 'position' past them, and load into
+    // the specified 'result' a description of the element whose
+    // 'contentLength' is the number of remaining octets in 'streamBuf' if the
+    // length is indefinite.  Return 0 on success, and a non-zero value if the
+    // octets are malformed or if a definite length extends past the end of
+    // 'streamBuf'.
+{
+    balber::BerConstants::TagClass tagClass;
+    balber::BerConstants::TagType  tagType;
+    int                            tagNumber;
+    int                            headerLength = 0;
+    int                            contentLength;
+
+    if (0 != balber::BerUtil::getIdentifierOctets(streamBuf,
+                                                  &tagClass,
+                                                  &tagType,
+                                                  &tagNumber,
+                                                  &headerLength)
+     || 0 != balber::BerUtil::getLength(streamBuf,
+                                        &contentLength,
+                                        &headerLength)) {
+        return -1;                                                    // RETURN
+    }
+
+    const int remaining = length - *position - headerLength;
+
+    const bool isIndefiniteLength =
+                     balber::BerUtil::e_INDEFINITE_LENGTH == contentLength;
+
+    if (isIndefiniteLength) {
+        if (balber::BerConstants::e_CONSTRUCTED != tagType) {
+            return -1;                                                // RETURN
+        }
+        contentLength = remaining;
+    }
+    else if (contentLength < 0 || contentLength > remaining) {
+        return -1;                                                    // RETURN
+    }
+
+    *result = balber::BerElementRef(tagClass,
+                                    tagType,
+                                    tagNumber,
+                                    *position,
+                                    headerLength,
+                                    contentLength,
+                                    isIndefiniteLength);
+
+    *position += headerLength;
+    return 0;
+}
+
+int skip(bdlsb::FixedMemInStreamBuf *streamBuf, int *position, int length)
+    // Advance the specified 'streamBuf' and the specified 'position' by the
+    // specified 'length' octets.  Return 0 on success, and a non-zero value if
+    // fewer than 'length' octets remain.
+{
+    if (bsl::streambuf::pos_type(-1) == streamBuf->pubseekoff(
+                                                          length,
+                                                          bsl::ios_base::cur,
+                                                          bsl::ios_base::in)) {
+        return -1;                                                    // RETURN
+    }
+
+    *position += length;
+    return 0;
+}
+
+int skipIndefiniteContents(bdlsb::FixedMemInStreamBuf *streamBuf,
+                           int                        *position,
+                           int                         length)
+    // Advance the specified 'streamBuf', holding the specified 'length'
+    // octets, and the specified 'position' past the contents and the
+    // end-of-contents octets of an element having an indefinite length, whose
+    // identifier and length octets have already been read.  Return 0 on
+    // success, and a non-zero value otherwise.  Note that nested elements are
+    // tracked with a counter rather than by recursion, so that deeply nested
+    // input cannot exhaust the stack.
+{
+    int depth = 1;
+
+    while (0 < depth) {
+        if (0 == streamBuf->sgetc()) {
+            if (0 != balber::BerUtil::getEndOfContentOctets(streamBuf,
+                                                            position)) {
+                return -1;                                            // RETURN
+            }
+            --depth;
+            continue;
+        }
+
+        balber::BerElementRef nested;
+        if (0 != readHeader(&nested, streamBuf, position, length)) {
+            return -1;                                                // RETURN
+        }
+
+        if (nested.isIndefiniteLength()) {
+            ++depth;
+        }
+        else if (0 != skip(streamBuf, position, nested.contentLength())) {
+            return -1;                                                // RETURN
+        }
+    }
+
+    return 0;
+}
+
+int readElement(balber::BerElementRef      *result,
+                bdlsb::FixedMemInStreamBuf *streamBuf,
+                int                        *position,
+                int                         length)
+    // Load into the specified 'result' a description of the complete BER
+    // element at the specified '*position' in the specified 'streamBuf',
+    // holding the specified 'length' octets, and advance 'streamBuf' and
+    // 'position' past that element.  Return 0 on success, and a non-zero
+    // value otherwise.
+{
+    balber::BerElementRef header;
+    if (0 != readHeader(&header, streamBuf, position, length)) {
+        return -1;                                                    // RETURN
+    }
+
+    if (!header.isIndefiniteLength()) {
+        *result = header;
+        return skip(streamBuf, position, header.contentLength());     // RETURN
+    }
+
+    const int contentOffset = *position;
+    if (0 != skipIndefiniteContents(streamBuf, position, length)) {
+        return -1;                                                    // RETURN
+    }
+
+    *result = balber::BerElementRef(header.tagClass(),
+                                    header.tagType(),
+                                    header.tagNumber(),
+                                    header.offset(),
+                                    header.headerLength(),
+                                    *position - contentOffset - 2,
+                                    true);
+    return 0;
+}
+
+}  // close unnamed namespace
+
+namespace balber {
+
+                           // ---------------------
+                           // class BerElementIndex
+                           // ---------------------
+
+// MANIPULATORS
+int BerElementIndex::load(const char *buffer, bsl::size_t length)
+{
+    BSLS_ASSERT(buffer || 0 == length);
+
+    reset();
+
+    if (length > static_cast<bsl::size_t>(INT_MAX)) {
+        return -1;                                                    // RETURN
+    }
+
+    bdlsb::FixedMemInStreamBuf streamBuf(buffer, length);
+    const int                  size     = static_cast<int>(length);
+    int                        position = 0;
+
+    BerElementRef element;
+    if (0 != readHeader(&element, &streamBuf, &position, size)
+     || BerConstants::e_CONSTRUCTED != element.tagType()) {
+        return -1;                                                    // RETURN
+    }
+
+    if (element.isIndefiniteLength()) {
+        while (0 != streamBuf.sgetc()) {
+            BerElementRef child;
+            if (0 != readElement(&child, &streamBuf, &position, size)) {
+                d_children.clear();
+                return -1;                                            // RETURN
+            }
+            d_children.push_back(child);
+        }
+
+        const int contentLength = position - element.contentOffset();
+
+        if (0 != BerUtil::getEndOfContentOctets(&streamBuf, &position)) {
+            d_children.clear();
+            return -1;                                                // RETURN
+        }
+
+        element = BerElementRef(element.tagClass(),
+                                element.tagType(),
+                                element.tagNumber(),
+                                element.offset(),
+                                element.headerLength(),
+                                contentLength,
+                                true);
+    }
+    else {
+        const int end = element.contentOffset() + element.contentLength();
+
+        while (position < end) {
+            BerElementRef child;
+            if (0 != readElement(&child, &streamBuf, &position, size)
+             || position > end) {
+                d_children.clear();
+                return -1;                                            // RETURN
+            }
+            d_children.push_back(child);
+        }
+    }
+
+    d_buffer_p = buffer;
+    d_element  = element;
+    return 0;
+}
+
+// ACCESSORS
+int BerElementIndex::find(int tagNumber) const
+{
+    const int numChildren = this->numChildren();
+
+    for (int i = 0; i < numChildren; ++i) {
+        const BerElementRef& child = d_children[i];
+
+        if (tagNumber == child.tagNumber()
+         && BerConstants::e_CONTEXT_SPECIFIC == child.tagClass()) {
+            return i;                                                 // RETURN
+        }
+    }
+
+    return -1;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
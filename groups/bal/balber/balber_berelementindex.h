@@ -0,0 +1,509 @@
+// balber_berelementindex.h                                           -*-C++-*-
+#ifndef INCLUDED_BALBER_BERELEMENTINDEX
+#define INCLUDED_BALBER_BERELEMENTINDEX
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an index of the elements nested in a BER element.
+//
+//@CLASSES:
+//  balber::BerElementRef: location and tag of a BER element in a buffer
+//  balber::BerElementIndex: index of the child elements of a BER element
+//
+//@SEE_ALSO: balber_berdecoder, balber_berutil
+//
+//@DESCRIPTION: This component provides a mechanism, 'balber::BerElementIndex',
+// that records the location of each immediate child of a constructed BER
+// element held in contiguous memory, without decoding the contents of any of
+// those children.  Each child is described by a 'balber::BerElementRef', an
+// unconstrained attribute type holding the tag of the child together with the
+// offset and length (in bytes) of the child within the indexed buffer.
+//
+// Together with 'balber::BerDecoder::decodeAttribute', an index supports
+// *lazy* decoding of large messages: a client that needs only a few of the
+// attributes of a large sequence indexes the encoded sequence once and then
+// decodes just the attributes it needs, each directly from its own
+// '(offset, length)' range.  A child that is itself a sequence can in turn be
+// indexed by loading a second index from the range of that child, so deeply
+// nested values are never decoded unless they are accessed.
+//
+///Cost of Indexing
+///----------------
+// Only identifier and length octets are examined while an index is loaded.  A
+// child having a definite length (see 'balber_berencoderoptions' for how to
+// produce such encodings) is stepped over in constant time, however large its
+// contents.  A child having an indefinite length has no such framing, so its
+// contents are scanned for the matching end-of-contents octets; the scan
+// reads the identifier and length octets of each nested element, but still
+// steps over nested elements having a definite length without reading their
+// contents.
+//
+// The index refers to, but does not own, the buffer from which it was
+// loaded; that buffer must remain valid for as long as the references in the
+// index are used to access it.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Locating Attributes Without Decoding
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we receive the following BER encoding of a sequence having
+// three attributes: an integer with id 0, a string with id 1, and a nested
+// sequence with id 2 (holding a single integer with id 0):
+//..
+//  const char ENCODING[] = {
+//      0x30, 0x0E,                                // SEQUENCE, 14 bytes
+//      char(0x80), 0x01, 0x22,                    // [0] 34
+//      char(0x81), 0x03, 'a', 'b', 'c',           // [1] "abc"
+//      char(0xA2), 0x04,                          // [2] SEQUENCE, 4 bytes
+//                  char(0x80), 0x02, 0x01, 0x00   //     [0] 256
+//  };
+//..
+// First, we load an index of the top-level sequence:
+//..
+//  balber::BerElementIndex index;
+//  int rc = index.load(ENCODING, sizeof ENCODING);
+//  assert(0 == rc);
+//  assert(3 == index.numChildren());
+//..
+// Then, we find the attribute having id 1 and verify its location:
+//..
+//  const int i = index.find(1);
+//  assert(1 == i);
+//
+//  const balber::BerElementRef& child = index.child(i);
+//  assert(balber::BerConstants::e_CONTEXT_SPECIFIC == child.tagClass());
+//  assert(5 == child.offset());
+//  assert(5 == child.length());
+//  assert(0 == bsl::memcmp("abc",
+//                          index.buffer() + child.contentOffset(),
+//                          child.contentLength()));
+//..
+// Finally, we index the nested sequence (attribute id 2) in turn, using the
+// range occupied by that child:
+//..
+//  const balber::BerElementRef& nested = index.child(index.find(2));
+//
+//  balber::BerElementIndex nestedIndex;
+//  rc = nestedIndex.load(index.buffer() + nested.offset(), nested.length());
+//  assert(0 == rc);
+//  assert(1 == nestedIndex.numChildren());
+//  assert(2 == nestedIndex.child(0).contentLength());
+//..
+// See 'balber_berdecoder' for how the value of such a child is decoded into
+// the corresponding attribute of a 'bdlat' sequence.
+
+#ifndef INCLUDED_BALSCM_VERSION
+#include <balscm_version.h>
+#endif
+
+#ifndef INCLUDED_BALBER_BERCONSTANTS
+#include <balber_berconstants.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace balber {
+
+                            // ===================
+                            // class BerElementRef
+                            // ===================
+
+class BerElementRef {
+    // This unconstrained attribute class describes one BER element held in a
+    // contiguous buffer: the class, type, and number of its tag, the offset
+    // of its first identifier octet from the start of the buffer, the number
+    // of its identifier and length octets, and the number of its contents
+    // octets.  An element having an indefinite length is also followed by two
+    // end-of-contents octets, which are included in 'length' but not in
+    // 'contentLength'.
+
+    // DATA
+    BerConstants::TagClass d_tagClass;            // tag class
+    BerConstants::TagType  d_tagType;             // tag type
+    int                    d_tagNumber;           // tag number
+    int                    d_offset;              // offset of identifier
+    int                    d_headerLength;        // identifier and length
+                                                  // octets
+    int                    d_contentLength;       // contents octets
+    bool                   d_isIndefiniteLength;  // 'true' if terminated by
+                                                  // end-of-contents octets
+
+  public:
+    // CREATORS
+    BerElementRef();
+        // Create an element reference describing an empty, universal,
+        // primitive element with tag number 0 and a definite length, at
+        // offset 0.
+
+    BerElementRef(BerConstants::TagClass tagClass,
+                  BerConstants::TagType  tagType,
+                  int                    tagNumber,
+                  int                    offset,
+                  int                    headerLength,
+                  int                    contentLength,
+                  bool                   isIndefiniteLength);
+        // Create an element reference describing an element having the
+        // specified 'tagClass', 'tagType', and 'tagNumber', whose identifier
+        // octets start at the specified 'offset', and that has the specified
+        // 'headerLength' identifier and length octets and the specified
+        // 'contentLength' contents octets.  If the specified
+        // 'isIndefiniteLength' is 'true', the contents are followed by two
+        // end-of-contents octets.  The behavior is undefined unless
+        // '0 <= tagNumber', '0 <= offset', '2 <= headerLength', and
+        // '0 <= contentLength'.
+
+    //! BerElementRef(const BerElementRef& original) = default;
+    //! ~BerElementRef() = default;
+
+    // MANIPULATORS
+    //! BerElementRef& operator=(const BerElementRef& rhs) = default;
+
+    // ACCESSORS
+    BerConstants::TagClass tagClass() const;
+        // Return the tag class of the described element.
+
+    BerConstants::TagType tagType() const;
+        // Return the tag type of the described element.
+
+    int tagNumber() const;
+        // Return the tag number of the described element.
+
+    int offset() const;
+        // Return the offset of the first identifier octet of the described
+        // element.
+
+    int headerLength() const;
+        // Return the number of identifier and length octets of the described
+        // element.
+
+    int contentOffset() const;
+        // Return the offset of the first contents octet of the described
+        // element, i.e., 'offset() + headerLength()'.
+
+    int contentLength() const;
+        // Return the number of contents octets of the described element,
+        // excluding any end-of-contents octets.
+
+    bool isIndefiniteLength() const;
+        // Return 'true' if the described element has an indefinite length
+        // (and so is terminated by end-of-contents octets), and 'false'
+        // otherwise.
+
+    int length() const;
+        // Return the total number of octets occupied by the described element,
+        // including its identifier, length, and any end-of-contents octets.
+};
+
+// FREE OPERATORS
+bool operator==(const BerElementRef& lhs, const BerElementRef& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' element references have
+    // the same value, and 'false' otherwise.  Two element references have the
+    // same value if each of their corresponding attributes has the same
+    // value.
+
+bool operator!=(const BerElementRef& lhs, const BerElementRef& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' element references do
+    // not have the same value, and 'false' otherwise.  Two element references
+    // do not have the same value if any of their corresponding attributes do
+    // not have the same value.
+
+                           // =====================
+                           // class BerElementIndex
+                           // =====================
+
+class BerElementIndex {
+    // This mechanism class indexes the immediate children of a constructed
+    // BER element held in contiguous memory, recording the tag and location
+    // of each child without decoding its contents.
+
+    // DATA
+    const char                 *d_buffer_p;  // indexed buffer (held)
+    BerElementRef               d_element;   // the indexed element
+    bsl::vector<BerElementRef>  d_children;  // children of 'd_element'
+
+    // NOT IMPLEMENTED
+    BerElementIndex(const BerElementIndex&);             // = delete
+    BerElementIndex& operator=(const BerElementIndex&);  // = delete
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(BerElementIndex,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit BerElementIndex(bslma::Allocator *basicAllocator = 0);
+        // Create an empty index.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.
+
+    //! ~BerElementIndex() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    int load(const char *buffer, bsl::size_t length);
+        // Index the immediate children of the constructed BER element that
+        // starts at the specified 'buffer' of the specified 'length'.  Return
+        // 0 on success, and a non-zero value otherwise.  The offsets of the
+        // indexed element and of its children are relative to 'buffer', which
+        // must remain valid for as long as it is accessed through this index.
+        // Octets following the indexed element are ignored.  On failure, this
+        // index is left empty.  The behavior is undefined unless 'buffer' is
+        // non-null or '0 == length'.
+
+    void reset();
+        // Reset this index to the empty state.
+
+    // ACCESSORS
+    const char *buffer() const;
+        // Return the address of the buffer from which this index was loaded,
+        // or 0 if this index is empty.
+
+    const BerElementRef& element() const;
+        // Return a reference providing non-modifiable access to the
+        // description of the indexed element.  The behavior is undefined if
+        // this index is empty.
+
+    int numChildren() const;
+        // Return the number of immediate children of the indexed element.
+
+    const BerElementRef& child(int index) const;
+        // Return a reference providing non-modifiable access to the
+        // description of the child of the indexed element at the specified
+        // 'index'.  The behavior is undefined unless
+        // '0 <= index < numChildren()'.
+
+    int find(int tagNumber) const;
+        // Return the index of the first child of the indexed element having a
+        // context-specific tag with the specified 'tagNumber', or -1 if there
+        // is no such child.  Note that in encodings produced by
+        // 'balber::BerEncoder' the tag number of each element nested in a
+        // sequence is the id of the corresponding attribute.
+
+    bool isEmpty() const;
+        // Return 'true' if this index is empty, and 'false' otherwise.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                            // -------------------
+                            // class BerElementRef
+                            // -------------------
+
+// CREATORS
+inline
+BerElementRef::BerElementRef()
+: d_tagClass(BerConstants::e_UNIVERSAL)
+, d_tagType(BerConstants::e_PRIMITIVE)
+, d_tagNumber(0)
+, d_offset(0)
+, d_headerLength(2)
+, d_contentLength(0)
+, d_isIndefiniteLength(false)
+{
+}
+
+inline
+BerElementRef::BerElementRef(BerConstants::TagClass tagClass,
+                             BerConstants::TagType  tagType,
+                             int                    tagNumber,
+                             int                    offset,
+                             int                    headerLength,
+                             int                    contentLength,
+                             bool                   isIndefiniteLength)
+: d_tagClass(tagClass)
+, d_tagType(tagType)
+, d_tagNumber(tagNumber)
+, d_offset(offset)
+, d_headerLength(headerLength)
+, d_contentLength(contentLength)
+, d_isIndefiniteLength(isIndefiniteLength)
+{
+    BSLS_ASSERT_SAFE(0 <= tagNumber);
+    BSLS_ASSERT_SAFE(0 <= offset);
+    BSLS_ASSERT_SAFE(2 <= headerLength);
+    BSLS_ASSERT_SAFE(0 <= contentLength);
+}
+
+// ACCESSORS
+inline
+BerConstants::TagClass BerElementRef::tagClass() const
+{
+    return d_tagClass;
+}
+
+inline
+BerConstants::TagType BerElementRef::tagType() const
+{
+    return d_tagType;
+}
+
+inline
+int BerElementRef::tagNumber() const
+{
+    return d_tagNumber;
+}
+
+inline
+int BerElementRef::offset() const
+{
+    return d_offset;
+}
+
+inline
+int BerElementRef::headerLength() const
+{
+    return d_headerLength;
+}
+
+inline
+int BerElementRef::contentOffset() const
+{
+    return d_offset + d_headerLength;
+}
+
+inline
+int BerElementRef::contentLength() const
+{
+    return d_contentLength;
+}
+
+inline
+bool BerElementRef::isIndefiniteLength() const
+{
+    return d_isIndefiniteLength;
+}
+
+inline
+int BerElementRef::length() const
+{
+    return d_headerLength + d_contentLength + (d_isIndefiniteLength ? 2 : 0);
+}
+
+                           // ---------------------
+                           // class BerElementIndex
+                           // ---------------------
+
+// CREATORS
+inline
+BerElementIndex::BerElementIndex(bslma::Allocator *basicAllocator)
+: d_buffer_p(0)
+, d_element()
+, d_children(basicAllocator)
+{
+}
+
+// MANIPULATORS
+inline
+void BerElementIndex::reset()
+{
+    d_buffer_p = 0;
+    d_element  = BerElementRef();
+    d_children.clear();
+}
+
+// ACCESSORS
+inline
+const char *BerElementIndex::buffer() const
+{
+    return d_buffer_p;
+}
+
+inline
+const BerElementRef& BerElementIndex::element() const
+{
+    BSLS_ASSERT_SAFE(!isEmpty());
+
+    return d_element;
+}
+
+inline
+int BerElementIndex::numChildren() const
+{
+    return static_cast<int>(d_children.size());
+}
+
+inline
+const BerElementRef& BerElementIndex::child(int index) const
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index < numChildren());
+
+    return d_children[index];
+}
+
+inline
+bool BerElementIndex::isEmpty() const
+{
+    return 0 == d_buffer_p;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+inline
+bool balber::operator==(const BerElementRef& lhs, const BerElementRef& rhs)
+{
+    return lhs.tagClass()           == rhs.tagClass()
+        && lhs.tagType()            == rhs.tagType()
+        && lhs.tagNumber()          == rhs.tagNumber()
+        && lhs.offset()             == rhs.offset()
+        && lhs.headerLength()       == rhs.headerLength()
+        && lhs.contentLength()      == rhs.contentLength()
+        && lhs.isIndefiniteLength() == rhs.isIndefiniteLength();
+}
+
+inline
+bool balber::operator!=(const BerElementRef& lhs, const BerElementRef& rhs)
+{
+    return !(lhs == rhs);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
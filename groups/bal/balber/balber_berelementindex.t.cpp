@@ -0,0 +1,816 @@
+// balber_berelementindex.t.cpp                                       -*-C++-*-
+#include <balber_berelementindex.h>
+
+#include <balber_berconstants.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                              TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides an unconstrained attribute type,
+// 'balber::BerElementRef', and a mechanism, 'balber::BerElementIndex', that
+// parses only the identifier and length octets of BER input.  The attribute
+// type is tested by constructing objects from values and comparing them.
+// The index is tested with tables of hand-written hexadecimal encodings,
+// covering definite and indefinite lengths, multi-octet tags and lengths,
+// nested elements, and malformed or truncated input.
+// ----------------------------------------------------------------------------
+// balber::BerElementRef
+// ---------------------
+// [ 2] BerElementRef();
+// [ 2] BerElementRef(TagClass, TagType, int, int, int, int, bool);
+// [ 2] BerConstants::TagClass tagClass() const;
+// [ 2] BerConstants::TagType tagType() const;
+// [ 2] int tagNumber() const;
+// [ 2] int offset() const;
+// [ 2] int headerLength() const;
+// [ 2] int contentOffset() const;
+// [ 2] int contentLength() const;
+// [ 2] bool isIndefiniteLength() const;
+// [ 2] int length() const;
+// [ 2] bool operator==(const BerElementRef&, const BerElementRef&);
+// [ 2] bool operator!=(const BerElementRef&, const BerElementRef&);
+//
+// balber::BerElementIndex
+// -----------------------
+// [ 3] explicit BerElementIndex(bslma::Allocator *basicAllocator = 0);
+// [ 3] int load(const char *buffer, bsl::size_t length);
+// [ 3] void reset();
+// [ 3] const char *buffer() const;
+// [ 3] const BerElementRef& element() const;
+// [ 3] int numChildren() const;
+// [ 3] const BerElementRef& child(int index) const;
+// [ 3] bool isEmpty() const;
+// [ 5] int find(int tagNumber) const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] MALFORMED INPUT
+// [ 6] USAGE EXAMPLE
+// ============================================================================
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                     NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_FAIL(expr) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(expr)
+#define ASSERT_SAFE_PASS(expr) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(expr)
+#define ASSERT_FAIL(expr)      BSLS_ASSERTTEST_ASSERT_FAIL(expr)
+#define ASSERT_PASS(expr)      BSLS_ASSERTTEST_ASSERT_PASS(expr)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef balber::BerElementRef   Ref;
+typedef balber::BerElementIndex Obj;
+typedef balber::BerConstants    Constants;
+
+// ============================================================================
+//                          GLOBAL HELPER FUNCTIONS
+// ----------------------------------------------------------------------------
+
+static
+bsl::vector<char> loadFromHex(const char *hexData)
+    // Return the octets described by the specified 'hexData', a sequence of
+    // pairs of hexadecimal digits, ignoring any spaces.
+{
+    bsl::vector<char> result;
+    int               numDigits = 0;
+    int               value     = 0;
+
+    for (; *hexData; ++hexData) {
+        const char c = *hexData;
+        int        digit;
+
+        if ('0' <= c && c <= '9') {
+            digit = c - '0';
+        }
+        else if ('A' <= c && c <= 'F') {
+            digit = c - 'A' + 10;
+        }
+        else if ('a' <= c && c <= 'f') {
+            digit = c - 'a' + 10;
+        }
+        else {
+            continue;
+        }
+
+        value = value * 16 + digit;
+        if (2 == ++numDigits) {
+            result.push_back(static_cast<char>(value));
+            numDigits = 0;
+            value     = 0;
+        }
+    }
+
+    return result;
+}
+
+static
+const char *dataOf(const bsl::vector<char>& data)
+    // Return the address of the first element of the specified 'data', or 0
+    // if 'data' is empty.
+{
+    return data.empty() ? 0 : &data[0];
+}
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int             test = argc > 1 ? atoi(argv[1]) : 0;
+    bool         verbose = argc > 2;
+    bool     veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, replace
+        //:   leading comment characters with spaces, replace 'assert' with
+        //:   'ASSERT', and insert 'if (veryVerbose)' before all output
+        //:   operations.  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Locating Attributes Without Decoding
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we receive the following BER encoding of a sequence having
+// three attributes: an integer with id 0, a string with id 1, and a nested
+// sequence with id 2 (holding a single integer with id 0):
+//..
+    const char ENCODING[] = {
+        0x30, 0x0E,                                // SEQUENCE, 14 bytes
+        char(0x80), 0x01, 0x22,                    // [0] 34
+        char(0x81), 0x03, 'a', 'b', 'c',           // [1] "abc"
+        char(0xA2), 0x04,                          // [2] SEQUENCE, 4 bytes
+                    char(0x80), 0x02, 0x01, 0x00   //     [0] 256
+    };
+//..
+// First, we load an index of the top-level sequence:
+//..
+    balber::BerElementIndex index;
+    int rc = index.load(ENCODING, sizeof ENCODING);
+    ASSERT(0 == rc);
+    ASSERT(3 == index.numChildren());
+//..
+// Then, we find the attribute having id 1 and verify its location:
+//..
+    const int i = index.find(1);
+    ASSERT(1 == i);
+
+    const balber::BerElementRef& child = index.child(i);
+    ASSERT(balber::BerConstants::e_CONTEXT_SPECIFIC == child.tagClass());
+    ASSERT(5 == child.offset());
+    ASSERT(5 == child.length());
+    ASSERT(0 == bsl::memcmp("abc",
+                            index.buffer() + child.contentOffset(),
+                            child.contentLength()));
+//..
+// Finally, we index the nested sequence (attribute id 2) in turn, using the
+// range occupied by that child:
+//..
+    const balber::BerElementRef& nested = index.child(index.find(2));
+
+    balber::BerElementIndex nestedIndex;
+    rc = nestedIndex.load(index.buffer() + nested.offset(), nested.length());
+    ASSERT(0 == rc);
+    ASSERT(1 == nestedIndex.numChildren());
+    ASSERT(2 == nestedIndex.child(0).contentLength());
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'find'
+        //
+        // Concerns:
+        //: 1 'find' returns the index of the first context-specific child
+        //:   having the specified tag number.
+        //:
+        //: 2 Children having a universal (or other non-context-specific) tag
+        //:   are not matched, even if their tag number matches.
+        //:
+        //: 3 'find' returns -1 if there is no matching child, including when
+        //:   the index is empty.
+        //
+        // Plan:
+        //: 1 Index an encoding having universal and context-specific children,
+        //:   including two having the same tag number, and verify the result
+        //:   of 'find' for each of a table of tag numbers.  (C-1..3)
+        //
+        // Testing:
+        //   int find(int tagNumber) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'find'" << endl
+                          << "==============" << endl;
+
+        const bsl::vector<char> data =
+                  loadFromHex("3010 020105 800122 810133 800144 9F1F0155");
+
+        Obj mX;  const Obj& X = mX;
+
+        ASSERT(-1 == X.find(0));
+
+        ASSERT(0 == mX.load(dataOf(data), data.size()));
+        ASSERT(5  == X.numChildren());
+
+        static const struct {
+            int d_line;
+            int d_tagNumber;
+            int d_expected;
+        } DATA[] = {
+            //LINE  TAG  EXP
+            //----  ---  ---
+            { L_,    0,   1 },
+            { L_,    1,   2 },
+            { L_,    2,  -1 },
+            { L_,    3,  -1 },
+            { L_,   31,   4 },
+            { L_,   32,  -1 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int LINE = DATA[ti].d_line;
+            const int TAG  = DATA[ti].d_tagNumber;
+            const int EXP  = DATA[ti].d_expected;
+
+            if (veryVerbose) { T_ P_(LINE) P_(TAG) P(EXP) }
+
+            ASSERTV(LINE, EXP, X.find(TAG), EXP == X.find(TAG));
+        }
+
+        mX.reset();
+        ASSERT(-1 == X.find(0));
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // MALFORMED INPUT
+        //
+        // Concerns:
+        //: 1 'load' fails if the indexed element is primitive.
+        //:
+        //: 2 'load' fails if the indexed element, or any of its children,
+        //:   extends past the end of the input.
+        //:
+        //: 3 'load' fails if a child extends past the end of the indexed
+        //:   element, even if it lies within the input.
+        //:
+        //: 4 'load' fails if a primitive element has an indefinite length, or
+        //:   if the end-of-contents octets of an element are missing.
+        //:
+        //: 5 After a failure, the index is empty, even if it was loaded
+        //:   before.
+        //
+        // Plan:
+        //: 1 Using a table of malformed encodings, verify that 'load' fails
+        //:   and leaves a previously loaded index empty.  (C-1..5)
+        //:
+        //: 2 Verify that 'load' fails for every proper prefix of several valid
+        //:   encodings.  (C-2, 4)
+        //
+        // Testing:
+        //   MALFORMED INPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MALFORMED INPUT" << endl
+                          << "===============" << endl;
+
+        const bsl::vector<char> valid = loadFromHex("3003 800122");
+
+        if (verbose) cout << "\nTesting a table of malformed input." << endl;
+        {
+            static const struct {
+                int         d_line;
+                const char *d_data;
+            } DATA[] = {
+                //LINE  DATA
+                //----  ----
+                { L_,   ""                             },
+                { L_,   "30"                           },
+                { L_,   "8001 22"                      },
+                { L_,   "3001"                         },
+                { L_,   "3003 8001"                    },
+                { L_,   "3003 820500"                  },
+                { L_,   "3002 8201 AA"                 },
+                { L_,   "3005 A2808201"                },
+                { L_,   "3080 800122"                  },
+                { L_,   "3080 800122 00"               },
+                { L_,   "3080 8080 0000"               },
+                { L_,   "3080 A280 800122 0000"        },
+                { L_,   "3085 0100000000 800122"       },
+                { L_,   "3006 A2808001220000"          },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int               LINE = DATA[ti].d_line;
+                const bsl::vector<char> DATA_V = loadFromHex(DATA[ti].d_data);
+
+                if (veryVerbose) { T_ P_(LINE) P(DATA[ti].d_data) }
+
+                Obj mX;  const Obj& X = mX;
+
+                ASSERTV(LINE, 0 == mX.load(dataOf(valid), valid.size()));
+                ASSERTV(LINE, !X.isEmpty());
+
+                ASSERTV(LINE, 0 != mX.load(dataOf(DATA_V), DATA_V.size()));
+                ASSERTV(LINE, X.isEmpty());
+                ASSERTV(LINE, 0 == X.buffer());
+                ASSERTV(LINE, 0 == X.numChildren());
+            }
+        }
+
+        if (verbose) cout << "\nTesting truncated input." << endl;
+        {
+            static const char *DATA[] = {
+                "300A 800122 810548656C6C6F",
+                "3080 800122 810548656C6C6F 0000",
+                "3011 A2808201990000 800122 810548656C6C6F",
+                "3080 A280A280820199000000000000",
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const bsl::vector<char> DATA_V = loadFromHex(DATA[ti]);
+
+                Obj mX;
+
+                ASSERTV(ti, 0 == mX.load(dataOf(DATA_V), DATA_V.size()));
+
+                for (bsl::size_t len = 0; len < DATA_V.size(); ++len) {
+                    ASSERTV(ti, len, 0 != mX.load(dataOf(DATA_V), len));
+                }
+            }
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'load'
+        //
+        // Concerns:
+        //: 1 A default-constructed index is empty.
+        //:
+        //: 2 'load' records the location and tag of every immediate child of
+        //:   the indexed element, and of the element itself, for definite and
+        //:   indefinite lengths, short- and long-form lengths, and multi-octet
+        //:   tag numbers.
+        //:
+        //: 3 Children nested in children are not indexed, but are stepped
+        //:   over, whether they have definite or indefinite lengths.
+        //:
+        //: 4 Octets following the indexed element are ignored.
+        //:
+        //: 5 'reset' returns the index to the empty state.
+        //:
+        //: 6 Any memory is supplied by the specified allocator.
+        //
+        // Plan:
+        //: 1 Using a table of encodings, each with a description of the
+        //:   expected children, load an index using a test allocator and
+        //:   verify the description of the element and of each child.
+        //:   (C-1..4, 6)
+        //:
+        //: 2 Reset each index and verify that it is empty.  (C-5)
+        //
+        // Testing:
+        //   explicit BerElementIndex(bslma::Allocator *basicAllocator = 0);
+        //   int load(const char *buffer, bsl::size_t length);
+        //   void reset();
+        //   const char *buffer() const;
+        //   const BerElementRef& element() const;
+        //   int numChildren() const;
+        //   const BerElementRef& child(int index) const;
+        //   bool isEmpty() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'load'" << endl
+                          << "==============" << endl;
+
+        enum { k_MAX_CHILDREN = 3 };
+
+        const Constants::TagClass U = Constants::e_UNIVERSAL;
+        const Constants::TagClass C = Constants::e_CONTEXT_SPECIFIC;
+        const Constants::TagType  R = Constants::e_PRIMITIVE;
+        const Constants::TagType  K = Constants::e_CONSTRUCTED;
+
+        struct Child {
+            Constants::TagClass d_tagClass;
+            Constants::TagType  d_tagType;
+            int                 d_tagNumber;
+            int                 d_offset;
+            int                 d_headerLength;
+            int                 d_contentLength;
+            bool                d_isIndefiniteLength;
+        };
+
+        static const struct {
+            int         d_line;
+            const char *d_data;
+            int         d_headerLength;     // of the indexed element
+            int         d_contentLength;    // of the indexed element
+            bool        d_isIndefinite;     // of the indexed element
+            int         d_numChildren;
+            Child       d_children[k_MAX_CHILDREN];
+        } DATA[] = {
+            { L_, "3000",                                  2,  0, false, 0,
+              { } },
+            { L_, "3003 800122",                           2,  3, false, 1,
+              { { C, R,  0,  2, 2,  1, false } } },
+            { L_, "3003 800122 FFFF",                      2,  3, false, 1,
+              { { C, R,  0,  2, 2,  1, false } } },
+            { L_, "300A 800122 810548656C6C6F",            2, 10, false, 2,
+              { { C, R,  0,  2, 2,  1, false },
+                { C, R,  1,  5, 2,  5, false } } },
+            { L_, "3080 800122 810548656C6C6F 0000",       2, 10, true,  2,
+              { { C, R,  0,  2, 2,  1, false },
+                { C, R,  1,  5, 2,  5, false } } },
+            { L_, "300F A203820199 800122 810548656C6C6F", 2, 15, false, 3,
+              { { C, K,  2,  2, 2,  3, false },
+                { C, R,  0,  7, 2,  1, false },
+                { C, R,  1, 10, 2,  5, false } } },
+            { L_, "300D A2808201990000 800122 0201FF",     2, 13, false, 3,
+              { { C, K,  2,  2, 2,  3, true  },
+                { C, R,  0,  9, 2,  1, false },
+                { U, R,  2, 12, 2,  1, false } } },
+            { L_, "3080 A280A280820199000000000000",       2, 11, true,  1,
+              { { C, K,  2,  2, 2,  7, true  } } },
+            { L_, "3004 9F1F0100",                         2,  4, false, 1,
+              { { C, R, 31,  2, 3,  1, false } } },
+            { L_, "308103 800122",                         3,  3, false, 1,
+              { { C, R,  0,  3, 2,  1, false } } },
+            { L_, "3007 A1058103000000",                   2,  7, false, 1,
+              { { C, K,  1,  2, 2,  5, false } } },
+            { L_, "3005 8182000100",                       2,  5, false, 1,
+              { { C, R,  1,  2, 4,  1, false } } },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        bslma::TestAllocator da("default",   veryVerbose);
+        bslma::TestAllocator oa("object",    veryVerbose);
+
+        bslma::DefaultAllocatorGuard dag(&da);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int               LINE   = DATA[ti].d_line;
+            const int               HLEN   = DATA[ti].d_headerLength;
+            const int               CLEN   = DATA[ti].d_contentLength;
+            const bool              INDEF  = DATA[ti].d_isIndefinite;
+            const int               NUM    = DATA[ti].d_numChildren;
+            const bsl::vector<char> DATA_V = loadFromHex(DATA[ti].d_data);
+
+            if (veryVerbose) { T_ P_(LINE) P(DATA[ti].d_data) }
+
+            Obj mX(&oa);  const Obj& X = mX;
+
+            ASSERTV(LINE, X.isEmpty());
+            ASSERTV(LINE, 0 == X.buffer());
+            ASSERTV(LINE, 0 == X.numChildren());
+
+            const bsls::Types::Int64 NUM_DEFAULT_BLOCKS = da.numBlocksTotal();
+
+            ASSERTV(LINE, 0 == mX.load(dataOf(DATA_V), DATA_V.size()));
+
+            ASSERTV(LINE, NUM_DEFAULT_BLOCKS == da.numBlocksTotal());
+            ASSERTV(LINE, !X.isEmpty());
+            ASSERTV(LINE, dataOf(DATA_V) == X.buffer());
+
+            const Ref EXP_ELEMENT(U, K, 16, 0, HLEN, CLEN, INDEF);
+            ASSERTV(LINE, EXP_ELEMENT == X.element());
+
+            ASSERTV(LINE, NUM, X.numChildren(), NUM == X.numChildren());
+            for (int j = 0; j < NUM && j < X.numChildren(); ++j) {
+                const Child& EXP = DATA[ti].d_children[j];
+
+                const Ref EXP_CHILD(EXP.d_tagClass,
+                                    EXP.d_tagType,
+                                    EXP.d_tagNumber,
+                                    EXP.d_offset,
+                                    EXP.d_headerLength,
+                                    EXP.d_contentLength,
+                                    EXP.d_isIndefiniteLength);
+
+                ASSERTV(LINE, j, EXP_CHILD == X.child(j));
+            }
+
+            if (0 < NUM) {
+                ASSERTV(LINE, 0 < oa.numBlocksInUse());
+            }
+
+            mX.reset();
+
+            ASSERTV(LINE, X.isEmpty());
+            ASSERTV(LINE, 0 == X.buffer());
+            ASSERTV(LINE, 0 == X.numChildren());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            const bsl::vector<char> DATA_V = loadFromHex("3003 800122");
+
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT_FAIL(mX.load(0, 1));
+            ASSERT_PASS(mX.load(0, 0));
+
+            ASSERT_SAFE_FAIL(X.element());
+            ASSERT_SAFE_FAIL(X.child(0));
+
+            ASSERT(0 == mX.load(dataOf(DATA_V), DATA_V.size()));
+
+            ASSERT_SAFE_PASS(X.element());
+            ASSERT_SAFE_FAIL(X.child(-1));
+            ASSERT_SAFE_PASS(X.child(0));
+            ASSERT_SAFE_FAIL(X.child(1));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'BerElementRef'
+        //
+        // Concerns:
+        //: 1 The default constructor creates a reference to an empty,
+        //:   universal, primitive element at offset 0.
+        //:
+        //: 2 The value constructor sets each attribute, and each accessor
+        //:   returns the corresponding attribute.
+        //:
+        //: 3 'contentOffset' and 'length' are computed from the attributes,
+        //:   and 'length' includes the end-of-contents octets of an element
+        //:   having an indefinite length.
+        //:
+        //: 4 Two objects compare equal if and only if every attribute is the
+        //:   same.
+        //:
+        //: 5 Precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Default-construct an object and verify its attributes.  (C-1)
+        //:
+        //: 2 Construct an object from values, verify each accessor, and then
+        //:   compare it with objects that differ in exactly one attribute.
+        //:   (C-2..4)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid attribute values.  (C-5)
+        //
+        // Testing:
+        //   BerElementRef();
+        //   BerElementRef(TagClass, TagType, int, int, int, int, bool);
+        //   BerConstants::TagClass tagClass() const;
+        //   BerConstants::TagType tagType() const;
+        //   int tagNumber() const;
+        //   int offset() const;
+        //   int headerLength() const;
+        //   int contentOffset() const;
+        //   int contentLength() const;
+        //   bool isIndefiniteLength() const;
+        //   int length() const;
+        //   bool operator==(const BerElementRef&, const BerElementRef&);
+        //   bool operator!=(const BerElementRef&, const BerElementRef&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'BerElementRef'" << endl
+                          << "=======================" << endl;
+
+        const Constants::TagClass U = Constants::e_UNIVERSAL;
+        const Constants::TagClass C = Constants::e_CONTEXT_SPECIFIC;
+        const Constants::TagType  R = Constants::e_PRIMITIVE;
+        const Constants::TagType  K = Constants::e_CONSTRUCTED;
+
+        if (verbose) cout << "\nTesting the default constructor." << endl;
+        {
+            const Ref X;
+
+            ASSERT(U     == X.tagClass());
+            ASSERT(R     == X.tagType());
+            ASSERT(0     == X.tagNumber());
+            ASSERT(0     == X.offset());
+            ASSERT(2     == X.headerLength());
+            ASSERT(2     == X.contentOffset());
+            ASSERT(0     == X.contentLength());
+            ASSERT(false == X.isIndefiniteLength());
+            ASSERT(2     == X.length());
+        }
+
+        if (verbose) cout << "\nTesting the value constructor." << endl;
+        {
+            const Ref X(C, K, 7, 10, 3, 20, false);
+
+            ASSERT(C     == X.tagClass());
+            ASSERT(K     == X.tagType());
+            ASSERT(7     == X.tagNumber());
+            ASSERT(10    == X.offset());
+            ASSERT(3     == X.headerLength());
+            ASSERT(13    == X.contentOffset());
+            ASSERT(20    == X.contentLength());
+            ASSERT(false == X.isIndefiniteLength());
+            ASSERT(23    == X.length());
+
+            const Ref Y(C, K, 7, 10, 3, 20, true);
+
+            ASSERT(true  == Y.isIndefiniteLength());
+            ASSERT(25    == Y.length());
+        }
+
+        if (verbose) cout << "\nTesting equality." << endl;
+        {
+            const Ref X(C, K, 7, 10, 3, 20, false);
+
+            const Ref DIFFERENT[] = {
+                Ref(U, K, 7, 10, 3, 20, false),
+                Ref(C, R, 7, 10, 3, 20, false),
+                Ref(C, K, 8, 10, 3, 20, false),
+                Ref(C, K, 7, 11, 3, 20, false),
+                Ref(C, K, 7, 10, 4, 20, false),
+                Ref(C, K, 7, 10, 3, 21, false),
+                Ref(C, K, 7, 10, 3, 20, true),
+            };
+            const int NUM_DIFFERENT = sizeof DIFFERENT / sizeof *DIFFERENT;
+
+            ASSERT(  X == Ref(C, K, 7, 10, 3, 20, false));
+            ASSERT(!(X != Ref(C, K, 7, 10, 3, 20, false)));
+
+            for (int i = 0; i < NUM_DIFFERENT; ++i) {
+                ASSERTV(i, !(X == DIFFERENT[i]));
+                ASSERTV(i,   X != DIFFERENT[i]);
+            }
+
+            Ref mY;  const Ref& Y = mY;
+            ASSERT(X != Y);
+            mY = X;
+            ASSERT(X == Y);
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_SAFE_PASS(Ref(C, K,  0,  0,  2,  0, false));
+            ASSERT_SAFE_FAIL(Ref(C, K, -1,  0,  2,  0, false));
+            ASSERT_SAFE_FAIL(Ref(C, K,  0, -1,  2,  0, false));
+            ASSERT_SAFE_FAIL(Ref(C, K,  0,  0,  1,  0, false));
+            ASSERT_SAFE_FAIL(Ref(C, K,  0,  0,  2, -1, false));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Index an encoded sequence, then index one of its children.
+        //:   (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        const bsl::vector<char> data =
+                  loadFromHex("300F A203820199 800122 810548656C6C6F");
+
+        Obj mX;  const Obj& X = mX;
+        ASSERT(X.isEmpty());
+
+        ASSERT(0 == mX.load(dataOf(data), data.size()));
+        ASSERT(!X.isEmpty());
+        ASSERT(3  == X.numChildren());
+        ASSERT(17 == X.element().length());
+
+        ASSERT(0 == X.find(2));
+        ASSERT(1 == X.find(0));
+        ASSERT(2 == X.find(1));
+
+        const Ref& CHILD = X.child(X.find(2));
+
+        Obj mY;  const Obj& Y = mY;
+        ASSERT(0 == mY.load(X.buffer() + CHILD.offset(), CHILD.length()));
+        ASSERT(1 == Y.numChildren());
+        ASSERT(2 == Y.child(0).tagNumber());
+        ASSERT(1 == Y.child(0).contentLength());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -26,6 +26,49 @@ balber::BerEncoder::MemOutStream::~MemOutStream()
 {
 }
 
+                 // -----------------------------------------
+                 // class balber::BerEncoder::SizingStreamBuf
+                 // -----------------------------------------
+
+// CREATORS
+balber::BerEncoder::SizingStreamBuf::SizingStreamBuf()
+: d_numFlushed(0)
+{
+    setp(d_buffer, d_buffer + k_BUFFER_SIZE);
+}
+
+balber::BerEncoder::SizingStreamBuf::~SizingStreamBuf()
+{
+}
+
+// PROTECTED MANIPULATORS
+balber::BerEncoder::SizingStreamBuf::int_type
+balber::BerEncoder::SizingStreamBuf::overflow(int_type c)
+{
+    d_numFlushed += static_cast<int>(pptr() - pbase());
+    setp(d_buffer, d_buffer + k_BUFFER_SIZE);
+
+    if (!traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+bsl::streamsize
+balber::BerEncoder::SizingStreamBuf::xsputn(const char      *,
+                                            bsl::streamsize  numChars)
+{
+    d_numFlushed += static_cast<int>(numChars);
+    return numChars;
+}
+
+// ACCESSORS
+int balber::BerEncoder::SizingStreamBuf::length() const
+{
+    return d_numFlushed + static_cast<int>(pptr() - pbase());
+}
+
 namespace balber {
 
                               // ----------------
@@ -35,12 +78,15 @@ namespace balber {
 // CREATORS
 BerEncoder::BerEncoder(const BerEncoderOptions *options,
                        bslma::Allocator        *basicAllocator)
-: d_options      (options)
-, d_allocator    (bslma::Default::allocator(basicAllocator))
-, d_logStream    (0)
-, d_severity     (e_BER_SUCCESS)
-, d_streamBuf    (0)
-, d_currentDepth (0)
+: d_options          (options)
+, d_allocator        (bslma::Default::allocator(basicAllocator))
+, d_logStream        (0)
+, d_severity         (e_BER_SUCCESS)
+, d_streamBuf        (0)
+, d_currentDepth     (0)
+, d_sizingStreamBuf_p(0)
+, d_lengths          (d_allocator)
+, d_lengthIndex      (0)
 {
 }
 
@@ -122,6 +168,51 @@ BerEncoder::logMsg(const char             *msg,
     return d_severity;
 }
 
+int BerEncoder::putConstructedLength(int *index)
+{
+    BSLS_ASSERT(index);
+
+    if (!d_options->encodeDefiniteLength()) {
+        *index = -1;
+        return BerUtil::putIndefiniteLengthOctet(d_streamBuf);        // RETURN
+    }
+
+    if (d_sizingStreamBuf_p) {
+        // Remember where the contents start; the length is computed, and its
+        // octets counted, by 'putConstructedEnd'.
+
+        *index = static_cast<int>(d_lengths.size());
+        d_lengths.push_back(d_sizingStreamBuf_p->length());
+        return 0;                                                     // RETURN
+    }
+
+    BSLS_ASSERT(d_lengthIndex < static_cast<int>(d_lengths.size()));
+
+    *index = d_lengthIndex;
+    return BerUtil::putLength(d_streamBuf, d_lengths[d_lengthIndex++]);
+}
+
+int BerEncoder::putConstructedEnd(int index)
+{
+    if (!d_options->encodeDefiniteLength()) {
+        return BerUtil::putEndOfContentOctets(d_streamBuf);           // RETURN
+    }
+
+    if (d_sizingStreamBuf_p) {
+        // Replace the recorded start of the contents with their length, and
+        // account for the length octets in the size of the enclosing value.
+
+        BSLS_ASSERT(0 <= index);
+        BSLS_ASSERT(index < static_cast<int>(d_lengths.size()));
+
+        const int length = d_sizingStreamBuf_p->length() - d_lengths[index];
+        d_lengths[index] = length;
+        return BerUtil::putLength(d_streamBuf, length);               // RETURN
+    }
+
+    return 0;
+}
+
 int BerEncoder::encodeImpl(const bsl::vector<char>&  value,
                            BerConstants::TagClass    tagClass,
                            int                       tagNumber,
@@ -33,6 +33,31 @@ BSLS_IDENT("$Id: $")
 // This component encodes objects based on the X.690 BER specification.  It can
 // only be used with types supported by the 'bdlat' framework.
 //
+///Definite-Length Encoding
+///------------------------
+// By default, constructed types (sequences, choices, nillable values, and
+// arrays) are encoded using the indefinite-length form: the contents are
+// written as they are visited and terminated by end-of-contents octets, so
+// the encoder never needs to know the size of a constructed value before
+// writing it.  Some peers require the definite-length form, in which every
+// constructed value is preceded by the exact length of its contents.  This
+// form is enabled by the 'EncodeDefiniteLength' attribute of
+// 'balber::BerEncoderOptions'.
+//
+// Rather than encoding nested values into temporary buffers to learn their
+// lengths, the encoder makes two traversals of the value when
+// 'EncodeDefiniteLength' is 'true'.  The first traversal encodes into a
+// private sizing stream buffer that discards its output and only counts
+// bytes, recording the content length of each constructed value in the order
+// in which they are visited.  The second traversal writes the encoding
+// directly to the destination stream buffer, emitting the recorded lengths.
+// Note that the encoded contents are thus produced twice, but are copied
+// exactly once, into the destination stream buffer.
+//
+// The vector of recorded lengths is retained by the encoder between calls to
+// 'encode', so that reusing an encoder object for messages of a similar shape
+// does not allocate.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -321,6 +346,51 @@ class BerEncoder {
             // characters appended to the stream, if any.
     };
 
+    class SizingStreamBuf : public bsl::streambuf {
+        // This class provides a stream buffer that discards the characters
+        // written to it, keeping only a count of them.  It is used to compute
+        // the lengths of constructed values when encoding with definite
+        // lengths.
+
+        // PRIVATE CONSTANTS
+        enum { k_BUFFER_SIZE = 256 };
+
+        // DATA
+        char d_buffer[k_BUFFER_SIZE];  // scratch put area
+        int  d_numFlushed;             // count of characters no longer in
+                                       // the put area
+
+        // NOT IMPLEMENTED
+        SizingStreamBuf(const SizingStreamBuf&);             // = delete;
+        SizingStreamBuf& operator=(const SizingStreamBuf&);  // = delete;
+
+      protected:
+        // PROTECTED MANIPULATORS
+        virtual int_type overflow(int_type c);
+            // Discard the contents of the put area, adding their count to the
+            // number of characters written, and then append the specified
+            // character 'c' unless it is 'traits_type::eof()'.  Return a
+            // value other than 'traits_type::eof()'.
+
+        virtual bsl::streamsize xsputn(const char      *s,
+                                       bsl::streamsize  numChars);
+            // Count, without copying, the specified 'numChars' characters
+            // from the specified 's'.  Return 'numChars'.
+
+      public:
+        // CREATORS
+        SizingStreamBuf();
+            // Create a sizing stream buffer to which no characters have been
+            // written.
+
+        virtual ~SizingStreamBuf();
+            // Destroy this stream buffer.
+
+        // ACCESSORS
+        int length() const;
+            // Return the number of characters written to this stream buffer.
+    };
+
   public:
     // PUBLIC TYPES
     enum ErrorSeverity {
@@ -346,6 +416,19 @@ class BerEncoder {
     bsl::streambuf                   *d_streamBuf;      // held, not owned
     int                               d_currentDepth;   // current depth
 
+    SizingStreamBuf                  *d_sizingStreamBuf_p;
+        // sizing stream buffer during the first of the two traversals made
+        // when encoding with definite lengths, and 0 otherwise (held, not
+        // owned)
+
+    bsl::vector<int>                  d_lengths;
+        // content lengths of the constructed values of the value being
+        // encoded with definite lengths, in the order in which they are
+        // visited
+
+    int                               d_lengthIndex;
+        // index in 'd_lengths' of the next constructed value to be written
+
     // NOT IMPLEMENTED
     BerEncoder(const BerEncoder&);             // = delete;
     BerEncoder& operator=(const BerEncoder&);  // = delete;
@@ -369,6 +452,26 @@ class BerEncoder {
         // Return the stream for logging.  Note the if stream has not been
         // created yet, it will be created during this call.
 
+    int putConstructedLength(int *index);
+        // Encode the length octets of a constructed value whose identifier
+        // octets have just been written, and load into the specified 'index'
+        // a value to be supplied to 'putConstructedEnd' once the contents of
+        // the constructed value have been written.  Return 0 on success, and
+        // a non-zero value otherwise.
+
+    int putConstructedEnd(int index);
+        // Complete the encoding of the constructed value whose length octets
+        // were encoded by the call to 'putConstructedLength' that loaded the
+        // specified 'index', after its contents have been written.  Return 0
+        // on success, and a non-zero value otherwise.
+
+    template <typename TYPE>
+    int encodeValue(const TYPE& value);
+        // Encode the specified 'value' as a universal element to the stream
+        // buffer supplied to 'encode', making a sizing traversal first if
+        // the options specify definite-length encoding.  Return 0 on success,
+        // and a non-zero value otherwise.
+
     int encodeImpl(const bsl::vector<char>&  value,
                    BerConstants::TagClass    tagClass,
                    int                       tagNumber,
@@ -738,18 +841,11 @@ int BerEncoder::encode(bsl::streambuf *streamBuf, const TYPE& value)
     if (! d_options) {
         BerEncoderOptions options;  // temporary options object
         d_options = &options;
-        BerEncoder_UniversalElementVisitor visitor(
-                                              this,
-                                              bdlat_FormattingMode::e_DEFAULT);
-
-        rc = visitor(value);
+        rc = encodeValue(value);
         d_options = 0;
     }
     else {
-        BerEncoder_UniversalElementVisitor visitor(
-                                              this,
-                                              bdlat_FormattingMode::e_DEFAULT);
-        rc = visitor(value);
+        rc = encodeValue(value);
     }
 
     d_streamBuf = 0;
@@ -774,6 +870,40 @@ int BerEncoder::encode(bsl::ostream& stream, const TYPE& value)
 }
 
 // PRIVATE MANIPULATORS
+template <typename TYPE>
+int BerEncoder::encodeValue(const TYPE& value)
+{
+    if (d_options->encodeDefiniteLength()) {
+        bsl::streambuf  *streamBuf = d_streamBuf;
+        SizingStreamBuf  sizingStreamBuf;
+
+        d_lengths.clear();
+        d_streamBuf         = &sizingStreamBuf;
+        d_sizingStreamBuf_p = &sizingStreamBuf;
+
+        int rc;
+        {
+            BerEncoder_UniversalElementVisitor visitor(
+                                              this,
+                                              bdlat_FormattingMode::e_DEFAULT);
+            rc = visitor(value);
+        }
+
+        d_streamBuf         = streamBuf;
+        d_sizingStreamBuf_p = 0;
+        d_lengthIndex       = 0;
+
+        if (rc) {
+            return rc;                                                // RETURN
+        }
+    }
+
+    BerEncoder_UniversalElementVisitor visitor(
+                                              this,
+                                              bdlat_FormattingMode::e_DEFAULT);
+    return visitor(value);
+}
+
 template <typename TYPE>
 int BerEncoder::encodeImpl(const TYPE&                value,
                            BerConstants::TagClass     tagClass,
@@ -785,17 +915,19 @@ int BerEncoder::encodeImpl(const TYPE&                value,
 
     const BerConstants::TagType tagType = BerConstants::e_CONSTRUCTED;
 
+    int outerIndex;
     int rc = BerUtil::putIdentifierOctets(d_streamBuf,
                                           tagClass,
                                           tagType,
                                           tagNumber);
-    if (rc | BerUtil::putIndefiniteLengthOctet(d_streamBuf)) {
+    if (rc | putConstructedLength(&outerIndex)) {
         return k_FAILURE;                                             // RETURN
     }
 
     const bool isUntagged = formattingMode
                           & bdlat_FormattingMode::e_UNTAGGED;
 
+    int innerIndex = 0;
     if (!isUntagged) {
         // According to X.694 (clause 20.4), an XML choice (not anonymous)
         // element is encoded as a sequence with 1 element.
@@ -804,7 +936,7 @@ int BerEncoder::encodeImpl(const TYPE&                value,
                                           BerConstants::e_CONTEXT_SPECIFIC,
                                           tagType,
                                           0);
-        if (rc | BerUtil::putIndefiniteLengthOctet(d_streamBuf)) {
+        if (rc | putConstructedLength(&innerIndex)) {
             return k_FAILURE;
         }
     }
@@ -827,10 +959,10 @@ int BerEncoder::encodeImpl(const TYPE&                value,
         // Don't waste time checking the result of this call -- the only thing
         // that can go wrong is eof, which will happen again when we call it
         // again below.
-        BerUtil::putEndOfContentOctets(d_streamBuf);
+        putConstructedEnd(innerIndex);
     }
 
-    return BerUtil::putEndOfContentOctets(d_streamBuf);
+    return putConstructedEnd(outerIndex);
 }
 
 template <typename TYPE>
@@ -848,11 +980,12 @@ int BerEncoder::encodeImpl(const TYPE&                       value,
 
         // nillable is encoded in BER as a sequence with one optional element
 
+        int index;
         int rc = BerUtil::putIdentifierOctets(d_streamBuf,
                                               tagClass,
                                               BerConstants::e_CONSTRUCTED,
                                               tagNumber);
-        if (rc | BerUtil::putIndefiniteLengthOctet(d_streamBuf)) {
+        if (rc | putConstructedLength(&index)) {
             return k_FAILURE;
         }
 
@@ -870,7 +1003,7 @@ int BerEncoder::encodeImpl(const TYPE&                       value,
             }
         } // end of bdlat_NullableValueFunctions::isNull(...)
 
-        return BerUtil::putEndOfContentOctets(d_streamBuf);
+        return putConstructedEnd(index);
     } // end of isNillable
 
     if (!bdlat_NullableValueFunctions::isNull(value)) {
@@ -940,17 +1073,18 @@ int BerEncoder::encodeImpl(const TYPE&                  value,
 {
     BerEncoder_Visitor visitor(this);
 
+    int index;
     int rc = BerUtil::putIdentifierOctets(d_streamBuf,
                                           tagClass,
                                           BerConstants::e_CONSTRUCTED,
                                           tagNumber);
-    rc |= BerUtil::putIndefiniteLengthOctet(d_streamBuf);
+    rc |= putConstructedLength(&index);
     if (rc) {
         return rc;
     }
 
     rc = bdlat_SequenceFunctions::accessAttributes(value, visitor);
-    rc |= BerUtil::putEndOfContentOctets(d_streamBuf);
+    rc |= putConstructedEnd(index);
 
     return rc;
 }
@@ -1008,11 +1142,12 @@ BerEncoder::encodeArrayImpl(const TYPE&             value,
 
     const BerConstants::TagType tagType = BerConstants::e_CONSTRUCTED;
 
+    int index;
     int rc = BerUtil::putIdentifierOctets(d_streamBuf,
                                           tagClass,
                                           tagType,
                                           tagNumber);
-    rc |= BerUtil::putIndefiniteLengthOctet(d_streamBuf);
+    rc |= putConstructedLength(&index);
     if (rc) {
         return k_FAILURE;                                             // RETURN
     }
@@ -1031,7 +1166,7 @@ BerEncoder::encodeArrayImpl(const TYPE&             value,
         }
     }
 
-    return BerUtil::putEndOfContentOctets(d_streamBuf);
+    return putConstructedEnd(index);
 }
 
 template <typename TYPE>
@@ -11,6 +11,7 @@
 #include <balber_berencoder.h>
 
 #include <balber_berconstants.h>
+#include <balber_berdecoder.h>
 #include <balber_berutil.h>
 
 #include <bdlat_attributeinfo.h>
@@ -39,6 +40,7 @@
 #include <bsl_iomanip.h>
 
 #include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
 #include <bsl_cctype.h>
 
 #include <bsl_climits.h>
@@ -55,7 +57,9 @@ using bsl::flush;
 // ============================================================================
 //                                 TEST PLAN
 // ----------------------------------------------------------------------------
-
+// ----------------------------------------------------------------------------
+// [15] CONCERN: 'EncodeDefiniteLength' option
+// [-2] PERFORMANCE TEST: DEFINITE-LENGTH ENCODING
 // ----------------------------------------------------------------------------
 
 // ============================================================================
@@ -207,6 +211,98 @@ void printDiagnostic(balber::BerEncoder & encoder)
     }
 }
 
+int verifyDefiniteLengths(bsl::streambuf *streamBuf, int length)
+    // Read from the specified 'streamBuf' BER elements occupying exactly the
+    // specified 'length' octets, recursing into constructed elements.  Return
+    // 0 if every element has a definite length consistent with the length of
+    // its enclosing element, and a non-zero value otherwise.
+{
+    int numConsumed = 0;
+    while (numConsumed < length) {
+        balber::BerConstants::TagClass tagClass;
+        balber::BerConstants::TagType  tagType;
+        int                            tagNumber;
+        int                            contentLength;
+
+        if (0 != balber::BerUtil::getIdentifierOctets(streamBuf,
+                                                      &tagClass,
+                                                      &tagType,
+                                                      &tagNumber,
+                                                      &numConsumed)
+         || 0 != balber::BerUtil::getLength(streamBuf,
+                                            &contentLength,
+                                            &numConsumed)
+         || balber::BerUtil::e_INDEFINITE_LENGTH == contentLength
+         || length - numConsumed < contentLength) {
+            return -1;                                                // RETURN
+        }
+
+        if (balber::BerConstants::e_CONSTRUCTED == tagType) {
+            if (0 != verifyDefiniteLengths(streamBuf, contentLength)) {
+                return -1;                                            // RETURN
+            }
+        }
+        else {
+            for (int i = 0; i < contentLength; ++i) {
+                streamBuf->sbumpc();
+            }
+        }
+        numConsumed += contentLength;
+    }
+    return numConsumed == length ? 0 : -1;
+}
+
+template <class TYPE>
+void testDefiniteLengthRoundTrip(int line, const TYPE& value)
+    // Encode the specified 'value' using both the definite-length and the
+    // indefinite-length forms, and verify that the definite-length encoding
+    // is well formed, is no longer than the indefinite-length encoding, and
+    // decodes to 'value'.  Use the specified 'line' to report failures.
+{
+    balber::BerEncoderOptions definiteOptions;
+    definiteOptions.setEncodeDefiniteLength(true);
+
+    balber::BerEncoder     definiteEncoder(&definiteOptions);
+    balber::BerEncoder     indefiniteEncoder;
+    bdlsb::MemOutStreamBuf definiteOsb;
+    bdlsb::MemOutStreamBuf indefiniteOsb;
+
+    ASSERTV(line, 0 == definiteEncoder.encode(&definiteOsb, value));
+    ASSERTV(line, 0 == indefiniteEncoder.encode(&indefiniteOsb, value));
+    printDiagnostic(definiteEncoder);
+
+    const int length = static_cast<int>(definiteOsb.length());
+
+    if (veryVerbose) {
+        P_(line) P(length)
+        printBuffer(definiteOsb.data(), length);
+    }
+
+    ASSERTV(line, length, indefiniteOsb.length(),
+            length <= static_cast<int>(indefiniteOsb.length()));
+
+    {
+        bdlsb::FixedMemInStreamBuf isb(definiteOsb.data(), length);
+        ASSERTV(line, 0 == verifyDefiniteLengths(&isb, length));
+    }
+
+    {
+        bdlsb::FixedMemInStreamBuf isb(definiteOsb.data(), length);
+        balber::BerDecoder         decoder;
+        TYPE                       decoded;
+
+        ASSERTV(line, 0 == decoder.decode(&isb, &decoded));
+        ASSERTV(line, value == decoded);
+    }
+
+    // Encoding again with the same encoder yields the same octets.
+
+    bdlsb::MemOutStreamBuf osb;
+    ASSERTV(line, 0 == definiteEncoder.encode(&osb, value));
+    ASSERTV(line, length == static_cast<int>(osb.length()));
+    ASSERTV(line, 0 == bsl::memcmp(osb.data(), definiteOsb.data(), length));
+}
+
 // ============================================================================
 //                     GLOBAL HELPER CLASSES FOR TESTING
 // ----------------------------------------------------------------------------
@@ -9349,6 +9445,141 @@ int main(int argc, char *argv[])
     bsl::cout << "TEST " << __FILE__ << " CASE " << test << bsl::endl;;
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 15: {
+        // --------------------------------------------------------------------
+        // TESTING DEFINITE-LENGTH ENCODING
+        //
+        // Concerns:
+        //: 1 When 'EncodeDefiniteLength' is 'true', every constructed value
+        //:   (sequence, choice, nillable value, and array) is encoded with a
+        //:   definite length equal to the size of its contents, and no
+        //:   end-of-contents octets are written.
+        //:
+        //: 2 Lengths that do not fit in the short form (i.e., 128 octets or
+        //:   more) are encoded in the long form.
+        //:
+        //: 3 The definite-length encoding decodes to the original value.
+        //:
+        //: 4 An encoder object can be reused, and encoding the same value
+        //:   again produces the same octets.
+        //:
+        //: 5 The default (indefinite-length) encoding is unaffected.
+        //
+        // Plan:
+        //: 1 Encode a simple sequence with and without the option, and
+        //:   compare the results against the expected octets.  (C-1, 5)
+        //:
+        //: 2 For values of each constructed category, including nested and
+        //:   large values, encode with both forms, walk the definite-length
+        //:   encoding to verify that each length is consistent with its
+        //:   enclosing element, decode it with 'balber::BerDecoder', and
+        //:   encode it again with the same encoder.  (C-1..4)
+        //
+        // Testing:
+        //   CONCERN: 'EncodeDefiniteLength' option
+        // --------------------------------------------------------------------
+
+        if (verbose) bsl::cout << "\nTESTING DEFINITE-LENGTH ENCODING"
+                               << "\n================================"
+                               << bsl::endl;
+
+        if (verbose) bsl::cout << "\nTesting expected octets." << bsl::endl;
+        {
+            test::MySequence value;
+            value.attribute1() = 34;
+            value.attribute2() = "Hello";
+
+            const char INDEFINITE[] = "30 80 80 01 22 81 05 48656c6c6f 00 00";
+            const char DEFINITE[]   = "30 0a 80 01 22 81 05 48656c6c6f";
+
+            bdlsb::MemOutStreamBuf osb;
+
+            ASSERT(0 == encoder.encode(&osb, value));
+            ASSERT(numOctets(INDEFINITE) == static_cast<int>(osb.length()));
+            ASSERT(0 == compareBuffers(osb.data(), INDEFINITE));
+
+            balber::BerEncoderOptions options;
+            options.setEncodeDefiniteLength(true);
+            balber::BerEncoder        definiteEncoder(&options);
+
+            osb.pubseekpos(0);
+            ASSERT(0 == definiteEncoder.encode(&osb, value));
+            printDiagnostic(definiteEncoder);
+
+            if (veryVerbose) {
+                P(osb.length())
+                printBuffer(osb.data(), static_cast<int>(osb.length()));
+            }
+
+            ASSERT(numOctets(DEFINITE) == static_cast<int>(osb.length()));
+            ASSERT(0 == compareBuffers(osb.data(), DEFINITE));
+        }
+
+        if (verbose) bsl::cout << "\nTesting round trips." << bsl::endl;
+        {
+            test::MySequence sequence;
+            sequence.attribute1() = 34;
+            sequence.attribute2() = "Hello";
+            testDefiniteLengthRoundTrip(L_, sequence);
+
+            test::MySequenceWithNillable nillable;
+            nillable.attribute1() = 34;
+            nillable.attribute2() = "Hello";
+            testDefiniteLengthRoundTrip(L_, nillable);
+
+            nillable.myNillable() = "World!";
+            testDefiniteLengthRoundTrip(L_, nillable);
+
+            test::MySequenceWithArray array;
+            array.attribute1() = 34;
+            testDefiniteLengthRoundTrip(L_, array);
+
+            array.attribute2().push_back("Hello");
+            array.attribute2().push_back("World!");
+            testDefiniteLengthRoundTrip(L_, array);
+
+            test::MySequenceWithAnonymousChoice anonymous;
+            anonymous.attribute1() = 34;
+            anonymous.attribute2() = "Hello";
+            anonymous.choice().makeMyChoice2("World!");
+            testDefiniteLengthRoundTrip(L_, anonymous);
+
+            test::Employee employee;
+            employee.name()                 = "Bob";
+            employee.homeAddress().street() = "Some Street";
+            employee.homeAddress().city()   = "Some City";
+            employee.homeAddress().state()  = "Some State";
+            employee.age()                  = 21;
+            testDefiniteLengthRoundTrip(L_, employee);
+
+            test::BasicRecord basicRec;
+            basicRec.i1() = 11;
+            basicRec.i2() = 22;
+            basicRec.dt() = bdlt::DatetimeTz(
+                                   bdlt::Datetime(bdlt::Date(2007, 9, 3),
+                                                  bdlt::Time(16, 30)), 0);
+            basicRec.s()  = "The quick brown fox jumped over the lazy dog.";
+
+            test::TimingRequest request;
+            request.makeBasic(basicRec);
+            testDefiniteLengthRoundTrip(L_, request);
+
+            test::BigRecord bigRec;
+            bigRec.name() = "This record is so big, it has its own gravity.";
+
+            // Grow the array past each of the 1, 2, and 3-octet long forms.
+
+            for (int i = 0; i < 1000; ++i) {
+                bigRec.array().push_back(basicRec);
+                if (1 == i || 3 == i || 999 == i) {
+                    request.makeBig(bigRec);
+                    testDefiniteLengthRoundTrip(L_, request);
+                }
+            }
+        }
+
+        if (verbose) bsl::cout << "\nEnd of test." << bsl::endl;
+      } break;
       case 14: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
@@ -12166,6 +12397,70 @@ int main(int argc, char *argv[])
                   << (reps / elapsed) << " reps/sec, "
                   << osb.length()     << " bytes" << bsl::endl;
       } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: DEFINITE-LENGTH ENCODING
+        //   Compare the cost of encoding a nested message using the
+        //   indefinite-length form with that of the two-pass definite-length
+        //   form.  Optionally specify the number of repetitions and the size
+        //   of the nested array on the command line:
+        //..
+        //  balber_berencoder.t -2 [reps] [arraySize]
+        //..
+        // --------------------------------------------------------------------
+
+        const int reps      = argc > 2 ? bsl::atoi(argv[2]) : 1000;
+        const int arraySize = argc > 3 ? bsl::atoi(argv[3]) : 200;
+
+        bsl::cout << "PERFORMANCE TEST: DEFINITE-LENGTH ENCODING" << bsl::endl
+                  << "  " << reps << " repetitions, array size of "
+                  << arraySize << bsl::endl;
+
+        test::BasicRecord basicRec;
+        basicRec.i1() = 11;
+        basicRec.i2() = 22;
+        basicRec.dt() = bdlt::DatetimeTz(
+                                   bdlt::Datetime(bdlt::Date(2007, 9, 3),
+                                                  bdlt::Time(16, 30)), 0);
+        basicRec.s()  = "The quick brown fox jumped over the lazy dog.";
+
+        test::BigRecord bigRec;
+        bigRec.name() = "This record is so big, it has its own gravity.";
+        for (int i = 0; i < arraySize; ++i) {
+            bigRec.array().push_back(basicRec);
+        }
+
+        test::TimingRequest request;
+        request.makeBig(bigRec);
+
+        for (int definite = 0; definite < 2; ++definite) {
+            balber::BerEncoderOptions options;
+            options.setEncodeDefiniteLength(definite);
+
+            // Reuse a single encoder, as a server encoding many messages of
+            // the same shape would.
+
+            balber::BerEncoder     encoder(&options);
+            bdlsb::MemOutStreamBuf osb;
+
+            ASSERT(0 == encoder.encode(&osb, request));
+
+            bsls::Stopwatch stopwatch;
+            stopwatch.start();
+            for (int i = 0; i < reps; ++i) {
+                osb.pubseekpos(0);
+                encoder.encode(&osb, request);
+            }
+            stopwatch.stop();
+
+            const double elapsed = stopwatch.elapsedTime();
+
+            bsl::cout << (definite ? "    definite:   " : "    indefinite: ")
+                      << elapsed                   << " seconds, "
+                      << (reps / elapsed)          << " reps/sec, "
+                      << osb.length()              << " bytes" << bsl::endl;
+        }
+      } break;
       default: {
         bsl::cerr << "WARNING: CASE `" << test << "' NOT FOUND." << bsl::endl;
         testStatus = -1;
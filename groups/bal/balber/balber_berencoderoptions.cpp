@@ -44,6 +44,8 @@ const bool balber::BerEncoderOptions::
               DEFAULT_INITIALIZER_ENCODE_DATE_AND_TIME_TYPES_AS_BINARY = false;
 const int  balber::BerEncoderOptions::
               DEFAULT_INITIALIZER_DATETIME_FRACTIONAL_SECOND_PRECISION = 3;
+const bool balber::BerEncoderOptions::
+              DEFAULT_INITIALIZER_ENCODE_DEFINITE_LENGTH               = false;
 
 const bdlat_AttributeInfo balber::BerEncoderOptions::ATTRIBUTE_INFO_ARRAY[] = {
     {
@@ -80,6 +82,13 @@ const bdlat_AttributeInfo balber::BerEncoderOptions::ATTRIBUTE_INFO_ARRAY[] = {
         sizeof("DatetimeFractionalSecondPrecision") - 1,
         "",
         bdlat_FormattingMode::e_DEC
+    },
+    {
+        e_ATTRIBUTE_ID_ENCODE_DEFINITE_LENGTH,
+        "EncodeDefiniteLength",
+        sizeof("EncodeDefiniteLength") - 1,
+        "",
+        bdlat_FormattingMode::e_TEXT
     }
 };
 
@@ -131,6 +140,33 @@ const bdlat_AttributeInfo *BerEncoderOptions::lookupAttributeInfo(
                                                                       // RETURN
             }
         } break;
+        case 20: {
+            if (name[0]=='E'
+             && name[1]=='n'
+             && name[2]=='c'
+             && name[3]=='o'
+             && name[4]=='d'
+             && name[5]=='e'
+             && name[6]=='D'
+             && name[7]=='e'
+             && name[8]=='f'
+             && name[9]=='i'
+             && name[10]=='n'
+             && name[11]=='i'
+             && name[12]=='t'
+             && name[13]=='e'
+             && name[14]=='L'
+             && name[15]=='e'
+             && name[16]=='n'
+             && name[17]=='g'
+             && name[18]=='t'
+             && name[19]=='h')
+            {
+                return &ATTRIBUTE_INFO_ARRAY[
+                                     e_ATTRIBUTE_INDEX_ENCODE_DEFINITE_LENGTH];
+                                                                      // RETURN
+            }
+        } break;
         case 21: {
             if (name[0]=='B'
              && name[1]=='d'
@@ -255,6 +291,8 @@ const bdlat_AttributeInfo *BerEncoderOptions::lookupAttributeInfo(int id)
       case e_ATTRIBUTE_ID_DATETIME_FRACTIONAL_SECOND_PRECISION:
         return &ATTRIBUTE_INFO_ARRAY[
                        e_ATTRIBUTE_INDEX_DATETIME_FRACTIONAL_SECOND_PRECISION];
+      case e_ATTRIBUTE_ID_ENCODE_DEFINITE_LENGTH:
+        return &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_ENCODE_DEFINITE_LENGTH];
       default:
         return 0;
     }
@@ -270,6 +308,7 @@ BerEncoderOptions::BerEncoderOptions()
 , d_encodeEmptyArrays(DEFAULT_INITIALIZER_ENCODE_EMPTY_ARRAYS)
 , d_encodeDateAndTimeTypesAsBinary(
                       DEFAULT_INITIALIZER_ENCODE_DATE_AND_TIME_TYPES_AS_BINARY)
+, d_encodeDefiniteLength(DEFAULT_INITIALIZER_ENCODE_DEFINITE_LENGTH)
 {
 }
 
@@ -280,6 +319,7 @@ BerEncoderOptions::BerEncoderOptions(const BerEncoderOptions& original)
 , d_bdeVersionConformance(original.d_bdeVersionConformance)
 , d_encodeEmptyArrays(original.d_encodeEmptyArrays)
 , d_encodeDateAndTimeTypesAsBinary(original.d_encodeDateAndTimeTypesAsBinary)
+, d_encodeDefiniteLength(original.d_encodeDefiniteLength)
 {
 }
 
@@ -300,6 +340,7 @@ BerEncoderOptions::operator=(const BerEncoderOptions& rhs)
                                           rhs.d_encodeDateAndTimeTypesAsBinary;
         d_datetimeFractionalSecondPrecision =
                                        rhs.d_datetimeFractionalSecondPrecision;
+        d_encodeDefiniteLength           = rhs.d_encodeDefiniteLength;
     }
     return *this;
 }
@@ -313,6 +354,7 @@ void BerEncoderOptions::reset()
                       DEFAULT_INITIALIZER_ENCODE_DATE_AND_TIME_TYPES_AS_BINARY;
     d_datetimeFractionalSecondPrecision =
                       DEFAULT_INITIALIZER_DATETIME_FRACTIONAL_SECOND_PRECISION;
+    d_encodeDefiniteLength  = DEFAULT_INITIALIZER_ENCODE_DEFINITE_LENGTH;
 }
 
 // ACCESSORS
@@ -371,6 +413,13 @@ bsl::ostream& BerEncoderOptions::print(
                                  -levelPlus1,
                                   spacesPerLevel);
 
+        bdlb::Print::indent(stream, levelPlus1, spacesPerLevel);
+        stream << "EncodeDefiniteLength = ";
+        bdlb::PrintMethods::print(stream,
+                                  d_encodeDefiniteLength,
+                                  -levelPlus1,
+                                  spacesPerLevel);
+
         bdlb::Print::indent(stream, level, spacesPerLevel);
 
         stream << "]\n";
@@ -409,6 +458,12 @@ bsl::ostream& BerEncoderOptions::print(
         bdlb::PrintMethods::print(stream, d_datetimeFractionalSecondPrecision,
                                  -levelPlus1, spacesPerLevel);
 
+        stream << ' ';
+        stream << "EncodeDefiniteLength = ";
+        bdlb::PrintMethods::print(stream, d_encodeDefiniteLength,
+                                  -levelPlus1,
+                                  spacesPerLevel);
+
         stream << " ]";
     }
 
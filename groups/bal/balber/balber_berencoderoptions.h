@@ -103,6 +103,13 @@ class BerEncoderOptions {
         // encoded as binary integers.  By default these types are encoded as
         // strings in the ISO 8601 format.
 
+    bool d_encodeDefiniteLength;
+        // This option allows users to control if constructed types (i.e.,
+        // sequences, choices, nillable values, and arrays) are encoded using
+        // the definite-length form.  By default constructed types are
+        // encoded using the indefinite-length form, terminated by
+        // end-of-contents octets.
+
   public:
     // TYPES
     enum {
@@ -111,10 +118,11 @@ class BerEncoderOptions {
       , e_ATTRIBUTE_ID_ENCODE_EMPTY_ARRAYS                  = 2
       , e_ATTRIBUTE_ID_ENCODE_DATE_AND_TIME_TYPES_AS_BINARY = 3
       , e_ATTRIBUTE_ID_DATETIME_FRACTIONAL_SECOND_PRECISION = 4
+      , e_ATTRIBUTE_ID_ENCODE_DEFINITE_LENGTH               = 5
     };
 
     enum {
-        k_NUM_ATTRIBUTES = 5
+        k_NUM_ATTRIBUTES = 6
     };
 
     enum {
@@ -123,6 +131,7 @@ class BerEncoderOptions {
       , e_ATTRIBUTE_INDEX_ENCODE_EMPTY_ARRAYS                  = 2
       , e_ATTRIBUTE_INDEX_ENCODE_DATE_AND_TIME_TYPES_AS_BINARY = 3
       , e_ATTRIBUTE_INDEX_DATETIME_FRACTIONAL_SECOND_PRECISION = 4
+      , e_ATTRIBUTE_INDEX_ENCODE_DEFINITE_LENGTH               = 5
     };
 
     // CONSTANTS
@@ -132,6 +141,7 @@ class BerEncoderOptions {
     static const bool DEFAULT_INITIALIZER_ENCODE_EMPTY_ARRAYS;
     static const bool DEFAULT_INITIALIZER_ENCODE_DATE_AND_TIME_TYPES_AS_BINARY;
     static const int  DEFAULT_INITIALIZER_DATETIME_FRACTIONAL_SECOND_PRECISION;
+    static const bool DEFAULT_INITIALIZER_ENCODE_DEFINITE_LENGTH;
     static const bdlat_AttributeInfo ATTRIBUTE_INFO_ARRAY[];
 
   public:
@@ -244,6 +254,14 @@ class BerEncoderOptions {
         // to the specified 'value'.  The behavior is undefined unless
         // 'value == 3 || value == 6'.
 
+    void setEncodeDefiniteLength(bool value);
+        // Set the 'EncodeDefiniteLength' attribute of this object to the
+        // specified 'value'.  If this option is set to 'true' then the
+        // contents of every constructed type are preceded by their exact
+        // length instead of being terminated by end-of-contents octets.  Note
+        // that the lengths are computed by the encoder in a separate sizing
+        // traversal of the value, without buffering any encoded contents.
+
     // ACCESSORS
     bsl::ostream& print(bsl::ostream& stream,
                         int           level = 0,
@@ -318,6 +336,10 @@ class BerEncoderOptions {
     int datetimeFractionalSecondPrecision() const;
         // Return a reference to the non-modifiable
         // 'DatetimeFractionalSecondPrecision' attribute of this object.
+
+    bool encodeDefiniteLength() const;
+        // Return a reference to the non-modifiable 'EncodeDefiniteLength'
+        // attribute of this object.
 };
 
 // FREE OPERATORS
@@ -385,6 +407,9 @@ STREAM& BerEncoderOptions::bdexStreamIn(STREAM& stream, int version)
                                            stream,
                                            d_datetimeFractionalSecondPrecision,
                                            1);
+            bslx::InStreamFunctions::bdexStreamIn(stream,
+                                                  d_encodeDefiniteLength,
+                                                  1);
           } break;
           default: {
             stream.invalidate();
@@ -433,6 +458,13 @@ int BerEncoderOptions::manipulateAttributes(MANIPULATOR& manipulator)
         return ret;
     }
 
+    ret = manipulator(
+               &d_encodeDefiniteLength,
+               ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_ENCODE_DEFINITE_LENGTH]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
     return ret;
 }
 
@@ -469,6 +501,11 @@ int BerEncoderOptions::manipulateAttribute(MANIPULATOR& manipulator, int id)
                       ATTRIBUTE_INFO_ARRAY[
                       e_ATTRIBUTE_INDEX_DATETIME_FRACTIONAL_SECOND_PRECISION]);
       } break;
+      case e_ATTRIBUTE_ID_ENCODE_DEFINITE_LENGTH: {
+        return manipulator(
+               &d_encodeDefiniteLength,
+               ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_ENCODE_DEFINITE_LENGTH]);
+      } break;
       default:
         return k_NOT_FOUND;
     }
@@ -521,6 +558,12 @@ void BerEncoderOptions::setDatetimeFractionalSecondPrecision(int value)
     d_datetimeFractionalSecondPrecision = value;
 }
 
+inline
+void BerEncoderOptions::setEncodeDefiniteLength(bool value)
+{
+    d_encodeDefiniteLength = value;
+}
+
 // ACCESSORS
 template <class STREAM>
 STREAM& BerEncoderOptions::bdexStreamOut(STREAM& stream, int version) const
@@ -544,6 +587,9 @@ STREAM& BerEncoderOptions::bdexStreamOut(STREAM& stream, int version) const
                                            stream,
                                            d_datetimeFractionalSecondPrecision,
                                            1);
+        bslx::OutStreamFunctions::bdexStreamOut(stream,
+                                                d_encodeDefiniteLength,
+                                                1);
       } break;
       default: {
         stream.invalidate();
@@ -592,6 +638,13 @@ int BerEncoderOptions::accessAttributes(ACCESSOR& accessor) const
         return ret;                                                   // RETURN
     }
 
+    ret = accessor(d_encodeDefiniteLength,
+                   ATTRIBUTE_INFO_ARRAY[
+                                    e_ATTRIBUTE_INDEX_ENCODE_DEFINITE_LENGTH]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
     return ret;
 }
 
@@ -627,6 +680,11 @@ int BerEncoderOptions::accessAttribute(ACCESSOR& accessor, int id) const
             ATTRIBUTE_INFO_ARRAY[
             e_ATTRIBUTE_INDEX_DATETIME_FRACTIONAL_SECOND_PRECISION]);
       } break;
+      case e_ATTRIBUTE_ID_ENCODE_DEFINITE_LENGTH: {
+        return accessor(d_encodeDefiniteLength,
+                        ATTRIBUTE_INFO_ARRAY[
+                                    e_ATTRIBUTE_INDEX_ENCODE_DEFINITE_LENGTH]);
+      } break;
       default:
         return k_NOT_FOUND;
     }
@@ -678,6 +736,12 @@ int BerEncoderOptions::datetimeFractionalSecondPrecision() const
     return d_datetimeFractionalSecondPrecision;
 }
 
+inline
+bool BerEncoderOptions::encodeDefiniteLength() const
+{
+    return d_encodeDefiniteLength;
+}
+
 }  // close package namespace
 
 
@@ -693,7 +757,8 @@ bool balber::operator==(const BerEncoderOptions& lhs,
          && lhs.encodeDateAndTimeTypesAsBinary() ==
                                            rhs.encodeDateAndTimeTypesAsBinary()
          && lhs.datetimeFractionalSecondPrecision() ==
-                                       rhs.datetimeFractionalSecondPrecision();
+                                       rhs.datetimeFractionalSecondPrecision()
+         && lhs.encodeDefiniteLength()           == rhs.encodeDefiniteLength();
 }
 
 inline
@@ -706,7 +771,8 @@ bool balber::operator!=(const BerEncoderOptions& lhs,
          || lhs.encodeDateAndTimeTypesAsBinary() !=
                                            rhs.encodeDateAndTimeTypesAsBinary()
          || lhs.datetimeFractionalSecondPrecision() !=
-                                       rhs.datetimeFractionalSecondPrecision();
+                                       rhs.datetimeFractionalSecondPrecision()
+         || lhs.encodeDefiniteLength()           != rhs.encodeDefiniteLength();
 }
 
 inline
@@ -0,0 +1,1195 @@
+// baljsn_datumutil.cpp                                               -*-C++-*-
+#include <baljsn_datumutil.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(baljsn_datumutil_cpp,"$Id$ $CSID$")
+
+#include <bdlb_float.h>
+#include <bdlb_numerictextutil.h>
+#include <bdlde_utf8util.h>
+#include <bdlma_localsequentialallocator.h>
+#include <bdlt_iso8601util.h>
+
+#include <bslma_allocator.h>
+#include <bsls_assert.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstring.h>
+#include <bsl_streambuf.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace {
+
+typedef bdld::Datum::SizeType SizeType;
+
+enum {
+    k_SCRATCH_BUFFER_SIZE = 4096,  // size of the local buffer supplying the
+                                   // parser's stacks
+
+    k_WRITE_BUFFER_SIZE   = 1024   // size of the local output buffer of the
+                                   // encoder
+};
+
+                           // ====================
+                           // local free functions
+                           // ====================
+
+inline
+bool isDigit(char value)
+    // Return 'true' if the specified 'value' is a decimal digit, and 'false'
+    // otherwise.
+{
+    return '0' <= value && value <= '9';
+}
+
+inline
+int hexValue(char value)
+    // Return the value of the specified 'value' read as a hexadecimal digit,
+    // or -1 if 'value' is not a hexadecimal digit.
+{
+    if (isDigit(value)) {
+        return value - '0';                                           // RETURN
+    }
+    if ('a' <= value && value <= 'f') {
+        return value - 'a' + 10;                                      // RETURN
+    }
+    if ('A' <= value && value <= 'F') {
+        return value - 'A' + 10;                                      // RETURN
+    }
+    return -1;
+}
+
+int parseCodeUnit(unsigned int *result, const char *input, const char *end)
+    // Load into the specified 'result' the value of the four hexadecimal
+    // digits at the specified 'input', which precedes the specified 'end'.
+    // Return 0 on success, and a non-zero value if there are fewer than four
+    // characters before 'end' or they are not all hexadecimal digits.
+{
+    if (end - input < 4) {
+        return -1;                                                    // RETURN
+    }
+
+    unsigned int value = 0;
+    for (int i = 0; i < 4; ++i) {
+        const int digit = hexValue(input[i]);
+        if (digit < 0) {
+            return -1;                                                // RETURN
+        }
+        value = (value << 4) | digit;
+    }
+
+    *result = value;
+    return 0;
+}
+
+int encodeUtf8(char *buffer, unsigned int codePoint)
+    // Write to the specified 'buffer', unless it is 0, the UTF-8 encoding of
+    // the specified 'codePoint', and return the number of bytes in that
+    // encoding.  The behavior is undefined unless 'codePoint < 0x110000'.
+{
+    if (codePoint < 0x80) {
+        if (buffer) {
+            buffer[0] = static_cast<char>(codePoint);
+        }
+        return 1;                                                     // RETURN
+    }
+    if (codePoint < 0x800) {
+        if (buffer) {
+            buffer[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+            buffer[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        return 2;                                                     // RETURN
+    }
+    if (codePoint < 0x10000) {
+        if (buffer) {
+            buffer[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+            buffer[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            buffer[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        return 3;                                                     // RETURN
+    }
+    if (buffer) {
+        buffer[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+        buffer[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        buffer[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        buffer[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    return 4;
+}
+
+int decodeString(char *buffer, const char *begin, const char *end)
+    // Write to the specified 'buffer', unless it is 0, the characters of the
+    // contents of a JSON string in the range '[begin, end)' (i.e., excluding
+    // the enclosing quotation marks), having decoded its escape sequences, and
+    // return the number of characters in the decoded string, or a negative
+    // value if the contents contain an invalid escape sequence.  The behavior
+    // is undefined unless every backslash in the range that is not itself
+    // escaped is followed by a character in the range.
+{
+    int         length  = 0;
+    const char *current = begin;
+
+    while (current != end) {
+        const char *escape = static_cast<const char *>(
+                                  bsl::memchr(current, '\\', end - current));
+        const char *runEnd = escape ? escape : end;
+
+        if (buffer) {
+            bsl::memcpy(buffer + length, current, runEnd - current);
+        }
+        length += static_cast<int>(runEnd - current);
+        current = runEnd;
+
+        if (!escape) {
+            break;
+        }
+
+        current += 2;
+
+        char value;
+        switch (escape[1]) {
+          case '"':                                             // FALL THROUGH
+          case '\\':                                            // FALL THROUGH
+          case '/': {
+            value = escape[1];
+          } break;
+          case 'b': {
+            value = '\b';
+          } break;
+          case 'f': {
+            value = '\f';
+          } break;
+          case 'n': {
+            value = '\n';
+          } break;
+          case 'r': {
+            value = '\r';
+          } break;
+          case 't': {
+            value = '\t';
+          } break;
+          case 'u': {
+            unsigned int codePoint;
+            if (0 != parseCodeUnit(&codePoint, current, end)) {
+                return -1;                                            // RETURN
+            }
+            current += 4;
+
+            if (0xDC00 <= codePoint && codePoint < 0xE000) {
+                return -1;                                            // RETURN
+            }
+            if (0xD800 <= codePoint && codePoint < 0xDC00) {
+                // A high surrogate must be followed by an escaped low
+                // surrogate.
+
+                unsigned int low;
+                if (end - current < 6
+                 || '\\' != current[0]
+                 || 'u'  != current[1]
+                 || 0 != parseCodeUnit(&low, current + 2, end)
+                 || low < 0xDC00
+                 || 0xE000 <= low) {
+                    return -1;                                        // RETURN
+                }
+                current += 6;
+
+                codePoint = 0x10000
+                          + ((codePoint - 0xD800) << 10)
+                          + (low - 0xDC00);
+            }
+            length += encodeUtf8(buffer ? buffer + length : 0, codePoint);
+          } continue;
+          default: {
+            return -1;                                                // RETURN
+          }
+        }
+
+        if (buffer) {
+            buffer[length] = value;
+        }
+        ++length;
+    }
+
+    return length;
+}
+
+                               // ============
+                               // class Parser
+                               // ============
+
+class Parser {
+    // This class implements a parser of JSON text into a 'bdld::Datum'.  The
+    // parser does not recurse: the elements of the arrays and maps being
+    // parsed are held on stacks until the closing bracket of their container
+    // is read, at which time the container is created and its elements are
+    // popped.  Any 'bdld::Datum' objects remaining on the stacks when the
+    // parser is destroyed (i.e., on failure) are destroyed with it.
+
+    // PRIVATE TYPES
+    struct Frame {
+        // This 'struct' describes an array or map being parsed.
+
+        SizeType d_begin;         // index, on the stack of elements (or
+                                  // entries), of the first element (or entry)
+                                  // of the container
+
+        bool     d_isMap;         // 'true' if the container is a map
+
+        bool     d_hasCopiedKey;  // 'true' if a key of the map was decoded
+                                  // into scratch memory
+    };
+
+    // DATA
+    const char                           *d_current_p;     // next character
+
+    const char                           *d_end_p;         // end of the text
+
+    bool                                  d_referenceInput;
+                                                           // whether strings
+                                                           // may refer to the
+                                                           // text
+
+    bslma::Allocator                     *d_allocator_p;   // supplies the
+                                                           // result (held)
+
+    bdlma::LocalSequentialAllocator<k_SCRATCH_BUFFER_SIZE>
+                                          d_scratch;       // supplies the
+                                                           // stacks and
+                                                           // decoded keys
+
+    bsl::vector<bdld::Datum>              d_elements;      // array elements
+
+    bsl::vector<bdld::DatumMapEntry>      d_entries;       // map entries
+
+    bsl::vector<Frame>                    d_frames;        // open containers
+
+  private:
+    // NOT IMPLEMENTED
+    Parser(const Parser&);
+    Parser& operator=(const Parser&);
+
+    // PRIVATE MANIPULATORS
+    bdld::Datum closeArray(const Frame& frame);
+        // Create an array holding the elements of the specified array 'frame',
+        // pop the elements, and return the array.
+
+    bdld::Datum closeMap(const Frame& frame);
+        // Create a map holding the entries of the specified map 'frame', pop
+        // the entries, and return the map.
+
+    int parseKey();
+        // Parse a member name (a string followed by a colon) of the map being
+        // parsed, and push an entry having that key, and a null value, on the
+        // stack of entries.  Return 0 on success, and a non-zero value
+        // otherwise.
+
+    int parseNumber(bdld::Datum *result);
+        // Parse a number and load it into the specified 'result'.  Return 0 on
+        // success, and a non-zero value otherwise.
+
+    int parseString(bslstl::StringRef *contents, bool *hasEscapes);
+        // Parse a string, load into the specified 'contents' the characters
+        // between its quotation marks, and load into the specified
+        // 'hasEscapes' whether those characters contain an escape sequence.
+        // Return 0 on success, and a non-zero value if the string is not
+        // terminated or contains a control character.
+
+    void skipWhitespace();
+        // Advance past any whitespace at the current position.
+
+  public:
+    // CREATORS
+    Parser(const bslstl::StringRef&  json,
+           bool                      referenceInput,
+           bslma::Allocator         *allocator);
+        // Create a parser of the specified 'json' text, creating strings that
+        // refer to that text if the specified 'referenceInput' is 'true', and
+        // using the specified 'allocator' to supply memory for the result.
+
+    ~Parser();
+        // Destroy this object, destroying any 'bdld::Datum' objects remaining
+        // on its stacks.
+
+    // MANIPULATORS
+    int parse(bdld::Datum *result);
+        // Parse the text of this parser and load the resulting value into the
+        // specified 'result'.  Return 0 on success, and a non-zero value, with
+        // no effect on 'result', otherwise.
+};
+
+                               // ------------
+                               // class Parser
+                               // ------------
+
+// PRIVATE MANIPULATORS
+bdld::Datum Parser::closeArray(const Frame& frame)
+{
+    const SizeType     length   = d_elements.size() - frame.d_begin;
+    const bdld::Datum *elements = d_elements.data() + frame.d_begin;
+
+    bdld::DatumMutableArrayRef array;
+    bdld::Datum::createUninitializedArray(&array, length, d_allocator_p);
+
+    bsl::copy(elements, elements + length, array.data());
+    *array.length() = length;
+
+    d_elements.resize(frame.d_begin);
+    return bdld::Datum::adoptArray(array);
+}
+
+bdld::Datum Parser::closeMap(const Frame& frame)
+{
+    const SizeType             size    = d_entries.size() - frame.d_begin;
+    const bdld::DatumMapEntry *entries = d_entries.data() + frame.d_begin;
+
+    bdld::Datum result;
+
+    if (d_referenceInput && !frame.d_hasCopiedKey) {
+        bdld::DatumMutableMapRef map;
+        bdld::Datum::createUninitializedMap(&map, size, d_allocator_p);
+
+        bsl::copy(entries, entries + size, map.data());
+        *map.size() = size;
+
+        result = bdld::Datum::adoptMap(map);
+    }
+    else {
+        SizeType keysLength = 0;
+        for (SizeType i = 0; i < size; ++i) {
+            keysLength += entries[i].key().length();
+        }
+
+        bdld::DatumMutableMapOwningKeysRef map;
+        bdld::Datum::createUninitializedMap(&map,
+                                            size,
+                                            keysLength,
+                                            d_allocator_p);
+
+        char *key = map.keys();
+        for (SizeType i = 0; i < size; ++i) {
+            const bslstl::StringRef& original = entries[i].key();
+
+            bsl::memcpy(key, original.data(), original.length());
+            map.data()[i] = bdld::DatumMapEntry(
+                                     bslstl::StringRef(key, original.length()),
+                                     entries[i].value());
+            key += original.length();
+        }
+        *map.size() = size;
+
+        result = bdld::Datum::adoptMap(map);
+    }
+
+    d_entries.resize(frame.d_begin);
+    return result;
+}
+
+int Parser::parseKey()
+{
+    BSLS_ASSERT(!d_frames.empty());
+    BSLS_ASSERT(d_frames.back().d_isMap);
+
+    skipWhitespace();
+    if (d_current_p == d_end_p || '"' != *d_current_p) {
+        return -1;                                                    // RETURN
+    }
+
+    bslstl::StringRef key;
+    bool              hasEscapes;
+    if (0 != parseString(&key, &hasEscapes)) {
+        return -1;                                                    // RETURN
+    }
+
+    if (hasEscapes) {
+        const int length = decodeString(0, key.begin(), key.end());
+        if (length < 0) {
+            return -1;                                                // RETURN
+        }
+
+        char *buffer = static_cast<char *>(d_scratch.allocate(length));
+        decodeString(buffer, key.begin(), key.end());
+
+        key.assign(buffer, length);
+        d_frames.back().d_hasCopiedKey = true;
+    }
+
+    skipWhitespace();
+    if (d_current_p == d_end_p || ':' != *d_current_p) {
+        return -1;                                                    // RETURN
+    }
+    ++d_current_p;
+
+    d_entries.push_back(bdld::DatumMapEntry(key, bdld::Datum::createNull()));
+    return 0;
+}
+
+int Parser::parseNumber(bdld::Datum *result)
+{
+    const char *begin   = d_current_p;
+    const char *current = d_current_p;
+
+    if (current != d_end_p && '-' == *current) {
+        ++current;
+    }
+
+    if (current == d_end_p || !isDigit(*current)) {
+        return -1;                                                    // RETURN
+    }
+    if ('0' == *current) {
+        ++current;
+    }
+    else {
+        while (current != d_end_p && isDigit(*current)) {
+            ++current;
+        }
+    }
+
+    if (current != d_end_p && '.' == *current) {
+        ++current;
+        if (current == d_end_p || !isDigit(*current)) {
+            return -1;                                                // RETURN
+        }
+        while (current != d_end_p && isDigit(*current)) {
+            ++current;
+        }
+    }
+
+    if (current != d_end_p && ('e' == *current || 'E' == *current)) {
+        ++current;
+        if (current != d_end_p && ('+' == *current || '-' == *current)) {
+            ++current;
+        }
+        if (current == d_end_p || !isDigit(*current)) {
+            return -1;                                                // RETURN
+        }
+        while (current != d_end_p && isDigit(*current)) {
+            ++current;
+        }
+    }
+
+    // A positive status from 'parseDouble' indicates overflow (which we
+    // reject) or underflow (which we accept).
+
+    double    value;
+    const int rc = bdlb::NumericTextUtil::parseDouble(
+                                          &value,
+                                          begin,
+                                          static_cast<int>(current - begin));
+    if (rc < 0 || (0 < rc && !bdlb::Float::isFinite(value))) {
+        return -1;                                                    // RETURN
+    }
+
+    d_current_p = current;
+    *result     = bdld::Datum::createDouble(value);
+    return 0;
+}
+
+int Parser::parseString(bslstl::StringRef *contents, bool *hasEscapes)
+{
+    BSLS_ASSERT(d_current_p != d_end_p && '"' == *d_current_p);
+
+    const char *begin   = d_current_p + 1;
+    bool        escapes = false;
+
+    for (const char *current = begin; current != d_end_p; ++current) {
+        const unsigned char value = static_cast<unsigned char>(*current);
+
+        if ('"' == value) {
+            contents->assign(begin, current - begin);
+            *hasEscapes = escapes;
+            d_current_p = current + 1;
+            return 0;                                                 // RETURN
+        }
+
+        if ('\\' == value) {
+            // Skip the escaped character, so that an escaped quotation mark
+            // does not terminate the string.
+
+            escapes = true;
+            if (++current == d_end_p) {
+                break;
+            }
+        }
+        else if (value < 0x20) {
+            return -1;                                                // RETURN
+        }
+    }
+
+    return -1;
+}
+
+void Parser::skipWhitespace()
+{
+    while (d_current_p != d_end_p) {
+        switch (*d_current_p) {
+          case ' ':                                             // FALL THROUGH
+          case '\t':                                            // FALL THROUGH
+          case '\n':                                            // FALL THROUGH
+          case '\r': {
+            ++d_current_p;
+          } break;
+          default: {
+            return;                                                   // RETURN
+          }
+        }
+    }
+}
+
+// CREATORS
+Parser::Parser(const bslstl::StringRef&  json,
+               bool                      referenceInput,
+               bslma::Allocator         *allocator)
+: d_current_p(json.begin())
+, d_end_p(json.end())
+, d_referenceInput(referenceInput)
+, d_allocator_p(allocator)
+, d_scratch()
+, d_elements(&d_scratch)
+, d_entries(&d_scratch)
+, d_frames(&d_scratch)
+{
+    BSLS_ASSERT(allocator);
+}
+
+Parser::~Parser()
+{
+    for (SizeType i = 0; i < d_elements.size(); ++i) {
+        bdld::Datum::destroy(d_elements[i], d_allocator_p);
+    }
+    for (SizeType i = 0; i < d_entries.size(); ++i) {
+        bdld::Datum::destroy(d_entries[i].value(), d_allocator_p);
+    }
+}
+
+// MANIPULATORS
+int Parser::parse(bdld::Datum *result)
+{
+    BSLS_ASSERT(result);
+
+    while (true) {
+        // Parse a value, or open an array or map and parse its first element
+        // (or entry).
+
+        bdld::Datum value;
+
+        skipWhitespace();
+        if (d_current_p == d_end_p) {
+            return -1;                                                // RETURN
+        }
+
+        switch (*d_current_p) {
+          case '[': {
+            ++d_current_p;
+            skipWhitespace();
+            if (d_current_p != d_end_p && ']' == *d_current_p) {
+                ++d_current_p;
+                value = bdld::Datum::adoptArray(bdld::DatumMutableArrayRef());
+                break;
+            }
+
+            const Frame frame = { d_elements.size(), false, false };
+            d_frames.push_back(frame);
+          } continue;
+          case '{': {
+            ++d_current_p;
+            skipWhitespace();
+            if (d_current_p != d_end_p && '}' == *d_current_p) {
+                ++d_current_p;
+                value = bdld::Datum::adoptMap(bdld::DatumMutableMapRef());
+                break;
+            }
+
+            const Frame frame = { d_entries.size(), true, false };
+            d_frames.push_back(frame);
+
+            if (0 != parseKey()) {
+                return -1;                                            // RETURN
+            }
+          } continue;
+          case '"': {
+            bslstl::StringRef contents;
+            bool              hasEscapes;
+            if (0 != parseString(&contents, &hasEscapes)) {
+                return -1;                                            // RETURN
+            }
+
+            if (hasEscapes) {
+                const int length = decodeString(0,
+                                                contents.begin(),
+                                                contents.end());
+                if (length < 0) {
+                    return -1;                                        // RETURN
+                }
+
+                char *buffer = bdld::Datum::createUninitializedString(
+                                                               &value,
+                                                               length,
+                                                               d_allocator_p);
+                decodeString(buffer, contents.begin(), contents.end());
+            }
+            else if (d_referenceInput) {
+                value = bdld::Datum::createStringRef(contents, d_allocator_p);
+            }
+            else {
+                value = bdld::Datum::copyString(contents, d_allocator_p);
+            }
+          } break;
+          case 't': {
+            if (d_end_p - d_current_p < 4
+             || 0 != bsl::memcmp(d_current_p, "true", 4)) {
+                return -1;                                            // RETURN
+            }
+            d_current_p += 4;
+            value = bdld::Datum::createBoolean(true);
+          } break;
+          case 'f': {
+            if (d_end_p - d_current_p < 5
+             || 0 != bsl::memcmp(d_current_p, "false", 5)) {
+                return -1;                                            // RETURN
+            }
+            d_current_p += 5;
+            value = bdld::Datum::createBoolean(false);
+          } break;
+          case 'n': {
+            if (d_end_p - d_current_p < 4
+             || 0 != bsl::memcmp(d_current_p, "null", 4)) {
+                return -1;                                            // RETURN
+            }
+            d_current_p += 4;
+            value = bdld::Datum::createNull();
+          } break;
+          default: {
+            if (0 != parseNumber(&value)) {
+                return -1;                                            // RETURN
+            }
+          }
+        }
+
+        // Store 'value' in the innermost open container, and close each
+        // container that is thereby complete, until a container has another
+        // element to parse or the outermost value is complete.
+
+        while (true) {
+            if (d_frames.empty()) {
+                skipWhitespace();
+                if (d_current_p != d_end_p) {
+                    bdld::Datum::destroy(value, d_allocator_p);
+                    return -1;                                        // RETURN
+                }
+                *result = value;
+                return 0;                                             // RETURN
+            }
+
+            const Frame frame = d_frames.back();
+
+            if (frame.d_isMap) {
+                d_entries.back() = bdld::DatumMapEntry(d_entries.back().key(),
+                                                       value);
+            }
+            else {
+                d_elements.push_back(value);
+            }
+
+            skipWhitespace();
+            if (d_current_p == d_end_p) {
+                return -1;                                            // RETURN
+            }
+
+            const char next = *d_current_p++;
+            if (',' == next) {
+                if (frame.d_isMap && 0 != parseKey()) {
+                    return -1;                                        // RETURN
+                }
+                break;
+            }
+            if (next != (frame.d_isMap ? '}' : ']')) {
+                return -1;                                            // RETURN
+            }
+
+            value = frame.d_isMap ? closeMap(frame) : closeArray(frame);
+            d_frames.pop_back();
+        }
+    }
+}
+
+                               // ============
+                               // class Writer
+                               // ============
+
+class Writer {
+    // This class implements a buffered writer of characters to either a
+    // string or a stream buffer.
+
+    // DATA
+    char            d_buffer[k_WRITE_BUFFER_SIZE];  // pending output
+    int             d_length;                       // length of pending output
+    bsl::string    *d_string_p;                     // destination (held), or 0
+    bsl::streambuf *d_streambuf_p;                  // destination (held), or 0
+    bool            d_failed;                       // 'true' if a write to
+                                                    // 'd_streambuf_p' failed
+
+  private:
+    // NOT IMPLEMENTED
+    Writer(const Writer&);
+    Writer& operator=(const Writer&);
+
+  public:
+    // CREATORS
+    explicit Writer(bsl::string *string);
+        // Create a writer that appends to the specified 'string'.
+
+    explicit Writer(bsl::streambuf *streambuf);
+        // Create a writer that writes to the specified 'streambuf'.
+
+    // MANIPULATORS
+    void commit(int length);
+        // Add to the pending output the specified 'length' characters written
+        // to the buffer returned by the preceding call to 'reserve'.
+
+    void flush();
+        // Write the pending output to the destination of this writer.
+
+    void put(char value);
+        // Write the specified 'value'.
+
+    char *reserve(int length);
+        // Return a buffer into which at least the specified 'length'
+        // characters can be written.  The behavior is undefined unless
+        // 'length <= k_WRITE_BUFFER_SIZE'.
+
+    void write(const char *data, bsl::size_t length);
+        // Write the specified 'length' characters at the specified 'data'.
+
+    // ACCESSORS
+    bool failed() const;
+        // Return 'true' if a write to the destination of this writer failed,
+        // and 'false' otherwise.
+};
+
+                               // ------------
+                               // class Writer
+                               // ------------
+
+// CREATORS
+Writer::Writer(bsl::string *string)
+: d_length(0)
+, d_string_p(string)
+, d_streambuf_p(0)
+, d_failed(false)
+{
+}
+
+Writer::Writer(bsl::streambuf *streambuf)
+: d_length(0)
+, d_string_p(0)
+, d_streambuf_p(streambuf)
+, d_failed(false)
+{
+}
+
+// MANIPULATORS
+inline
+void Writer::commit(int length)
+{
+    d_length += length;
+}
+
+void Writer::flush()
+{
+    if (d_string_p) {
+        d_string_p->append(d_buffer, d_length);
+    }
+    else if (d_length != d_streambuf_p->sputn(d_buffer, d_length)) {
+        d_failed = true;
+    }
+    d_length = 0;
+}
+
+inline
+void Writer::put(char value)
+{
+    if (k_WRITE_BUFFER_SIZE == d_length) {
+        flush();
+    }
+    d_buffer[d_length++] = value;
+}
+
+inline
+char *Writer::reserve(int length)
+{
+    BSLS_ASSERT_SAFE(length <= k_WRITE_BUFFER_SIZE);
+
+    if (k_WRITE_BUFFER_SIZE - d_length < length) {
+        flush();
+    }
+    return d_buffer + d_length;
+}
+
+void Writer::write(const char *data, bsl::size_t length)
+{
+    if (static_cast<bsl::size_t>(k_WRITE_BUFFER_SIZE - d_length) < length) {
+        flush();
+
+        if (k_WRITE_BUFFER_SIZE <= length) {
+            if (d_string_p) {
+                d_string_p->append(data, length);
+            }
+            else if (static_cast<bsl::streamsize>(length) !=
+                                          d_streambuf_p->sputn(data, length)) {
+                d_failed = true;
+            }
+            return;                                                   // RETURN
+        }
+    }
+    bsl::memcpy(d_buffer + d_length, data, length);
+    d_length += static_cast<int>(length);
+}
+
+// ACCESSORS
+inline
+bool Writer::failed() const
+{
+    return d_failed;
+}
+
+                          // =======================
+                          // local encoder functions
+                          // =======================
+
+struct EncoderFrame {
+    // This 'struct' describes an array or map being encoded.
+
+    const bdld::Datum         *d_elements_p;  // elements of an array, or 0
+    const bdld::DatumMapEntry *d_entries_p;   // entries of a map, or 0
+    SizeType                   d_size;        // number of elements
+    SizeType                   d_index;       // index of current element
+};
+
+int encodeString(Writer *writer, const bslstl::StringRef& value)
+    // Write to the specified 'writer' the specified 'value' as a JSON string.
+    // Return 0 on success, and a non-zero value if 'value' is not valid UTF-8.
+{
+    if (!bdlde::Utf8Util::isValid(value.data(), value.length())) {
+        return -1;                                                    // RETURN
+    }
+
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    writer->put('"');
+
+    const char *runBegin = value.begin();
+    const char *end      = value.end();
+
+    for (const char *current = runBegin; current != end; ++current) {
+        const unsigned char character = static_cast<unsigned char>(*current);
+
+        char escaped;
+        switch (character) {
+          case '"':                                             // FALL THROUGH
+          case '\\':                                            // FALL THROUGH
+          case '/': {
+            escaped = *current;
+          } break;
+          case '\b': {
+            escaped = 'b';
+          } break;
+          case '\f': {
+            escaped = 'f';
+          } break;
+          case '\n': {
+            escaped = 'n';
+          } break;
+          case '\r': {
+            escaped = 'r';
+          } break;
+          case '\t': {
+            escaped = 't';
+          } break;
+          default: {
+            if (0x20 <= character) {
+                continue;
+            }
+            escaped = 'u';
+          }
+        }
+
+        writer->write(runBegin, current - runBegin);
+        runBegin = current + 1;
+
+        writer->put('\\');
+        writer->put(escaped);
+        if ('u' == escaped) {
+            char *buffer = writer->reserve(4);
+            buffer[0] = '0';
+            buffer[1] = '0';
+            buffer[2] = HEX_DIGITS[character >> 4];
+            buffer[3] = HEX_DIGITS[character & 0x0F];
+            writer->commit(4);
+        }
+    }
+
+    writer->write(runBegin, end - runBegin);
+    writer->put('"');
+    return 0;
+}
+
+template <class TYPE>
+void encodeIso8601(Writer *writer, const TYPE& value)
+    // Write to the specified 'writer' the specified 'value' as a JSON string
+    // holding its ISO 8601 representation.
+{
+    char *buffer = writer->reserve(bdlt::Iso8601Util::k_MAX_STRLEN + 3);
+
+    buffer[0] = '"';
+    const int length = bdlt::Iso8601Util::generate(
+                                          buffer + 1,
+                                          bdlt::Iso8601Util::k_MAX_STRLEN + 1,
+                                          value);
+    buffer[length + 1] = '"';
+
+    writer->commit(length + 2);
+}
+
+int encodeScalar(Writer *writer, const bdld::Datum& datum)
+    // Write to the specified 'writer' the JSON representation of the
+    // specified 'datum', which is not an array or a map.  Return 0 on success,
+    // and a non-zero value if 'datum' has no JSON representation.
+{
+    switch (datum.type()) {
+      case bdld::Datum::e_NIL: {
+        writer->write("null", 4);
+      } break;
+      case bdld::Datum::e_BOOLEAN: {
+        if (datum.theBoolean()) {
+            writer->write("true", 4);
+        }
+        else {
+            writer->write("false", 5);
+        }
+      } break;
+      case bdld::Datum::e_INTEGER: {
+        char *buffer = writer->reserve(
+                               bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH);
+        writer->commit(bdlb::NumericTextUtil::formatInt(buffer,
+                                                        datum.theInteger()));
+      } break;
+      case bdld::Datum::e_INTEGER64: {
+        char *buffer = writer->reserve(
+                               bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH);
+        writer->commit(bdlb::NumericTextUtil::formatInt64(
+                                                       buffer,
+                                                       datum.theInteger64()));
+      } break;
+      case bdld::Datum::e_DOUBLE: {
+        const double value = datum.theDouble();
+        if (!bdlb::Float::isFinite(value)) {
+            return -1;                                                // RETURN
+        }
+
+        char *buffer = writer->reserve(
+                             bdlb::NumericTextUtil::k_SHORTEST_BUFFER_SIZE);
+        writer->commit(bdlb::NumericTextUtil::formatShortest(buffer, value));
+      } break;
+      case bdld::Datum::e_STRING: {
+        return encodeString(writer, datum.theString());               // RETURN
+      }
+      case bdld::Datum::e_DATE: {
+        encodeIso8601(writer, datum.theDate());
+      } break;
+      case bdld::Datum::e_TIME: {
+        encodeIso8601(writer, datum.theTime());
+      } break;
+      case bdld::Datum::e_DATETIME: {
+        encodeIso8601(writer, datum.theDatetime());
+      } break;
+      default: {
+        return -1;                                                    // RETURN
+      }
+    }
+    return 0;
+}
+
+int encodeDatum(Writer *writer, const bdld::Datum& datum)
+    // Write to the specified 'writer' the JSON representation of the
+    // specified 'datum'.  Return 0 on success, and a non-zero value if
+    // 'datum' has no JSON representation.  Note that this function does not
+    // recurse, so that datums of any depth can be encoded.
+{
+    bdlma::LocalSequentialAllocator<k_SCRATCH_BUFFER_SIZE> scratch;
+    bsl::vector<EncoderFrame>                              frames(&scratch);
+
+    const bdld::Datum *current = &datum;
+
+    while (true) {
+        // Write 'current', or open an array or map and advance to its first
+        // element (or entry).
+
+        if (current->isArray()) {
+            const bdld::DatumArrayRef array = current->theArray();
+
+            writer->put('[');
+            if (0 != array.length()) {
+                const EncoderFrame frame = { array.data(),
+                                             0,
+                                             array.length(),
+                                             0 };
+                frames.push_back(frame);
+
+                current = array.data();
+                continue;
+            }
+            writer->put(']');
+        }
+        else if (current->isMap()) {
+            const bdld::DatumMapRef map = current->theMap();
+
+            writer->put('{');
+            if (0 != map.size()) {
+                const EncoderFrame frame = { 0, map.data(), map.size(), 0 };
+                frames.push_back(frame);
+
+                if (0 != encodeString(writer, map[0].key())) {
+                    return -1;                                        // RETURN
+                }
+                writer->put(':');
+
+                current = &map[0].value();
+                continue;
+            }
+            writer->put('}');
+        }
+        else if (0 != encodeScalar(writer, *current)) {
+            return -1;                                                // RETURN
+        }
+
+        // Advance to the next element of the innermost open container,
+        // closing each container that has no more elements.
+
+        while (true) {
+            if (frames.empty()) {
+                return 0;                                             // RETURN
+            }
+
+            EncoderFrame& frame = frames.back();
+
+            if (++frame.d_index < frame.d_size) {
+                writer->put(',');
+
+                if (frame.d_entries_p) {
+                    const bdld::DatumMapEntry& entry =
+                                             frame.d_entries_p[frame.d_index];
+
+                    if (0 != encodeString(writer, entry.key())) {
+                        return -1;                                    // RETURN
+                    }
+                    writer->put(':');
+
+                    current = &entry.value();
+                }
+                else {
+                    current = frame.d_elements_p + frame.d_index;
+                }
+                break;
+            }
+
+            writer->put(frame.d_entries_p ? '}' : ']');
+            frames.pop_back();
+        }
+    }
+}
+
+int decodeImp(bdld::ManagedDatum       *result,
+              const bslstl::StringRef&  json,
+              bool                      referenceInput)
+    // Load into the specified 'result' the value represented by the specified
+    // 'json' text, creating strings that refer to that text if the specified
+    // 'referenceInput' is 'true'.  Return 0 on success, and a non-zero value,
+    // with no effect on 'result', otherwise.
+{
+    BSLS_ASSERT(result);
+
+    bdld::Datum value;
+    {
+        Parser parser(json, referenceInput, result->allocator());
+
+        if (0 != parser.parse(&value)) {
+            return -1;                                                // RETURN
+        }
+    }
+
+    result->adopt(value);
+    return 0;
+}
+
+}  // close unnamed namespace
+
+namespace baljsn {
+
+                              // ----------------
+                              // struct DatumUtil
+                              // ----------------
+
+// CLASS METHODS
+int DatumUtil::decode(bdld::ManagedDatum       *result,
+                      const bslstl::StringRef&  json)
+{
+    return decodeImp(result, json, false);
+}
+
+int DatumUtil::decodeReferencingInput(bdld::ManagedDatum       *result,
+                                      const bslstl::StringRef&  json)
+{
+    return decodeImp(result, json, true);
+}
+
+int DatumUtil::encode(bsl::string *result, const bdld::Datum& datum)
+{
+    BSLS_ASSERT(result);
+
+    result->clear();
+
+    Writer writer(result);
+
+    const int rc = encodeDatum(&writer, datum);
+    writer.flush();
+
+    return rc;
+}
+
+int DatumUtil::encode(bsl::ostream& stream, const bdld::Datum& datum)
+{
+    if (!stream.good()) {
+        return -1;                                                    // RETURN
+    }
+
+    Writer writer(stream.rdbuf());
+
+    const int rc = encodeDatum(&writer, datum);
+    writer.flush();
+
+    if (writer.failed()) {
+        stream.setstate(bsl::ios_base::badbit);
+        return -1;                                                    // RETURN
+    }
+    return rc;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
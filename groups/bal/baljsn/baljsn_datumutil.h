@@ -0,0 +1,247 @@
+// baljsn_datumutil.h                                                 -*-C++-*-
+#ifndef INCLUDED_BALJSN_DATUMUTIL
+#define INCLUDED_BALJSN_DATUMUTIL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide conversions between JSON text and 'bdld::Datum' values.
+//
+//@CLASSES:
+//  baljsn::DatumUtil: namespace for converting JSON text to and from 'Datum'
+//
+//@SEE_ALSO: bdld_datum, bdld_manageddatum, baljsn_decoder
+//
+//@DESCRIPTION: This component provides a namespace, 'baljsn::DatumUtil',
+// containing functions that decode JSON text (RFC 7159) into a
+// 'bdld::ManagedDatum', and encode a 'bdld::Datum' as JSON text.  Unlike
+// 'baljsn::Decoder' and 'baljsn::Encoder', which operate on 'bdeat'-compatible
+// types whose structure is known at compile time, these functions operate on
+// documents of arbitrary structure.
+//
+///Decoding
+///--------
+// 'decode' and 'decodeReferencingInput' parse the text in a single pass over a
+// contiguous buffer, creating every scalar value directly from the text and
+// every array and map, once all of its elements are known, with a single
+// allocation of exactly the required size.  Elements of arrays and maps being
+// parsed are held on stacks supplied by a 'bdlma::BufferedSequentialAllocator'
+// whose initial buffer is local to the call, so that decoding small documents
+// allocates no temporary memory.  The parser does not recurse, so the depth of
+// nesting of the text is limited only by available memory.
+//
+// The memory of the resulting 'bdld::Datum' is supplied by the allocator of
+// the 'bdld::ManagedDatum' into which it is loaded.  Because the result is
+// typically read and then discarded as a whole, using a sequential allocator
+// (e.g., 'bdlma::BufferedSequentialAllocator' or 'bdlma::SequentialAllocator')
+// for the 'bdld::ManagedDatum' is particularly effective.
+//
+// 'decode' copies every string (and map key) into the result, which is
+// therefore independent of the text.  'decodeReferencingInput' copies only
+// strings and keys containing escape sequences; all others refer to the text,
+// which must therefore remain valid (and unmodified) for as long as the result
+// is used.
+//
+// JSON values are decoded as follows:
+//..
+//  JSON value           'bdld::Datum' type
+//  ----------           ------------------
+//  null                 e_NIL
+//  true, false          e_BOOLEAN
+//  number               e_DOUBLE   (the nearest 'double' value)
+//  string               e_STRING   (escape sequences decoded to UTF-8)
+//  array                e_ARRAY
+//  object               e_MAP      (members in order of appearance)
+//..
+// Maps are not sorted, and an object having several members with the same name
+// is decoded to a map having several entries with that key.  Numbers whose
+// magnitude is too large to be represented by a 'double' are rejected.  Note
+// that the text is not checked to be valid UTF-8.
+//
+///Encoding
+///--------
+// 'encode' writes a 'bdld::Datum' as compact JSON text (i.e., having no
+// whitespace), buffering the output locally and writing integers and
+// floating-point values directly into that buffer.  Datums are encoded as
+// follows:
+//..
+//  'bdld::Datum' type   JSON value
+//  ------------------   ----------
+//  e_NIL                null
+//  e_BOOLEAN            true, false
+//  e_INTEGER            number
+//  e_INTEGER64          number
+//  e_DOUBLE             number     (shortest text that reads back exactly)
+//  e_STRING             string
+//  e_DATE               string     (ISO 8601)
+//  e_TIME               string     (ISO 8601)
+//  e_DATETIME           string     (ISO 8601)
+//  e_ARRAY              array
+//  e_MAP                object
+//..
+// Encoding fails for datums holding (or holding, at any depth, arrays or maps
+// holding) values of any other type, infinite or NaN 'double' values, and
+// strings that are not valid UTF-8.  Note that 'e_INTEGER64' values whose
+// magnitude exceeds 2^53 are not decoded back to the same value.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Reading and Writing a JSON Document
+///----------------------------------------------
+// Suppose we receive a JSON document describing a trade, which we read into a
+// 'bdld::Datum', and we want to write a modified copy of it.
+//
+// First, we create the text of the document:
+//..
+//  const char TEXT[] = "{\"security\":\"IBM\","
+//                      "\"quantity\":100,"
+//                      "\"tags\":[\"equity\",\"us\"]}";
+//..
+// Then, we create an arena whose memory is released as a whole once we have
+// finished with the document, and a 'bdld::ManagedDatum' using that arena.
+// Because the text outlives the datum, we can avoid copying its strings:
+//..
+//  char                               buffer[1024];
+//  bdlma::BufferedSequentialAllocator arena(buffer, sizeof buffer);
+//
+//  bdld::ManagedDatum document(&arena);
+//  int rc = baljsn::DatumUtil::decodeReferencingInput(&document, TEXT);
+//  assert(0 == rc);
+//..
+// Next, we examine the document:
+//..
+//  assert(document->isMap());
+//
+//  const bdld::DatumMapRef trade = document->theMap();
+//  assert(3 == trade.size());
+//
+//  const bdld::Datum *security = trade.find("security");
+//  assert(security && "IBM" == security->theString());
+//
+//  const bdld::Datum *quantity = trade.find("quantity");
+//  assert(quantity && 100.0 == quantity->theDouble());
+//..
+// Then, we create a copy of the document having a larger quantity:
+//..
+//  bdld::DatumMutableMapRef copy;
+//  bdld::Datum::createUninitializedMap(&copy, trade.size(), &arena);
+//  for (bdld::DatumMapRef::SizeType i = 0; i < trade.size(); ++i) {
+//      copy.data()[i] = trade[i];
+//      if ("quantity" == trade[i].key()) {
+//          copy.data()[i] = bdld::DatumMapEntry(
+//                                          trade[i].key(),
+//                                          bdld::Datum::createDouble(250.0));
+//      }
+//  }
+//  *copy.size() = trade.size();
+//
+//  const bdld::Datum modified = bdld::Datum::adoptMap(copy);
+//..
+// Finally, we write the modified document:
+//..
+//  bsl::string text;
+//  rc = baljsn::DatumUtil::encode(&text, modified);
+//  assert(0 == rc);
+//  assert("{\"security\":\"IBM\","
+//         "\"quantity\":250,"
+//         "\"tags\":[\"equity\",\"us\"]}" == text);
+//..
+// Note that the copy shares its elements with the original, so we do not
+// destroy it separately: the memory of both is released by 'arena'.
+
+#ifndef INCLUDED_BALSCM_VERSION
+#include <balscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLD_DATUM
+#include <bdld_datum.h>
+#endif
+
+#ifndef INCLUDED_BDLD_MANAGEDDATUM
+#include <bdld_manageddatum.h>
+#endif
+
+#ifndef INCLUDED_BSLSTL_STRINGREF
+#include <bslstl_stringref.h>
+#endif
+
+#ifndef INCLUDED_BSL_OSTREAM
+#include <bsl_ostream.h>
+#endif
+
+#ifndef INCLUDED_BSL_STRING
+#include <bsl_string.h>
+#endif
+
+namespace BloombergLP {
+namespace baljsn {
+
+                              // ================
+                              // struct DatumUtil
+                              // ================
+
+struct DatumUtil {
+    // This 'struct' provides a namespace for utility functions that convert
+    // JSON text to and from 'bdld::Datum' values.
+
+    // CLASS METHODS
+    static int decode(bdld::ManagedDatum       *result,
+                      const bslstl::StringRef&  json);
+        // Load into the specified 'result' the value represented by the
+        // specified 'json' text, copying every string and map key into memory
+        // supplied by the allocator of 'result'.  Return 0 on success, and a
+        // non-zero value, with no effect on 'result', if 'json' is not a
+        // single JSON value optionally surrounded by whitespace.  See
+        // {Decoding}.
+
+    static int decodeReferencingInput(bdld::ManagedDatum       *result,
+                                      const bslstl::StringRef&  json);
+        // Load into the specified 'result' the value represented by the
+        // specified 'json' text, copying into memory supplied by the allocator
+        // of 'result' only those strings and map keys that contain escape
+        // sequences; all other strings and keys refer to 'json'.  Return 0 on
+        // success, and a non-zero value, with no effect on 'result', if 'json'
+        // is not a single JSON value optionally surrounded by whitespace.  The
+        // behavior is undefined unless the text referred to by 'json' remains
+        // valid and unmodified for as long as the value of 'result' is used.
+        // See {Decoding}.
+
+    static int encode(bsl::string *result, const bdld::Datum& datum);
+        // Load into the specified 'result' the compact JSON text representing
+        // the value of the specified 'datum'.  Return 0 on success, and a
+        // non-zero value, leaving 'result' in a valid but unspecified state,
+        // if 'datum' has no JSON representation.  See {Encoding}.
+
+    static int encode(bsl::ostream& stream, const bdld::Datum& datum);
+        // Write to the specified 'stream' the compact JSON text representing
+        // the value of the specified 'datum'.  Return 0 on success, and a
+        // non-zero value, having written an unspecified prefix of that text,
+        // if 'datum' has no JSON representation or 'stream' is not (or
+        // becomes not) valid for writing; in the latter case, set the
+        // 'badbit' of 'stream'.  See {Encoding}.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1041 @@
+// baljsn_datumutil.t.cpp                                             -*-C++-*-
+#include <baljsn_datumutil.h>
+
+#include <bslim_testutil.h>
+
+#include <bdld_datummaker.h>
+
+#include <bdlma_bufferedsequentialallocator.h>
+#include <bdlma_sequentialallocator.h>
+
+#include <bdlt_date.h>
+#include <bdlt_datetime.h>
+#include <bdlt_datetimeinterval.h>
+#include <bdlt_time.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_limits.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+using bsl::cout;
+using bsl::cerr;
+using bsl::endl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                             Overview
+//                             --------
+// The component under test implements a utility for converting JSON text to
+// and from 'bdld::Datum' values.  The decoding functions are tested using a
+// table of texts and the datums they are expected to produce, and a table of
+// invalid texts; for both, we verify that memory is obtained only from the
+// allocator of the result, and that none is leaked.  The encoding functions
+// are tested using a table of datums and the texts they are expected to
+// produce.  Finally, we verify that encoding and decoding are inverse
+// operations, including for deeply nested values.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 2] int decode(bdld::ManagedDatum *, const bslstl::StringRef&);
+// [ 2] int decodeReferencingInput(ManagedDatum *, const StringRef&);
+// [ 5] int encode(bsl::string *result, const bdld::Datum& datum);
+// [ 5] int encode(bsl::ostream& stream, const bdld::Datum& datum);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] DECODING ARRAYS AND MAPS
+// [ 4] DECODING INVALID TEXT
+// [ 6] ROUND TRIP
+// [ 7] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef baljsn::DatumUtil  Util;
+typedef bslstl::StringRef  StringRef;
+typedef bdld::Datum        Datum;
+typedef bdld::ManagedDatum ManagedDatum;
+typedef bdld::DatumMaker   DatumMaker;
+
+bool refersTo(const StringRef& string, const StringRef& text)
+    // Return 'true' if the characters of the specified 'string' lie within
+    // the specified 'text', and 'false' otherwise.
+{
+    return text.begin() <= string.begin() && string.end() <= text.end();
+}
+
+bool stringsReferTo(const Datum& datum, const StringRef& text)
+    // Return 'true' if every non-empty string and map key held (at any depth)
+    // by the specified 'datum' lies within the specified 'text', and 'false'
+    // otherwise.
+{
+    if (datum.isString()) {
+        return datum.theString().isEmpty()
+            || refersTo(datum.theString(), text);                     // RETURN
+    }
+    if (datum.isArray()) {
+        for (bsl::size_t i = 0; i < datum.theArray().length(); ++i) {
+            if (!stringsReferTo(datum.theArray()[i], text)) {
+                return false;                                         // RETURN
+            }
+        }
+    }
+    if (datum.isMap()) {
+        for (bsl::size_t i = 0; i < datum.theMap().size(); ++i) {
+            const bdld::DatumMapEntry& entry = datum.theMap()[i];
+            if (!(entry.key().isEmpty() || refersTo(entry.key(), text))
+             || !stringsReferTo(entry.value(), text)) {
+                return false;                                         // RETURN
+            }
+        }
+    }
+    return true;
+}
+
+bool stringsAreOutside(const Datum& datum, const StringRef& text)
+    // Return 'true' if no string or map key held (at any depth) by the
+    // specified 'datum' lies within the specified 'text', and 'false'
+    // otherwise.
+{
+    if (datum.isString()) {
+        return !refersTo(datum.theString(), text);                    // RETURN
+    }
+    if (datum.isArray()) {
+        for (bsl::size_t i = 0; i < datum.theArray().length(); ++i) {
+            if (!stringsAreOutside(datum.theArray()[i], text)) {
+                return false;                                         // RETURN
+            }
+        }
+    }
+    if (datum.isMap()) {
+        for (bsl::size_t i = 0; i < datum.theMap().size(); ++i) {
+            const bdld::DatumMapEntry& entry = datum.theMap()[i];
+            if (refersTo(entry.key(), text)
+             || !stringsAreOutside(entry.value(), text)) {
+                return false;                                         // RETURN
+            }
+        }
+    }
+    return true;
+}
+
+class FixedBuffer : public bsl::streambuf {
+    // This class implements a stream buffer that accepts only as many
+    // characters as fit in a fixed buffer.
+
+  public:
+    // CREATORS
+    FixedBuffer(char *buffer, int size)
+        // Create a stream buffer writing to the specified 'buffer' of the
+        // specified 'size'.
+    {
+        setp(buffer, buffer + size);
+    }
+};
+
+void generateDocument(bsl::string *result, bsl::size_t size)
+    // Load into the specified 'result' a JSON document, of at least the
+    // specified 'size' bytes, holding an array of records of typical content.
+{
+    result->clear();
+    result->reserve(size + 256);
+    result->append("[");
+
+    for (int i = 0; result->size() < size; ++i) {
+        bsl::ostringstream record;
+        record << (i ? "," : "")
+               << "{\"id\":" << i
+               << ",\"name\":\"instrument " << i << "\""
+               << ",\"price\":" << i * 0.25 + 0.125
+               << ",\"active\":" << (i % 2 ? "true" : "false")
+               << ",\"tags\":[\"equity\",\"line\\nbreak\",null]"
+               << ",\"limits\":{\"low\":-1.5e3,\"high\":" << i << "}}";
+        result->append(record.str());
+    }
+    result->append("]");
+}
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+
+    bool verbose = argc > 2;
+    bool veryVerbose = argc > 3;
+    bool veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator          globalAllocator("global", veryVeryVerbose);
+    bslma::Default::setGlobalAllocator(&globalAllocator);
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Reading and Writing a JSON Document
+///----------------------------------------------
+// Suppose we receive a JSON document describing a trade, which we read into a
+// 'bdld::Datum', and we want to write a modified copy of it.
+//
+// First, we create the text of the document:
+//..
+    const char TEXT[] = "{\"security\":\"IBM\","
+                        "\"quantity\":100,"
+                        "\"tags\":[\"equity\",\"us\"]}";
+//..
+// Then, we create an arena whose memory is released as a whole once we have
+// finished with the document, and a 'bdld::ManagedDatum' using that arena.
+// Because the text outlives the datum, we can avoid copying its strings:
+//..
+    char                               buffer[1024];
+    bdlma::BufferedSequentialAllocator arena(buffer, sizeof buffer);
+
+    bdld::ManagedDatum document(&arena);
+    int rc = baljsn::DatumUtil::decodeReferencingInput(&document, TEXT);
+    ASSERT(0 == rc);
+//..
+// Next, we examine the document:
+//..
+    ASSERT(document->isMap());
+
+    const bdld::DatumMapRef trade = document->theMap();
+    ASSERT(3 == trade.size());
+
+    const bdld::Datum *security = trade.find("security");
+    ASSERT(security && "IBM" == security->theString());
+
+    const bdld::Datum *quantity = trade.find("quantity");
+    ASSERT(quantity && 100.0 == quantity->theDouble());
+//..
+// Then, we create a copy of the document having a larger quantity:
+//..
+    bdld::DatumMutableMapRef copy;
+    bdld::Datum::createUninitializedMap(&copy, trade.size(), &arena);
+    for (bdld::DatumMapRef::SizeType i = 0; i < trade.size(); ++i) {
+        copy.data()[i] = trade[i];
+        if ("quantity" == trade[i].key()) {
+            copy.data()[i] = bdld::DatumMapEntry(
+                                            trade[i].key(),
+                                            bdld::Datum::createDouble(250.0));
+        }
+    }
+    *copy.size() = trade.size();
+
+    const bdld::Datum modified = bdld::Datum::adoptMap(copy);
+//..
+// Finally, we write the modified document:
+//..
+    bsl::string text;
+    rc = baljsn::DatumUtil::encode(&text, modified);
+    ASSERT(0 == rc);
+    ASSERT("{\"security\":\"IBM\","
+           "\"quantity\":250,"
+           "\"tags\":[\"equity\",\"us\"]}" == text);
+//..
+// Note that the copy shares its elements with the original, so we do not
+// destroy it separately: the memory of both is released by 'arena'.
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // ROUND TRIP
+        //
+        // Concerns:
+        //: 1 Decoding the text produced by encoding a datum that has a JSON
+        //:   representation produces a datum equal to the original, and
+        //:   encoding that datum produces the same text.
+        //:
+        //: 2 Deeply nested values are decoded and encoded.
+        //:
+        //: 3 Output longer than the internal buffer of the encoder is written
+        //:   completely to both strings and streams.
+        //
+        // Plan:
+        //: 1 Generate a document of several kilobytes, decode it, encode the
+        //:   result, and verify that the text is unchanged apart from
+        //:   whitespace and the representation of numbers, by decoding it
+        //:   again and comparing the datums.  (C-1, 3)
+        //:
+        //: 2 Decode and encode arrays and maps nested 10000 deep.  (C-2)
+        //
+        // Testing:
+        //   ROUND TRIP
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ROUND TRIP" << endl
+                          << "==========" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+        bslma::TestAllocator         oa("object", veryVeryVerbose);
+
+        if (verbose) cout << "\nTesting a generated document." << endl;
+        {
+            bsl::string document(&oa);
+            generateDocument(&document, 20000);
+
+            ManagedDatum first(&oa);
+            ASSERT(0 == Util::decode(&first, document));
+
+            bsl::string text(&oa);
+            ASSERT(0 == Util::encode(&text, *first));
+
+            ManagedDatum second(&oa);
+            ASSERT(0 == Util::decode(&second, text));
+            ASSERT(*first == *second);
+
+            bsl::string again(&oa);
+            ASSERT(0 == Util::encode(&again, *second));
+            ASSERT(text == again);
+
+            bsl::ostringstream stream(&oa);
+            ASSERT(0 == Util::encode(stream, *second));
+            ASSERT(stream.good());
+            ASSERT(text == stream.str());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\nTesting deep nesting." << endl;
+        {
+            const int k_DEPTH = 10000;
+
+            const char *OPEN[]  = { "[",  "{\"k\":" };
+            const char *CLOSE[] = { "]",  "}"       };
+
+            for (int ti = 0; ti < 2; ++ti) {
+                bsl::string document(&oa);
+                for (int i = 0; i < k_DEPTH; ++i) {
+                    document.append(OPEN[ti]);
+                }
+                document.append("1");
+                for (int i = 0; i < k_DEPTH; ++i) {
+                    document.append(CLOSE[ti]);
+                }
+
+                ManagedDatum result(&oa);
+                ASSERTV(ti, 0 == Util::decodeReferencingInput(&result,
+                                                              document));
+
+                bsl::string text(&oa);
+                ASSERTV(ti, 0 == Util::encode(&text, *result));
+                ASSERTV(ti, document == text);
+
+                // Remove the final closing bracket.
+
+                document.resize(document.size() - 1);
+                ManagedDatum unchanged(&oa);
+                ASSERTV(ti, 0 != Util::decode(&unchanged, document));
+                ASSERTV(ti, unchanged->isNull());
+            }
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // ENCODING
+        //
+        // Concerns:
+        //: 1 Each type having a JSON representation is encoded as documented,
+        //:   with strings escaped and doubles formatted in the shortest form
+        //:   that reads back to the same value.
+        //:
+        //: 2 Datums holding, at any depth, values having no JSON
+        //:   representation, non-finite doubles, or invalid UTF-8 fail to
+        //:   encode.
+        //:
+        //: 3 The stream overload writes the same text, fails if the stream is
+        //:   not valid for writing, and sets 'badbit' if writing fails.
+        //:
+        //: 4 No memory is allocated except by the result string.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, encode datums created with a
+        //:   'bdld::DatumMaker', and verify the status and text produced by
+        //:   both overloads.  (C-1..2)
+        //:
+        //: 2 Encode to a stream in a failed state, and to a stream whose
+        //:   buffer is full.  (C-3)
+        //:
+        //: 3 Use a test allocator to verify that the default allocator is not
+        //:   used.  (C-4)
+        //
+        // Testing:
+        //   int encode(bsl::string *result, const bdld::Datum& datum);
+        //   int encode(bsl::ostream& stream, const bdld::Datum& datum);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ENCODING" << endl
+                          << "========" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+        bslma::TestAllocator         sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator         oa("object", veryVeryVerbose);
+
+        bdlma::SequentialAllocator arena(&sa);
+        DatumMaker                 m(&arena);
+
+        const char INVALID_UTF8[] = "\xC0\x80";
+        int        udt            = 0;
+
+        const struct {
+            int         d_line;
+            Datum       d_datum;
+            const char *d_expected;  // 0 if encoding fails
+        } DATA[] = {
+            { L_, m(),                             "null"                 },
+            { L_, m(true),                         "true"                 },
+            { L_, m(false),                        "false"                },
+            { L_, m(0),                            "0"                    },
+            { L_, m(-2147483647 - 1),              "-2147483648"          },
+            { L_, m(bsls::Types::Int64(1) << 62),  "4611686018427387904"  },
+            { L_, m(0.1),                          "0.1"                  },
+            { L_, m(-2.5),                         "-2.5"                 },
+            { L_, m(1e300),                        "1e+300"               },
+            { L_, m(""),                           "\"\""                 },
+            { L_, m("plain"),                      "\"plain\""            },
+            { L_, m("q\"b\\s/"),                   "\"q\\\"b\\\\s\\/\""   },
+            { L_, m("\b\f\n\r\t"),                 "\"\\b\\f\\n\\r\\t\""  },
+            { L_, m(StringRef("\0\x1f", 2)),       "\"\\u0000\\u001f\""   },
+            { L_, m("\xC3\xA9\xF0\x9F\x98\x80"),
+                                           "\"\xC3\xA9\xF0\x9F\x98\x80\"" },
+            { L_, m(bdlt::Date(2016, 2, 29)),      "\"2016-02-29\""       },
+            { L_, m(bdlt::Time(12, 34, 56)),       "\"12:34:56.000\""     },
+            { L_, m(bdlt::Datetime(2016, 2, 29, 12, 34, 56)),
+                                             "\"2016-02-29T12:34:56.000\"" },
+            { L_, m.a(),                           "[]"                   },
+            { L_, m.a(1, "two", m.a()),            "[1,\"two\",[]]"       },
+            { L_, m.m(),                           "{}"                   },
+            { L_, m.m("a", 1, "b", m.m("c", m.a(true))),
+                                      "{\"a\":1,\"b\":{\"c\":[true]}}"     },
+            { L_, m.m("k\n", 1),                   "{\"k\\n\":1}"         },
+
+            { L_, m(bsl::numeric_limits<double>::infinity()),           0 },
+            { L_, m(bsl::numeric_limits<double>::quiet_NaN()),          0 },
+            { L_, m(bdlt::DatetimeInterval(1)),                         0 },
+            { L_, m(bdld::DatumError(1)),                               0 },
+            { L_, m(bdld::DatumUdt(&udt, 1)),                           0 },
+            { L_, m(StringRef(INVALID_UTF8, 2)),                        0 },
+            { L_, m.a(1, m.a(bdld::DatumError(1))),                     0 },
+            { L_, m.m(StringRef(INVALID_UTF8, 2), 1),                   0 },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int    LINE     = DATA[ti].d_line;
+            const Datum& DATUM    = DATA[ti].d_datum;
+            const char  *EXPECTED = DATA[ti].d_expected;
+
+            if (veryVerbose) { T_ P_(LINE) P(DATUM) }
+
+            bsl::string        result(&oa);
+            bsl::ostringstream stream(&oa);
+
+            const bsls::Types::Int64 NUM_BLOCKS = da.numBlocksTotal();
+
+            const int rc       = Util::encode(&result, DATUM);
+            const int streamRc = Util::encode(stream, DATUM);
+
+            ASSERTV(LINE, NUM_BLOCKS == da.numBlocksTotal());
+
+            if (EXPECTED) {
+                ASSERTV(LINE, rc, 0 == rc);
+                ASSERTV(LINE, EXPECTED, result, EXPECTED == result);
+
+                ASSERTV(LINE, streamRc, 0 == streamRc);
+                ASSERTV(LINE, stream.good());
+                ASSERTV(LINE, EXPECTED, stream.str(),
+                        EXPECTED == stream.str());
+            }
+            else {
+                ASSERTV(LINE, rc, 0 != rc);
+                ASSERTV(LINE, streamRc, 0 != streamRc);
+            }
+        }
+
+        if (verbose) cout << "\nTesting streams not valid for writing."
+                          << endl;
+        {
+            bsl::ostringstream stream(&oa);
+            stream.setstate(bsl::ios_base::failbit);
+
+            ASSERT(0 != Util::encode(stream, m(1)));
+            ASSERT(stream.str().empty());
+
+            char         buffer[4];
+            FixedBuffer  fixed(buffer, sizeof buffer);
+            bsl::ostream full(&fixed);
+
+            ASSERT(0 != Util::encode(full, m("too long")));
+            ASSERT(full.bad());
+            ASSERT(0 == bsl::memcmp("\"too", buffer, sizeof buffer));
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // DECODING INVALID TEXT
+        //
+        // Concerns:
+        //: 1 Text that is not a single JSON value optionally surrounded by
+        //:   whitespace is rejected by both decoding functions.
+        //:
+        //: 2 On failure, the result is unchanged and all memory allocated
+        //:   while parsing is released, whatever the point of failure.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, decode invalid texts, each
+        //:   including complete values before the point of failure, into a
+        //:   'bdld::ManagedDatum' holding an array, and verify the status,
+        //:   that the result is unchanged, and, using a test allocator, that
+        //:   no memory remains allocated apart from the original value.
+        //:   (C-1..2)
+        //
+        // Testing:
+        //   DECODING INVALID TEXT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DECODING INVALID TEXT" << endl
+                          << "=====================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+        bslma::TestAllocator         oa("object", veryVeryVerbose);
+
+        const struct {
+            int         d_line;
+            const char *d_text;
+        } DATA[] = {
+            { L_, ""                                                   },
+            { L_, "   "                                                },
+            { L_, "nul"                                                },
+            { L_, "nulls"                                              },
+            { L_, "True"                                               },
+            { L_, "fals"                                               },
+            { L_, "1 2"                                                },
+            { L_, "+1"                                                 },
+            { L_, "01"                                                 },
+            { L_, "1."                                                 },
+            { L_, ".5"                                                 },
+            { L_, "1e"                                                 },
+            { L_, "1e+"                                                },
+            { L_, "-"                                                  },
+            { L_, "1e400"                                              },
+            { L_, "-1e400"                                             },
+            { L_, "NaN"                                                },
+            { L_, "\"unterminated"                                     },
+            { L_, "\"unterminated\\\""                                 },
+            { L_, "\"control\tcharacter\""                             },
+            { L_, "\"\\x\""                                            },
+            { L_, "\"\\u12\""                                          },
+            { L_, "\"\\u12G4\""                                        },
+            { L_, "\"\\uDC00\""                                        },
+            { L_, "\"\\uD800\""                                        },
+            { L_, "\"\\uD800\\u0041\""                                 },
+            { L_, "\"\\uD800x\""                                       },
+            { L_, "["                                                  },
+            { L_, "[1"                                                 },
+            { L_, "[1,"                                                },
+            { L_, "[1,]"                                               },
+            { L_, "[,1]"                                               },
+            { L_, "[1 2]"                                              },
+            { L_, "[1}"                                                },
+            { L_, "]"                                                  },
+            { L_, "{"                                                  },
+            { L_, "{\"a\""                                             },
+            { L_, "{\"a\":"                                            },
+            { L_, "{\"a\" 1}"                                          },
+            { L_, "{\"a\":1"                                           },
+            { L_, "{\"a\":1,}"                                         },
+            { L_, "{\"a\":1]"                                          },
+            { L_, "{a:1}"                                              },
+            { L_, "{1:1}"                                              },
+            { L_, "{\"\\q\":1}"                                        },
+            { L_, "[\"string\",{\"a\":[1,\"two\"]},\"x\",\"\\q\"]"     },
+            { L_, "[\"string\",{\"\\n\":[1,\"two\"],\"b\":}]"          },
+            { L_, "{\"a\":[\"long string value\",{}],\"b\":[[]]} x"    },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int   LINE = DATA[ti].d_line;
+            const char *TEXT = DATA[ti].d_text;
+
+            if (veryVerbose) { T_ P_(LINE) P(TEXT) }
+
+            for (int referenceInput = 0; referenceInput < 2;
+                                                           ++referenceInput) {
+                ManagedDatum result(&oa);
+                ASSERTV(LINE, 0 == Util::decode(&result, "[\"original\"]"));
+
+                const bsls::Types::Int64 NUM_BLOCKS = oa.numBlocksInUse();
+
+                const int rc = referenceInput
+                             ? Util::decodeReferencingInput(&result, TEXT)
+                             : Util::decode(&result, TEXT);
+
+                ASSERTV(LINE, referenceInput, rc, 0 != rc);
+                ASSERTV(LINE, referenceInput,
+                        NUM_BLOCKS == oa.numBlocksInUse());
+                ASSERTV(LINE, referenceInput,
+                        result->isArray()
+                     && 1 == result->theArray().length()
+                     && "original" == result->theArray()[0].theString());
+            }
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // DECODING ARRAYS AND MAPS
+        //
+        // Concerns:
+        //: 1 Arrays and objects, empty, nested, and surrounded by arbitrary
+        //:   whitespace, are decoded to arrays and maps holding their elements
+        //:   and members in order, including members having the same name.
+        //:
+        //: 2 'decode' copies every string and key, and
+        //:   'decodeReferencingInput' copies only those having escape
+        //:   sequences.
+        //:
+        //: 3 Temporary memory is not obtained from the result's allocator, and
+        //:   no memory is leaked.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, decode texts with both
+        //:   functions, and compare the results with datums created with a
+        //:   'bdld::DatumMaker'.  (C-1)
+        //:
+        //: 2 Verify that the strings of the results lie outside (respectively,
+        //:   for texts having no escape sequences, inside) the text.  (C-2)
+        //:
+        //: 3 Use test allocators to verify that destroying the result
+        //:   releases all memory obtained from the result's allocator, and
+        //:   that the default allocator is used only for large documents.
+        //:   (C-3)
+        //
+        // Testing:
+        //   DECODING ARRAYS AND MAPS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DECODING ARRAYS AND MAPS" << endl
+                          << "========================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+        bslma::TestAllocator         sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator         oa("object", veryVeryVerbose);
+
+        bdlma::SequentialAllocator arena(&sa);
+        DatumMaker                 m(&arena);
+
+        const struct {
+            int         d_line;
+            const char *d_text;
+            Datum       d_expected;
+            bool        d_hasEscapes;
+        } DATA[] = {
+            { L_, "[]",                  m.a(),                      false },
+            { L_, " [ ] ",               m.a(),                      false },
+            { L_, "{}",                  m.m(),                      false },
+            { L_, "\t{\r\n}\n",          m.m(),                      false },
+            { L_, "[1]",                 m.a(1.0),                   false },
+            { L_, "[ 1 , \"a\" , null ]",
+                                         m.a(1.0, "a", m()),         false },
+            { L_, "[[],[[]],{}]",        m.a(m.a(), m.a(m.a()), m.m()),
+                                                                     false },
+            { L_, "{\"a\":1}",           m.m("a", 1.0),              false },
+            { L_, " { \"a\" : 1 , \"b\" : true } ",
+                                         m.m("a", 1.0, "b", true),   false },
+            { L_, "{\"\":\"\"}",         m.m("", ""),                false },
+            { L_, "{\"a\":1,\"a\":2}",   m.m("a", 1.0, "a", 2.0),    false },
+            { L_, "{\"a\":[1,{\"b\":[]}],\"c\":{\"d\":{}}}",
+                               m.m("a", m.a(1.0, m.m("b", m.a())),
+                                   "c", m.m("d", m.m())),            false },
+            { L_, "[{\"a\":1},{\"b\":2}]",
+                                  m.a(m.m("a", 1.0), m.m("b", 2.0)), false },
+            { L_, "{\"x\\ny\":1}",       m.m("x\ny", 1.0),           true  },
+            { L_, "{\"a\":1,\"\\u00e9\":[\"\\\"\"]}",
+                           m.m("a", 1.0, "\xC3\xA9", m.a("\"")),     true  },
+            { L_, "[\"a long string without escapes\",\"t\\tab\"]",
+                   m.a("a long string without escapes", "t\tab"),    true  },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int    LINE        = DATA[ti].d_line;
+            const char  *TEXT        = DATA[ti].d_text;
+            const Datum& EXPECTED    = DATA[ti].d_expected;
+            const bool   HAS_ESCAPES = DATA[ti].d_hasEscapes;
+
+            if (veryVerbose) { T_ P_(LINE) P(TEXT) }
+
+            {
+                ManagedDatum result(&oa);
+                ASSERTV(LINE, 0 == Util::decode(&result, TEXT));
+                ASSERTV(LINE, EXPECTED, *result, EXPECTED == *result);
+                ASSERTV(LINE, stringsAreOutside(*result, TEXT));
+            }
+            ASSERTV(LINE, 0 == oa.numBlocksInUse());
+            {
+                ManagedDatum result(&oa);
+                ASSERTV(LINE, 0 == Util::decodeReferencingInput(&result,
+                                                                TEXT));
+                ASSERTV(LINE, EXPECTED, *result, EXPECTED == *result);
+                ASSERTV(LINE, HAS_ESCAPES || stringsReferTo(*result, TEXT));
+            }
+            ASSERTV(LINE, 0 == oa.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nTesting use of the default allocator."
+                          << endl;
+        {
+            ASSERT(0 == da.numBlocksTotal());
+
+            bsl::string document(&oa);
+            generateDocument(&document, 100000);
+
+            ManagedDatum result(&oa);
+            ASSERT(0 == Util::decode(&result, document));
+            ASSERT(result->isArray());
+            ASSERT(0 <  da.numBlocksTotal());
+            ASSERT(0 == da.numBlocksInUse());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // DECODING SCALARS
+        //
+        // Concerns:
+        //: 1 'null', 'true', 'false', numbers, and strings, surrounded by
+        //:   arbitrary whitespace, are decoded to datums of the documented
+        //:   types and values.
+        //:
+        //: 2 Every escape sequence, including surrogate pairs, is decoded to
+        //:   UTF-8.
+        //:
+        //: 3 Numbers too small in magnitude to be represented are decoded as
+        //:   zero.
+        //:
+        //: 4 Decoding replaces the previous value of the result.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, decode texts with both
+        //:   functions into a 'bdld::ManagedDatum' holding a value, and
+        //:   compare the results with the expected datums.  (C-1..4)
+        //
+        // Testing:
+        //   int decode(bdld::ManagedDatum *, const bslstl::StringRef&);
+        //   int decodeReferencingInput(ManagedDatum *, const StringRef&);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DECODING SCALARS" << endl
+                          << "================" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+        bslma::TestAllocator         sa("supplied", veryVeryVerbose);
+        bslma::TestAllocator         oa("object", veryVeryVerbose);
+
+        bdlma::SequentialAllocator arena(&sa);
+        DatumMaker                 m(&arena);
+
+        const struct {
+            int         d_line;
+            const char *d_text;
+            Datum       d_expected;
+        } DATA[] = {
+            { L_, "null",                      m()                         },
+            { L_, " null ",                    m()                         },
+            { L_, "true",                      m(true)                     },
+            { L_, "\t\r\nfalse\n",             m(false)                    },
+            { L_, "0",                         m(0.0)                      },
+            { L_, "-0",                        m(-0.0)                     },
+            { L_, "1",                         m(1.0)                      },
+            { L_, "-12",                       m(-12.0)                    },
+            { L_, "0.1",                       m(0.1)                      },
+            { L_, "-1.5e3",                    m(-1500.0)                  },
+            { L_, "2E+2",                      m(200.0)                    },
+            { L_, "25e-1",                     m(2.5)                      },
+            { L_, "9007199254740993",          m(9007199254740992.0)       },
+            { L_, "1.7976931348623157e308",    m(1.7976931348623157e308)   },
+            { L_, "1e-400",                    m(0.0)                      },
+            { L_, "\"\"",                      m("")                       },
+            { L_, "\"abc\"",                   m("abc")                    },
+            { L_, "\"a string longer than a short string\"",
+                              m("a string longer than a short string")     },
+            { L_, "\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"",
+                                               m("\"\\/\b\f\n\r\t")        },
+            { L_, "\"x\\u0041y\"",             m("xAy")                    },
+            { L_, "\"\\u0000\"",               m(StringRef("\0", 1))       },
+            { L_, "\"\\u00e9\\u00E9\"",        m("\xC3\xA9\xC3\xA9")       },
+            { L_, "\"\\u20ac\"",               m("\xE2\x82\xAC")           },
+            { L_, "\"\\ud83d\\ude00\"",        m("\xF0\x9F\x98\x80")       },
+            { L_, "\"\xC3\xA9\"",              m("\xC3\xA9")               },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int    LINE     = DATA[ti].d_line;
+            const char  *TEXT     = DATA[ti].d_text;
+            const Datum& EXPECTED = DATA[ti].d_expected;
+
+            if (veryVerbose) { T_ P_(LINE) P(TEXT) }
+
+            for (int referenceInput = 0; referenceInput < 2;
+                                                           ++referenceInput) {
+                ManagedDatum result(Datum::copyString("previous", &oa), &oa);
+
+                const int rc = referenceInput
+                             ? Util::decodeReferencingInput(&result, TEXT)
+                             : Util::decode(&result, TEXT);
+
+                ASSERTV(LINE, referenceInput, rc, 0 == rc);
+                ASSERTV(LINE, referenceInput, EXPECTED, *result,
+                        EXPECTED == *result);
+
+                if (EXPECTED.isDouble() && 0 == EXPECTED.theDouble()) {
+                    // Distinguish '0.0' and '-0.0'.
+
+                    ASSERTV(LINE, referenceInput,
+                            (1 / EXPECTED.theDouble() < 0)
+                         == (1 / result->theDouble() < 0));
+                }
+            }
+            ASSERTV(LINE, 0 == oa.numBlocksInUse());
+        }
+
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Decode a document, verify its contents, and encode it.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        const char TEXT[] = "{\"name\":\"value\",\"list\":[1,true,null]}";
+
+        ManagedDatum result(&oa);
+        ASSERT(0 == Util::decode(&result, TEXT));
+        ASSERT(result->isMap());
+        ASSERT(2 == result->theMap().size());
+        ASSERT("value" == result->theMap().find("name")->theString());
+        ASSERT(3 == result->theMap().find("list")->theArray().length());
+
+        bsl::string text(&oa);
+        ASSERT(0 == Util::encode(&text, *result));
+        ASSERT(TEXT == text);
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //
+        // Concerns:
+        //: 1 Decoding and encoding documents of 1 MB to 100 MB runs at a rate
+        //:   comparable to that of copying the text.
+        //
+        // Plan:
+        //: 1 Generate documents of 1, 10, and 100 MB, and measure the time to
+        //:   decode them with both functions, into a 'bdld::ManagedDatum'
+        //:   using a 'bdlma::SequentialAllocator', and to encode the result.
+        //:   (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE TEST
+        // --------------------------------------------------------------------
+
+        cout << endl
+             << "PERFORMANCE TEST" << endl
+             << "================" << endl;
+
+        const bsl::size_t MEGABYTE = 1024 * 1024;
+        const bsl::size_t SIZES[]  = { 1, 10, 100 };
+
+        for (bsl::size_t ti = 0; ti < sizeof SIZES / sizeof *SIZES; ++ti) {
+            bsl::string document;
+            generateDocument(&document, SIZES[ti] * MEGABYTE);
+
+            const double megabytes =
+                              static_cast<double>(document.size()) / MEGABYTE;
+
+            for (int referenceInput = 0; referenceInput < 2;
+                                                           ++referenceInput) {
+                bdlma::SequentialAllocator arena;
+                ManagedDatum               result(&arena);
+
+                bsls::Stopwatch timer;
+                timer.start();
+
+                const int rc = referenceInput
+                             ? Util::decodeReferencingInput(&result, document)
+                             : Util::decode(&result, document);
+
+                timer.stop();
+                ASSERT(0 == rc);
+
+                cout << megabytes << " MB, "
+                     << (referenceInput ? "decodeReferencingInput: "
+                                        : "decode:                 ")
+                     << megabytes / timer.elapsedTime() << " MB/s" << endl;
+
+                if (referenceInput) {
+                    bsl::string text;
+                    text.reserve(document.size());
+
+                    timer.reset();
+                    timer.start();
+
+                    ASSERT(0 == Util::encode(&text, *result));
+
+                    timer.stop();
+
+                    cout << megabytes << " MB, encode:                 "
+                         << megabytes / timer.elapsedTime() << " MB/s"
+                         << endl;
+                }
+
+                // The memory of 'result' is released by 'arena'.
+
+                result.release();
+            }
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    // CONCERN: In no case does memory come from the global/default allocator.
+
+    LOOP_ASSERT(globalAllocator.numBlocksTotal(),
+                0 == globalAllocator.numBlocksTotal());
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -145,6 +145,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlat_attributeinfo.h>
 #endif
 
+#ifndef INCLUDED_BDLAT_ATTRIBUTENAMEINDEX
+#include <bdlat_attributenameindex.h>
+#endif
+
 #ifndef INCLUDED_BDLAT_CHOICEFUNCTIONS
 #include <bdlat_choicefunctions.h>
 #endif
@@ -442,13 +446,13 @@ int Decoder::decodeImp(TYPE *value, int mode, bdlat_TypeCategory::Sequence)
         // This is an anonymous element.  Do not read anything and instead
         // decode into the corresponding sub-element.
 
-        if (bdlat_SequenceFunctions::hasAttribute(
+        if (bdlat_AttributeNameIndexUtil::hasAttribute(
                                    *value,
                                    d_elementName.data(),
                                    static_cast<int>(d_elementName.length()))) {
             Decoder_ElementVisitor visitor = { this, mode };
 
-            if (0 != bdlat_SequenceFunctions::manipulateAttribute(
+            if (0 != bdlat_AttributeNameIndexUtil::manipulateAttribute(
                                    value,
                                    visitor,
                                    d_elementName.data(),
@@ -503,7 +507,7 @@ int Decoder::decodeImp(TYPE *value, int mode, bdlat_TypeCategory::Sequence)
                 return -1;                                            // RETURN
             }
 
-            if (bdlat_SequenceFunctions::hasAttribute(
+            if (bdlat_AttributeNameIndexUtil::hasAttribute(
                                      *value,
                                      elementName.data(),
                                      static_cast<int>(elementName.length()))) {
@@ -518,7 +522,7 @@ int Decoder::decodeImp(TYPE *value, int mode, bdlat_TypeCategory::Sequence)
 
                 Decoder_ElementVisitor visitor = { this, mode };
 
-                if (0 != bdlat_SequenceFunctions::manipulateAttribute(
+                if (0 != bdlat_AttributeNameIndexUtil::manipulateAttribute(
                                    value,
                                    visitor,
                                    d_elementName.data(),
@@ -172,6 +172,123 @@ int Encoder_EncodeImpl::encodeImp(const bsl::vector<char>&  value,
 
     return encode(base64String, 0);
 }
+
+                           // ----------------------
+                           // class StreamingEncoder
+                           // ----------------------
+
+// PRIVATE MANIPULATORS
+int StreamingEncoder::flushIfNeeded()
+{
+    if (d_buffer.length() < d_flushThreshold) {
+        return 0;                                                     // RETURN
+    }
+
+    if (0 != flush()) {
+        d_state = e_FAILED;
+        return -1;                                                    // RETURN
+    }
+
+    return 0;
+}
+
+// CREATORS
+StreamingEncoder::StreamingEncoder(bsl::streambuf        *streamBuf,
+                                   const EncoderOptions&  options,
+                                   bsl::size_t            flushThreshold,
+                                   bslma::Allocator      *basicAllocator)
+: d_encoder(basicAllocator)
+, d_buffer(basicAllocator)
+, d_options(options)
+, d_encodeImpl(&d_encoder, &d_buffer, d_options)
+, d_streamBuf_p(streamBuf)
+, d_flushThreshold(flushThreshold)
+, d_numBytesFlushed(0)
+, d_numElements(0)
+, d_state(e_INITIAL)
+{
+    BSLS_ASSERT(streamBuf);
+}
+
+StreamingEncoder::~StreamingEncoder()
+{
+    flush();
+}
+
+// MANIPULATORS
+int StreamingEncoder::openArray()
+{
+    BSLS_ASSERT(e_INITIAL == d_state);
+
+    d_state = e_OPEN;
+    return 0;
+}
+
+int StreamingEncoder::closeArray()
+{
+    BSLS_ASSERT(e_INITIAL != d_state);
+    BSLS_ASSERT(e_CLOSED  != d_state);
+
+    if (e_OPEN != d_state) {
+        return -1;                                                    // RETURN
+    }
+
+    // Reproduce the output of 'Encoder_EncodeImpl' for an array of
+    // 'd_numElements' elements.
+
+    if (0 < d_numElements) {
+        d_encodeImpl.d_formatter.setIsArrayElement(false);
+        d_encodeImpl.d_formatter.closeArray();
+    }
+    else {
+        d_encodeImpl.openDocument();
+
+        if (d_options.encodeEmptyArrays()) {
+            d_encodeImpl.d_formatter.openArray(true);
+            d_encodeImpl.d_formatter.closeArray(true);
+        }
+    }
+
+    d_encodeImpl.closeDocument();
+
+    if (0 != flush()) {
+        d_state = e_FAILED;
+        return -1;                                                    // RETURN
+    }
+
+    d_state = e_CLOSED;
+    return 0;
+}
+
+int StreamingEncoder::flush()
+{
+    const bsl::streamsize length = static_cast<bsl::streamsize>(
+                                                           d_buffer.length());
+
+    if (0 < length) {
+        const bsl::streamsize numWritten = d_streamBuf_p->sputn(
+                                                               d_buffer.data(),
+                                                               length);
+
+        if (0 < numWritten) {
+            d_numBytesFlushed += numWritten;
+        }
+
+        // Rewind the buffer rather than resetting it, so that its capacity is
+        // reused for subsequent elements.
+
+        d_buffer.pubseekpos(0, bsl::ios_base::out);
+
+        if (length != numWritten) {
+            d_encodeImpl.logStream() << "Unable to write "
+                                     << length - numWritten
+                                     << " bytes of output." << bsl::endl;
+            return -1;                                                // RETURN
+        }
+    }
+
+    return 0 == d_streamBuf_p->pubsync() ? 0 : -1;
+}
 }  // close package namespace
 
 }  // close enterprise namespace
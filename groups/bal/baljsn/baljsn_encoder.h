@@ -11,6 +11,7 @@ BSLS_IDENT("$Id: $")
 //
 //@CLASSES:
 // baljsn::Encoder: JSON decoder for 'bdeat'-compliant types
+// baljsn::StreamingEncoder: incremental JSON encoder for arrays of elements
 //
 //@SEE_ALSO: baljsn_decoder, baljsn_printutil
 //
@@ -40,6 +41,27 @@ BSLS_IDENT("$Id: $")
 // Refer to the details of the JSON encoding format supported by this decoder
 // in the package documentation file (doc/baljsn.txt).
 //
+///Streaming Encoding
+///------------------
+// 'baljsn::Encoder' encodes a complete object in a single call, so the whole
+// object (e.g., a large array of results) must be in memory before encoding
+// starts.  This component also provides 'baljsn::StreamingEncoder', which
+// produces a top-level JSON array one element at a time: the client calls
+// 'openArray', then 'encodeElement' once per element as each becomes
+// available, and finally 'closeArray'.  The text produced is identical to the
+// text 'baljsn::Encoder' produces for an array holding the same elements
+// encoded with the same options.
+//
+// A 'baljsn::StreamingEncoder' accumulates encoded text in an internal buffer
+// and, once at least 'flushThreshold' bytes are pending after an element is
+// encoded, writes the pending text to the destination 'bsl::streambuf' and
+// calls 'pubsync' on it.  Memory use is therefore bounded by the flush
+// threshold plus the size of the largest single element, and a destination
+// that transmits on 'sync' (e.g., a socket stream buffer, or a
+// 'btlb::BlobStreamBuf' whose blob is handed off to a channel) can send data
+// while the remaining elements are still being produced.  A flush threshold
+// of 0 flushes after every element.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -131,6 +153,58 @@ BSLS_IDENT("$Id: $")
 //
 //  assert(EXP_OUTPUT == os.str());
 //..
+//
+///Example 2: Streaming an Array of Objects
+///----------------------------------------
+// Suppose that the 'test::Employee' objects of Example 1 are produced one at
+// a time (e.g., as the rows of a database query) and that we want to send
+// them as a single JSON array without first collecting them all in memory.
+//
+// First, we create a 'baljsn::StreamingEncoder' that writes to the stream
+// buffer of our destination, flushing whenever at least 64 bytes of output
+// are pending:
+//..
+//  bsl::ostringstream arrayStream;
+//
+//  baljsn::EncoderOptions   arrayOptions;
+//  baljsn::StreamingEncoder streamingEncoder(arrayStream.rdbuf(),
+//                                            arrayOptions,
+//                                            64);
+//..
+// Then, we open the array:
+//..
+//  int status = streamingEncoder.openArray();
+//  assert(!status);
+//..
+// Next, we encode each employee as it becomes available.  Once 64 or more
+// bytes are pending after an element, they are written to 'arrayStream':
+//..
+//  status = streamingEncoder.encodeElement(employee);
+//  assert(!status);
+//  assert(0 == streamingEncoder.numBufferedBytes());
+//
+//  employee.name() = "Jim";
+//  employee.age()  = 35;
+//
+//  status = streamingEncoder.encodeElement(employee);
+//  assert(!status);
+//  assert(2 == streamingEncoder.numElements());
+//..
+// Finally, we close the array, which flushes the remaining output, and verify
+// the text written to 'arrayStream':
+//..
+//  status = streamingEncoder.closeArray();
+//  assert(!status);
+//  assert(0 == streamingEncoder.numBufferedBytes());
+//
+//  const char EXP_ARRAY[] =
+//      "[{\"name\":\"Bob\",\"homeAddress\":{\"street\":\"Lexington Ave\","
+//      "\"city\":\"New York City\",\"state\":\"New York\"},\"age\":21},"
+//      "{\"name\":\"Jim\",\"homeAddress\":{\"street\":\"Lexington Ave\","
+//      "\"city\":\"New York City\",\"state\":\"New York\"},\"age\":35}]";
+//
+//  assert(EXP_ARRAY == arrayStream.str());
+//..
 
 #ifndef INCLUDED_BALSCM_VERSION
 #include <balscm_version.h>
@@ -184,6 +258,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlb_print.h>
 #endif
 
+#ifndef INCLUDED_BDLSB_MEMOUTSTREAMBUF
+#include <bdlsb_memoutstreambuf.h>
+#endif
+
 #ifndef INCLUDED_BSLS_ASSERT
 #include <bsls_assert.h>
 #endif
@@ -192,6 +270,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_types.h>
 #endif
 
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
 #ifndef INCLUDED_BSL_IOSTREAM
 #include <bsl_iostream.h>
 #endif
@@ -429,6 +511,7 @@ class Encoder_EncodeImpl {
     friend struct Encoder_DynamicTypeDispatcher;
     friend struct Encoder_ElementVisitor;
     friend class Encoder_SequenceVisitor;
+    friend class StreamingEncoder;
 
   private:
     // PRIVATE MANIPULATORS
@@ -503,6 +586,146 @@ class Encoder_EncodeImpl {
         // being used by this encoder.
 };
 
+                           // ======================
+                           // class StreamingEncoder
+                           // ======================
+
+class StreamingEncoder {
+    // This class provides a mechanism for encoding a top-level JSON array
+    // incrementally, one element at a time, onto a 'bsl::streambuf' supplied
+    // at construction.  Encoded text is accumulated in an internal buffer
+    // that is written to the destination, which is then synchronized, each
+    // time at least 'flushThreshold' bytes are pending after an element is
+    // encoded.  The text produced for a sequence of elements is identical to
+    // the text produced by 'Encoder::encode' for an array holding the same
+    // elements.  Once an operation fails, every subsequent operation (other
+    // than 'flush') fails.
+
+  public:
+    // PUBLIC TYPES
+    enum {
+        k_DEFAULT_FLUSH_THRESHOLD = 64 * 1024  // default flush threshold
+    };
+
+  private:
+    // PRIVATE TYPES
+    enum State {
+        e_INITIAL,  // 'openArray' has not been called
+        e_OPEN,     // the array is open
+        e_CLOSED,   // the array has been closed
+        e_FAILED    // an operation has failed
+    };
+
+    // DATA
+    Encoder                 d_encoder;          // supplies the log
+
+    bdlsb::MemOutStreamBuf  d_buffer;           // pending output
+
+    EncoderOptions          d_options;          // encoder options
+
+    Encoder_EncodeImpl      d_encodeImpl;       // encodes onto 'd_buffer'
+
+    bsl::streambuf         *d_streamBuf_p;      // destination (held, not
+                                                // owned)
+
+    bsl::size_t             d_flushThreshold;   // pending bytes triggering a
+                                                // flush
+
+    bsls::Types::Int64      d_numBytesFlushed;  // bytes written to
+                                                // 'd_streamBuf_p'
+
+    int                     d_numElements;      // elements encoded
+
+    State                   d_state;            // array state
+
+  private:
+    // PRIVATE MANIPULATORS
+    int flushIfNeeded();
+        // Flush the pending output if at least 'flushThreshold()' bytes are
+        // pending.  Return 0 on success, and a non-zero value otherwise.
+
+    // NOT IMPLEMENTED
+    StreamingEncoder(const StreamingEncoder&);
+    StreamingEncoder& operator=(const StreamingEncoder&);
+
+  public:
+    // CREATORS
+    StreamingEncoder(bsl::streambuf        *streamBuf,
+                     const EncoderOptions&  options,
+                     bsl::size_t            flushThreshold =
+                                                    k_DEFAULT_FLUSH_THRESHOLD,
+                     bslma::Allocator      *basicAllocator = 0);
+        // Create a streaming encoder that writes the JSON encoding of an array
+        // onto the specified 'streamBuf' using the specified 'options'.
+        // Optionally specify a 'flushThreshold' number of pending bytes after
+        // which the pending output is written to 'streamBuf'; if
+        // 'flushThreshold' is 0, the output is written after every element.
+        // If 'flushThreshold' is not specified, 'k_DEFAULT_FLUSH_THRESHOLD' is
+        // used.  Optionally specify a 'basicAllocator' used to supply memory.
+        // If 'basicAllocator' is 0, the currently installed default allocator
+        // is used.  The behavior is undefined unless 'streamBuf' remains valid
+        // for the lifetime of this object.
+
+    ~StreamingEncoder();
+        // Write any pending output to the stream buffer supplied at
+        // construction and destroy this object.  Note that the array is not
+        // closed if 'closeArray' has not been called.
+
+    // MANIPULATORS
+    int openArray();
+        // Begin the encoding of the array.  Return 0 on success, and a
+        // non-zero value otherwise.  The behavior is undefined unless this is
+        // the first call to 'openArray' on this object.  Note that no output
+        // is produced until the first element is encoded or the array is
+        // closed.
+
+    template <class TYPE>
+    int encodeElement(const TYPE& value);
+        // Encode the specified 'value', of (template parameter) 'TYPE', as the
+        // next element of the array, and flush the pending output if at least
+        // 'flushThreshold()' bytes are then pending.  Return 0 on success, and
+        // a non-zero value otherwise.  'TYPE' shall be a 'bdeat'-compatible
+        // type that may be an element of an array encoded by 'Encoder'.  The
+        // behavior is undefined unless 'openArray' has been called and
+        // 'closeArray' has not.
+
+    int closeArray();
+        // Complete the encoding of the array, and write all pending output to
+        // the stream buffer supplied at construction.  Return 0 on success,
+        // and a non-zero value otherwise.  The behavior is undefined unless
+        // 'openArray' has been called and 'closeArray' has not.
+
+    int flush();
+        // Write all pending output to the stream buffer supplied at
+        // construction and synchronize that stream buffer.  Return 0 on
+        // success, and a non-zero value if the stream buffer did not accept
+        // all of the output.
+
+    // ACCESSORS
+    bsl::size_t flushThreshold() const;
+        // Return the number of pending bytes after which the pending output
+        // is written to the stream buffer supplied at construction.
+
+    bsl::string loggedMessages() const;
+        // Return a string containing any error, warning, or trace messages
+        // that were logged by this encoder.
+
+    bsl::size_t numBufferedBytes() const;
+        // Return the number of bytes of encoded output that have not yet been
+        // written to the stream buffer supplied at construction.
+
+    bsls::Types::Int64 numBytesFlushed() const;
+        // Return the number of bytes of encoded output that have been written
+        // to the stream buffer supplied at construction.
+
+    int numElements() const;
+        // Return the number of elements successfully encoded by this object.
+
+    const EncoderOptions& options() const;
+        // Return a reference to the non-modifiable encoder options used by
+        // this object.
+};
+
                        // =============================
                        // struct Encoder_ElementVisitor
                        // =============================
@@ -1111,6 +1334,81 @@ int Encoder_DynamicTypeDispatcher::operator()(const TYPE&  value,
 {
     return d_encoder_p->encodeImp(value, d_mode, category);
 }
+
+                           // ----------------------
+                           // class StreamingEncoder
+                           // ----------------------
+
+// MANIPULATORS
+template <class TYPE>
+int StreamingEncoder::encodeElement(const TYPE& value)
+{
+    BSLS_ASSERT(e_INITIAL != d_state);
+    BSLS_ASSERT(e_CLOSED  != d_state);
+
+    if (e_OPEN != d_state) {
+        return -1;                                                    // RETURN
+    }
+
+    if (0 == d_numElements) {
+        d_encodeImpl.openDocument();
+        d_encodeImpl.d_formatter.openArray();
+        d_encodeImpl.d_formatter.setIsArrayElement(true);
+    }
+    else {
+        d_encodeImpl.d_formatter.closeElement();
+    }
+
+    const int rc = d_encodeImpl.encode(value, 0);
+    if (rc) {
+        d_encodeImpl.logStream() << "Unable to encode array element "
+                                 << d_numElements << '.' << bsl::endl;
+        d_state = e_FAILED;
+        return rc;                                                    // RETURN
+    }
+
+    ++d_numElements;
+
+    return flushIfNeeded();
+}
+
+// ACCESSORS
+inline
+bsl::size_t StreamingEncoder::flushThreshold() const
+{
+    return d_flushThreshold;
+}
+
+inline
+bsl::string StreamingEncoder::loggedMessages() const
+{
+    return d_encoder.loggedMessages();
+}
+
+inline
+bsl::size_t StreamingEncoder::numBufferedBytes() const
+{
+    return d_buffer.length();
+}
+
+inline
+bsls::Types::Int64 StreamingEncoder::numBytesFlushed() const
+{
+    return d_numBytesFlushed;
+}
+
+inline
+int StreamingEncoder::numElements() const
+{
+    return d_numElements;
+}
+
+inline
+const EncoderOptions& StreamingEncoder::options() const
+{
+    return d_options;
+}
+
 }  // close package namespace
 
 }  // close enterprise namespace
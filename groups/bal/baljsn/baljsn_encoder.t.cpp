@@ -18,6 +18,7 @@
 #include <bdlde_utf8util.h>
 
 #include <bdlsb_fixedmeminstreambuf.h>
+#include <bdlsb_fixedmemoutstreambuf.h>
 #include <bdlsb_memoutstreambuf.h>
 
 // These header are for testing only and the hierarchy level of 'baljsn' was
@@ -88,9 +89,23 @@ using bsl::endl;
 //
 // ACCESSORS
 // [13] bsl::string loggedMessages() const;
+//
+// StreamingEncoder
+// [14] StreamingEncoder(streamBuf, options, flushThreshold, allocator);
+// [14] ~StreamingEncoder();
+// [14] int openArray();
+// [14] int encodeElement(const TYPE& value);
+// [14] int closeArray();
+// [14] int flush();
+// [14] bsl::size_t flushThreshold() const;
+// [14] bsl::string loggedMessages() const;
+// [14] bsl::size_t numBufferedBytes() const;
+// [14] Int64 numBytesFlushed() const;
+// [14] int numElements() const;
+// [14] const EncoderOptions& options() const;
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [14] USAGE EXAMPLE
+// [15] USAGE EXAMPLE
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -30276,6 +30291,118 @@ void testNumber()
     }
 }
 
+                         // ===========================
+                         // class SyncCountingStreamBuf
+                         // ===========================
+
+class SyncCountingStreamBuf : public bsl::stringbuf {
+    // This class provides a string-based stream buffer that counts the calls
+    // to 'pubsync' and records the number of bytes it holds at the most
+    // recent such call.
+
+    // DATA
+    int         d_numSyncs;       // number of calls to 'sync'
+    bsl::size_t d_lengthAtSync;   // length of the buffer at the last 'sync'
+
+  protected:
+    // PROTECTED MANIPULATORS
+    virtual int sync()
+        // Record the synchronization and return 0.
+    {
+        ++d_numSyncs;
+        d_lengthAtSync = str().length();
+        return 0;
+    }
+
+  public:
+    // CREATORS
+    SyncCountingStreamBuf()
+    : d_numSyncs(0)
+    , d_lengthAtSync(0)
+    {
+    }
+
+    // ACCESSORS
+    int numSyncs() const
+        // Return the number of calls to 'sync'.
+    {
+        return d_numSyncs;
+    }
+
+    bsl::size_t lengthAtSync() const
+        // Return the number of bytes held at the last call to 'sync'.
+    {
+        return d_lengthAtSync;
+    }
+};
+
+template <class TYPE>
+void testStreamingEncoder(int                      line,
+                          const bsl::vector<TYPE>& elements,
+                          const Options&           options,
+                          bsl::size_t              flushThreshold)
+    // Encode the specified 'elements' one at a time using a
+    // 'baljsn::StreamingEncoder' configured with the specified 'options' and
+    // 'flushThreshold', and verify, reporting failures using the specified
+    // 'line', that the resulting text is that produced by 'baljsn::Encoder'
+    // for 'elements' and that output is flushed as specified.
+{
+    typedef baljsn::StreamingEncoder SObj;
+
+    const int NUM_ELEMENTS = static_cast<int>(elements.size());
+
+    bsl::ostringstream expected;
+    {
+        Obj encoder;
+        ASSERTV(line, 0 == encoder.encode(expected, elements, options));
+    }
+
+    bslma::TestAllocator  ta("streaming", false);
+    SyncCountingStreamBuf sb;
+    SObj                  mX(&sb, options, flushThreshold, &ta);
+    const SObj&           X = mX;
+
+    ASSERTV(line, flushThreshold == X.flushThreshold());
+    ASSERTV(line, 0 == X.numElements());
+    ASSERTV(line, 0 == X.numBufferedBytes());
+    ASSERTV(line, 0 == X.numBytesFlushed());
+
+    ASSERTV(line, 0 == mX.openArray());
+    ASSERTV(line, 0 == X.numBufferedBytes());
+
+    for (int i = 0; i < NUM_ELEMENTS; ++i) {
+        const int numSyncs = sb.numSyncs();
+
+        ASSERTV(line, i, 0 == mX.encodeElement(elements[i]));
+        ASSERTV(line, i, i + 1 == X.numElements());
+
+        // At most 'flushThreshold - 1' bytes remain pending, and everything
+        // else has been written to, and synchronized with, the destination.
+
+        ASSERTV(line, i, X.numBufferedBytes() < flushThreshold
+                      || 0 == X.numBufferedBytes());
+        ASSERTV(line, i, X.numBytesFlushed() ==
+                              static_cast<Int64>(sb.str().length()));
+        if (numSyncs != sb.numSyncs()) {
+            ASSERTV(line, i, 0 == X.numBufferedBytes());
+            ASSERTV(line, i, sb.str().length() == sb.lengthAtSync());
+        }
+        if (0 == flushThreshold) {
+            ASSERTV(line, i, numSyncs + 1 == sb.numSyncs());
+        }
+    }
+
+    ASSERTV(line, 0 == mX.closeArray());
+    ASSERTV(line, 0 == X.numBufferedBytes());
+    ASSERTV(line, sb.str().length() == sb.lengthAtSync());
+    ASSERTV(line, X.numBytesFlushed() ==
+                                      static_cast<Int64>(sb.str().length()));
+    ASSERTV(line, X.loggedMessages().empty());
+
+    ASSERTV(line, expected.str(), sb.str(), expected.str() == sb.str());
+}
+
+
 }  // close unnamed namespace
 
 // ============================================================================
@@ -30294,7 +30421,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
-      case 14: {
+      case 15: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -30403,6 +30530,247 @@ int main(int argc, char *argv[])
 
     ASSERT(EXP_OUTPUT == os.str());
 //..
+//
+///Example 2: Streaming an Array of Objects
+///----------------------------------------
+// Suppose that the 'test::Employee' objects of Example 1 are produced one at
+// a time (e.g., as the rows of a database query) and that we want to send
+// them as a single JSON array without first collecting them all in memory.
+//
+// First, we create a 'baljsn::StreamingEncoder' that writes to the stream
+// buffer of our destination, flushing whenever at least 64 bytes of output
+// are pending:
+//..
+    bsl::ostringstream arrayStream;
+
+    baljsn::EncoderOptions   arrayOptions;
+    baljsn::StreamingEncoder streamingEncoder(arrayStream.rdbuf(),
+                                              arrayOptions,
+                                              64);
+//..
+// Then, we open the array:
+//..
+    int status = streamingEncoder.openArray();
+    ASSERT(!status);
+//..
+// Next, we encode each employee as it becomes available.  Once 64 or more
+// bytes are pending after an element, they are written to 'arrayStream':
+//..
+    status = streamingEncoder.encodeElement(employee);
+    ASSERT(!status);
+    ASSERT(0 == streamingEncoder.numBufferedBytes());
+
+    employee.name() = "Jim";
+    employee.age()  = 35;
+
+    status = streamingEncoder.encodeElement(employee);
+    ASSERT(!status);
+    ASSERT(2 == streamingEncoder.numElements());
+//..
+// Finally, we close the array, which flushes the remaining output, and verify
+// the text written to 'arrayStream':
+//..
+    status = streamingEncoder.closeArray();
+    ASSERT(!status);
+    ASSERT(0 == streamingEncoder.numBufferedBytes());
+
+    const char EXP_ARRAY[] =
+        "[{\"name\":\"Bob\",\"homeAddress\":{\"street\":\"Lexington Ave\","
+        "\"city\":\"New York City\",\"state\":\"New York\"},\"age\":21},"
+        "{\"name\":\"Jim\",\"homeAddress\":{\"street\":\"Lexington Ave\","
+        "\"city\":\"New York City\",\"state\":\"New York\"},\"age\":35}]";
+
+    ASSERT(EXP_ARRAY == arrayStream.str());
+//..
+      } break;
+      case 14: {
+        // --------------------------------------------------------------------
+        // TESTING 'StreamingEncoder'
+        //
+        // Concerns:
+        //: 1 Encoding elements one at a time produces the same text as
+        //:   encoding an array holding those elements with 'Encoder', for
+        //:   every encoding style and formatting option, including an empty
+        //:   array with and without 'encodeEmptyArrays'.
+        //:
+        //: 2 Pending output is written to, and synchronized with, the
+        //:   destination once at least 'flushThreshold' bytes are pending
+        //:   after an element, and after every element if 'flushThreshold' is
+        //:   0.
+        //:
+        //: 3 'closeArray' writes all pending output.
+        //:
+        //: 4 A failure to encode an element, or to write to the destination,
+        //:   is reported, and every subsequent operation fails.
+        //:
+        //: 5 The destructor writes pending output to the destination.
+        //:
+        //: 6 Memory is supplied by the specified allocator.
+        //
+        // Plan:
+        //: 1 For a set of encoding options, element counts, and flush
+        //:   thresholds, encode arrays of simple, sequence, and array
+        //:   elements, checking the pending and flushed byte counts after
+        //:   each element, and compare the final text with that produced by
+        //:   'Encoder'.  (C-1..3, 6)
+        //:
+        //: 2 Encode a choice having no selection, and verify that the
+        //:   operation and every subsequent operation fails.  (C-4)
+        //:
+        //: 3 Encode onto a fixed-capacity stream buffer that is too small to
+        //:   hold the output, and verify that the failure is reported.  (C-4)
+        //:
+        //: 4 Destroy an encoder having pending output, and verify that the
+        //:   output is written.  (C-5)
+        //
+        // Testing:
+        //   StreamingEncoder(streamBuf, options, flushThreshold, allocator);
+        //   ~StreamingEncoder();
+        //   int openArray();
+        //   int encodeElement(const TYPE& value);
+        //   int closeArray();
+        //   int flush();
+        //   bsl::size_t flushThreshold() const;
+        //   bsl::string loggedMessages() const;
+        //   bsl::size_t numBufferedBytes() const;
+        //   Int64 numBytesFlushed() const;
+        //   int numElements() const;
+        //   const EncoderOptions& options() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING 'StreamingEncoder'"
+                          << "\n==========================" << endl;
+
+        typedef baljsn::StreamingEncoder SObj;
+
+        static const struct {
+            int   d_line;         // source line number
+            Style d_style;        // encoding style
+            int   d_indent;       // initial indent level
+            int   d_spl;          // spaces per level
+            bool  d_emptyArrays;  // if empty arrays should be encoded
+        } OPTIONS[] = {
+            { L_, Options::e_COMPACT, 0, 0, false },
+            { L_, Options::e_COMPACT, 0, 0, true  },
+            { L_, Options::e_PRETTY,  0, 0, false },
+            { L_, Options::e_PRETTY,  0, 2, true  },
+            { L_, Options::e_PRETTY,  1, 4, false },
+            { L_, Options::e_PRETTY,  2, 4, true  },
+        };
+        const int NUM_OPTIONS = sizeof OPTIONS / sizeof *OPTIONS;
+
+        static const bsl::size_t THRESHOLDS[] = { 0, 1, 40, 100000 };
+        const int NUM_THRESHOLDS = sizeof THRESHOLDS / sizeof *THRESHOLDS;
+
+        static const int COUNTS[] = { 0, 1, 2, 7 };
+        const int NUM_COUNTS = sizeof COUNTS / sizeof *COUNTS;
+
+        if (verbose) cout << "\nCompare with 'Encoder'." << endl;
+
+        for (int oi = 0; oi < NUM_OPTIONS; ++oi) {
+            const int LINE = OPTIONS[oi].d_line;
+
+            Options options;
+            options.setEncodingStyle(OPTIONS[oi].d_style);
+            options.setInitialIndentLevel(OPTIONS[oi].d_indent);
+            options.setSpacesPerLevel(OPTIONS[oi].d_spl);
+            options.setEncodeEmptyArrays(OPTIONS[oi].d_emptyArrays);
+
+            for (int ci = 0; ci < NUM_COUNTS; ++ci) {
+                const int COUNT = COUNTS[ci];
+
+                bsl::vector<int>                ints;
+                bsl::vector<test::Employee>     employees;
+                bsl::vector<bsl::vector<int> >  arrays;
+
+                for (int i = 0; i < COUNT; ++i) {
+                    ints.push_back(i * 1000 - 3);
+
+                    test::Employee employee;
+                    employee.name()                 = "Name";
+                    employee.homeAddress().street() = "Street";
+                    employee.homeAddress().city()   = "City";
+                    employee.homeAddress().state()  = "State";
+                    employee.age()                  = 20 + i;
+                    employees.push_back(employee);
+
+                    arrays.push_back(bsl::vector<int>(i + 1, i));
+                }
+
+                for (int ti = 0; ti < NUM_THRESHOLDS; ++ti) {
+                    const bsl::size_t THRESHOLD = THRESHOLDS[ti];
+
+                    if (veryVerbose) {
+                        T_ P_(LINE) P_(COUNT) P(THRESHOLD)
+                    }
+
+                    testStreamingEncoder(LINE, ints, options, THRESHOLD);
+                    testStreamingEncoder(LINE, employees, options, THRESHOLD);
+                    testStreamingEncoder(LINE, arrays, options, THRESHOLD);
+                }
+            }
+        }
+
+        if (verbose) cout << "\nEncoding failure." << endl;
+        {
+            bsl::ostringstream os;
+            SObj               mX(os.rdbuf(), Options(), 0);
+            const SObj&        X = mX;
+
+            ASSERT(0 == mX.openArray());
+            ASSERT(0 == mX.encodeElement(1));
+
+            balb::Choice1 undefined;
+            ASSERT(0 != mX.encodeElement(undefined));
+            ASSERT(1 == X.numElements());
+            ASSERT(!X.loggedMessages().empty());
+
+            ASSERT(0 != mX.encodeElement(2));
+            ASSERT(0 != mX.closeArray());
+            ASSERT(1 == X.numElements());
+        }
+
+        if (verbose) cout << "\nDestination failure." << endl;
+        {
+            char                        buffer[8];
+            bdlsb::FixedMemOutStreamBuf sb(buffer, sizeof buffer);
+            SObj                        mX(&sb, Options(), 0);
+            const SObj&                 X = mX;
+
+            ASSERT(0 == mX.openArray());
+            ASSERT(0 == mX.encodeElement(1234));
+            ASSERT(0 != mX.encodeElement(5678));
+            ASSERT(!X.loggedMessages().empty());
+            ASSERT(8 == X.numBytesFlushed());
+            ASSERT(0 != mX.encodeElement(9));
+            ASSERT(0 != mX.closeArray());
+        }
+
+        if (verbose) cout << "\nDestructor flushes." << endl;
+        {
+            bsl::ostringstream os;
+            {
+                SObj mX(os.rdbuf(), Options());
+
+                ASSERT(0 == mX.openArray());
+                ASSERT(0 == mX.encodeElement(1));
+                ASSERT(0 == mX.encodeElement(2));
+                ASSERT(4 == mX.numBufferedBytes());
+                ASSERT(os.str().empty());
+            }
+            ASSERT("[1,2" == os.str());
+        }
+
+        if (verbose) cout << "\nAccessors." << endl;
+        {
+            bsl::ostringstream os;
+            Options            options;
+            options.setEncodingStyle(Options::e_PRETTY);
+
+            const SObj X(os.rdbuf(), options);
+            ASSERT(SObj::k_DEFAULT_FLUSH_THRESHOLD == X.flushThreshold());
+            ASSERT(Options::e_PRETTY == X.options().encodingStyle());
+        }
       } break;
       case 13: {
         // --------------------------------------------------------------------
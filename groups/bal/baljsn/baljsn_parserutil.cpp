@@ -10,6 +10,7 @@ BSLS_IDENT_RCSID(baljsn_parserutil_cpp,"$Id$ $CSID$")
 #include <bdlde_charconvertutf32.h>
 
 #include <bdlb_chartype.h>
+#include <bdlb_numerictextutil.h>
 #include <bdlb_string.h>
 
 #include <bdldfp_decimalutil.h>
@@ -312,6 +313,21 @@ int ParserUtil::getValue(double *value, bslstl::StringRef data)
         return loadInfOrNan(value, data);                             // RETURN
     }
 
+    if (!bsl::isdigit(static_cast<unsigned char>(data[data.length() - 1]))) {
+        return -1;                                                    // RETURN
+    }
+
+    // Decimal notation, which is all that conforming JSON uses, is parsed
+    // without copying; any other text accepted by 'strtod' is left to it.
+
+    const int rc = bdlb::NumericTextUtil::parseDouble(
+                                           value,
+                                           data.data(),
+                                           static_cast<int>(data.length()));
+    if (0 <= rc) {
+        return 0 == rc ? 0 : -1;                                      // RETURN
+    }
+
     const int k_MAX_STRING_LENGTH = 63;
     char      buffer[k_MAX_STRING_LENGTH + 1];
 
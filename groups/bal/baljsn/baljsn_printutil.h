@@ -95,6 +95,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlb_float.h>
 #endif
 
+#ifndef INCLUDED_BDLB_NUMERICTEXTUTIL
+#include <bdlb_numerictextutil.h>
+#endif
+
 #ifndef INCLUDED_BDLDFP_DECIMAL
 #include <bdldfp_decimal.h>
 #endif
@@ -333,19 +337,11 @@ int PrintUtil::printFloatingPoint(bsl::ostream&                 stream,
         const int SIZE = 32;
         char      buffer[SIZE];
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#define snprintf _snprintf
-#endif
-
-        const int len = snprintf(buffer,
-                                 SIZE,
-                                 "%-1.*g",
-                                 maxStreamPrecision<TYPE>(options),
-                                 value);
-
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#undef snprintf
-#endif
+        const int len = bdlb::NumericTextUtil::formatGeneral(
+                                            buffer,
+                                            SIZE,
+                                            value,
+                                            maxStreamPrecision<TYPE>(options));
         stream.write(buffer, len);
       }
     }
@@ -366,7 +362,9 @@ int PrintUtil::printValue(bsl::ostream& stream,
                           short         value,
                           const EncoderOptions *)
 {
-    stream << value;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    stream.write(buffer, bdlb::NumericTextUtil::formatInt(buffer, value));
     return 0;
 }
 
@@ -375,7 +373,9 @@ int PrintUtil::printValue(bsl::ostream& stream,
                           int           value,
                           const EncoderOptions *)
 {
-    stream << value;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    stream.write(buffer, bdlb::NumericTextUtil::formatInt(buffer, value));
     return 0;
 }
 
@@ -384,7 +384,9 @@ int PrintUtil::printValue(bsl::ostream&      stream,
                           bsls::Types::Int64 value,
                           const EncoderOptions *)
 {
-    stream << value;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    stream.write(buffer, bdlb::NumericTextUtil::formatInt64(buffer, value));
     return 0;
 }
 
@@ -393,7 +395,9 @@ int PrintUtil::printValue(bsl::ostream& stream,
                           unsigned char value,
                           const EncoderOptions *)
 {
-    stream << static_cast<int>(value);
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    stream.write(buffer, bdlb::NumericTextUtil::formatUint(buffer, value));
     return 0;
 }
 
@@ -402,7 +406,9 @@ int PrintUtil::printValue(bsl::ostream&  stream,
                           unsigned short value,
                           const EncoderOptions *)
 {
-    stream << value;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    stream.write(buffer, bdlb::NumericTextUtil::formatUint(buffer, value));
     return 0;
 }
 
@@ -411,7 +417,9 @@ int PrintUtil::printValue(bsl::ostream& stream,
                           unsigned int  value,
                           const EncoderOptions *)
 {
-    stream << value;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    stream.write(buffer, bdlb::NumericTextUtil::formatUint(buffer, value));
     return 0;
 }
 
@@ -420,7 +428,9 @@ int PrintUtil::printValue(bsl::ostream&       stream,
                           bsls::Types::Uint64 value,
                           const EncoderOptions *)
 {
-    stream << value;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    stream.write(buffer, bdlb::NumericTextUtil::formatUint64(buffer, value));
     return 0;
 }
 
@@ -492,8 +502,9 @@ int PrintUtil::printValue(bsl::ostream& stream,
                           const EncoderOptions *)
 {
     signed char tmp(value);  // Note that 'char' is unsigned on IBM.
+    char        buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
 
-    stream << static_cast<int>(tmp);
+    stream.write(buffer, bdlb::NumericTextUtil::formatInt(buffer, tmp));
     return 0;
 }
 
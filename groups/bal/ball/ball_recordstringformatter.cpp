@@ -25,6 +25,7 @@ BSLS_IDENT_RCSID(ball_recordstringformatter_cpp,"$Id$ $CSID$")
 #include <ball_userfields.h>
 #include <ball_userfieldvalue.h>
 
+#include <bdlb_numerictextutil.h>
 #include <bdlb_print.h>
 
 #include <bdlma_bufferedsequentialallocator.h>
@@ -43,7 +44,6 @@ BSLS_IDENT_RCSID(ball_recordstringformatter_cpp,"$Id$ $CSID$")
 #include <bsl_climits.h>   // for 'INT_MAX'
 #include <bsl_cstring.h>   // for 'bsl::strcmp'
 #include <bsl_c_stdlib.h>
-#include <bsl_c_stdio.h>   // for 'snprintf'
 
 #include <bsl_iomanip.h>
 #include <bsl_ostream.h>
@@ -62,38 +62,19 @@ static void appendToString(bsl::string *result, int value)
     // Convert the specified 'value' into ASCII characters and append it to the
     // specified 'result.
 {
-    char buffer[16];
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#define snprintf _snprintf
-#endif
-
-    snprintf(buffer, sizeof buffer, "%d", value);
-
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#undef snprintf
-#endif
-
-    *result += buffer;
+    result->append(buffer, bdlb::NumericTextUtil::formatInt(buffer, value));
 }
 
 static void appendToString(bsl::string *result, bsls::Types::Uint64 value)
     // Convert the specified 'value' into ASCII characters and append it to the
     // specified 'result.
 {
-    char buffer[32];
-
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#define snprintf _snprintf
-#endif
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
 
-    snprintf(buffer, sizeof(buffer), "%llu", value);
-
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#undef snprintf
-#endif
-
-    *result += buffer;
+    result->append(buffer,
+                   bdlb::NumericTextUtil::formatUint64(buffer, value));
 }
 
 namespace ball {
@@ -231,10 +212,6 @@ void RecordStringFormatter::operator()(bsl::ostream& stream,
     bsl::string output(&stringAllocator);
     output.reserve(STRING_RESERVATION);
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#define snprintf _snprintf
-#endif
-
     while (iter != end) {
         switch (*iter) {
           case '%': {
@@ -402,10 +379,6 @@ void RecordStringFormatter::operator()(bsl::ostream& stream,
         }
     }
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#undef snprintf
-#endif
-
     stream.write(output.c_str(), output.size());
     stream.flush();
 }
@@ -0,0 +1,556 @@
+// balst_stacktracesamplingallocator.cpp                              -*-C++-*-
+#include <balst_stacktracesamplingallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(balst_stacktracesamplingallocator_cpp,"$Id$ $CSID$")
+
+#include <balst_stacktrace.h>
+#include <balst_stacktraceutil.h>
+
+#include <bslmt_lockguard.h>
+
+#include <bslma_deallocatorproctor.h>
+#include <bslma_mallocfreeallocator.h>
+
+#include <bsls_assert.h>
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+#include <bsls_stackaddressutil.h>
+#include <bsls_systemtime.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_fstream.h>
+#include <bsl_ios.h>
+#include <bsl_ostream.h>
+
+#include <new>           // placement 'new'
+
+namespace BloombergLP {
+namespace {
+
+typedef bsls::StackAddressUtil AddressUtil;
+
+enum {
+    k_IGNORE_FRAMES = AddressUtil::k_IGNORE_FRAMES + 1,
+        // Number of frames at the top of each stack trace obtained by
+        // 'allocate' that are of no interest to the user: the frame of
+        // 'AddressUtil::getStackAddresses' itself on some platforms (see
+        // 'bsls_stackaddressutil'), and the frame of 'allocate'.
+
+    k_DEFAULT_NUM_RECORDED_FRAMES = 16
+};
+
+int drawInterval(bsls::Types::Uint64 *seed, int samplingInterval)
+    // Return a pseudo-random number between 1 and '2 * samplingInterval - 1',
+    // using and updating the specified 'seed' of a linear congruential
+    // generator, for the specified 'samplingInterval'.
+{
+    *seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+    const unsigned int range = 2u * samplingInterval - 1u;
+
+    return 1 + static_cast<int>(static_cast<unsigned int>(*seed >> 33)
+                                                                     % range);
+}
+
+bsls::Types::Uint64 drawSeed(bsls::Types::Uint64 *state)
+    // Return a seed for the generator of sampling intervals of a thread,
+    // using and updating the specified 'state' of a "splitmix64" generator,
+    // so that the sequences of intervals drawn by different threads are
+    // uncorrelated.
+{
+    *state += 0x9E3779B97F4A7C15ULL;
+
+    bsls::Types::Uint64 seed = *state;
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBULL;
+    return seed ^ (seed >> 31);
+}
+
+template <class ITERATOR>
+struct IsGreaterCallSite {
+    // This 'struct' provides a functor ordering the call sites referred to by
+    // iterators of type 'ITERATOR' by decreasing number of bytes in use, then
+    // by decreasing number of bytes allocated.
+
+    bool operator()(const ITERATOR& lhs, const ITERATOR& rhs) const
+        // Return 'true' if the call site referred to by the specified 'lhs'
+        // is ordered before that referred to by the specified 'rhs', and
+        // 'false' otherwise.
+    {
+        if (lhs->second.d_numBytesInUse != rhs->second.d_numBytesInUse) {
+            return lhs->second.d_numBytesInUse > rhs->second.d_numBytesInUse;
+                                                                      // RETURN
+        }
+        return lhs->second.d_numBytes > rhs->second.d_numBytes;
+    }
+};
+
+}  // close unnamed namespace
+
+namespace balst {
+
+               // ----------------------------------------------
+               // struct StackTraceSamplingAllocator::ThreadState
+               // ----------------------------------------------
+
+// CREATORS
+StackTraceSamplingAllocator::ThreadState::ThreadState(
+                                         bsls::Types::Uint64 seed,
+                                         int                 samplingInterval)
+: d_countdown(0)
+, d_seed(seed)
+, d_numAllocations(0)
+{
+    d_countdown = drawInterval(&d_seed, samplingInterval);
+}
+
+                     // ---------------------------------
+                     // class StackTraceSamplingAllocator
+                     // ---------------------------------
+
+// PRIVATE CLASS METHODS
+bool StackTraceSamplingAllocator::addAllocations(const void *state,
+                                                 void       *total)
+{
+    *static_cast<bsls::Types::Int64 *>(total) +=
+              static_cast<const ThreadState *>(state)->d_numAllocations.load();
+    return true;
+}
+
+void StackTraceSamplingAllocator::releaseThreadState(void *state,
+                                                     void *allocator)
+{
+    ThreadState                 *threadState =
+                                          static_cast<ThreadState *>(state);
+    StackTraceSamplingAllocator *sampler =
+                         static_cast<StackTraceSamplingAllocator *>(allocator);
+
+    sampler->d_numRetiredAllocations.addRelaxed(
+                                         threadState->d_numAllocations.load());
+
+    threadState->~ThreadState();
+}
+
+// PRIVATE MANIPULATORS
+StackTraceSamplingAllocator::ThreadState *
+StackTraceSamplingAllocator::createThreadState()
+{
+    bsls::Types::Uint64 seed;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        seed = drawSeed(&d_seed);
+    }
+
+    ThreadState *state = new (d_threadStates.allocateCache())
+                                        ThreadState(seed, d_samplingInterval);
+
+    d_threadStates.registerCache(state);
+
+    return state;
+}
+
+inline
+StackTraceSamplingAllocator::ThreadState *
+StackTraceSamplingAllocator::localThreadState()
+{
+    ThreadState *state = static_cast<ThreadState *>(
+                                                 d_threadStates.localCache());
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == state)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        state = createThreadState();
+    }
+    return state;
+}
+
+void StackTraceSamplingAllocator::recordSample(Header       *header,
+                                               size_type     size,
+                                               void * const *frames,
+                                               int           numFrames)
+{
+    BSLS_ASSERT(header);
+    BSLS_ASSERT(0 <= numFrames);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    Frames key(frames, frames + numFrames, d_allocator_p);
+
+    CallSiteMap::iterator it = d_callSites.find(key);
+    if (d_callSites.end() == it) {
+        // Note that we avoid 'operator[]', which uses the default allocator
+        // to create a temporary object, as this allocator may be the default
+        // allocator.
+
+        const CallSite empty = { 0, 0, 0, 0 };
+
+        it = d_callSites.insert(CallSiteMap::value_type(key,
+                                                        empty,
+                                                        d_allocator_p)).first;
+    }
+
+    CallSite& callSite = it->second;
+
+    ++callSite.d_numSamplesInUse;
+    ++callSite.d_numSamples;
+    callSite.d_numBytesInUse += size;
+    callSite.d_numBytes      += size;
+
+    header->d_data.d_callSite_p = &callSite;
+    header->d_data.d_size       = size;
+}
+
+// CREATORS
+StackTraceSamplingAllocator::StackTraceSamplingAllocator(
+                                            int               samplingInterval,
+                                            bslma::Allocator *basicAllocator)
+: d_samplingInterval(samplingInterval)
+, d_maxRecordedFrames(k_DEFAULT_NUM_RECORDED_FRAMES + k_IGNORE_FRAMES)
+, d_numRetiredAllocations(0)
+, d_mutex()
+, d_callSites(basicAllocator ? basicAllocator
+                             : &bslma::MallocFreeAllocator::singleton())
+, d_startTime(bsls::SystemTime::nowMonotonicClock())
+, d_seed(0x2545F4914F6CDD1DULL)
+, d_allocator_p(basicAllocator ? basicAllocator
+                               : &bslma::MallocFreeAllocator::singleton())
+, d_threadStates(sizeof(ThreadState),
+                 &StackTraceSamplingAllocator::releaseThreadState,
+                 this,
+                 d_allocator_p)
+{
+    BSLS_ASSERT(1 <= samplingInterval);
+    BSLS_ASSERT(samplingInterval <= 1 << 30);
+}
+
+StackTraceSamplingAllocator::StackTraceSamplingAllocator(
+                                           int               samplingInterval,
+                                           int               numRecordedFrames,
+                                           bslma::Allocator *basicAllocator)
+: d_samplingInterval(samplingInterval)
+, d_maxRecordedFrames(numRecordedFrames + k_IGNORE_FRAMES)
+, d_numRetiredAllocations(0)
+, d_mutex()
+, d_callSites(basicAllocator ? basicAllocator
+                             : &bslma::MallocFreeAllocator::singleton())
+, d_startTime(bsls::SystemTime::nowMonotonicClock())
+, d_seed(0x2545F4914F6CDD1DULL)
+, d_allocator_p(basicAllocator ? basicAllocator
+                               : &bslma::MallocFreeAllocator::singleton())
+, d_threadStates(sizeof(ThreadState),
+                 &StackTraceSamplingAllocator::releaseThreadState,
+                 this,
+                 d_allocator_p)
+{
+    BSLS_ASSERT(1 <= samplingInterval);
+    BSLS_ASSERT(samplingInterval <= 1 << 30);
+    BSLS_ASSERT(1 <= numRecordedFrames);
+    BSLS_ASSERT(numRecordedFrames <= k_MAX_RECORDED_FRAMES);
+}
+
+StackTraceSamplingAllocator::~StackTraceSamplingAllocator()
+{
+    d_threadStates.releaseCaches();
+}
+
+// MANIPULATORS
+void *StackTraceSamplingAllocator::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return 0;                                                     // RETURN
+    }
+
+    ThreadState *state = localThreadState();
+
+    Header *header = static_cast<Header *>(
+                              d_allocator_p->allocate(sizeof(Header) + size));
+
+    // The state of a thread is updated by that thread only, so that no atomic
+    // read-modify-write operation is needed.
+
+    state->d_numAllocations.storeRelaxed(
+                                   state->d_numAllocations.loadRelaxed() + 1);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(0 < --state->d_countdown)) {
+        header->d_data.d_callSite_p = 0;
+
+        return header + 1;                                            // RETURN
+    }
+
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+    // The countdown has expired: sample this allocation, restarting the
+    // countdown first, so that sampling continues if recording this sample
+    // throws.  Note that the stack addresses must be obtained here (rather
+    // than in 'recordSample') for 'k_IGNORE_FRAMES' to be accurate.
+
+    state->d_countdown = drawInterval(&state->d_seed, d_samplingInterval);
+
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(header,
+                                                        d_allocator_p);
+
+    void      *frames[k_MAX_RECORDED_FRAMES + k_IGNORE_FRAMES];
+    const int  numFrames = AddressUtil::getStackAddresses(frames,
+                                                          d_maxRecordedFrames);
+
+    recordSample(header,
+                 size,
+                 frames + k_IGNORE_FRAMES,
+                 bsl::max(numFrames - static_cast<int>(k_IGNORE_FRAMES), 0));
+
+    proctor.release();
+
+    return header + 1;
+}
+
+void StackTraceSamplingAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return;                                                       // RETURN
+    }
+
+    Header   *header   = static_cast<Header *>(address) - 1;
+    CallSite *callSite = header->d_data.d_callSite_p;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(callSite)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        BSLS_ASSERT(0 < callSite->d_numSamplesInUse);
+
+        --callSite->d_numSamplesInUse;
+        callSite->d_numBytesInUse -= header->d_data.d_size;
+    }
+
+    d_allocator_p->deallocate(header);
+}
+
+void StackTraceSamplingAllocator::resetStatistics()
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    for (CallSiteMap::iterator it = d_callSites.begin();
+                                                    d_callSites.end() != it;) {
+        if (0 == it->second.d_numSamplesInUse) {
+            d_callSites.erase(it++);
+        }
+        else {
+            it->second.d_numSamples = 0;
+            it->second.d_numBytes   = 0;
+            ++it;
+        }
+    }
+
+    d_startTime = bsls::SystemTime::nowMonotonicClock();
+}
+
+// ACCESSORS
+void StackTraceSamplingAllocator::loadCallSites(
+                  bsl::vector<CallSiteStatistics>         *statistics,
+                  bsl::vector<bsl::vector<const void *> > *stackTraces) const
+{
+    BSLS_ASSERT(statistics);
+
+    typedef CallSiteMap::const_iterator Iterator;
+
+    statistics->clear();
+    if (stackTraces) {
+        stackTraces->clear();
+    }
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    bsl::vector<Iterator> callSites(d_allocator_p);
+    callSites.reserve(d_callSites.size());
+    for (Iterator it = d_callSites.begin(); d_callSites.end() != it; ++it) {
+        callSites.push_back(it);
+    }
+
+    bsl::sort(callSites.begin(),
+              callSites.end(),
+              IsGreaterCallSite<Iterator>());
+
+    const bsls::Types::Int64 interval = d_samplingInterval;
+
+    statistics->reserve(callSites.size());
+    for (bsl::size_t i = 0; i < callSites.size(); ++i) {
+        const CallSite&    callSite = callSites[i]->second;
+        CallSiteStatistics entry;
+
+        entry.d_numBlocksInUse     = callSite.d_numSamplesInUse * interval;
+        entry.d_numBytesInUse      = callSite.d_numBytesInUse   * interval;
+        entry.d_numBlocksAllocated = callSite.d_numSamples      * interval;
+        entry.d_numBytesAllocated  = callSite.d_numBytes        * interval;
+
+        statistics->push_back(entry);
+
+        if (stackTraces) {
+            stackTraces->push_back(callSites[i]->first);
+        }
+    }
+}
+
+bsls::Types::Int64 StackTraceSamplingAllocator::numAllocations() const
+{
+    bsls::Types::Int64 total = d_numRetiredAllocations.load();
+
+    d_threadStates.visitCaches(&StackTraceSamplingAllocator::addAllocations,
+                               &total);
+    return total;
+}
+
+int StackTraceSamplingAllocator::numCallSites() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return static_cast<int>(d_callSites.size());
+}
+
+void StackTraceSamplingAllocator::printReport(bsl::ostream& stream,
+                                              int           maxNumCallSites)
+                                                                         const
+{
+    BSLS_ASSERT(0 <= maxNumCallSites);
+
+    // Note that the call sites are loaded (under the mutex) before resolving
+    // their stack traces, which may allocate memory from the default
+    // allocator, which may be this allocator.
+
+    bsl::vector<CallSiteStatistics>         statistics(d_allocator_p);
+    bsl::vector<bsl::vector<const void *> > stackTraces(d_allocator_p);
+
+    loadCallSites(&statistics, &stackTraces);
+
+    const double seconds = statisticsInterval().totalSecondsAsDouble();
+    const int    numCallSites = static_cast<int>(statistics.size());
+
+    stream << "Allocation profile: " << numAllocations()
+           << " allocation(s), sampling interval " << d_samplingInterval
+           << ", " << numCallSites << " call site(s), "
+           << seconds << " second(s).\n";
+
+    StackTrace stackTrace(d_allocator_p);
+    for (int i = 0; i < numCallSites && i < maxNumCallSites; ++i) {
+        const CallSiteStatistics& entry = statistics[i];
+
+        stream << "------------------------------------------"
+               << "-------------------------------------\n"
+               << "Call site " << i + 1 << ": "
+               << entry.d_numBytesInUse << " byte(s) in "
+               << entry.d_numBlocksInUse << " block(s) in use, "
+               << entry.d_numBytesAllocated << " byte(s) in "
+               << entry.d_numBlocksAllocated << " block(s) allocated";
+        if (0 < seconds) {
+            stream << " ("
+                   << static_cast<bsls::Types::Int64>(
+                                        entry.d_numBytesAllocated / seconds)
+                   << " byte(s)/s)";
+        }
+        stream << ".\n";
+
+        const bsl::vector<const void *>& frames = stackTraces[i];
+
+        stackTrace.removeAll();
+
+        const int rc = frames.empty()
+                     ? -1
+                     : StackTraceUtil::loadStackTraceFromAddressArray(
+                                              &stackTrace,
+                                              frames.data(),
+                                              static_cast<int>(frames.size()));
+        if (rc || 0 == stackTrace.length()) {
+            stream << "... stack trace failed ...\n";
+        }
+        else {
+            StackTraceUtil::printFormatted(stream, stackTrace);
+        }
+    }
+}
+
+bsls::TimeInterval StackTraceSamplingAllocator::statisticsInterval() const
+{
+    bsls::TimeInterval startTime;
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        startTime = d_startTime;
+    }
+    return bsls::SystemTime::nowMonotonicClock() - startTime;
+}
+
+void StackTraceSamplingAllocator::writeHeapProfile(bsl::ostream& stream) const
+{
+    bsl::vector<CallSiteStatistics>         statistics(d_allocator_p);
+    bsl::vector<bsl::vector<const void *> > stackTraces(d_allocator_p);
+
+    loadCallSites(&statistics, &stackTraces);
+
+    CallSiteStatistics total = { 0, 0, 0, 0 };
+    for (bsl::size_t i = 0; i < statistics.size(); ++i) {
+        total.d_numBlocksInUse     += statistics[i].d_numBlocksInUse;
+        total.d_numBytesInUse      += statistics[i].d_numBytesInUse;
+        total.d_numBlocksAllocated += statistics[i].d_numBlocksAllocated;
+        total.d_numBytesAllocated  += statistics[i].d_numBytesAllocated;
+    }
+
+    // The statistics are already scaled by the sampling interval, which the
+    // "heapprofile" header tells 'pprof' not to do.
+
+    stream << "heap profile: "
+           << total.d_numBlocksInUse     << ": "
+           << total.d_numBytesInUse      << " ["
+           << total.d_numBlocksAllocated << ": "
+           << total.d_numBytesAllocated  << "] @ heapprofile\n";
+
+    for (bsl::size_t i = 0; i < statistics.size(); ++i) {
+        const CallSiteStatistics&        entry  = statistics[i];
+        const bsl::vector<const void *>& frames = stackTraces[i];
+
+        stream << entry.d_numBlocksInUse     << ": "
+               << entry.d_numBytesInUse      << " ["
+               << entry.d_numBlocksAllocated << ": "
+               << entry.d_numBytesAllocated  << "] @";
+
+        const bsl::ios_base::fmtflags flags = stream.flags();
+        stream << bsl::hex;
+        for (bsl::size_t j = 0; j < frames.size(); ++j) {
+            stream << " 0x"
+                   << reinterpret_cast<bsls::Types::UintPtr>(frames[j]);
+        }
+        stream.flags(flags);
+        stream << '\n';
+    }
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+    bsl::ifstream maps("/proc/self/maps");
+    if (maps.is_open()) {
+        stream << "\nMAPPED_LIBRARIES:\n" << maps.rdbuf();
+    }
+#endif
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
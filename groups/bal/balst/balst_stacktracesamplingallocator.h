@@ -0,0 +1,469 @@
+// balst_stacktracesamplingallocator.h                                -*-C++-*-
+#ifndef INCLUDED_BALST_STACKTRACESAMPLINGALLOCATOR
+#define INCLUDED_BALST_STACKTRACESAMPLINGALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator profiling a sample of its allocations.
+//
+//@CLASSES:
+//  balst::StackTraceSamplingAllocator: allocator attributing usage to callers
+//
+//@SEE_ALSO: balst_stacktracetestallocator, bdlma_countingallocator
+//
+//@DESCRIPTION: This component provides an allocator adapter,
+// 'balst::StackTraceSamplingAllocator', implementing the 'bslma::Allocator'
+// protocol, that records the call stack of (on average) one in every
+// 'samplingInterval()' allocations, and attributes the memory allocated (and
+// still in use) to the "call sites" (i.e., the distinct call stacks) so
+// recorded.  Unlike 'balst::StackTraceTestAllocator', which records the call
+// stack of every allocation and is intended for finding leaks in test
+// drivers, this allocator is intended for finding the allocation hot spots of
+// production processes: an allocation that is not sampled costs only the
+// update of two counters of the calling thread (found through thread-specific
+// storage) and the initialization of a block header, in addition to the
+// allocation from the underlying allocator, and does not update any memory
+// shared between threads.
+//..
+//    ,----------------------------------.
+//   ( balst::StackTraceSamplingAllocator )
+//    `----------------------------------'
+//                    |         ctor/dtor
+//                    |         resetStatistics
+//                    |         loadCallSites
+//                    |         numAllocations
+//                    |         numCallSites
+//                    |         printReport
+//                    |         samplingInterval
+//                    |         statisticsInterval
+//                    |         writeHeapProfile
+//                    V
+//            ,----------------.
+//           ( bslma::Allocator )
+//            `----------------'
+//                            allocate
+//                            deallocate
+//..
+//
+///Sampling and Estimation
+///-----------------------
+// Each thread counts down its own allocations, and the allocation bringing the
+// count of its thread to 0 is sampled: the return addresses of the call stack
+// of the allocation are recorded (stack pointers only, which are compact and
+// quick to obtain), the block is attributed to the call site having that call
+// stack, and the count is reset to a pseudo-random number between 1 and
+// '2 * samplingInterval() - 1', drawn from a generator of the thread, so that
+// one allocation in 'samplingInterval()' is sampled on average, without the
+// sampling being biased by periodic patterns of allocation.  When a sampled
+// block is deallocated, it is removed from the blocks in use of its call site.
+// Each sample is taken to represent 'samplingInterval()' allocations of the
+// same size from the same call site, so that the statistics of each call site
+// (see 'CallSiteStatistics') are *estimates* obtained by multiplying the
+// sampled counts by 'samplingInterval()'.  These estimates are accurate for
+// call sites performing many allocations, but not for call sites performing
+// few.  Specifying a 'samplingInterval' of 1 records every allocation, making
+// the statistics exact.
+//
+// The statistics of allocated (as opposed to in use) blocks are cumulative
+// since the construction of the allocator or the last call to
+// 'resetStatistics', the time elapsed since then being returned by
+// 'statisticsInterval', so that the allocation rate of each call site can be
+// computed.
+//
+// Note that the countdown and the number of allocations of each thread are
+// held in a cache of that thread (see 'bdlma_threadcacheregistry'), found
+// through a thread-specific storage key shared by all such caches, so that
+// creating an allocator does not consume a key.  A sampling allocator is
+// nevertheless intended to be long-lived (e.g., installed as the default
+// allocator for the lifetime of a process).
+//
+// Resolving the recorded addresses to function names (using
+// 'balst::StackTraceUtil') is expensive, but happens only when a report is
+// printed by 'printReport'.  'writeHeapProfile' writes the statistics in the
+// legacy text format of heap profiles read by 'pprof' (the format written by
+// the heap profiler of 'gperftools'), followed, on Linux, by the memory map of
+// the process, so that 'pprof' can resolve the addresses itself.
+//
+///Underlying Allocator
+///--------------------
+// Like 'balst::StackTraceTestAllocator', this allocator does *not* use the
+// currently installed default allocator unless it is explicitly supplied at
+// construction, but, by default, the 'bslma::MallocFreeAllocator' singleton,
+// so that it can itself be installed as the default allocator.  The
+// underlying allocator supplies the blocks allocated by clients, the records
+// of the call sites, and the caches of the threads.
+//
+///Thread Safety
+///-------------
+// 'balst::StackTraceSamplingAllocator' is *fully thread-safe*, meaning any
+// operation on the same object can be safely invoked from any thread,
+// provided the underlying allocator is itself thread-safe.  Sampled
+// allocations and deallocations, and the accessors reporting statistics,
+// serialize on a mutex; allocations that are not sampled, and deallocations
+// of blocks that were not sampled, do not.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding the Allocation Hot Spots of a Process
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a server process uses more memory than we expect, and we would
+// like to find out where that memory is allocated.
+//
+// First, we create a sampling allocator recording one allocation in 16, and
+// install it as the default allocator (in a real process, this would be done
+// at the beginning of 'main'):
+//..
+//  balst::StackTraceSamplingAllocator profiler(16);
+//  bslma::DefaultAllocatorGuard       guard(&profiler);
+//..
+// Then, the process does its work, here simulated by building a vector of
+// strings, using the default allocator:
+//..
+//  bsl::vector<bsl::string> records;
+//  for (int i = 0; i < 1000; ++i) {
+//      records.push_back(bsl::string(100, 'x'));
+//  }
+//..
+// Next, we observe the number of allocations counted and of call sites
+// found:
+//..
+//  assert(1000 <= profiler.numAllocations());
+//  assert(1    <= profiler.numCallSites());
+//..
+// Then, we load the statistics of the call sites, ordered by decreasing
+// number of bytes in use, and observe that the top call site accounts for (an
+// estimate of) most of the memory in use:
+//..
+//  bsl::vector<balst::StackTraceSamplingAllocator::CallSiteStatistics>
+//                                                                  statistics;
+//  profiler.loadCallSites(&statistics);
+//
+//  assert(!statistics.empty());
+//  assert(50000 < statistics[0].d_numBytesInUse);
+//..
+// Now, we print a report of the top 5 call sites (including their resolved
+// stack traces) to an output stream, here a string stream:
+//..
+//  bsl::ostringstream report;
+//  profiler.printReport(report, 5);
+//
+//  assert(bsl::string::npos != report.str().find("Call site 1:"));
+//..
+// Finally, we write a heap profile that can be analyzed by 'pprof' (e.g.,
+// 'pprof --text ./server heap.prof'), here, again, to a string stream:
+//..
+//  bsl::ostringstream profile;
+//  profiler.writeHeapProfile(profile);
+//
+//  assert(0 == profile.str().find("heap profile:"));
+//..
+
+#ifndef INCLUDED_BALSCM_VERSION
+#include <balscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_THREADCACHEREGISTRY
+#include <bdlma_threadcacheregistry.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_MUTEX
+#include <bslmt_mutex.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TIMEINTERVAL
+#include <bsls_timeinterval.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_IOSFWD
+#include <bsl_iosfwd.h>
+#endif
+
+#ifndef INCLUDED_BSL_MAP
+#include <bsl_map.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace balst {
+
+                     // =================================
+                     // class StackTraceSamplingAllocator
+                     // =================================
+
+class StackTraceSamplingAllocator : public bslma::Allocator {
+    // This class implements the 'bslma::Allocator' protocol to provide an
+    // allocator adapter that records the call stacks of a sample of its
+    // allocations, and estimates the memory allocated, and in use, from each
+    // call site.  See {Sampling and Estimation}.
+
+  public:
+    // PUBLIC TYPES
+    struct CallSiteStatistics {
+        // This 'struct' provides the estimated statistics of a call site.
+
+        bsls::Types::Int64 d_numBlocksInUse;      // blocks in use
+        bsls::Types::Int64 d_numBytesInUse;       // bytes in use
+        bsls::Types::Int64 d_numBlocksAllocated;  // blocks allocated
+        bsls::Types::Int64 d_numBytesAllocated;   // bytes allocated
+    };
+
+    enum {
+        k_MAX_RECORDED_FRAMES = 64  // maximum number of frames recorded for
+                                    // each sampled allocation
+    };
+
+  private:
+    // PRIVATE TYPES
+    struct CallSite {
+        // This 'struct' provides the sampled counts of a call site.
+
+        bsls::Types::Int64 d_numSamplesInUse;   // sampled blocks in use
+        bsls::Types::Int64 d_numBytesInUse;     // sampled bytes in use
+        bsls::Types::Int64 d_numSamples;        // sampled blocks allocated
+        bsls::Types::Int64 d_numBytes;          // sampled bytes allocated
+    };
+
+    typedef bsl::vector<const void *>  Frames;
+    typedef bsl::map<Frames, CallSite> CallSiteMap;
+
+    union Header {
+        // This 'union' provides the header of each block.
+
+        struct {
+            CallSite  *d_callSite_p;  // call site, or 0 if not sampled
+            size_type  d_size;        // requested size (if sampled)
+        } d_data;
+        bsls::AlignmentUtil::MaxAlignedType d_dummy;  // force alignment
+    };
+
+    struct ThreadState {
+        // This 'struct' provides the sampling state of a thread, held in the
+        // cache of that thread.
+
+        // DATA
+        int                 d_countdown;       // allocations until the next
+                                               // sample
+
+        bsls::Types::Uint64 d_seed;            // state of the generator of
+                                               // sampling intervals
+
+        bsls::AtomicInt64   d_numAllocations;  // allocations counted (written
+                                               // by the thread only)
+
+        // CREATORS
+        ThreadState(bsls::Types::Uint64 seed, int samplingInterval);
+            // Create a state having no allocations, using the specified
+            // 'seed' for its generator, and draw its countdown for the
+            // specified 'samplingInterval'.
+    };
+
+    // DATA
+    const int                   d_samplingInterval;  // average number of
+                                                     // allocations per sample
+
+    const int                   d_maxRecordedFrames; // frames to obtain for
+                                                     // each sample, including
+                                                     // ignored frames
+
+    bsls::AtomicInt64           d_numRetiredAllocations;
+                                                     // allocations counted by
+                                                     // exited threads
+
+    mutable bslmt::Mutex        d_mutex;             // serializes access to
+                                                     // the following members
+
+    CallSiteMap                 d_callSites;         // call sites, by stack
+                                                     // trace
+
+    bsls::TimeInterval          d_startTime;         // start of cumulative
+                                                     // statistics (monotonic)
+
+    bsls::Types::Uint64         d_seed;              // state of the generator
+                                                     // of the seeds of the
+                                                     // threads
+
+    bslma::Allocator           *d_allocator_p;       // underlying allocator
+                                                     // (held, not owned)
+
+    bdlma::ThreadCacheRegistry  d_threadStates;      // 'ThreadState' of each
+                                                     // thread
+
+    // PRIVATE CLASS METHODS
+    static bool addAllocations(const void *state, void *total);
+        // Add the number of allocations of the specified 'state' to the
+        // specified 'total' (a 'bsls::Types::Int64'), and return 'true'.
+
+    static void releaseThreadState(void *state, void *allocator);
+        // Add the number of allocations of the specified 'state' to the
+        // allocations of exited threads of the specified 'allocator', and
+        // destroy 'state'.  Note that this method is called on exit of each
+        // thread having a state.
+
+    // PRIVATE MANIPULATORS
+    ThreadState *createThreadState();
+        // Create and register the state of the calling thread, seeding its
+        // generator from the generator of this allocator, and return its
+        // address.
+
+    ThreadState *localThreadState();
+        // Return the address of the state of the calling thread, creating it
+        // if it does not exist.
+
+    void recordSample(Header       *header,
+                      size_type     size,
+                      void * const *frames,
+                      int           numFrames);
+        // Attribute the block having the specified 'header' and 'size' to the
+        // call site having the stack trace consisting of the specified
+        // 'numFrames' 'frames', creating the call site if it does not
+        // exist.
+
+  private:
+    // NOT IMPLEMENTED
+    StackTraceSamplingAllocator(const StackTraceSamplingAllocator&);
+    StackTraceSamplingAllocator& operator=(
+                                           const StackTraceSamplingAllocator&);
+
+  public:
+    // CREATORS
+    explicit
+    StackTraceSamplingAllocator(int               samplingInterval,
+                                bslma::Allocator *basicAllocator = 0);
+    StackTraceSamplingAllocator(int               samplingInterval,
+                                int               numRecordedFrames,
+                                bslma::Allocator *basicAllocator = 0);
+        // Create an allocator recording the call stack of (on average) one
+        // allocation in every specified 'samplingInterval' allocations.
+        // Optionally specify 'numRecordedFrames', the maximum number of frames
+        // of each recorded call stack.  If 'numRecordedFrames' is not
+        // specified, 16 frames are recorded.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator' is 0,
+        // the 'bslma::MallocFreeAllocator' singleton is used.  The behavior is
+        // undefined unless '1 <= samplingInterval <= 1 << 30' and
+        // '1 <= numRecordedFrames <= k_MAX_RECORDED_FRAMES'.
+
+    virtual ~StackTraceSamplingAllocator();
+        // Destroy this allocator.  The behavior is undefined unless all
+        // blocks allocated from this allocator have been deallocated.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return a newly allocated block of memory of (at least) the specified
+        // positive 'size' (in bytes), obtained from the underlying allocator,
+        // and record the call stack of the allocation if it is sampled.  If
+        // 'size' is 0, a null pointer is returned with no other effect.  See
+        // {Sampling and Estimation}.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' back to the
+        // underlying allocator, removing it from the blocks in use of its call
+        // site if it was sampled.  If 'address' is 0, this function has no
+        // effect.  The behavior is undefined unless 'address' was allocated
+        // using this allocator object and has not already been deallocated.
+
+    void resetStatistics();
+        // Reset the cumulative statistics of allocated blocks of all call
+        // sites, discard the call sites having no sampled block in use, and
+        // restart the interval returned by 'statisticsInterval'.  Note that
+        // the statistics of blocks in use are not affected.
+
+    // ACCESSORS
+    void loadCallSites(
+      bsl::vector<CallSiteStatistics>         *statistics,
+      bsl::vector<bsl::vector<const void *> > *stackTraces = 0) const;
+        // Load into the specified 'statistics' the estimated statistics of
+        // each call site, ordered by decreasing number of bytes in use, then
+        // by decreasing number of bytes allocated.  Optionally specify
+        // 'stackTraces', into which the return addresses of the call stack of
+        // each call site (innermost first) are loaded, in the same order.
+
+    bsls::Types::Int64 numAllocations() const;
+        // Return the number of allocations (of positive size) performed by
+        // this allocator since its construction.  Note that the allocations
+        // of a thread exiting concurrently with this call may not be
+        // counted.
+
+    int numCallSites() const;
+        // Return the number of call sites of this allocator.
+
+    void printReport(bsl::ostream& stream, int maxNumCallSites = 10) const;
+        // Write to the specified 'stream' a human-readable report of the
+        // estimated statistics and the resolved stack traces of the call
+        // sites of this allocator, in the order of 'loadCallSites', limited
+        // to the first of them up to the optionally specified
+        // 'maxNumCallSites'.  The behavior is undefined unless
+        // '0 <= maxNumCallSites'.
+
+    int samplingInterval() const;
+        // Return the average number of allocations of which one is sampled.
+
+    bsls::TimeInterval statisticsInterval() const;
+        // Return the time elapsed since the construction of this allocator or
+        // the last call to 'resetStatistics', whichever is the latest.
+
+    void writeHeapProfile(bsl::ostream& stream) const;
+        // Write to the specified 'stream' the estimated statistics of the call
+        // sites of this allocator in the legacy text format of heap profiles
+        // read by 'pprof', followed, on Linux, by the memory map of this
+        // process.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                     // ---------------------------------
+                     // class StackTraceSamplingAllocator
+                     // ---------------------------------
+
+// ACCESSORS
+inline
+int StackTraceSamplingAllocator::samplingInterval() const
+{
+    return d_samplingInterval;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
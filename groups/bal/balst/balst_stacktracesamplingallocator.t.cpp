@@ -0,0 +1,974 @@
+// balst_stacktracesamplingallocator.t.cpp                            -*-C++-*-
+#include <balst_stacktracesamplingallocator.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_testallocatorexception.h>
+
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_platform.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>     // 'atoi'
+#include <bsl_cstring.h>     // 'memset'
+#include <bsl_iostream.h>
+#include <bsl_sstream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a thread-safe allocator adapter recording the
+// call stacks of a sample of its allocations.  Using a sampling interval of 1,
+// which samples every allocation, we verify that the statistics of each call
+// site (allocations performed from distinct lines of this test driver) are
+// exact, and that they are maintained by deallocations and reset by
+// 'resetStatistics'; using larger intervals, we verify that the estimates are
+// close to the exact values.  We verify the format of the reports, and that
+// the allocator is exception-neutral and usable concurrently.  The resolution
+// of stack traces to symbols depends on the platform and build, and is not
+// verified.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] StackTraceSamplingAllocator(int interval, Allocator *ba = 0);
+// [ 2] StackTraceSamplingAllocator(int interval, int frames, Allocator *ba);
+// [ 2] ~StackTraceSamplingAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+// [ 3] void resetStatistics();
+//
+// ACCESSORS
+// [ 3] void loadCallSites(vector<Statistics> *, vector<...> *) const;
+// [ 2] bsls::Types::Int64 numAllocations() const;
+// [ 2] int numCallSites() const;
+// [ 4] void printReport(bsl::ostream& stream, int maxNumCallSites) const;
+// [ 2] int samplingInterval() const;
+// [ 2] bsls::TimeInterval statisticsInterval() const;
+// [ 4] void writeHeapProfile(bsl::ostream& stream) const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] CONCURRENCY
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef balst::StackTraceSamplingAllocator Obj;
+typedef Obj::CallSiteStatistics            Statistics;
+typedef bsls::Types::size_type             size_type;
+typedef bsls::Types::Int64                 Int64;
+
+const int MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+// ============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+bool isMaxAligned(const void *address)
+    // Return 'true' if the specified 'address' is maximally aligned, and
+    // 'false' otherwise.
+{
+    return 0 == reinterpret_cast<bsls::Types::UintPtr>(address) % MAX_ALIGN;
+}
+
+bool isStatistics(const Statistics& statistics,
+                  Int64             numBlocksInUse,
+                  Int64             numBytesInUse,
+                  Int64             numBlocksAllocated,
+                  Int64             numBytesAllocated)
+    // Return 'true' if the specified 'statistics' have the specified
+    // 'numBlocksInUse', 'numBytesInUse', 'numBlocksAllocated', and
+    // 'numBytesAllocated', and 'false' otherwise.
+{
+    return numBlocksInUse     == statistics.d_numBlocksInUse
+        && numBytesInUse      == statistics.d_numBytesInUse
+        && numBlocksAllocated == statistics.d_numBlocksAllocated
+        && numBytesAllocated  == statistics.d_numBytesAllocated;
+}
+
+int countLines(const bsl::string& text, const char *prefix)
+    // Return the number of lines of the specified 'text' starting with the
+    // specified 'prefix'.
+{
+    int               count = 0;
+    bsl::string       line;
+    bsl::stringstream stream(text);
+    while (bsl::getline(stream, line)) {
+        if (0 == line.find(prefix)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+                             // =================
+                             // struct StressArgs
+                             // =================
+
+struct StressArgs {
+    // This 'struct' holds the arguments of 'stressThread'.
+
+    Obj *d_allocator_p;  // allocator under test
+    int  d_index;        // index of this thread
+    int  d_numSlots;     // number of blocks held at once
+    int  d_numRounds;    // number of rounds
+    int  d_numErrors;    // number of corrupted blocks found
+};
+
+extern "C" void *stressThread(void *arg)
+    // In each round, allocate a block of varying size (scribbled with the
+    // index of this thread) for each of the slots of this thread, then verify
+    // and deallocate them.  The specified 'arg' must be the address of a
+    // 'StressArgs' object.
+{
+    StressArgs *args = static_cast<StressArgs *>(arg);
+    Obj        *mX   = args->d_allocator_p;
+
+    const int N = args->d_numSlots;
+
+    bsl::vector<char *> slots(N,
+                              static_cast<char *>(0),
+                              bslma::NewDeleteAllocator::allocator(0));
+
+    for (int round = 0; round < args->d_numRounds; ++round) {
+        for (int i = 0; i < N; ++i) {
+            const size_type SIZE = 1 + (i * 13 + round) % 200;
+
+            slots[i] = static_cast<char *>(mX->allocate(SIZE));
+            bsl::memset(slots[i], args->d_index, SIZE);
+        }
+        for (int i = 0; i < N; ++i) {
+            const size_type SIZE = 1 + (i * 13 + round) % 200;
+
+            if (!isMaxAligned(slots[i])
+             || args->d_index != slots[i][0]
+             || args->d_index != slots[i][SIZE - 1]) {
+                ++args->d_numErrors;
+            }
+            mX->deallocate(slots[i]);
+        }
+    }
+    return 0;
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int  test            = argc > 1 ? atoi(argv[1]) : 0;
+    const bool verbose         = argc > 2;
+    const bool veryVerbose     = argc > 3;
+    const bool veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator da("default", veryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding the Allocation Hot Spots of a Process
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a server process uses more memory than we expect, and we would
+// like to find out where that memory is allocated.
+//
+// First, we create a sampling allocator recording one allocation in 16, and
+// install it as the default allocator (in a real process, this would be done
+// at the beginning of 'main'):
+//..
+    balst::StackTraceSamplingAllocator profiler(16);
+    bslma::DefaultAllocatorGuard       guard(&profiler);
+//..
+// Then, the process does its work, here simulated by building a vector of
+// strings, using the default allocator:
+//..
+    bsl::vector<bsl::string> records;
+    for (int i = 0; i < 1000; ++i) {
+        records.push_back(bsl::string(100, 'x'));
+    }
+//..
+// Next, we observe the number of allocations counted and of call sites
+// found:
+//..
+    ASSERT(1000 <= profiler.numAllocations());
+    ASSERT(1    <= profiler.numCallSites());
+//..
+// Then, we load the statistics of the call sites, ordered by decreasing
+// number of bytes in use, and observe that the top call site accounts for (an
+// estimate of) most of the memory in use:
+//..
+    bsl::vector<balst::StackTraceSamplingAllocator::CallSiteStatistics>
+                                                                    statistics;
+    profiler.loadCallSites(&statistics);
+
+    ASSERT(!statistics.empty());
+    ASSERT(50000 < statistics[0].d_numBytesInUse);
+//..
+// Now, we print a report of the top 5 call sites (including their resolved
+// stack traces) to an output stream, here a string stream:
+//..
+    bsl::ostringstream report;
+    profiler.printReport(report, 5);
+
+    ASSERT(bsl::string::npos != report.str().find("Call site 1:"));
+//..
+// Finally, we write a heap profile that can be analyzed by 'pprof' (e.g.,
+// 'pprof --text ./server heap.prof'), here, again, to a string stream:
+//..
+    bsl::ostringstream profile;
+    profiler.writeHeapProfile(profile);
+
+    ASSERT(0 == profile.str().find("heap profile:"));
+//..
+
+        if (veryVerbose) {
+            cout << report.str();
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY
+        //
+        // Concerns:
+        //: 1 Blocks allocated concurrently by several threads do not overlap,
+        //:   and are not corrupted by the allocator while in use.
+        //:
+        //: 2 All allocations are counted, including those of threads that
+        //:   have exited, and the statistics of blocks in use are
+        //:   maintained, also under concurrent use.
+        //
+        // Plan:
+        //: 1 Run several threads that, in each round, allocate blocks of
+        //:   varying sizes, scribbling over each the index of the thread, and
+        //:   then verify and deallocate them.  (C-1)
+        //:
+        //: 2 Verify the number of allocations, and that no block remains in
+        //:   use, after all threads have completed.  (C-2)
+        //
+        // Testing:
+        //   CONCURRENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY" << endl
+                          << "===========" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+        bslma::TestAllocator sa("scratch", veryVeryVerbose);
+
+        enum { k_NUM_THREADS = 8, k_NUM_SLOTS = 100, k_NUM_ROUNDS = 100 };
+
+        const int INTERVALS[] = { 1, 3, 64 };
+
+        for (int ti = 0; ti < 3; ++ti) {
+            const int INTERVAL = INTERVALS[ti];
+
+            if (veryVerbose) { T_ P(INTERVAL) }
+
+            {
+                Obj mX(INTERVAL, &ta);  const Obj& X = mX;
+
+                StressArgs                args[k_NUM_THREADS];
+                bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    args[i].d_allocator_p = &mX;
+                    args[i].d_index       = i;
+                    args[i].d_numSlots    = k_NUM_SLOTS;
+                    args[i].d_numRounds   = k_NUM_ROUNDS;
+                    args[i].d_numErrors   = 0;
+
+                    ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                          stressThread,
+                                                          &args[i]));
+                }
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    bslmt::ThreadUtil::join(handles[i]);
+                    ASSERTV(INTERVAL, i, 0 == args[i].d_numErrors);
+                }
+
+                const Int64 NUM_ALLOCATIONS =
+                           static_cast<Int64>(k_NUM_THREADS)
+                                                 * k_NUM_SLOTS * k_NUM_ROUNDS;
+
+                ASSERTV(INTERVAL, NUM_ALLOCATIONS == X.numAllocations());
+
+                bsl::vector<Statistics> statistics(&sa);
+                X.loadCallSites(&statistics);
+
+                ASSERTV(INTERVAL, 1 <= statistics.size());
+
+                Int64 numSamples = 0;
+                for (bsl::size_t i = 0; i < statistics.size(); ++i) {
+                    ASSERTV(INTERVAL, i, 0 == statistics[i].d_numBlocksInUse);
+                    ASSERTV(INTERVAL, i, 0 == statistics[i].d_numBytesInUse);
+
+                    numSamples += statistics[i].d_numBlocksAllocated
+                                                                   / INTERVAL;
+                }
+
+                // Each sample is taken after 1 to '2 * INTERVAL - 1'
+                // allocations.
+
+                ASSERTV(INTERVAL, numSamples,
+                        NUM_ALLOCATIONS / (2 * INTERVAL - 1) <= numSamples);
+                ASSERTV(INTERVAL, numSamples, NUM_ALLOCATIONS >= numSamples);
+                if (1 == INTERVAL) {
+                    ASSERTV(numSamples, NUM_ALLOCATIONS == numSamples);
+                }
+            }
+            ASSERTV(INTERVAL, 0 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // REPORTS
+        //
+        // Concerns:
+        //: 1 'printReport' reports the number of allocations and of call
+        //:   sites, and, for the specified maximum number of call sites, their
+        //:   statistics and stack traces.
+        //:
+        //: 2 'writeHeapProfile' writes a header line with the totals of the
+        //:   statistics of all call sites, and one line for each call site,
+        //:   in the text format of heap profiles read by 'pprof', followed,
+        //:   on Linux, by the memory map of the process.
+        //
+        // Plan:
+        //: 1 Allocate blocks from three call sites, print reports limited to
+        //:   various numbers of call sites, and verify their contents.  (C-1)
+        //:
+        //: 2 Write a heap profile, and verify its lines.  (C-2)
+        //
+        // Testing:
+        //   void printReport(bsl::ostream& stream, int maxNumCallSites) const;
+        //   void writeHeapProfile(bsl::ostream& stream) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "REPORTS" << endl
+                          << "=======" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            bsl::vector<void *> blocks;
+            for (int i = 0; i < 3; ++i) {
+                blocks.push_back(mX.allocate(100));
+            }
+            for (int i = 0; i < 2; ++i) {
+                blocks.push_back(mX.allocate(10));
+            }
+            mX.deallocate(mX.allocate(1000));
+
+            ASSERT(3 == X.numCallSites());
+
+            if (verbose) cout << "\t'printReport'" << endl;
+
+            for (int max = 0; max <= 4; ++max) {
+                bsl::ostringstream report;
+                X.printReport(report, max);
+
+                if (veryVerbose) { cout << report.str(); }
+
+                const bsl::string& REPORT = report.str();
+
+                ASSERTV(max, 0 == REPORT.find("Allocation profile: 6 "
+                                              "allocation(s), sampling "
+                                              "interval 1, 3 call site(s)"));
+
+                ASSERTV(max, (max > 0) == (bsl::string::npos !=
+                                REPORT.find("Call site 1: 300 byte(s) in 3 "
+                                            "block(s) in use, 300 byte(s) in "
+                                            "3 block(s) allocated")));
+                ASSERTV(max, (max > 1) == (bsl::string::npos !=
+                                REPORT.find("Call site 2: 20 byte(s) in 2 "
+                                            "block(s) in use, 20 byte(s) in "
+                                            "2 block(s) allocated")));
+                ASSERTV(max, (max > 2) == (bsl::string::npos !=
+                                REPORT.find("Call site 3: 0 byte(s) in 0 "
+                                            "block(s) in use, 1000 byte(s) "
+                                            "in 1 block(s) allocated")));
+                ASSERTV(max, bsl::string::npos == REPORT.find("Call site 4"));
+            }
+
+            if (verbose) cout << "\t'writeHeapProfile'" << endl;
+            {
+                bsl::ostringstream profile;
+                X.writeHeapProfile(profile);
+
+                const bsl::string& PROFILE = profile.str();
+
+                if (veryVerbose) { cout << PROFILE.substr(0, 1000); }
+
+                ASSERT(0 == PROFILE.find(
+                     "heap profile: 5: 320 [6: 1320] @ heapprofile\n"
+                     "3: 300 [3: 300] @ 0x"));
+
+                ASSERT(bsl::string::npos != PROFILE.find(
+                                                    "\n2: 20 [2: 20] @ 0x"));
+                ASSERT(bsl::string::npos != PROFILE.find(
+                                                "\n0: 0 [1: 1000] @ 0x"));
+
+                ASSERT(1 == countLines(PROFILE, "heap profile:"));
+                ASSERT(1 == countLines(PROFILE, "3: "));
+                ASSERT(1 == countLines(PROFILE, "2: "));
+                ASSERT(1 == countLines(PROFILE, "0: "));
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+                ASSERT(1 == countLines(PROFILE, "MAPPED_LIBRARIES:"));
+#endif
+            }
+
+            for (bsl::size_t i = 0; i < blocks.size(); ++i) {
+                mX.deallocate(blocks[i]);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // ALLOCATE, DEALLOCATE, AND STATISTICS
+        //
+        // Concerns:
+        //: 1 'allocate' returns maximally-aligned blocks of at least the
+        //:   requested size, obtained from the underlying allocator, or 0 if
+        //:   the requested size is 0.
+        //:
+        //: 2 With a sampling interval of 1, every allocation is attributed to
+        //:   its call site, and the statistics of each call site are exact.
+        //:
+        //: 3 Deallocating a sampled block updates the statistics of blocks in
+        //:   use of its call site, but not those of allocated blocks.
+        //:
+        //: 4 'loadCallSites' orders call sites by decreasing bytes in use,
+        //:   then by decreasing bytes allocated, and optionally loads their
+        //:   stack traces, which have at most the specified number of frames.
+        //:
+        //: 5 'resetStatistics' resets the statistics of allocated blocks, and
+        //:   discards the call sites having no block in use.
+        //:
+        //: 6 With larger sampling intervals, the estimated statistics are
+        //:   close to the exact values.
+        //:
+        //: 7 'allocate' is exception-neutral.
+        //
+        // Plan:
+        //: 1 Allocate blocks from distinct lines of this test driver (i.e.,
+        //:   distinct call sites), and verify the statistics of the call sites
+        //:   after each step.  (C-1..5)
+        //:
+        //: 2 Allocate many blocks from a single call site with various
+        //:   sampling intervals, and verify the estimates.  (C-6)
+        //:
+        //: 3 Allocate blocks using a test allocator set to throw, and verify
+        //:   that no memory is leaked.  (C-7)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        //   void resetStatistics();
+        //   void loadCallSites(vector<Statistics> *, vector<...> *) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ALLOCATE, DEALLOCATE, AND STATISTICS" << endl
+                          << "====================================" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+        bslma::TestAllocator sa("scratch", veryVeryVerbose);
+
+        if (verbose) cout << "\tExact statistics." << endl;
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            ASSERT(0 == mX.allocate(0));
+            ASSERT(0 == X.numAllocations());
+            ASSERT(0 == X.numCallSites());
+
+            mX.deallocate(0);
+
+            void *a[10];
+            void *b[5];
+
+            for (int i = 0; i < 10; ++i) {
+                a[i] = mX.allocate(100);                        // call site A
+                ASSERTV(i, isMaxAligned(a[i]));
+                bsl::memset(a[i], 'a', 100);
+            }
+            for (int i = 0; i < 5; ++i) {
+                b[i] = mX.allocate(30);                         // call site B
+                ASSERTV(i, isMaxAligned(b[i]));
+                bsl::memset(b[i], 'b', 30);
+            }
+
+            ASSERT(15 == X.numAllocations());
+            ASSERT(2  == X.numCallSites());
+
+            bsl::vector<Statistics>                 statistics(&sa);
+            bsl::vector<bsl::vector<const void *> > stackTraces(&sa);
+
+            X.loadCallSites(&statistics, &stackTraces);
+
+            ASSERT(2 == statistics.size());
+            ASSERT(2 == stackTraces.size());
+            ASSERT(isStatistics(statistics[0], 10, 1000, 10, 1000));
+            ASSERT(isStatistics(statistics[1],  5,  150,  5,  150));
+
+            ASSERT(!stackTraces[0].empty());
+            ASSERT(!stackTraces[1].empty());
+            ASSERT(16 >= stackTraces[0].size());
+            ASSERT(stackTraces[0] != stackTraces[1]);
+
+            // Deallocating blocks updates the statistics of blocks in use
+            // only, and may change the order of the call sites.
+
+            for (int i = 0; i < 8; ++i) {
+                mX.deallocate(a[i]);
+            }
+
+            bsl::vector<bsl::vector<const void *> > stackTraces2(&sa);
+            X.loadCallSites(&statistics, &stackTraces2);
+
+            ASSERT(2 == statistics.size());
+            ASSERT(isStatistics(statistics[0], 2, 200, 10, 1000));
+            ASSERT(isStatistics(statistics[1], 5, 150,  5,  150));
+            ASSERT(stackTraces[0] == stackTraces2[0]);
+
+            for (int i = 0; i < 5; ++i) {
+                mX.deallocate(b[i]);
+            }
+
+            X.loadCallSites(&statistics);
+
+            ASSERT(isStatistics(statistics[0], 2, 200, 10, 1000));
+            ASSERT(isStatistics(statistics[1], 0,   0,  5,  150));
+
+            // Resetting the statistics discards call site B.
+
+            mX.resetStatistics();
+
+            ASSERT(1 == X.numCallSites());
+
+            X.loadCallSites(&statistics, &stackTraces2);
+
+            ASSERT(1 == statistics.size());
+            ASSERT(isStatistics(statistics[0], 2, 200, 0, 0));
+            ASSERT(stackTraces[0] == stackTraces2[0]);
+
+            // Statistics are again accumulated after the reset.
+
+            a[0] = mX.allocate(100);                            // call site C
+
+            X.loadCallSites(&statistics);
+
+            ASSERT(2 == statistics.size());
+            ASSERT(isStatistics(statistics[0], 2, 200, 0,   0));
+            ASSERT(isStatistics(statistics[1], 1, 100, 1, 100));
+
+            mX.deallocate(a[0]);
+            mX.deallocate(a[8]);
+            mX.deallocate(a[9]);
+
+            ASSERT(16 == X.numAllocations());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tRecorded frames." << endl;
+        {
+            const int FRAMES[] = { 1, 2, 5, Obj::k_MAX_RECORDED_FRAMES };
+
+            for (int ti = 0; ti < 4; ++ti) {
+                Obj mX(1, FRAMES[ti], &ta);  const Obj& X = mX;
+
+                mX.deallocate(mX.allocate(8));
+
+                bsl::vector<Statistics>                 statistics(&sa);
+                bsl::vector<bsl::vector<const void *> > stackTraces(&sa);
+
+                X.loadCallSites(&statistics, &stackTraces);
+
+                ASSERTV(ti, 1 == stackTraces.size());
+                ASSERTV(ti, stackTraces[0].size(),
+                        1 <= stackTraces[0].size());
+                ASSERTV(ti, stackTraces[0].size(),
+                        FRAMES[ti] >= static_cast<int>(stackTraces[0].size()));
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tEstimated statistics." << endl;
+        {
+            enum { k_NUM_BLOCKS = 100000, k_SIZE = 24 };
+
+            const int INTERVALS[] = { 1, 2, 10, 100 };
+
+            bslma::Allocator *na = bslma::NewDeleteAllocator::allocator(0);
+
+            bsl::vector<void *> blocks(k_NUM_BLOCKS,
+                                       static_cast<void *>(0),
+                                       na);
+
+            for (int ti = 0; ti < 4; ++ti) {
+                const int INTERVAL = INTERVALS[ti];
+
+                Obj mX(INTERVAL, &ta);  const Obj& X = mX;
+
+                for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                    blocks[i] = mX.allocate(k_SIZE);
+                }
+                for (int i = 0; i < k_NUM_BLOCKS; i += 2) {
+                    mX.deallocate(blocks[i]);
+                }
+
+                bsl::vector<Statistics> statistics(&sa);
+                X.loadCallSites(&statistics);
+
+                ASSERTV(INTERVAL, 1 == statistics.size());
+
+                const Statistics& S = statistics[0];
+
+                if (veryVerbose) {
+                    T_ P_(INTERVAL) P_(S.d_numBlocksAllocated)
+                                                       P(S.d_numBlocksInUse)
+                }
+
+                // Expect the estimates within 10% of the exact values.
+
+                ASSERTV(INTERVAL, S.d_numBlocksAllocated,
+                        k_NUM_BLOCKS * 9 / 10 <= S.d_numBlocksAllocated);
+                ASSERTV(INTERVAL, S.d_numBlocksAllocated,
+                        k_NUM_BLOCKS * 11 / 10 >= S.d_numBlocksAllocated);
+                ASSERTV(INTERVAL, S.d_numBlocksInUse,
+                        k_NUM_BLOCKS / 2 * 9 / 10 <= S.d_numBlocksInUse);
+                ASSERTV(INTERVAL, S.d_numBlocksInUse,
+                        k_NUM_BLOCKS / 2 * 11 / 10 >= S.d_numBlocksInUse);
+                ASSERTV(INTERVAL,
+                        S.d_numBlocksAllocated * k_SIZE
+                                                   == S.d_numBytesAllocated);
+
+                for (int i = 1; i < k_NUM_BLOCKS; i += 2) {
+                    mX.deallocate(blocks[i]);
+                }
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tException neutrality." << endl;
+        {
+            Obj mX(1, &ta);  const Obj& X = mX;
+
+            BSLMA_TESTALLOCATOR_EXCEPTION_TEST_BEGIN(ta) {
+                void *p = mX.allocate(50);
+                mX.deallocate(p);
+            } BSLMA_TESTALLOCATOR_EXCEPTION_TEST_END
+
+            ASSERT(1 == X.numCallSites());
+
+            bsl::vector<Statistics> statistics(&sa);
+            X.loadCallSites(&statistics);
+
+            ASSERT(1 == statistics.size());
+            ASSERT(0 == statistics[0].d_numBlocksInUse);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CONSTRUCTORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 The sampling interval is as specified.
+        //:
+        //: 2 A newly created allocator has counted no allocation, and has no
+        //:   call site.
+        //:
+        //: 3 The allocator specified at construction supplies all memory; the
+        //:   default allocator is never used.
+        //:
+        //: 4 'numAllocations' counts the allocations of positive size.
+        //:
+        //: 5 'statisticsInterval' returns the time elapsed since construction.
+        //
+        // Plan:
+        //: 1 Create allocators using each constructor, and verify the values
+        //:   of the accessors before and after allocating blocks.  (C-1..5)
+        //
+        // Testing:
+        //   StackTraceSamplingAllocator(int interval, Allocator *ba = 0);
+        //   StackTraceSamplingAllocator(int interval, int frames, Alloc *ba);
+        //   ~StackTraceSamplingAllocator();
+        //   bsls::Types::Int64 numAllocations() const;
+        //   int numCallSites() const;
+        //   int samplingInterval() const;
+        //   bsls::TimeInterval statisticsInterval() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONSTRUCTORS AND ACCESSORS" << endl
+                          << "==========================" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+
+        const int INTERVALS[] = { 1, 2, 1000, 1 << 30 };
+
+        for (int ti = 0; ti < 4; ++ti) {
+            const int INTERVAL = INTERVALS[ti];
+
+            for (int ctor = 0; ctor < 2; ++ctor) {
+                if (veryVerbose) { T_ P_(INTERVAL) P(ctor) }
+
+                {
+                    Obj  mA(INTERVAL, &ta);
+                    Obj  mB(INTERVAL, 4, &ta);
+                    Obj& mX = ctor ? mB : mA;  const Obj& X = mX;
+
+                    ASSERTV(INTERVAL, INTERVAL == X.samplingInterval());
+                    ASSERTV(INTERVAL, 0        == X.numAllocations());
+                    ASSERTV(INTERVAL, 0        == X.numCallSites());
+                    ASSERTV(INTERVAL, bsls::TimeInterval(0)
+                                                    <= X.statisticsInterval());
+
+                    const Int64 NUM_BLOCKS = ta.numBlocksInUse();
+
+                    void *p = mX.allocate(10);
+                    void *q = mX.allocate(0);
+
+                    ASSERTV(INTERVAL, 1 == X.numAllocations());
+                    ASSERTV(INTERVAL, 1 >= X.numCallSites());
+                    ASSERTV(INTERVAL, NUM_BLOCKS < ta.numBlocksInUse());
+                    ASSERTV(INTERVAL, 0 == q);
+
+                    mX.deallocate(p);
+                }
+                ASSERTV(INTERVAL, 0 == ta.numBlocksInUse());
+            }
+        }
+
+        if (verbose) cout << "\tDefault underlying allocator." << endl;
+        {
+            Obj mX(1);  const Obj& X = mX;
+
+            mX.deallocate(mX.allocate(100));
+
+            ASSERT(1 == X.numCallSites());
+        }
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks, and print a report.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+        {
+            Obj mX(2, &ta);  const Obj& X = mX;
+
+            ASSERT(2 == X.samplingInterval());
+
+            void *p1 = mX.allocate(1);
+            void *p2 = mX.allocate(100);
+            void *p3 = mX.allocate(100000);
+
+            ASSERT(p1);  ASSERT(p2);  ASSERT(p3);
+            ASSERT(p1 != p2);
+
+            ASSERT(3 == X.numAllocations());
+
+            mX.deallocate(p1);
+            mX.deallocate(p2);
+            mX.deallocate(p3);
+
+            if (veryVerbose) {
+                X.printReport(cout);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //   Measure the time taken by each pair of allocation and deallocation
+        //   of a small block using the new-delete allocator directly, and
+        //   through a sampling allocator with various sampling intervals.
+        //
+        //   Usage: <driver> -1 [numIterations]
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST" << endl
+                          << "================" << endl;
+
+        const int NUM_ITERATIONS = argc > 2 ? atoi(argv[2]) : 10000000;
+
+        bslma::Allocator *na = bslma::NewDeleteAllocator::allocator(0);
+
+        const int INTERVALS[] = { 0, 1, 16, 1024, 65536 };
+
+        printf("%10s %12s %10s\n", "interval", "ns/pair", "call sites");
+
+        for (int ti = 0; ti < 5; ++ti) {
+            const int INTERVAL = INTERVALS[ti];
+
+            Obj               mX(INTERVAL ? INTERVAL : 1, na);
+            bslma::Allocator *allocator = INTERVAL
+                                        ? static_cast<bslma::Allocator *>(&mX)
+                                        : na;
+
+            bsls::Stopwatch timer;
+            timer.start();
+            for (int i = 0; i < NUM_ITERATIONS; ++i) {
+                allocator->deallocate(allocator->allocate(32));
+            }
+            timer.stop();
+
+            if (INTERVAL) {
+                printf("%10d %12.2f %10d\n",
+                       INTERVAL,
+                       timer.elapsedTime() * 1e9 / NUM_ITERATIONS,
+                       mX.numCallSites());
+            }
+            else {
+                printf("%10s %12.2f %10s\n",
+                       "(none)",
+                       timer.elapsedTime() * 1e9 / NUM_ITERATIONS,
+                       "-");
+            }
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -292,6 +292,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlat_arrayfunctions.h>
 #endif
 
+#ifndef INCLUDED_BDLAT_ATTRIBUTENAMEINDEX
+#include <bdlat_attributenameindex.h>
+#endif
+
 #ifndef INCLUDED_BDLAT_CHOICEFUNCTIONS
 #include <bdlat_choicefunctions.h>
 #endif
@@ -2497,10 +2501,10 @@ int Decoder_SequenceContext<TYPE>::parseAttribute(const char  *name,
 
     Decoder_ParseAttribute visitor(decoder, name, value, lenValue);
 
-    if (0 != bdlat_SequenceFunctions::manipulateAttribute(d_object_p,
-                                                          visitor,
-                                                          name,
-                                                          lenName)) {
+    if (0 != bdlat_AttributeNameIndexUtil::manipulateAttribute(d_object_p,
+                                                               visitor,
+                                                               name,
+                                                               lenName)) {
         if (visitor.failed()) {
             return k_FAILURE;                                         // RETURN
         }
@@ -2519,9 +2523,9 @@ int Decoder_SequenceContext<TYPE>::parseSubElement(const char *elementName,
     const int lenName = static_cast<int>(bsl::strlen(elementName));
 
     if (decoder->options()->skipUnknownElements()
-     && false == bdlat_SequenceFunctions::hasAttribute(*d_object_p,
-                                                       elementName,
-                                                       lenName)) {
+     && false == bdlat_AttributeNameIndexUtil::hasAttribute(*d_object_p,
+                                                            elementName,
+                                                            lenName)) {
         decoder->setNumUnknownElementsSkipped(
                                      decoder->numUnknownElementsSkipped() + 1);
         Decoder_UnknownElementContext unknownElement;
@@ -2530,10 +2534,10 @@ int Decoder_SequenceContext<TYPE>::parseSubElement(const char *elementName,
 
     Decoder_ParseSequenceSubElement visitor(decoder, elementName, lenName);
 
-    return bdlat_SequenceFunctions::manipulateAttribute(d_object_p,
-                                                        visitor,
-                                                        elementName,
-                                                        lenName);
+    return bdlat_AttributeNameIndexUtil::manipulateAttribute(d_object_p,
+                                                             visitor,
+                                                             elementName,
+                                                             lenName);
 }
 
                      // ---------------------------------
@@ -3052,7 +3056,7 @@ int Decoder_ParseObject::executeImp(
 
     if (formattingMode & bdlat_FormattingMode::e_UNTAGGED) {
         if (d_decoder->options()->skipUnknownElements()
-         && false == bdlat_SequenceFunctions::hasAttribute(
+         && false == bdlat_AttributeNameIndexUtil::hasAttribute(
                                                 *object,
                                                 d_elementName_p,
                                                 static_cast<int>(d_lenName))) {
@@ -3062,7 +3066,7 @@ int Decoder_ParseObject::executeImp(
             return unknownElement.beginParse(d_decoder);              // RETURN
         }
 
-        return bdlat_SequenceFunctions::manipulateAttribute(
+        return bdlat_AttributeNameIndexUtil::manipulateAttribute(
                                                   object,
                                                   *this,
                                                   d_elementName_p,
@@ -14,12 +14,20 @@ BSLS_IDENT_RCSID(balxml_minireader_cpp,"$Id$ $CSID$")
 
 #include <balxml_errorinfo.h>
 
+#include <bdlb_bitutil.h>
+
 #include <bsls_assert.h>
+#include <bsls_platform.h>
 
 #include <bsl_algorithm.h>  // for swap
 #include <bsl_cctype.h>
 #include <bsl_climits.h>
 
+#if defined(BSLS_PLATFORM_CPU_X86_64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define BALXML_MINIREADER_USE_SSE2 1
+#endif
+
 // IMPLEMENTATION NOTES
 // --------------------
 
@@ -108,6 +116,181 @@ BSLS_IDENT_RCSID(balxml_minireader_cpp,"$Id$ $CSID$")
 
 namespace {
 
+                       // ==============================
+                       // Delimiter Scanning Definitions
+                       // ==============================
+
+// The delimiters are located, where SSE2 is available, by comparing 16
+// characters of the parse buffer at a time with vectors holding 16 copies of
+// each delimiter.  The vectors of the characters present in every set of
+// delimiters ('\0', '\n', '\r', '\t', and ' ') are constants, and the
+// vectors of the symbols supplied by the caller are built once per scan,
+// outside of the scanning loop.  Note that a null character is included in
+// each set of delimiters so that scanning stops at a null character in the
+// input, which is then treated as the end of the input.
+
+#ifdef BALXML_MINIREADER_USE_SSE2
+
+enum { k_BLOCK_SIZE = 16 };  // number of characters examined at a time
+
+union Block {
+    // This 'union' holds 16 copies of a character, compared with 16
+    // characters of the parse buffer at a time.
+
+    char    d_chars[k_BLOCK_SIZE];
+    __m128i d_vector;
+};
+
+#define BALXML_MINIREADER_BLOCK(c) \
+    {{ c, c, c, c, c, c, c, c, c, c, c, c, c, c, c, c }}
+
+const Block k_NULL_BLOCK    = BALXML_MINIREADER_BLOCK('\0');
+const Block k_NEWLINE_BLOCK = BALXML_MINIREADER_BLOCK('\n');
+const Block k_RETURN_BLOCK  = BALXML_MINIREADER_BLOCK('\r');
+const Block k_TAB_BLOCK     = BALXML_MINIREADER_BLOCK('\t');
+const Block k_SPACE_BLOCK   = BALXML_MINIREADER_BLOCK(' ');
+
+#undef BALXML_MINIREADER_BLOCK
+
+inline
+__m128i loadBlock(const char *block)
+    // Return the 16 characters at the specified 'block'.
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(block));
+}
+
+inline
+__m128i matchSpaces(__m128i data)
+    // Return a vector having each byte set where the corresponding character
+    // of the specified 'data' is ' ', '\t', or '\r'.
+{
+    return _mm_or_si128(
+                   _mm_or_si128(_mm_cmpeq_epi8(data, k_SPACE_BLOCK.d_vector),
+                                _mm_cmpeq_epi8(data, k_TAB_BLOCK.d_vector)),
+                   _mm_cmpeq_epi8(data, k_RETURN_BLOCK.d_vector));
+}
+
+inline
+__m128i matchEnds(__m128i data)
+    // Return a vector having each byte set where the corresponding character
+    // of the specified 'data' is '\n' or '\0'.
+{
+    return _mm_or_si128(_mm_cmpeq_epi8(data, k_NEWLINE_BLOCK.d_vector),
+                        _mm_cmpeq_epi8(data, k_NULL_BLOCK.d_vector));
+}
+
+inline
+const char *firstMatch(const char *block, int mask)
+    // Return the address of the character at the specified 'block' offset by
+    // the index of the lowest bit set in the specified non-zero 'mask'.
+{
+    using BloombergLP::bdlb::BitUtil;
+    return block + BitUtil::numTrailingUnsetBits(
+                                             static_cast<bsl::uint32_t>(mask));
+}
+
+#endif
+
+inline
+bool isSpace(char ch)
+    // Return 'true' if the specified 'ch' is ' ', '\t', or '\r', and 'false'
+    // otherwise.
+{
+    return ' ' == ch || '\t' == ch || '\r' == ch;
+}
+
+inline
+bool isEnd(char ch)
+    // Return 'true' if the specified 'ch' is '\n' or '\0', and 'false'
+    // otherwise.
+{
+    return '\n' == ch || '\0' == ch;
+}
+
+const char *skipSpaceChars(const char *begin, const char *end)
+    // Return the address of the first character in the specified range
+    // '[begin .. end)' that is not ' ', '\t', or '\r', or 'end' if there is
+    // no such character.
+{
+#ifdef BALXML_MINIREADER_USE_SSE2
+    for (; end - begin >= k_BLOCK_SIZE; begin += k_BLOCK_SIZE) {
+        const int mask = ~_mm_movemask_epi8(matchSpaces(loadBlock(begin)))
+                       & 0xFFFF;
+        if (mask) {
+            return firstMatch(begin, mask);                           // RETURN
+        }
+    }
+#endif
+
+    while (begin < end && isSpace(*begin)) {
+        ++begin;
+    }
+    return begin;
+}
+
+const char *findSymbolOrEnd(const char *begin, const char *end, char symbol)
+    // Return the address of the first character in the specified range
+    // '[begin .. end)' that is the specified 'symbol', '\n', or '\0', or
+    // 'end' if there is no such character.
+{
+#ifdef BALXML_MINIREADER_USE_SSE2
+    const __m128i symbolVector = _mm_set1_epi8(symbol);
+
+    for (; end - begin >= k_BLOCK_SIZE; begin += k_BLOCK_SIZE) {
+        const __m128i data = loadBlock(begin);
+        const int     mask = _mm_movemask_epi8(
+                          _mm_or_si128(_mm_cmpeq_epi8(data, symbolVector),
+                                       matchEnds(data)));
+        if (mask) {
+            return firstMatch(begin, mask);                           // RETURN
+        }
+    }
+#endif
+
+    while (begin < end && symbol != *begin && !isEnd(*begin)) {
+        ++begin;
+    }
+    return begin;
+}
+
+const char *findSymbolOrSpace(const char *begin,
+                              const char *end,
+                              char        symbol1,
+                              char        symbol2)
+    // Return the address of the first character in the specified range
+    // '[begin .. end)' that is the specified 'symbol1' or 'symbol2', a space,
+    // tab, carriage return, or newline, or '\0', or 'end' if there is no
+    // such character.
+{
+#ifdef BALXML_MINIREADER_USE_SSE2
+    const __m128i symbol1Vector = _mm_set1_epi8(symbol1);
+    const __m128i symbol2Vector = _mm_set1_epi8(symbol2);
+
+    for (; end - begin >= k_BLOCK_SIZE; begin += k_BLOCK_SIZE) {
+        const __m128i data    = loadBlock(begin);
+        const __m128i symbols = _mm_or_si128(
+                                        _mm_cmpeq_epi8(data, symbol1Vector),
+                                        _mm_cmpeq_epi8(data, symbol2Vector));
+        const int     mask    = _mm_movemask_epi8(
+                                 _mm_or_si128(symbols,
+                                              _mm_or_si128(matchSpaces(data),
+                                                           matchEnds(data))));
+        if (mask) {
+            return firstMatch(begin, mask);                           // RETURN
+        }
+    }
+#endif
+
+    while (begin < end
+        && symbol1 != *begin
+        && symbol2 != *begin
+        && !isSpace(*begin)
+        && !isEnd(*begin)) {
+        ++begin;
+    }
+    return begin;
+}
+
 inline
 const char* nonNullStr(const char *s)
     // Return the specified 's' if 's' != 0, or "" otherwise.  Never returns a
@@ -919,8 +1102,7 @@ MiniReader::skipSpaces()
     while (1) {
 
         // skip SPACE, TAB, CR chars
-        size_t len = bsl::strspn(d_scanPtr, "\r\t ");
-        d_scanPtr +=len;
+        d_scanPtr = const_cast<char *>(skipSpaceChars(d_scanPtr, d_endPtr));
 
         if (checkForNewLine()) {
             ++d_scanPtr;          //skip NL
@@ -941,12 +1123,10 @@ MiniReader::skipSpaces()
 int
 MiniReader::scanForSymbol(char symbol)
 {
-    char strSet [] = { symbol, '\n', '\0' };
-
     while (1) {
         // find 'symbol' or NL
-        size_t len = bsl::strcspn(d_scanPtr, strSet);
-        d_scanPtr +=len;
+        d_scanPtr = const_cast<char *>(
+                               findSymbolOrEnd(d_scanPtr, d_endPtr, symbol));
 
         if (symbol == *d_scanPtr) {
             return symbol;                                            // RETURN
@@ -972,12 +1152,10 @@ MiniReader::scanForSymbol(char symbol)
 int
 MiniReader::scanForSymbolOrSpace(char symbol)
 {
-    char strSet[] = { symbol, '\n', '\r', '\t', ' ', '\0' };
-
     while (1) {
         // find 'symbol' or space
-        size_t len = bsl::strcspn(d_scanPtr, strSet);
-        d_scanPtr +=len;
+        d_scanPtr = const_cast<char *>(
+                     findSymbolOrSpace(d_scanPtr, d_endPtr, symbol, symbol));
 
         if (d_scanPtr < d_endPtr) {
             break;
@@ -993,14 +1171,10 @@ MiniReader::scanForSymbolOrSpace(char symbol)
 int
 MiniReader::scanForSymbolOrSpace(char symbol1, char symbol2)
 {
-    char strSet [] = {
-        symbol1, symbol2,  '\n', '\r', '\t', ' ', '\0'
-    };
-
     while (1) {
         // find 'symbol1' or 'symbol2' or space
-        size_t len = bsl::strcspn(d_scanPtr, strSet);
-        d_scanPtr +=len;
+        d_scanPtr = const_cast<char *>(
+                   findSymbolOrSpace(d_scanPtr, d_endPtr, symbol1, symbol2));
 
         if (d_scanPtr < d_endPtr) {
             break;
@@ -1817,6 +1991,15 @@ MiniReader::readInput()
         chunkSize = k_MIN_BUFSIZE;
     }
 
+    if (d_memStream != 0
+     && (d_options & e_WHOLE_BUFFER_INPUT) != 0
+     && chunkSize < d_memSize) {
+        // Read all of the remaining input at once, so that the parse buffer
+        // is not refilled again.
+
+        chunkSize = d_memSize;
+    }
+
     if (d_parseBuf.size() < (numLeft + chunkSize + 1)) {
         d_parseBuf.resize(numLeft + chunkSize + 1);
     }
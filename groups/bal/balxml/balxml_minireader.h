@@ -31,6 +31,27 @@ BSLS_IDENT("$Id: $")
 // This provides a far more standard, easy to use and powerful API than the
 // existing SAX.
 //
+///Buffering and Scanning
+///----------------------
+// The reader parses its input in place: names and values are null-terminated
+// within an internal parse buffer, and the strings returned by the accessors
+// point into that buffer.  By default the parse buffer holds 8 KB of input,
+// and is refilled (after moving any partially parsed node to its start) each
+// time the scanner reaches its end.  A different size, between 1 KB and
+// 128 KB, may be supplied to the constructor.
+//
+// When the reader is opened on a memory buffer, the 'e_WHOLE_BUFFER_INPUT'
+// option (see 'setOptions') causes the entire input to be copied into the
+// parse buffer at once, which then grows to the size of the document.  The
+// document is then parsed without any refilling, moving, or adjustment of
+// internal pointers, at the cost of holding a second copy of the document.
+// Note that the copy itself cannot be avoided, because the reader modifies
+// its parse buffer.  The option has no effect on file and stream input.
+//
+// The scanner locates markup delimiters (e.g., '<', '>', '=', quotes, and
+// whitespace) by examining 16 bytes of the parse buffer at a time using SSE2
+// instructions where they are available, and one byte at a time otherwise.
+//
 ///Usage
 ///-----
 // For this example, we will use 'balxml::MiniReader' to read each node in an
@@ -324,6 +345,15 @@ class MiniReader :  public Reader {
     // This 'class' provides a concrete and efficient implementation of the
     // 'Reader' protocol.
 
+  public:
+    // PUBLIC TYPES
+    enum Option {
+        // Option flags, which may be combined and supplied to 'setOptions'.
+
+        e_WHOLE_BUFFER_INPUT = 0x0001  // copy all of a memory buffer into
+                                       // the parse buffer when opened
+    };
+
   private:
     // PRIVATE TYPES
     enum {
@@ -687,7 +717,8 @@ class MiniReader :  public Reader {
         // Set the options to the flags in the specified 'flags'.  The options
         // for the reader are persistent, i.e., the options are not reset by
         // 'close'.  The behavior is undefined if this method is called after
-        // calling 'open' and before calling 'close'.
+        // calling 'open' and before calling 'close'.  See 'Option' for the
+        // flags that are recognized; other flags are ignored.
 
     // ACCESSORS
     virtual const char *documentEncoding() const;
@@ -16,6 +16,7 @@
 #include <bslma_testallocator.h>
 #include <bslma_testallocatorexception.h>
 
+#include <bsls_stopwatch.h>
 #include <bsls_types.h>
 
 #include <bsl_cstring.h>     // strlen()
@@ -35,6 +36,13 @@ using namespace bsl;
 //                                 Overview
 //                                 --------
 // ----------------------------------------------------------------------------
+// [13] enum Option { e_WHOLE_BUFFER_INPUT };
+// [13] MiniReader(int bufSize, bslma::Allocator *basicAllocator = 0);
+// [13] void setOptions(unsigned int flags);
+// ----------------------------------------------------------------------------
+// [12] USAGE EXAMPLE
+// [13] TESTING BUFFERING AND SCANNING
+// [-2] BENCHMARK: PARSING THROUGHPUT
 
 // ============================================================================
 //                     STANDARD BDE ASSERT TEST FUNCTION
@@ -707,6 +715,59 @@ void readNodes(Obj& reader,
     readNodes(reader, currentNode + 1, numNodes, currentDepth, depth);
 }
 
+bsl::string makePaddedDocument(int padding)
+    // Return an XML document in which each delimiter that the reader scans
+    // for is preceded by a run of characters whose length depends on the
+    // specified 'padding', so that the delimiters fall at different offsets
+    // relative to the scanning blocks for different values of 'padding'.
+{
+    const bsl::string pad(padding, ' ');
+    const bsl::string tabs(padding, '\t');
+    const bsl::string name(padding + 1, 'N');
+    const bsl::string text(padding, 'y');
+
+    bsl::string doc("<?xml version='1.0' encoding='UTF-8'?>\n");
+    doc += "<Root" + pad + "\n" + tabs;
+    doc += " a='" + text + "\"" + text + "'" + pad;
+    doc += " b=\"" + text + "'" + text + "\"" + tabs + ">";
+    doc += text + "&amp;" + text + "\n";
+    doc += "<" + name + tabs + "/>" + pad;
+    doc += "<!--" + text + "-->";
+    doc += "<![CDATA[" + text + "]]>";
+    doc += "</Root" + pad + ">\n";
+    return doc;
+}
+
+int summarizeDocument(bsl::string *summary, Obj *reader)
+    // Advance the specified 'reader' through all of its remaining nodes, and
+    // load into the specified 'summary' a description of the type, name,
+    // value, attributes, and position of each node.  Return the status of
+    // the final call to 'advanceToNextNode'.
+{
+    bsl::ostringstream out;
+
+    int rc;
+    while (0 == (rc = reader->advanceToNextNode())) {
+        out << reader->nodeType()                << ' '
+            << CHK(reader->nodeName())           << ' '
+            << CHK(reader->nodeValue())          << ' '
+            << reader->getLineNumber()           << ':'
+            << reader->getColumnNumber()         << ' '
+            << reader->nodeStartPosition()       << '\n';
+
+        const int numAttr = reader->numAttributes();
+        for (int i = 0; i < numAttr; ++i) {
+            balxml::ElementAttribute attr;
+            reader->lookupAttribute(&attr, i);
+            out << "  " << CHK(attr.qualifiedName())
+                << '=' << CHK(attr.value()) << '\n';
+        }
+    }
+
+    *summary = out.str();
+    return rc;
+}
+
 void readHeader(Obj& reader)
 {
     int rc = advancePastWhiteSpace(reader);
@@ -747,6 +808,190 @@ int main(int argc, char *argv[])
     switch (test)
     {
       case 0:  // Zero is always the leading case.
+      case 13: {
+        // --------------------------------------------------------------------
+        // TESTING BUFFERING AND SCANNING
+        //
+        // Concerns:
+        //: 1 Delimiters are found regardless of their offset within the
+        //:   parse buffer, including within the final partial block of the
+        //:   input.
+        //:
+        //: 2 A null character in the input is treated as the end of the
+        //:   input.
+        //:
+        //: 3 The nodes, values, attributes, and positions reported are the
+        //:   same for every buffer size, whether or not the
+        //:   'e_WHOLE_BUFFER_INPUT' option is set, and whether the input is
+        //:   a memory buffer or a stream.
+        //:
+        //: 4 The 'e_WHOLE_BUFFER_INPUT' option has no effect on a reader
+        //:   opened on a stream.
+        //
+        // Plan:
+        //: 1 For each of a sequence of padding lengths, generate a document
+        //:   whose delimiters are preceded by runs of that length, parse it
+        //:   with a reader using the default buffer size and no options,
+        //:   and verify the values of selected nodes.  (C-1)
+        //:
+        //: 2 Truncate a document with an embedded null character, and verify
+        //:   that parsing stops at that character.  (C-2)
+        //:
+        //: 3 Parse each document from P-1 with readers having a range of
+        //:   buffer sizes and options, from both a memory buffer and a
+        //:   stream, and verify that a summary of the nodes reported is the
+        //:   same as that of the default reader.  (C-3..4)
+        //
+        // Testing:
+        //   enum Option { e_WHOLE_BUFFER_INPUT };
+        //   MiniReader(int bufSize, bslma::Allocator *basicAllocator = 0);
+        //   void setOptions(unsigned int flags);
+        // --------------------------------------------------------------------
+
+        if (verbose) bsl::cout << "\nTESTING BUFFERING AND SCANNING"
+                               << "\n==============================\n";
+
+        static const int BUFFER_SIZES[] = { 1024, 8 * 1024, 128 * 1024 };
+        const int        NUM_BUFFER_SIZES = sizeof  BUFFER_SIZES
+                                          / sizeof *BUFFER_SIZES;
+
+        static const int PADDINGS[] = {
+            0, 1, 2, 3, 7, 14, 15, 16, 17, 31, 32, 33, 40, 1000, 1500, 3000
+        };
+        const int NUM_PADDINGS = sizeof PADDINGS / sizeof *PADDINGS;
+
+        if (verbose) bsl::cout << "\tValues of selected nodes.\n";
+
+        for (int ti = 0; ti < NUM_PADDINGS; ++ti) {
+            const int         PADDING = PADDINGS[ti];
+            const bsl::string DOC     = makePaddedDocument(PADDING);
+            const bsl::string TEXT(PADDING, 'y');
+
+            Obj mX(&testAllocator);  Obj& reader = mX;
+
+            ASSERTV(PADDING, 0 == reader.open(DOC.data(), DOC.size()));
+
+            ASSERTV(PADDING, 0 == advancePastWhiteSpace(reader));
+            ASSERTV(PADDING, balxml::Reader::e_NODE_TYPE_XML_DECLARATION ==
+                                                            reader.nodeType());
+
+            ASSERTV(PADDING, 0 == advancePastWhiteSpace(reader));
+            ASSERTV(PADDING, balxml::Reader::e_NODE_TYPE_ELEMENT ==
+                                                            reader.nodeType());
+            ASSERTV(PADDING, !bsl::strcmp(reader.nodeName(), "Root"));
+            ASSERTV(PADDING, 2 == reader.numAttributes());
+
+            ElementAttribute attr;
+            ASSERTV(PADDING, 0 == reader.lookupAttribute(&attr, 0));
+            ASSERTV(PADDING, TEXT + '"' + TEXT == attr.value());
+            ASSERTV(PADDING, 0 == reader.lookupAttribute(&attr, 1));
+            ASSERTV(PADDING, TEXT + '\'' + TEXT == attr.value());
+
+            ASSERTV(PADDING, 0 == reader.advanceToNextNode());
+            ASSERTV(PADDING, balxml::Reader::e_NODE_TYPE_TEXT ==
+                                                            reader.nodeType());
+            ASSERTV(PADDING, TEXT + '&' + TEXT + '\n' == reader.nodeValue());
+
+            ASSERTV(PADDING, 0 == reader.advanceToNextNode());
+            ASSERTV(PADDING, balxml::Reader::e_NODE_TYPE_ELEMENT ==
+                                                            reader.nodeType());
+            ASSERTV(PADDING, bsl::string(PADDING + 1, 'N') ==
+                                                            reader.nodeName());
+            ASSERTV(PADDING, reader.isEmptyElement());
+
+            ASSERTV(PADDING, 0 == advancePastWhiteSpace(reader));
+            ASSERTV(PADDING, balxml::Reader::e_NODE_TYPE_COMMENT ==
+                                                            reader.nodeType());
+            ASSERTV(PADDING, TEXT == reader.nodeValue());
+
+            ASSERTV(PADDING, 0 == reader.advanceToNextNode());
+            ASSERTV(PADDING, balxml::Reader::e_NODE_TYPE_CDATA ==
+                                                            reader.nodeType());
+            ASSERTV(PADDING, TEXT == reader.nodeValue());
+
+            ASSERTV(PADDING, 0 == reader.advanceToNextNode());
+            ASSERTV(PADDING, balxml::Reader::e_NODE_TYPE_END_ELEMENT ==
+                                                            reader.nodeType());
+            ASSERTV(PADDING, !bsl::strcmp(reader.nodeName(), "Root"));
+
+            reader.close();
+        }
+
+        if (verbose) bsl::cout << "\tEmbedded null character.\n";
+        {
+            for (int padding = 0; padding < 40; ++padding) {
+                bsl::string doc("<Root a='");
+                doc.append(padding, 'x');
+                doc += '\0';
+                doc += "'/>";
+
+                Obj mX(&testAllocator);  Obj& reader = mX;
+
+                ASSERTV(padding, 0 == reader.open(doc.data(), doc.size()));
+                ASSERTV(padding, 0 != reader.advanceToNextNode());
+                reader.close();
+            }
+        }
+
+        if (verbose) bsl::cout << "\tBuffer sizes and options.\n";
+
+        for (int ti = 0; ti < NUM_PADDINGS; ++ti) {
+            const int         PADDING = PADDINGS[ti];
+            const bsl::string DOC     = makePaddedDocument(PADDING);
+
+            bsl::string expected;
+            {
+                Obj mX(&testAllocator);
+
+                ASSERTV(PADDING, 0 == mX.open(DOC.data(), DOC.size()));
+                ASSERTV(PADDING, 1 == summarizeDocument(&expected, &mX));
+                mX.close();
+            }
+
+            if (veryVerbose) { P_(PADDING) P(expected) }
+
+            for (int tj = 0; tj < NUM_BUFFER_SIZES; ++tj) {
+                const int BUFFER_SIZE = BUFFER_SIZES[tj];
+
+                for (int options = 0; options < 2; ++options) {
+                    const unsigned int FLAGS = options
+                                             ? Obj::e_WHOLE_BUFFER_INPUT
+                                             : 0;
+
+                    bsl::string summary;
+                    {
+                        Obj mX(BUFFER_SIZE, &testAllocator);
+
+                        mX.setOptions(FLAGS);
+                        ASSERTV(FLAGS == mX.options());
+
+                        ASSERTV(PADDING, BUFFER_SIZE, FLAGS,
+                                0 == mX.open(DOC.data(), DOC.size()));
+                        ASSERTV(PADDING, BUFFER_SIZE, FLAGS,
+                                1 == summarizeDocument(&summary, &mX));
+                        mX.close();
+                    }
+                    ASSERTV(PADDING, BUFFER_SIZE, FLAGS, summary,
+                            expected == summary);
+
+                    {
+                        bsl::istringstream stream(DOC);
+                        Obj                mX(BUFFER_SIZE, &testAllocator);
+
+                        mX.setOptions(FLAGS);
+
+                        ASSERTV(PADDING, BUFFER_SIZE, FLAGS,
+                                0 == mX.open(stream.rdbuf()));
+                        ASSERTV(PADDING, BUFFER_SIZE, FLAGS,
+                                1 == summarizeDocument(&summary, &mX));
+                        mX.close();
+                    }
+                    ASSERTV(PADDING, BUFFER_SIZE, FLAGS, summary,
+                            expected == summary);
+                }
+            }
+        }
+      } break;
       case 12: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
@@ -2353,6 +2598,116 @@ int main(int argc, char *argv[])
         reader.close();
 
       } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // BENCHMARK: PARSING THROUGHPUT
+        //
+        // Concerns:
+        //: 1 Report the rate at which a large document is parsed for a range
+        //:   of buffer sizes and options.
+        //
+        // Plan:
+        //: 1 Generate a document of several megabytes of elements having
+        //:   short attributes and text, and another having long attribute
+        //:   values, long text runs, and indentation, and time parsing each
+        //:   from a memory buffer with the default buffer size, the maximum
+        //:   buffer size, and the 'e_WHOLE_BUFFER_INPUT' option.
+        //
+        // Testing:
+        //   BENCHMARK: PARSING THROUGHPUT
+        // --------------------------------------------------------------------
+
+        if (verbose) bsl::cout << "\nBENCHMARK: PARSING THROUGHPUT"
+                               << "\n=============================\n";
+
+        const int NUM_RECORDS    = 100000;
+        const int NUM_ITERATIONS = 5;
+
+        const int NUM_LONG_RECORDS = 5000;
+
+        const bsl::string text(1000, 'x');
+        const bsl::string value(200, 'v');
+        const bsl::string indent(40, ' ');
+
+        bsl::string docs[2];
+
+        docs[0] = "<?xml version='1.0' encoding='UTF-8'?>\n<Records>\n";
+        for (int i = 0; i < NUM_RECORDS; ++i) {
+            bsl::ostringstream out;
+            out << "  <Record id='" << i << "' name=\"record number " << i
+                << "\" status='active'>\n"
+                << "    <Description>A record of moderate length, holding "
+                << "some descriptive text and a reference &amp; a value of "
+                << i * 7 << ".</Description>\n"
+                << "    <Address street='1 Main Street' city='Springfield'"
+                << " country='US'/>\n"
+                << "  </Record>\n";
+            docs[0] += out.str();
+        }
+        docs[0] += "</Records>\n";
+
+        docs[1] = "<?xml version='1.0' encoding='UTF-8'?>\n<Records>\n";
+        for (int i = 0; i < NUM_LONG_RECORDS; ++i) {
+            bsl::ostringstream out;
+            out << indent << "<Record id='" << i << "' note='" << value
+                << "'>\n"
+                << indent << indent << "<Description>" << text << ' ' << i
+                << ' ' << text << "</Description>\n"
+                << indent << "</Record>\n";
+            docs[1] += out.str();
+        }
+        docs[1] += "</Records>\n";
+
+        const char *DOC_LABELS[] = { "short tokens", "long text runs" };
+
+        struct {
+            const char   *d_label;
+            int           d_bufferSize;
+            unsigned int  d_options;
+        } CONFIGS[] = {
+            { "default buffer",   8 * 1024, 0                         },
+            { "maximum buffer", 128 * 1024, 0                         },
+            { "whole buffer",     8 * 1024, Obj::e_WHOLE_BUFFER_INPUT }
+        };
+        const int NUM_CONFIGS = sizeof CONFIGS / sizeof *CONFIGS;
+
+        for (int di = 0; di < 2; ++di) {
+            const bsl::string& doc = docs[di];
+
+            bsl::cout << "Document with " << DOC_LABELS[di] << ": "
+                      << doc.size() << " bytes" << bsl::endl;
+
+            for (int ti = 0; ti < NUM_CONFIGS; ++ti) {
+                bsls::Stopwatch timer;
+                int             numNodes = 0;
+
+                timer.start();
+                for (int i = 0; i < NUM_ITERATIONS; ++i) {
+                    Obj mX(CONFIGS[ti].d_bufferSize);
+
+                    mX.setOptions(CONFIGS[ti].d_options);
+                    ASSERT(0 == mX.open(doc.data(), doc.size()));
+
+                    while (0 == mX.advanceToNextNode()) {
+                        ++numNodes;
+                    }
+                    mX.close();
+                }
+                timer.stop();
+
+                const double seconds = timer.elapsedTime();
+                const double mbps    = seconds > 0
+                                     ? static_cast<double>(doc.size())
+                                       * NUM_ITERATIONS / seconds
+                                       / (1024 * 1024)
+                                     : 0;
+
+                bsl::cout << CONFIGS[ti].d_label << ": "
+                          << numNodes / NUM_ITERATIONS << " nodes, "
+                          << mbps << " MB/s" << bsl::endl;
+            }
+        }
+      } break;
       default: {
         bsl::cerr << "WARNING: CASE `" << test << "' NOT FOUND." << bsl::endl;
         testStatus = -1;
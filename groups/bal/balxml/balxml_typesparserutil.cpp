@@ -19,6 +19,8 @@ BSLS_IDENT_RCSID(balxml_typesparserutil_cpp,"$Id$ $CSID$")
 
 #include <bdlsb_fixedmeminstreambuf.h>
 
+#include <bdlb_numerictextutil.h>
+
 #include <bdldfp_decimalutil.h>
 
 #include <bsl_climits.h>
@@ -172,6 +174,26 @@ int parseDouble(double     *result,
         return BAEXML_FAILURE;                                        // RETURN
     }
 
+    // Decimal and exponential notation are parsed without copying, and with
+    // the same treatment of overflow (an error) and underflow (not an error)
+    // as below; any other text is left to 'parseDoubleImpl'.
+
+    double    value;
+    const int rc = bdlb::NumericTextUtil::parseDouble(&value,
+                                                      input,
+                                                      inputLength);
+    if (0 <= rc
+     && (!formatDecimal
+      || (!bsl::memchr(input, 'e', inputLength)
+       && !bsl::memchr(input, 'E', inputLength)))) {
+        if (0 != rc && (value < -1.0 || 1.0 < value)) {
+            return BAEXML_FAILURE;                                    // RETURN
+        }
+
+        *result = value;
+        return BAEXML_SUCCESS;                                        // RETURN
+    }
+
     if (inputLength < BUFLEN) {
         // Use a fixed-length buffer for efficiency.
         char  buffer[BUFLEN];
@@ -14,6 +14,7 @@ BSLS_IDENT_RCSID(balxml_typesprintutil_cpp,"$Id$ $CSID$")
 
 #include <bdldfp_decimalutil.h>
 
+#include <bdlb_numerictextutil.h>
 #include <bdlb_print.h>
 
 #include <bdlde_base64encoder.h>
@@ -929,25 +930,17 @@ bsl::ostream& TypesPrintUtil_Imp::printDefault(
       default: {
         // not a NaN and not +/- INFINITY
 
-        // On Sun, formatting a 'double' using 'ostream' is 60% slower than
-        // 'sprintf', even though the former calls the latter.  Also, note that
-        // 'snprintf' is 15% slower than 'sprintf' on Sun.
+        // Formatting using 'ostream' or 'sprintf' is several times slower
+        // than 'bdlb::NumericTextUtil', which produces the same text.
 
         char buffer[FLT_DIG + 20];  // buffer with headroom
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#pragma warning(push)
-#pragma warning(disable:4996)     // suppress 'sprintf' deprecation warning
-#endif
-
-        const int len = ::sprintf(buffer, "%.*g", FLT_DIG + 1,
-                                     (double) object);
+        const int len = bdlb::NumericTextUtil::formatGeneral(buffer,
+                                                             sizeof buffer,
+                                                             object,
+                                                             FLT_DIG + 1);
         BSLS_ASSERT(len < (int) sizeof buffer);
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#pragma warning(pop)
-#endif
-
         stream.write(buffer, len);
       } break;
     }
@@ -975,24 +968,17 @@ bsl::ostream& TypesPrintUtil_Imp::printDefault(
       default: {
         // not a NaN and not +/- INFINITY
 
-        // On Sun, formatting a 'double' using 'ostream' is 60% slower than
-        // 'sprintf', even though the former calls the latter.  Also, note that
-        // 'snprintf' is 15% slower than 'sprintf' on Sun.
+        // Formatting using 'ostream' or 'sprintf' is several times slower
+        // than 'bdlb::NumericTextUtil', which produces the same text.
 
         char buffer[DBL_DIG + 20];  // buffer with headroom
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#pragma warning(push)
-#pragma warning(disable:4996)     // suppress 'sprintf' deprecation warning
-#endif
-
-        const int len = ::sprintf(buffer, "%.*g", DBL_DIG + 1, object);
+        const int len = bdlb::NumericTextUtil::formatGeneral(buffer,
+                                                             sizeof buffer,
+                                                             object,
+                                                             DBL_DIG + 1);
         BSLS_ASSERT(len < (int) sizeof buffer);
 
-#if defined(BSLS_PLATFORM_CMP_MSVC)
-#pragma warning(pop)
-#endif
-
         stream.write(buffer, len);
       } break;
     }
@@ -264,6 +264,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlb_float.h>
 #endif
 
+#ifndef INCLUDED_BDLB_NUMERICTEXTUTIL
+#include <bdlb_numerictextutil.h>
+#endif
+
 #ifndef INCLUDED_BSL_IOMANIP
 #include <bsl_iomanip.h>
 #endif
@@ -1357,8 +1361,10 @@ bsl::ostream& TypesPrintUtil_Imp::printDecimal(
                                             bdlat_TypeCategory::Simple)
 {
     signed char temp(object);  // Note that 'char' is unsigned on IBM.
+    char        buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
 
-    return stream << int(temp);
+    return stream.write(buffer,
+                        bdlb::NumericTextUtil::formatInt(buffer, temp));
 }
 
 inline
@@ -1368,7 +1374,10 @@ bsl::ostream& TypesPrintUtil_Imp::printDecimal(
                                             const EncoderOptions       *,
                                             bdlat_TypeCategory::Simple)
 {
-    return stream << object;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    return stream.write(buffer,
+                        bdlb::NumericTextUtil::formatInt(buffer, object));
 }
 
 inline
@@ -1378,7 +1387,10 @@ bsl::ostream& TypesPrintUtil_Imp::printDecimal(
                                             const EncoderOptions       *,
                                             bdlat_TypeCategory::Simple)
 {
-    return stream << object;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    return stream.write(buffer,
+                        bdlb::NumericTextUtil::formatInt(buffer, object));
 }
 
 inline
@@ -1388,7 +1400,10 @@ bsl::ostream& TypesPrintUtil_Imp::printDecimal(
                                             const EncoderOptions       *,
                                             bdlat_TypeCategory::Simple)
 {
-    return stream << object;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    return stream.write(buffer,
+                        bdlb::NumericTextUtil::formatInt64(buffer, object));
 }
 
 inline
@@ -1398,7 +1413,10 @@ bsl::ostream& TypesPrintUtil_Imp::printDecimal(
                                             const EncoderOptions       *,
                                             bdlat_TypeCategory::Simple)
 {
-    return stream << object;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    return stream.write(buffer,
+                        bdlb::NumericTextUtil::formatInt64(buffer, object));
 }
 
 inline
@@ -1408,8 +1426,10 @@ bsl::ostream& TypesPrintUtil_Imp::printDecimal(
                                             const EncoderOptions       *,
                                             bdlat_TypeCategory::Simple)
 {
-    unsigned short us = object;
-    return stream << us;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    return stream.write(buffer,
+                        bdlb::NumericTextUtil::formatUint(buffer, object));
 }
 
 inline
@@ -1419,7 +1439,10 @@ bsl::ostream& TypesPrintUtil_Imp::printDecimal(
                                             const EncoderOptions       *,
                                             bdlat_TypeCategory::Simple)
 {
-    return stream << object;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    return stream.write(buffer,
+                        bdlb::NumericTextUtil::formatUint(buffer, object));
 }
 
 inline
@@ -1429,7 +1452,10 @@ bsl::ostream& TypesPrintUtil_Imp::printDecimal(
                                             const EncoderOptions       *,
                                             bdlat_TypeCategory::Simple)
 {
-    return stream << object;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    return stream.write(buffer,
+                        bdlb::NumericTextUtil::formatUint(buffer, object));
 }
 
 inline
@@ -1439,7 +1465,10 @@ bsl::ostream& TypesPrintUtil_Imp::printDecimal(
                                             const EncoderOptions       *,
                                             bdlat_TypeCategory::Simple)
 {
-    return stream << object;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    return stream.write(buffer,
+                        bdlb::NumericTextUtil::formatUint64(buffer, object));
 }
 
 inline
@@ -1449,7 +1478,10 @@ bsl::ostream& TypesPrintUtil_Imp::printDecimal(
                                             const EncoderOptions       *,
                                             bdlat_TypeCategory::Simple)
 {
-    return stream << object;
+    char buffer[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+
+    return stream.write(buffer,
+                        bdlb::NumericTextUtil::formatUint64(buffer, object));
 }
 
 // DEFAULT FUNCTIONS
@@ -0,0 +1,163 @@
+// bdlat_attributenameindex.cpp                                       -*-C++-*-
+#include <bdlat_attributenameindex.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlat_attributenameindex_cpp,"$Id$ $CSID$")
+
+#include <bsl_cstring.h>
+
+namespace BloombergLP {
+
+namespace {
+
+enum {
+    k_MIN_TABLE_SIZE = 8  // smallest non-empty table
+};
+
+}  // close unnamed namespace
+
+                       // ------------------------------
+                       // class bdlat_AttributeNameIndex
+                       // ------------------------------
+
+// PRIVATE MANIPULATORS
+void bdlat_AttributeNameIndex::rehash(bsl::size_t size)
+{
+    BSLS_ASSERT(0 == (size & (size - 1)));
+    BSLS_ASSERT(static_cast<bsl::size_t>(d_numAttributes) * 2 < size);
+
+    Entry unused = { 0, 0, -1, 0 };
+
+    bsl::vector<Entry> table(size, unused, d_table.get_allocator());
+    d_table.swap(table);
+
+    for (bsl::size_t i = 0; i < table.size(); ++i) {
+        const Entry& entry = table[i];
+
+        if (0 <= entry.d_nameLength) {
+            d_table[findSlot(entry.d_hash,
+                             d_names.data() + entry.d_nameOffset,
+                             entry.d_nameLength)] = entry;
+        }
+    }
+}
+
+// PRIVATE ACCESSORS
+bsl::size_t bdlat_AttributeNameIndex::findSlot(unsigned int  hash,
+                                               const char   *name,
+                                               int           nameLength) const
+{
+    BSLS_ASSERT_SAFE(!d_table.empty());
+
+    const bsl::size_t mask = d_table.size() - 1;
+
+    for (bsl::size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+        const Entry& entry = d_table[slot];
+
+        if (entry.d_nameLength < 0
+         || (hash == entry.d_hash
+          && nameLength == entry.d_nameLength
+          && 0 == bsl::memcmp(d_names.data() + entry.d_nameOffset,
+                              name,
+                              nameLength))) {
+            return slot;                                              // RETURN
+        }
+    }
+}
+
+// CREATORS
+bdlat_AttributeNameIndex::bdlat_AttributeNameIndex(
+                                              bslma::Allocator *basicAllocator)
+: d_table(basicAllocator)
+, d_names(basicAllocator)
+, d_numAttributes(0)
+{
+}
+
+// MANIPULATORS
+int bdlat_AttributeNameIndex::insert(int         attributeId,
+                                     const char *name,
+                                     int         nameLength)
+{
+    BSLS_ASSERT(0 <= nameLength);
+    BSLS_ASSERT(name || 0 == nameLength);
+
+    const bsl::size_t required = static_cast<bsl::size_t>(d_numAttributes + 1)
+                                                                          * 2;
+    if (d_table.size() < required) {
+        bsl::size_t size = d_table.empty()
+                         ? static_cast<bsl::size_t>(k_MIN_TABLE_SIZE)
+                         : d_table.size();
+        while (size < required) {
+            size *= 2;
+        }
+        rehash(size);
+    }
+
+    const unsigned int h    = hash(name, nameLength);
+    Entry&             slot = d_table[findSlot(h, name, nameLength)];
+
+    if (0 <= slot.d_nameLength) {
+        return -1;                                                    // RETURN
+    }
+
+    slot.d_hash       = h;
+    slot.d_nameOffset = static_cast<int>(d_names.size());
+    slot.d_nameLength = nameLength;
+    slot.d_id         = attributeId;
+
+    d_names.append(name, nameLength);
+    ++d_numAttributes;
+
+    return 0;
+}
+
+void bdlat_AttributeNameIndex::reset()
+{
+    d_table.clear();
+    d_names.clear();
+    d_numAttributes = 0;
+}
+
+// ACCESSORS
+int bdlat_AttributeNameIndex::find(int        *attributeId,
+                                   const char *name,
+                                   int         nameLength) const
+{
+    BSLS_ASSERT_SAFE(attributeId);
+    BSLS_ASSERT_SAFE(0 <= nameLength);
+    BSLS_ASSERT_SAFE(name || 0 == nameLength);
+
+    if (d_table.empty()) {
+        return -1;                                                    // RETURN
+    }
+
+    const Entry& entry = d_table[findSlot(hash(name, nameLength),
+                                          name,
+                                          nameLength)];
+
+    if (entry.d_nameLength < 0) {
+        return -1;                                                    // RETURN
+    }
+
+    *attributeId = entry.d_id;
+    return 0;
+}
+
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,585 @@
+// bdlat_attributenameindex.h                                         -*-C++-*-
+#ifndef INCLUDED_BDLAT_ATTRIBUTENAMEINDEX
+#define INCLUDED_BDLAT_ATTRIBUTENAMEINDEX
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a hashed index from attribute names to attribute ids.
+//
+//@CLASSES:
+//  bdlat_AttributeNameIndex: hash table mapping attribute names to ids
+//  bdlat_AttributeNameIndexUtil: name-based sequence functions using an index
+//
+//@SEE_ALSO: bdlat_sequencefunctions, bdlat_attributeinfo
+//
+//@DESCRIPTION: This component provides a class, 'bdlat_AttributeNameIndex',
+// that maps the name of each attribute of a "sequence" type to the id of that
+// attribute, and a utility 'struct', 'bdlat_AttributeNameIndexUtil', providing
+// drop-in replacements for the name-based functions of
+// 'bdlat_SequenceFunctions' that are intended for use by generic codecs.
+//
+// Decoders for text formats (such as XML and JSON) identify each attribute of
+// a sequence by name.  The name-based functions of 'bdlat_SequenceFunctions'
+// delegate to the 'lookupAttributeInfo' method of the type, which, depending
+// on the generator that produced the type, may compare the supplied name
+// against the name of every attribute in turn.  For types having many
+// attributes, that comparison can dominate the cost of decoding.  A
+// 'bdlat_AttributeNameIndex' is an open-addressed hash table, loaded once from
+// the attributes of a type, in which a name is found by computing a single
+// hash and (typically) comparing a single candidate name.
+//
+///Caching Indexes for Generated Types
+///-----------------------------------
+// The attributes of a type having the 'bdlat_TypeTraitBasicSequence' trait
+// (i.e., a generated type) do not depend on the value of an object of that
+// type, so one index can be shared by all objects of the type.
+// 'bdlat_AttributeNameIndexUtil::indexForType' creates that index, in a
+// thread-safe manner, the first time it is called for a type, and returns the
+// same index on every subsequent call.  Such indexes are allocated from the
+// global allocator and are never destroyed.
+//
+// The 'manipulateAttribute' and 'hasAttribute' functions of
+// 'bdlat_AttributeNameIndexUtil' use the cached index to translate a name to
+// an id, and then access the attribute by id, for types having the
+// 'bdlat_TypeTraitBasicSequence' trait.  A generated type may accept names
+// other than those of its attributes (for example, the names of the
+// selections of an anonymous choice, or names that differ only in case), so a
+// name that is not in the index is looked up using the corresponding
+// name-based function of 'bdlat_SequenceFunctions', preserving the behavior
+// of the type.  For all other "sequence" types, whose attributes may vary from
+// object to object, these functions always forward to
+// 'bdlat_SequenceFunctions'.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding Attribute Ids by Name
+/// - - - - - - - - - - - - - - - - - - - -
+// Suppose that we need to translate element names to attribute ids while
+// parsing a document.  First, we create an index and insert the attributes we
+// expect:
+//..
+//  bdlat_AttributeNameIndex index;
+//
+//  int rc = index.insert(1, "name", 4);
+//  assert(0 == rc);
+//
+//  rc = index.insert(2, "age", 3);
+//  assert(0 == rc);
+//  assert(2 == index.numAttributes());
+//..
+// Inserting a name a second time fails, leaving the index unchanged:
+//..
+//  rc = index.insert(3, "age", 3);
+//  assert(0 != rc);
+//  assert(2 == index.numAttributes());
+//..
+// Then, we look up names, which need not be null-terminated:
+//..
+//  const char *element = "age=42";
+//  int         id      = 0;
+//
+//  rc = index.find(&id, element, 3);
+//  assert(0 == rc);
+//  assert(2 == id);
+//
+//  rc = index.find(&id, "height", 6);
+//  assert(0 != rc);
+//..
+// Finally, note that a codec would typically not populate an index itself,
+// but would instead call 'bdlat_AttributeNameIndexUtil::manipulateAttribute'
+// wherever it would otherwise call the name-based
+// 'bdlat_SequenceFunctions::manipulateAttribute'.
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLAT_SEQUENCEFUNCTIONS
+#include <bdlat_sequencefunctions.h>
+#endif
+
+#ifndef INCLUDED_BDLAT_TYPETRAITS
+#include <bdlat_typetraits.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_TYPETRAITS
+#include <bslalg_typetraits.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_METAINT
+#include <bslmf_metaint.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_ONCE
+#include <bslmt_once.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+#ifndef INCLUDED_BSL_STRING
+#include <bsl_string.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+
+                   // ======================================
+                   // class bdlat_AttributeNameIndex_Loader
+                   // ======================================
+
+class bdlat_AttributeNameIndex;
+
+class bdlat_AttributeNameIndex_Loader {
+    // This component-private class provides an accessor that, for each
+    // attribute of a "sequence" that it visits, inserts the name and id of
+    // that attribute into an index.
+
+    // DATA
+    bdlat_AttributeNameIndex *d_index_p;  // index to load (held, not owned)
+
+  public:
+    // CREATORS
+    explicit bdlat_AttributeNameIndex_Loader(bdlat_AttributeNameIndex *index);
+        // Create an accessor that loads the specified 'index'.
+
+    // MANIPULATORS
+    template <class ATTRIBUTE, class INFO>
+    int operator()(const ATTRIBUTE&, const INFO& info);
+        // Insert into the index the name and id described by the specified
+        // 'info'.  Return the value returned by 'insert'.
+};
+
+                       // ==============================
+                       // class bdlat_AttributeNameIndex
+                       // ==============================
+
+class bdlat_AttributeNameIndex {
+    // This class provides a hash table mapping attribute names to attribute
+    // ids.  The names are copied into storage owned by the index.
+
+    // PRIVATE TYPES
+    struct Entry {
+        // An entry in the hash table.  An entry whose 'd_nameLength' is
+        // negative is unused.
+
+        unsigned int d_hash;        // hash of the name
+        int          d_nameOffset;  // offset of the name in 'd_names'
+        int          d_nameLength;  // length of the name, or -1 if unused
+        int          d_id;          // attribute id
+    };
+
+    // DATA
+    bsl::vector<Entry> d_table;          // open-addressed table, having a
+                                         // power-of-two size (or empty)
+
+    bsl::string        d_names;          // names of all inserted attributes
+
+    int                d_numAttributes;  // number of used entries
+
+    // PRIVATE CLASS METHODS
+    static unsigned int hash(const char *name, int nameLength);
+        // Return the hash of the specified 'name' having the specified
+        // 'nameLength'.
+
+    // PRIVATE MANIPULATORS
+    void rehash(bsl::size_t size);
+        // Rebuild the table with the specified 'size' entries.  The behavior
+        // is undefined unless 'size' is a power of two greater than twice
+        // the number of attributes in this index.
+
+    // PRIVATE ACCESSORS
+    bsl::size_t findSlot(unsigned int  hash,
+                         const char   *name,
+                         int           nameLength) const;
+        // Return the index of the entry in the table holding the specified
+        // 'name' having the specified 'nameLength' and 'hash', or of the
+        // unused entry at which such an entry would be inserted.  The
+        // behavior is undefined unless the table is not empty.
+
+  private:
+    // NOT IMPLEMENTED
+    bdlat_AttributeNameIndex(const bdlat_AttributeNameIndex&);
+    bdlat_AttributeNameIndex& operator=(const bdlat_AttributeNameIndex&);
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(bdlat_AttributeNameIndex,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit bdlat_AttributeNameIndex(bslma::Allocator *basicAllocator = 0);
+        // Create an empty index.  Optionally specify a 'basicAllocator' used
+        // to supply memory.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.
+
+    //! ~bdlat_AttributeNameIndex() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    int insert(int attributeId, const char *name, int nameLength);
+        // Insert into this index a mapping from the specified 'name' having
+        // the specified 'nameLength' to the specified 'attributeId'.  Return
+        // 0 on success, and a non-zero value, with no effect, if 'name' is
+        // already in this index.  The behavior is undefined unless
+        // '0 <= nameLength' and 'name' refers to at least 'nameLength'
+        // characters.
+
+    template <class TYPE>
+    int loadAttributes(const TYPE& object);
+        // Remove all entries from this index, and then insert the name and id
+        // of each attribute of the specified "sequence" 'object'.  Return 0
+        // on success, and a non-zero value, leaving this index in a valid but
+        // unspecified state, if two attributes of 'object' have the same
+        // name.
+
+    void reset();
+        // Remove all entries from this index.
+
+    // ACCESSORS
+    int find(int *attributeId, const char *name, int nameLength) const;
+        // Load into the specified 'attributeId' the id of the attribute
+        // having the specified 'name' of the specified 'nameLength'.  Return
+        // 0 on success, and a non-zero value, with no effect on
+        // 'attributeId', if 'name' is not in this index.  The behavior is
+        // undefined unless '0 <= nameLength' and 'name' refers to at least
+        // 'nameLength' characters.
+
+    int numAttributes() const;
+        // Return the number of attributes in this index.
+
+                                  // Aspects
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used by this object to supply memory.
+};
+
+                     // ===================================
+                     // struct bdlat_AttributeNameIndexUtil
+                     // ===================================
+
+struct bdlat_AttributeNameIndexUtil {
+    // This 'struct' provides a namespace for functions that access the
+    // attributes of "sequence" types by name using a
+    // 'bdlat_AttributeNameIndex' where the attributes of the type permit.
+
+  private:
+    // PRIVATE CLASS METHODS
+    template <class TYPE, class MANIPULATOR>
+    static int manipulateAttributeImp(TYPE              *object,
+                                      MANIPULATOR&       manipulator,
+                                      const char        *attributeName,
+                                      int                attributeNameLength,
+                                      bslmf::MetaInt<1>);
+    template <class TYPE, class MANIPULATOR>
+    static int manipulateAttributeImp(TYPE              *object,
+                                      MANIPULATOR&       manipulator,
+                                      const char        *attributeName,
+                                      int                attributeNameLength,
+                                      bslmf::MetaInt<0>);
+        // Invoke the specified 'manipulator' on the attribute of the
+        // specified 'object' indicated by the specified 'attributeName' and
+        // 'attributeNameLength', consulting the index for 'TYPE' first if the
+        // last argument is 'bslmf::MetaInt<1>'.
+
+    template <class TYPE>
+    static bool hasAttributeImp(const TYPE&        object,
+                                const char        *attributeName,
+                                int                attributeNameLength,
+                                bslmf::MetaInt<1>);
+    template <class TYPE>
+    static bool hasAttributeImp(const TYPE&        object,
+                                const char        *attributeName,
+                                int                attributeNameLength,
+                                bslmf::MetaInt<0>);
+        // Return 'true' if the specified 'object' has an attribute with the
+        // specified 'attributeName' and 'attributeNameLength', consulting the
+        // index for 'TYPE' first if the last argument is 'bslmf::MetaInt<1>'.
+
+  public:
+    // CLASS METHODS
+    template <class TYPE>
+    static const bdlat_AttributeNameIndex& indexForType(const TYPE& object);
+        // Return a reference providing non-modifiable access to the index of
+        // the attributes of the (template parameter) 'TYPE', loading that
+        // index from the specified 'object' if this is the first call for
+        // 'TYPE'.  This function is thread-safe.  The behavior is undefined
+        // unless the attributes of 'TYPE' have distinct names and do not
+        // depend on the value of 'object'.
+
+    template <class TYPE, class MANIPULATOR>
+    static int manipulateAttribute(TYPE         *object,
+                                   MANIPULATOR&  manipulator,
+                                   const char   *attributeName,
+                                   int           attributeNameLength);
+        // Invoke the specified 'manipulator' on the address of the
+        // (modifiable) attribute indicated by the specified 'attributeName'
+        // and 'attributeNameLength' of the specified 'object', supplying
+        // 'manipulator' with the corresponding attribute information
+        // structure.  Return a non-zero value if the attribute is not found,
+        // and the value returned from the invocation of 'manipulator'
+        // otherwise.  Note that this function has the same contract as the
+        // corresponding function in 'bdlat_SequenceFunctions'.
+
+    template <class TYPE>
+    static bool hasAttribute(const TYPE&  object,
+                             const char  *attributeName,
+                             int          attributeNameLength);
+        // Return 'true' if the specified 'object' has an attribute with the
+        // specified 'attributeName' of the specified 'attributeNameLength',
+        // and 'false' otherwise.  Note that this function has the same
+        // contract as the corresponding function in
+        // 'bdlat_SequenceFunctions'.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                       // ------------------------------
+                       // class bdlat_AttributeNameIndex
+                       // ------------------------------
+
+// PRIVATE CLASS METHODS
+inline
+unsigned int bdlat_AttributeNameIndex::hash(const char *name, int nameLength)
+{
+    // 32-bit FNV-1a.
+
+    unsigned int result = 2166136261U;
+    for (int i = 0; i < nameLength; ++i) {
+        result ^= static_cast<unsigned char>(name[i]);
+        result *= 16777619U;
+    }
+    return result;
+}
+
+// MANIPULATORS
+template <class TYPE>
+int bdlat_AttributeNameIndex::loadAttributes(const TYPE& object)
+{
+    reset();
+
+    bdlat_AttributeNameIndex_Loader loader(this);
+    return bdlat_SequenceFunctions::accessAttributes(object, loader);
+}
+
+// ACCESSORS
+inline
+int bdlat_AttributeNameIndex::numAttributes() const
+{
+    return d_numAttributes;
+}
+
+                                  // Aspects
+
+inline
+bslma::Allocator *bdlat_AttributeNameIndex::allocator() const
+{
+    return d_names.get_allocator().mechanism();
+}
+
+                   // -------------------------------------
+                   // class bdlat_AttributeNameIndex_Loader
+                   // -------------------------------------
+
+// CREATORS
+inline
+bdlat_AttributeNameIndex_Loader::bdlat_AttributeNameIndex_Loader(
+                                              bdlat_AttributeNameIndex *index)
+: d_index_p(index)
+{
+}
+
+// MANIPULATORS
+template <class ATTRIBUTE, class INFO>
+inline
+int bdlat_AttributeNameIndex_Loader::operator()(const ATTRIBUTE&,
+                                                const INFO&      info)
+{
+    return d_index_p->insert(info.id(), info.name(), info.nameLength());
+}
+
+                     // -----------------------------------
+                     // struct bdlat_AttributeNameIndexUtil
+                     // -----------------------------------
+
+// PRIVATE CLASS METHODS
+template <class TYPE, class MANIPULATOR>
+inline
+int bdlat_AttributeNameIndexUtil::manipulateAttributeImp(
+                                      TYPE              *object,
+                                      MANIPULATOR&       manipulator,
+                                      const char        *attributeName,
+                                      int                attributeNameLength,
+                                      bslmf::MetaInt<1>)
+{
+    int attributeId;
+    if (0 == indexForType(*object).find(&attributeId,
+                                        attributeName,
+                                        attributeNameLength)) {
+        return bdlat_SequenceFunctions::manipulateAttribute(
+                                                         object,
+                                                         manipulator,
+                                                         attributeId);// RETURN
+    }
+
+    return bdlat_SequenceFunctions::manipulateAttribute(object,
+                                                        manipulator,
+                                                        attributeName,
+                                                        attributeNameLength);
+}
+
+template <class TYPE, class MANIPULATOR>
+inline
+int bdlat_AttributeNameIndexUtil::manipulateAttributeImp(
+                                      TYPE              *object,
+                                      MANIPULATOR&       manipulator,
+                                      const char        *attributeName,
+                                      int                attributeNameLength,
+                                      bslmf::MetaInt<0>)
+{
+    return bdlat_SequenceFunctions::manipulateAttribute(object,
+                                                        manipulator,
+                                                        attributeName,
+                                                        attributeNameLength);
+}
+
+template <class TYPE>
+inline
+bool bdlat_AttributeNameIndexUtil::hasAttributeImp(
+                                      const TYPE&        object,
+                                      const char        *attributeName,
+                                      int                attributeNameLength,
+                                      bslmf::MetaInt<1>)
+{
+    int attributeId;
+    return 0 == indexForType(object).find(&attributeId,
+                                          attributeName,
+                                          attributeNameLength)
+        || bdlat_SequenceFunctions::hasAttribute(object,
+                                                 attributeName,
+                                                 attributeNameLength);
+}
+
+template <class TYPE>
+inline
+bool bdlat_AttributeNameIndexUtil::hasAttributeImp(
+                                      const TYPE&        object,
+                                      const char        *attributeName,
+                                      int                attributeNameLength,
+                                      bslmf::MetaInt<0>)
+{
+    return bdlat_SequenceFunctions::hasAttribute(object,
+                                                 attributeName,
+                                                 attributeNameLength);
+}
+
+// CLASS METHODS
+template <class TYPE>
+const bdlat_AttributeNameIndex&
+bdlat_AttributeNameIndexUtil::indexForType(const TYPE& object)
+{
+    static const bdlat_AttributeNameIndex *s_index_p = 0;
+
+    BSLMT_ONCE_DO {
+        bslma::Allocator *allocator = bslma::Default::globalAllocator();
+
+        bdlat_AttributeNameIndex *index = new (*allocator)
+                                          bdlat_AttributeNameIndex(allocator);
+
+        int rc = index->loadAttributes(object);
+        BSLS_ASSERT(0 == rc);  (void)rc;
+
+        s_index_p = index;
+    }
+
+    return *s_index_p;
+}
+
+template <class TYPE, class MANIPULATOR>
+inline
+int bdlat_AttributeNameIndexUtil::manipulateAttribute(
+                                             TYPE         *object,
+                                             MANIPULATOR&  manipulator,
+                                             const char   *attributeName,
+                                             int           attributeNameLength)
+{
+    BSLS_ASSERT_SAFE(object);
+
+    typedef bslmf::MetaInt<
+               bslalg::HasTrait<TYPE, bdlat_TypeTraitBasicSequence>::VALUE>
+                                                                       IsBasic;
+
+    return manipulateAttributeImp(object,
+                                  manipulator,
+                                  attributeName,
+                                  attributeNameLength,
+                                  IsBasic());
+}
+
+template <class TYPE>
+inline
+bool bdlat_AttributeNameIndexUtil::hasAttribute(
+                                             const TYPE&  object,
+                                             const char  *attributeName,
+                                             int          attributeNameLength)
+{
+    typedef bslmf::MetaInt<
+               bslalg::HasTrait<TYPE, bdlat_TypeTraitBasicSequence>::VALUE>
+                                                                       IsBasic;
+
+    return hasAttributeImp(object,
+                           attributeName,
+                           attributeNameLength,
+                           IsBasic());
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
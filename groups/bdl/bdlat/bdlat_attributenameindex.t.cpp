@@ -0,0 +1,899 @@
+// bdlat_attributenameindex.t.cpp                                     -*-C++-*-
+#include <bdlat_attributenameindex.h>
+
+#include <bdlat_attributeinfo.h>
+#include <bdlat_sequencefunctions.h>
+#include <bdlat_typetraits.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test provides a hash table mapping attribute names to
+// ids, and functions that use a per-type instance of that table to access the
+// attributes of generated "sequence" types by name.  We verify the table
+// directly, then verify that it is loaded correctly from "sequence" types, and
+// finally that the utility functions behave exactly as the corresponding
+// functions of 'bdlat_SequenceFunctions' for generated and non-generated
+// types.
+// ----------------------------------------------------------------------------
+// CREATORS
+// [ 2] bdlat_AttributeNameIndex(bslma::Allocator *basicAllocator = 0);
+//
+// MANIPULATORS
+// [ 2] int insert(int attributeId, const char *name, int nameLength);
+// [ 3] int loadAttributes(const TYPE& object);
+// [ 2] void reset();
+//
+// ACCESSORS
+// [ 2] int find(int *attributeId, const char *name, int nameLength) const;
+// [ 2] int numAttributes() const;
+// [ 2] bslma::Allocator *allocator() const;
+//
+// UTILITIES
+// [ 4] const bdlat_AttributeNameIndex& indexForType(const TYPE& object);
+// [ 4] int manipulateAttribute(TYPE *, MANIPULATOR&, const char *, int);
+// [ 4] bool hasAttribute(const TYPE&, const char *, int);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] USAGE EXAMPLE
+// [-1] BENCHMARK: LOOKUP BY NAME
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlat_AttributeNameIndex     Obj;
+typedef bdlat_AttributeNameIndexUtil Util;
+
+// ============================================================================
+//                            CLASSES FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace test {
+
+                              // ================
+                              // class WideRecord
+                              // ================
+
+class WideRecord {
+    // This class models a generated "sequence" type having 'NUM_ATTRIBUTES'
+    // 'int' attributes named "attribute0", "attribute1", and so on, whose ids
+    // are offset from their indices by 'k_ID_OFFSET'.  Like some generated
+    // types, it looks up attributes by name by comparing the supplied name
+    // against each attribute name in turn, and, like generated types having
+    // an anonymous choice, it also accepts a name ("alias") that is not the
+    // name of any attribute.
+
+  public:
+    // TYPES
+    enum {
+        NUM_ATTRIBUTES = 128,
+        k_ID_OFFSET    = 100
+    };
+
+  private:
+    // CLASS DATA
+    static char                s_names[NUM_ATTRIBUTES][16];
+    static bdlat_AttributeInfo s_info[NUM_ATTRIBUTES];
+    static bool                s_initialized;
+
+    // DATA
+    int d_values[NUM_ATTRIBUTES];
+
+  public:
+    // CLASS METHODS
+    static void initialize();
+        // Initialize the attribute information of this class.  This function
+        // must be called before any other function of this class.
+
+    static const bdlat_AttributeInfo *lookupAttributeInfo(int id);
+    static const bdlat_AttributeInfo *lookupAttributeInfo(
+                                                       const char *name,
+                                                       int         nameLength);
+        // Return the information for the attribute having the specified 'id',
+        // or the specified 'name' and 'nameLength', or 0 if there is no such
+        // attribute.
+
+    // TRAITS
+    BSLALG_DECLARE_NESTED_TRAITS(WideRecord, bdlat_TypeTraitBasicSequence);
+
+    // CREATORS
+    WideRecord()
+    {
+        bsl::memset(d_values, 0, sizeof d_values);
+    }
+
+    // MANIPULATORS
+    template <class MANIPULATOR>
+    int manipulateAttribute(MANIPULATOR& manipulator, int id)
+    {
+        const bdlat_AttributeInfo *info = lookupAttributeInfo(id);
+        if (!info) {
+            return -1;                                                // RETURN
+        }
+        return manipulator(&d_values[id - k_ID_OFFSET], *info);
+    }
+
+    template <class MANIPULATOR>
+    int manipulateAttribute(MANIPULATOR&  manipulator,
+                            const char   *name,
+                            int           nameLength)
+    {
+        const bdlat_AttributeInfo *info = lookupAttributeInfo(name,
+                                                              nameLength);
+        if (!info) {
+            return -1;                                                // RETURN
+        }
+        return manipulateAttribute(manipulator, info->d_id);
+    }
+
+    template <class MANIPULATOR>
+    int manipulateAttributes(MANIPULATOR& manipulator)
+    {
+        for (int i = 0; i < NUM_ATTRIBUTES; ++i) {
+            const int rc = manipulator(&d_values[i], s_info[i]);
+            if (rc) {
+                return rc;                                            // RETURN
+            }
+        }
+        return 0;
+    }
+
+    // ACCESSORS
+    template <class ACCESSOR>
+    int accessAttribute(ACCESSOR& accessor, int id) const
+    {
+        const bdlat_AttributeInfo *info = lookupAttributeInfo(id);
+        if (!info) {
+            return -1;                                                // RETURN
+        }
+        return accessor(d_values[id - k_ID_OFFSET], *info);
+    }
+
+    template <class ACCESSOR>
+    int accessAttribute(ACCESSOR&   accessor,
+                        const char *name,
+                        int         nameLength) const
+    {
+        const bdlat_AttributeInfo *info = lookupAttributeInfo(name,
+                                                              nameLength);
+        if (!info) {
+            return -1;                                                // RETURN
+        }
+        return accessAttribute(accessor, info->d_id);
+    }
+
+    template <class ACCESSOR>
+    int accessAttributes(ACCESSOR& accessor) const
+    {
+        for (int i = 0; i < NUM_ATTRIBUTES; ++i) {
+            const int rc = accessor(d_values[i], s_info[i]);
+            if (rc) {
+                return rc;                                            // RETURN
+            }
+        }
+        return 0;
+    }
+
+    int value(int index) const
+    {
+        return d_values[index];
+    }
+};
+
+                              // ----------------
+                              // class WideRecord
+                              // ----------------
+
+char                WideRecord::s_names[NUM_ATTRIBUTES][16];
+bdlat_AttributeInfo WideRecord::s_info[NUM_ATTRIBUTES];
+bool                WideRecord::s_initialized = false;
+
+void WideRecord::initialize()
+{
+    if (s_initialized) {
+        return;                                                       // RETURN
+    }
+
+    for (int i = 0; i < NUM_ATTRIBUTES; ++i) {
+        bsl::sprintf(s_names[i], "attribute%d", i);
+
+        bdlat_AttributeInfo& info = s_info[i];
+        info.d_id             = i + k_ID_OFFSET;
+        info.d_name_p         = s_names[i];
+        info.d_nameLength     = static_cast<int>(bsl::strlen(s_names[i]));
+        info.d_annotation_p   = "";
+        info.d_formattingMode = 0;
+    }
+    s_initialized = true;
+}
+
+const bdlat_AttributeInfo *WideRecord::lookupAttributeInfo(int id)
+{
+    const int index = id - k_ID_OFFSET;
+    return 0 <= index && index < NUM_ATTRIBUTES ? &s_info[index] : 0;
+}
+
+const bdlat_AttributeInfo *WideRecord::lookupAttributeInfo(
+                                                       const char *name,
+                                                       int         nameLength)
+{
+    if (5 == nameLength && 0 == bsl::memcmp("alias", name, 5)) {
+        return &s_info[0];                                            // RETURN
+    }
+
+    for (int i = 0; i < NUM_ATTRIBUTES; ++i) {
+        const bdlat_AttributeInfo& info = s_info[i];
+
+        if (nameLength == info.d_nameLength
+         && 0 == bsl::memcmp(info.d_name_p, name, nameLength)) {
+            return &info;                                             // RETURN
+        }
+    }
+    return 0;
+}
+
+                            // ====================
+                            // struct DynamicRecord
+                            // ====================
+
+struct DynamicRecord {
+    // This 'struct' models a non-generated "sequence" type whose attributes
+    // are those named in 'd_names', and which counts calls to its name-based
+    // functions.
+
+    bsl::vector<bsl::string> d_names;
+    int                      d_numNameCalls;
+};
+
+// The following functions expose "sequence" behavior for 'DynamicRecord'
+// through argument-dependent lookup.
+
+template <class MANIPULATOR>
+int bdlat_sequenceManipulateAttribute(DynamicRecord *object,
+                                      MANIPULATOR&   manipulator,
+                                      const char    *name,
+                                      int            nameLength)
+{
+    ++object->d_numNameCalls;
+
+    for (bsl::size_t i = 0; i < object->d_names.size(); ++i) {
+        if (object->d_names[i] == bsl::string(name, nameLength)) {
+            bdlat_AttributeInfo info = { static_cast<int>(i),
+                                         object->d_names[i].c_str(),
+                                         nameLength,
+                                         "",
+                                         0 };
+            int value = 0;
+            return manipulator(&value, info);                         // RETURN
+        }
+    }
+    return -1;
+}
+
+bool bdlat_sequenceHasAttribute(const DynamicRecord&  object,
+                                const char           *name,
+                                int                   nameLength)
+{
+    const_cast<DynamicRecord&>(object).d_numNameCalls++;
+
+    for (bsl::size_t i = 0; i < object.d_names.size(); ++i) {
+        if (object.d_names[i] == bsl::string(name, nameLength)) {
+            return true;                                              // RETURN
+        }
+    }
+    return false;
+}
+
+}  // close namespace test
+
+namespace {
+
+struct SetValue {
+    // This manipulator assigns a value to each 'int' attribute visited, and
+    // records the id of the last attribute visited.
+
+    int d_value;
+    int d_lastId;
+
+    int operator()(int *attribute, const bdlat_AttributeInfo& info)
+    {
+        *attribute = d_value;
+        d_lastId   = info.d_id;
+        return 0;
+    }
+};
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int test = argc > 1 ? atoi(argv[1]) : 0;
+    bool verbose = argc > 2;
+    bool veryVerbose = argc > 3;
+    bool veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator defaultAllocator("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard guard(&defaultAllocator);
+
+    test::WideRecord::initialize();
+
+    switch (test) { case 0:  // Zero is always the leading case.
+      case 5: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nUSAGE EXAMPLE"
+                          << "\n=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Finding Attribute Ids by Name
+/// - - - - - - - - - - - - - - - - - - - -
+// Suppose that we need to translate element names to attribute ids while
+// parsing a document.  First, we create an index and insert the attributes we
+// expect:
+//..
+    bdlat_AttributeNameIndex index;
+
+    int rc = index.insert(1, "name", 4);
+    ASSERT(0 == rc);
+
+    rc = index.insert(2, "age", 3);
+    ASSERT(0 == rc);
+    ASSERT(2 == index.numAttributes());
+//..
+// Inserting a name a second time fails, leaving the index unchanged:
+//..
+    rc = index.insert(3, "age", 3);
+    ASSERT(0 != rc);
+    ASSERT(2 == index.numAttributes());
+//..
+// Then, we look up names, which need not be null-terminated:
+//..
+    const char *element = "age=42";
+    int         id      = 0;
+
+    rc = index.find(&id, element, 3);
+    ASSERT(0 == rc);
+    ASSERT(2 == id);
+
+    rc = index.find(&id, "height", 6);
+    ASSERT(0 != rc);
+//..
+// Finally, note that a codec would typically not populate an index itself,
+// but would instead call 'bdlat_AttributeNameIndexUtil::manipulateAttribute'
+// wherever it would otherwise call the name-based
+// 'bdlat_SequenceFunctions::manipulateAttribute'.
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // UTILITY FUNCTIONS
+        //
+        // Concerns:
+        //: 1 'indexForType' returns the same index on every call for a type,
+        //:   and that index holds every attribute of the type.
+        //:
+        //: 2 'indexForType' allocates from the global allocator only.
+        //:
+        //: 3 For a generated type, 'manipulateAttribute' and 'hasAttribute'
+        //:   find every attribute, reject unknown names and prefixes of
+        //:   known names, and manipulate the same attribute as the
+        //:   corresponding function of 'bdlat_SequenceFunctions'.
+        //:
+        //: 4 For a generated type, names accepted by the type that are not
+        //:   attribute names are still recognized.
+        //:
+        //: 5 For a non-generated type, 'manipulateAttribute' and
+        //:   'hasAttribute' forward to the name-based functions of the type.
+        //
+        // Plan:
+        //: 1 Call 'indexForType' twice for 'WideRecord' and verify the
+        //:   address and contents of the index, and that the default
+        //:   allocator was not used.  (C-1..2)
+        //:
+        //: 2 For each attribute of 'WideRecord', set its value through
+        //:   'manipulateAttribute' and verify the result.  Verify the results
+        //:   of both functions for names that are not attributes.  (C-3)
+        //:
+        //: 3 Invoke both functions with the name "alias", which 'WideRecord'
+        //:   accepts for its first attribute.  (C-4)
+        //:
+        //: 4 Invoke both functions on a 'DynamicRecord' and verify that its
+        //:   name-based functions were called.  (C-5)
+        //
+        // Testing:
+        //   const bdlat_AttributeNameIndex& indexForType(const TYPE& object);
+        //   int manipulateAttribute(TYPE *, MANIPULATOR&, const char *, int);
+        //   bool hasAttribute(const TYPE&, const char *, int);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nUTILITY FUNCTIONS"
+                          << "\n=================" << endl;
+
+        typedef test::WideRecord Record;
+
+        if (verbose) cout << "\tTesting 'indexForType'." << endl;
+        {
+            Record record;
+
+            const bdlat_AttributeNameIndex& INDEX = Util::indexForType(record);
+            ASSERT(&INDEX == &Util::indexForType(record));
+            ASSERT(Record::NUM_ATTRIBUTES == INDEX.numAttributes());
+            ASSERT(bslma::Default::globalAllocator() == INDEX.allocator());
+            ASSERT(0 == defaultAllocator.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\tTesting generated types." << endl;
+        {
+            Record record;
+
+            for (int i = 0; i < Record::NUM_ATTRIBUTES; ++i) {
+                char name[16];
+                bsl::sprintf(name, "attribute%d", i);
+                const int LEN = static_cast<int>(bsl::strlen(name));
+
+                ASSERTV(i, Util::hasAttribute(record, name, LEN));
+                ASSERTV(i, Util::hasAttribute(record, name, LEN) ==
+                       bdlat_SequenceFunctions::hasAttribute(record,
+                                                             name,
+                                                             LEN));
+
+                SetValue setter = { i + 1, -1 };
+                ASSERTV(i, 0 == Util::manipulateAttribute(&record,
+                                                          setter,
+                                                          name,
+                                                          LEN));
+                ASSERTV(i, i + 1 == record.value(i));
+                ASSERTV(i, i + Record::k_ID_OFFSET == setter.d_lastId);
+            }
+
+            static const char *const UNKNOWN[] = {
+                "", "a", "attribute", "attribute128", "Attribute0",
+                "attribute00", "attribute1x"
+            };
+            const int NUM_UNKNOWN = sizeof UNKNOWN / sizeof *UNKNOWN;
+
+            for (int i = 0; i < NUM_UNKNOWN; ++i) {
+                const char *NAME = UNKNOWN[i];
+                const int   LEN  = static_cast<int>(bsl::strlen(NAME));
+
+                ASSERTV(NAME, !Util::hasAttribute(record, NAME, LEN));
+
+                SetValue setter = { 0, -1 };
+                ASSERTV(NAME, 0 != Util::manipulateAttribute(&record,
+                                                             setter,
+                                                             NAME,
+                                                             LEN));
+                ASSERTV(NAME, -1 == setter.d_lastId);
+            }
+
+            // A name that is a prefix of the supplied characters must match
+            // only for the supplied length.
+
+            ASSERT( Util::hasAttribute(record, "attribute12", 10));
+            ASSERT( Util::hasAttribute(record, "attribute12", 11));
+        }
+
+        if (verbose) cout << "\tTesting names that are not in the index."
+                          << endl;
+        {
+            Record record;
+            int    id;
+
+            ASSERT(0 != Util::indexForType(record).find(&id, "alias", 5));
+            ASSERT(Util::hasAttribute(record, "alias", 5));
+
+            SetValue setter = { 42, -1 };
+            ASSERT(0 == Util::manipulateAttribute(&record,
+                                                  setter,
+                                                  "alias",
+                                                  5));
+            ASSERT(42 == record.value(0));
+            ASSERT(Record::k_ID_OFFSET == setter.d_lastId);
+        }
+
+        if (verbose) cout << "\tTesting non-generated types." << endl;
+        {
+            test::DynamicRecord record;
+            record.d_names.push_back("first");
+            record.d_names.push_back("second");
+            record.d_numNameCalls = 0;
+
+            ASSERT( Util::hasAttribute(record, "second", 6));
+            ASSERT(1 == record.d_numNameCalls);
+
+            ASSERT(!Util::hasAttribute(record, "third", 5));
+            ASSERT(2 == record.d_numNameCalls);
+
+            SetValue setter = { 0, -1 };
+            ASSERT(0 == Util::manipulateAttribute(&record,
+                                                  setter,
+                                                  "second",
+                                                  6));
+            ASSERT(3 == record.d_numNameCalls);
+            ASSERT(1 == setter.d_lastId);
+
+            record.d_names.push_back("third");
+            ASSERT( Util::hasAttribute(record, "third", 5));
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // LOADING FROM A SEQUENCE
+        //
+        // Concerns:
+        //: 1 'loadAttributes' inserts the name and id of every attribute of
+        //:   the supplied object.
+        //:
+        //: 2 'loadAttributes' removes any existing entries.
+        //
+        // Plan:
+        //: 1 Load an index that already holds entries from a 'WideRecord',
+        //:   and verify that every attribute, and no other name, is found.
+        //:   (C-1..2)
+        //
+        // Testing:
+        //   int loadAttributes(const TYPE& object);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nLOADING FROM A SEQUENCE"
+                          << "\n=======================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        Obj mX(&ta);  const Obj& X = mX;
+
+        ASSERT(0 == mX.insert(7, "stale", 5));
+
+        test::WideRecord record;
+        ASSERT(0 == mX.loadAttributes(record));
+        ASSERT(test::WideRecord::NUM_ATTRIBUTES == X.numAttributes());
+
+        int id;
+        ASSERT(0 != X.find(&id, "stale", 5));
+
+        for (int i = 0; i < test::WideRecord::NUM_ATTRIBUTES; ++i) {
+            char name[16];
+            bsl::sprintf(name, "attribute%d", i);
+
+            id = -1;
+            ASSERTV(i, 0 == X.find(&id,
+                                   name,
+                                   static_cast<int>(bsl::strlen(name))));
+            ASSERTV(i, id, test::WideRecord::k_ID_OFFSET + i == id);
+        }
+
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // INSERT, FIND, AND RESET
+        //
+        // Concerns:
+        //: 1 Every inserted name is found, with its id, as the table grows.
+        //:
+        //: 2 Names are compared by length and content, so that prefixes,
+        //:   extensions, and the empty name are distinct names.
+        //:
+        //: 3 Inserting a name that is already present fails and has no
+        //:   effect.
+        //:
+        //: 4 'reset' removes all entries, after which names can be inserted
+        //:   again.
+        //:
+        //: 5 All memory comes from the object allocator.
+        //
+        // Plan:
+        //: 1 Insert a large number of generated names, verifying after each
+        //:   insertion that every name inserted so far is found and that the
+        //:   next name is not.  (C-1)
+        //:
+        //: 2 Insert and find a set of names that are prefixes of one another,
+        //:   including the empty name.  (C-2..3)
+        //:
+        //: 3 Reset the object and repeat.  (C-4)
+        //:
+        //: 4 Verify that the default allocator was not used.  (C-5)
+        //
+        // Testing:
+        //   bdlat_AttributeNameIndex(bslma::Allocator *basicAllocator = 0);
+        //   int insert(int attributeId, const char *name, int nameLength);
+        //   void reset();
+        //   int find(int *attributeId, const char *name, int nameLength) const;
+        //   int numAttributes() const;
+        //   bslma::Allocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nINSERT, FIND, AND RESET"
+                          << "\n=======================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        Obj mX(&ta);  const Obj& X = mX;
+
+        ASSERT(&ta == X.allocator());
+
+        if (verbose) cout << "\tGrowing the table." << endl;
+
+        const int NUM_NAMES = 300;
+
+        bsl::vector<bsl::string> names(&ta);
+        for (int i = 0; i < NUM_NAMES; ++i) {
+            char buffer[32];
+            bsl::sprintf(buffer, "n%dx", i * 7919);
+            names.push_back(buffer);
+        }
+
+        for (int i = 0; i < NUM_NAMES; ++i) {
+            const bsl::string& NAME = names[i];
+            const int          LEN  = static_cast<int>(NAME.size());
+
+            int id = -1;
+            ASSERTV(i, 0 != X.find(&id, NAME.data(), LEN));
+            ASSERTV(i, -1 == id);
+
+            ASSERTV(i, 0 == mX.insert(i * 3, NAME.data(), LEN));
+            ASSERTV(i, i + 1 == X.numAttributes());
+
+            if (veryVerbose || i + 1 == NUM_NAMES) {
+                for (int j = 0; j <= i; ++j) {
+                    ASSERTV(i, j, 0 == X.find(&id,
+                                              names[j].data(),
+                                              static_cast<int>(
+                                                          names[j].size())));
+                    ASSERTV(i, j, id, j * 3 == id);
+                }
+            }
+        }
+
+        if (verbose) cout << "\tPrefixes, duplicates, and reset." << endl;
+
+        for (int pass = 0; pass < 2; ++pass) {
+            mX.reset();
+            ASSERTV(pass, 0 == X.numAttributes());
+
+            int id;
+            ASSERTV(pass, 0 != X.find(&id, "", 0));
+
+            static const char NAME[] = "abcdef";
+
+            for (int len = 0; len < 7; ++len) {
+                ASSERTV(pass, len, 0 == mX.insert(len, NAME, len));
+            }
+            ASSERTV(pass, 7 == X.numAttributes());
+
+            for (int len = 0; len < 7; ++len) {
+                ASSERTV(pass, len, 0 != mX.insert(len + 10, NAME, len));
+                ASSERTV(pass, len, 0 == X.find(&id, NAME, len));
+                ASSERTV(pass, len, id, len == id);
+            }
+            ASSERTV(pass, 7 == X.numAttributes());
+
+            ASSERTV(pass, 0 != X.find(&id, "abcdeg", 6));
+            ASSERTV(pass, 0 != X.find(&id, "bcdef", 5));
+        }
+
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Insert a few names, find them, and reset the object.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nBREATHING TEST"
+                          << "\n==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        Obj mX(&ta);  const Obj& X = mX;
+        ASSERT(0 == X.numAttributes());
+
+        int id = -1;
+        ASSERT(0 != X.find(&id, "x", 1));
+
+        ASSERT(0 == mX.insert(5, "x", 1));
+        ASSERT(0 == mX.insert(6, "y", 1));
+        ASSERT(2 == X.numAttributes());
+
+        ASSERT(0 == X.find(&id, "x", 1));    ASSERT(5 == id);
+        ASSERT(0 == X.find(&id, "y", 1));    ASSERT(6 == id);
+        ASSERT(0 != X.find(&id, "z", 1));    ASSERT(6 == id);
+
+        mX.reset();
+        ASSERT(0 == X.numAttributes());
+        ASSERT(0 != X.find(&id, "x", 1));
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // BENCHMARK: LOOKUP BY NAME
+        //
+        // Concerns:
+        //: 1 Report the cost of manipulating attributes of a type having many
+        //:   attributes by name, with and without the index.
+        //
+        // Plan:
+        //: 1 Repeatedly manipulate every attribute of a 'WideRecord' by name
+        //:   using 'bdlat_SequenceFunctions' and
+        //:   'bdlat_AttributeNameIndexUtil', and report the time taken.
+        //
+        // Testing:
+        //   BENCHMARK: LOOKUP BY NAME
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nBENCHMARK: LOOKUP BY NAME"
+                          << "\n=========================" << endl;
+
+        typedef test::WideRecord Record;
+
+        const int NUM_ITERATIONS = 20000;
+
+        char names[Record::NUM_ATTRIBUTES][16];
+        int  lengths[Record::NUM_ATTRIBUTES];
+        for (int i = 0; i < Record::NUM_ATTRIBUTES; ++i) {
+            bsl::sprintf(names[i], "attribute%d", i);
+            lengths[i] = static_cast<int>(bsl::strlen(names[i]));
+        }
+
+        Record   record;
+        SetValue setter = { 1, 0 };
+
+        bsls::Stopwatch timer;
+
+        timer.start();
+        for (int j = 0; j < NUM_ITERATIONS; ++j) {
+            for (int i = 0; i < Record::NUM_ATTRIBUTES; ++i) {
+                bdlat_SequenceFunctions::manipulateAttribute(&record,
+                                                             setter,
+                                                             names[i],
+                                                             lengths[i]);
+            }
+        }
+        timer.stop();
+        const double linearTime = timer.elapsedTime();
+
+        timer.reset();
+        timer.start();
+        for (int j = 0; j < NUM_ITERATIONS; ++j) {
+            for (int i = 0; i < Record::NUM_ATTRIBUTES; ++i) {
+                Util::manipulateAttribute(&record,
+                                          setter,
+                                          names[i],
+                                          lengths[i]);
+            }
+        }
+        timer.stop();
+        const double indexedTime = timer.elapsedTime();
+
+        const double numLookups = static_cast<double>(NUM_ITERATIONS)
+                                * Record::NUM_ATTRIBUTES;
+
+        cout << "bdlat_SequenceFunctions:      "
+             << linearTime * 1e9 / numLookups << " ns/lookup" << endl;
+        cout << "bdlat_AttributeNameIndexUtil: "
+             << indexedTime * 1e9 / numLookups << " ns/lookup" << endl;
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
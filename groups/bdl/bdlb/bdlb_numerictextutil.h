@@ -0,0 +1,286 @@
+// bdlb_numerictextutil.h                                             -*-C++-*-
+#ifndef INCLUDED_BDLB_NUMERICTEXTUTIL
+#define INCLUDED_BDLB_NUMERICTEXTUTIL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide fast conversions between numeric values and text.
+//
+//@CLASSES:
+//  bdlb::NumericTextUtil: namespace for numeric formatting and parsing
+//
+//@SEE_ALSO: bdlb_float
+//
+//@DESCRIPTION: This component provides a namespace, 'bdlb::NumericTextUtil',
+// containing functions that convert integral and floating-point values to
+// decimal text and decimal text to such values without the use of
+// 'bsl::ostream' or the 'printf', 'strtod', and 'strtol' families of
+// functions, whose cost is dominated by generality (locale handling, arbitrary
+// precision arithmetic) that text codecs do not need.
+//
+///Integer Conversions
+///-------------------
+// 'formatInt', 'formatUint', 'formatInt64', and 'formatUint64' write the
+// decimal digits of a value two at a time, from a table of the 100 two-digit
+// pairs, directly into their final positions (the number of digits being
+// computed up front from the position of the most significant bit), and
+// 'formatUintFixedWidth' writes a specified number of low-order digits, padded
+// with leading zeros, as required by fixed-width formats such as ISO 8601.
+//
+// 'parseInt', 'parseUint', 'parseInt64', and 'parseUint64' validate and
+// convert eight digits at a time using 64-bit integer arithmetic on the
+// characters themselves ("SIMD within a register", or SWAR), and detect values
+// that are not representable in the result type; such values are reported
+// distinctly from text that is not a decimal integer at all.
+//
+///Shortest Round-Trip Formatting
+///------------------------------
+// 'generateShortestDigits' computes, using the Grisu2 algorithm (Loitsch,
+// "Printing Floating-Point Numbers Quickly and Accurately with Integers",
+// PLDI 2010), a sequence of decimal digits that converts back to exactly the
+// same 'double' (or 'float') value.  The sequence is the shortest such
+// sequence for all but a very small fraction of values (for which it has one
+// more digit than necessary), and never has more than 17 (9 for 'float')
+// digits.  'formatShortest' formats such a digit sequence using the same
+// layout as 'printf' with the '%.17g' (respectively '%.9g') conversion.
+//
+///'printf'-Compatible Formatting
+///------------------------------
+// 'formatGeneral' produces exactly the text that 'snprintf' produces for the
+// '%.*g' conversion with a specified precision in the "C" locale.  For
+// precisions of at most 17, the digits are computed using the counted mode of
+// the Grisu algorithm, which determines the correctly rounded digits, or
+// reports that it cannot, using 64-bit integer arithmetic; in the latter case
+// (which includes every value exactly halfway between two decimal numbers
+// having the requested precision, and is otherwise rare), and for larger
+// precisions, 'snprintf' is called.
+//
+///Parsing
+///-------
+// 'parseDouble' converts decimal text to the nearest 'double' value (ties to
+// even) using the Eisel-Lemire algorithm (Lemire, "Number Parsing at a
+// Gigabyte per Second", Software: Practice and Experience, 2021) when the
+// text has at most 19 significant digits, or the Clinger fast path when the
+// result is exactly computable in 'double' arithmetic.  In the rare cases
+// where neither algorithm can determine the correctly rounded result, 'strtod'
+// is called.  Unlike 'strtod', 'parseDouble' accepts only decimal notation: it
+// does not skip leading whitespace and does not accept hexadecimal notation,
+// infinities, or NaNs.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Round-Tripping a 'double' Through Text
+///-------------------------------------------------
+// Suppose we need to write a 'double' value as text, using as few characters
+// as possible, such that the value read back from the text is identical.
+//
+// First, we format the value:
+//..
+//  const double value = 0.3;
+//
+//  char      buffer[bdlb::NumericTextUtil::k_SHORTEST_BUFFER_SIZE];
+//  const int length = bdlb::NumericTextUtil::formatShortest(buffer, value);
+//
+//  assert(3 == length);
+//  assert(0 == bsl::strcmp("0.3", buffer));
+//..
+// Note that 'printf' with the '%.17g' conversion, which also round-trips,
+// produces "0.29999999999999999".
+//
+// Then, we parse the text:
+//..
+//  double    result;
+//  const int rc = bdlb::NumericTextUtil::parseDouble(&result, buffer, length);
+//
+//  assert(0 == rc);
+//..
+// Finally, we observe that we obtained the original value:
+//..
+//  assert(value == result);
+//..
+//
+///Example 2: Formatting and Parsing Integers
+///------------------------------------------
+// Suppose we need to write an integer field into a text record, and later
+// read it back, rejecting values that do not fit the field's type.
+//
+// First, we format the value into a buffer large enough for any 64-bit
+// integer; note that the text is not null-terminated:
+//..
+//  char      text[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+//  const int textLength = bdlb::NumericTextUtil::formatInt(text, -1234567);
+//
+//  assert(8 == textLength);
+//  assert(0 == bsl::memcmp("-1234567", text, textLength));
+//..
+// Then, we parse the text back:
+//..
+//  int number;
+//  assert(0 == bdlb::NumericTextUtil::parseInt(&number, text, textLength));
+//  assert(-1234567 == number);
+//..
+// Finally, we observe that text representing a value too large for an 'int'
+// is reported with a positive status, while text that is not an integer is
+// reported with a negative status, and that neither modifies the result:
+//..
+//  assert(0 <  bdlb::NumericTextUtil::parseInt(&number, "2147483648", 10));
+//  assert(0 >  bdlb::NumericTextUtil::parseInt(&number, "12a", 3));
+//  assert(-1234567 == number);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlb {
+
+                           // ======================
+                           // struct NumericTextUtil
+                           // ======================
+
+struct NumericTextUtil {
+    // This 'struct' provides a namespace for utility functions that convert
+    // between numeric values and their decimal text representations.
+
+    // PUBLIC TYPES
+    enum {
+        k_MAX_DOUBLE_DIGITS   = 17,  // maximum number of digits generated
+                                     // for a 'double'
+
+        k_MAX_FLOAT_DIGITS    = 9,   // maximum number of digits generated
+                                     // for a 'float'
+
+        k_SHORTEST_BUFFER_SIZE = 25, // sufficient buffer size for
+                                     // 'formatShortest', including the null
+                                     // terminator
+
+        k_MAX_INTEGER_LENGTH   = 20  // maximum number of characters written
+                                     // by the integer formatting functions
+    };
+
+    // CLASS METHODS
+    static int formatGeneral(char   *buffer,
+                             int     bufferLength,
+                             double  value,
+                             int     precision);
+    static int formatGeneral(char   *buffer,
+                             int     bufferLength,
+                             float   value,
+                             int     precision);
+        // Write into the specified 'buffer' of the specified 'bufferLength'
+        // the text that 'snprintf(buffer, bufferLength, "%.*g", precision,
+        // value)' writes in the "C" locale, and return the value that call
+        // returns.  Note that for 'float' the text is that for 'value'
+        // converted to 'double', which is exact.
+
+    static int formatInt(char *buffer, int value);
+    static int formatInt64(char *buffer, bsls::Types::Int64 value);
+    static int formatUint(char *buffer, unsigned int value);
+    static int formatUint64(char *buffer, bsls::Types::Uint64 value);
+        // Write into the specified 'buffer' the decimal representation of the
+        // specified 'value', having no leading zeros and preceded by '-' if
+        // 'value' is negative, and return the number of characters written.
+        // 'buffer' is *not* null-terminated.  The behavior is undefined unless
+        // 'buffer' has room for at least 'k_MAX_INTEGER_LENGTH' characters.
+
+    static void formatUintFixedWidth(char         *buffer,
+                                     unsigned int  value,
+                                     int           width);
+        // Write into the specified 'buffer' the specified 'width' low-order
+        // decimal digits of the specified 'value', padded with leading zeros
+        // if 'value' has fewer than 'width' digits.  'buffer' is *not*
+        // null-terminated.  The behavior is undefined unless '0 <= width' and
+        // 'buffer' has room for at least 'width' characters.
+
+    static int formatShortest(char *buffer, double value);
+    static int formatShortest(char *buffer, float value);
+        // Write into the specified 'buffer' a null-terminated decimal
+        // representation of the specified 'value' from which 'parseDouble' or
+        // 'strtod' recovers exactly 'value', using the digits produced by
+        // 'generateShortestDigits' laid out as the '%.17g' (for 'double') or
+        // '%.9g' (for 'float') 'printf' conversion would lay them out, and
+        // return the number of characters written, not including the null
+        // terminator.  The behavior is undefined unless 'buffer' has room for
+        // at least 'k_SHORTEST_BUFFER_SIZE' characters and 'value' is finite.
+
+    static int generateShortestDigits(char   *digits,
+                                      int    *exponent,
+                                      double  value);
+    static int generateShortestDigits(char   *digits,
+                                      int    *exponent,
+                                      float   value);
+        // Load into the specified 'digits' the decimal digits, having no
+        // trailing zeros, of the shortest (with very rare exceptions; see
+        // {Shortest Round-Trip Formatting}) decimal number that rounds to the
+        // magnitude of the specified 'value', and load into the specified
+        // 'exponent' the power of ten by which that number, read with a
+        // decimal point after its first digit, must be multiplied to obtain
+        // its value.  Return the number of digits loaded.  If 'value' is zero,
+        // load the single digit '0' and an 'exponent' of 0.  'digits' is not
+        // null-terminated.  The behavior is undefined unless 'digits' has room
+        // for at least 'k_MAX_DOUBLE_DIGITS' (respectively
+        // 'k_MAX_FLOAT_DIGITS') characters and 'value' is finite.
+
+    static int parseDouble(double *result, const char *input, int length);
+        // Load into the specified 'result' the 'double' value nearest to the
+        // number represented by the decimal text in the specified 'input'
+        // having the specified 'length'.  The text must match the pattern
+        // '[+-]?(D+|D+\.D*|\.D+)([eE][+-]?D+)?' where 'D' is a decimal digit.
+        // Return 0 on success, a positive value (having loaded an infinity or
+        // a zero of the appropriate sign into 'result') if the number is too
+        // large in magnitude to be represented or is non-zero but too small in
+        // magnitude to be represented by anything but zero, and a negative
+        // value, with no effect on 'result', if the text does not match the
+        // pattern.  The behavior is undefined unless '0 <= length' and 'input'
+        // refers to at least 'length' characters.
+
+    static int parseInt(int *result, const char *input, int length);
+    static int parseInt64(bsls::Types::Int64 *result,
+                          const char         *input,
+                          int                 length);
+    static int parseUint(unsigned int *result, const char *input, int length);
+    static int parseUint64(bsls::Types::Uint64 *result,
+                           const char          *input,
+                           int                  length);
+        // Load into the specified 'result' the integer represented by the
+        // decimal text in the specified 'input' having the specified 'length'.
+        // The text must match the pattern '[+-]?D+' (or '\+?D+' for the
+        // unsigned types) where 'D' is a decimal digit; leading zeros are
+        // permitted.  Return 0 on success, a positive value if the text
+        // matches the pattern but the integer is not representable by the
+        // type of 'result', and a negative value if the text does not match
+        // the pattern; 'result' is not modified unless 0 is returned.  The
+        // behavior is undefined unless '0 <= length' and 'input' refers to at
+        // least 'length' characters.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1458 @@
+// bdlb_numerictextutil.t.cpp                                         -*-C++-*-
+#include <bdlb_numerictextutil.h>
+
+#include <bslim_testutil.h>
+
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>
+#include <bsl_cstring.h>
+#include <bsl_iostream.h>
+#include <bsl_limits.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using bsl::cout;
+using bsl::cerr;
+using bsl::endl;
+
+// ============================================================================
+//                             TEST PLAN
+// ----------------------------------------------------------------------------
+//                             Overview
+//                             --------
+// The component under test provides conversions between numeric values and
+// decimal text that must agree exactly with the C library: the text written
+// by 'formatGeneral' must be that written by 'snprintf', the value obtained by
+// 'parseDouble' must be that obtained by 'strtod', and the integer functions
+// must agree with the '%d' family of conversions and with 'strtoull'.  In
+// addition to table-driven tests of boundary values, each function is
+// checked against the C library on a large number of pseudo-random inputs.
+// ----------------------------------------------------------------------------
+// CLASS METHODS
+// [ 4] int formatGeneral(char *, int, double, int);
+// [ 4] int formatGeneral(char *, int, float, int);
+// [ 6] int formatInt(char *buffer, int value);
+// [ 6] int formatInt64(char *buffer, bsls::Types::Int64 value);
+// [ 6] int formatUint(char *buffer, unsigned int value);
+// [ 6] int formatUint64(char *buffer, bsls::Types::Uint64 value);
+// [ 6] void formatUintFixedWidth(char *, unsigned int, int);
+// [ 3] int formatShortest(char *buffer, double value);
+// [ 3] int formatShortest(char *buffer, float value);
+// [ 2] int generateShortestDigits(char *, int *, double);
+// [ 2] int generateShortestDigits(char *, int *, float);
+// [ 5] int parseDouble(double *result, const char *input, int length);
+// [ 7] int parseInt(int *result, const char *input, int length);
+// [ 7] int parseInt64(Int64 *result, const char *input, int length);
+// [ 7] int parseUint(unsigned int *, const char *, int);
+// [ 7] int parseUint64(Uint64 *result, const char *input, int length);
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE: NUMBERS PER SECOND
+// [-2] PERFORMANCE: INTEGERS PER SECOND
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlb::NumericTextUtil Util;
+typedef bsls::Types::Uint64   Uint64;
+
+#if defined(BSLS_PLATFORM_CMP_MSVC)
+#define snprintf _snprintf
+#define strtoll  _strtoi64
+#define strtoull _strtoui64
+#endif
+
+// ============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+Uint64 nextRandom(Uint64 *state)
+    // Advance the specified 'state' of a xorshift pseudo-random number
+    // generator and return the new value.
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+double randomDouble(Uint64 *state)
+    // Return a finite 'double' value derived from the next values of the
+    // pseudo-random generator having the specified 'state', alternating
+    // between arbitrary bit patterns and values typical of text documents.
+{
+    for (;;) {
+        const Uint64 r = nextRandom(state);
+
+        double value;
+        switch (r % 3) {
+          case 0: {
+            bsl::memcpy(&value, &r, sizeof value);
+          } break;
+          case 1: {
+            value = static_cast<double>(nextRandom(state) % 100000000)
+                                                                     / 1000.0;
+          } break;
+          default: {
+            value = static_cast<double>(nextRandom(state) % 2000000)
+                  / static_cast<double>(1 + nextRandom(state) % 10000) - 50.0;
+          } break;
+        }
+
+        if (value == value && value - value == 0) {
+            return value;                                             // RETURN
+        }
+    }
+}
+
+float randomFloat(Uint64 *state)
+    // Return a finite 'float' value having a bit pattern derived from the next
+    // value of the pseudo-random generator having the specified 'state'.
+{
+    for (;;) {
+        const unsigned int r = static_cast<unsigned int>(nextRandom(state));
+
+        float value;
+        bsl::memcpy(&value, &r, sizeof value);
+
+        if (value == value && value - value == 0) {
+            return value;                                             // RETURN
+        }
+    }
+}
+
+bool isSameDouble(double lhs, double rhs)
+    // Return 'true' if the specified 'lhs' and 'rhs' have the same bit
+    // pattern, and 'false' otherwise.
+{
+    return 0 == bsl::memcmp(&lhs, &rhs, sizeof lhs);
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int                 test = argc > 1 ? bsl::atoi(argv[1]) : 0;
+    bool             verbose = argc > 2;
+    bool         veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Round-Tripping a 'double' Through Text
+///-------------------------------------------------
+// Suppose we need to write a 'double' value as text, using as few characters
+// as possible, such that the value read back from the text is identical.
+//
+// First, we format the value:
+//..
+    const double value = 0.3;
+
+    char      buffer[bdlb::NumericTextUtil::k_SHORTEST_BUFFER_SIZE];
+    const int length = bdlb::NumericTextUtil::formatShortest(buffer, value);
+
+    ASSERT(3 == length);
+    ASSERT(0 == bsl::strcmp("0.3", buffer));
+//..
+// Note that 'printf' with the '%.17g' conversion, which also round-trips,
+// produces "0.29999999999999999".
+//
+// Then, we parse the text:
+//..
+    double    result;
+    const int rc = bdlb::NumericTextUtil::parseDouble(&result, buffer, length);
+
+    ASSERT(0 == rc);
+//..
+// Finally, we observe that we obtained the original value:
+//..
+    ASSERT(value == result);
+//..
+//
+///Example 2: Formatting and Parsing Integers
+///------------------------------------------
+// Suppose we need to write an integer field into a text record, and later
+// read it back, rejecting values that do not fit the field's type.
+//
+// First, we format the value into a buffer large enough for any 64-bit
+// integer; note that the text is not null-terminated:
+//..
+    char      text[bdlb::NumericTextUtil::k_MAX_INTEGER_LENGTH];
+    const int textLength = bdlb::NumericTextUtil::formatInt(text, -1234567);
+
+    ASSERT(8 == textLength);
+    ASSERT(0 == bsl::memcmp("-1234567", text, textLength));
+//..
+// Then, we parse the text back:
+//..
+    int number;
+    ASSERT(0 == bdlb::NumericTextUtil::parseInt(&number, text, textLength));
+    ASSERT(-1234567 == number);
+//..
+// Finally, we observe that text representing a value too large for an 'int'
+// is reported with a positive status, while text that is not an integer is
+// reported with a negative status, and that neither modifies the result:
+//..
+    ASSERT(0 <  bdlb::NumericTextUtil::parseInt(&number, "2147483648", 10));
+    ASSERT(0 >  bdlb::NumericTextUtil::parseInt(&number, "12a", 3));
+    ASSERT(-1234567 == number);
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // TESTING INTEGER PARSING
+        //
+        // Concerns:
+        //: 1 Every text matching '[+-]?D+' ('\+?D+' for the unsigned
+        //:   functions) and representing a value of the result type is
+        //:   accepted, including text with leading zeros, and the result is
+        //:   that value.
+        //:
+        //: 2 Text representing a value outside the range of the result type,
+        //:   however many digits it has, yields a positive status.
+        //:
+        //: 3 Text not matching the pattern, including a non-digit at any
+        //:   position of an eight-character group, yields a negative status.
+        //:
+        //: 4 'result' is modified only on success.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, parse boundary values and
+        //:   invalid text with each function, and verify the status and the
+        //:   result.  (C-1..4)
+        //:
+        //: 2 Format pseudo-random values of various magnitudes with 'printf',
+        //:   parse them back, and verify the result.  (C-1)
+        //:
+        //: 3 Replace each character of a long digit string in turn with a
+        //:   non-digit, and verify that parsing fails.  (C-3..4)
+        //
+        // Testing:
+        //   int parseInt(int *result, const char *input, int length);
+        //   int parseInt64(Int64 *result, const char *input, int length);
+        //   int parseUint(unsigned int *, const char *, int);
+        //   int parseUint64(Uint64 *result, const char *input, int length);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING INTEGER PARSING" << endl
+                          << "=======================" << endl;
+
+        typedef bsls::Types::Int64 Int64;
+
+        enum { k_OK = 0, k_RANGE = 1, k_SYNTAX = -1 };
+
+        static const struct {
+            int         d_line;    // source line number
+            const char *d_input;   // input text
+            int         d_int;     // expected 'parseInt' status
+            int         d_int64;   // expected 'parseInt64' status
+            int         d_uint;    // expected 'parseUint' status
+            int         d_uint64;  // expected 'parseUint64' status
+        } DATA[] = {
+            //LINE INPUT                        INT   INT64  UINT  UINT64
+            //---- ---------------------------  ----  -----  ----  ------
+            { L_,  "0",                           0,     0,    0,     0 },
+            { L_,  "-0",                          0,     0,   -1,    -1 },
+            { L_,  "+0",                          0,     0,    0,     0 },
+            { L_,  "7",                           0,     0,    0,     0 },
+            { L_,  "-7",                          0,     0,   -1,    -1 },
+            { L_,  "12345678",                    0,     0,    0,     0 },
+            { L_,  "123456789",                   0,     0,    0,     0 },
+            { L_,  "000000000000000000000000042", 0,     0,    0,     0 },
+            { L_,  "2147483647",                  0,     0,    0,     0 },
+            { L_,  "2147483648",                  1,     0,    0,     0 },
+            { L_,  "-2147483648",                 0,     0,   -1,    -1 },
+            { L_,  "-2147483649",                 1,     0,   -1,    -1 },
+            { L_,  "4294967295",                  1,     0,    0,     0 },
+            { L_,  "4294967296",                  1,     0,    1,     0 },
+            { L_,  "9223372036854775807",         1,     0,    1,     0 },
+            { L_,  "9223372036854775808",         1,     1,    1,     0 },
+            { L_,  "-9223372036854775808",        1,     0,   -1,    -1 },
+            { L_,  "-9223372036854775809",        1,     1,   -1,    -1 },
+            { L_,  "18446744073709551615",        1,     1,    1,     0 },
+            { L_,  "18446744073709551616",        1,     1,    1,     1 },
+            { L_,  "99999999999999999999",        1,     1,    1,     1 },
+            { L_,  "100000000000000000000000",    1,     1,    1,     1 },
+            { L_,  "",                           -1,    -1,   -1,    -1 },
+            { L_,  "-",                          -1,    -1,   -1,    -1 },
+            { L_,  "+",                          -1,    -1,   -1,    -1 },
+            { L_,  "--1",                        -1,    -1,   -1,    -1 },
+            { L_,  " 1",                         -1,    -1,   -1,    -1 },
+            { L_,  "1 ",                         -1,    -1,   -1,    -1 },
+            { L_,  "1.0",                        -1,    -1,   -1,    -1 },
+            { L_,  "1e3",                        -1,    -1,   -1,    -1 },
+            { L_,  "0x10",                       -1,    -1,   -1,    -1 },
+            { L_,  "1234567/",                   -1,    -1,   -1,    -1 },
+            { L_,  "1234567:",                   -1,    -1,   -1,    -1 },
+            { L_,  "99999999999999999999x",      -1,    -1,   -1,    -1 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE   = DATA[ti].d_line;
+            const char *const INPUT  = DATA[ti].d_input;
+            const int         LENGTH = static_cast<int>(bsl::strlen(INPUT));
+
+            if (veryVerbose) { T_ P_(LINE) P(INPUT) }
+
+            const Uint64 EXPECTED = strtoull(INPUT + ('-' == *INPUT), 0, 10);
+
+            int rc;
+
+            int intResult = 42;
+            rc = Util::parseInt(&intResult, INPUT, LENGTH);
+            ASSERTV(LINE, rc, DATA[ti].d_int == (rc > 0) - (rc < 0));
+            if (0 == rc) {
+                ASSERTV(LINE, intResult,
+                        ('-' == *INPUT ? 0 - EXPECTED : EXPECTED)
+                               == static_cast<Uint64>(static_cast<Int64>(
+                                                               intResult)));
+            }
+            else {
+                ASSERTV(LINE, 42 == intResult);
+            }
+
+            Int64 int64Result = 42;
+            rc = Util::parseInt64(&int64Result, INPUT, LENGTH);
+            ASSERTV(LINE, rc, DATA[ti].d_int64 == (rc > 0) - (rc < 0));
+            if (0 == rc) {
+                ASSERTV(LINE, int64Result,
+                        ('-' == *INPUT ? 0 - EXPECTED : EXPECTED)
+                                       == static_cast<Uint64>(int64Result));
+            }
+            else {
+                ASSERTV(LINE, 42 == int64Result);
+            }
+
+            unsigned int uintResult = 42;
+            rc = Util::parseUint(&uintResult, INPUT, LENGTH);
+            ASSERTV(LINE, rc, DATA[ti].d_uint == (rc > 0) - (rc < 0));
+            ASSERTV(LINE, uintResult, 0 == rc ? EXPECTED == uintResult
+                                              : 42 == uintResult);
+
+            Uint64 uint64Result = 42;
+            rc = Util::parseUint64(&uint64Result, INPUT, LENGTH);
+            ASSERTV(LINE, rc, DATA[ti].d_uint64 == (rc > 0) - (rc < 0));
+            ASSERTV(LINE, uint64Result, 0 == rc ? EXPECTED == uint64Result
+                                                : 42 == uint64Result);
+        }
+
+        if (verbose) cout << "\nPseudo-random values." << endl;
+        {
+            Uint64 state = 0x510E527FADE682D1ULL;
+
+            for (int i = 0; i < 100000; ++i) {
+                const Uint64 VALUE = nextRandom(&state)
+                                          >> (nextRandom(&state) % 64);
+
+                char      text[32];
+                const int length = snprintf(text,
+                                            sizeof text,
+                                            "%llu",
+                                            VALUE);
+
+                Uint64 uint64Result;
+                ASSERTV(text, 0 == Util::parseUint64(&uint64Result,
+                                                     text,
+                                                     length));
+                ASSERTV(text, VALUE == uint64Result);
+
+                const Int64 SIGNED = static_cast<Int64>(VALUE);
+
+                const int signedLength = snprintf(text,
+                                                  sizeof text,
+                                                  "%lld",
+                                                  SIGNED);
+
+                Int64 int64Result;
+                ASSERTV(text, 0 == Util::parseInt64(&int64Result,
+                                                    text,
+                                                    signedLength));
+                ASSERTV(text, SIGNED == int64Result);
+            }
+        }
+
+        if (verbose) cout << "\nNon-digit at each position." << endl;
+        {
+            const char DIGITS[] = "123456789012345678";
+            const int  LENGTH   = static_cast<int>(sizeof DIGITS - 1);
+            const char BAD[]    = { '/', ':', ' ', '.', 'a', '\0', '\x80' };
+
+            for (int position = 0; position < LENGTH; ++position) {
+                for (int bi = 0; bi < static_cast<int>(sizeof BAD); ++bi) {
+                    char text[sizeof DIGITS];
+                    bsl::memcpy(text, DIGITS, sizeof text);
+                    text[position] = BAD[bi];
+
+                    Int64 result = 42;
+                    ASSERTV(position, bi,
+                            0 > Util::parseInt64(&result, text, LENGTH));
+                    ASSERTV(position, bi, 42 == result);
+                }
+            }
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING INTEGER FORMATTING
+        //
+        // Concerns:
+        //: 1 The text written and the length returned are those of the '%d',
+        //:   '%lld', '%u', and '%llu' 'printf' conversions, for every number
+        //:   of digits and for the extreme values of each type.
+        //:
+        //: 2 No character beyond the returned length is written.
+        //:
+        //: 3 'formatUintFixedWidth' writes exactly the specified number of
+        //:   low-order digits, padding with zeros, for both even and odd
+        //:   widths, including 0.
+        //
+        // Plan:
+        //: 1 Format each power of ten, its predecessor, and the extreme
+        //:   values of each type, plus pseudo-random values of every
+        //:   magnitude, and compare the result with that of 'snprintf', into
+        //:   a buffer pre-filled with a sentinel.  (C-1..2)
+        //:
+        //: 2 Format values with 'formatUintFixedWidth' at every width in
+        //:   '[0 .. 10]' and compare with the trailing characters of the
+        //:   '%010u' conversion.  (C-3)
+        //
+        // Testing:
+        //   int formatInt(char *buffer, int value);
+        //   int formatInt64(char *buffer, bsls::Types::Int64 value);
+        //   int formatUint(char *buffer, unsigned int value);
+        //   int formatUint64(char *buffer, bsls::Types::Uint64 value);
+        //   void formatUintFixedWidth(char *, unsigned int, int);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING INTEGER FORMATTING" << endl
+                          << "==========================" << endl;
+
+        typedef bsls::Types::Int64 Int64;
+
+        bsl::vector<Uint64> values;
+        {
+            Uint64 power = 1;
+            for (int i = 0; i < 20; ++i) {
+                values.push_back(power);
+                values.push_back(power - 1);
+                values.push_back(0 - power);
+                values.push_back(0 - power + 1);
+                power *= 10;
+            }
+
+            values.push_back(0x7FFFFFFFULL);
+            values.push_back(0x80000000ULL);
+            values.push_back(0xFFFFFFFFULL);
+            values.push_back(0x100000000ULL);
+            values.push_back(0x7FFFFFFFFFFFFFFFULL);
+            values.push_back(0x8000000000000000ULL);
+            values.push_back(0xFFFFFFFFFFFFFFFFULL);
+
+            Uint64 state = 0x9B05688C2B3E6C1FULL;
+            for (int i = 0; i < 100000; ++i) {
+                values.push_back(nextRandom(&state)
+                                          >> (nextRandom(&state) % 64));
+            }
+        }
+
+        for (bsl::size_t i = 0; i < values.size(); ++i) {
+            const Uint64 VALUE = values[i];
+
+            if (veryVerbose && i < 100) { T_ P(VALUE) }
+
+            char expected[32];
+            char buffer[32];
+            int  expectedLength;
+            int  length;
+
+#define CHECK(FORMAT, FUNCTION, TYPE) {                                       \
+            expectedLength = snprintf(expected,                               \
+                                      sizeof expected,                        \
+                                      FORMAT,                                 \
+                                      static_cast<TYPE>(VALUE));              \
+            bsl::memset(buffer, 'X', sizeof buffer);                          \
+            length = Util::FUNCTION(buffer, static_cast<TYPE>(VALUE));        \
+            ASSERTV(VALUE, #FUNCTION, expectedLength, length,                 \
+                    expectedLength == length);                                \
+            ASSERTV(VALUE, #FUNCTION,                                         \
+                    0 == bsl::memcmp(expected, buffer, expectedLength));      \
+            ASSERTV(VALUE, #FUNCTION, 'X' == buffer[length]);                 \
+        }
+
+            CHECK("%d",   formatInt,    int);
+            CHECK("%u",   formatUint,   unsigned int);
+            CHECK("%lld", formatInt64,  Int64);
+            CHECK("%llu", formatUint64, Uint64);
+
+#undef CHECK
+        }
+
+        if (verbose) cout << "\nTesting 'formatUintFixedWidth'." << endl;
+
+        for (bsl::size_t i = 0; i < values.size(); i += 7) {
+            const unsigned int VALUE = static_cast<unsigned int>(values[i]);
+
+            char padded[16];
+            snprintf(padded, sizeof padded, "%010u", VALUE);
+
+            for (int width = 0; width <= 10; ++width) {
+                char buffer[16];
+                bsl::memset(buffer, 'X', sizeof buffer);
+
+                Util::formatUintFixedWidth(buffer, VALUE, width);
+
+                ASSERTV(VALUE, width,
+                        0 == bsl::memcmp(padded + 10 - width, buffer, width));
+                ASSERTV(VALUE, width, 'X' == buffer[width]);
+            }
+        }
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'parseDouble'
+        //
+        // Concerns:
+        //: 1 Every text matching the documented pattern is accepted, and the
+        //:   result is the 'double' nearest to the number, with ties broken
+        //:   in favor of the even significand, as obtained by 'strtod'.
+        //:
+        //: 2 Numbers halfway between adjacent 'double' values, numbers with
+        //:   more than 19 significant digits, and subnormal numbers are
+        //:   correctly rounded.
+        //:
+        //: 3 Numbers too large to represent yield an infinity, and non-zero
+        //:   numbers too small to represent yield a zero, of the appropriate
+        //:   sign, and a positive status.
+        //:
+        //: 4 Text not matching the pattern is rejected without modifying the
+        //:   result.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, parse boundary values and
+        //:   invalid text, and verify the status and the result.  (C-2..4)
+        //:
+        //: 2 Parse pseudo-random decimal texts, and texts holding the exact
+        //:   midpoints between pseudo-random adjacent 'double' values, and
+        //:   compare the results with those of 'strtod'.  (C-1..2)
+        //
+        // Testing:
+        //   int parseDouble(double *result, const char *input, int length);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'parseDouble'" << endl
+                          << "=====================" << endl;
+
+        static const struct {
+            int         d_line;      // source line number
+            const char *d_input;     // input text
+            int         d_status;    // expected status: 0, 1, or -1
+            const char *d_expected;  // text of expected value if 0 <= status
+        } DATA[] = {
+            //LINE INPUT                     STATUS  EXPECTED
+            //---- ------------------------- ------  -------------------------
+            { L_, "0",                        0,  "0"                       },
+            { L_, "-0",                       0,  "-0"                      },
+            { L_, "+0.000e99",                0,  "0"                       },
+            { L_, "1",                        0,  "1"                       },
+            { L_, "1.",                       0,  "1"                       },
+            { L_, ".5",                       0,  "0.5"                     },
+            { L_, "-.5e1",                    0,  "-5"                      },
+            { L_, "1E+2",                     0,  "100"                     },
+            { L_, "0.1",                      0,  "0.1"                     },
+            { L_, "12345678901234567890123",  0,  "1.2345678901234568e22"   },
+            { L_, "9007199254740993",         0,  "9007199254740992"        },
+            { L_, "9007199254740995",         0,  "9007199254740996"        },
+            { L_, "1.7976931348623157e308",   0,  "1.7976931348623157e308"  },
+            { L_, "2.2250738585072014e-308",  0,  "2.2250738585072014e-308" },
+            { L_, "2.2250738585072011e-308",  0,  "2.2250738585072009e-308" },
+            { L_, "4.9406564584124654e-324",  0,  "4.9406564584124654e-324" },
+            { L_, "2.4703282292062328e-324",  0,  "4.9406564584124654e-324" },
+            { L_, "1e-320",                   0,  "1e-320"                  },
+            { L_, "1.7976931348623159e308",   1,  "inf"                     },
+            { L_, "-1e400",                   1,  "-inf"                    },
+            { L_, "1e99999999999",            1,  "inf"                     },
+            { L_, "2.4703282292062327e-324",  1,  "0"                       },
+            { L_, "-1e-400",                  1,  "-0"                      },
+            { L_, "",                        -1,  ""                        },
+            { L_, "-",                       -1,  ""                        },
+            { L_, ".",                       -1,  ""                        },
+            { L_, "e5",                      -1,  ""                        },
+            { L_, "1e",                      -1,  ""                        },
+            { L_, "1e+",                     -1,  ""                        },
+            { L_, "1.5.",                    -1,  ""                        },
+            { L_, "--1",                     -1,  ""                        },
+            { L_, " 1",                      -1,  ""                        },
+            { L_, "1 ",                      -1,  ""                        },
+            { L_, "0x10",                    -1,  ""                        },
+            { L_, "inf",                     -1,  ""                        },
+            { L_, "nan",                     -1,  ""                        },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE   = DATA[ti].d_line;
+            const char *const INPUT  = DATA[ti].d_input;
+            const int         STATUS = DATA[ti].d_status;
+            const double      VALUE  = bsl::strtod(DATA[ti].d_expected, 0);
+
+            if (veryVerbose) { T_ P_(LINE) P(INPUT) }
+
+            double    result = 42.0;
+            const int rc     = Util::parseDouble(
+                                        &result,
+                                        INPUT,
+                                        static_cast<int>(bsl::strlen(INPUT)));
+
+            if (0 > STATUS) {
+                ASSERTV(LINE, rc, 0 > rc);
+                ASSERTV(LINE, result, 42.0 == result);
+            }
+            else {
+                ASSERTV(LINE, STATUS, rc, STATUS == rc);
+                ASSERTV(LINE, VALUE, result, isSameDouble(VALUE, result));
+            }
+        }
+
+        if (verbose) cout << "\nCompare with 'strtod'." << endl;
+        {
+            Uint64 state = 0x9E3779B97F4A7C15ULL;
+
+            for (int i = 0; i < 200000; ++i) {
+                // A text with up to 25 digits, an optional sign, decimal
+                // point, and exponent.
+
+                bsl::string text;
+                if (nextRandom(&state) & 1) {
+                    text += '-';
+                }
+
+                const int numDigits = 1 + static_cast<int>(
+                                                   nextRandom(&state) % 25);
+                const int point     = static_cast<int>(
+                                     nextRandom(&state) % (numDigits + 1));
+
+                for (int j = 0; j < numDigits; ++j) {
+                    if (j == point) {
+                        text += '.';
+                    }
+                    text += static_cast<char>('0' + nextRandom(&state) % 10);
+                }
+
+                if (nextRandom(&state) & 1) {
+                    char exponent[16];
+                    snprintf(exponent,
+                             sizeof exponent,
+                             "e%d",
+                             static_cast<int>(nextRandom(&state) % 700) - 350);
+                    text += exponent;
+                }
+
+                double    result;
+                const int rc = Util::parseDouble(
+                                          &result,
+                                          text.data(),
+                                          static_cast<int>(text.length()));
+
+                const double expected = bsl::strtod(text.c_str(), 0);
+
+                ASSERTV(text, 0 <= rc);
+                ASSERTV(text, expected, result,
+                        isSameDouble(expected, result));
+            }
+
+            if (bsl::numeric_limits<long double>::digits >= 64) {
+                // The exact midpoint between a value and its successor, which
+                // is representable as a 'long double' where that type has at
+                // least 64 significand bits, and rounds to the value having
+                // an even significand.
+
+                for (int i = 0; i < 50000; ++i) {
+                    Uint64 bits = nextRandom(&state) % 0x7FEFFFFFFFFFFFFFULL;
+                    double value;
+                    bsl::memcpy(&value, &bits, sizeof value);
+
+                    ++bits;
+                    double next;
+                    bsl::memcpy(&next, &bits, sizeof next);
+
+                    const long double midpoint =
+                                  (static_cast<long double>(value) + next) / 2;
+
+                    char      text[1024];
+                    const int length = snprintf(text,
+                                                sizeof text,
+                                                "%.780Le",
+                                                midpoint);
+
+                    double    result;
+                    const int rc = Util::parseDouble(&result, text, length);
+
+                    const double expected = bsl::strtod(text, 0);
+
+                    ASSERTV(value, 0 <= rc);
+                    ASSERTV(value, expected, result,
+                            isSameDouble(expected, result));
+                }
+            }
+        }
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'formatGeneral'
+        //
+        // Concerns:
+        //: 1 For every value and precision, the text written and the value
+        //:   returned are those of 'snprintf' with the '%.*g' conversion,
+        //:   including for zeros, subnormal values, the extreme finite
+        //:   values, infinities, and NaNs.
+        //:
+        //: 2 Values whose digits must be rounded up to the next power of ten
+        //:   at the requested precision are laid out correctly.
+        //:
+        //: 3 A buffer too short for the text receives the text truncated and
+        //:   null-terminated as by 'snprintf', and the value returned is the
+        //:   full length of the text.
+        //:
+        //: 4 A 'float' value is formatted as the same value converted to
+        //:   'double'.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, format boundary values at
+        //:   every precision in the range '[-1 .. 20]' and compare the result
+        //:   with that of 'snprintf'.  (C-1..2)
+        //:
+        //: 2 Format pseudo-random 'double' and 'float' values at every
+        //:   precision in the range '[0 .. 18]' and compare the result with
+        //:   that of 'snprintf'.  (C-1..2, 4)
+        //:
+        //: 3 Format values into buffers of every length from 0 to the length
+        //:   of the text, and compare the result with that of 'snprintf'.
+        //:   (C-3)
+        //
+        // Testing:
+        //   int formatGeneral(char *, int, double, int);
+        //   int formatGeneral(char *, int, float, int);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'formatGeneral'" << endl
+                          << "=======================" << endl;
+
+        const double INF = bsl::numeric_limits<double>::infinity();
+        const double QNAN = bsl::numeric_limits<double>::quiet_NaN();
+
+        const double DATA[] = {
+            0.0, -0.0, 1.0, -1.0, 0.1, 0.3, 0.5, 1.5, 2.5, 9.5, 10.0, 99.5,
+            123456.0, 999999.5, 1e15, 1e16, 1e17, 1e21, 1e22, 1e23, 1e-4,
+            9.9999e-5, 1e-5, 0.000123456789, 1.0 / 3, 2.0 / 3,
+            9.999999999999999e22, 5e-324, 2.2250738585072009e-308,
+            2.2250738585072014e-308, 1.7976931348623157e308, 4.35, 0.15,
+            0.25, 1.05, 123.456, INF, -INF, QNAN,
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        if (verbose) cout << "\nTable-driven values." << endl;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const double VALUE = DATA[ti];
+
+            for (int precision = -1; precision <= 20; ++precision) {
+                char      expected[64];
+                const int expectedLength = snprintf(expected,
+                                                    sizeof expected,
+                                                    "%.*g",
+                                                    precision,
+                                                    VALUE);
+
+                char      buffer[64];
+                const int length = Util::formatGeneral(buffer,
+                                                       sizeof buffer,
+                                                       VALUE,
+                                                       precision);
+
+                if (veryVerbose) { T_ P_(precision) P(buffer) }
+
+                ASSERTV(VALUE, precision, expectedLength, length,
+                        expectedLength == length);
+                ASSERTV(VALUE, precision, expected, buffer,
+                        0 == bsl::strcmp(expected, buffer));
+            }
+        }
+
+        if (verbose) cout << "\nPseudo-random values." << endl;
+        {
+            Uint64 state = 0x2545F4914F6CDD1DULL;
+
+            for (int i = 0; i < 20000; ++i) {
+                const double VALUE = randomDouble(&state);
+                const float  FVALUE = randomFloat(&state);
+
+                for (int precision = 0; precision <= 18; ++precision) {
+                    char expected[64];
+                    char buffer[64];
+
+                    snprintf(expected,
+                             sizeof expected,
+                             "%.*g",
+                             precision,
+                             VALUE);
+                    Util::formatGeneral(buffer,
+                                        sizeof buffer,
+                                        VALUE,
+                                        precision);
+
+                    ASSERTV(VALUE, precision, expected, buffer,
+                            0 == bsl::strcmp(expected, buffer));
+
+                    snprintf(expected,
+                             sizeof expected,
+                             "%.*g",
+                             precision,
+                             static_cast<double>(FVALUE));
+                    Util::formatGeneral(buffer,
+                                        sizeof buffer,
+                                        FVALUE,
+                                        precision);
+
+                    ASSERTV(FVALUE, precision, expected, buffer,
+                            0 == bsl::strcmp(expected, buffer));
+                }
+            }
+        }
+
+        if (verbose) cout << "\nTruncation." << endl;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const double VALUE = DATA[ti];
+
+            char      full[64];
+            const int fullLength = snprintf(full,
+                                            sizeof full,
+                                            "%.*g",
+                                            17,
+                                            VALUE);
+
+            for (int size = 0; size <= fullLength + 1; ++size) {
+                char expected[64];
+                char buffer[64];
+
+                bsl::memset(expected, 'X', sizeof expected);
+                bsl::memset(buffer,   'X', sizeof buffer);
+
+                snprintf(expected, size, "%.*g", 17, VALUE);
+                const int length = Util::formatGeneral(buffer,
+                                                       size,
+                                                       VALUE,
+                                                       17);
+
+                ASSERTV(VALUE, size, fullLength == length);
+                ASSERTV(VALUE, size,
+                        0 == bsl::memcmp(expected, buffer, sizeof buffer));
+            }
+        }
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'formatShortest'
+        //
+        // Concerns:
+        //: 1 The text is laid out as by 'printf' with the '%.17g' (for
+        //:   'double') or '%.9g' (for 'float') conversion, but with the
+        //:   digits produced by 'generateShortestDigits'.
+        //:
+        //: 2 The text converts back to exactly the formatted value.
+        //:
+        //: 3 The text is null-terminated, and the value returned is its
+        //:   length, which is less than 'k_SHORTEST_BUFFER_SIZE'.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, format boundary values and
+        //:   compare the result with the expected text.  (C-1, 3)
+        //:
+        //: 2 Format pseudo-random 'double' and 'float' values and verify
+        //:   that 'strtod' recovers the value from the text, and that the
+        //:   text matches that of 'printf' with the '%.*g' conversion at the
+        //:   precision equal to the number of digits produced by
+        //:   'generateShortestDigits'.  (C-1..3)
+        //
+        // Testing:
+        //   int formatShortest(char *buffer, double value);
+        //   int formatShortest(char *buffer, float value);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'formatShortest'" << endl
+                          << "========================" << endl;
+
+        static const struct {
+            int         d_line;      // source line number
+            double      d_value;     // value to format
+            const char *d_expected;  // expected text
+        } DATA[] = {
+            //LINE  VALUE                     EXPECTED
+            //----  ------------------------  -------------------------
+            { L_,   0.0,                      "0"                       },
+            { L_,   -0.0,                     "-0"                      },
+            { L_,   1.0,                      "1"                       },
+            { L_,   -1.5,                     "-1.5"                    },
+            { L_,   0.1,                      "0.1"                     },
+            { L_,   0.3,                      "0.3"                     },
+            { L_,   1.0 / 3,                  "0.3333333333333333"      },
+            { L_,   100.0,                    "100"                     },
+            { L_,   1e16,                     "10000000000000000"       },
+            { L_,   1e17,                     "1e+17"                   },
+            { L_,   123456789012345680.0,     "1.2345678901234568e+17"  },
+            { L_,   1e-4,                     "0.0001"                  },
+            { L_,   1e-5,                     "1e-05"                   },
+            { L_,   1.5e-5,                   "1.5e-05"                 },
+            { L_,   5e-324,                   "5e-324"                  },
+            { L_,   1.7976931348623157e308,   "1.7976931348623157e+308" },
+            { L_,   -2.2250738585072014e-308, "-2.2250738585072014e-308"},
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE     = DATA[ti].d_line;
+            const double      VALUE    = DATA[ti].d_value;
+            const char *const EXPECTED = DATA[ti].d_expected;
+
+            char      buffer[Util::k_SHORTEST_BUFFER_SIZE];
+            const int length = Util::formatShortest(buffer, VALUE);
+
+            if (veryVerbose) { T_ P_(LINE) P(buffer) }
+
+            ASSERTV(LINE, EXPECTED, buffer,
+                    0 == bsl::strcmp(EXPECTED, buffer));
+            ASSERTV(LINE, length,
+                    static_cast<int>(bsl::strlen(EXPECTED)) == length);
+        }
+
+        if (verbose) cout << "\nPseudo-random values." << endl;
+        {
+            Uint64 state = 0xD1B54A32D192ED03ULL;
+
+            for (int i = 0; i < 200000; ++i) {
+                const double VALUE  = randomDouble(&state);
+                const float  FVALUE = randomFloat(&state);
+
+                char digits[Util::k_MAX_DOUBLE_DIGITS];
+                int  exponent;
+                int  numDigits;
+                char expected[64];
+                char buffer[Util::k_SHORTEST_BUFFER_SIZE];
+                int  length;
+
+                numDigits = Util::generateShortestDigits(digits,
+                                                         &exponent,
+                                                         VALUE);
+                snprintf(expected, sizeof expected, "%.*g", numDigits, VALUE);
+                length = Util::formatShortest(buffer, VALUE);
+
+                ASSERTV(VALUE, length < Util::k_SHORTEST_BUFFER_SIZE);
+                ASSERTV(VALUE,
+                        static_cast<int>(bsl::strlen(buffer)) == length);
+                ASSERTV(VALUE, isSameDouble(VALUE, bsl::strtod(buffer, 0)));
+
+                // At precision 'numDigits', '%.*g' switches to scientific
+                // notation at a smaller exponent than '%.17g' does, so
+                // compare only where the two conversions agree on notation.
+                // Where the value lies exactly halfway between two decimal
+                // numbers having 'numDigits' digits, both of which round-trip,
+                // the digits may differ from those chosen by '%.*g'.
+
+                if (exponent < numDigits || exponent >= 17) {
+                    ASSERTV(VALUE, expected, buffer,
+                            0 == bsl::strcmp(expected, buffer)
+                         || (bsl::strlen(expected) == bsl::strlen(buffer)
+                          && isSameDouble(VALUE,
+                                          bsl::strtod(expected, 0))));
+                }
+
+                numDigits = Util::generateShortestDigits(digits,
+                                                         &exponent,
+                                                         FVALUE);
+                length = Util::formatShortest(buffer, FVALUE);
+
+                ASSERTV(FVALUE, length < Util::k_SHORTEST_BUFFER_SIZE);
+                ASSERTV(FVALUE,
+                        static_cast<int>(bsl::strlen(buffer)) == length);
+                ASSERTV(FVALUE, buffer,
+                        FVALUE == static_cast<float>(bsl::strtod(buffer, 0)));
+            }
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING 'generateShortestDigits'
+        //
+        // Concerns:
+        //: 1 The digits and exponent represent a decimal number that rounds
+        //:   to the magnitude of the value.
+        //:
+        //: 2 There are no trailing zeros, and at most 'k_MAX_DOUBLE_DIGITS'
+        //:   (respectively 'k_MAX_FLOAT_DIGITS') digits.
+        //:
+        //: 3 The digits are the shortest ones for values whose shortest
+        //:   representation is known, including zero, the extreme finite
+        //:   values, and powers of ten.
+        //:
+        //: 4 The sign of the value is ignored.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, generate the digits of values
+        //:   with known shortest representations.  (C-3..4)
+        //:
+        //: 2 Generate the digits of pseudo-random 'double' and 'float'
+        //:   values, and verify that 'strtod' recovers the magnitude of the
+        //:   value from them, that they have no trailing zeros, and that the
+        //:   number of digits is within bounds.  (C-1..2)
+        //
+        // Testing:
+        //   int generateShortestDigits(char *, int *, double);
+        //   int generateShortestDigits(char *, int *, float);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'generateShortestDigits'" << endl
+                          << "================================" << endl;
+
+        static const struct {
+            int         d_line;      // source line number
+            double      d_value;     // value
+            const char *d_digits;    // expected digits
+            int         d_exponent;  // expected exponent
+        } DATA[] = {
+            //LINE  VALUE                     DIGITS                EXP
+            //----  ------------------------  -------------------   ----
+            { L_,   0.0,                      "0",                     0 },
+            { L_,   -0.0,                     "0",                     0 },
+            { L_,   1.0,                      "1",                     0 },
+            { L_,   -7.0,                     "7",                     0 },
+            { L_,   0.1,                      "1",                    -1 },
+            { L_,   123.25,                   "12325",                 2 },
+            { L_,   1e22,                     "1",                    22 },
+            { L_,   1e-300,                   "1",                  -300 },
+            { L_,   5e-324,                   "5",                  -324 },
+            { L_,   1.7976931348623157e308,   "17976931348623157",   308 },
+            { L_,   2.2250738585072014e-308,  "22250738585072014",  -308 },
+            { L_,   9007199254740993.0,       "9007199254740992",     15 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int         LINE     = DATA[ti].d_line;
+            const double      VALUE    = DATA[ti].d_value;
+            const char *const DIGITS   = DATA[ti].d_digits;
+            const int         EXPONENT = DATA[ti].d_exponent;
+
+            char      digits[Util::k_MAX_DOUBLE_DIGITS];
+            int       exponent  = -9999;
+            const int numDigits = Util::generateShortestDigits(digits,
+                                                               &exponent,
+                                                               VALUE);
+
+            const bsl::string result(digits, numDigits);
+
+            if (veryVerbose) { T_ P_(LINE) P_(result) P(exponent) }
+
+            ASSERTV(LINE, DIGITS, result, DIGITS == result);
+            ASSERTV(LINE, EXPONENT, exponent, EXPONENT == exponent);
+        }
+
+        if (verbose) cout << "\nPseudo-random values." << endl;
+        {
+            Uint64 state = 0x6A09E667F3BCC909ULL;
+
+            for (int i = 0; i < 200000; ++i) {
+                const double VALUE  = randomDouble(&state);
+                const float  FVALUE = randomFloat(&state);
+
+                char digits[Util::k_MAX_DOUBLE_DIGITS];
+                int  exponent;
+                char text[64];
+                int  numDigits;
+
+                numDigits = Util::generateShortestDigits(digits,
+                                                         &exponent,
+                                                         VALUE);
+
+                ASSERTV(VALUE, numDigits,
+                        1 <= numDigits
+                     && numDigits <= Util::k_MAX_DOUBLE_DIGITS);
+                ASSERTV(VALUE, '0' != digits[numDigits - 1] || 0 == VALUE);
+
+                snprintf(text,
+                         sizeof text,
+                         "0.%.*se%d",
+                         numDigits,
+                         digits,
+                         exponent + 1);
+
+                ASSERTV(VALUE, text,
+                        bsl::strtod(text, 0) == (VALUE < 0 ? -VALUE : VALUE));
+
+                numDigits = Util::generateShortestDigits(digits,
+                                                         &exponent,
+                                                         FVALUE);
+
+                ASSERTV(FVALUE, numDigits,
+                        1 <= numDigits
+                     && numDigits <= Util::k_MAX_FLOAT_DIGITS);
+                ASSERTV(FVALUE, '0' != digits[numDigits - 1] || 0 == FVALUE);
+
+                snprintf(text,
+                         sizeof text,
+                         "0.%.*se%d",
+                         numDigits,
+                         digits,
+                         exponent + 1);
+
+                ASSERTV(FVALUE, text,
+                        static_cast<float>(bsl::strtod(text, 0))
+                                         == (FVALUE < 0 ? -FVALUE : FVALUE));
+            }
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Format and parse a few values.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        char buffer[64];
+
+        ASSERT(3 == Util::formatShortest(buffer, 1.5));
+        ASSERT(0 == bsl::strcmp("1.5", buffer));
+
+        ASSERT(19 == Util::formatGeneral(buffer, sizeof buffer, 0.1, 17));
+        ASSERT(0 == bsl::strcmp("0.10000000000000001", buffer));
+
+        ASSERT(6 == Util::formatGeneral(buffer, sizeof buffer, 1e100, 6));
+        ASSERT(0 == bsl::strcmp("1e+100", buffer));
+
+        double result = 0;
+        ASSERT(0 == Util::parseDouble(&result, "-2.5e-1", 7));
+        ASSERT(-0.25 == result);
+
+        ASSERT(0 != Util::parseDouble(&result, "abc", 3));
+        ASSERT(-0.25 == result);
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: NUMBERS PER SECOND
+        //
+        // Concerns:
+        //: 1 'formatGeneral' and 'formatShortest' convert values to text
+        //:   faster than 'snprintf', and 'parseDouble' converts text to
+        //:   values faster than 'strtod'.
+        //
+        // Plan:
+        //: 1 Convert a vector of pseudo-random values, typical of text
+        //:   documents, to text and back using each of the functions, and
+        //:   report the number of values converted per second.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: NUMBERS PER SECOND
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: NUMBERS PER SECOND" << endl
+                          << "===============================" << endl;
+
+        const int NUM_VALUES = 1000000;
+
+        bsl::vector<double> values(NUM_VALUES);
+        {
+            Uint64 state = 0xBB67AE8584CAA73BULL;
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                values[i] = randomDouble(&state);
+            }
+        }
+
+        bsl::vector<char> text(NUM_VALUES * 32);
+        bsl::vector<int>  lengths(NUM_VALUES);
+
+        bsls::Stopwatch timer;
+        int             numMismatches = 0;
+
+#define REPORT(NAME) {                                                        \
+            const double seconds = timer.elapsedTime();                       \
+            cout << NAME << ": " << NUM_VALUES / seconds                      \
+                 << " numbers/sec" << endl;                                   \
+        }
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            lengths[i] = snprintf(&text[i * 32], 32, "%.17g", values[i]);
+        }
+        timer.stop();
+        REPORT("snprintf(\"%.17g\")    ");
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            lengths[i] = Util::formatGeneral(&text[i * 32], 32, values[i], 17);
+        }
+        timer.stop();
+        REPORT("formatGeneral(17)     ");
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            lengths[i] = snprintf(&text[i * 32], 32, "%.15g", values[i]);
+        }
+        timer.stop();
+        REPORT("snprintf(\"%.15g\")    ");
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            lengths[i] = Util::formatGeneral(&text[i * 32], 32, values[i], 15);
+        }
+        timer.stop();
+        REPORT("formatGeneral(15)     ");
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            lengths[i] = Util::formatShortest(&text[i * 32], values[i]);
+        }
+        timer.stop();
+        REPORT("formatShortest        ");
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            numMismatches += bsl::strtod(&text[i * 32], 0) != values[i];
+        }
+        timer.stop();
+        REPORT("strtod                ");
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            double result;
+            Util::parseDouble(&result, &text[i * 32], lengths[i]);
+            numMismatches += result != values[i];
+        }
+        timer.stop();
+        REPORT("parseDouble           ");
+
+#undef REPORT
+
+        ASSERTV(numMismatches, 0 == numMismatches);
+      } break;
+      case -2: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: INTEGERS PER SECOND
+        //
+        // Concerns:
+        //: 1 The integer formatting and parsing functions are faster than
+        //:   'snprintf' and 'strtoll'.
+        //
+        // Plan:
+        //: 1 Convert a vector of pseudo-random 64-bit integers of every
+        //:   magnitude to text and back using each of the functions, and
+        //:   report the number of values converted per second.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: INTEGERS PER SECOND
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: INTEGERS PER SECOND" << endl
+                          << "================================" << endl;
+
+        typedef bsls::Types::Int64 Int64;
+
+        const int NUM_VALUES = 1000000;
+
+        bsl::vector<Int64> values(NUM_VALUES);
+        {
+            Uint64 state = 0x1F83D9ABFB41BD6BULL;
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                values[i] = static_cast<Int64>(nextRandom(&state))
+                                          >> (nextRandom(&state) % 64);
+            }
+        }
+
+        bsl::vector<char> text(NUM_VALUES * 32);
+        bsl::vector<int>  lengths(NUM_VALUES);
+
+        bsls::Stopwatch timer;
+        int             numMismatches = 0;
+
+#define REPORT(NAME) {                                                        \
+            const double seconds = timer.elapsedTime();                       \
+            cout << NAME << ": " << NUM_VALUES / seconds                      \
+                 << " integers/sec" << endl;                                  \
+        }
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            lengths[i] = snprintf(&text[i * 32], 32, "%lld", values[i]);
+        }
+        timer.stop();
+        REPORT("snprintf(\"%lld\")");
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            lengths[i] = Util::formatInt64(&text[i * 32], values[i]);
+            text[i * 32 + lengths[i]] = '\0';
+        }
+        timer.stop();
+        REPORT("formatInt64     ");
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            numMismatches += strtoll(&text[i * 32], 0, 10) != values[i];
+        }
+        timer.stop();
+        REPORT("strtoll         ");
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_VALUES; ++i) {
+            Int64 result;
+            Util::parseInt64(&result, &text[i * 32], lengths[i]);
+            numMismatches += result != values[i];
+        }
+        timer.stop();
+        REPORT("parseInt64      ");
+
+#undef REPORT
+
+        ASSERTV(numMismatches, 0 == numMismatches);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
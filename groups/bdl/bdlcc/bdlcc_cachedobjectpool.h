@@ -0,0 +1,654 @@
+// bdlcc_cachedobjectpool.h                                           -*-C++-*-
+#ifndef INCLUDED_BDLCC_CACHEDOBJECTPOOL
+#define INCLUDED_BDLCC_CACHEDOBJECTPOOL
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a thread-safe object pool with per-thread caches.
+//
+//@CLASSES:
+//  bdlcc::CachedObjectPool: object pool caching objects for each thread
+//
+//@SEE_ALSO: bdlcc_objectpool, bdlma_threadcachingallocator
+//
+//@DESCRIPTION: This component provides a generic thread-safe pool of objects,
+// 'bdlcc::CachedObjectPool', having the same interface and the same creator
+// and resetter contract as 'bdlcc::ObjectPool' (see {'bdlcc_objectpool'}),
+// that keeps a cache of free objects private to each thread using it.  Most
+// calls to 'getObject' and 'releaseObject' only access the cache of the
+// calling thread, and thus are not subject to the contention on the head of
+// the shared free list that limits the throughput of a 'bdlcc::ObjectPool'
+// used by many threads at once.
+//
+///Per-Thread Caches
+///-----------------
+// The cache of each thread holds up to 'maxCachedObjects()' free objects,
+// which is specified at construction.  'getObject' returns the most recently
+// cached object of the calling thread; when the cache is empty, it is filled
+// with a batch of 'batchSize()' objects (half of 'maxCachedObjects()')
+// obtained from a shared 'bdlcc::ObjectPool' (which creates objects as
+// needed).  'releaseObject' invokes the resetter on the object and adds it to
+// the cache of the calling thread; when the cache is full, the batch of the
+// least recently cached objects is first returned to the shared pool, which
+// adds them to its free list with a single atomic operation.  The shared pool
+// is thus accessed at most once for every 'batchSize()' requests of a thread.
+//
+// An object may be released by a thread other than the one that obtained it;
+// it is then added to the cache of the releasing thread.  A thread that has
+// never obtained an object from the pool has no cache, and returns the
+// objects it releases directly to the shared pool.  When a thread having a
+// cache exits, the objects in its cache are returned to the shared pool.
+// 'flushCache' returns the objects cached by the calling thread to the shared
+// pool at any time.  If 'maxCachedObjects()' is 0, no thread has a cache, and
+// the pool behaves as a 'bdlcc::ObjectPool'.
+//
+// Note that the objects cached by a thread are not available to other
+// threads: 'numAvailableObjects' reports only the objects available in the
+// shared pool, and the pool may create up to 'maxCachedObjects()' more
+// objects for each thread using it than a 'bdlcc::ObjectPool' would.  Also
+// note that the caches of all pools are found through a single
+// thread-specific storage key (see 'bdlma_threadcacheregistry'), so that the
+// number of pools is not bounded by the number of keys available to a process.
+//
+///Thread Safety
+///-------------
+// 'bdlcc::CachedObjectPool' is *fully thread-safe*, meaning any operation on
+// the same object can be safely invoked from any thread.  The behavior is
+// undefined if the pool is destroyed while any other thread is using it.  A
+// pool may be destroyed while threads that have used it exit.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Pooling Message Objects
+/// - - - - - - - - - - - - - - - - -
+// Suppose that the threads of a messaging system each decode many messages
+// into short-lived 'Message' objects.  Each 'Message' holds a string, whose
+// capacity we want to keep for the next message that reuses the object.
+//
+// First, we define the 'Message' class, which uses an allocator, and provides
+// a 'reset' method restoring the default state of a message:
+//..
+//  class Message {
+//      // This class holds the topic and payload of a message.
+//
+//      // DATA
+//      int         d_topic;    // topic of the message
+//      bsl::string d_payload;  // payload of the message
+//
+//    public:
+//      // TRAITS
+//      BSLMF_NESTED_TRAIT_DECLARATION(Message, bslma::UsesBslmaAllocator);
+//
+//      // CREATORS
+//      explicit Message(bslma::Allocator *basicAllocator = 0)
+//      : d_topic(0)
+//      , d_payload(basicAllocator)
+//      {
+//      }
+//
+//      // MANIPULATORS
+//      void decode(int topic, const char *payload)
+//      {
+//          d_topic = topic;
+//          d_payload.assign(payload);
+//      }
+//
+//      void reset()
+//      {
+//          d_topic = 0;
+//          d_payload.clear();
+//      }
+//
+//      // ACCESSORS
+//      const bsl::string& payload() const
+//      {
+//          return d_payload;
+//      }
+//  };
+//..
+// Then, we define the type of the pool, which resets the messages returned to
+// it:
+//..
+//  typedef bdlcc::CachedObjectPool<
+//                           Message,
+//                           bdlcc::ObjectPoolFunctors::DefaultCreator,
+//                           bdlcc::ObjectPoolFunctors::Reset<Message> > Pool;
+//..
+// Next, we define a function decoding a number of messages using objects
+// obtained from a pool, as done by each thread of the system:
+//..
+//  bsl::size_t decodeMessages(Pool *pool, int numMessages)
+//      // Decode the specified 'numMessages' messages using objects obtained
+//      // from the specified 'pool', and return the total length of their
+//      // payloads.
+//  {
+//      bsl::size_t length = 0;
+//
+//      for (int i = 0; i < numMessages; ++i) {
+//          Message *message = pool->getObject();
+//
+//          message->decode(i, "a payload too long for the short buffer");
+//          length += message->payload().length();
+//
+//          pool->releaseObject(message);
+//      }
+//      return length;
+//  }
+//..
+// Now, we create a pool caching up to 16 messages for each thread, whose
+// shared pool creates 8 messages at a time, and decode a few messages:
+//..
+//  Pool pool(16, 8);
+//
+//  assert(16 == pool.maxCachedObjects());
+//  assert( 8 == pool.batchSize());
+//
+//  assert(390 == decodeMessages(&pool, 10));
+//..
+// Finally, we observe that the first message requested from the pool
+// obtained a batch of 8 messages from the shared pool, one of which is reused
+// for all messages, and all of which are held by the cache of this thread:
+//..
+//  assert(8 == pool.numObjects());
+//  assert(8 == pool.numCachedObjects());
+//  assert(0 == pool.numAvailableObjects());
+//
+//  pool.flushCache();
+//
+//  assert(0 == pool.numCachedObjects());
+//  assert(8 == pool.numAvailableObjects());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLCC_OBJECTPOOL
+#include <bdlcc_objectpool.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_FACTORY
+#include <bdlma_factory.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_THREADCACHEREGISTRY
+#include <bdlma_threadcacheregistry.h>
+#endif
+
+#ifndef INCLUDED_BSLALG_CONSTRUCTORPROXY
+#include <bslalg_constructorproxy.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlcc {
+
+                          // ======================
+                          // class CachedObjectPool
+                          // ======================
+
+template <class TYPE,
+          class CREATOR  = ObjectPoolFunctors::DefaultCreator,
+          class RESETTER = ObjectPoolFunctors::Nil<TYPE> >
+class CachedObjectPool : public bdlma::Factory<TYPE> {
+    // This class provides a thread-safe pool of reusable objects, keeping a
+    // cache of free objects for each thread using it.  It also implements the
+    // 'bdlma::Factory' protocol: "creating" objects gets them from the pool
+    // and "deleting" objects returns them to the pool.
+
+    // PRIVATE TYPES
+    typedef ObjectPool<TYPE, CREATOR, ObjectPoolFunctors::Nil<TYPE> >
+                                                                    SharedPool;
+        // The shared pool does not reset objects, as they are reset when
+        // released to this pool.
+
+    struct Cache {
+        // This 'struct' holds the objects cached by one thread.  It is
+        // followed in memory by an array of 'maxCachedObjects()' object
+        // addresses.
+
+        TYPE **d_objects_p;   // cached objects, oldest first
+        int    d_numObjects;  // number of cached objects
+    };
+
+    // DATA
+    SharedPool                          d_pool;              // shared pool
+
+    bslalg::ConstructorProxy<RESETTER>  d_objectResetter;    // functor to
+                                                             // reset object
+
+    const int                           d_maxCachedObjects;  // capacity of
+                                                             // each cache
+
+    const int                           d_batchSize;         // number of
+                                                             // objects
+                                                             // transferred at
+                                                             // once
+
+    bdlma::ThreadCacheRegistry          d_caches;            // cache of each
+                                                             // thread
+
+    // PRIVATE CLASS METHODS
+    static void releaseCache(void *cache, void *pool);
+        // Return the objects held by the specified 'cache' to the shared pool
+        // of the specified 'pool'.  Note that this method is called on exit
+        // of each thread having a cache.
+
+    // PRIVATE MANIPULATORS
+    Cache *localCache();
+        // Return the address of the cache of the calling thread, creating it
+        // if it does not exist.
+
+  private:
+    // NOT IMPLEMENTED
+    CachedObjectPool(const CachedObjectPool&);
+    CachedObjectPool& operator=(const CachedObjectPool&);
+
+  public:
+    // TYPES
+    typedef RESETTER ResetterType;
+    typedef CREATOR  CreatorType;
+
+    enum {
+        k_DEFAULT_MAX_CACHED_OBJECTS = 32  // default capacity of each cache
+    };
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(CachedObjectPool,
+                                   bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    CachedObjectPool(bslma::Allocator *basicAllocator = 0);
+    explicit
+    CachedObjectPool(int               maxCachedObjects,
+                     int               growBy = -1,
+                     bslma::Allocator *basicAllocator = 0);
+        // Create an object pool that invokes the default value of 'CREATOR'
+        // to construct objects, and the default value of 'RESETTER' to
+        // restore the objects returned to the pool to a reusable state.
+        // Optionally specify 'maxCachedObjects', the maximum number of free
+        // objects cached by each thread; if 'maxCachedObjects' is not
+        // specified, 'k_DEFAULT_MAX_CACHED_OBJECTS' is used.  Optionally
+        // specify a 'growBy' value indicating how the shared pool increases
+        // its capacity when it is depleted (see 'bdlcc::ObjectPool').
+        // Optionally specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '0 <= maxCachedObjects' and
+        // '0 != growBy'.
+
+    CachedObjectPool(const CREATOR&    objectCreator,
+                     const RESETTER&   objectResetter,
+                     int               maxCachedObjects =
+                                                  k_DEFAULT_MAX_CACHED_OBJECTS,
+                     int               growBy = -1,
+                     bslma::Allocator *basicAllocator = 0);
+        // Create an object pool that uses the specified 'objectCreator' to
+        // construct objects, and the specified 'objectResetter' to restore
+        // the objects returned to the pool to a reusable state.  Optionally
+        // specify 'maxCachedObjects', the maximum number of free objects
+        // cached by each thread; if 'maxCachedObjects' is not specified,
+        // 'k_DEFAULT_MAX_CACHED_OBJECTS' is used.  Optionally specify a
+        // 'growBy' value indicating how the shared pool increases its
+        // capacity when it is depleted (see 'bdlcc::ObjectPool').  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '0 <= maxCachedObjects' and
+        // '0 != growBy'.
+
+    virtual ~CachedObjectPool();
+        // Destroy this object pool.  All objects created by this pool are
+        // destroyed (even if some of them are still in use) and memory is
+        // reclaimed.
+
+    // MANIPULATORS
+    void flushCache();
+        // Return the objects cached by the calling thread to the shared pool,
+        // making them available to other threads.
+
+    TYPE *getObject();
+        // Return an address of modifiable object from this object pool, taken
+        // from the cache of the calling thread.  If the cache is empty, it is
+        // first filled with 'batchSize()' objects from the shared pool, which
+        // is replenished if needed.
+
+    void increaseCapacity(int numObjects);
+        // Create the specified 'numObjects' objects and add them to the shared
+        // pool.  The behavior is undefined unless '0 <= numObjects'.
+
+    void releaseObject(TYPE *object);
+        // Return the specified 'object' back to this object pool, invoking the
+        // resetter on it and adding it to the cache of the calling thread (or
+        // to the shared pool if the calling thread has no cache).  If the
+        // cache is full, the 'batchSize()' least recently cached objects are
+        // first returned to the shared pool.  The behavior is undefined
+        // unless 'object' was obtained from this object pool.
+
+    void reserveCapacity(int numObjects);
+        // Create enough objects to satisfy requests for at least the specified
+        // 'numObjects' objects before the next replenishment of the shared
+        // pool.  The behavior is undefined unless '0 <= numObjects'.
+
+    // ACCESSORS
+    int batchSize() const;
+        // Return the number of objects transferred at once between the cache
+        // of a thread and the shared pool.
+
+    int maxCachedObjects() const;
+        // Return the maximum number of free objects cached by each thread.
+
+    int numAvailableObjects() const;
+        // Return a *snapshot* of the number of objects available in the
+        // shared pool.  Note that the objects cached by threads are not
+        // included.
+
+    int numCachedObjects() const;
+        // Return the number of free objects cached by the calling thread.
+
+    int numObjects() const;
+        // Return the (instantaneous) number of objects managed by this pool,
+        // whether available in the shared pool, cached by any thread, or in
+        // use.
+
+    // 'bdlma::Factory' INTERFACE
+    virtual TYPE *createObject();
+        // This concrete implementation of 'bdlma::Factory::createObject'
+        // invokes 'getObject'.  This should not be invoked directly.
+
+    virtual void deleteObject(TYPE *object);
+        // This concrete implementation of 'bdlma::Factory::deleteObject'
+        // invokes 'releaseObject' on the specified 'object', returning it to
+        // this pool.  Note that this does *not* destroy the object and should
+        // not be invoked directly.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                          // ----------------------
+                          // class CachedObjectPool
+                          // ----------------------
+
+// PRIVATE CLASS METHODS
+template <class TYPE, class CREATOR, class RESETTER>
+void CachedObjectPool<TYPE, CREATOR, RESETTER>::releaseCache(void *cache,
+                                                             void *pool)
+{
+    Cache *c = static_cast<Cache *>(cache);
+
+    static_cast<CachedObjectPool *>(pool)->d_pool.releaseObjects(
+                                                             c->d_objects_p,
+                                                             c->d_numObjects);
+}
+
+// PRIVATE MANIPULATORS
+template <class TYPE, class CREATOR, class RESETTER>
+typename CachedObjectPool<TYPE, CREATOR, RESETTER>::Cache *
+CachedObjectPool<TYPE, CREATOR, RESETTER>::localCache()
+{
+    Cache *cache = static_cast<Cache *>(d_caches.localCache());
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(cache)) {
+        return cache;                                                 // RETURN
+    }
+
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+    cache = static_cast<Cache *>(d_caches.allocateCache());
+
+    cache->d_objects_p  = reinterpret_cast<TYPE **>(cache + 1);
+    cache->d_numObjects = 0;
+
+    d_caches.registerCache(cache);
+
+    return cache;
+}
+
+// CREATORS
+template <class TYPE, class CREATOR, class RESETTER>
+CachedObjectPool<TYPE, CREATOR, RESETTER>::CachedObjectPool(
+                                              bslma::Allocator *basicAllocator)
+: d_pool(-1, basicAllocator)
+, d_objectResetter(basicAllocator)
+, d_maxCachedObjects(k_DEFAULT_MAX_CACHED_OBJECTS)
+, d_batchSize(k_DEFAULT_MAX_CACHED_OBJECTS / 2)
+, d_caches(sizeof(Cache) + d_maxCachedObjects * sizeof(TYPE *),
+           &CachedObjectPool::releaseCache,
+           this,
+           basicAllocator)
+{
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+CachedObjectPool<TYPE, CREATOR, RESETTER>::CachedObjectPool(
+                                            int               maxCachedObjects,
+                                            int               growBy,
+                                            bslma::Allocator *basicAllocator)
+: d_pool(growBy, basicAllocator)
+, d_objectResetter(basicAllocator)
+, d_maxCachedObjects(maxCachedObjects)
+, d_batchSize(maxCachedObjects > 1 ? maxCachedObjects / 2 : 1)
+, d_caches(sizeof(Cache) + d_maxCachedObjects * sizeof(TYPE *),
+           &CachedObjectPool::releaseCache,
+           this,
+           basicAllocator)
+{
+    BSLS_ASSERT(0 <= maxCachedObjects);
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+CachedObjectPool<TYPE, CREATOR, RESETTER>::CachedObjectPool(
+                                            const CREATOR&    objectCreator,
+                                            const RESETTER&   objectResetter,
+                                            int               maxCachedObjects,
+                                            int               growBy,
+                                            bslma::Allocator *basicAllocator)
+: d_pool(objectCreator, growBy, basicAllocator)
+, d_objectResetter(objectResetter, basicAllocator)
+, d_maxCachedObjects(maxCachedObjects)
+, d_batchSize(maxCachedObjects > 1 ? maxCachedObjects / 2 : 1)
+, d_caches(sizeof(Cache) + d_maxCachedObjects * sizeof(TYPE *),
+           &CachedObjectPool::releaseCache,
+           this,
+           basicAllocator)
+{
+    BSLS_ASSERT(0 <= maxCachedObjects);
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+CachedObjectPool<TYPE, CREATOR, RESETTER>::~CachedObjectPool()
+{
+    // The objects cached by all threads are returned to the shared pool,
+    // which destroys them.
+
+    d_caches.releaseCaches();
+}
+
+// MANIPULATORS
+template <class TYPE, class CREATOR, class RESETTER>
+void CachedObjectPool<TYPE, CREATOR, RESETTER>::flushCache()
+{
+    Cache *cache = static_cast<Cache *>(d_caches.localCache());
+
+    if (cache) {
+        d_pool.releaseObjects(cache->d_objects_p, cache->d_numObjects);
+        cache->d_numObjects = 0;
+    }
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+TYPE *CachedObjectPool<TYPE, CREATOR, RESETTER>::getObject()
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == d_maxCachedObjects)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return d_pool.getObject();                                    // RETURN
+    }
+
+    Cache *cache = localCache();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(cache->d_numObjects)) {
+        return cache->d_objects_p[--cache->d_numObjects];             // RETURN
+    }
+
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+    d_pool.getObjects(cache->d_objects_p, d_batchSize);
+    cache->d_numObjects = d_batchSize - 1;
+
+    return cache->d_objects_p[d_batchSize - 1];
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+void CachedObjectPool<TYPE, CREATOR, RESETTER>::increaseCapacity(
+                                                                int numObjects)
+{
+    d_pool.increaseCapacity(numObjects);
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+void CachedObjectPool<TYPE, CREATOR, RESETTER>::releaseObject(TYPE *object)
+{
+    BSLS_ASSERT(object);
+
+    d_objectResetter.object()(object);
+
+    // Note that a cache is not created here, so that this method does not
+    // allocate memory.
+
+    Cache *cache = static_cast<Cache *>(d_caches.localCache());
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!cache)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        d_pool.releaseObject(object);
+        return;                                                       // RETURN
+    }
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                cache->d_numObjects == d_maxCachedObjects)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // Return the least recently cached objects to the shared pool, and
+        // move the others to the front of the cache.
+
+        d_pool.releaseObjects(cache->d_objects_p, d_batchSize);
+
+        cache->d_numObjects -= d_batchSize;
+        for (int i = 0; i < cache->d_numObjects; ++i) {
+            cache->d_objects_p[i] = cache->d_objects_p[i + d_batchSize];
+        }
+    }
+
+    cache->d_objects_p[cache->d_numObjects++] = object;
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+void CachedObjectPool<TYPE, CREATOR, RESETTER>::reserveCapacity(
+                                                                int numObjects)
+{
+    d_pool.reserveCapacity(numObjects);
+}
+
+// ACCESSORS
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+int CachedObjectPool<TYPE, CREATOR, RESETTER>::batchSize() const
+{
+    return d_batchSize;
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+int CachedObjectPool<TYPE, CREATOR, RESETTER>::maxCachedObjects() const
+{
+    return d_maxCachedObjects;
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+int CachedObjectPool<TYPE, CREATOR, RESETTER>::numAvailableObjects() const
+{
+    return d_pool.numAvailableObjects();
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+int CachedObjectPool<TYPE, CREATOR, RESETTER>::numCachedObjects() const
+{
+    const Cache *cache = static_cast<const Cache *>(d_caches.localCache());
+
+    return cache ? cache->d_numObjects : 0;
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+int CachedObjectPool<TYPE, CREATOR, RESETTER>::numObjects() const
+{
+    return d_pool.numObjects();
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+TYPE *CachedObjectPool<TYPE, CREATOR, RESETTER>::createObject()
+{
+    return getObject();
+}
+
+template <class TYPE, class CREATOR, class RESETTER>
+inline
+void CachedObjectPool<TYPE, CREATOR, RESETTER>::deleteObject(TYPE *object)
+{
+    releaseObject(object);
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1234 @@
+// bdlcc_cachedobjectpool.t.cpp                                       -*-C++-*-
+#include <bdlcc_cachedobjectpool.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+#include <bslma_usesbslmaallocator.h>
+
+#include <bslmf_nestedtraitdeclaration.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstddef.h>
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>     // 'atoi'
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a thread-safe object pool keeping a cache of
+// free objects for each thread, and transferring objects in batches between
+// the caches and a shared 'bdlcc::ObjectPool'.  We verify that objects are
+// reused by the thread releasing them, that batches of the expected size are
+// transferred when a cache is empty or full, that the resetter is invoked
+// once for each released object, and that the objects cached by a thread are
+// returned to the shared pool on 'flushCache' and on thread exit.  Finally,
+// we verify that no object is lost or supplied twice when many threads use
+// the pool concurrently, releasing objects obtained by other threads.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] CachedObjectPool(Allocator *ba = 0);
+// [ 2] CachedObjectPool(int max, int growBy = -1, Allocator *ba = 0);
+// [ 2] CachedObjectPool(creator, resetter, max, growBy, ba);
+// [ 2] ~CachedObjectPool();
+//
+// MANIPULATORS
+// [ 3] void flushCache();
+// [ 3] TYPE *getObject();
+// [ 2] void increaseCapacity(int numObjects);
+// [ 3] void releaseObject(TYPE *object);
+// [ 2] void reserveCapacity(int numObjects);
+// [ 3] TYPE *createObject();
+// [ 3] void deleteObject(TYPE *object);
+//
+// ACCESSORS
+// [ 2] int batchSize() const;
+// [ 2] int maxCachedObjects() const;
+// [ 3] int numAvailableObjects() const;
+// [ 3] int numCachedObjects() const;
+// [ 2] int numObjects() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] THREAD EXIT AND CROSS-THREAD RELEASE
+// [ 5] CONCURRENCY
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+                               // =============
+                               // class Counter
+                               // =============
+
+class Counter {
+    // This class counts the number of times it was used and reset, and
+    // records whether it is currently in use.
+
+    // DATA
+    int  d_count;      // number of uses
+    int  d_numResets;  // number of resets
+    bool d_inUse;      // 'true' while held by a thread
+
+  public:
+    // CREATORS
+    Counter()
+    : d_count(0)
+    , d_numResets(0)
+    , d_inUse(false)
+    {
+    }
+
+    // MANIPULATORS
+    bool acquire()
+        // Mark this object in use and increment its count, and return 'true'
+        // if it was not already in use, and 'false' otherwise.
+    {
+        const bool wasInUse = d_inUse;
+        d_inUse = true;
+        ++d_count;
+        return !wasInUse;
+    }
+
+    void release()
+        // Mark this object not in use.
+    {
+        d_inUse = false;
+    }
+
+    void reset()
+        // Increment the number of resets of this object.
+    {
+        ++d_numResets;
+    }
+
+    // ACCESSORS
+    int count() const
+    {
+        return d_count;
+    }
+
+    bool inUse() const
+    {
+        return d_inUse;
+    }
+
+    int numResets() const
+    {
+        return d_numResets;
+    }
+};
+
+                           // ======================
+                           // class RecordingCreator
+                           // ======================
+
+class RecordingCreator {
+    // This class provides a creator recording the addresses of the objects
+    // it creates.  Note that a pool invokes its creator only while holding a
+    // mutex.
+
+    // DATA
+    bsl::vector<Counter *> *d_created_p;  // created objects (held, not
+                                          // owned)
+
+  public:
+    // CREATORS
+    explicit RecordingCreator(bsl::vector<Counter *> *created)
+    : d_created_p(created)
+    {
+    }
+
+    // ACCESSORS
+    void operator()(void *arena, bslma::Allocator *) const
+        // Create a 'Counter' object at the specified 'arena', and record its
+        // address.
+    {
+        d_created_p->push_back(new (arena) Counter());
+    }
+};
+
+typedef bdlcc::ObjectPoolFunctors::Reset<Counter>          Resetter;
+
+typedef bdlcc::CachedObjectPool<Counter,
+                                bdlcc::ObjectPoolFunctors::DefaultCreator,
+                                Resetter>                  Obj;
+
+typedef bdlcc::CachedObjectPool<Counter, RecordingCreator, Resetter>
+                                                           RecordingObj;
+
+// ============================================================================
+//                      HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+                             // ================
+                             // struct UseArgs
+                             // ================
+
+struct UseArgs {
+    // This 'struct' holds the arguments of 'useThread' and 'releaseThread'.
+
+    Obj      *d_pool_p;            // pool under test
+    Counter  *d_object_p;          // object to release, if any
+    int       d_numObjects;        // number of objects to obtain
+    int       d_numCachedObjects;  // number of objects cached by the thread
+                                   // before exiting
+};
+
+extern "C" void *useThread(void *arg)
+    // Obtain, then release, the number of objects described by the specified
+    // 'arg', which must be the address of a 'UseArgs' object, then release
+    // the object of 'arg' (if any), and record the number of objects then
+    // cached by the calling thread.
+{
+    UseArgs *args = static_cast<UseArgs *>(arg);
+
+    bsl::vector<Counter *> objects(bslma::NewDeleteAllocator::allocator(0));
+    for (int i = 0; i < args->d_numObjects; ++i) {
+        objects.push_back(args->d_pool_p->getObject());
+    }
+    for (int i = 0; i < args->d_numObjects; ++i) {
+        args->d_pool_p->releaseObject(objects[i]);
+    }
+    if (args->d_object_p) {
+        args->d_pool_p->releaseObject(args->d_object_p);
+    }
+    args->d_numCachedObjects = args->d_pool_p->numCachedObjects();
+
+    return 0;
+}
+
+                            // =================
+                            // struct StressArgs
+                            // =================
+
+struct StressArgs {
+    // This 'struct' holds the arguments of 'stressThread'.
+
+    RecordingObj     *d_pool_p;      // pool under test
+    bslmt::Barrier   *d_barrier_p;   // barrier shared by all threads
+    Counter         **d_slots_p;     // objects exchanged between threads,
+                                     // 'd_numThreads * d_numSlots'
+    int               d_index;       // index of this thread
+    int               d_numThreads;  // number of threads
+    int               d_numSlots;    // number of slots per thread
+    int               d_numRounds;   // number of rounds
+    int               d_numErrors;   // number of objects supplied twice
+};
+
+extern "C" void *stressThread(void *arg)
+    // In each round, obtain an object for each of the slots of this thread,
+    // also obtaining and releasing a few short-lived objects, then, after all
+    // threads have done so, release the objects of the slots of the next
+    // thread.  The specified 'arg' must be the address of a 'StressArgs'
+    // object.
+{
+    StressArgs *args = static_cast<StressArgs *>(arg);
+
+    const int next = (args->d_index + 1) % args->d_numThreads;
+
+    Counter **mine   = args->d_slots_p + args->d_index * args->d_numSlots;
+    Counter **theirs = args->d_slots_p + next * args->d_numSlots;
+
+    for (int round = 0; round < args->d_numRounds; ++round) {
+        for (int i = 0; i < args->d_numSlots; ++i) {
+            mine[i] = args->d_pool_p->getObject();
+            if (!mine[i]->acquire()) {
+                ++args->d_numErrors;
+            }
+
+            if (0 == i % 4) {
+                Counter *temp = args->d_pool_p->getObject();
+                if (!temp->acquire()) {
+                    ++args->d_numErrors;
+                }
+                temp->release();
+                args->d_pool_p->releaseObject(temp);
+            }
+        }
+
+        args->d_barrier_p->wait();
+
+        for (int i = 0; i < args->d_numSlots; ++i) {
+            theirs[i]->release();
+            args->d_pool_p->releaseObject(theirs[i]);
+        }
+
+        args->d_barrier_p->wait();
+    }
+    return 0;
+}
+
+                             // ================
+                             // struct BenchArgs
+                             // ================
+
+struct BenchArgs {
+    // This 'struct' holds the arguments of 'benchThread'.
+
+    void            (*d_run_p)(void *, int, int);  // function to run
+    void             *d_pool_p;                     // pool to use
+    bslmt::Barrier   *d_barrier_p;                  // start barrier
+    int               d_numRounds;                  // number of rounds
+    int               d_numSlots;                   // objects per round
+};
+
+template <class POOL>
+void runRounds(void *pool, int numRounds, int numSlots)
+    // Obtain, then release, the specified 'numSlots' objects from the
+    // specified 'pool', which must be the address of a 'POOL' object, in each
+    // of the specified 'numRounds' rounds.
+{
+    POOL    *p = static_cast<POOL *>(pool);
+    Counter *objects[64];
+
+    BSLS_ASSERT(numSlots <= 64);
+
+    for (int round = 0; round < numRounds; ++round) {
+        for (int i = 0; i < numSlots; ++i) {
+            objects[i] = p->getObject();
+        }
+        for (int i = 0; i < numSlots; ++i) {
+            p->releaseObject(objects[i]);
+        }
+    }
+}
+
+extern "C" void *benchThread(void *arg)
+    // Run the function described by the specified 'arg', which must be the
+    // address of a 'BenchArgs' object, after all threads are started.
+{
+    BenchArgs *args = static_cast<BenchArgs *>(arg);
+
+    args->d_barrier_p->wait();
+    args->d_run_p(args->d_pool_p, args->d_numRounds, args->d_numSlots);
+
+    return 0;
+}
+
+template <class POOL>
+double runBenchmark(POOL *pool, int numThreads, int numRounds, int numSlots)
+    // Run the specified 'numThreads' threads, each obtaining and releasing
+    // the specified 'numSlots' objects from the specified 'pool' in each of
+    // the specified 'numRounds' rounds, and return the elapsed wall time in
+    // seconds.
+{
+    bslmt::Barrier barrier(numThreads + 1);
+
+    bsl::vector<BenchArgs>                 args(numThreads);
+    bsl::vector<bslmt::ThreadUtil::Handle> handles(numThreads);
+
+    for (int i = 0; i < numThreads; ++i) {
+        args[i].d_run_p     = &runRounds<POOL>;
+        args[i].d_pool_p    = pool;
+        args[i].d_barrier_p = &barrier;
+        args[i].d_numRounds = numRounds;
+        args[i].d_numSlots  = numSlots;
+
+        bslmt::ThreadUtil::create(&handles[i], benchThread, &args[i]);
+    }
+
+    bsls::Stopwatch timer;
+    timer.start(true);
+
+    barrier.wait();
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::join(handles[i]);
+    }
+
+    timer.stop();
+    return timer.accumulatedWallTime();
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+namespace BDLCC_CACHEDOBJECTPOOL_USAGE_EXAMPLE {
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Pooling Message Objects
+/// - - - - - - - - - - - - - - - - -
+// Suppose that the threads of a messaging system each decode many messages
+// into short-lived 'Message' objects.  Each 'Message' holds a string, whose
+// capacity we want to keep for the next message that reuses the object.
+//
+// First, we define the 'Message' class, which uses an allocator, and provides
+// a 'reset' method restoring the default state of a message:
+//..
+class Message {
+    // This class holds the topic and payload of a message.
+
+    // DATA
+    int         d_topic;    // topic of the message
+    bsl::string d_payload;  // payload of the message
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(Message, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit Message(bslma::Allocator *basicAllocator = 0)
+    : d_topic(0)
+    , d_payload(basicAllocator)
+    {
+    }
+
+    // MANIPULATORS
+    void decode(int topic, const char *payload)
+    {
+        d_topic = topic;
+        d_payload.assign(payload);
+    }
+
+    void reset()
+    {
+        d_topic = 0;
+        d_payload.clear();
+    }
+
+    // ACCESSORS
+    const bsl::string& payload() const
+    {
+        return d_payload;
+    }
+};
+//..
+// Then, we define the type of the pool, which resets the messages returned to
+// it:
+//..
+typedef bdlcc::CachedObjectPool<
+                         Message,
+                         bdlcc::ObjectPoolFunctors::DefaultCreator,
+                         bdlcc::ObjectPoolFunctors::Reset<Message> > Pool;
+//..
+// Next, we define a function decoding a number of messages using objects
+// obtained from a pool, as done by each thread of the system:
+//..
+bsl::size_t decodeMessages(Pool *pool, int numMessages)
+    // Decode the specified 'numMessages' messages using objects obtained
+    // from the specified 'pool', and return the total length of their
+    // payloads.
+{
+    bsl::size_t length = 0;
+
+    for (int i = 0; i < numMessages; ++i) {
+        Message *message = pool->getObject();
+
+        message->decode(i, "a payload too long for the short buffer");
+        length += message->payload().length();
+
+        pool->releaseObject(message);
+    }
+    return length;
+}
+//..
+
+}  // close namespace BDLCC_CACHEDOBJECTPOOL_USAGE_EXAMPLE
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int  test            = argc > 1 ? atoi(argv[1]) : 0;
+    const bool verbose         = argc > 2;
+    const bool veryVerbose     = argc > 3;
+    const bool veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator da("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        using namespace BDLCC_CACHEDOBJECTPOOL_USAGE_EXAMPLE;
+
+// Now, we create a pool caching up to 16 messages for each thread, whose
+// shared pool creates 8 messages at a time, and decode a few messages:
+//..
+    Pool pool(16, 8);
+
+    ASSERT(16 == pool.maxCachedObjects());
+    ASSERT( 8 == pool.batchSize());
+
+    ASSERT(390 == decodeMessages(&pool, 10));
+//..
+// Finally, we observe that the first message requested from the pool
+// obtained a batch of 8 messages from the shared pool, one of which is reused
+// for all messages, and all of which are held by the cache of this thread:
+//..
+    ASSERT(8 == pool.numObjects());
+    ASSERT(8 == pool.numCachedObjects());
+    ASSERT(0 == pool.numAvailableObjects());
+
+    pool.flushCache();
+
+    ASSERT(0 == pool.numCachedObjects());
+    ASSERT(8 == pool.numAvailableObjects());
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY
+        //
+        // Concerns:
+        //: 1 Objects obtained concurrently by several threads are never
+        //:   supplied to two threads at once.
+        //:
+        //: 2 Objects released by a thread other than the one that obtained
+        //:   them are reused.
+        //:
+        //: 3 No object is lost: after all threads exit, all objects are
+        //:   available in the shared pool, and each was reset once for each
+        //:   use.
+        //
+        // Plan:
+        //: 1 Run several threads, each obtaining objects for its slots in
+        //:   each round (marking them in use, and counting those already in
+        //:   use), and releasing the objects of the slots of another thread.
+        //:   (C-1..2)
+        //:
+        //: 2 After joining the threads, verify that all objects, recorded by
+        //:   the creator of the pool, are available in the shared pool, and
+        //:   verify the sums of their counts and numbers of resets.  (C-3)
+        //
+        // Testing:
+        //   CONCURRENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY" << endl
+                          << "===========" << endl;
+
+        enum { k_NUM_THREADS = 8, k_NUM_SLOTS = 50, k_NUM_ROUNDS = 200 };
+
+        const int MAX_CACHED[] = { 0, 1, 8, 32 };
+
+        for (int ti = 0; ti < 4; ++ti) {
+            const int MAX = MAX_CACHED[ti];
+
+            if (veryVerbose) { T_ P(MAX) }
+
+            bslma::TestAllocator ta("object", veryVeryVerbose);
+            {
+                bsl::vector<Counter *> created(&ta);
+
+                RecordingObj mX(RecordingCreator(&created),
+                                Resetter(),
+                                MAX,
+                                -1,
+                                &ta);
+                const RecordingObj& X = mX;
+
+                Counter        *slots[k_NUM_THREADS * k_NUM_SLOTS];
+                bslmt::Barrier  barrier(k_NUM_THREADS);
+
+                StressArgs                args[k_NUM_THREADS];
+                bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    args[i].d_pool_p     = &mX;
+                    args[i].d_barrier_p  = &barrier;
+                    args[i].d_slots_p    = slots;
+                    args[i].d_index      = i;
+                    args[i].d_numThreads = k_NUM_THREADS;
+                    args[i].d_numSlots   = k_NUM_SLOTS;
+                    args[i].d_numRounds  = k_NUM_ROUNDS;
+                    args[i].d_numErrors  = 0;
+
+                    ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                          stressThread,
+                                                          &args[i]));
+                }
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+                    ASSERTV(MAX, i, args[i].d_numErrors,
+                            0 == args[i].d_numErrors);
+                }
+
+                const int NUM_OBJECTS = X.numObjects();
+
+                if (veryVerbose) { T_ T_ P(NUM_OBJECTS) }
+
+                ASSERTV(MAX,
+                        NUM_OBJECTS,
+                        static_cast<int>(created.size()),
+                        NUM_OBJECTS == static_cast<int>(created.size()));
+                ASSERTV(MAX,
+                        NUM_OBJECTS,
+                        X.numAvailableObjects(),
+                        NUM_OBJECTS == X.numAvailableObjects());
+
+                int totalCount  = 0;
+                int totalResets = 0;
+                for (int i = 0; i < NUM_OBJECTS; ++i) {
+                    ASSERTV(MAX, i, !created[i]->inUse());
+
+                    totalCount  += created[i]->count();
+                    totalResets += created[i]->numResets();
+                }
+
+                const int EXPECTED = k_NUM_THREADS
+                                   * k_NUM_ROUNDS
+                                   * (k_NUM_SLOTS + (k_NUM_SLOTS + 3) / 4);
+
+                ASSERTV(MAX, totalCount, EXPECTED == totalCount);
+                ASSERTV(MAX, totalResets, EXPECTED == totalResets);
+            }
+            ASSERTV(MAX, ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // THREAD EXIT AND CROSS-THREAD RELEASE
+        //
+        // Concerns:
+        //: 1 The objects cached by a thread are returned to the shared pool
+        //:   when the thread exits, and its cache is deallocated.
+        //:
+        //: 2 An object released by a thread having no cache is returned to
+        //:   the shared pool.
+        //:
+        //: 3 An object released by a thread having a cache, other than the
+        //:   thread that obtained it, is added to the cache of the releasing
+        //:   thread.
+        //
+        // Plan:
+        //: 1 Run a thread obtaining and releasing objects, and verify that
+        //:   all objects are available in the shared pool after joining it.
+        //:   (C-1)
+        //:
+        //: 2 Obtain an object in the main thread, and release it from a
+        //:   thread obtaining no objects, verifying that the thread caches no
+        //:   object, and that the object is available in the shared pool.
+        //:   (C-2)
+        //:
+        //: 3 Repeat P-2 with a thread obtaining and releasing an object
+        //:   before releasing the object of the main thread, verifying the
+        //:   number of objects cached by the thread.  (C-3)
+        //
+        // Testing:
+        //   THREAD EXIT AND CROSS-THREAD RELEASE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "THREAD EXIT AND CROSS-THREAD RELEASE" << endl
+                          << "====================================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(8, 4, &ta);  const Obj& X = mX;
+
+            if (verbose) cout << "\nReturning the cache on thread exit."
+                              << endl;
+            {
+                UseArgs args = { &mX, 0, 6, -1 };
+
+                bslmt::ThreadUtil::Handle handle;
+                ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                      useThread,
+                                                      &args));
+                ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+                ASSERTV(args.d_numCachedObjects,
+                        8 == args.d_numCachedObjects);
+                ASSERTV(X.numObjects(), 8 == X.numObjects());
+                ASSERTV(X.numAvailableObjects(),
+                        8 == X.numAvailableObjects());
+            }
+
+            if (verbose) cout << "\nReleasing from a thread with no cache."
+                              << endl;
+            {
+                Counter   *object = mX.getObject();
+                const int  RESETS = object->numResets();
+
+                ASSERTV(X.numCachedObjects(), 3 == X.numCachedObjects());
+                ASSERTV(X.numAvailableObjects(),
+                        4 == X.numAvailableObjects());
+
+                UseArgs args = { &mX, object, 0, -1 };
+
+                bslmt::ThreadUtil::Handle handle;
+                ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                      useThread,
+                                                      &args));
+                ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+                ASSERTV(args.d_numCachedObjects,
+                        0 == args.d_numCachedObjects);
+                ASSERTV(X.numCachedObjects(), 3 == X.numCachedObjects());
+                ASSERTV(X.numAvailableObjects(),
+                        5 == X.numAvailableObjects());
+                ASSERTV(RESETS, object->numResets(),
+                        RESETS + 1 == object->numResets());
+            }
+
+            if (verbose) cout << "\nReleasing from a thread with a cache."
+                              << endl;
+            {
+                mX.flushCache();
+
+                Counter *object = mX.getObject();
+
+                ASSERTV(X.numAvailableObjects(),
+                        4 == X.numAvailableObjects());
+
+                UseArgs args = { &mX, object, 1, -1 };
+
+                bslmt::ThreadUtil::Handle handle;
+                ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                      useThread,
+                                                      &args));
+                ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+                // The thread obtained a batch of 4 objects, and cached them
+                // with the object of the main thread.
+
+                ASSERTV(args.d_numCachedObjects,
+                        5 == args.d_numCachedObjects);
+                ASSERTV(X.numObjects(), 8 == X.numObjects());
+                ASSERTV(X.numAvailableObjects(),
+                        5 == X.numAvailableObjects());
+
+                mX.flushCache();
+
+                ASSERTV(X.numAvailableObjects(),
+                        8 == X.numAvailableObjects());
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'getObject', 'releaseObject', AND 'flushCache'
+        //
+        // Concerns:
+        //: 1 'getObject' fills the empty cache of the calling thread with a
+        //:   batch of objects from the shared pool, and otherwise supplies
+        //:   the most recently cached object.
+        //:
+        //: 2 'releaseObject' resets the object and adds it to the cache of
+        //:   the calling thread, first returning the least recently cached
+        //:   batch of objects to the shared pool if the cache is full.
+        //:
+        //: 3 'flushCache' returns all cached objects to the shared pool.
+        //:
+        //: 4 If the maximum number of cached objects is 0, objects are
+        //:   obtained from, and released to, the shared pool.
+        //:
+        //: 5 'createObject' and 'deleteObject' forward to 'getObject' and
+        //:   'releaseObject'.
+        //
+        // Plan:
+        //: 1 Obtain and release objects from a pool caching up to 8 objects,
+        //:   verifying the addresses of the objects supplied, the numbers of
+        //:   resets, and the values of 'numObjects', 'numAvailableObjects',
+        //:   and 'numCachedObjects'.  (C-1..3)
+        //:
+        //: 2 Repeat P-1 for a pool caching no objects.  (C-4)
+        //:
+        //: 3 Obtain and release an object through the 'bdlma::Factory'
+        //:   protocol.  (C-5)
+        //
+        // Testing:
+        //   void flushCache();
+        //   TYPE *getObject();
+        //   void releaseObject(TYPE *object);
+        //   TYPE *createObject();
+        //   void deleteObject(TYPE *object);
+        //   int numAvailableObjects() const;
+        //   int numCachedObjects() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'getObject', 'releaseObject', AND 'flushCache'"
+                          << endl
+                          << "=============================================="
+                          << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        if (verbose) cout << "\nCaching up to 8 objects." << endl;
+        {
+            Obj mX(8, 4, &ta);  const Obj& X = mX;
+
+            ASSERTV(X.numCachedObjects(), 0 == X.numCachedObjects());
+
+            Counter *objects[12];
+
+            objects[0] = mX.getObject();
+            ASSERTV(X.numObjects(),          4 == X.numObjects());
+            ASSERTV(X.numAvailableObjects(), 0 == X.numAvailableObjects());
+            ASSERTV(X.numCachedObjects(),    3 == X.numCachedObjects());
+
+            for (int i = 1; i < 12; ++i) {
+                objects[i] = mX.getObject();
+                for (int j = 0; j < i; ++j) {
+                    ASSERTV(i, j, objects[i] != objects[j]);
+                }
+            }
+            ASSERTV(X.numObjects(),          12 == X.numObjects());
+            ASSERTV(X.numAvailableObjects(),  0 == X.numAvailableObjects());
+            ASSERTV(X.numCachedObjects(),     0 == X.numCachedObjects());
+
+            for (int i = 0; i < 8; ++i) {
+                mX.releaseObject(objects[i]);
+                ASSERTV(i, i + 1 == X.numCachedObjects());
+            }
+            ASSERTV(X.numAvailableObjects(), 0 == X.numAvailableObjects());
+
+            // The cache is full: the 4 least recently cached objects are
+            // returned to the shared pool.
+
+            mX.releaseObject(objects[8]);
+            ASSERTV(X.numCachedObjects(),    5 == X.numCachedObjects());
+            ASSERTV(X.numAvailableObjects(), 4 == X.numAvailableObjects());
+
+            for (int i = 9; i < 12; ++i) {
+                mX.releaseObject(objects[i]);
+            }
+            ASSERTV(X.numCachedObjects(),    8 == X.numCachedObjects());
+            ASSERTV(X.numAvailableObjects(), 4 == X.numAvailableObjects());
+
+            for (int i = 0; i < 12; ++i) {
+                ASSERTV(i, 1 == objects[i]->numResets());
+            }
+
+            // Cached objects are supplied most recently released first.
+
+            for (int i = 11; i >= 4; --i) {
+                Counter *object = mX.getObject();
+                ASSERTV(i, objects[i] == object);
+            }
+            ASSERTV(X.numCachedObjects(), 0 == X.numCachedObjects());
+
+            for (int i = 4; i < 12; ++i) {
+                mX.releaseObject(objects[i]);
+            }
+            ASSERTV(X.numCachedObjects(), 8 == X.numCachedObjects());
+
+            mX.flushCache();
+            ASSERTV(X.numCachedObjects(),     0 == X.numCachedObjects());
+            ASSERTV(X.numAvailableObjects(), 12 == X.numAvailableObjects());
+            ASSERTV(X.numObjects(),          12 == X.numObjects());
+
+            mX.flushCache();
+            ASSERTV(X.numAvailableObjects(), 12 == X.numAvailableObjects());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nCaching no objects." << endl;
+        {
+            Obj mX(0, 4, &ta);  const Obj& X = mX;
+
+            Counter *object = mX.getObject();
+            ASSERTV(X.numObjects(),          4 == X.numObjects());
+            ASSERTV(X.numAvailableObjects(), 3 == X.numAvailableObjects());
+            ASSERTV(X.numCachedObjects(),    0 == X.numCachedObjects());
+
+            mX.releaseObject(object);
+            ASSERTV(X.numAvailableObjects(), 4 == X.numAvailableObjects());
+            ASSERTV(X.numCachedObjects(),    0 == X.numCachedObjects());
+            ASSERTV(object->numResets(),     1 == object->numResets());
+
+            mX.flushCache();
+            ASSERTV(X.numAvailableObjects(), 4 == X.numAvailableObjects());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nUsing the factory protocol." << endl;
+        {
+            Obj mX(8, 4, &ta);  const Obj& X = mX;
+
+            bdlma::Factory<Counter> *factory = &mX;
+
+            Counter *object = factory->createObject();
+            ASSERTV(X.numCachedObjects(), 3 == X.numCachedObjects());
+
+            factory->deleteObject(object);
+            ASSERTV(X.numCachedObjects(), 4 == X.numCachedObjects());
+            ASSERTV(object->numResets(),  1 == object->numResets());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 The maximum number of cached objects is the value supplied at
+        //:   construction, or 'k_DEFAULT_MAX_CACHED_OBJECTS' by default.
+        //:
+        //: 2 The batch size is half the maximum number of cached objects,
+        //:   and at least 1.
+        //:
+        //: 3 The creator supplied at construction creates the objects, and
+        //:   'growBy' determines the replenishment of the shared pool.
+        //:
+        //: 4 'increaseCapacity' and 'reserveCapacity' create objects in the
+        //:   shared pool.
+        //:
+        //: 5 The pool uses the allocator supplied at construction, or the
+        //:   default allocator if none is supplied, and releases all memory
+        //:   on destruction.
+        //
+        // Plan:
+        //: 1 Create pools using each constructor, for several maximum
+        //:   numbers of cached objects, verifying the values of the
+        //:   accessors.  (C-1..2)
+        //:
+        //: 2 Create a pool with a counting creator, obtain an object, and
+        //:   verify the number of objects created.  (C-3)
+        //:
+        //: 3 Call 'increaseCapacity' and 'reserveCapacity', verifying the
+        //:   number of objects.  (C-4)
+        //:
+        //: 4 Verify the use of the test allocators.  (C-5)
+        //
+        // Testing:
+        //   CachedObjectPool(Allocator *ba = 0);
+        //   CachedObjectPool(int max, int growBy = -1, Allocator *ba = 0);
+        //   CachedObjectPool(creator, resetter, max, growBy, ba);
+        //   ~CachedObjectPool();
+        //   void increaseCapacity(int numObjects);
+        //   void reserveCapacity(int numObjects);
+        //   int batchSize() const;
+        //   int maxCachedObjects() const;
+        //   int numObjects() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND BASIC ACCESSORS" << endl
+                          << "============================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        if (verbose) cout << "\nDefault maximum number of cached objects."
+                          << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERTV(X.maxCachedObjects(),
+                    Obj::k_DEFAULT_MAX_CACHED_OBJECTS == X.maxCachedObjects());
+            ASSERTV(X.batchSize(),
+                    Obj::k_DEFAULT_MAX_CACHED_OBJECTS / 2 == X.batchSize());
+            ASSERTV(X.numObjects(), 0 == X.numObjects());
+            ASSERTV(ta.numBlocksTotal(), 0 == ta.numBlocksTotal());
+        }
+
+        if (verbose) cout << "\nSpecified maximum number of cached objects."
+                          << endl;
+        {
+            static const struct {
+                int d_line;       // source line number
+                int d_maxCached;  // maximum number of cached objects
+                int d_batchSize;  // expected batch size
+            } DATA[] = {
+                //LINE  MAX  BATCH
+                //----  ---  -----
+                { L_,     0,     1 },
+                { L_,     1,     1 },
+                { L_,     2,     1 },
+                { L_,     3,     1 },
+                { L_,     4,     2 },
+                { L_,    64,    32 },
+                { L_,  1001,   500 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int LINE  = DATA[ti].d_line;
+                const int MAX   = DATA[ti].d_maxCached;
+                const int BATCH = DATA[ti].d_batchSize;
+
+                Obj mX(MAX, -1, &ta);  const Obj& X = mX;
+
+                ASSERTV(LINE, X.maxCachedObjects(),
+                        MAX == X.maxCachedObjects());
+                ASSERTV(LINE, X.batchSize(), BATCH == X.batchSize());
+                ASSERTV(LINE, X.numObjects(), 0 == X.numObjects());
+
+                Counter *object = mX.getObject();
+                ASSERTV(LINE, X.numObjects(), BATCH <= X.numObjects());
+                mX.releaseObject(object);
+            }
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nCreator and resetter." << endl;
+        {
+            bsl::vector<Counter *> created(&ta);
+
+            RecordingObj mX(RecordingCreator(&created), Resetter(), 6, 2, &ta);
+            const RecordingObj& X = mX;
+
+            ASSERTV(X.maxCachedObjects(), 6 == X.maxCachedObjects());
+            ASSERTV(X.batchSize(),        3 == X.batchSize());
+
+            Counter *object = mX.getObject();
+
+            // The shared pool grows by 2 objects at a time.
+
+            ASSERTV(created.size(),       4 == created.size());
+            ASSERTV(X.numObjects(),       4 == X.numObjects());
+
+            mX.releaseObject(object);
+            ASSERTV(object->numResets(),  1 == object->numResets());
+
+            const RecordingCreator CREATOR(&created);
+            const Resetter         RESETTER;
+
+            RecordingObj mY(CREATOR, RESETTER);  const RecordingObj& Y = mY;
+
+            ASSERTV(Y.maxCachedObjects(),
+                    RecordingObj::k_DEFAULT_MAX_CACHED_OBJECTS ==
+                                                        Y.maxCachedObjects());
+            ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\n'increaseCapacity' and 'reserveCapacity'."
+                          << endl;
+        {
+            Obj mX(8, 4, &ta);  const Obj& X = mX;
+
+            mX.increaseCapacity(5);
+            ASSERTV(X.numObjects(),          5 == X.numObjects());
+            ASSERTV(X.numAvailableObjects(), 5 == X.numAvailableObjects());
+
+            mX.reserveCapacity(3);
+            ASSERTV(X.numObjects(),          5 == X.numObjects());
+
+            mX.reserveCapacity(10);
+            ASSERTV(X.numObjects(),         10 == X.numObjects());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nDefault allocator." << endl;
+        {
+            Obj mX;
+
+            mX.releaseObject(mX.getObject());
+            ASSERTV(da.numBlocksInUse(), 0 < da.numBlocksInUse());
+        }
+        ASSERTV(da.numBlocksInUse(), 0 == da.numBlocksInUse());
+        ASSERTV(ta.numBlocksTotal(), 0 < ta.numBlocksTotal());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Obtain objects from a pool, use them, and release them.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            Counter *a = mX.getObject();
+            Counter *b = mX.getObject();
+
+            ASSERT(a != b);
+            ASSERT(a->acquire());
+            ASSERT(b->acquire());
+
+            a->release();
+            b->release();
+            mX.releaseObject(a);
+            mX.releaseObject(b);
+
+            ASSERT(b == mX.getObject());
+            ASSERT(a == mX.getObject());
+            ASSERTV(X.numObjects(), 2 <= X.numObjects());
+
+            mX.releaseObject(a);
+            mX.releaseObject(b);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //   Compare the throughput of 'bdlcc::CachedObjectPool' with that of
+        //   'bdlcc::ObjectPool', for 1 to 32 threads each obtaining and
+        //   releasing objects.
+        //
+        //   Usage: <driver> -1 [numRounds [numSlots]]
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST" << endl
+                          << "================" << endl;
+
+        const int NUM_ROUNDS = argc > 2 ? atoi(argv[2]) : 20000;
+        const int NUM_SLOTS  = argc > 3 ? atoi(argv[3]) : 8;
+
+        typedef bdlcc::ObjectPool<Counter> Pool;
+        typedef bdlcc::CachedObjectPool<Counter> CachedPool;
+
+        bslma::Allocator *na = bslma::NewDeleteAllocator::allocator(0);
+
+        const int THREADS[] = { 1, 2, 4, 8, 16, 32 };
+
+        printf("%8s %12s %12s\n", "threads", "pool", "cached");
+
+        for (int ti = 0; ti < 6; ++ti) {
+            const int NUM_THREADS = THREADS[ti];
+
+            double times[2];
+            {
+                Pool mX(-1, na);
+                times[0] = runBenchmark(&mX,
+                                        NUM_THREADS,
+                                        NUM_ROUNDS,
+                                        NUM_SLOTS);
+            }
+            {
+                CachedPool mX(na);
+                times[1] = runBenchmark(&mX,
+                                        NUM_THREADS,
+                                        NUM_ROUNDS,
+                                        NUM_SLOTS);
+            }
+
+            // Report millions of 'getObject'/'releaseObject' pairs per
+            // second.
+
+            const double OPS = static_cast<double>(NUM_THREADS)
+                             * NUM_ROUNDS * NUM_SLOTS / 1e6;
+
+            printf("%8d %12.2f %12.2f\n",
+                   NUM_THREADS,
+                   OPS / times[0],
+                   OPS / times[1]);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,430 @@
+// bdlcc_epochmanager.cpp                                             -*-C++-*-
+#include <bdlcc_epochmanager.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlcc_epochmanager_cpp,"$Id$ $CSID$")
+
+#include <bslmt_lockguard.h>
+
+#include <bsls_performancehint.h>
+
+#include <bsl_cstddef.h>
+
+#include <new>           // placement 'new'
+
+namespace BloombergLP {
+namespace bdlcc {
+
+                     // ================================
+                     // struct EpochManager_ThreadRecord
+                     // ================================
+
+struct EpochManager_ThreadRecord {
+    // This component-private 'struct' holds the state of a thread registered
+    // with an epoch manager.  Only 'd_state' is accessed by other threads; it
+    // is padded so that threads announcing their epoch do not write to the
+    // same cache line.
+
+    // TYPES
+    typedef EpochManager::Retired Retired;
+
+    enum { k_CACHE_LINE_SIZE = 64 };
+
+    // DATA
+    bsls::AtomicInt64          d_state;       // '2 * epoch + 1' if in a
+                                              // critical section, and 0
+                                              // otherwise
+
+    char                       d_pad[k_CACHE_LINE_SIZE -
+                                     sizeof(bsls::AtomicInt64)];
+
+    int                        d_nesting;     // depth of critical sections
+
+    bool                       d_collecting;  // 'true' while deleters are
+                                              // invoked
+
+    bsl::vector<Retired>       d_retired;     // objects retired by the
+                                              // thread, in epoch order
+
+    bsl::vector<Retired>       d_reclaimed;   // objects being reclaimed
+
+    // CREATORS
+    explicit
+    EpochManager_ThreadRecord(bslma::Allocator *basicAllocator)
+    : d_state(0)
+    , d_nesting(0)
+    , d_collecting(false)
+    , d_retired(basicAllocator)
+    , d_reclaimed(basicAllocator)
+    {
+    }
+};
+
+}  // close package namespace
+
+namespace {
+
+inline
+int reclaimThreshold(int maxRetired)
+    // Return the number of objects retired by a thread and not yet reclaimed
+    // beyond which the thread attempts to reclaim them, for the specified
+    // 'maxRetired' bound.
+{
+    return (maxRetired + 1) / 2;
+}
+
+bool hasAnnounced(const void *record, void *epoch)
+    // Return 'true' unless the thread of the specified 'record', which must
+    // be the address of a 'bdlcc::EpochManager_ThreadRecord', is in a
+    // critical section and has announced an epoch other than the one at the
+    // specified 'epoch', which must be the address of a
+    // 'bsls::Types::Int64'.
+{
+    const bsls::Types::Int64 state =
+          static_cast<const bdlcc::EpochManager_ThreadRecord *>(record)->
+                                                              d_state.load();
+
+    return !(state & 1)
+        || (state >> 1) == *static_cast<const bsls::Types::Int64 *>(epoch);
+}
+
+inline
+int retiredCount(const bdlcc::EpochManager_ThreadRecord *record)
+    // Return the number of objects retired by the thread of the specified
+    // 'record' and not yet reclaimed.
+{
+    return static_cast<int>(record->d_retired.size());
+}
+
+}  // close unnamed namespace
+
+namespace bdlcc {
+
+                            // ------------------
+                            // class EpochManager
+                            // ------------------
+
+// PRIVATE CLASS METHODS
+void EpochManager::releaseRecord(void *record, void *manager)
+{
+    static_cast<EpochManager *>(manager)->unregister(
+                                                static_cast<Record *>(record));
+}
+
+// PRIVATE MANIPULATORS
+void EpochManager::collect(Record *record)
+{
+    if (record->d_collecting) {
+        // A deleter invoked by this thread retired an object.
+
+        return;                                                       // RETURN
+    }
+
+    const bsls::Types::Int64 epoch = d_epoch.load();
+
+    bsl::vector<Retired>& retired = record->d_retired;
+
+    bsl::size_t n = 0;
+    while (n < retired.size() && retired[n].d_epoch + 2 <= epoch) {
+        ++n;
+    }
+
+    if (n) {
+        record->d_collecting = true;
+
+        record->d_reclaimed.assign(retired.begin(), retired.begin() + n);
+        retired.erase(retired.begin(), retired.begin() + n);
+
+        for (bsl::size_t i = 0; i < n; ++i) {
+            const Retired& item = record->d_reclaimed[i];
+            item.d_deleter(item.d_object_p, item.d_allocator_p);
+        }
+        record->d_reclaimed.clear();
+
+        record->d_collecting = false;
+    }
+
+    if (d_numOrphans.loadRelaxed()) {
+        reclaimOrphans();
+    }
+}
+
+EpochManager::Record *EpochManager::localRecord()
+{
+    Record *record = static_cast<Record *>(d_records.localCache());
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(record)) {
+        return record;                                                // RETURN
+    }
+
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+    record = new (d_records.allocateCache()) Record(d_records.allocator());
+
+    d_records.registerCache(record);
+
+    return record;
+}
+
+void EpochManager::reclaimOrphans()
+{
+    const bsls::Types::Int64 epoch = d_epoch.load();
+
+    bsl::vector<Retired> reclaimed(d_records.allocator());
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        bsl::size_t numKept = 0;
+        for (bsl::size_t i = 0; i < d_orphans.size(); ++i) {
+            if (d_orphans[i].d_epoch + 2 <= epoch) {
+                reclaimed.push_back(d_orphans[i]);
+            }
+            else {
+                d_orphans[numKept++] = d_orphans[i];
+            }
+        }
+        d_orphans.resize(numKept);
+        d_numOrphans.storeRelaxed(static_cast<int>(numKept));
+    }
+
+    for (bsl::size_t i = 0; i < reclaimed.size(); ++i) {
+        reclaimed[i].d_deleter(reclaimed[i].d_object_p,
+                               reclaimed[i].d_allocator_p);
+    }
+}
+
+void EpochManager::reclaimRetired(Record *record)
+{
+    if (retiredCount(record) < reclaimThreshold(d_maxRetired)) {
+        return;                                                       // RETURN
+    }
+
+    tryAdvance();
+    collect(record);
+
+    if (record->d_nesting || record->d_collecting) {
+        // This thread would wait for itself.
+
+        return;                                                       // RETURN
+    }
+
+    while (retiredCount(record) >= d_maxRetired) {
+        if (!tryAdvance()) {
+            bslmt::ThreadUtil::yield();
+        }
+        collect(record);
+    }
+}
+
+bool EpochManager::tryAdvance()
+{
+    bsls::Types::Int64 epoch = d_epoch.load();
+
+    if (!d_records.visitCaches(&hasAnnounced, &epoch)) {
+        return false;                                                 // RETURN
+    }
+
+    // Note that the epoch may have been advanced by another thread since it
+    // was loaded, in which case this attempt has no effect.
+
+    d_epoch.testAndSwap(epoch, epoch + 1);
+
+    return true;
+}
+
+void EpochManager::unregister(Record *record)
+{
+    BSLS_ASSERT(0 == record->d_nesting);
+
+    collect(record);
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        d_orphans.insert(d_orphans.end(),
+                         record->d_retired.begin(),
+                         record->d_retired.end());
+        d_numOrphans.storeRelaxed(static_cast<int>(d_orphans.size()));
+    }
+
+    record->~Record();
+}
+
+// CREATORS
+EpochManager::EpochManager(bslma::Allocator *basicAllocator)
+: d_epoch(0)
+, d_maxRetired(k_DEFAULT_MAX_RETIRED_PER_THREAD)
+, d_records(sizeof(Record), &EpochManager::releaseRecord, this, basicAllocator)
+, d_orphans(d_records.allocator())
+, d_numOrphans(0)
+{
+}
+
+EpochManager::EpochManager(int               maxRetiredPerThread,
+                           bslma::Allocator *basicAllocator)
+: d_epoch(0)
+, d_maxRetired(maxRetiredPerThread)
+, d_records(sizeof(Record), &EpochManager::releaseRecord, this, basicAllocator)
+, d_orphans(d_records.allocator())
+, d_numOrphans(0)
+{
+    BSLS_ASSERT(0 < maxRetiredPerThread);
+}
+
+EpochManager::~EpochManager()
+{
+    // The objects retired by the threads still registered are handed over,
+    // then all the objects handed over are reclaimed.
+
+    d_records.releaseCaches();
+
+    for (bsl::size_t i = 0; i < d_orphans.size(); ++i) {
+        d_orphans[i].d_deleter(d_orphans[i].d_object_p,
+                               d_orphans[i].d_allocator_p);
+    }
+}
+
+// MANIPULATORS
+void EpochManager::enter()
+{
+    Record *record = localRecord();
+
+    if (0 == record->d_nesting++) {
+        // The announcement must be visible before any address is loaded in
+        // the critical section, hence the sequentially consistent store.
+
+        record->d_state.store(d_epoch.load() * 2 + 1);
+    }
+}
+
+void EpochManager::leave()
+{
+    Record *record = static_cast<Record *>(d_records.localCache());
+
+    BSLS_ASSERT(record);
+    BSLS_ASSERT(0 < record->d_nesting);
+
+    if (0 == --record->d_nesting) {
+        record->d_state.storeRelease(0);
+
+        reclaimRetired(record);
+    }
+}
+
+void EpochManager::quiescentState()
+{
+    Record *record = static_cast<Record *>(d_records.localCache());
+
+    if (!record) {
+        return;                                                       // RETURN
+    }
+
+    if (record->d_nesting) {
+        record->d_state.store(d_epoch.load() * 2 + 1);
+    }
+
+    reclaimRetired(record);
+}
+
+void EpochManager::reclaim()
+{
+    // The objects retired in the current epoch can be reclaimed once the
+    // epoch has advanced twice.
+
+    if (tryAdvance()) {
+        tryAdvance();
+    }
+
+    Record *record = static_cast<Record *>(d_records.localCache());
+
+    if (record) {
+        collect(record);
+    }
+    else if (d_numOrphans.loadRelaxed()) {
+        reclaimOrphans();
+    }
+}
+
+void EpochManager::registerThread()
+{
+    localRecord();
+}
+
+void EpochManager::retire(void             *object,
+                          Deleter           deleter,
+                          bslma::Allocator *allocator)
+{
+    BSLS_ASSERT(deleter);
+
+    Record *record = localRecord();
+
+    const Retired item = { object, deleter, allocator, d_epoch.load() };
+    record->d_retired.push_back(item);
+
+    reclaimRetired(record);
+}
+
+void EpochManager::synchronize()
+{
+    BSLS_ASSERT(!isInCriticalSection());
+
+    // Every thread in a critical section when the epoch reaches 'epoch + 2'
+    // has announced 'epoch + 1', and thus entered its critical section (or
+    // announced a quiescent state) after this method was called.
+
+    const bsls::Types::Int64 epoch = d_epoch.load();
+
+    while (d_epoch.load() < epoch + 2) {
+        if (!tryAdvance()) {
+            bslmt::ThreadUtil::yield();
+        }
+    }
+}
+
+void EpochManager::unregisterThread()
+{
+    BSLS_ASSERT(!isInCriticalSection());
+
+    d_records.releaseLocalCache();
+}
+
+// ACCESSORS
+bool EpochManager::isInCriticalSection() const
+{
+    const Record *record = static_cast<const Record *>(
+                                                     d_records.localCache());
+
+    return record && 0 < record->d_nesting;
+}
+
+int EpochManager::numRetired() const
+{
+    const Record *record = static_cast<const Record *>(
+                                                     d_records.localCache());
+
+    return record ? retiredCount(record) : 0;
+}
+
+int EpochManager::numThreads() const
+{
+    return d_records.numCaches();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
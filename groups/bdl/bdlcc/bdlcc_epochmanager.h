@@ -0,0 +1,624 @@
+// bdlcc_epochmanager.h                                               -*-C++-*-
+#ifndef INCLUDED_BDLCC_EPOCHMANAGER
+#define INCLUDED_BDLCC_EPOCHMANAGER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide epoch-based deferred reclamation for lock-free structures.
+//
+//@CLASSES:
+//  bdlcc::EpochManager: epoch-based reclamation of retired objects
+//  bdlcc::EpochManagerGuard: scoped critical section of an epoch manager
+//
+//@SEE_ALSO: bdlcc_skiplist, bdlcc_objectcatalog
+//
+//@DESCRIPTION: This component provides a mechanism, 'bdlcc::EpochManager',
+// that defers the destruction of objects removed from a lock-free data
+// structure until no thread may still be accessing them, and a guard,
+// 'bdlcc::EpochManagerGuard', delimiting the scope in which a thread accesses
+// such a structure.
+//
+// A thread traversing a lock-free structure may load the address of an object
+// just before another thread removes that object from the structure; the
+// removing thread therefore cannot destroy the object immediately.  Instead,
+// the removing thread "retires" the object by passing its address, a deleter,
+// and an allocator to 'retire' (or to 'retireObject', which supplies a
+// deleter destroying an object of the specified type), and the manager
+// invokes the deleter once every thread that may have loaded the address has
+// completed the access.
+//
+///Critical Sections and Epochs
+///----------------------------
+// A thread accesses the objects protected by a manager only within a
+// *critical* *section*, delimited by calls to 'enter' and 'leave' (usually by
+// the lifetime of an 'EpochManagerGuard').  Critical sections may be nested,
+// are expected to be short, and do not block: entering and leaving a critical
+// section only stores the state of the calling thread in a cache line
+// private to that thread.
+//
+// The manager maintains a global *epoch* number.  On entry to a critical
+// section, a thread announces the current epoch.  An object is retired in the
+// epoch current at the time of 'retire'.  The epoch advances only when every
+// thread in a critical section has announced the current epoch; an object
+// retired in epoch 'E' can therefore no longer be referenced once the epoch
+// reaches 'E + 2', at which point its deleter is invoked.  Note that a thread
+// that stays in a critical section prevents the epoch from advancing, and
+// thus delays the reclamation of the objects retired by all threads.
+//
+// A thread that needs to modify an object it made unreachable, rather than
+// destroy it, may instead call 'synchronize', which waits (outside of any
+// critical section) until the threads that may still be referring to the
+// object have left their critical sections.
+//
+///Quiescent-State-Based Use
+///-------------------------
+// Alternatively, a thread may enter a critical section once, when it starts
+// using a structure, and call 'quiescentState' at points where it holds no
+// address loaded from the structure (e.g., between the requests processed by
+// a server thread).  'quiescentState' announces the current epoch as if the
+// thread had left and re-entered its critical section, at the cost of a
+// single store, so that the epoch can advance while the thread keeps
+// accessing the structure.
+//
+///Thread Registration
+///-------------------
+// A thread is registered with a manager on its first call to 'enter',
+// 'retire', 'retireObject', or 'registerThread'; registration allocates a
+// record for the thread, found through a thread-specific storage key shared by
+// all managers (see 'bdlma_threadcacheregistry'), so that the number of
+// managers is not bounded by the number of keys available to a process (see
+// 'bslmt::ThreadUtil::createKey').  The record of a thread is released when
+// the thread calls 'unregisterThread' or exits; the objects it retired that
+// cannot yet be reclaimed are then handed over to the manager, and reclaimed
+// by other threads (or by the destructor of the manager).
+//
+///Bounded Garbage
+///---------------
+// The objects retired by each thread are held in a list private to the
+// thread until they can be reclaimed.  When the number of objects in that
+// list reaches half the 'maxRetiredPerThread' value supplied at construction
+// (and on exit from the outermost critical section of a thread having
+// reached that threshold), the thread attempts to advance the epoch and
+// reclaims the objects whose grace period has expired.  If the list still
+// holds 'maxRetiredPerThread' objects after the attempt, and the thread is
+// not in a critical section, the thread waits for the other threads to leave
+// (or to announce the current epoch in) their critical sections, so that the
+// number of objects retired by a thread outside a critical section and not
+// yet reclaimed never reaches 'maxRetiredPerThread'.  Note that a thread
+// cannot wait for the reclamation of objects it retired within a critical
+// section, as it is itself preventing the epoch from advancing.
+//
+///Thread Safety
+///-------------
+// 'bdlcc::EpochManager' is *fully thread-safe*, meaning any operation on the
+// same object can be safely invoked from any thread.  The behavior is
+// undefined if a manager is destroyed while any thread is in one of its
+// critical sections.  A manager may be destroyed while threads registered with
+// it exit.  The deleters of retired objects are invoked by the threads calling
+// 'retire', 'retireObject', 'leave', 'quiescentState', and 'reclaim', without
+// holding any lock of the manager; a deleter may retire other objects.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: A Lock-Free Stack
+/// - - - - - - - - - - - - - -
+// Suppose that we want a stack of integers that can be used by many threads
+// without a lock.  A thread popping the top node of a Treiber stack must read
+// the address of the next node from the top node before swapping the top of
+// the stack, while another thread may concurrently pop and destroy the top
+// node; an epoch manager lets the popping thread retire the node instead of
+// destroying it.  Note that, as a node is not reused while a thread may still
+// refer to it, the stack is also immune to the "ABA" problem.
+//
+// First, we define the 'Stack' class:
+//..
+//  class Stack {
+//      // This class implements a lock-free stack of integers whose nodes are
+//      // reclaimed by an epoch manager.
+//
+//      // PRIVATE TYPES
+//      struct Node {
+//          int   d_value;   // value held by this node
+//          Node *d_next_p;  // next node of the stack
+//      };
+//
+//      // DATA
+//      bsls::AtomicPointer<Node>  d_top;          // top of the stack
+//      bdlcc::EpochManager       *d_manager_p;    // manager (held)
+//      bslma::Allocator          *d_allocator_p;  // memory allocator (held)
+//
+//    private:
+//      // NOT IMPLEMENTED
+//      Stack(const Stack&);
+//      Stack& operator=(const Stack&);
+//
+//    public:
+//      // CREATORS
+//      explicit Stack(bdlcc::EpochManager *manager,
+//                     bslma::Allocator    *basicAllocator = 0)
+//      : d_top(0)
+//      , d_manager_p(manager)
+//      , d_allocator_p(bslma::Default::allocator(basicAllocator))
+//      {
+//      }
+//
+//      ~Stack()
+//      {
+//          int value;
+//          while (pop(&value)) {
+//          }
+//      }
+//
+//      // MANIPULATORS
+//      void push(int value)
+//      {
+//          Node *node = new (*d_allocator_p) Node;
+//          node->d_value = value;
+//
+//          Node *top;
+//          do {
+//              top = d_top;
+//              node->d_next_p = top;
+//          } while (top != d_top.testAndSwap(top, node));
+//      }
+//
+//      bool pop(int *value)
+//      {
+//          bdlcc::EpochManagerGuard guard(d_manager_p);
+//
+//          Node *top;
+//          do {
+//              top = d_top;
+//              if (!top) {
+//                  return false;                                 // RETURN
+//              }
+//          } while (top != d_top.testAndSwap(top, top->d_next_p));
+//
+//          *value = top->d_value;
+//
+//          d_manager_p->retireObject(top, d_allocator_p);
+//          return true;
+//      }
+//  };
+//..
+// Notice that 'pop' dereferences 'top' only within a critical section, and
+// that the node it removes is retired rather than deleted.
+//
+// Then, we create an epoch manager and a stack, and push a few values:
+//..
+//  bslma::TestAllocator ta;
+//  bdlcc::EpochManager  manager;
+//  {
+//      Stack stack(&manager, &ta);
+//
+//      for (int i = 0; i < 3; ++i) {
+//          stack.push(i);
+//      }
+//..
+// Next, we pop one value.  The removed node is retired, but not yet deleted:
+//..
+//      int value;
+//      assert(stack.pop(&value));
+//      assert(2 == value);
+//
+//      assert(1 == manager.numRetired());
+//      assert(3 == ta.numBlocksInUse());
+//..
+// Now, as no thread is in a critical section of 'manager', the node can be
+// reclaimed explicitly:
+//..
+//      manager.reclaim();
+//
+//      assert(0 == manager.numRetired());
+//      assert(2 == ta.numBlocksInUse());
+//  }
+//..
+// Finally, we note that the nodes popped by the destructor of the stack are
+// reclaimed when the manager is destroyed, if not before.
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_THREADCACHEREGISTRY
+#include <bdlma_threadcacheregistry.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DELETERHELPER
+#include <bslma_deleterhelper.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_USESBSLMAALLOCATOR
+#include <bslma_usesbslmaallocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_NESTEDTRAITDECLARATION
+#include <bslmf_nestedtraitdeclaration.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_MUTEX
+#include <bslmt_mutex.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlcc {
+
+struct EpochManager_ThreadRecord;
+
+                            // ==================
+                            // class EpochManager
+                            // ==================
+
+class EpochManager {
+    // This class provides a mechanism deferring the destruction of retired
+    // objects until no thread may still be accessing them, as determined by
+    // the epochs announced by the threads on entry to their critical
+    // sections.
+
+  public:
+    // TYPES
+    typedef void (*Deleter)(void *object, bslma::Allocator *allocator);
+        // 'Deleter' is an alias for a function destroying the specified
+        // 'object' and returning its memory to the specified 'allocator'.
+
+  private:
+    // PRIVATE TYPES
+    struct Retired {
+        // This 'struct' describes a retired object.
+
+        void               *d_object_p;     // retired object
+        Deleter             d_deleter;      // reclaims the object
+        bslma::Allocator   *d_allocator_p;  // passed to 'd_deleter'
+        bsls::Types::Int64  d_epoch;        // epoch of retirement
+    };
+
+    typedef EpochManager_ThreadRecord Record;
+
+    template <class TYPE>
+    struct DeleteUtil {
+        // This 'struct' provides a deleter for objects of the parameterized
+        // 'TYPE'.
+
+        static void deleteObject(void *object, bslma::Allocator *allocator);
+            // Destroy the specified 'object' of 'TYPE' and return its memory
+            // to the specified 'allocator'.
+    };
+
+    // DATA
+    bsls::AtomicInt64                   d_epoch;          // global epoch
+
+    const int                           d_maxRetired;     // bound on the
+                                                          // objects retired
+                                                          // by a thread
+
+    bdlma::ThreadCacheRegistry          d_records;        // record of each
+                                                          // registered
+                                                          // thread; supplies
+                                                          // all the memory
+                                                          // of this manager
+
+    bslmt::Mutex                        d_mutex;          // protects the
+                                                          // orphans
+
+    bsl::vector<Retired>                d_orphans;        // objects retired
+                                                          // by unregistered
+                                                          // threads
+
+    bsls::AtomicInt                     d_numOrphans;     // size of
+                                                          // 'd_orphans'
+
+    // PRIVATE CLASS METHODS
+    static void releaseRecord(void *record, void *manager);
+        // Hand over the objects retired by the thread of the specified
+        // 'record' to the specified 'manager', and destroy 'record'.  Note
+        // that this method is called on exit of each registered thread.
+
+    // PRIVATE MANIPULATORS
+    void collect(Record *record);
+        // Invoke the deleters of the objects retired by the thread of the
+        // specified 'record' whose grace period has expired, and of the
+        // objects handed over by unregistered threads whose grace period has
+        // expired.
+
+    Record *localRecord();
+        // Return the address of the record of the calling thread, registering
+        // the calling thread if needed.
+
+    void reclaimOrphans();
+        // Invoke the deleters of the objects handed over by unregistered
+        // threads whose grace period has expired.
+
+    void reclaimRetired(Record *record);
+        // Attempt to reclaim the objects retired by the thread of the
+        // specified 'record' if they reach the reclamation threshold and,
+        // unless that thread is in a critical section, wait until they number
+        // less than 'maxRetiredPerThread()'.
+
+    bool tryAdvance();
+        // Advance the epoch of this manager if every thread in a critical
+        // section has announced the current epoch.  Return 'true' if the
+        // epoch was advanced (by this or another thread), and 'false'
+        // otherwise.
+
+    void unregister(Record *record);
+        // Hand over the objects retired by the thread of the specified
+        // 'record' to this manager, and destroy 'record'.
+
+    // FRIENDS
+    friend struct EpochManager_ThreadRecord;
+
+  private:
+    // NOT IMPLEMENTED
+    EpochManager(const EpochManager&);
+    EpochManager& operator=(const EpochManager&);
+
+  public:
+    // TYPES
+    enum {
+        k_DEFAULT_MAX_RETIRED_PER_THREAD = 256  // default garbage bound
+    };
+
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(EpochManager, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit
+    EpochManager(bslma::Allocator *basicAllocator = 0);
+    explicit
+    EpochManager(int               maxRetiredPerThread,
+                 bslma::Allocator *basicAllocator = 0);
+        // Create an epoch manager having no registered thread.  Optionally
+        // specify 'maxRetiredPerThread', the number of objects retired by a
+        // thread and not yet reclaimed at which the thread waits for their
+        // reclamation (see {Bounded Garbage}); if 'maxRetiredPerThread' is not
+        // specified, 'k_DEFAULT_MAX_RETIRED_PER_THREAD' is used.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '0 < maxRetiredPerThread'.
+
+    ~EpochManager();
+        // Destroy this object, invoking the deleters of all the objects
+        // retired and not yet reclaimed.  The behavior is undefined if any
+        // thread is in a critical section of this manager.
+
+    // MANIPULATORS
+    void enter();
+        // Enter a critical section of this manager, registering the calling
+        // thread if needed.  If the calling thread is not already in a
+        // critical section, announce the current epoch.  Every call to
+        // 'enter' must be matched by a call to 'leave' from the same thread.
+
+    void leave();
+        // Leave the critical section entered by the matching call to 'enter'.
+        // If the calling thread is no longer in any critical section and has
+        // retired at least half of 'maxRetiredPerThread()' objects not yet
+        // reclaimed, attempt to reclaim them, and wait until they number less
+        // than 'maxRetiredPerThread()'.  The behavior is undefined unless the
+        // calling thread is in a critical section of this manager.
+
+    void quiescentState();
+        // Announce that the calling thread holds no reference obtained in its
+        // current critical section, so that the epoch may advance although
+        // the thread remains in its critical section (see {Quiescent-State-
+        // Based Use}), and attempt to reclaim the objects retired by the
+        // calling thread if they number at least half of
+        // 'maxRetiredPerThread()' (waiting until they number less than
+        // 'maxRetiredPerThread()' if the calling thread is not in a critical
+        // section).  This method has no effect on the critical section state
+        // of a thread that is not in a critical section.
+
+    void reclaim();
+        // Attempt to advance the epoch, and invoke the deleters of the
+        // objects retired by the calling thread, or by unregistered threads,
+        // whose grace period has expired.  Note that the objects retired in
+        // the current epoch are reclaimed only if the epoch can be advanced
+        // twice, i.e., if no other thread is in a critical section.
+
+    void registerThread();
+        // Register the calling thread with this manager if it is not already
+        // registered.  Note that threads are registered on their first use of
+        // this manager, so that calling this method is optional.
+
+    void retire(void *object, Deleter deleter, bslma::Allocator *allocator);
+        // Retire the specified 'object', which has been made unreachable to
+        // threads entering a critical section from now on: the specified
+        // 'deleter' is invoked with 'object' and the specified 'allocator'
+        // once no thread may still be accessing 'object'.  Attempt to reclaim
+        // the objects retired by the calling thread if they number at least
+        // half of 'maxRetiredPerThread()', and, if the calling thread is not
+        // in a critical section, wait until they number less than
+        // 'maxRetiredPerThread()'.  The behavior is undefined unless
+        // 'deleter' is not 0.
+
+    template <class TYPE>
+    void retireObject(TYPE *object, bslma::Allocator *allocator = 0);
+        // Retire the specified 'object', as if by calling 'retire' with a
+        // deleter destroying 'object' and returning its memory to the
+        // optionally specified 'allocator'.  If 'allocator' is 0, the
+        // currently installed default allocator is used.  The behavior is
+        // undefined unless 'object' was allocated from 'allocator' (or the
+        // default allocator) and is of the most derived type 'TYPE' or has a
+        // virtual destructor.
+
+    void synchronize();
+        // Wait until every thread that was in a critical section of this
+        // manager when this method was called has left it (or announced a
+        // quiescent state), so that no thread still refers to an object made
+        // unreachable before the call.  The behavior is undefined if the
+        // calling thread is in a critical section of this manager.  Note that
+        // this method does not reclaim retired objects.
+
+    void unregisterThread();
+        // Unregister the calling thread from this manager, handing over the
+        // objects it retired that cannot yet be reclaimed to the manager.
+        // This method has no effect if the calling thread is not registered.
+        // The behavior is undefined if the calling thread is in a critical
+        // section of this manager.
+
+    // ACCESSORS
+    bsls::Types::Int64 epoch() const;
+        // Return the current epoch of this manager.
+
+    bool isInCriticalSection() const;
+        // Return 'true' if the calling thread is in a critical section of
+        // this manager, and 'false' otherwise.
+
+    int maxRetiredPerThread() const;
+        // Return the number of objects retired by a thread and not yet
+        // reclaimed at which the thread waits for their reclamation.
+
+    int numOrphans() const;
+        // Return a *snapshot* of the number of objects retired by
+        // unregistered threads and not yet reclaimed.
+
+    int numRetired() const;
+        // Return the number of objects retired by the calling thread and not
+        // yet reclaimed.
+
+    int numThreads() const;
+        // Return a *snapshot* of the number of threads registered with this
+        // manager.
+};
+
+                          // =======================
+                          // class EpochManagerGuard
+                          // =======================
+
+class EpochManagerGuard {
+    // This class implements a guard keeping the calling thread in a critical
+    // section of an epoch manager for the lifetime of the guard.
+
+    // DATA
+    EpochManager *d_manager_p;  // manager (held, not owned)
+
+  private:
+    // NOT IMPLEMENTED
+    EpochManagerGuard(const EpochManagerGuard&);
+    EpochManagerGuard& operator=(const EpochManagerGuard&);
+
+  public:
+    // CREATORS
+    explicit EpochManagerGuard(EpochManager *manager);
+        // Enter a critical section of the specified 'manager'.
+
+    ~EpochManagerGuard();
+        // Leave the critical section entered on construction.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                            // ------------------
+                            // class EpochManager
+                            // ------------------
+
+// PRIVATE TYPES
+template <class TYPE>
+void EpochManager::DeleteUtil<TYPE>::deleteObject(void             *object,
+                                                  bslma::Allocator *allocator)
+{
+    bslma::DeleterHelper::deleteObject(static_cast<TYPE *>(object),
+                                       allocator);
+}
+
+// MANIPULATORS
+template <class TYPE>
+inline
+void EpochManager::retireObject(TYPE *object, bslma::Allocator *allocator)
+{
+    BSLS_ASSERT_SAFE(object);
+
+    retire(const_cast<void *>(static_cast<const volatile void *>(object)),
+           &DeleteUtil<TYPE>::deleteObject,
+           bslma::Default::allocator(allocator));
+}
+
+// ACCESSORS
+inline
+bsls::Types::Int64 EpochManager::epoch() const
+{
+    return d_epoch.load();
+}
+
+inline
+int EpochManager::maxRetiredPerThread() const
+{
+    return d_maxRetired;
+}
+
+inline
+int EpochManager::numOrphans() const
+{
+    return d_numOrphans.loadRelaxed();
+}
+
+                          // -----------------------
+                          // class EpochManagerGuard
+                          // -----------------------
+
+// CREATORS
+inline
+EpochManagerGuard::EpochManagerGuard(EpochManager *manager)
+: d_manager_p(manager)
+{
+    BSLS_ASSERT_SAFE(manager);
+
+    d_manager_p->enter();
+}
+
+inline
+EpochManagerGuard::~EpochManagerGuard()
+{
+    d_manager_p->leave();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
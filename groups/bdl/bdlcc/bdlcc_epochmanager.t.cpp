@@ -0,0 +1,1579 @@
+// bdlcc_epochmanager.t.cpp                                           -*-C++-*-
+#include <bdlcc_epochmanager.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_mutex.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>     // 'atoi'
+#include <bsl_iostream.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a mechanism reclaiming retired objects once the
+// epoch it maintains has advanced twice, the epoch advancing only when every
+// thread in a critical section has announced the current epoch.  We verify,
+// using deleters recording their invocations, that a retired object is
+// reclaimed exactly once, with the supplied allocator, and not before its
+// grace period expired; that a thread in a critical section prevents the
+// epoch from advancing unless it announces a quiescent state; that the
+// objects retired by an exiting or unregistered thread are reclaimed by other
+// threads or by the destructor; and that 'retire' bounds the garbage of a
+// thread outside a critical section.  Finally, we verify that a lock-free
+// stack whose nodes are reclaimed by the manager never accesses a reclaimed
+// node while many threads push and pop concurrently.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] EpochManager(Allocator *ba = 0);
+// [ 2] EpochManager(int maxRetiredPerThread, Allocator *ba = 0);
+// [ 5] ~EpochManager();
+// [ 3] EpochManagerGuard(EpochManager *manager);
+// [ 3] ~EpochManagerGuard();
+//
+// MANIPULATORS
+// [ 3] void enter();
+// [ 3] void leave();
+// [ 7] void quiescentState();
+// [ 3] void reclaim();
+// [ 2] void registerThread();
+// [ 4] void retire(void *object, Deleter deleter, Allocator *allocator);
+// [ 4] void retireObject(TYPE *object, Allocator *allocator = 0);
+// [ 3] void synchronize();
+// [ 5] void unregisterThread();
+//
+// ACCESSORS
+// [ 3] Int64 epoch() const;
+// [ 3] bool isInCriticalSection() const;
+// [ 2] int maxRetiredPerThread() const;
+// [ 5] int numOrphans() const;
+// [ 4] int numRetired() const;
+// [ 2] int numThreads() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] THREAD EXIT AND ORPHANED OBJECTS
+// [ 6] BOUNDED GARBAGE
+// [ 8] CONCURRENCY
+// [ 9] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_PASS(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(EXPR)
+#define ASSERT_SAFE_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(EXPR)
+#define ASSERT_PASS(EXPR)      BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_FAIL(EXPR)      BSLS_ASSERTTEST_ASSERT_FAIL(EXPR)
+#define ASSERT_OPT_PASS(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR)  BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlcc::EpochManager      Obj;
+typedef bdlcc::EpochManagerGuard Guard;
+
+static bool verbose;
+static bool veryVerbose;
+
+                           // ======================
+                           // struct DeleterRecorder
+                           // ======================
+
+struct DeleterRecorder {
+    // This 'struct' records the invocations of 'recordingDeleter'.
+
+    enum { k_MAX_OBJECTS = 1024 };
+
+    static bsls::AtomicInt   s_numDeleted;               // invocations
+    static bsls::AtomicInt   s_counts[k_MAX_OBJECTS];    // per object
+    static bslma::Allocator *s_lastAllocator_p;          // last allocator
+
+    static void reset()
+        // Reset all the recorded invocations.
+    {
+        s_numDeleted = 0;
+        for (int i = 0; i < k_MAX_OBJECTS; ++i) {
+            s_counts[i] = 0;
+        }
+        s_lastAllocator_p = 0;
+    }
+};
+
+bsls::AtomicInt   DeleterRecorder::s_numDeleted;
+bsls::AtomicInt   DeleterRecorder::s_counts[DeleterRecorder::k_MAX_OBJECTS];
+bslma::Allocator *DeleterRecorder::s_lastAllocator_p = 0;
+
+static int objects[DeleterRecorder::k_MAX_OBJECTS];
+    // Objects retired in the tests; 'objects[i]' holds 'i'.
+
+void recordingDeleter(void *object, bslma::Allocator *allocator)
+    // Record the deletion of the specified 'object', which must be an element
+    // of 'objects', with the specified 'allocator'.
+{
+    const int index = *static_cast<int *>(object);
+    ASSERT(&objects[index] == object);
+
+    ++DeleterRecorder::s_counts[index];
+    ++DeleterRecorder::s_numDeleted;
+    DeleterRecorder::s_lastAllocator_p = allocator;
+}
+
+static Obj *chainManager = 0;
+    // Manager to which 'chainingDeleter' retires an object.
+
+void chainingDeleter(void *object, bslma::Allocator *allocator)
+    // Record the deletion of the specified 'object' with the specified
+    // 'allocator', and retire the next element of 'objects' to
+    // 'chainManager'.
+{
+    recordingDeleter(object, allocator);
+
+    const int index = *static_cast<int *>(object);
+    chainManager->retire(&objects[index + 1], &recordingDeleter, 0);
+}
+
+void noopDeleter(void *, bslma::Allocator *)
+    // Do nothing.
+{
+}
+
+                            // ====================
+                            // struct SectionHolder
+                            // ====================
+
+struct SectionHolder {
+    // This 'struct' describes a thread holding a critical section of a
+    // manager until requested to leave it.
+
+    Obj             *d_manager_p;  // manager
+    bslmt::Barrier  *d_entered_p;  // waited on once in the section
+    bsls::AtomicInt  d_release;    // set to request leaving the section
+    bsls::AtomicInt  d_left;       // set once the section was left
+    bsls::AtomicInt  d_quiescent;  // set to request a quiescent state
+    int              d_numQuiescent;  // quiescent states announced
+
+    SectionHolder(Obj *manager, bslmt::Barrier *entered)
+    : d_manager_p(manager)
+    , d_entered_p(entered)
+    , d_release(0)
+    , d_left(0)
+    , d_quiescent(0)
+    , d_numQuiescent(0)
+    {
+    }
+};
+
+extern "C" void *holdSection(void *arg)
+    // Enter a critical section of the manager of the specified 'arg', which
+    // must be a 'SectionHolder', wait on its barrier, announce a quiescent
+    // state each time it is requested, and leave the section once requested.
+{
+    SectionHolder *holder = static_cast<SectionHolder *>(arg);
+
+    holder->d_manager_p->enter();
+    holder->d_entered_p->wait();
+
+    while (!holder->d_release) {
+        if (holder->d_quiescent) {
+            holder->d_manager_p->quiescentState();
+            ++holder->d_numQuiescent;
+            holder->d_quiescent = 0;
+        }
+        bslmt::ThreadUtil::yield();
+    }
+
+    holder->d_left = 1;
+    holder->d_manager_p->leave();
+
+    return 0;
+}
+
+                          // ========================
+                          // struct SynchronizeThread
+                          // ========================
+
+struct SynchronizeThread {
+    // This 'struct' describes a thread calling 'synchronize' on a manager.
+
+    Obj             *d_manager_p;  // manager
+    bsls::AtomicInt  d_done;       // set once 'synchronize' returned
+
+    explicit SynchronizeThread(Obj *manager)
+    : d_manager_p(manager)
+    , d_done(0)
+    {
+    }
+};
+
+extern "C" void *synchronizeManager(void *arg)
+    // Call 'synchronize' on the manager of the specified 'arg', which must be
+    // a 'SynchronizeThread', and record that it returned.
+{
+    SynchronizeThread *job = static_cast<SynchronizeThread *>(arg);
+
+    job->d_manager_p->synchronize();
+    job->d_done = 1;
+
+    return 0;
+}
+
+                            // ===================
+                            // struct RetireThread
+                            // ===================
+
+struct RetireThread {
+    // This 'struct' describes a thread retiring a range of 'objects' with
+    // 'recordingDeleter'.
+
+    Obj *d_manager_p;    // manager
+    int  d_begin;        // first index of the range
+    int  d_end;          // one past the last index of the range
+    bool d_unregister;   // whether to unregister explicitly
+};
+
+extern "C" void *retireRange(void *arg)
+    // Retire the range of 'objects' described by the specified 'arg', which
+    // must be a 'RetireThread', and optionally unregister from its manager.
+{
+    RetireThread *job = static_cast<RetireThread *>(arg);
+
+    for (int i = job->d_begin; i < job->d_end; ++i) {
+        job->d_manager_p->retire(&objects[i], &recordingDeleter, 0);
+    }
+    if (job->d_unregister) {
+        job->d_manager_p->unregisterThread();
+        ASSERT(0 == job->d_manager_p->numRetired());
+    }
+
+    return 0;
+}
+
+                             // ==================
+                             // class CheckedStack
+                             // ==================
+
+class CheckedStack {
+    // This class implements a lock-free stack of integers, whose nodes are
+    // reclaimed by an epoch manager, that verifies that no reclaimed node is
+    // accessed.
+
+    // PRIVATE TYPES
+    enum { k_LIVE = 0x11f3, k_DEAD = 0xdead };
+
+    struct Node {
+        int   d_value;   // value held by this node
+        int   d_state;   // 'k_LIVE' until destroyed
+        Node *d_next_p;  // next node of the stack
+
+        ~Node()
+        {
+            ASSERT(k_LIVE == d_state);
+            d_state = k_DEAD;
+        }
+    };
+
+    // DATA
+    bsls::AtomicPointer<Node>  d_top;          // top of the stack
+    Obj                       *d_manager_p;    // manager (held)
+    bslma::Allocator          *d_allocator_p;  // memory allocator (held)
+
+  private:
+    // NOT IMPLEMENTED
+    CheckedStack(const CheckedStack&);
+    CheckedStack& operator=(const CheckedStack&);
+
+  public:
+    // CREATORS
+    CheckedStack(Obj *manager, bslma::Allocator *basicAllocator)
+    : d_top(0)
+    , d_manager_p(manager)
+    , d_allocator_p(basicAllocator)
+    {
+    }
+
+    // MANIPULATORS
+    void push(int value)
+        // Push the specified 'value'.
+    {
+        Node *node = new (*d_allocator_p) Node;
+        node->d_value = value;
+        node->d_state = k_LIVE;
+
+        Node *top;
+        do {
+            top = d_top;
+            node->d_next_p = top;
+        } while (top != d_top.testAndSwap(top, node));
+    }
+
+    bool pop(int *value)
+        // Pop the top value into the specified 'value' and return 'true', or
+        // return 'false' if the stack is empty.  The behavior is undefined
+        // unless the calling thread is in a critical section of the manager
+        // of this stack.
+    {
+        Node *top;
+        do {
+            top = d_top;
+            if (!top) {
+                return false;                                         // RETURN
+            }
+            ASSERT(k_LIVE == top->d_state);
+        } while (top != d_top.testAndSwap(top, top->d_next_p));
+
+        *value = top->d_value;
+        d_manager_p->retireObject(top, d_allocator_p);
+        return true;
+    }
+
+    // ACCESSORS
+    int peek() const
+        // Return the sum of the values of the top two nodes, or -1 if the
+        // stack holds less than two nodes.  The behavior is undefined unless
+        // the calling thread is in a critical section of the manager of this
+        // stack.
+    {
+        const Node *top = d_top;
+        if (!top) {
+            return -1;                                                // RETURN
+        }
+        ASSERT(k_LIVE == top->d_state);
+
+        const Node *next = top->d_next_p;
+        if (!next) {
+            return -1;                                                // RETURN
+        }
+        ASSERT(k_LIVE == next->d_state);
+
+        return top->d_value + next->d_value;
+    }
+};
+
+                             // ==================
+                             // struct StackThread
+                             // ==================
+
+struct StackThread {
+    // This 'struct' describes a thread using a 'CheckedStack'.
+
+    CheckedStack       *d_stack_p;        // stack
+    Obj                *d_manager_p;      // manager of the stack
+    bslmt::Barrier     *d_barrier_p;      // start barrier
+    int                 d_numIterations;  // number of push/pop pairs
+    bool                d_quiescent;      // use quiescent states
+    bsls::Types::Int64  d_pushed;         // sum of the pushed values
+    bsls::Types::Int64  d_popped;         // sum of the popped values
+};
+
+extern "C" void *useCheckedStack(void *arg)
+    // Push and pop values on the stack of the specified 'arg', which must be
+    // a 'StackThread', peeking at the stack between operations, using a
+    // guard for each operation, or a single critical section and quiescent
+    // states.
+{
+    StackThread *job = static_cast<StackThread *>(arg);
+
+    job->d_barrier_p->wait();
+
+    if (job->d_quiescent) {
+        job->d_manager_p->enter();
+    }
+
+    for (int i = 0; i < job->d_numIterations; ++i) {
+        job->d_stack_p->push(i);
+        job->d_pushed += i;
+
+        int value;
+        if (job->d_quiescent) {
+            job->d_stack_p->peek();
+            if (job->d_stack_p->pop(&value)) {
+                job->d_popped += value;
+            }
+            job->d_manager_p->quiescentState();
+        }
+        else {
+            {
+                Guard guard(job->d_manager_p);
+                job->d_stack_p->peek();
+            }
+            Guard guard(job->d_manager_p);
+            if (job->d_stack_p->pop(&value)) {
+                job->d_popped += value;
+            }
+        }
+        if (!job->d_quiescent) {
+            ASSERT(job->d_manager_p->numRetired() <
+                                      job->d_manager_p->maxRetiredPerThread());
+        }
+    }
+
+    if (job->d_quiescent) {
+        job->d_manager_p->leave();
+    }
+
+    return 0;
+}
+
+                           // ======================
+                           // struct BenchmarkThread
+                           // ======================
+
+struct BenchmarkThread {
+    // This 'struct' describes a thread measuring the cost of critical
+    // sections.
+
+    Obj            *d_manager_p;      // manager
+    bslmt::Mutex   *d_mutex_p;        // mutex, or 0 to use the manager
+    bslmt::Barrier *d_barrier_p;      // start barrier
+    int             d_numIterations;  // number of critical sections
+    bool            d_retire;         // retire an object in each section
+};
+
+extern "C" void *benchmark(void *arg)
+    // Enter and leave critical sections as described by the specified 'arg',
+    // which must be a 'BenchmarkThread'.
+{
+    BenchmarkThread *job = static_cast<BenchmarkThread *>(arg);
+
+    job->d_barrier_p->wait();
+
+    if (job->d_mutex_p) {
+        for (int i = 0; i < job->d_numIterations; ++i) {
+            job->d_mutex_p->lock();
+            job->d_mutex_p->unlock();
+        }
+        return 0;                                                     // RETURN
+    }
+
+    for (int i = 0; i < job->d_numIterations; ++i) {
+        Guard guard(job->d_manager_p);
+        if (job->d_retire) {
+            job->d_manager_p->retire(&objects[0], &noopDeleter, 0);
+        }
+    }
+    return 0;
+}
+
+double runBenchmark(int  numThreads,
+                    int  numIterations,
+                    Obj *manager,
+                    bool useMutex,
+                    bool retire)
+    // Return the wall time, in seconds, taken by the specified 'numThreads'
+    // threads each performing the specified 'numIterations' critical
+    // sections of the specified 'manager' (retiring an object in each
+    // section if the specified 'retire' is 'true'), or locking and unlocking
+    // a mutex if the specified 'useMutex' is 'true'.
+{
+    bslmt::Mutex   mutex;
+    bslmt::Barrier barrier(numThreads + 1);
+
+    BenchmarkThread job = { manager,
+                            useMutex ? &mutex : 0,
+                            &barrier,
+                            numIterations,
+                            retire };
+
+    bslmt::ThreadUtil::Handle handles[64];
+    for (int i = 0; i < numThreads; ++i) {
+        ASSERT(0 == bslmt::ThreadUtil::create(&handles[i], &benchmark, &job));
+    }
+
+    bsls::Stopwatch timer;
+    timer.start();
+
+    barrier.wait();
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::join(handles[i]);
+    }
+
+    timer.stop();
+    return timer.accumulatedWallTime();
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+namespace BDLCC_EPOCHMANAGER_USAGE_EXAMPLE {
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: A Lock-Free Stack
+/// - - - - - - - - - - - - - -
+// Suppose that we want a stack of integers that can be used by many threads
+// without a lock.  A thread popping the top node of a Treiber stack must read
+// the address of the next node from the top node before swapping the top of
+// the stack, while another thread may concurrently pop and destroy the top
+// node; an epoch manager lets the popping thread retire the node instead of
+// destroying it.  Note that, as a node is not reused while a thread may still
+// refer to it, the stack is also immune to the "ABA" problem.
+//
+// First, we define the 'Stack' class:
+//..
+class Stack {
+    // This class implements a lock-free stack of integers whose nodes are
+    // reclaimed by an epoch manager.
+
+    // PRIVATE TYPES
+    struct Node {
+        int   d_value;   // value held by this node
+        Node *d_next_p;  // next node of the stack
+    };
+
+    // DATA
+    bsls::AtomicPointer<Node>  d_top;          // top of the stack
+    bdlcc::EpochManager       *d_manager_p;    // manager (held)
+    bslma::Allocator          *d_allocator_p;  // memory allocator (held)
+
+  private:
+    // NOT IMPLEMENTED
+    Stack(const Stack&);
+    Stack& operator=(const Stack&);
+
+  public:
+    // CREATORS
+    explicit Stack(bdlcc::EpochManager *manager,
+                   bslma::Allocator    *basicAllocator = 0)
+    : d_top(0)
+    , d_manager_p(manager)
+    , d_allocator_p(bslma::Default::allocator(basicAllocator))
+    {
+    }
+
+    ~Stack()
+    {
+        int value;
+        while (pop(&value)) {
+        }
+    }
+
+    // MANIPULATORS
+    void push(int value)
+    {
+        Node *node = new (*d_allocator_p) Node;
+        node->d_value = value;
+
+        Node *top;
+        do {
+            top = d_top;
+            node->d_next_p = top;
+        } while (top != d_top.testAndSwap(top, node));
+    }
+
+    bool pop(int *value)
+    {
+        bdlcc::EpochManagerGuard guard(d_manager_p);
+
+        Node *top;
+        do {
+            top = d_top;
+            if (!top) {
+                return false;                                 // RETURN
+            }
+        } while (top != d_top.testAndSwap(top, top->d_next_p));
+
+        *value = top->d_value;
+
+        d_manager_p->retireObject(top, d_allocator_p);
+        return true;
+    }
+};
+//..
+// Notice that 'pop' dereferences 'top' only within a critical section, and
+// that the node it removes is retired rather than deleted.
+//
+
+}  // close namespace BDLCC_EPOCHMANAGER_USAGE_EXAMPLE
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int  test            = argc > 1 ? atoi(argv[1]) : 0;
+                verbose         = argc > 2;
+                veryVerbose     = argc > 3;
+    const bool veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    for (int i = 0; i < DeleterRecorder::k_MAX_OBJECTS; ++i) {
+        objects[i] = i;
+    }
+
+    bslma::TestAllocator da("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    switch (test) { case 0:
+      case 9: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        using namespace BDLCC_EPOCHMANAGER_USAGE_EXAMPLE;
+
+// Then, we create an epoch manager and a stack, and push a few values:
+//..
+    bslma::TestAllocator ta;
+    bdlcc::EpochManager  manager;
+    {
+        Stack stack(&manager, &ta);
+
+        for (int i = 0; i < 3; ++i) {
+            stack.push(i);
+        }
+//..
+// Next, we pop one value.  The removed node is retired, but not yet deleted:
+//..
+        int value;
+        ASSERT(stack.pop(&value));
+        ASSERT(2 == value);
+
+        ASSERT(1 == manager.numRetired());
+        ASSERT(3 == ta.numBlocksInUse());
+//..
+// Now, as no thread is in a critical section of 'manager', the node can be
+// reclaimed explicitly:
+//..
+        manager.reclaim();
+
+        ASSERT(0 == manager.numRetired());
+        ASSERT(2 == ta.numBlocksInUse());
+    }
+//..
+// Finally, we note that the nodes popped by the destructor of the stack are
+// reclaimed when the manager is destroyed, if not before.
+      } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY
+        //
+        // Concerns:
+        //: 1 A node of a lock-free stack reclaimed by the manager is never
+        //:   accessed, while many threads concurrently push, pop, and peek
+        //:   (dereferencing two nodes), using either a guard for each
+        //:   operation, or a single critical section and quiescent states.
+        //:
+        //: 2 Every popped value was pushed, and every node is reclaimed.
+        //:
+        //: 3 The garbage of the threads using guards remains bounded.
+        //
+        // Plan:
+        //: 1 Run threads pushing and popping values on a stack whose nodes
+        //:   verify that they are live when accessed, and are scribbled on
+        //:   when reclaimed.  Half of the threads use guards, and verify the
+        //:   number of objects they retired after each pop; the other half
+        //:   use a single critical section and announce a quiescent state
+        //:   after each pop.  (C-1, 3)
+        //:
+        //: 2 Pop the remaining values, destroy the manager, and verify that
+        //:   the sums of the pushed and popped values are equal, and that all
+        //:   nodes were returned to the allocator.  (C-2)
+        //
+        // Testing:
+        //   CONCURRENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY" << endl
+                          << "===========" << endl;
+
+        enum { k_NUM_THREADS = 8, k_NUM_ITERATIONS = 20000 };
+
+        bslma::TestAllocator ta("nodes", veryVeryVerbose);
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        bsls::Types::Int64 pushed = 0;
+        bsls::Types::Int64 popped = 0;
+        {
+            Obj   mX(16, &oa);
+            CheckedStack stack(&mX, &ta);
+
+            bslmt::Barrier            barrier(k_NUM_THREADS);
+            StackThread               jobs[k_NUM_THREADS];
+            bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                StackThread job = { &stack,
+                                    &mX,
+                                    &barrier,
+                                    k_NUM_ITERATIONS,
+                                    1 == i % 2,
+                                    0,
+                                    0 };
+                jobs[i] = job;
+                ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                      &useCheckedStack,
+                                                      &jobs[i]));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                bslmt::ThreadUtil::join(handles[i]);
+                pushed += jobs[i].d_pushed;
+                popped += jobs[i].d_popped;
+            }
+
+            ASSERT(0 == mX.numThreads());
+
+            Guard guard(&mX);
+
+            int value;
+            while (stack.pop(&value)) {
+                popped += value;
+            }
+        }
+        ASSERTV(pushed, popped, pushed == popped);
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // QUIESCENT STATES
+        //
+        // Concerns:
+        //: 1 A thread remaining in a critical section prevents the epoch from
+        //:   advancing more than once, unless it announces quiescent states.
+        //:
+        //: 2 Each quiescent state allows the epoch to advance once more.
+        //:
+        //: 3 'quiescentState' has no effect on the critical section state of
+        //:   a thread that is not in a critical section, or not registered.
+        //
+        // Plan:
+        //: 1 Keep a thread in a critical section, request quiescent states
+        //:   from it, and verify the epoch reached by 'reclaim' and the
+        //:   objects it reclaims.  (C-1..2)
+        //:
+        //: 2 Call 'quiescentState' from an unregistered thread and from a
+        //:   registered thread outside a critical section.  (C-3)
+        //
+        // Testing:
+        //   void quiescentState();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "QUIESCENT STATES" << endl
+                          << "================" << endl;
+
+        DeleterRecorder::reset();
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            mX.quiescentState();
+            ASSERT(0 == X.numThreads());
+
+            bslmt::Barrier            entered(2);
+            SectionHolder             holder(&mX, &entered);
+            bslmt::ThreadUtil::Handle handle;
+
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  &holdSection,
+                                                  &holder));
+            entered.wait();
+
+            const bsls::Types::Int64 EPOCH = X.epoch();
+
+            mX.retire(&objects[0], &recordingDeleter, 0);
+
+            mX.reclaim();
+            ASSERT(EPOCH + 1 == X.epoch());
+            mX.reclaim();
+            ASSERT(EPOCH + 1 == X.epoch());
+            ASSERT(1 == X.numRetired());
+
+            for (int i = 1; i <= 3; ++i) {
+                holder.d_quiescent = 1;
+                while (holder.d_quiescent) {
+                    bslmt::ThreadUtil::yield();
+                }
+                ASSERT(i == holder.d_numQuiescent);
+
+                mX.reclaim();
+                ASSERTV(i, X.epoch(), EPOCH + 1 + i == X.epoch());
+                ASSERT(0 == X.numRetired());
+                ASSERT(1 == DeleterRecorder::s_numDeleted);
+            }
+            ASSERT(1 == DeleterRecorder::s_counts[0]);
+
+            holder.d_release = 1;
+            bslmt::ThreadUtil::join(handle);
+
+            mX.quiescentState();
+            ASSERT(!X.isInCriticalSection());
+        }
+        ASSERT(1 == DeleterRecorder::s_numDeleted);
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // BOUNDED GARBAGE
+        //
+        // Concerns:
+        //: 1 A thread outside a critical section whose retired objects reach
+        //:   'maxRetiredPerThread()' waits in 'retire' until the other
+        //:   threads allow their reclamation.
+        //:
+        //: 2 A thread retiring objects within a critical section does not
+        //:   wait, and reclaims them once it leaves the section.
+        //:
+        //: 3 A thread attempts to reclaim its objects once they number at
+        //:   least half of 'maxRetiredPerThread()'.
+        //
+        // Plan:
+        //: 1 Keep a second thread in a critical section, and retire objects
+        //:   from the main thread outside any critical section; verify that
+        //:   the epoch advances once the threshold is reached, and that the
+        //:   retiring of the 'maxRetiredPerThread()'th object returns only
+        //:   after the second thread left its section.  (C-1, 3)
+        //:
+        //: 2 Retire more than 'maxRetiredPerThread()' objects within a
+        //:   critical section, and verify that they are reclaimed on leaving
+        //:   the section.  (C-2)
+        //
+        // Testing:
+        //   BOUNDED GARBAGE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BOUNDED GARBAGE" << endl
+                          << "===============" << endl;
+
+        DeleterRecorder::reset();
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+        {
+            Obj mX(4, &oa);  const Obj& X = mX;
+
+            bslmt::Barrier            entered(2);
+            SectionHolder             holder(&mX, &entered);
+            bslmt::ThreadUtil::Handle handle;
+
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  &holdSection,
+                                                  &holder));
+            entered.wait();
+
+            const bsls::Types::Int64 EPOCH = X.epoch();
+
+            mX.retire(&objects[0], &recordingDeleter, 0);
+            ASSERT(EPOCH == X.epoch());
+
+            mX.retire(&objects[1], &recordingDeleter, 0);
+            ASSERT(EPOCH + 1 == X.epoch());
+
+            mX.retire(&objects[2], &recordingDeleter, 0);
+            ASSERT(3 == X.numRetired());
+            ASSERT(0 == DeleterRecorder::s_numDeleted);
+
+            // The second thread leaves its section only after a delay, and
+            // the next 'retire' must wait for it.
+
+            holder.d_release = 1;
+            mX.retire(&objects[3], &recordingDeleter, 0);
+
+            ASSERT(1 == holder.d_left);
+            ASSERTV(X.numRetired(), X.numRetired() < 4);
+            ASSERT(4 == DeleterRecorder::s_numDeleted + X.numRetired());
+
+            bslmt::ThreadUtil::join(handle);
+
+            mX.reclaim();
+            ASSERT(0 == X.numRetired());
+            ASSERT(4 == DeleterRecorder::s_numDeleted);
+
+            {
+                Guard guard(&mX);
+
+                for (int i = 10; i < 20; ++i) {
+                    mX.retire(&objects[i], &recordingDeleter, 0);
+                }
+                ASSERT(10 == X.numRetired());
+                ASSERT(4  == DeleterRecorder::s_numDeleted);
+            }
+            ASSERT(0  == X.numRetired());
+            ASSERT(14 == DeleterRecorder::s_numDeleted);
+        }
+        for (int i = 0; i < 20; ++i) {
+            ASSERTV(i, (i < 4 || 10 <= i) == DeleterRecorder::s_counts[i]);
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // THREAD EXIT AND ORPHANED OBJECTS
+        //
+        // Concerns:
+        //: 1 The record of a thread is released on thread exit and on
+        //:   'unregisterThread', which has no effect if the calling thread is
+        //:   not registered.
+        //:
+        //: 2 The objects retired by such a thread that cannot be reclaimed
+        //:   are handed over to the manager, and reclaimed by 'reclaim' (from
+        //:   a registered or unregistered thread) or by the destructor.
+        //:
+        //: 3 The destructor reclaims the objects retired by registered
+        //:   threads.
+        //
+        // Plan:
+        //: 1 Retire objects from threads exiting, or unregistering, while the
+        //:   main thread is in a critical section; verify the number of
+        //:   threads and of orphaned objects, and that the objects are
+        //:   reclaimed once the main thread leaves its section.  (C-1..2)
+        //:
+        //: 2 Destroy managers holding orphaned objects and objects retired by
+        //:   the main thread, and verify that the objects are reclaimed.
+        //:   (C-2..3)
+        //
+        // Testing:
+        //   ~EpochManager();
+        //   void unregisterThread();
+        //   int numOrphans() const;
+        //   THREAD EXIT AND ORPHANED OBJECTS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "THREAD EXIT AND ORPHANED OBJECTS" << endl
+                          << "================================" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        if (verbose) cout << "\tReclamation of orphaned objects." << endl;
+
+        DeleterRecorder::reset();
+        {
+            Obj mX(100, &oa);  const Obj& X = mX;
+
+            mX.enter();
+            ASSERT(1 == X.numThreads());
+
+            RetireThread jobs[] = { { &mX,  0, 10, false },
+                                    { &mX, 10, 20, true  } };
+
+            for (int i = 0; i < 2; ++i) {
+                bslmt::ThreadUtil::Handle handle;
+                ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                      &retireRange,
+                                                      &jobs[i]));
+                bslmt::ThreadUtil::join(handle);
+
+                ASSERTV(i, X.numThreads(), 1 == X.numThreads());
+                ASSERTV(i, X.numOrphans(), 10 * (i + 1) == X.numOrphans());
+            }
+            ASSERT(0 == DeleterRecorder::s_numDeleted);
+
+            mX.reclaim();
+            ASSERT(20 == X.numOrphans());
+
+            mX.leave();
+
+            // An unregistered thread reclaims orphaned objects.
+
+            mX.unregisterThread();
+            ASSERT(0 == X.numThreads());
+            ASSERT(!X.isInCriticalSection());
+
+            mX.unregisterThread();
+            ASSERT(0 == X.numThreads());
+
+            mX.reclaim();
+            ASSERT(0 == X.numThreads());
+            ASSERT(0 == X.numOrphans());
+            ASSERT(20 == DeleterRecorder::s_numDeleted);
+
+            for (int i = 0; i < 20; ++i) {
+                ASSERTV(i, 1 == DeleterRecorder::s_counts[i]);
+            }
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\tReclamation by the destructor." << endl;
+
+        DeleterRecorder::reset();
+        {
+            Obj mX(100, &oa);  const Obj& X = mX;
+
+            mX.enter();
+
+            RetireThread job = { &mX, 0, 10, false };
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  &retireRange,
+                                                  &job));
+            bslmt::ThreadUtil::join(handle);
+
+            ASSERT(10 == X.numOrphans());
+
+            mX.retire(&objects[10], &recordingDeleter, 0);
+            ASSERT(1 == X.numRetired());
+
+            mX.leave();
+
+            ASSERT(0 == DeleterRecorder::s_numDeleted);
+        }
+        ASSERT(11 == DeleterRecorder::s_numDeleted);
+        for (int i = 0; i <= 10; ++i) {
+            ASSERTV(i, 1 == DeleterRecorder::s_counts[i]);
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // RETIRING OBJECTS
+        //
+        // Concerns:
+        //: 1 A retired object is reclaimed exactly once, with the supplied
+        //:   allocator, once the epoch has advanced twice since it was
+        //:   retired, and not before.
+        //:
+        //: 2 'retireObject' destroys the object and returns its memory to the
+        //:   supplied allocator, or to the default allocator.
+        //:
+        //: 3 'numRetired' reports the objects retired by the calling thread
+        //:   and not yet reclaimed.
+        //:
+        //: 4 A deleter may retire objects.
+        //
+        // Plan:
+        //: 1 Retire objects with a deleter recording its invocations, and
+        //:   verify when they are reclaimed as the epoch advances.  (C-1, 3)
+        //:
+        //: 2 Retire objects allocated from a test allocator and from the
+        //:   default allocator with 'retireObject'.  (C-2)
+        //:
+        //: 3 Retire an object whose deleter retires another object.  (C-4)
+        //
+        // Testing:
+        //   void retire(void *object, Deleter deleter, Allocator *allocator);
+        //   void retireObject(TYPE *object, Allocator *allocator = 0);
+        //   int numRetired() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "RETIRING OBJECTS" << endl
+                          << "================" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+        bslma::TestAllocator sa("supplied", veryVeryVerbose);
+
+        DeleterRecorder::reset();
+        {
+            Obj mX(8, &oa);  const Obj& X = mX;
+
+            ASSERT(0 == X.numRetired());
+
+            mX.retire(&objects[0], &recordingDeleter, &sa);
+            mX.retire(&objects[1], &recordingDeleter, 0);
+            mX.retire(&objects[2], &recordingDeleter, &sa);
+            ASSERT(3 == X.numRetired());
+            ASSERT(0 == DeleterRecorder::s_numDeleted);
+
+            // Advance the epoch once only, by entering a section.
+
+            mX.enter();
+            mX.reclaim();
+            mX.leave();
+            ASSERT(3 == X.numRetired());
+            ASSERT(0 == DeleterRecorder::s_numDeleted);
+
+            mX.enter();
+            mX.reclaim();
+            mX.leave();
+            ASSERT(0 == X.numRetired());
+            ASSERT(3 == DeleterRecorder::s_numDeleted);
+            ASSERT(&sa == DeleterRecorder::s_lastAllocator_p);
+
+            mX.reclaim();
+            ASSERT(3 == DeleterRecorder::s_numDeleted);
+            for (int i = 0; i < 3; ++i) {
+                ASSERTV(i, 1 == DeleterRecorder::s_counts[i]);
+            }
+
+            if (verbose) cout << "\tTesting 'retireObject'." << endl;
+
+            int *p = new (sa) int(1);
+            int *q = new (da) int(2);
+
+            mX.retireObject(p, &sa);
+            mX.retireObject(q);
+            ASSERT(2 == X.numRetired());
+            ASSERT(1 == sa.numBlocksInUse());
+            ASSERT(1 == da.numBlocksInUse());
+
+            mX.reclaim();
+            ASSERT(0 == X.numRetired());
+            ASSERT(0 == sa.numBlocksInUse());
+            ASSERT(0 == da.numBlocksInUse());
+
+            if (verbose) cout << "\tTesting retiring deleters." << endl;
+
+            chainManager = &mX;
+
+            mX.retire(&objects[10], &chainingDeleter, 0);
+            mX.reclaim();
+            ASSERT(1 == DeleterRecorder::s_counts[10]);
+            ASSERT(0 == DeleterRecorder::s_counts[11]);
+            ASSERT(1 == X.numRetired());
+
+            mX.reclaim();
+            ASSERT(1 == DeleterRecorder::s_counts[11]);
+            ASSERT(0 == X.numRetired());
+
+            chainManager = 0;
+        }
+        ASSERT(5 == DeleterRecorder::s_numDeleted);
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // CRITICAL SECTIONS AND EPOCHS
+        //
+        // Concerns:
+        //: 1 'enter' and 'leave' may be nested, and 'isInCriticalSection'
+        //:   reports whether the calling thread is in a critical section.
+        //:
+        //: 2 The guard enters a critical section for its lifetime.
+        //:
+        //: 3 'reclaim' advances the epoch twice if no thread is in a critical
+        //:   section, and once if a thread is in a critical section, whether
+        //:   it is the calling thread or another thread.
+        //:
+        //: 4 'synchronize' returns only once the threads in a critical
+        //:   section when it was called have left it or announced a quiescent
+        //:   state, and advances the epoch twice.
+        //
+        // Plan:
+        //: 1 Enter and leave nested critical sections, directly and with
+        //:   guards, and verify 'isInCriticalSection'.  (C-1..2)
+        //:
+        //: 2 Verify the epoch reached by 'reclaim' with no thread, the
+        //:   calling thread, or another thread in a critical section.  (C-3)
+        //:
+        //: 3 Call 'synchronize' with no thread in a critical section, then
+        //:   from a thread while another thread holds a critical section, and
+        //:   verify that it returns only once the section holder has
+        //:   announced a quiescent state.  (C-4)
+        //
+        // Testing:
+        //   void enter();
+        //   void leave();
+        //   void reclaim();
+        //   void synchronize();
+        //   Int64 epoch() const;
+        //   bool isInCriticalSection() const;
+        //   EpochManagerGuard(EpochManager *manager);
+        //   ~EpochManagerGuard();
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CRITICAL SECTIONS AND EPOCHS" << endl
+                          << "============================" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            ASSERT(!X.isInCriticalSection());
+            ASSERT(0 == X.epoch());
+
+            mX.enter();
+            ASSERT(X.isInCriticalSection());
+            ASSERT(1 == X.numThreads());
+
+            mX.enter();
+            ASSERT(X.isInCriticalSection());
+
+            mX.leave();
+            ASSERT(X.isInCriticalSection());
+
+            mX.leave();
+            ASSERT(!X.isInCriticalSection());
+
+            {
+                Guard guard(&mX);
+                ASSERT(X.isInCriticalSection());
+                {
+                    Guard guard2(&mX);
+                    ASSERT(X.isInCriticalSection());
+                }
+                ASSERT(X.isInCriticalSection());
+            }
+            ASSERT(!X.isInCriticalSection());
+
+            if (verbose) cout << "\tNo thread in a critical section." << endl;
+
+            mX.reclaim();
+            ASSERT(2 == X.epoch());
+
+            if (verbose) cout << "\tCalling thread in a section." << endl;
+            {
+                Guard guard(&mX);
+
+                mX.reclaim();
+                ASSERT(3 == X.epoch());
+
+                mX.reclaim();
+                ASSERT(3 == X.epoch());
+            }
+
+            if (verbose) cout << "\tOther thread in a section." << endl;
+
+            bslmt::Barrier            entered(2);
+            SectionHolder             holder(&mX, &entered);
+            bslmt::ThreadUtil::Handle handle;
+
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  &holdSection,
+                                                  &holder));
+            entered.wait();
+
+            mX.reclaim();
+            ASSERT(4 == X.epoch());
+
+            mX.reclaim();
+            ASSERT(4 == X.epoch());
+
+            holder.d_release = 1;
+            bslmt::ThreadUtil::join(handle);
+
+            mX.reclaim();
+            ASSERT(6 == X.epoch());
+
+            if (verbose) cout << "\tSynchronizing." << endl;
+
+            mX.synchronize();
+            ASSERT(8 == X.epoch());
+
+            bslmt::Barrier entered2(2);
+            SectionHolder  holder2(&mX, &entered2);
+
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  &holdSection,
+                                                  &holder2));
+            entered2.wait();
+
+            SynchronizeThread         job(&mX);
+            bslmt::ThreadUtil::Handle syncHandle;
+
+            ASSERT(0 == bslmt::ThreadUtil::create(&syncHandle,
+                                                  &synchronizeManager,
+                                                  &job));
+
+            bslmt::ThreadUtil::microSleep(100 * 1000);
+            ASSERT(0 == job.d_done);
+
+            while (!job.d_done) {
+                holder2.d_quiescent = 1;
+                bslmt::ThreadUtil::microSleep(1000);
+            }
+            bslmt::ThreadUtil::join(syncHandle);
+
+            ASSERT(10 <= X.epoch());
+
+            holder2.d_release = 1;
+            bslmt::ThreadUtil::join(handle);
+
+            ASSERT(1 <= holder2.d_numQuiescent);
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND THREAD REGISTRATION
+        //
+        // Concerns:
+        //: 1 The constructors set the garbage bound, and use the supplied
+        //:   allocator, or the default allocator.
+        //:
+        //: 2 A thread is registered by 'registerThread' once, and its record
+        //:   is allocated from the allocator of the manager.
+        //:
+        //: 3 The destructor releases all memory.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create managers with each constructor, with and without an
+        //:   allocator, register the main thread, and verify the accessors
+        //:   and the allocators.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   EpochManager(Allocator *ba = 0);
+        //   EpochManager(int maxRetiredPerThread, Allocator *ba = 0);
+        //   void registerThread();
+        //   int maxRetiredPerThread() const;
+        //   int numThreads() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND THREAD REGISTRATION" << endl
+                          << "================================" << endl;
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+
+        for (char cfg = 'a'; cfg <= 'd'; ++cfg) {
+            if (veryVerbose) { P(cfg) }
+
+            Obj *objPtr = 0;
+            bslma::TestAllocator *allocPtr = 0;
+
+            switch (cfg) {
+              case 'a': {
+                objPtr   = new (oa) Obj();
+                allocPtr = &da;
+              } break;
+              case 'b': {
+                objPtr   = new (oa) Obj(&oa);
+                allocPtr = &oa;
+              } break;
+              case 'c': {
+                objPtr   = new (oa) Obj(8);
+                allocPtr = &da;
+              } break;
+              case 'd': {
+                objPtr   = new (oa) Obj(8, &oa);
+                allocPtr = &oa;
+              } break;
+            }
+
+            Obj& mX = *objPtr;  const Obj& X = mX;
+
+            const int EXP_MAX = cfg < 'c'
+                              ? Obj::k_DEFAULT_MAX_RETIRED_PER_THREAD
+                              : 8;
+
+            ASSERTV(cfg, EXP_MAX == X.maxRetiredPerThread());
+            ASSERTV(cfg, 0 == X.numThreads());
+            ASSERTV(cfg, 0 == X.numOrphans());
+            ASSERTV(cfg, 0 == X.numRetired());
+            ASSERTV(cfg, 0 == X.epoch());
+
+            const bsls::Types::Int64 NUM_BLOCKS = allocPtr->numBlocksInUse();
+
+            mX.registerThread();
+            ASSERTV(cfg, 1 == X.numThreads());
+            ASSERTV(cfg, NUM_BLOCKS < allocPtr->numBlocksInUse());
+
+            mX.registerThread();
+            ASSERTV(cfg, 1 == X.numThreads());
+
+            oa.deleteObject(objPtr);
+
+            ASSERTV(cfg, 0 == da.numBlocksInUse());
+        }
+        ASSERT(0 == oa.numBlocksInUse());
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_PASS(Obj(1));
+            ASSERT_FAIL(Obj(0));
+
+            Obj mX(&oa);
+
+            ASSERT_FAIL(mX.retire(&objects[0], 0, 0));
+            ASSERT_FAIL(mX.leave());
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Retire a few objects, inside and outside critical sections, and
+        //:   reclaim them.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        DeleterRecorder::reset();
+
+        bslma::TestAllocator oa("object", veryVeryVerbose);
+        {
+            Obj mX(&oa);  const Obj& X = mX;
+
+            {
+                Guard guard(&mX);
+
+                mX.retire(&objects[0], &recordingDeleter, 0);
+                mX.retire(&objects[1], &recordingDeleter, 0);
+            }
+            ASSERT(2 == X.numRetired());
+
+            mX.reclaim();
+            ASSERT(0 == X.numRetired());
+            ASSERT(2 == DeleterRecorder::s_numDeleted);
+
+            mX.retire(&objects[2], &recordingDeleter, 0);
+        }
+        ASSERT(3 == DeleterRecorder::s_numDeleted);
+        ASSERT(0 == oa.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //   Measure the cost of a critical section (a guard), with and without
+        //   retiring an object, and of locking and unlocking a mutex, for 1 to
+        //   8 threads.  The optional second argument specifies the number of
+        //   iterations per thread.
+        // --------------------------------------------------------------------
+
+        int numIterations = argc > 2 ? atoi(argv[2]) : 0;
+        if (0 >= numIterations) {
+            numIterations = 1000 * 1000;
+        }
+
+        cout << "ns per operation: threads, guard, guard + retire, mutex"
+             << endl;
+
+        for (int numThreads = 1; numThreads <= 8; numThreads *= 2) {
+            Obj mX;
+
+            const double guard  = runBenchmark(numThreads,
+                                               numIterations,
+                                               &mX,
+                                               false,
+                                               false);
+            const double retire = runBenchmark(numThreads,
+                                               numIterations,
+                                               &mX,
+                                               false,
+                                               true);
+            const double mutex  = runBenchmark(numThreads,
+                                               numIterations,
+                                               &mX,
+                                               true,
+                                               false);
+
+            const double scale = 1.0e9 / numIterations;
+
+            cout << numThreads          << ", "
+                 << guard  * scale      << ", "
+                 << retire * scale      << ", "
+                 << mutex  * scale      << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -13,6 +13,51 @@
 BSLS_IDENT_RCSID(bdlcc_objectcatalog_cpp,"$Id$ $CSID$")
 
 #include <bslmt_barrier.h> // for testing only
+#include <bslmt_threadutil.h>
+
+namespace BloombergLP {
+namespace bdlcc {
+
+                    // -----------------------------------
+                    // local class ObjectCatalog_ReadGuard
+                    // -----------------------------------
+
+// PRIVATE MANIPULATORS
+void ObjectCatalog_ReadGuard::lockSlow()
+{
+    for (;;) {
+        const int pins = d_state_p->load();
+
+        if (pins & k_WRITER) {
+            bslmt::ThreadUtil::yield();
+        }
+        else if (pins == d_state_p->testAndSwap(pins, pins + 1)) {
+            return;                                                   // RETURN
+        }
+    }
+}
+
+                    // ------------------------------------
+                    // local class ObjectCatalog_WriteGuard
+                    // ------------------------------------
+
+// CREATORS
+ObjectCatalog_WriteGuard::ObjectCatalog_WriteGuard(bsls::AtomicInt *state)
+: d_state_p(state)
+{
+    // New read pins fail once the writer flag is set; the pins acquired
+    // before are then waited for.
+
+    int pins = d_state_p->add(ObjectCatalog_ReadGuard::k_WRITER);
+
+    while (ObjectCatalog_ReadGuard::k_WRITER != pins) {
+        bslmt::ThreadUtil::yield();
+        pins = d_state_p->load();
+    }
+}
+
+}  // close package namespace
+}  // close enterprise namespace
 
 // ----------------------------------------------------------------------------
 // Copyright 2015 Bloomberg Finance L.P.
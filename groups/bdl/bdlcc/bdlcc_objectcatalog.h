@@ -36,6 +36,18 @@ BSLS_IDENT("$Id: $")
 // handle is then no longer valid and subsequent calls to 'find' or 'remove'
 // with this handle will return 0.
 //
+// 'find' does not acquire any lock of the catalog, so that concurrent lookups
+// do not contend on a shared lock word: a lookup locates the node of the
+// handle, validates the handle (including its generation bits) against the
+// handle atomically published in the node, and copies the object while
+// holding a read pin on that node only.  The manipulators remain serialized
+// with each other and with iterators by a reader-writer lock; 'remove' and
+// 'replace' additionally wait for the lookups of the affected node that are
+// in progress to complete, and a lookup concurrent with 'replace' of the same
+// handle waits for 'replace' to complete.  Nodes are allocated in blocks of
+// geometrically increasing size that are never moved, and their memory is
+// retained until the catalog is destroyed ('removeAll' does not release it).
+//
 // 'bdlcc::ObjectCatalogIter' provides thread safe iteration through all the
 // objects of an object catalog of parameterized 'TYPE'.  The order of the
 // iteration is implementation defined.  Thread safe iteration is provided by
@@ -267,6 +279,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlscm_version.h>
 #endif
 
+#ifndef INCLUDED_BDLB_BITUTIL
+#include <bdlb_bitutil.h>
+#endif
+
 #ifndef INCLUDED_BSLMT_RWMUTEX
 #include <bslmt_rwmutex.h>
 #endif
@@ -279,10 +295,6 @@ BSLS_IDENT("$Id: $")
 #include <bslmt_writelockguard.h>
 #endif
 
-#ifndef INCLUDED_BDLMA_POOL
-#include <bdlma_pool.h>
-#endif
-
 #ifndef INCLUDED_BSLALG_SCALARPRIMITIVES
 #include <bslalg_scalarprimitives.h>
 #endif
@@ -311,6 +323,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_assert.h>
 #endif
 
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
 #ifndef INCLUDED_BSLS_OBJECTBUFFER
 #include <bsls_objectbuffer.h>
 #endif
@@ -333,6 +349,10 @@ BSLS_IDENT("$Id: $")
 #include <bslalg_typetraits.h>
 #endif
 
+#ifndef INCLUDED_BDLMA_POOL
+#include <bdlma_pool.h>
+#endif
+
 #endif // BDE_DONT_ALLOW_TRANSITIVE_INCLUDES
 
 namespace BloombergLP {
@@ -342,6 +362,67 @@ template <class TYPE> class ObjectCatalog_AutoCleanup;
 template <class TYPE> class ObjectCatalogIter;
 template <class TYPE> class ObjectCatalog;
 
+                    // ===================================
+                    // local class ObjectCatalog_ReadGuard
+                    // ===================================
+
+class ObjectCatalog_ReadGuard {
+    // This class provides a guard holding a read pin on a catalog node for
+    // its lifetime.  The state of a node is the number of read pins held on
+    // it, plus 'k_WRITER' while a writer holds the node; a read pin cannot be
+    // acquired while a writer holds the node.
+
+    bsls::AtomicInt *d_state_p;  // state of the pinned node
+
+    // NOT IMPLEMENTED
+    ObjectCatalog_ReadGuard(const ObjectCatalog_ReadGuard&);
+    ObjectCatalog_ReadGuard& operator=(const ObjectCatalog_ReadGuard&);
+
+    // PRIVATE MANIPULATORS
+    void lockSlow();
+        // Wait until no writer holds the node, and acquire a read pin on it.
+
+  public:
+    // TYPES
+    enum { k_WRITER = 0x40000000 };
+
+    // CREATORS
+    explicit ObjectCatalog_ReadGuard(bsls::AtomicInt *state);
+        // Acquire a read pin on the node having the specified 'state',
+        // waiting until no writer holds the node, and create a guard
+        // releasing the pin on destruction.
+
+    ~ObjectCatalog_ReadGuard();
+        // Release the read pin held by this guard, and destroy this object.
+};
+
+                    // ====================================
+                    // local class ObjectCatalog_WriteGuard
+                    // ====================================
+
+class ObjectCatalog_WriteGuard {
+    // This class provides a guard holding a catalog node exclusively for its
+    // lifetime.  Writers of a node must be serialized by the client.
+
+    bsls::AtomicInt *d_state_p;  // state of the held node
+
+    // NOT IMPLEMENTED
+    ObjectCatalog_WriteGuard(const ObjectCatalog_WriteGuard&);
+    ObjectCatalog_WriteGuard& operator=(const ObjectCatalog_WriteGuard&);
+
+  public:
+    // CREATORS
+    explicit ObjectCatalog_WriteGuard(bsls::AtomicInt *state);
+        // Hold the node having the specified 'state' exclusively, preventing
+        // new read pins on the node and waiting until the read pins held on
+        // it are released, and create a guard releasing the node on
+        // destruction.  The behavior is undefined unless no other writer
+        // holds the node.
+
+    ~ObjectCatalog_WriteGuard();
+        // Release the node held by this guard, and destroy this object.
+};
+
                    // =====================================
                    // local class ObjectCatalog_AutoCleanup
                    // =====================================
@@ -349,14 +430,12 @@ template <class TYPE> class ObjectCatalog;
 template <class TYPE>
 class ObjectCatalog_AutoCleanup {
     // This class provides a specialized proctor object that, upon destruction
-    // and unless the 'release' method is called (1) removes a managed node
-    // from the 'ObjectCatalog', and (2) deallocates all associated memory as
-    // necessary.
+    // and unless the 'release' method is called, returns a managed node to
+    // the free list of the 'ObjectCatalog'.
 
     ObjectCatalog<TYPE> *d_catalog_p;       // temporarily managed catalog
     typename ObjectCatalog<TYPE>::Node
                         *d_node_p;          // temporarily managed node
-    bool                 d_deallocateFlag;  // how to return the managed node
 
     // NOT IMPLEMENTED
     ObjectCatalog_AutoCleanup(const ObjectCatalog_AutoCleanup&);
@@ -368,17 +447,13 @@ class ObjectCatalog_AutoCleanup {
         // Create a proctor to manage the specified 'catalog'.
 
     ~ObjectCatalog_AutoCleanup();
-        // Remove a managed node from the 'ObjectCatalog' (by returning it to
-        // the catalog's free list or node pool, as specified in 'manageNode'),
-        // deallocate all associated memory, and destroy this object.
+        // Return a managed node to the catalog's free list, and destroy this
+        // object.
 
     // MANIPULATORS
-    void manageNode(typename ObjectCatalog<TYPE>::Node *node,
-                    bool                                deallocateFlag);
+    void manageNode(typename ObjectCatalog<TYPE>::Node *node);
         // Release from management the catalog node, if any, currently managed
-        // by this object and begin managing the specified catalog 'node'.  The
-        // specified 'deallocateFlag' tells the destructor how to dispose of
-        // 'node' if 'node' is managed during the destruction of this object.
+        // by this object and begin managing the specified catalog 'node'.
 
     void releaseNode();
         // Release from management the catalog node, if any, currently managed
@@ -412,6 +487,16 @@ class ObjectCatalog {
         k_GENERATION_MASK = 0xff000000
     };
 
+    enum {
+        // Nodes are allocated in chunks that are never moved: chunk 'i' holds
+        // the '2 ^ (k_FIRST_CHUNK_SHIFT + i)' nodes from index
+        // '2 ^ (k_FIRST_CHUNK_SHIFT + i) - k_FIRST_CHUNK_SIZE'.
+
+        k_FIRST_CHUNK_SHIFT = 5,
+        k_FIRST_CHUNK_SIZE  = 1 << k_FIRST_CHUNK_SHIFT,
+        k_NUM_CHUNKS        = 24 - k_FIRST_CHUNK_SHIFT
+    };
+
     struct Node {
         // PUBLIC DATA
         union {
@@ -421,15 +506,20 @@ class ObjectCatalog {
             Node                               *d_next_p; // when free, pointer
                                                           // to next free node
         }    d_payload;
-        int  d_handle;
+        bsls::AtomicInt  d_handle;  // handle, busy only once the value is
+                                    // constructed
+        bsls::AtomicInt  d_state;   // read pins and writer (see
+                                    // 'ObjectCatalog_ReadGuard')
     };
 
     // DATA
-    bsl::vector<Node*>      d_nodes;
-    bdlma::Pool             d_nodePool;
-    Node                   *d_nextFreeNode_p;
-    volatile int            d_length;
-    mutable bslmt::RWMutex  d_lock;
+    bsls::AtomicPointer<Node>  d_chunks[k_NUM_CHUNKS];
+    int                        d_numNodes;    // nodes used so far
+    Node                      *d_nextFreeNode_p;
+    volatile int               d_length;
+    mutable bslmt::RWMutex     d_lock;        // serializes the manipulators
+                                              // and iterators
+    bslma::Allocator          *d_allocator_p; // held, not owned
 
     // FRIENDS
     friend class ObjectCatalog_AutoCleanup<TYPE>;
@@ -450,10 +540,21 @@ class ObjectCatalog {
         // 'ObjectCatalog_AutoCleanup' guard, but there it should not invoke
         // the object's destructor.)
 
+    Node *newNode();
+        // Return the address of the node following the nodes used so far,
+        // allocating a new chunk of nodes if needed.
+
     // PRIVATE ACCESSORS
     Node *findNode(int handle) const;
         // Return a pointer to the node with the specified 'handle', or 0 if
-        // not found.
+        // not found.  Note that this method does not acquire any lock, and
+        // that the handle of the returned node may change at any time unless
+        // the calling thread holds 'd_lock' for writing.
+
+    Node *nodeAt(int index) const;
+        // Return a pointer to the node at the specified 'index', or 0 if the
+        // chunk holding that node has not been allocated.  The behavior is
+        // undefined unless '0 <= index <= k_INDEX_MASK'.
 
   public:
     // TRAITS
@@ -476,19 +577,23 @@ class ObjectCatalog {
     int remove(int handle, TYPE *valueBuffer = 0);
         // Optionally load into the optionally specified 'valueBuffer' the
         // value of the object having the specified 'handle' and remove it from
-        // this catalog.  Return zero on success, and a non-zero value if the
-        // 'handle' is not contained in this catalog.  Note that 'valueBuffer'
-        // is assigned into, and thus must point to a valid 'TYPE' instance.
+        // this catalog, waiting for the concurrent calls to 'find' copying
+        // that object to complete.  Return zero on success, and a non-zero
+        // value if the 'handle' is not contained in this catalog.  Note that
+        // 'valueBuffer' is assigned into, and thus must point to a valid
+        // 'TYPE' instance.
 
     void removeAll(bsl::vector<TYPE> *buffer = 0);
         // Remove all objects that are currently held in this catalog and
         // optionally load into the optionally specified 'buffer' the removed
-        // objects.
+        // objects.  Note that the memory of the nodes of this catalog is
+        // retained for reuse by subsequent calls to 'add'.
 
     int replace(int handle, const TYPE& newObject);
         // Replace the object having the specified 'handle' with the specified
-        // 'newObject'.  Return 0 on success, and a non-zero value if the
-        // handle is not contained in this catalog.
+        // 'newObject', waiting for the concurrent calls to 'find' copying the
+        // replaced object to complete.  Return 0 on success, and a non-zero
+        // value if the handle is not contained in this catalog.
 
     // ACCESSORS
     int find(int handle, TYPE *valueBuffer = 0) const;
@@ -496,7 +601,9 @@ class ObjectCatalog {
         // its value into the optionally specified 'valueBuffer'.  Return zero
         // on success, and a non-zero value if the 'handle' is not contained in
         // this catalog.  Note that 'valueBuffer' is assigned into, and thus
-        // must point to a valid 'TYPE' instance.
+        // must point to a valid 'TYPE' instance.  Also note that this method
+        // does not acquire any lock of this catalog, but waits for a
+        // concurrent call to 'replace' of the same 'handle' to complete.
 
     int length() const;
         // Return a "snapshot" of the number of items currently contained in
@@ -573,6 +680,39 @@ class ObjectCatalogIter {
 //                            INLINE DEFINITIONS
 // ----------------------------------------------------------------------------
 
+                    // -----------------------------------
+                    // local class ObjectCatalog_ReadGuard
+                    // -----------------------------------
+
+// CREATORS
+inline
+ObjectCatalog_ReadGuard::ObjectCatalog_ReadGuard(bsls::AtomicInt *state)
+: d_state_p(state)
+{
+    const int pins = d_state_p->loadRelaxed();
+
+    if (pins & k_WRITER || pins != d_state_p->testAndSwap(pins, pins + 1)) {
+        lockSlow();
+    }
+}
+
+inline
+ObjectCatalog_ReadGuard::~ObjectCatalog_ReadGuard()
+{
+    d_state_p->add(-1);
+}
+
+                    // ------------------------------------
+                    // local class ObjectCatalog_WriteGuard
+                    // ------------------------------------
+
+// CREATORS
+inline
+ObjectCatalog_WriteGuard::~ObjectCatalog_WriteGuard()
+{
+    d_state_p->add(-ObjectCatalog_ReadGuard::k_WRITER);
+}
+
                    // -------------------------------------
                    // local class ObjectCatalog_AutoCleanup
                    // -------------------------------------
@@ -583,7 +723,6 @@ ObjectCatalog_AutoCleanup<TYPE>::ObjectCatalog_AutoCleanup(
                                                   ObjectCatalog<TYPE> *catalog)
 : d_catalog_p(catalog)
 , d_node_p(0)
-, d_deallocateFlag(false)
 {
 }
 
@@ -591,26 +730,18 @@ template <class TYPE>
 ObjectCatalog_AutoCleanup<TYPE>::~ObjectCatalog_AutoCleanup()
 {
     if (d_catalog_p && d_node_p) {
-        if (d_deallocateFlag) {
-            // Return node to the pool.
+        // Return node to the catalog's free list.
 
-            d_catalog_p->d_nodePool.deallocate(d_node_p);
-        } else {
-            // Return node to the catalog's free list.
-
-            d_catalog_p->freeNode(d_node_p);
-        }
+        d_catalog_p->freeNode(d_node_p);
     }
 }
 
 // MANIPULATORS
 template <class TYPE>
 void ObjectCatalog_AutoCleanup<TYPE>::manageNode(
-                            typename ObjectCatalog<TYPE>::Node *node,
-                            bool                                deallocateFlag)
+                                      typename ObjectCatalog<TYPE>::Node *node)
 {
     d_node_p = node;
-    d_deallocateFlag = deallocateFlag;
 }
 
 template <class TYPE>
@@ -646,49 +777,114 @@ template <class TYPE>
 inline
 void ObjectCatalog<TYPE>::freeNode(typename ObjectCatalog<TYPE>::Node *node)
 {
-    node->d_handle += k_GENERATION_INC;
-    node->d_handle &= ~k_BUSY_INDICATOR;
+    // The generation is incremented modulo 256 (the handle is computed as an
+    // 'unsigned' to avoid a signed overflow).
+
+    unsigned handle = static_cast<unsigned>(node->d_handle.loadRelaxed());
+    handle += k_GENERATION_INC;
+    handle &= ~static_cast<unsigned>(k_BUSY_INDICATOR);
+    node->d_handle.store(static_cast<int>(handle));
 
     node->d_payload.d_next_p   = d_nextFreeNode_p;
     d_nextFreeNode_p = node;
 }
 
+template <class TYPE>
+typename ObjectCatalog<TYPE>::Node *ObjectCatalog<TYPE>::newNode()
+{
+    // If the number of nodes grows as big as the flags used to indicate BUSY
+    // and generations, then the handle will be all mixed up!
+
+    BSLS_ASSERT_SAFE(d_numNodes <= static_cast<int>(k_INDEX_MASK));
+
+    Node *node = nodeAt(d_numNodes);
+
+    if (!node) {
+        // 'd_numNodes' is the first index of a chunk that is not allocated,
+        // hence 'd_numNodes + k_FIRST_CHUNK_SIZE' is a power of 2.
+
+        const int size  = d_numNodes + k_FIRST_CHUNK_SIZE;
+        const int chunk = bdlb::BitUtil::log2(static_cast<bsl::uint32_t>(size))
+                        - k_FIRST_CHUNK_SHIFT;
+
+        Node *nodes = static_cast<Node *>(d_allocator_p->allocate(
+                                                        sizeof(Node) * size));
+
+        for (int i = 0; i < size; ++i) {
+            new (static_cast<void *>(nodes + i)) Node;
+            nodes[i].d_handle.storeRelaxed(d_numNodes + i);
+            nodes[i].d_state.storeRelaxed(0);
+        }
+
+        // A lookup finding the chunk must observe the handles of its nodes.
+
+        d_chunks[chunk].storeRelease(nodes);
+        node = nodes;
+    }
+
+    ++d_numNodes;
+    return node;
+}
+
 // PRIVATE ACCESSORS
 template <class TYPE>
 inline
 typename ObjectCatalog<TYPE>::Node *
 ObjectCatalog<TYPE>::findNode(int handle) const
 {
-    int index = handle & k_INDEX_MASK;
-    // if (d_nodes.size() < index || !(handle & k_BUSY_INDICATOR)) return 0;
-
-    if (0 > index                    ||
-        index >= (int)d_nodes.size() ||
-        !(handle & k_BUSY_INDICATOR)) {
+    if (!(handle & k_BUSY_INDICATOR)) {
         return 0;                                                     // RETURN
     }
 
-    Node *node = d_nodes[index];
+    Node *node = nodeAt(handle & k_INDEX_MASK);
+
+    return (node && node->d_handle == handle) ? node : 0;
+}
+
+template <class TYPE>
+inline
+typename ObjectCatalog<TYPE>::Node *
+ObjectCatalog<TYPE>::nodeAt(int index) const
+{
+    BSLS_ASSERT_SAFE(0 <= index);
+    BSLS_ASSERT_SAFE(index <= static_cast<int>(k_INDEX_MASK));
+
+    const bsl::uint32_t position = static_cast<bsl::uint32_t>(index)
+                                                         + k_FIRST_CHUNK_SIZE;
+    const int           chunk    = 31
+                                 - bdlb::BitUtil::numLeadingUnsetBits(position)
+                                 - k_FIRST_CHUNK_SHIFT;
+
+    Node *nodes = d_chunks[chunk].loadAcquire();
 
-    return (node->d_handle == handle) ? node : 0;
+    return nodes
+         ? nodes + (position - (static_cast<bsl::uint32_t>(k_FIRST_CHUNK_SIZE)
+                                                                     << chunk))
+         : 0;
 }
 
 // CREATORS
 template <class TYPE>
 inline
 ObjectCatalog<TYPE>::ObjectCatalog(bslma::Allocator *allocator)
-: d_nodes(allocator)
-, d_nodePool(sizeof(Node), allocator)
+: d_numNodes(0)
 , d_nextFreeNode_p(0)
 , d_length(0)
+, d_allocator_p(bslma::Default::allocator(allocator))
 {
 }
 
 template <class TYPE>
-inline
 ObjectCatalog<TYPE>::~ObjectCatalog()
 {
     removeAll();
+
+    for (int i = 0; i < k_NUM_CHUNKS; ++i) {
+        Node *nodes = d_chunks[i].loadRelaxed();
+        if (nodes) {
+            d_allocator_p->deallocate(nodes);
+        }
+    }
 }
 
 // MANIPULATORS
@@ -703,37 +899,29 @@ int ObjectCatalog<TYPE>::add(const TYPE& object)
     if (d_nextFreeNode_p) {
         node = d_nextFreeNode_p;
         d_nextFreeNode_p = node->d_payload.d_next_p;
-
-        proctor.manageNode(node, false);
-        // Destruction of this proctor will put node back onto the free list.
     } else {
-        // If 'd_nodes' grows as big as the flags used to indicate BUSY and
-        // generations, then the handle will be all mixed up!
-
-        BSLS_ASSERT_SAFE(d_nodes.size() < k_BUSY_INDICATOR);
-
-        node = (Node *)d_nodePool.allocate();
-        proctor.manageNode(node, true);
-        // Destruction of this proctor will deallocate node.
-
-        d_nodes.push_back(node);
-        node->d_handle = static_cast<int>(d_nodes.size()) - 1;
-        proctor.manageNode(node, false);
-        // Destruction of this proctor will put node back onto the free list,
-        // which is now OK since the 'push_back' succeeded without throwing.
+        node = newNode();
     }
 
-    node->d_handle |= k_BUSY_INDICATOR;
-    handle = node->d_handle;
+    proctor.manageNode(node);
+    // Destruction of this proctor will put node back onto the free list.
+
+    handle = node->d_handle.loadRelaxed() | k_BUSY_INDICATOR;
 
     // We need to use the copyConstruct logic to pass the allocator through.
-    bslalg::ScalarPrimitives::copyConstruct(
-              getNodeValue(node), object, d_nodes.get_allocator().mechanism());
+    bslalg::ScalarPrimitives::copyConstruct(getNodeValue(node),
+                                            object,
+                                            d_allocator_p);
 
     // If the copy constructor throws, the proctor will properly put the node
     // back onto the free list.  Otherwise, the proctor should do nothing.
     proctor.release();
 
+    // Publish the handle only once the value is constructed, so that a
+    // concurrent lookup matching the handle observes the value.
+
+    node->d_handle.store(handle);
+
     ++d_length;
     return handle;
 }
@@ -750,6 +938,8 @@ int ObjectCatalog<TYPE>::remove(int handle, TYPE *valueBuffer)
         return -1;                                                    // RETURN
     }
 
+    ObjectCatalog_WriteGuard nodeGuard(&node->d_state);
+
     TYPE *value = getNodeValue(node);
 
     if (valueBuffer) {
@@ -768,23 +958,28 @@ void ObjectCatalog<TYPE>::removeAll(bsl::vector<TYPE> *buffer)
 {
     bslmt::WriteLockGuard<bslmt::RWMutex> guard(&d_lock);
 
-    for (typename bsl::vector<Node*>::iterator it = d_nodes.begin();
-         it != d_nodes.end();++it) {
-        if ((*it)->d_handle & k_BUSY_INDICATOR) {
-            TYPE *value = getNodeValue(*it);
+    for (int i = 0; i < d_numNodes; ++i) {
+        Node *node = nodeAt(i);
+
+        if (node->d_handle.loadRelaxed() & k_BUSY_INDICATOR) {
+            ObjectCatalog_WriteGuard nodeGuard(&node->d_state);
+
+            TYPE *value = getNodeValue(node);
 
             if (buffer) {
                 buffer->push_back(*value);
             }
             value->~TYPE();
+            freeNode(node);
         }
     }
-    // Even though we get rid of the container of 'Node*' without returning the
-    // nodes to the pool prior, the release of the pool immediately after will
-    // properly (and efficiently) dispose of those nodes without leaking
-    // memory.
-    d_nodes.clear();
-    d_nodePool.release();
+
+    // The nodes are reused in index order, and keep their generations so that
+    // the handles of the removed objects remain stale.  Nodes are never
+    // deallocated while the catalog exists, as concurrent lookups may access
+    // them.
+
+    d_numNodes = 0;
     d_nextFreeNode_p = 0;
     d_length = 0;
 }
@@ -800,12 +995,13 @@ int ObjectCatalog<TYPE>::replace(int handle, const TYPE& newObject)
         return -1;                                                    // RETURN
     }
 
+    ObjectCatalog_WriteGuard nodeGuard(&node->d_state);
+
     TYPE *value = getNodeValue(node);
 
     value->~TYPE();
     // We need to use the copyConstruct logic to pass the allocator through.
-    bslalg::ScalarPrimitives::copyConstruct(
-                        value, newObject, d_nodes.get_allocator().mechanism());
+    bslalg::ScalarPrimitives::copyConstruct(value, newObject, d_allocator_p);
 
     return 0;
 }
@@ -815,8 +1011,6 @@ template <class TYPE>
 inline
 int ObjectCatalog<TYPE>::find(int handle, TYPE *valueBuffer) const
 {
-    bslmt::ReadLockGuard<bslmt::RWMutex> guard(&d_lock);
-
     Node *node = findNode(handle);
 
     if (!node) {
@@ -824,6 +1018,16 @@ int ObjectCatalog<TYPE>::find(int handle, TYPE *valueBuffer) const
     }
 
     if (valueBuffer) {
+        // The handle must be validated again once the node is pinned, as the
+        // object may have been removed (and the node reused) since it was
+        // validated by 'findNode'.
+
+        ObjectCatalog_ReadGuard nodeGuard(&node->d_state);
+
+        if (node->d_handle != handle) {
+            return -1;                                                // RETURN
+        }
+
         *valueBuffer = *getNodeValue(node);
     }
     return 0;
@@ -841,13 +1045,16 @@ void ObjectCatalog<TYPE>::verifyState() const
 {
     bslmt::ReadLockGuard<bslmt::RWMutex> guard(&d_lock);
 
-    BSLS_ASSERT_SAFE((int)d_nodes.size() >= d_length);
+    BSLS_ASSERT_SAFE(d_numNodes >= d_length);
     BSLS_ASSERT_SAFE(d_length >= 0);
 
     int nBusy = 0;
-    for (int i = 0; i < (int)d_nodes.size(); i++) {
-        BSLS_ASSERT_SAFE((d_nodes[i]->d_handle & k_INDEX_MASK) == (unsigned)i);
-        if (d_nodes[i]->d_handle & k_BUSY_INDICATOR) {
+    for (int i = 0; i < d_numNodes; i++) {
+        const Node *node = nodeAt(i);
+
+        BSLS_ASSERT_SAFE(node);
+        BSLS_ASSERT_SAFE((node->d_handle & k_INDEX_MASK) == (unsigned)i);
+        if (node->d_handle & k_BUSY_INDICATOR) {
             nBusy++;
         }
     }
@@ -858,7 +1065,7 @@ void ObjectCatalog<TYPE>::verifyState() const
         nFree++;
     }
 
-    BSLS_ASSERT_SAFE(nFree+nBusy == (int)d_nodes.size());
+    BSLS_ASSERT_SAFE(nFree+nBusy == d_numNodes);
 }
 
                             // -----------------
@@ -888,8 +1095,8 @@ template <class TYPE>
 void ObjectCatalogIter<TYPE>::operator++()
 {
     ++d_index;
-    while ((unsigned)d_index < d_catalog_p->d_nodes.size() &&
-          !(d_catalog_p->d_nodes[d_index]->d_handle &
+    while (d_index < d_catalog_p->d_numNodes &&
+          !(d_catalog_p->nodeAt(d_index)->d_handle &
               ObjectCatalog<TYPE>::k_BUSY_INDICATOR)) {
         ++d_index;
     }
@@ -901,7 +1108,7 @@ template <class TYPE>
 inline
 bdlcc::ObjectCatalogIter<TYPE>::operator const void *() const
 {
-    return (void *)(((unsigned)d_index < d_catalog_p->d_nodes.size())
+    return (void *)((d_index < d_catalog_p->d_numNodes)
             ? const_cast<bdlcc::ObjectCatalogIter<TYPE> *>(this)
             : 0);
 }
@@ -914,7 +1121,7 @@ bsl::pair<int, TYPE> ObjectCatalogIter<TYPE>::operator()() const
 {
     typedef ObjectCatalog<TYPE> Catalog;
 
-    typename Catalog::Node *node = d_catalog_p->d_nodes[d_index];
+    typename Catalog::Node *node = d_catalog_p->nodeAt(d_index);
 
     return bsl::pair<int, TYPE>(node->d_handle, *Catalog::getNodeValue(node));
 }
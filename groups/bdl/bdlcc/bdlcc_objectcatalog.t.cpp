@@ -30,6 +30,8 @@
 #include <bsls_alignmentfromtype.h>
 #include <bsls_alignmentutil.h>
 #include <bsls_assert.h>
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
 #include <bsls_types.h>
 
 #include <bsl_cstddef.h>
@@ -66,7 +68,8 @@ using namespace bsl;  // automatically added by script
 //
 // All the test cases above are for a single thread.  [12] verifies that the
 // catalog remain consistent in the presence of multiple threads accessing it
-// (either directly or through iteration).
+// (either directly or through iteration).  [14] verifies that the lock-free
+// lookups are safe in the presence of concurrent modifications.
 //
 // [10] verifies that stale handles are rejected properly by catalog.
 //
@@ -106,7 +109,9 @@ using namespace bsl;  // automatically added by script
 // [11] TESTING OBJECT CONSTRUCTION/DESTRUCTION WITH ALLOCATORS
 // [12] TESTING STALE HANDLE REJECTION
 // [13] CONCURRENCY TEST
-// [14] USAGE EXAMPLE
+// [14] CONCURRENT LOOKUPS
+// [15] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
 
 // ============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -704,6 +709,238 @@ void queryCallBack(const QueryResult& /* result */)
 
 }  // close namespace OBJECTCATALOG_TEST_USAGE_EXAMPLE
 
+// ============================================================================
+//                         CASE 14 RELATED ENTITIES
+// ----------------------------------------------------------------------------
+
+namespace OBJECTCATALOG_TEST_CASE_14
+
+{
+
+enum {
+    k_NUM_READERS    = 6,
+    k_NUM_SLOTS      = 64,
+    k_NUM_ITERATIONS = 20000
+};
+
+class CheckedValue {
+    // This class holds an integer value in allocated memory, along with its
+    // complement, so that reading a destroyed (or partially constructed)
+    // object is detected.
+
+    int              *d_value_p;      // value and its complement
+    bslma::Allocator *d_allocator_p;  // held, not owned
+
+  private:
+    // PRIVATE MANIPULATORS
+    void setValue(int value)
+        // Set the value of this object to the specified 'value'.
+    {
+        d_value_p[0] = value;
+        d_value_p[1] = ~value;
+    }
+
+  public:
+    // TRAITS
+    BSLMF_NESTED_TRAIT_DECLARATION(CheckedValue, bslma::UsesBslmaAllocator);
+
+    // CREATORS
+    explicit CheckedValue(int value = 0, bslma::Allocator *alloc = 0)
+    : d_allocator_p(bslma::Default::allocator(alloc))
+    {
+        d_value_p = static_cast<int *>(
+                                   d_allocator_p->allocate(2 * sizeof(int)));
+        setValue(value);
+    }
+
+    CheckedValue(const CheckedValue& original, bslma::Allocator *alloc = 0)
+    : d_allocator_p(bslma::Default::allocator(alloc))
+    {
+        ASSERTT(original.isValid());
+
+        d_value_p = static_cast<int *>(
+                                   d_allocator_p->allocate(2 * sizeof(int)));
+        setValue(original.value());
+    }
+
+    ~CheckedValue()
+    {
+        ASSERTT(isValid());
+
+        d_value_p[1] = d_value_p[0];
+        d_allocator_p->deallocate(d_value_p);
+        d_value_p = 0;
+    }
+
+    // MANIPULATORS
+    CheckedValue& operator=(const CheckedValue& rhs)
+    {
+        ASSERTT(rhs.isValid());
+        ASSERTT(isValid());
+
+        setValue(rhs.value());
+        return *this;
+    }
+
+    // ACCESSORS
+    bool isValid() const
+        // Return 'true' if this object was neither destroyed nor corrupted.
+    {
+        return d_value_p && d_value_p[1] == ~d_value_p[0];
+    }
+
+    int value() const
+        // Return the value of this object.
+    {
+        return d_value_p[0];
+    }
+};
+
+typedef bdlcc::ObjectCatalog<CheckedValue> CheckedObj;
+
+bsls::AtomicInt handles[k_NUM_SLOTS];
+    // Current handle of the object of each slot.
+
+bsls::AtomicInt done(0);
+    // Set once the writer has completed.
+
+struct ReaderArgs {
+    CheckedObj      *d_catalog_p;
+    bslmt::Barrier  *d_barrier_p;
+    int              d_id;
+    int              d_numFound;
+};
+
+extern "C" void *readerThread(void *arg)
+    // Look up the objects of all slots until the writer has completed,
+    // verifying that each object found is valid and belongs to its slot.
+{
+    ReaderArgs *args = static_cast<ReaderArgs *>(arg);
+
+    CheckedValue buffer;
+
+    args->d_barrier_p->wait();
+
+    int slot = args->d_id;
+    while (!done) {
+        slot = (slot + 7) % k_NUM_SLOTS;
+
+        if (0 == args->d_catalog_p->find(handles[slot], &buffer)) {
+            ASSERTT(buffer.isValid());
+            LOOP2_ASSERTT(slot,
+                          buffer.value(),
+                          slot == buffer.value() % k_NUM_SLOTS);
+            ++args->d_numFound;
+        }
+    }
+    return 0;
+}
+
+}  // close namespace OBJECTCATALOG_TEST_CASE_14
+
+// ============================================================================
+//                        CASE -1 RELATED ENTITIES
+// ----------------------------------------------------------------------------
+
+namespace OBJECTCATALOG_TEST_CASE_MINUS_1
+
+{
+
+struct BenchmarkArgs {
+    bdlcc::ObjectCatalog<int> *d_catalog_p;
+    const int                 *d_handles_p;
+    int                        d_numHandles;
+    int                        d_numIterations;
+    bslmt::Barrier            *d_barrier_p;
+    bsls::AtomicInt           *d_done_p;
+};
+
+extern "C" void *benchmarkReader(void *arg)
+    // Look up the catalog in a loop.
+{
+    BenchmarkArgs *args = static_cast<BenchmarkArgs *>(arg);
+
+    args->d_barrier_p->wait();
+
+    int value = 0;
+    for (int i = 0; i < args->d_numIterations; ++i) {
+        args->d_catalog_p->find(args->d_handles_p[i % args->d_numHandles],
+                                &value);
+    }
+    return 0;
+}
+
+extern "C" void *benchmarkWriter(void *arg)
+    // Replace the objects of the catalog until requested to stop.
+{
+    BenchmarkArgs *args = static_cast<BenchmarkArgs *>(arg);
+
+    args->d_barrier_p->wait();
+
+    for (int i = 0; !*args->d_done_p; ++i) {
+        args->d_catalog_p->replace(args->d_handles_p[i % args->d_numHandles],
+                                   i);
+        bslmt::ThreadUtil::yield();
+    }
+    return 0;
+}
+
+double runBenchmark(int numReaders, int numIterations, bool withWriter)
+    // Return the wall time, in seconds, taken by the specified 'numReaders'
+    // threads each looking up the specified 'numIterations' handles of a
+    // catalog, concurrently with a thread replacing objects if the specified
+    // 'withWriter' is 'true'.
+{
+    enum { k_NUM_HANDLES = 1024 };
+
+    bdlcc::ObjectCatalog<int> catalog;
+    int                       handles[k_NUM_HANDLES];
+
+    for (int i = 0; i < k_NUM_HANDLES; ++i) {
+        handles[i] = catalog.add(i);
+    }
+
+    const int       numThreads = numReaders + (withWriter ? 1 : 0);
+    bslmt::Barrier  barrier(numThreads + 1);
+    bsls::AtomicInt done(0);
+
+    BenchmarkArgs args = { &catalog,
+                           handles,
+                           k_NUM_HANDLES,
+                           numIterations,
+                           &barrier,
+                           &done };
+
+    bslmt::ThreadUtil::Handle readers[64];
+    bslmt::ThreadUtil::Handle writer;
+
+    for (int i = 0; i < numReaders; ++i) {
+        bslmt::ThreadUtil::create(&readers[i], benchmarkReader, &args);
+    }
+    if (withWriter) {
+        bslmt::ThreadUtil::create(&writer, benchmarkWriter, &args);
+    }
+
+    bsls::Stopwatch timer;
+    timer.start();
+
+    barrier.wait();
+    for (int i = 0; i < numReaders; ++i) {
+        bslmt::ThreadUtil::join(readers[i]);
+    }
+
+    timer.stop();
+
+    done = 1;
+    if (withWriter) {
+        bslmt::ThreadUtil::join(writer);
+    }
+
+    return timer.accumulatedWallTime();
+}
+
+}  // close namespace OBJECTCATALOG_TEST_CASE_MINUS_1
+
 // ============================================================================
 //                         CASE 13 RELATED ENTITIES
 // ----------------------------------------------------------------------------
@@ -1107,7 +1344,7 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;;
 
     switch (test) { case 0:  // Zero is always the leading case.
-      case 14: {
+      case 15: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE:
         //   The usage example provided in the component header file must
@@ -1174,6 +1411,96 @@ int main(int argc, char *argv[])
 
         }
       } break;
+      case 14: {
+        // --------------------------------------------------------------------
+        // CONCURRENT LOOKUPS
+        //   Verify that the lock-free lookups are safe with concurrent
+        //   modifications.
+        //
+        // Concerns:
+        //: 1 'find' never copies an object that is being constructed,
+        //:   replaced, or destroyed, and never returns an object for a handle
+        //:   that was removed, while a writer concurrently invokes 'add',
+        //:   'replace', and 'remove'.
+        //:
+        //: 2 The catalog remains consistent, and all memory is released.
+        //
+        // Plan:
+        //: 1 Create a catalog of objects detecting reads of destroyed
+        //:   objects, with one object per slot whose value is congruent to
+        //:   the slot.  Let 'k_NUM_READERS' threads look up the current
+        //:   handles of the slots, and verify the objects they find, while a
+        //:   writer thread replaces the objects, and removes and adds them
+        //:   again (which reuses the same node with a new generation).  (C-1)
+        //:
+        //: 2 Verify the state of the catalog, and that the test allocator
+        //:   has no memory in use once the catalog is destroyed.  (C-2)
+        //
+        // Testing:
+        //   CONCURRENT LOOKUPS
+        // --------------------------------------------------------------------
+        if (verbose) cout << endl
+                          << "CONCURRENT LOOKUPS" << endl
+                          << "==================" << endl;
+
+        using namespace OBJECTCATALOG_TEST_CASE_14;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        {
+            CheckedObj x(&ta);
+
+            for (int i = 0; i < k_NUM_SLOTS; ++i) {
+                handles[i] = x.add(CheckedValue(i, &ta));
+            }
+
+            bslmt::Barrier            barrier(k_NUM_READERS + 1);
+            ReaderArgs                args[k_NUM_READERS];
+            bslmt::ThreadUtil::Handle threads[k_NUM_READERS];
+
+            for (int i = 0; i < k_NUM_READERS; ++i) {
+                ReaderArgs arg = { &x, &barrier, i, 0 };
+                args[i] = arg;
+                bslmt::ThreadUtil::create(&threads[i],
+                                          readerThread,
+                                          &args[i]);
+            }
+
+            barrier.wait();
+
+            for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+                const int slot  = i % k_NUM_SLOTS;
+                const int value = slot + k_NUM_SLOTS * (i / k_NUM_SLOTS);
+
+                if (i % 3) {
+                    LOOP_ASSERTT(i, 0 == x.replace(handles[slot],
+                                                   CheckedValue(value, &ta)));
+                }
+                else {
+                    const int handle = handles[slot];
+
+                    LOOP_ASSERTT(i, 0 == x.remove(handle));
+                    LOOP_ASSERTT(i, 0 != x.find(handle));
+
+                    handles[slot] = x.add(CheckedValue(value, &ta));
+                    LOOP_ASSERTT(i, handle != handles[slot]);
+                }
+                if (0 == i % 256) {
+                    bslmt::ThreadUtil::yield();
+                }
+            }
+
+            done = 1;
+
+            for (int i = 0; i < k_NUM_READERS; ++i) {
+                bslmt::ThreadUtil::join(threads[i]);
+                if (veryVerbose) { P_(i) P(args[i].d_numFound) }
+            }
+
+            x.verifyState();
+            ASSERT(k_NUM_SLOTS == x.length());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
       case 13: {
         // --------------------------------------------------------------------
         // CONCURRENCY TEST:
@@ -2285,6 +2612,34 @@ int main(int argc, char *argv[])
         }
 
       } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //   Measure the cost of 'find' (copying an 'int') for 1 to 8 reader
+        //   threads, with and without a concurrent thread replacing objects.
+        //   The optional second argument specifies the number of lookups per
+        //   thread.
+        // --------------------------------------------------------------------
+
+        using namespace OBJECTCATALOG_TEST_CASE_MINUS_1;
+
+        int numIterations = argc > 2 ? atoi(argv[2]) : 0;
+        if (0 >= numIterations) {
+            numIterations = 1000 * 1000;
+        }
+
+        cout << "ns per find: readers, without writer, with writer" << endl;
+
+        for (int numReaders = 1; numReaders <= 8; numReaders *= 2) {
+            const double scale = 1.0e9 / numIterations;
+
+            cout << numReaders << ", "
+                 << runBenchmark(numReaders, numIterations, false) * scale
+                 << ", "
+                 << runBenchmark(numReaders, numIterations, true) * scale
+                 << endl;
+        }
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
@@ -21,7 +21,7 @@ BSLS_IDENT("$Id: $")
 //  bdlcc::ObjectPool: thread-enabled container of managed objects
 //  bdlcc::ObjectPoolFunctors: namespace for resetter/creator implementations
 //
-//@SEE_ALSO: bdlcc_sharedobjectpool
+//@SEE_ALSO: bdlcc_sharedobjectpool, bdlcc_cachedobjectpool
 //
 //@DESCRIPTION: This component provides a generic thread-safe pool of objects,
 // 'bdlcc::ObjectPool', using the acquire-release idiom and a 'struct' with
@@ -124,6 +124,14 @@ BSLS_IDENT("$Id: $")
 // number of objects.  If 'growBy' is not specified, it defaults to -1 (i.e.,
 // geometric increase beginning at 1).
 //
+///Transferring Objects in Bulk
+///----------------------------
+// 'getObjects' and 'releaseObjects' respectively obtain and return several
+// objects in a single call.  'releaseObjects' adds all the returned objects to
+// the free list with a single atomic operation, which reduces contention on
+// the head of the free list when objects are returned in batches, for example
+// by a per-thread cache of objects such as 'bdlcc::CachedObjectPool'.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -374,6 +382,10 @@ BSLS_IDENT("$Id: $")
 #include <bsls_atomicoperations.h>
 #endif
 
+#ifndef INCLUDED_BSLS_EXCEPTIONUTIL
+#include <bsls_exceptionutil.h>
+#endif
+
 #ifndef INCLUDED_BSLS_OBJECTBUFFER
 #include <bsls_objectbuffer.h>
 #endif
@@ -838,6 +850,12 @@ class ObjectPool : public bdlma::Factory<TYPE> {
         // Create the specified 'numObjects' objects and attach them to this
         // object pool.
 
+    bool releaseNode(ObjectNode *node);
+        // Mark the object of the specified 'node' as available, and return
+        // 'true' if 'node' must be added to the free list by the caller, and
+        // 'false' if it is taken by a thread concurrently executing
+        // 'getObject'.
+
   public:
     // TYPES
     typedef RESETTER ResetterType;
@@ -930,6 +948,14 @@ class ObjectPool : public bdlma::Factory<TYPE> {
         // specified at the pool construction (or an implementation-defined
         // strategy if none was provided).
 
+    void getObjects(TYPE **objects, int numObjects);
+        // Load into the specified 'objects' array the addresses of the
+        // specified 'numObjects' modifiable objects from this object pool, as
+        // if by 'numObjects' calls to 'getObject'.  If an exception is thrown,
+        // the objects already obtained are returned to this pool.  The
+        // behavior is undefined unless '0 <= numObjects' and 'objects' has at
+        // least 'numObjects' elements.
+
     void increaseCapacity(int numObjects);
         // Create the specified 'numObjects' objects and add them to this
         // object pool.  The behavior is undefined unless '0 <= numObjects'.
@@ -944,6 +970,14 @@ class ObjectPool : public bdlma::Factory<TYPE> {
         // 'getObject' requests.  The behavior is undefined unless the 'object'
         // was obtained from this object pool's 'getObject' method.
 
+    void releaseObjects(TYPE * const *objects, int numObjects);
+        // Return the specified 'numObjects' objects whose addresses are held
+        // in the specified 'objects' array back to this object pool, as if by
+        // 'numObjects' calls to 'releaseObject', but adding them to the free
+        // list with a single atomic operation.  The behavior is undefined
+        // unless '0 <= numObjects', and each of the objects was obtained from
+        // this object pool and is returned only once.
+
     void reserveCapacity(int numObjects);
         // Create enough objects to satisfy requests for at least the specified
         // 'numObjects' objects before the next replenishment.  The behavior is
@@ -1056,6 +1090,39 @@ void ObjectPool<TYPE, CREATOR, RESETTER>::addObjects(int numObjects)
     d_numAvailableObjects.addRelaxed(numObjects);
 }
 
+template <class TYPE, class CREATOR, class RESETTER>
+bool ObjectPool<TYPE, CREATOR, RESETTER>::releaseNode(ObjectNode *node)
+{
+    int refCount = bsls::AtomicOperations::getIntRelaxed(
+                                                    &node->d_inUse.d_refCount);
+    do {
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(2 == refCount)) {
+            refCount = bsls::AtomicOperations::testAndSwapInt(
+                                                     &node->d_inUse.d_refCount,
+                                                     2,
+                                                     0);
+            if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(2 == refCount)) {
+                return true;                                          // RETURN
+            }
+        }
+
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        const int oldRefCount = refCount;
+        refCount = bsls::AtomicOperations::testAndSwapInt(
+                                                   &node->d_inUse.d_refCount,
+                                                   refCount,
+                                                   refCount - 1);
+        if (oldRefCount == refCount) {
+            // Someone else is still trying to pop this item.  Just let them
+            // have it.
+
+            return false;                                             // RETURN
+        }
+
+    } while (1);
+}
+
 // CREATORS
 template <class TYPE, class CREATOR, class RESETTER>
 ObjectPool<TYPE, CREATOR, RESETTER>::ObjectPool(
@@ -1268,6 +1335,26 @@ TYPE *ObjectPool<TYPE, CREATOR, RESETTER>::getObject()
     return (TYPE *)(p+1);
 }
 
+template <class TYPE, class CREATOR, class RESETTER>
+void ObjectPool<TYPE, CREATOR, RESETTER>::getObjects(TYPE **objects,
+                                                     int    numObjects)
+{
+    BSLS_ASSERT(0 <= numObjects);
+    BSLS_ASSERT(objects || 0 == numObjects);
+
+    int i = 0;
+
+    BSLS_TRY {
+        for (; i < numObjects; ++i) {
+            objects[i] = getObject();
+        }
+    }
+    BSLS_CATCH(...) {
+        releaseObjects(objects, i);
+        BSLS_RETHROW;
+    }
+}
+
 template <class TYPE, class CREATOR, class RESETTER>
 void ObjectPool<TYPE, CREATOR, RESETTER>::increaseCapacity(int numObjects)
 {
@@ -1283,35 +1370,12 @@ void ObjectPool<TYPE, CREATOR, RESETTER>::releaseObject(TYPE *object)
     ObjectNode *current = (ObjectNode *)(void *)object - 1;
     d_objectResetter.object()(object);
 
-    int refCount = bsls::AtomicOperations::getIntRelaxed(
-                                                 &current->d_inUse.d_refCount);
-    do {
-        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(2 == refCount)) {
-            refCount = bsls::AtomicOperations::testAndSwapInt(
-                                                  &current->d_inUse.d_refCount,
-                                                  2,
-                                                  0);
-            if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(2 == refCount)) {
-                break;
-            }
-        }
-
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!releaseNode(current))) {
         BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
 
-        const int oldRefCount = refCount;
-        refCount = bsls::AtomicOperations::testAndSwapInt(
-                                                &current->d_inUse.d_refCount,
-                                                refCount,
-                                                refCount - 1);
-        if (oldRefCount == refCount) {
-            // Someone else is still trying to pop this item.  Just let them
-            // have it.
-
-            d_numAvailableObjects.addRelaxed(1);
-            return;                                                   // RETURN
-        }
-
-    } while (1);
+        d_numAvailableObjects.addRelaxed(1);
+        return;                                                       // RETURN
+    }
 
     ObjectNode *head = d_freeObjectsList.loadRelaxed();
     for (;;) {
@@ -1326,6 +1390,50 @@ void ObjectPool<TYPE, CREATOR, RESETTER>::releaseObject(TYPE *object)
     d_numAvailableObjects.addRelaxed(1);
 }
 
+template <class TYPE, class CREATOR, class RESETTER>
+void ObjectPool<TYPE, CREATOR, RESETTER>::releaseObjects(
+                                                   TYPE * const *objects,
+                                                   int           numObjects)
+{
+    BSLS_ASSERT(0 <= numObjects);
+    BSLS_ASSERT(objects || 0 == numObjects);
+
+    // Link the nodes that must be added to the free list into a chain, and
+    // attach the chain to 'd_freeObjectsList' with a single atomic operation.
+    // Note that the nodes of the chain cannot be referenced by any thread
+    // concurrently executing 'getObject', as 'releaseNode' returned 'true'.
+
+    ObjectNode *first = 0;
+    ObjectNode *last  = 0;
+
+    for (int i = 0; i < numObjects; ++i) {
+        ObjectNode *current = (ObjectNode *)(void *)objects[i] - 1;
+        d_objectResetter.object()(objects[i]);
+
+        if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(releaseNode(current))) {
+            current->d_inUse.d_next_p = first;
+            first = current;
+            if (!last) {
+                last = current;
+            }
+        }
+    }
+
+    if (first) {
+        ObjectNode *head = d_freeObjectsList.loadRelaxed();
+        for (;;) {
+            last->d_inUse.d_next_p = head;
+            ObjectNode * const oldHead = head;
+            head = d_freeObjectsList.testAndSwap(head, first);
+            if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(oldHead == head)) {
+                break;
+            }
+            BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+        }
+    }
+    d_numAvailableObjects.addRelaxed(numObjects);
+}
+
 template <class TYPE, class CREATOR, class RESETTER>
 void ObjectPool<TYPE, CREATOR, RESETTER>::reserveCapacity(int numObjects)
 {
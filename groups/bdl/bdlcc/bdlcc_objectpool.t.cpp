@@ -39,6 +39,7 @@
 #include <bsl_iostream.h>
 #include <bsl_memory.h>
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 using namespace BloombergLP;
 using namespace bsl;  // automatically added by script
@@ -93,8 +94,10 @@ using namespace bsl;  // automatically added by script
 //
 // MANIPULATORS
 // [ 2] TYPE *getObject();
+// [18] void getObjects(TYPE **objects, int numObjects);
 // [ 8] void increaseCapacity(int numObjects);
 // [ 9] void releaseObject(TYPE *objPtr);
+// [18] void releaseObjects(TYPE * const *objects, int numObjects);
 // [ 1] void reserveCapacity(int numObjects);
 //
 // ACCESSORS
@@ -496,6 +499,99 @@ void case13Processor(bdlcc::ObjectPool<Case13Type>  *mX,
 
 }  // close unnamed namespace
 
+//                         CASE 18 RELATED ENTITIES
+//-----------------------------------------------------------------------------
+
+namespace OBJECTPOOL_TEST_CASE_18
+
+{
+
+enum {
+    k_NUM_THREADS    = 4,
+    k_BATCH_SIZE     = 16,
+    k_NUM_ITERATIONS = 2000
+};
+
+class Counter
+{
+    int d_count;
+    int d_numResets;
+public:
+    Counter() : d_count(0), d_numResets(0)
+    {
+    }
+
+    void increment()
+    {
+        ++d_count;
+    }
+
+    void reset()
+    {
+        ++d_numResets;
+    }
+
+    int count() const
+    {
+        return d_count;
+    }
+
+    int numResets() const
+    {
+        return d_numResets;
+    }
+};
+
+typedef bdlcc::ObjectPool<Counter,
+                          bdlcc::ObjectPoolFunctors::DefaultCreator,
+                          bdlcc::ObjectPoolFunctors::Reset<Counter> > Pool;
+
+Pool *pool;
+
+bslmt::Barrier barrier(k_NUM_THREADS);
+
+extern "C"
+void *workerThread18(void *arg)
+    // Repeatedly obtain a batch of objects from 'pool', increment them, and
+    // return them, alternating between bulk and single object operations
+    // based on the thread index passed in the specified 'arg'.
+{
+    const int index = static_cast<int>(static_cast<char *>(arg) -
+                                       static_cast<char *>(0));
+
+    Counter *objects[k_BATCH_SIZE];
+
+    barrier.wait();
+    for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+        const int numObjects = 1 + (i + index) % k_BATCH_SIZE;
+
+        if ((i + index) % 3) {
+            pool->getObjects(objects, numObjects);
+        }
+        else {
+            for (int j = 0; j < numObjects; ++j) {
+                objects[j] = pool->getObject();
+            }
+        }
+
+        for (int j = 0; j < numObjects; ++j) {
+            objects[j]->increment();
+        }
+
+        if ((i + index) % 2) {
+            pool->releaseObjects(objects, numObjects);
+        }
+        else {
+            for (int j = 0; j < numObjects; ++j) {
+                pool->releaseObject(objects[j]);
+            }
+        }
+    }
+    return NULL;
+}
+
+}  // close namespace OBJECTPOOL_TEST_CASE_18
+
 //                         CASE 12 RELATED ENTITIES
 //-----------------------------------------------------------------------------
 
@@ -1304,6 +1400,134 @@ int main(int argc, char *argv[])
     using namespace bdlf::PlaceHolders;
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 18: {
+        // --------------------------------------------------------------------
+        // TESTING 'getObjects' AND 'releaseObjects'
+        //
+        // Concerns:
+        //: 1 'getObjects' supplies distinct objects, replenishing the pool as
+        //:   needed, and 'releaseObjects' makes the objects available again,
+        //:   invoking the resetter once for each object.
+        //:
+        //: 2 'numAvailableObjects' and 'numObjects' are maintained.
+        //:
+        //: 3 Transferring zero objects has no effect.
+        //:
+        //: 4 Bulk and single object operations may be mixed concurrently
+        //:   without losing or duplicating objects.
+        //
+        // Plan:
+        //: 1 Obtain batches of objects from a pool with 'getObjects', verify
+        //:   the objects are distinct and the values of the accessors, then
+        //:   return them with 'releaseObjects', verifying the number of
+        //:   resets, and obtain them again.  (C-1..3)
+        //:
+        //: 2 Run several threads, each repeatedly obtaining a batch of
+        //:   objects (with 'getObjects' or 'getObject'), incrementing the
+        //:   counter of each object, and returning them (with
+        //:   'releaseObjects' or 'releaseObject').  Verify that the sum of
+        //:   the counters, and of the numbers of resets, equal the number of
+        //:   objects obtained, and that all objects are available.  (C-4)
+        //
+        // Testing:
+        //   void getObjects(TYPE **objects, int numObjects);
+        //   void releaseObjects(TYPE * const *objects, int numObjects);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'getObjects' AND 'releaseObjects'"
+                          << endl
+                          << "========================================="
+                          << endl;
+
+        using namespace OBJECTPOOL_TEST_CASE_18;
+
+        if (verbose) cout << "\nSingle thread." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Pool p(4, &ta);
+
+            Counter *objects[k_BATCH_SIZE];
+
+            p.getObjects(objects, 0);
+            p.releaseObjects(objects, 0);
+            ASSERT(0 == p.numObjects());
+            ASSERT(0 == p.numAvailableObjects());
+
+            p.getObjects(objects, k_BATCH_SIZE);
+            LOOP_ASSERT(p.numObjects(), k_BATCH_SIZE == p.numObjects());
+            LOOP_ASSERT(p.numAvailableObjects(),
+                        0 == p.numAvailableObjects());
+
+            for (int i = 0; i < k_BATCH_SIZE; ++i) {
+                for (int j = 0; j < i; ++j) {
+                    LOOP2_ASSERT(i, j, objects[i] != objects[j]);
+                }
+                objects[i]->increment();
+            }
+
+            p.releaseObjects(objects, k_BATCH_SIZE);
+            LOOP_ASSERT(p.numAvailableObjects(),
+                        k_BATCH_SIZE == p.numAvailableObjects());
+
+            for (int i = 0; i < k_BATCH_SIZE; ++i) {
+                LOOP_ASSERT(i, 1 == objects[i]->numResets());
+            }
+
+            Counter *again[k_BATCH_SIZE];
+            p.getObjects(again, k_BATCH_SIZE);
+            LOOP_ASSERT(p.numObjects(), k_BATCH_SIZE == p.numObjects());
+
+            int totalCount = 0;
+            for (int i = 0; i < k_BATCH_SIZE; ++i) {
+                totalCount += again[i]->count();
+            }
+            LOOP_ASSERT(totalCount, k_BATCH_SIZE == totalCount);
+
+            p.releaseObjects(again, k_BATCH_SIZE / 2);
+            for (int i = k_BATCH_SIZE / 2; i < k_BATCH_SIZE; ++i) {
+                p.releaseObject(again[i]);
+            }
+            LOOP_ASSERT(p.numAvailableObjects(),
+                        k_BATCH_SIZE == p.numAvailableObjects());
+        }
+
+        if (verbose) cout << "\nMultiple threads." << endl;
+        {
+            bslma::TestAllocator ta(veryVeryVerbose);
+            Pool p(-1, &ta);
+            pool = &p;
+
+            executeInParallel(k_NUM_THREADS, workerThread18);
+
+            int expected = 0;
+            for (int t = 0; t < k_NUM_THREADS; ++t) {
+                for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+                    expected += 1 + (i + t) % k_BATCH_SIZE;
+                }
+            }
+
+            const int numObjects = p.numObjects();
+            LOOP2_ASSERT(numObjects,
+                         p.numAvailableObjects(),
+                         numObjects == p.numAvailableObjects());
+
+            bsl::vector<Counter *> objects(numObjects);
+            p.getObjects(&objects[0], numObjects);
+
+            int totalCount  = 0;
+            int totalResets = 0;
+            for (int i = 0; i < numObjects; ++i) {
+                totalCount  += objects[i]->count();
+                totalResets += objects[i]->numResets();
+            }
+            LOOP2_ASSERT(totalCount, expected, expected == totalCount);
+            LOOP2_ASSERT(totalResets, expected, expected == totalResets);
+            LOOP_ASSERT(p.numObjects(), numObjects == p.numObjects());
+
+            p.releaseObjects(&objects[0], numObjects);
+        }
+      } break;
       case 17: {
         /////////////////////////////////////////////////////////
         // bdlma::Factory test
@@ -80,6 +80,30 @@ int SkipList_Control::incrementRefCount()
     return newBits & k_REF_COUNT_MASK;
 }
 
+int SkipList_Control::tryIncrementRefCount()
+{
+    int oldBits = d_cw;
+    if (0 == (oldBits & k_REF_COUNT_MASK)) {
+        return 0;                                                     // RETURN
+    }
+    BSLS_ASSERT((oldBits & k_REF_COUNT_MASK) != k_REF_COUNT_MASK);
+
+    int newBits = oldBits + k_REF_COUNT_INC;
+    int result;
+
+    while (oldBits != (result = d_cw.testAndSwap(oldBits, newBits))) {
+        oldBits = result;
+        if (0 == (oldBits & k_REF_COUNT_MASK)) {
+            return 0;                                                 // RETURN
+        }
+        BSLS_ASSERT((oldBits & k_REF_COUNT_MASK) != k_REF_COUNT_MASK);
+
+        newBits = oldBits + k_REF_COUNT_INC;
+    }
+
+    return newBits & k_REF_COUNT_MASK;
+}
+
 int SkipList_Control::decrementRefCount()
 {
     int oldBits = d_cw;
@@ -178,7 +202,11 @@ namespace bdlcc {
                          // class SkipList_PoolManager
                          // ==========================
 
-class SkipList_PoolManager {
+class SkipList_PoolManager : public bslma::Allocator {
+    // This component-private class manages the pools of list nodes, one per
+    // level.  It is an allocator so that the nodes retired to an epoch manager
+    // can be returned to their pool by 'deallocate'.
+
     enum {
         k_MAX_POOLS                       =  32,
 
@@ -194,6 +222,7 @@ class SkipList_PoolManager {
     bslmt::Mutex                       d_mutex;      // protects the block list
 
     Pool                              d_pools[k_MAX_POOLS];
+    int                               d_numPools;
 
     void initPool(Pool *pool, int level, int objectSize);
     void replenish(Pool *pool);
@@ -208,10 +237,18 @@ class SkipList_PoolManager {
     explicit SkipList_PoolManager(int              *objectSizes,
                                   int               numPools,
                                   bslma::Allocator *basicAllocator);
-    ~SkipList_PoolManager();
+    virtual ~SkipList_PoolManager();
+
+    void *allocateNode(int level);
 
-    void *allocate(int level);
-    void deallocate(void *node);
+    virtual void *allocate(size_type size);
+        // Return a node from the pool of the lowest level whose nodes have at
+        // least the specified 'size' bytes.  The behavior is undefined unless
+        // such a pool exists.
+
+    virtual void deallocate(void *address);
+        // Return the node at the specified 'address' to the pool of its level.
+        // If 'address' is 0, this method has no effect.
 };
 
 void SkipList_PoolManager::replenish(Pool *pool)
@@ -347,6 +384,7 @@ SkipList_PoolManager::SkipList_PoolManager(int              *objectSizes,
                                            int               numPools,
                                            bslma::Allocator *basicAllocator)
 : d_blockList(basicAllocator)
+, d_numPools(numPools)
 {
     BSLS_ASSERT(numPools > 0);
     BSLS_ASSERT(numPools <= k_MAX_POOLS);
@@ -359,22 +397,36 @@ SkipList_PoolManager::SkipList_PoolManager(int              *objectSizes,
     }
 }
 
-inline
 SkipList_PoolManager::~SkipList_PoolManager()
 {
 }
 
 inline
-void *SkipList_PoolManager::allocate(int level)
+void *SkipList_PoolManager::allocateNode(int level)
 {
     return allocate(&d_pools[level]);
 }
 
-inline
-void SkipList_PoolManager::deallocate(void *node)
+void *SkipList_PoolManager::allocate(size_type size)
+{
+    int level = 0;
+    while (level < d_numPools - 1
+        && d_pools[level].d_objectSize < static_cast<int>(size)) {
+        ++level;
+    }
+    BSLS_ASSERT(static_cast<int>(size) <= d_pools[level].d_objectSize);
+
+    return allocate(&d_pools[level]);
+}
+
+void SkipList_PoolManager::deallocate(void *address)
 {
-    int level = reinterpret_cast<Node *>(node)->d_control.level();
-    deallocate(&d_pools[level], node);
+    if (!address) {
+        return;                                                       // RETURN
+    }
+
+    int level = reinterpret_cast<Node *>(address)->d_control.level();
+    deallocate(&d_pools[level], address);
 }
 
                           // =======================
@@ -383,7 +435,12 @@ void SkipList_PoolManager::deallocate(void *node)
 
 void *SkipList_PoolUtil::allocate(PoolManager *poolManager, int level)
 {
-    return poolManager->allocate(level);
+    return poolManager->allocateNode(level);
+}
+
+bslma::Allocator *SkipList_PoolUtil::allocator(PoolManager *poolManager)
+{
+    return poolManager;
 }
 
 void SkipList_PoolUtil::deallocate(PoolManager *poolManager, void *address)
@@ -105,6 +105,36 @@ BSLS_IDENT("$Id: $")
 // pair found by 'find' may (or may not) be different from the one found by
 // 'findR'.
 //
+///Lock-Free Lookups
+///-----------------
+// The methods searching the list from the front ('exists', 'find',
+// 'findLowerBound', 'findUpperBound', and their "Raw" variants), the methods
+// traversing the list forward ('front', 'next', 'skipForward', and their
+// "Raw" variants), and 'isEmpty' do not acquire the mutex of the list: any
+// number of threads may perform these operations concurrently with each other
+// and with a modification of the list, so that lookups scale with the number
+// of reading threads.  Insertions, removals, updates, the "R" methods, and the
+// methods traversing the list backward ('back', 'previous', 'skipBackward')
+// remain serialized by the mutex.
+//
+// A lookup encountering a pair that is being removed (or moved by 'update')
+// restarts its search; a lookup is therefore delayed only by modifications of
+// the list, never by other lookups.  Lookups are critical sections of a
+// 'bdlcc::EpochManager' owned by the list: the release of the last reference
+// to a removed pair destroys its data, and retires the pair to that manager,
+// which destroys its key once no lookup may still be comparing it, so that
+// neither the releasing thread nor any writer waits for the lookups in
+// progress.  'update' and 'updateR' unlink the pair, and wait for the lookups
+// that may be comparing its key *without* holding the mutex, before assigning
+// the new key and reinserting the pair; while a pair is being moved, it is not
+// found by lookups (neither at its old nor at its new key), and other
+// operations modifying or traversing the list from that pair wait for the
+// move to complete.  Note that each thread performing lock-free lookups on a
+// list is registered with the epoch manager of the list until it exits, and
+// that the records of all threads are found through a thread-specific storage
+// key shared by all lists (see 'bdlcc_epochmanager'), so that the number of
+// lists is not bounded by the number of keys available to a process.
+//
 ///'bdlcc::SkipListPair' Usage Rules
 ///---------------------------------
 // For safe and correct behavior of this component, it is critical that
@@ -123,7 +153,14 @@ BSLS_IDENT("$Id: $")
 // 'bdlcc::SkipList' is thread-safe and thread-aware; that is, multiple threads
 // may use their own Skip List objects or may concurrently use the same object.
 // Note that safe usage of the component depends upon correct usage of
-// 'bdlcc::SkipListPair' objects (see above).
+// 'bdlcc::SkipListPair' objects (see above).  The behavior is undefined if a
+// list is destroyed while any other thread is using it; a list may, however,
+// be destroyed while threads that have performed lookups on it exit.
+//
+// A lookup concurrent with 'update' or 'updateR' of a pair may fail to find
+// that pair, as the pair is not in the list while it is being moved (see
+// "Lock-Free Lookups" above); a lookup that must find every pair whose key is
+// being updated must be serialized with the update by the caller.
 //
 // 'bdlcc::SkipListPairHandle' is only *const* *thread-safe*.  It is not safe
 // for multiple threads to invoke non-const methods on the same PairHandle
@@ -336,6 +373,10 @@ BSLS_IDENT("$Id: $")
 #include <bdlscm_version.h>
 #endif
 
+#ifndef INCLUDED_BDLCC_EPOCHMANAGER
+#include <bdlcc_epochmanager.h>
+#endif
+
 #ifndef INCLUDED_BSLMT_LOCKGUARD
 #include <bslmt_lockguard.h>
 #endif
@@ -452,6 +493,12 @@ struct SkipList_Control {
         // the new reference count.  The behavior is undefined if the reference
         // count is at the implementation-defined maximum.
 
+    int tryIncrementRefCount();
+        // Add 1 to the reference count portion of this control word unless
+        // the reference count is 0.  Return the new reference count, or 0 if
+        // the reference count was 0.  The behavior is undefined if the
+        // reference count is at the implementation-defined maximum.
+
     int decrementRefCount();
         // Subtract 1 from the reference count portion of this control word.
         // Return the new reference count.  The behavior is undefined if the
@@ -476,13 +523,16 @@ struct SkipList_Node {
 
     struct Ptrs {
         // PUBLIC DATA
-        Node *d_next_p;
-        Node *d_prev_p;
+        bsls::AtomicPointer<Node> d_next_p;  // 0 at level 0 if not in list
+        Node                     *d_prev_p;  // accessed under the list lock
     };
 
     // DATA
     Control        d_control;    // must be first!
 
+    bool           d_isMoving;   // 'true' while moved by 'update'; accessed
+                                 // under the list lock
+
     DATA           d_data;
 
     KEY            d_key;
@@ -494,6 +544,7 @@ struct SkipList_Node {
     int  decrementRefCount();
     int  incrementRefCount();
     void initControlWord(int level);
+    int  tryIncrementRefCount();
 
     // ACCESSORS
     int level() const;
@@ -558,6 +609,12 @@ struct SkipList_PoolUtil {
         // 'poolManager'.  The behavior is undefined if 'address' was not
         // allocated from 'poolManager'.
 
+    static bslma::Allocator *allocator(PoolManager *poolManager);
+        // Return the address of an allocator whose 'deallocate' method
+        // returns a node to the specified 'poolManager'.  The behavior is
+        // undefined unless the nodes supplied to 'deallocate' were allocated
+        // from 'poolManager'.
+
     static PoolManager *createPoolManager(int              *objectSizes,
                                           int               numLevels,
                                           bslma::Allocator *basicAllocator);
@@ -785,6 +842,39 @@ class SkipList {
     typedef bslmt::Mutex                        Lock;
     typedef bslmt::LockGuard<bslmt::Mutex>      LockGuard;
 
+    class RelinkProctor;
+    friend class RelinkProctor;
+
+    class RelinkProctor {
+        // This private class reinserts into a list a node unlinked by
+        // 'unlinkNode', unless released, on destruction.  It is used to
+        // restore a node when the assignment of its new key throws in
+        // 'updateNode' and 'updateNodeR'.
+
+        // DATA
+        SkipList *d_list_p;  // list (held, not owned)
+        Node     *d_node_p;  // unlinked node, or 0 if released
+
+      private:
+        // NOT IMPLEMENTED
+        RelinkProctor(const RelinkProctor&);
+        RelinkProctor& operator=(const RelinkProctor&);
+
+      public:
+        // CREATORS
+        RelinkProctor(SkipList *list, Node *node);
+            // Create a proctor reinserting the specified 'node' into the
+            // specified 'list' on destruction unless released.
+
+        ~RelinkProctor();
+            // Reinsert the node supplied at construction into its list,
+            // unless this proctor is released.
+
+        // MANIPULATORS
+        void release();
+            // Release the node managed by this proctor from management.
+    };
+
     // DATA
     SkipList_RandomLevelGenerator              d_rand;
 
@@ -796,6 +886,8 @@ class SkipList {
 
     int                                        d_length;
 
+    EpochManager                              *d_epochs_p; // owned
+
     PoolManager                               *d_poolManager_p; // owned
 
     bslma::Allocator                          *d_allocator_p; // held
@@ -817,6 +909,12 @@ class SkipList {
         // Return a non-'const' reference to the "data" value of the pair
         // identified by the specified 'reference'.
 
+    static void deleteNode(void *node, bslma::Allocator *poolAllocator);
+        // Destroy the key of the specified 'node', whose data was destroyed,
+        // and return 'node' to its pool using the specified 'poolAllocator'.
+        // This function is the deleter of the nodes retired by 'releaseNode'
+        // and 'removeAllImp'.
+
     // PRIVATE MANIPULATORS
     void addNode(bool *newFrontFlag, Node *newNode);
         // Acquire the lock, add the specified 'newNode' to the list, and
@@ -877,19 +975,24 @@ class SkipList {
         // the front of the list, and 'false' otherwise.  This method must be
         // called under the lock.
 
-    void moveImp(bool *newFrontFlag, Node *location[], Node *node);
-        // Like 'insert', but the specified 'node' must already be present in
-        // the list.  This internal method must be called under the lock.
-
     Node *popFrontImp();
         // Acquire the lock, remove the front of the list, and release the
         // lock.  Return the node that was at the front of the list, or 0 if
         // the list was empty.
 
+    void relinkNode(Node *node);
+        // Insert the specified 'node', which was unlinked by 'unlinkNode', at
+        // the position of its key value in the list.  This internal method
+        // must be called under the lock.
+
     void releaseNode(Node *node);
         // Decrement the reference count of the specified 'node', and if it
-        // reaches 0, destroy 'node' and return it to the pool.  Note that this
-        // method neither acquires nor requires the lock.
+        // reaches 0, destroy its data and retire 'node' to 'd_epochs_p', which
+        // destroys its key and returns it to the pool once no lock-free lookup
+        // may be examining it.  Note that this method neither acquires nor
+        // requires the lock, and must not be called under the lock nor during
+        // a lock-free lookup, as retiring a node may wait for the lookups in
+        // progress (see {'bdlcc_epochmanager'|Bounded Garbage}).
 
     int removeAllImp(bsl::vector<Pair *> *removed, bool unlock);
         // Remove all items from this list, and then unlock the mutex if the
@@ -899,41 +1002,55 @@ class SkipList {
         // is no longer needed.  Note that the pairs in 'removed' will be in
         // ascending order by key value.  Return the number of items that were
         // removed from the list.  This internal method must be called under
-        // the lock.
+        // the lock.  The behavior is undefined unless 'removed' is not 0 or
+        // 'unlock' is 'true'.
 
     int removeNode(Node *node);
         // Acquire the lock, remove the specified 'node' from the list, and
         // release the lock.  Return 0 on success, and 'e_NOT_FOUND' if the
         // 'node' is no longer in the list.
 
+    void unlinkNode(Node *node);
+        // Remove the specified 'node' from the list.  The node is first
+        // marked as removed (its level-0 "next" pointer is set to 0), so that
+        // a concurrent lock-free lookup reaching it restarts, and then
+        // unlinked at each of its levels.  Note that the other pointers of
+        // 'node' are not modified, so that a concurrent lock-free lookup
+        // positioned at 'node' may proceed.  This internal method must be
+        // called under the lock.
+
     int updateNode(bool       *newFrontFlag,
                    Node       *node,
                    const KEY&  newKey,
                    bool        allowDuplicates);
-        // Acquire the lock, move the specified 'node' to the correct position
-        // for the specified 'newKey', and release the lock.  Update the key
-        // value of 'node' to the 'newKey' value.  If the specified
-        // 'newFrontFlag' is not 0, load into it a 'true' value if the new
-        // location of the node is the front of the list, and a 'false' value
-        // otherwise.  Return 0 on success, 'e_NOT_FOUND' if the node is no
-        // longer in the list, or 'e_DUPLICATE' if the specified
-        // 'allowDuplicates' is 'false' and 'newKey' already appears in the
-        // list.
+        // Move the specified 'node' to the correct position for the
+        // specified 'newKey', and update the key value of 'node' to the
+        // 'newKey' value.  If the specified 'newFrontFlag' is not 0, load into
+        // it a 'true' value if the new location of the node is the front of
+        // the list, and a 'false' value otherwise.  Return 0 on success,
+        // 'e_NOT_FOUND' if the node is no longer in the list, or
+        // 'e_DUPLICATE' if the specified 'allowDuplicates' is 'false' and
+        // 'newKey' already appears in the list.  This method acquires the
+        // lock to unlink 'node', releases it while waiting for the lock-free
+        // lookups that may be comparing the key of 'node', and acquires it
+        // again to assign the key and reinsert 'node'.  The behavior is
+        // undefined if this method is called during a lock-free lookup.
 
     int updateNodeR(bool       *newFrontFlag,
                     Node       *node,
                     const KEY&  newKey,
                     bool        allowDuplicates);
-        // Acquire the lock, move the specified 'node' to the correct position
-        // for the specified 'newKey', and release the lock.  The search for
-        // the correct location for 'newKey' proceeds from the back of the list
-        // in descending order by by key value.  Update the key value of 'node'
-        // to the 'newKey' value.  If the specified 'newFrontFlag' is not 0,
-        // load into it a 'true' value if the new location of the node is the
-        // front of the list, and a 'false' value otherwise.  Return 0 on
-        // success, 'e_NOT_FOUND' if the node is no longer in the list, or
+        // Move the specified 'node' to the correct position for the
+        // specified 'newKey', and update the key value of 'node' to the
+        // 'newKey' value.  The search for the correct location for 'newKey'
+        // proceeds from the back of the list in descending order by by key
+        // value.  If the specified 'newFrontFlag' is not 0, load into it a
+        // 'true' value if the new location of the node is the front of the
+        // list, and a 'false' value otherwise.  Return 0 on success,
+        // 'e_NOT_FOUND' if the node is no longer in the list, or
         // 'e_DUPLICATE' if the specified 'allowDuplicates' is 'false' and
-        // 'newKey' already appears in the list.
+        // 'newKey' already appears in the list.  The lock is acquired and
+        // released as by 'updateNode'.
 
     // PRIVATE ACCESSORS
     Node *backNode() const;
@@ -941,6 +1058,9 @@ class SkipList {
         // This method acquires and releases the lock.
 
     Node *findNode(const KEY& key) const;
+        // Return the node with the specified 'key', or 0 if no node could be
+        // found.  This method does not acquire the lock.
+
     Node *findNodeR(const KEY& key) const;
         // Return the node with the specified 'key', or 0 if no node could be
         // found.  This method acquires and releases the lock.
@@ -949,7 +1069,7 @@ class SkipList {
         // Return the first node in this list whose key is not less than the
         // specified 'key', found by searching the list from the front (in
         // ascending order of key value), and 0 if no such node exists.  This
-        // method acquires and releases the lock.
+        // method does not acquire the lock.
 
     Node *findNodeLowerBoundR(const KEY& key) const;
         // Return the first node in this list whose key is not less than the
@@ -961,7 +1081,7 @@ class SkipList {
         // Return the first node in this list whose key is greater than the
         // specified 'key', found by searching the list from the front (in
         // ascending order of key value), and 0 if no such node exists.  This
-        // method acquires and releases the lock.
+        // method does not acquire the lock.
 
     Node *findNodeUpperBoundR(const KEY& key) const;
         // Return the first node in this list whose key is greater than the
@@ -971,15 +1091,24 @@ class SkipList {
 
     Node *frontNode() const;
         // Return the node at the front of the list, or 0 if the list is empty.
-        // This method acquires and releases the lock.
+        // This method does not acquire the lock.
+
+    void lockUnlessMoving(Node *node) const;
+        // Acquire the lock once the specified 'node' is not being moved by
+        // 'updateNode' or 'updateNodeR', waiting for the move to complete
+        // without holding the lock.  Note that the lock is held on return.
 
-    void lookupImpLowerBound(Node *location[], const KEY& key) const;
+    int lookupImpLowerBound(Node *location[], const KEY& key) const;
         // Populate the specified 'location' array with the first node whose
         // key is not less than the specified 'key' at each level in the list,
         // found by searching the list from the front (in ascending order of
         // key value); if no such node exists at a given level, the
-        // head-of-list sentinel is populated for that level.  This method must
-        // be called under the lock.
+        // head-of-list sentinel is populated for that level.  Return 0 on
+        // success, and a non-zero value (with 'location' partially populated)
+        // if the search encountered a node marked as removed, in which case
+        // it must be restarted.  This method must be called either under the
+        // lock (in which case it always succeeds) or within a critical
+        // section of 'd_epochs_p'.
 
     void lookupImpLowerBoundR(Node *location[], const KEY& key) const;
         // Populate the specified 'location' array with the first node whose
@@ -989,13 +1118,17 @@ class SkipList {
         // head-of-list sentinel is populated for that level.  This method must
         // be called under the lock.
 
-    void lookupImpUpperBound(Node *location[], const KEY& key) const;
+    int lookupImpUpperBound(Node *location[], const KEY& key) const;
         // Populate the specified 'location' array with the first node whose
         // key is greater than the specified 'key' at each level in the list,
         // found by searching the list from the front (in ascending order of
         // key value); if no such node exists at a given level, the
-        // tail-of-list sentinel is populated for that level.  This method must
-        // be called under the lock.
+        // tail-of-list sentinel is populated for that level.  Return 0 on
+        // success, and a non-zero value (with 'location' partially populated)
+        // if the search encountered a node marked as removed, in which case
+        // it must be restarted.  This method must be called either under the
+        // lock (in which case it always succeeds) or within a critical
+        // section of 'd_epochs_p'.
 
     void lookupImpUpperBoundR(Node *location[], const KEY& key) const;
         // Populate the specified 'location' array with the first node whose
@@ -1007,7 +1140,8 @@ class SkipList {
 
     Node *nextNode(Node *node) const;
         // Return the node after to the specified 'node', or 0 if 'node' is at
-        // the back of the list.  This method acquires and releases the lock.
+        // the back of the list.  This method acquires and releases the lock
+        // only if 'node' appears to have been removed from the list.
 
     Node *prevNode(Node *node) const;
         // Return the node prior to the specified 'node', or 0 if 'node' is at
@@ -1025,7 +1159,8 @@ class SkipList {
         // the list, load a reference to the next item in the list into 'node';
         // otherwise load 0 into 'node'.  Return 0 on success, and
         // 'e_NOT_FOUND' (with no effect on the value of 'node') if 'node' is
-        // no longer in the list.  This method acquires and releases the lock.
+        // no longer in the list.  This method acquires and releases the lock
+        // only if 'node' appears to have been removed from the list.
 
     // NOT IMPLEMENTED
     void addPairReferenceRaw(const PairHandle&);
@@ -1309,7 +1444,8 @@ class SkipList {
         // success, 'e_NOT_FOUND' if the pair referred to by 'reference' is no
         // longer in the list, or 'e_DUPLICATE' if the optionally specified
         // 'allowDuplicates' is 'false' and 'newKey' already appears in the
-        // list.
+        // list.  Note that the pair is not found by concurrent lookups, at
+        // either its old or its new key, while it is being moved.
 
     int updateR(const Pair *reference,
                 const KEY&  newKey,
@@ -1323,7 +1459,9 @@ class SkipList {
         // front of the list.  Return 0 on success, 'e_NOT_FOUND' if the pair
         // referred to by 'reference' is no longer in the list, or
         // 'e_DUPLICATE' if the optionally specified 'allowDuplicates' is
-        // 'false' and 'newKey' already appears in the list.
+        // 'false' and 'newKey' already appears in the list.  Note that the
+        // pair is not found by concurrent lookups, at either its old or its
+        // new key, while it is being moved.
 
     // ACCESSORS
     Pair *addPairReferenceRaw(const Pair *reference) const;
@@ -1723,6 +1861,13 @@ void SkipList_Node<KEY, DATA>::initControlWord(int level)
     d_control.init(level);
 }
 
+template<class KEY, class DATA>
+inline
+int SkipList_Node<KEY, DATA>::tryIncrementRefCount()
+{
+    return d_control.tryIncrementRefCount();
+}
+
 template<class KEY, class DATA>
 inline
 int SkipList_Node<KEY, DATA>::level() const
@@ -1783,6 +1928,31 @@ void SkipList_NodeCreationHelper<KEY, DATA>::construct(const KEY&  key,
                                // class SkipList
                                // --------------
 
+// PRIVATE TYPES
+template<class KEY, class DATA>
+inline
+SkipList<KEY, DATA>::RelinkProctor::RelinkProctor(SkipList *list, Node *node)
+: d_list_p(list)
+, d_node_p(node)
+{
+}
+
+template<class KEY, class DATA>
+inline
+SkipList<KEY, DATA>::RelinkProctor::~RelinkProctor()
+{
+    if (d_node_p) {
+        d_list_p->relinkNode(d_node_p);
+    }
+}
+
+template<class KEY, class DATA>
+inline
+void SkipList<KEY, DATA>::RelinkProctor::release()
+{
+    d_node_p = 0;
+}
+
 // PRIVATE CLASS METHODS
 template<class KEY, class DATA>
 inline
@@ -1804,6 +1974,16 @@ DATA& SkipList<KEY, DATA>::data(const Pair *reference)
     return node->d_data;
 }
 
+template<class KEY, class DATA>
+void SkipList<KEY, DATA>::deleteNode(void             *node,
+                                     bslma::Allocator *poolAllocator)
+{
+    Node *p = static_cast<Node *>(node);
+
+    p->d_key.~KEY();
+    poolAllocator->deallocate(p);
+}
+
 // PRIVATE MANIPULATORS
 template<class KEY, class DATA>
 void SkipList<KEY, DATA>::addNode(bool *newFrontFlag, Node *newNode)
@@ -1904,6 +2084,7 @@ SkipList<KEY, DATA>::allocateNode(int level, const KEY& key, const DATA& data)
     nodeGuard.construct(key, data);
 
     node->incrementRefCount();
+    node->d_isMoving = false;
     node->d_ptrs[0].d_next_p = 0;
 
     return node;
@@ -1914,6 +2095,9 @@ void SkipList<KEY, DATA>::initialize()
 {
     // Assert that this method has not been invoked.
     BSLS_ASSERT(0 == d_poolManager_p);
+    BSLS_ASSERT(0 == d_epochs_p);
+
+    d_epochs_p = new (*d_allocator_p) EpochManager(d_allocator_p);
 
     int nodeSizes[k_MAX_NUM_LEVELS];
 
@@ -1959,72 +2143,35 @@ void SkipList<KEY, DATA>::insertImp(bool *newFrontFlag,
     if (level > d_listLevel) {
         BSLS_ASSERT(level == d_listLevel + 1);
 
-        d_listLevel = level;
-
-        node->d_ptrs[level].d_prev_p = d_head_p;
-        node->d_ptrs[level].d_next_p = d_tail_p;
+        location[level] = d_tail_p;
+    }
 
-        d_head_p->d_ptrs[level].d_next_p = node;
-        d_tail_p->d_ptrs[level].d_prev_p = node;
+    // All the pointers of 'node' are set before 'node' is published, and
+    // 'node' is then published from the bottom level up, so that a lock-free
+    // lookup reaching 'node' at any level finds it in the list.
 
-        level--;
+    for (int k = 0; k <= level; ++k) {
+        node->d_ptrs[k].d_prev_p = location[k]->d_ptrs[k].d_prev_p;
+        node->d_ptrs[k].d_next_p = location[k];
     }
 
-    for (int k = level; k >= 0; --k) {
-        Node *p = location[k]->d_ptrs[k].d_prev_p;
+    for (int k = 0; k <= level; ++k) {
+        Node *p = node->d_ptrs[k].d_prev_p;
         Node *q = location[k];
 
-        node->d_ptrs[k].d_prev_p = p;
-        node->d_ptrs[k].d_next_p = q;
-
-        p->d_ptrs[k].d_next_p = node;
         q->d_ptrs[k].d_prev_p = node;
+        p->d_ptrs[k].d_next_p = node;
     }
 
-    if (newFrontFlag) {
-        *newFrontFlag = (node->d_ptrs[0].d_prev_p == d_head_p);
-    }
-
-    ++d_length;
-}
-
-template<class KEY, class DATA>
-void SkipList<KEY, DATA>::moveImp(bool *newFrontFlag,
-                                  Node *location[],
-                                  Node *node)
-{
-    BSLS_ASSERT(location);
-    BSLS_ASSERT(node);
-
-    int level = node->level();
-    BSLS_ASSERT(level <= d_listLevel);
-
-    for (int k = 0; k <= level; ++k) {
-        Node *newP = location[k]->d_ptrs[k].d_prev_p;
-        Node *newQ = location[k];
-
-        if (newP == node || newQ == node) {
-            // The node's already in the right place.  Since we started at
-            // level 0, there's no more work to do.
-            break;
-        }
-
-        Node *oldP = node->d_ptrs[k].d_prev_p;
-        Node *oldQ = node->d_ptrs[k].d_next_p;
-
-        oldQ->d_ptrs[k].d_prev_p = oldP;
-        oldP->d_ptrs[k].d_next_p = oldQ;
-
-        node->d_ptrs[k].d_prev_p = newP;
-        node->d_ptrs[k].d_next_p = newQ;
-
-        newP->d_ptrs[k].d_next_p = node;
-        newQ->d_ptrs[k].d_prev_p = node;
+    if (level > d_listLevel) {
+        d_listLevel = level;
     }
 
     if (newFrontFlag) {
         *newFrontFlag = (node->d_ptrs[0].d_prev_p == d_head_p);
     }
+
+    ++d_length;
 }
 
 template<class KEY, class DATA>
@@ -2037,18 +2184,20 @@ SkipList_Node<KEY, DATA> *SkipList<KEY, DATA>::popFrontImp()
         return 0;                                                     // RETURN
     }
 
-    int level = node->level();
+    unlinkNode(node);
 
-    for (int k = level; k >= 0; --k) {
-        Node *q = node->d_ptrs[k].d_next_p;
-        q->d_ptrs[k].d_prev_p = d_head_p;
-        d_head_p->d_ptrs[k].d_next_p = q;
-    }
+    return node;
+}
 
-    node->d_ptrs[0].d_next_p = 0;
-    --d_length;
+template<class KEY, class DATA>
+void SkipList<KEY, DATA>::relinkNode(Node *node)
+{
+    BSLS_ASSERT(node);
 
-    return node;
+    Node *location[k_MAX_NUM_LEVELS];
+    lookupImpLowerBound(location, node->d_key);
+
+    insertImp(0, location, node);
 }
 
 template<class KEY, class DATA>
@@ -2060,9 +2209,13 @@ void SkipList<KEY, DATA>::releaseNode(Node *node)
     int refCnt = node->decrementRefCount();
 
     if (!refCnt) {
-        node->d_key.~KEY();
+        // A lock-free lookup may still be comparing the key of 'node', but
+        // never accesses its data once its reference count is 0.
+
         node->d_data.~DATA();
-        PoolUtil::deallocate(d_poolManager_p, node);
+        d_epochs_p->retire(node,
+                           &SkipList::deleteNode,
+                           PoolUtil::allocator(d_poolManager_p));
     }
 }
 
@@ -2102,11 +2255,26 @@ int SkipList<KEY, DATA>::removeAllImp(bsl::vector<Pair *> *removed,
         }
     }
     else {
+        BSLS_ASSERT(unlock);
+
+        // The removed nodes are retired within a critical section, so that
+        // this thread waits for the lock-free lookups that may be examining
+        // them at most once, on leaving the section, rather than each time
+        // 'maxRetiredPerThread' nodes are retired.
+
+        EpochManagerGuard guard(d_epochs_p);
+
+        bslma::Allocator *poolAllocator = PoolUtil::allocator(
+                                                             d_poolManager_p);
+
         while (p != d_head_p) {
             q = p;
             p = q->d_ptrs[0].d_prev_p;
 
-            releaseNode(q);
+            if (0 == q->decrementRefCount()) {
+                q->d_data.~DATA();
+                d_epochs_p->retire(q, &SkipList::deleteNode, poolAllocator);
+            }
         }
     }
     return numRemoved;
@@ -2117,15 +2285,29 @@ int SkipList<KEY, DATA>::removeNode(Node *node)
 {
     BSLS_ASSERT(node);
 
-    LockGuard guard(&d_lock);
+    lockUnlessMoving(node);
+    LockGuard guard(&d_lock, 1);
 
     if (0 == node->d_ptrs[0].d_next_p) {
         return e_NOT_FOUND;                                           // RETURN
     }
 
-    int level = node->level();
+    unlinkNode(node);
+
+    return 0;
+}
+
+template<class KEY, class DATA>
+void SkipList<KEY, DATA>::unlinkNode(Node *node)
+{
+    BSLS_ASSERT(node);
+
+    Node *next = node->d_ptrs[0].d_next_p;
+    BSLS_ASSERT(next);
+
+    node->d_ptrs[0].d_next_p = 0;
 
-    for (int k = level; k >= 0; --k) {
+    for (int k = node->level(); k > 0; --k) {
         Node *p = node->d_ptrs[k].d_prev_p;
         Node *q = node->d_ptrs[k].d_next_p;
 
@@ -2133,9 +2315,12 @@ int SkipList<KEY, DATA>::removeNode(Node *node)
         p->d_ptrs[k].d_next_p = q;
     }
 
-    node->d_ptrs[0].d_next_p = 0;
+    Node *prev = node->d_ptrs[0].d_prev_p;
+
+    next->d_ptrs[0].d_prev_p = prev;
+    prev->d_ptrs[0].d_next_p = next;
+
     --d_length;
-    return 0;
 }
 
 template<class KEY, class DATA>
@@ -2146,26 +2331,59 @@ int SkipList<KEY, DATA>::updateNode(bool       *newFrontFlag,
 {
     BSLS_ASSERT(node);
 
-    LockGuard guard(&d_lock);
+    Node *location[k_MAX_NUM_LEVELS];
 
-    if (0 == node->d_ptrs[0].d_next_p) {
-        return e_NOT_FOUND;                                           // RETURN
+    {
+        lockUnlessMoving(node);
+        LockGuard guard(&d_lock, 1);
+
+        if (0 == node->d_ptrs[0].d_next_p) {
+            return e_NOT_FOUND;                                       // RETURN
+        }
+
+        if (!allowDuplicates) {
+            lookupImpLowerBound(location, newKey);
+
+            Node *q = location[0];
+            if (q != d_tail_p && q != node && q->d_key == newKey) {
+                return e_DUPLICATE;                                   // RETURN
+            }
+        }
+
+        unlinkNode(node);
+        node->d_isMoving = true;
     }
 
-    Node *location[k_MAX_NUM_LEVELS];
+    // The key is modified only once no lock-free lookup may be comparing it;
+    // the lookups are waited for without holding the lock.
+
+    d_epochs_p->synchronize();
+
+    LockGuard guard(&d_lock);
+
+    node->d_isMoving = false;
+
     lookupImpLowerBound(location, newKey);
 
     if (!allowDuplicates) {
         Node *q = location[0];
-        if (q != d_tail_p && q != node && q->d_key == newKey) {
+        if (q != d_tail_p && q->d_key == newKey) {
+            // A pair having 'newKey' was added while the lock was released.
+
+            relinkNode(node);
             return e_DUPLICATE;                                       // RETURN
         }
     }
 
-    node->d_key = newKey;  // may throw
+    {
+        RelinkProctor proctor(this, node);
+
+        node->d_key = newKey;  // may throw
 
-    // now we are committed: change the list!
-    moveImp(newFrontFlag, location, node);
+        proctor.release();
+    }
+
+    insertImp(newFrontFlag, location, node);
 
     return 0;
 }
@@ -2178,26 +2396,59 @@ int SkipList<KEY, DATA>::updateNodeR(bool       *newFrontFlag,
 {
     BSLS_ASSERT(node);
 
-    LockGuard guard(&d_lock);
+    Node *location[k_MAX_NUM_LEVELS];
 
-    if (0 == node->d_ptrs[0].d_next_p) {
-        return e_NOT_FOUND;                                           // RETURN
+    {
+        lockUnlessMoving(node);
+        LockGuard guard(&d_lock, 1);
+
+        if (0 == node->d_ptrs[0].d_next_p) {
+            return e_NOT_FOUND;                                       // RETURN
+        }
+
+        if (!allowDuplicates) {
+            lookupImpLowerBoundR(location, newKey);
+
+            Node *p = location[0];
+            if (p != d_tail_p && p != node && p->d_key == newKey) {
+                return e_DUPLICATE;                                   // RETURN
+            }
+        }
+
+        unlinkNode(node);
+        node->d_isMoving = true;
     }
 
-    Node *location[k_MAX_NUM_LEVELS];
+    // The key is modified only once no lock-free lookup may be comparing it;
+    // the lookups are waited for without holding the lock.
+
+    d_epochs_p->synchronize();
+
+    LockGuard guard(&d_lock);
+
+    node->d_isMoving = false;
+
     lookupImpLowerBoundR(location, newKey);
 
     if (!allowDuplicates) {
         Node *p = location[0];
-        if (p != d_head_p && p != node && p->d_key == newKey) {
+        if (p != d_tail_p && p->d_key == newKey) {
+            // A pair having 'newKey' was added while the lock was released.
+
+            relinkNode(node);
             return e_DUPLICATE;                                       // RETURN
         }
     }
 
-    node->d_key = newKey;  // may throw
+    {
+        RelinkProctor proctor(this, node);
+
+        node->d_key = newKey;  // may throw
+
+        proctor.release();
+    }
 
-    // now we are committed: change the list!
-    moveImp(newFrontFlag, location, node);
+    insertImp(newFrontFlag, location, node);
 
     return 0;
 }
@@ -2223,16 +2474,22 @@ SkipList_Node<KEY, DATA> *SkipList<KEY, DATA>::findNode(const KEY& key) const
 {
     Node *locator[k_MAX_NUM_LEVELS];
 
-    LockGuard guard(&d_lock);
-    lookupImpLowerBound(locator, key);
+    EpochManagerGuard guard(d_epochs_p);
 
-    Node *q = locator[0];
-    if (q != d_tail_p && q->d_key == key) {
-        q->incrementRefCount();
-        return q;                                                     // RETURN
-    }
+    while (true) {
+        if (lookupImpLowerBound(locator, key)) {
+            continue;
+        }
 
-    return 0;
+        Node *q = locator[0];
+        if (q == d_tail_p || !(q->d_key == key)) {
+            return 0;                                                 // RETURN
+        }
+
+        if (q->tryIncrementRefCount()) {
+            return q;                                                 // RETURN
+        }
+    }
 }
 
 template<class KEY, class DATA>
@@ -2258,16 +2515,22 @@ SkipList_Node<KEY, DATA> *SkipList<KEY, DATA>::findNodeLowerBound(
 {
     Node *locator[k_MAX_NUM_LEVELS];
 
-    LockGuard guard(&d_lock);
-    lookupImpLowerBound(locator, key);
+    EpochManagerGuard guard(d_epochs_p);
 
-    Node *q = locator[0];
-    if (q != d_tail_p) {
-        q->incrementRefCount();
-        return q;                                                     // RETURN
-    }
+    while (true) {
+        if (lookupImpLowerBound(locator, key)) {
+            continue;
+        }
 
-    return 0;
+        Node *q = locator[0];
+        if (q == d_tail_p) {
+            return 0;                                                 // RETURN
+        }
+
+        if (q->tryIncrementRefCount()) {
+            return q;                                                 // RETURN
+        }
+    }
 }
 
 template<class KEY, class DATA>
@@ -2276,16 +2539,22 @@ SkipList_Node<KEY, DATA> *SkipList<KEY, DATA>::findNodeUpperBound(
 {
     Node *locator[k_MAX_NUM_LEVELS];
 
-    LockGuard guard(&d_lock);
-    lookupImpUpperBound(locator, key);
+    EpochManagerGuard guard(d_epochs_p);
 
-    Node *q = locator[0];
-    if (q != d_tail_p) {
-        q->incrementRefCount();
-        return q;                                                     // RETURN
-    }
+    while (true) {
+        if (lookupImpUpperBound(locator, key)) {
+            continue;
+        }
 
-    return 0;
+        Node *q = locator[0];
+        if (q == d_tail_p) {
+            return 0;                                                 // RETURN
+        }
+
+        if (q->tryIncrementRefCount()) {
+            return q;                                                 // RETURN
+        }
+    }
 }
 
 template<class KEY, class DATA>
@@ -2327,30 +2596,64 @@ SkipList_Node<KEY, DATA> *SkipList<KEY, DATA>::findNodeUpperBoundR(
 template<class KEY, class DATA>
 SkipList_Node<KEY, DATA> *SkipList<KEY, DATA>::frontNode() const
 {
-    LockGuard guard(&d_lock);
+    EpochManagerGuard guard(d_epochs_p);
 
-    Node *node = d_head_p->d_ptrs[0].d_next_p;
-    if (node == d_tail_p) {
-        return 0;                                                     // RETURN
+    while (true) {
+        Node *node = d_head_p->d_ptrs[0].d_next_p;
+        if (node == d_tail_p) {
+            return 0;                                                 // RETURN
+        }
+
+        // A node marked as removed may still be linked from the head while
+        // it is being unlinked.
+
+        if (0 != node->d_ptrs[0].d_next_p && node->tryIncrementRefCount()) {
+            return node;                                              // RETURN
+        }
     }
+}
 
-    node->incrementRefCount();
-    return node;
+template<class KEY, class DATA>
+void SkipList<KEY, DATA>::lockUnlessMoving(Node *node) const
+{
+    BSLS_ASSERT(node);
+
+    while (true) {
+        d_lock.lock();
+
+        if (!node->d_isMoving) {
+            return;                                                   // RETURN
+        }
+
+        d_lock.unlock();
+        bslmt::ThreadUtil::yield();
+    }
 }
 
 template<class KEY, class DATA>
-void SkipList<KEY, DATA>::lookupImpLowerBound(Node       *location[],
-                                              const KEY&  key) const
+int SkipList<KEY, DATA>::lookupImpLowerBound(Node       *location[],
+                                             const KEY&  key) const
 {
+    // Only the level-0 "next" pointer of a node marked as removed is 0.  The
+    // search is restarted if it reaches such a node, or if the node found is
+    // itself marked, so that the node found was the successor of its
+    // predecessor, and neither node was marked, at the time the level-0
+    // "next" pointer of the predecessor was loaded.
+
     Node *p = d_head_p;
     for (int k = d_listLevel; k >= 0; --k) {
         Node *q = p->d_ptrs[k].d_next_p;
-        while (q != d_tail_p && q->d_key < key) {
+        while (q && q != d_tail_p && q->d_key < key) {
             p = q;
             q = p->d_ptrs[k].d_next_p;
         }
+        if (0 == q) {
+            return 1;                                                 // RETURN
+        }
         location[k] = q;
     }
+
+    return location[0] != d_tail_p && 0 == location[0]->d_ptrs[0].d_next_p;
 }
 
 template<class KEY, class DATA>
@@ -2369,19 +2672,25 @@ void SkipList<KEY, DATA>::lookupImpLowerBoundR(Node       *location[],
 }
 
 template<class KEY, class DATA>
-void SkipList<KEY, DATA>::lookupImpUpperBound(Node       *location[],
-                                              const KEY&  key) const
+int SkipList<KEY, DATA>::lookupImpUpperBound(Node       *location[],
+                                             const KEY&  key) const
 {
+    // See 'lookupImpLowerBound'.
+
     Node *p = d_head_p;
     for (int k = d_listLevel; k >= 0; --k) {
         Node *q = p->d_ptrs[k].d_next_p;
-        while (q != d_tail_p && !(key < q->d_key)) {
+        while (q && q != d_tail_p && !(key < q->d_key)) {
             p = q;
             q = p->d_ptrs[k].d_next_p;
         }
-
+        if (0 == q) {
+            return 1;                                                 // RETURN
+        }
         location[k] = q;
     }
+
+    return location[0] != d_tail_p && 0 == location[0]->d_ptrs[0].d_next_p;
 }
 
 template<class KEY, class DATA>
@@ -2406,7 +2715,28 @@ SkipList<KEY, DATA>::nextNode(Node *node) const
     BSLS_ASSERT(node != d_head_p);
     BSLS_ASSERT(node != d_tail_p);
 
-    LockGuard guard(&d_lock);
+    {
+        EpochManagerGuard guard(d_epochs_p);
+
+        while (true) {
+            Node *next = node->d_ptrs[0].d_next_p;
+            if (0 == next) {
+                // 'node' is being removed or moved by 'update'.
+
+                break;
+            }
+            if (d_tail_p == next) {
+                return 0;                                             // RETURN
+            }
+            if (0 != next->d_ptrs[0].d_next_p
+             && next->tryIncrementRefCount()) {
+                return next;                                          // RETURN
+            }
+        }
+    }
+
+    lockUnlessMoving(node);
+    LockGuard guard(&d_lock, 1);
 
     Node *next = node->d_ptrs[0].d_next_p;
     if (0 == next || d_tail_p == next) {
@@ -2424,7 +2754,9 @@ SkipList<KEY, DATA>::prevNode(Node *node) const
     BSLS_ASSERT(node != d_head_p);
     BSLS_ASSERT(node != d_tail_p);
 
-    LockGuard guard(&d_lock);
+    lockUnlessMoving(node);
+    LockGuard guard(&d_lock, 1);
+
     if (0 == node->d_ptrs[0].d_next_p) {
         return 0;                                                     // RETURN
     }
@@ -2448,7 +2780,8 @@ int SkipList<KEY, DATA>::skipBackward(Node **node) const
     BSLS_ASSERT(current != d_head_p);
     BSLS_ASSERT(current != d_tail_p);
 
-    LockGuard guard(&d_lock);
+    lockUnlessMoving(current);
+    LockGuard guard(&d_lock, 1);
 
     if (0 == current->d_ptrs[0].d_next_p) {
         // The node is no longer on the list.
@@ -2480,7 +2813,37 @@ int SkipList<KEY, DATA>::skipForward(Node **node) const
     BSLS_ASSERT(current != d_head_p);
     BSLS_ASSERT(current != d_tail_p);
 
-    LockGuard guard(&d_lock);
+    Node *next = 0;
+    {
+        EpochManagerGuard guard(d_epochs_p);
+
+        while (true) {
+            Node *q = current->d_ptrs[0].d_next_p;
+            if (0 == q) {
+                // 'current' is being removed or moved by 'update'.
+
+                break;
+            }
+            if (d_tail_p == q
+             || (0 != q->d_ptrs[0].d_next_p && q->tryIncrementRefCount())) {
+                next = q;
+                break;
+            }
+        }
+    }
+
+    if (next) {
+        // 'current' may have been removed since 'next' was found, so that
+        // the reference to it may be the last one.
+
+        const_cast<SkipList *>(this)->releaseNode(current);
+
+        *node = d_tail_p == next ? 0 : next;
+        return 0;                                                     // RETURN
+    }
+
+    lockUnlessMoving(current);
+    LockGuard guard(&d_lock, 1);
 
     if (0 == current->d_ptrs[0].d_next_p) {
         // The node is no longer on the list.
@@ -2491,7 +2854,7 @@ int SkipList<KEY, DATA>::skipForward(Node **node) const
     BSLS_ASSERT(count);
     (void) count;    // suppress 'unused variable' warnings
 
-    Node *next = current->d_ptrs[0].d_next_p;
+    next = current->d_ptrs[0].d_next_p;
     if (d_tail_p == next) {
         *node = 0;
         return 0;                                                     // RETURN
@@ -2518,6 +2881,7 @@ template<class KEY, class DATA>
 SkipList<KEY, DATA>::SkipList(bslma::Allocator *basicAllocator)
 : d_listLevel(0)
 , d_length(0)
+, d_epochs_p(0)
 , d_poolManager_p(0)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
@@ -2529,6 +2893,7 @@ SkipList<KEY, DATA>::SkipList(const SkipList&   original,
                               bslma::Allocator *basicAllocator)
 : d_listLevel(0)
 , d_length(0)
+, d_epochs_p(0)
 , d_poolManager_p(0)
 , d_allocator_p(bslma::Default::allocator(basicAllocator))
 {
@@ -2550,6 +2915,11 @@ SkipList<KEY, DATA>::~SkipList()
         p = p->d_ptrs[0].d_next_p;
     }
 
+    // The nodes retired and not yet reclaimed are destroyed by the epoch
+    // manager, and must be before the pool is.
+
+    d_allocator_p->deleteObject(d_epochs_p);
+
     PoolUtil::deletePoolManager(d_allocator_p, d_poolManager_p);
 }
 
@@ -2562,9 +2932,25 @@ SkipList<KEY, DATA>::operator=(const SkipList& rhs)
         return *this;                                                 // RETURN
     }
 
-    // first empty this list
+    // The references to the removed nodes, and to the elements of 'rhs', are
+    // held by handles declared outside the scope of the lock, as releasing
+    // the last reference to a node may wait for lock-free lookups.
+
+    bsl::vector<Pair *>     removedRaw(d_allocator_p);
+    bsl::vector<PairHandle> removed(d_allocator_p);
+    bsl::vector<PairHandle> rhsElements;
+
     LockGuard guard(&d_lock);
-    removeAllImp(0, false);
+
+    // first empty this list
+
+    removedRaw.reserve(d_length);
+    removed.resize(d_length);
+    removeAllImp(&removedRaw, false);
+
+    for (bsl::size_t i = 0; i < removedRaw.size(); ++i) {
+        removed[i].reset(this, removedRaw[i]);
+    }
 
     // Now lock the other list and get handles to all its elements.  Once we
     // have locked it, we need to do all operations manually because the
@@ -2573,7 +2959,6 @@ SkipList<KEY, DATA>::operator=(const SkipList& rhs)
 
     LockGuard rhsGuard(&rhs.d_lock);
 
-    bsl::vector<PairHandle> rhsElements;
     for (Node *node = rhs.d_head_p->d_ptrs[0].d_next_p;
          node && node != rhs.d_tail_p;
          node = node->d_ptrs[0].d_next_p)
@@ -2597,6 +2982,8 @@ SkipList<KEY, DATA>::operator=(const SkipList& rhs)
         addNodeImpR(0, node, false);  // false -> do not lock (already locked)
     }
 
+    guard.release()->unlock();
+
     return *this;
 }
 
@@ -2989,8 +3376,10 @@ bool SkipList<KEY, DATA>::exists(const KEY& key) const
 {
     Node *locator[k_MAX_NUM_LEVELS];
 
-    LockGuard guard(&d_lock);
-    lookupImpLowerBound(locator, key);
+    EpochManagerGuard guard(d_epochs_p);
+
+    while (lookupImpLowerBound(locator, key)) {
+    }
 
     Node *q = locator[0];
     if (q != d_tail_p && q->d_key == key) {
@@ -3175,8 +3564,6 @@ template<class KEY, class DATA>
 inline
 bool SkipList<KEY, DATA>::isEmpty() const
 {
-    LockGuard guard(&d_lock);
-
     return d_tail_p == d_head_p->d_ptrs[0].d_next_p;
 }
 
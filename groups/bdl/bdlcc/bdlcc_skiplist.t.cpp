@@ -20,6 +20,7 @@
 #include <bslmt_threadutil.h>
 #include <bslmt_threadgroup.h>
 
+#include <bsls_atomic.h>
 #include <bsls_timeinterval.h>
 #include <bsls_types.h>
 
@@ -40,6 +41,7 @@
 #include <bsl_iostream.h>
 #include <bsl_sstream.h>
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 using namespace BloombergLP;
 using namespace bsl;  // automatically added by script
@@ -761,6 +763,367 @@ void run()
 
 }  // close namespace SKIPLIST_TEST_CASE_MINUS_100
 
+// ============================================================================
+//                         CASE 26 RELATED ENTITIES
+// ----------------------------------------------------------------------------
+
+namespace SKIPLIST_TEST_CASE_26 {
+
+class CheckedKey {
+    // This class is an integer key that detects its use after destruction.
+
+    enum { k_VALID = 0x600d600d, k_DESTROYED = 0xdeadbeef };
+
+    int          d_value;
+    unsigned int d_state;
+
+  public:
+    CheckedKey(int value = 0)                                       // IMPLICIT
+    : d_value(value)
+    , d_state(k_VALID)
+    {
+    }
+
+    CheckedKey(const CheckedKey& original)
+    : d_value(original.value())
+    , d_state(k_VALID)
+    {
+    }
+
+    ~CheckedKey()
+    {
+        ASSERTT(k_VALID == d_state);
+        d_state = k_DESTROYED;
+    }
+
+    CheckedKey& operator=(const CheckedKey& rhs)
+    {
+        ASSERTT(k_VALID == d_state);
+        d_value = rhs.value();
+        return *this;
+    }
+
+    int value() const
+    {
+        ASSERTT(k_VALID == d_state);
+        return d_value;
+    }
+};
+
+bool operator<(const CheckedKey& lhs, const CheckedKey& rhs)
+{
+    return lhs.value() < rhs.value();
+}
+
+bool operator==(const CheckedKey& lhs, const CheckedKey& rhs)
+{
+    return lhs.value() == rhs.value();
+}
+
+typedef bdlcc::SkipList<CheckedKey, int> List;
+
+enum {
+    k_NUM_STABLE  = 16,   // keys '-k_NUM_STABLE' to -1, never modified
+    k_NUM_WRITERS = 2,
+    k_NUM_KEYS    = 64,   // keys added by each writer in each iteration
+    k_MOVE        = k_NUM_WRITERS * k_NUM_KEYS * 2  // 'update' offset
+};
+
+void writerThread(List *list, int writerId, int numIterations)
+    // Repeatedly add to the specified 'list' 'k_NUM_KEYS' keys congruent to
+    // the specified 'writerId' modulo 'k_NUM_WRITERS' (with 'writerId' as
+    // data), move them by 'k_MOVE' using 'update' and 'updateR', and remove
+    // them, for the specified 'numIterations'.
+{
+    List::PairHandle handles[k_NUM_KEYS];
+
+    for (int j = 0; j < numIterations; ++j) {
+        for (int i = 0; i < k_NUM_KEYS; ++i) {
+            list->add(&handles[i], i * k_NUM_WRITERS + writerId, writerId);
+        }
+        for (int i = 0; i < k_NUM_KEYS; ++i) {
+            const int key = handles[i].key().value() + k_MOVE;
+            const int rc  = i % 2
+                          ? list->update(handles[i], key, 0, false)
+                          : list->updateR(handles[i], key, 0, false);
+            ASSERTT(0 == rc);
+        }
+        for (int i = 0; i < k_NUM_KEYS; ++i) {
+            ASSERTT(0 == list->remove(handles[i]));
+            handles[i].release();
+        }
+    }
+}
+
+void readerThread(List *list, bsls::AtomicInt *done, unsigned int seed)
+    // Repeatedly look up and traverse the specified 'list', checking the
+    // invariants maintained by 'writerThread', until the specified 'done'
+    // flag is set.  Use the specified 'seed' to select keys.
+{
+    const int k_MAX_KEY = k_NUM_WRITERS * k_NUM_KEYS + k_MOVE;
+
+    while (!*done) {
+        List::PairHandle h;
+
+        // Stable keys are always found.
+
+        for (int s = -k_NUM_STABLE; s < 0; ++s) {
+            ASSERTT(list->exists(s));
+            ASSERTT(0 == list->find(&h, s));
+            ASSERTT(h.key().value() == s && -1 == h.data());
+        }
+
+        // Other keys are found only in one of their two positions, and
+        // always with the data of their writer.  Note that the key of a pair
+        // may only increase by 'k_MOVE' while a reference to it is held.
+
+        const int k = rand_r(&seed) % k_MAX_KEY;
+
+        if (0 == list->find(&h, k)) {
+            const int key = h.key().value();
+            ASSERTT(key == k || key == k + k_MOVE);
+            ASSERTT(h.data() == key % k_NUM_WRITERS);
+        }
+        if (0 == list->findLowerBound(&h, k)) {
+            const int key = h.key().value();
+            ASSERTT(k <= key);
+            ASSERTT(h.data() == key % k_NUM_WRITERS);
+        }
+        if (0 == list->findUpperBound(&h, k)) {
+            const int key = h.key().value();
+            ASSERTT(k < key);
+            ASSERTT(h.data() == key % k_NUM_WRITERS);
+        }
+
+        // A forward traversal finds the stable keys in order, followed by
+        // pairs having consistent data.
+
+        ASSERTT(0 == list->front(&h));
+        for (int s = -k_NUM_STABLE; s < 0; ++s) {
+            ASSERTT(h.isValid() && h.key().value() == s);
+            ASSERTT(0 == list->skipForward(&h));
+        }
+        for (int i = 0; h.isValid() && i < 4 * k_MAX_KEY; ++i) {
+            const int key = h.key().value();
+            ASSERTT(0 <= key && h.data() == key % k_NUM_WRITERS);
+
+            List::PairHandle next;
+            if (0 == list->next(&next, h)) {
+                const int nextKey = next.key().value();
+                ASSERTT(0 <= nextKey
+                     && next.data() == nextKey % k_NUM_WRITERS);
+            }
+            if (0 != list->skipForward(&h)) {
+                break;
+            }
+        }
+    }
+}
+
+}  // close namespace SKIPLIST_TEST_CASE_26
+
+// ============================================================================
+//                         CASE 27 RELATED ENTITIES
+// ----------------------------------------------------------------------------
+
+namespace SKIPLIST_TEST_CASE_27 {
+
+bsls::AtomicInt    s_stall(0);            // set to stall 's_stallingThread'
+bsls::AtomicInt    s_stalled(0);          // set once it is stalled
+bsls::AtomicInt64  s_stallingThread(-1);  // id of the thread to stall
+
+class StallingKey {
+    // This class is an integer key whose comparisons block, while 's_stall'
+    // is set, in the thread identified by 's_stallingThread'.
+
+    int d_value;
+
+    void stallIfRequested() const
+    {
+        if (s_stall && s_stallingThread == static_cast<bsls::Types::Int64>(
+                                     bslmt::ThreadUtil::selfIdAsUint64())) {
+            s_stalled = 1;
+            while (s_stall) {
+                bslmt::ThreadUtil::yield();
+            }
+        }
+    }
+
+  public:
+    StallingKey(int value = 0)                                      // IMPLICIT
+    : d_value(value)
+    {
+    }
+
+    int value() const
+    {
+        stallIfRequested();
+        return d_value;
+    }
+};
+
+bool operator<(const StallingKey& lhs, const StallingKey& rhs)
+{
+    return lhs.value() < rhs.value();
+}
+
+bool operator==(const StallingKey& lhs, const StallingKey& rhs)
+{
+    return lhs.value() == rhs.value();
+}
+
+typedef bdlcc::SkipList<StallingKey, int> List;
+
+void stalledLookup(List *list)
+    // Look up a key in the specified 'list', stalling in the first key
+    // comparison until 's_stall' is reset.
+{
+    s_stallingThread = static_cast<bsls::Types::Int64>(
+                                         bslmt::ThreadUtil::selfIdAsUint64());
+    s_stall = 1;
+
+    ASSERTT(!list->exists(1000));
+}
+
+void updateThread(List             *list,
+                  List::PairHandle *handle,
+                  int               newKey,
+                  bsls::AtomicInt  *result)
+    // Update the key of the specified 'handle' in the specified 'list' to the
+    // specified 'newKey', and load the status into the specified 'result'.
+{
+    *result = list->update(*handle, newKey, 0, false);
+}
+
+void removeThread(List             *list,
+                  List::PairHandle *handle,
+                  bsls::AtomicInt  *result)
+    // Remove the pair of the specified 'handle' from the specified 'list',
+    // and load the status into the specified 'result'.
+{
+    *result = list->remove(*handle);
+}
+
+}  // close namespace SKIPLIST_TEST_CASE_27
+
+// ============================================================================
+//                         CASE 28 RELATED ENTITIES
+// ----------------------------------------------------------------------------
+
+namespace SKIPLIST_TEST_CASE_28 {
+
+typedef bdlcc::SkipList<int, int> List;
+
+void lookupAndExit(List *list, bslmt::Barrier *barrier)
+    // Look up a key in the specified 'list', so that this thread is
+    // registered with the list, then wait on the specified 'barrier' and
+    // exit.
+{
+    ASSERTT(list->exists(1));
+
+    barrier->wait();
+}
+
+}  // close namespace SKIPLIST_TEST_CASE_28
+
+// ============================================================================
+//                        CASE -102 RELATED ENTITIES
+// ----------------------------------------------------------------------------
+
+namespace SKIPLIST_TEST_CASE_MINUS_102 {
+
+typedef bdlcc::SkipList<int, int> List;
+
+void findThread(List           *list,
+                bslmt::Barrier *barrier,
+                int             numKeys,
+                int             numLookups,
+                bool            locked,
+                unsigned int    seed)
+    // Wait on the specified 'barrier', then look up the specified
+    // 'numLookups' keys, chosen using the specified 'seed' among the
+    // specified 'numKeys' keys in the specified 'list', using 'findR' if the
+    // specified 'locked' is 'true' and 'find' otherwise.
+{
+    barrier->wait();
+
+    for (int i = 0; i < numLookups; ++i) {
+        List::Pair *h;
+        const int   key = rand_r(&seed) % numKeys;
+        const int   rc  = locked ? list->findRRaw(&h, key)
+                                 : list->findRaw(&h, key);
+        ASSERTT(0 == rc);
+        list->releaseReferenceRaw(h);
+    }
+}
+
+double measure(List *list,
+               int   numThreads,
+               int   numKeys,
+               int   numLookups,
+               bool  locked)
+    // Return the number of lookups per microsecond achieved by the specified
+    // 'numThreads' threads each performing the specified 'numLookups' of
+    // the specified 'numKeys' keys in the specified 'list', using 'findR' if
+    // the specified 'locked' is 'true' and 'find' otherwise.
+{
+    bslmt::Barrier     barrier(numThreads + 1);
+    bslmt::ThreadGroup tg;
+
+    for (int i = 0; i < numThreads; ++i) {
+        tg.addThread(bdlf::BindUtil::bind(&findThread,
+                                          list,
+                                          &barrier,
+                                          numKeys,
+                                          numLookups,
+                                          locked,
+                                          1234567u * (i + 1)));
+    }
+
+    bsls::Stopwatch timer;
+    timer.start(true);
+    barrier.wait();
+    tg.joinAll();
+    timer.stop();
+
+    return numThreads * static_cast<double>(numLookups) /
+                                             (timer.elapsedTime() * 1.0e6);
+}
+
+void run(int numLookups)
+{
+    if (verbose) cout << endl
+                      << "Lock-free lookup scaling benchmark" << endl
+                      << "==================================" << endl;
+
+    enum { k_NUM_KEYS = 100 * 1000 };
+
+    List list;
+    for (int i = 0; i < k_NUM_KEYS; ++i) {
+        list.add(i, i);
+    }
+
+    cout << "threads  find (lookups/us)  findR (lookups/us)" << endl;
+
+    for (int numThreads = 1; numThreads <= 64; numThreads *= 2) {
+        const double lockFree = measure(&list,
+                                        numThreads,
+                                        k_NUM_KEYS,
+                                        numLookups,
+                                        false);
+        const double locked   = measure(&list,
+                                        numThreads,
+                                        k_NUM_KEYS,
+                                        numLookups,
+                                        true);
+
+        cout << numThreads << "\t " << lockFree << "\t\t     " << locked
+             << endl;
+    }
+}
+
+}  // close namespace SKIPLIST_TEST_CASE_MINUS_102
+
 namespace {
 
 void pushBackWrapper(bsl::vector<int> *vector, int item)
@@ -783,6 +1146,266 @@ int main(int argc, char *argv[])
     cout << "TEST " << __FILE__ << " CASE " << test << endl;;
 
     switch (test) { case 0:  // Zero is always the leading case.
+      case 28: {
+        // --------------------------------------------------------------------
+        // MANY LISTS AND DESTRUCTION DURING THREAD EXIT
+        //
+        // Concerns:
+        //: 1 More lists than there are thread-specific storage keys available
+        //:   to a process may exist at once, each looked up by a thread.
+        //:
+        //: 2 A list may be destroyed while a thread that has looked it up
+        //:   exits.
+        //:
+        //: 3 No memory is leaked.
+        //
+        // Plan:
+        //: 1 Create 3000 lists (more than 'PTHREAD_KEYS_MAX' on common
+        //:   platforms), look up a key in each, and destroy them.  (C-1)
+        //:
+        //: 2 Repeatedly, look up a key in a list from several threads, and
+        //:   destroy the list as soon as those threads start exiting.  (C-2)
+        //:
+        //: 3 Verify that all memory is returned to the test allocator.
+        //:   (C-3)
+        //
+        // Testing:
+        //   CONCERN: lists do not consume thread-specific storage keys
+        //   CONCERN: a list may be destroyed while its readers exit
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "Many Lists And Destruction During Thread Exit"
+                          << endl
+                          << "============================================="
+                          << endl;
+
+        using namespace SKIPLIST_TEST_CASE_28;
+
+        enum { k_NUM_LISTS = 3000, k_NUM_ITERATIONS = 200, k_NUM_THREADS = 4 };
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        {
+            bsl::vector<List *> lists(&ta);
+
+            for (int i = 0; i < k_NUM_LISTS; ++i) {
+                List *list = new (ta) List(&ta);
+                list->add(i, i);
+                lists.push_back(list);
+
+                ASSERTV(i, list->exists(i));
+            }
+            for (int i = 0; i < k_NUM_LISTS; ++i) {
+                ASSERTV(i, lists[i]->exists(i));
+
+                ta.deleteObject(lists[i]);
+            }
+        }
+        ASSERT(0 == ta.numBytesInUse());
+
+        for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+            List *list = new (ta) List(&ta);
+            list->add(1, 1);
+
+            bslmt::Barrier     barrier(k_NUM_THREADS + 1);
+            bslmt::ThreadGroup threads;
+
+            threads.addThreads(bdlf::BindUtil::bind(&lookupAndExit,
+                                                    list,
+                                                    &barrier),
+                               k_NUM_THREADS);
+
+            barrier.wait();
+            ta.deleteObject(list);
+
+            threads.joinAll();
+        }
+        ASSERT(0 == ta.numBytesInUse());
+      } break;
+      case 27: {
+        // --------------------------------------------------------------------
+        // UPDATE WAITS FOR LOOKUPS UNLOCKED
+        //
+        // Concerns:
+        //: 1 'update' waits for a lookup in progress before modifying the key
+        //:   of the pair, without holding the lock of the list, so that
+        //:   other modifications of the list proceed meanwhile.
+        //:
+        //: 2 The removal of a pair, and the release of its last reference,
+        //:   do not wait for the lookups in progress.
+        //:
+        //: 3 A removal of a pair being moved by 'update' waits for the move
+        //:   to complete, and then removes the moved pair.
+        //
+        // Plan:
+        //: 1 Using a key type whose comparisons block in a designated
+        //:   thread, stall a lookup, start an 'update' in another thread,
+        //:   and verify that the 'update' does not complete, while the main
+        //:   thread adds and removes other pairs.  (C-1..2)
+        //:
+        //: 2 Start removing the pair being moved in another thread, and
+        //:   verify that the removal completes only after the stalled lookup
+        //:   and the 'update' complete, and removes the moved pair.  (C-3)
+        //
+        // Testing:
+        //   CONCERN: 'update' does not wait for lookups under the lock
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "Update Waits For Lookups Unlocked" << endl
+                          << "=================================" << endl;
+
+        using namespace SKIPLIST_TEST_CASE_27;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        {
+            List mX(&ta);
+
+            for (int i = 0; i < 10; ++i) {
+                mX.add(i, i);
+            }
+
+            List::PairHandle moved;
+            ASSERT(0 == mX.find(&moved, 5));
+
+            bslmt::ThreadGroup lookups;
+            lookups.addThread(bdlf::BindUtil::bind(&stalledLookup, &mX));
+
+            while (!s_stalled) {
+                bslmt::ThreadUtil::yield();
+            }
+
+            bsls::AtomicInt    updateResult(-1);
+            bslmt::ThreadGroup updates;
+            updates.addThread(bdlf::BindUtil::bind(&updateThread,
+                                                   &mX,
+                                                   &moved,
+                                                   50,
+                                                   &updateResult));
+
+            bslmt::ThreadUtil::microSleep(100 * 1000);
+            ASSERT(-1 == updateResult);
+
+            // The list is modified while 'update' waits for the lookup.
+
+            mX.add(20, 20);
+
+            List::PairHandle h;
+            ASSERT(0 == mX.find(&h, 3));
+            ASSERT(0 == mX.remove(h));
+            h.release();
+
+            ASSERT(!mX.exists(5));
+            ASSERT(!mX.exists(50));
+            ASSERT(9 == mX.length());  // the moved pair is not in the list
+
+            bsls::AtomicInt    removeResult(-1);
+            bslmt::ThreadGroup removes;
+            removes.addThread(bdlf::BindUtil::bind(&removeThread,
+                                                   &mX,
+                                                   &moved,
+                                                   &removeResult));
+
+            bslmt::ThreadUtil::microSleep(100 * 1000);
+            ASSERT(-1 == updateResult);
+            ASSERT(-1 == removeResult);
+
+            s_stall = 0;
+
+            lookups.joinAll();
+            updates.joinAll();
+            removes.joinAll();
+
+            ASSERT(0 == updateResult);
+            ASSERT(0 == removeResult);
+            ASSERT(50 == moved.key().value());
+
+            ASSERT(!mX.exists(5));
+            ASSERT(!mX.exists(50));
+            ASSERT(mX.exists(20));
+            ASSERT(9 == mX.length());
+        }
+        ASSERT(0 == ta.numBytesInUse());
+      } break;
+      case 26: {
+        // --------------------------------------------------------------------
+        // LOCK-FREE LOOKUPS
+        //
+        // Concerns:
+        //: 1 Lookups and forward traversals that do not acquire the lock
+        //:   return pairs consistent with the state of the list while the
+        //:   list is concurrently modified by 'add', 'update', 'updateR',
+        //:   and 'remove'.
+        //:
+        //: 2 A removed pair is not destroyed while a lookup may examine it,
+        //:   and the key of a pair is not modified while a lookup may
+        //:   compare it.
+        //:
+        //: 3 Pairs that are never modified are always found.
+        //:
+        //: 4 No memory is leaked.
+        //
+        // Plan:
+        //: 1 Using a key type detecting its use after destruction, run
+        //:   writer threads adding, moving (by 'update' and 'updateR'), and
+        //:   removing keys of disjoint residue classes, concurrently with
+        //:   reader threads calling 'exists', 'find', 'findLowerBound',
+        //:   'findUpperBound', 'front', 'next', and 'skipForward', and
+        //:   checking the invariants maintained by the writers.  (C-1..3)
+        //:
+        //: 2 Verify that the list finally contains only the stable keys, and
+        //:   that all memory is returned to the test allocator.  (C-4)
+        //
+        // Testing:
+        //   CONCERN: lookups do not block and are safe during modifications
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "Lock-Free Lookups" << endl
+                          << "=================" << endl;
+
+        using namespace SKIPLIST_TEST_CASE_26;
+
+        enum { k_NUM_READERS = 4, k_NUM_ITERATIONS = 300 };
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+        {
+            List mX(&ta);
+
+            for (int s = -k_NUM_STABLE; s < 0; ++s) {
+                mX.add(s, -1);
+            }
+
+            bsls::AtomicInt    done(0);
+            bslmt::ThreadGroup readers;
+            bslmt::ThreadGroup writers;
+
+            for (int i = 0; i < k_NUM_READERS; ++i) {
+                readers.addThread(bdlf::BindUtil::bind(&readerThread,
+                                                       &mX,
+                                                       &done,
+                                                       7u * (i + 1)));
+            }
+            for (int i = 0; i < k_NUM_WRITERS; ++i) {
+                writers.addThread(bdlf::BindUtil::bind(&writerThread,
+                                                       &mX,
+                                                       i,
+                                                       (int)k_NUM_ITERATIONS));
+            }
+
+            writers.joinAll();
+            done = 1;
+            readers.joinAll();
+
+            ASSERT(k_NUM_STABLE == mX.length());
+
+            List::PairHandle h;
+            ASSERT(0 == mX.back(&h));
+            ASSERT(-1 == h.key().value());
+        }
+        ASSERT(0 < ta.numAllocations());
+        ASSERT(0 == ta.numBytesInUse());
+      } break;
 
       case 25: {
         DATA VALUES1[] = {
@@ -2445,6 +3068,22 @@ int main(int argc, char *argv[])
         // --------------------------------------------------------------------
         SKIPLIST_TEST_CASE_MINUS_100::run();
       } break;
+      case -102: {
+        // --------------------------------------------------------------------
+        // LOOKUP SCALING BENCHMARK
+        //   Compare the throughput of the lock-free 'find' with that of the
+        //   locked 'findR' for 1 to 64 threads looking up keys in a list of
+        //   100000 pairs.  The optional second argument specifies the number
+        //   of lookups per thread.
+        // --------------------------------------------------------------------
+
+        int numLookups = argc > 2 ? atoi(argv[2]) : 0;
+        if (0 >= numLookups) {
+            numLookups = 100 * 1000;
+        }
+
+        SKIPLIST_TEST_CASE_MINUS_102::run(numLookups);
+      } break;
       default: {
         cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
         testStatus = -1;
@@ -136,7 +136,9 @@ BSLS_IDENT_RCSID(bdld_datum_cpp,"$Id$ $CSID$")
 #include <bdlt_currenttime.h>
 #include <bdldfp_decimal.h>
 #include <bdldfp_decimalconvertutil.h>
+#include <bdldfp_decimalutil.h>
 
+#include <bslh_defaulthashalgorithm.h>
 #include <bslim_printer.h>
 #include <bslma_allocator.h>
 #include <bslma_usesbslmaallocator.h>
@@ -146,6 +148,8 @@ BSLS_IDENT_RCSID(bdld_datum_cpp,"$Id$ $CSID$")
 #include <bsls_types.h>
 
 #include <bsl_algorithm.h>
+#include <bsl_climits.h>
+#include <bsl_cmath.h>
 #include <bsl_cstddef.h>
 #include <bsl_memory.h>
 #include <bsl_ostream.h>
@@ -185,6 +189,10 @@ static const Datum *findElementLinear(const bslstl::StringRef& key,
     // Return a pointer to a 'Datum' object if the specified 'key' exists in
     // the specified 'map' or 0 otherwise.  Find the key using linear search.
 
+static unsigned int hashKey(const bslstl::StringRef& key);
+    // Return the hash of the specified 'key' used by the index of indexed
+    // maps.
+
                          // ========================
                          // class Datum_ArrayProctor
                          // ========================
@@ -667,10 +675,20 @@ Datum copyMapOwningKeys(const DatumMapRef&  map,
             totalSizeOfKeys += map[i].key().length();
         }
 
-        Datum::createUninitializedMap(&ref,
-                                      map.size(),
-                                      totalSizeOfKeys,
-                                      basicAllocator);
+        // Preserve the index of an indexed map.
+
+        if (map.isIndexed()) {
+            Datum::createUninitializedIndexedMap(&ref,
+                                                 map.size(),
+                                                 totalSizeOfKeys,
+                                                 basicAllocator);
+        }
+        else {
+            Datum::createUninitializedMap(&ref,
+                                          map.size(),
+                                          totalSizeOfKeys,
+                                          basicAllocator);
+        }
 
         // Track the allocated memory and destroy it if any of the allocations
         // inside the for loop throws.
@@ -728,6 +746,17 @@ const Datum *findElementLinear(const bslstl::StringRef& key,
     return 0;
 }
 
+unsigned int hashKey(const bslstl::StringRef& key)
+{
+    // FNV-1a, which is fast for the short keys typical of maps.
+
+    unsigned int hash = 2166136261u;
+    for (const char *p = key.data(), *end = p + key.length(); p != end; ++p) {
+        hash = (hash ^ static_cast<unsigned char>(*p)) * 16777619u;
+    }
+    return hash ^ (hash >> 16);
+}
+
 }  // close unnamed namespace
 
 BSLMF_ASSERT(bsl::is_trivially_copyable<Datum>::value);
@@ -752,6 +781,58 @@ BSLMF_ASSERT(sizeof(bdlt::Datetime) <= sizeof(void*));
 BSLMF_ASSERT(sizeof(bdlt::Date) <= sizeof(int));
 BSLMF_ASSERT(sizeof(bdlt::Time) <= sizeof(long long));
 BSLMF_ASSERT(sizeof(Datum_MapHeader) <= sizeof(DatumMapEntry));
+BSLMF_ASSERT(sizeof(Datum::SizeType) + sizeof(unsigned int) <= sizeof(Datum));
+    // The cached hash digest of an array is stored after the length, in the
+    // 'Datum'-sized slot preceding the array elements.
+
+// PRIVATE ACCESSORS
+unsigned int *Datum::hashCache() const
+{
+    void *array = 0;
+    void *map   = 0;
+
+#ifdef BSLS_PLATFORM_CPU_32_BIT
+    switch (internalType()) {
+      case e_INTERNAL_ARRAY: {
+        array = const_cast<void *>(d_as.d_cvp);
+      } break;
+      case e_INTERNAL_EXTENDED: {
+        switch (extendedInternalType()) {
+          case e_EXTENDED_INTERNAL_MAP      :  // fall through
+          case e_EXTENDED_INTERNAL_OWNED_MAP: {
+            map = const_cast<void *>(d_as.d_cvp);
+          } break;
+          default: {
+          } break;
+        }
+      } break;
+      default: {
+      } break;
+    }
+#else   // BSLS_PLATFORM_CPU_32_BIT
+    switch (internalType()) {
+      case e_INTERNAL_ARRAY: {
+        array = d_as.d_ptr;
+      } break;
+      case e_INTERNAL_MAP      :  // fall through
+      case e_INTERNAL_OWNED_MAP: {
+        map = d_as.d_ptr;
+      } break;
+      default: {
+      } break;
+    }
+#endif  // BSLS_PLATFORM_CPU_32_BIT
+
+    if (array) {
+        return reinterpret_cast<unsigned int *>(
+                                          static_cast<SizeType *>(array) + 1);
+                                                                      // RETURN
+    }
+    if (map) {
+        return &static_cast<Datum_MapHeader *>(map)->d_hash;          // RETURN
+    }
+    return 0;
+}
 
 // CLASS METHODS
 Datum Datum::createDecimal64(bdldfp::Decimal64  value,
@@ -953,9 +1034,11 @@ void Datum::createUninitializedArray(DatumMutableArrayRef *result,
     void     *mem = basicAllocator->allocate(sizeof(Datum) * (capacity + 1));
     SizeType *length = static_cast<SizeType *>(mem);
 
-    // Store length of the array in the front.
+    // Store length of the array in the front, followed by the (absent)
+    // cached hash digest.
 
     *length = 0;
+    *reinterpret_cast<unsigned int *>(length + 1) = 0;
     *result = DatumMutableArrayRef(static_cast<Datum *>(mem) + 1, length);
 }
 
@@ -977,9 +1060,11 @@ void Datum::createUninitializedMap(DatumMutableMapRef *result,
     // Store map header in the front (1 DatumMapEntry).
     Datum_MapHeader *header = static_cast<Datum_MapHeader *>(mem);
 
-    header->d_size     = 0;
-    header->d_sorted   = false;
-    header->d_ownsKeys = false;
+    header->d_size      = 0;
+    header->d_sorted    = false;
+    header->d_ownsKeys  = false;
+    header->d_hash      = 0;
+    header->d_indexSize = 0;
 
     *result = DatumMutableMapRef(static_cast<DatumMapEntry *>(mem) + 1,
                                  &header->d_size,
@@ -1007,9 +1092,11 @@ void Datum::createUninitializedMap(
     // Store map header in the front ( 1 DatumMapEntry ).
     Datum_MapHeader *header = static_cast<Datum_MapHeader *>(mem);
 
-    header->d_size     = 0;
-    header->d_sorted   = false;
-    header->d_ownsKeys = true;
+    header->d_size      = 0;
+    header->d_sorted    = false;
+    header->d_ownsKeys  = true;
+    header->d_hash      = 0;
+    header->d_indexSize = 0;
 
     char *keysMem = static_cast<char *>(mem)
                                     + (sizeof(DatumMapEntry) * (capacity + 1));
@@ -1021,6 +1108,77 @@ void Datum::createUninitializedMap(
                                          &header->d_sorted);
 }
 
+void Datum::createUninitializedIndexedMap(DatumMutableMapRef *result,
+                                          SizeType            capacity,
+                                          bslma::Allocator   *basicAllocator)
+{
+    BSLS_ASSERT(result);
+    BSLS_ASSERT(basicAllocator);
+    BSLS_ASSERT(capacity < UINT_MAX / 4);
+
+    // Allocate the header (1 'DatumMapEntry'), followed by the index, followed
+    // by the elements.
+
+    const unsigned int indexSize   = Datum_MapIndex::sizeForCapacity(capacity);
+    const SizeType     indexBlocks = Datum_MapIndex::numBlocks(indexSize);
+
+    void *mem = basicAllocator->allocate(
+                         sizeof(DatumMapEntry) * (1 + indexBlocks + capacity));
+
+    Datum_MapHeader *header = static_cast<Datum_MapHeader *>(mem);
+
+    header->d_size      = 0;
+    header->d_sorted    = false;
+    header->d_ownsKeys  = false;
+    header->d_hash      = 0;
+    header->d_indexSize = indexSize;
+
+    *result = DatumMutableMapRef(
+                       static_cast<DatumMapEntry *>(mem) + 1 + indexBlocks,
+                       &header->d_size,
+                       &header->d_sorted);
+}
+
+void Datum::createUninitializedIndexedMap(
+                                  DatumMutableMapOwningKeysRef *result,
+                                  SizeType                      capacity,
+                                  SizeType                      keysCapacity,
+                                  bslma::Allocator             *basicAllocator)
+{
+    BSLS_ASSERT(result);
+    BSLS_ASSERT(basicAllocator);
+    BSLS_ASSERT(capacity < UINT_MAX / 4);
+
+    // Allocate the header (1 'DatumMapEntry'), followed by the index, followed
+    // by the elements, followed by the keys.
+
+    const unsigned int indexSize   = Datum_MapIndex::sizeForCapacity(capacity);
+    const SizeType     indexBlocks = Datum_MapIndex::numBlocks(indexSize);
+    const SizeType     entriesSize =
+                        sizeof(DatumMapEntry) * (1 + indexBlocks + capacity);
+
+    BSLS_ASSERT(keysCapacity <= bsl::numeric_limits<SizeType>::max()
+                                                               - entriesSize);
+
+    void * const mem = basicAllocator->allocate(
+                                bsls::AlignmentUtil::roundUpToMaximalAlignment(
+                                                 entriesSize + keysCapacity));
+
+    Datum_MapHeader *header = static_cast<Datum_MapHeader *>(mem);
+
+    header->d_size      = 0;
+    header->d_sorted    = false;
+    header->d_ownsKeys  = true;
+    header->d_hash      = 0;
+    header->d_indexSize = indexSize;
+
+    *result = DatumMutableMapOwningKeysRef(
+                       static_cast<DatumMapEntry *>(mem) + 1 + indexBlocks,
+                       &header->d_size,
+                       static_cast<char *>(mem) + entriesSize,
+                       &header->d_sorted);
+}
+
 char *Datum::createUninitializedString(Datum            *result,
                                        SizeType          length,
                                        bslma::Allocator *basicAllocator)
@@ -1071,6 +1229,38 @@ char *Datum::createUninitializedString(Datum            *result,
 #endif  // BSLS_PLATFORM_CPU_32_BIT
 }
 
+void Datum::cacheHash(const Datum& value)
+{
+    unsigned int *cache = value.hashCache();
+
+    if (cache && *cache) {
+        return;                                                       // RETURN
+    }
+
+    // Cache the digests of the nested aggregates first, so that the digest of
+    // 'value' is computed from them.
+
+    if (value.isArray()) {
+        const DatumArrayRef array = value.theArray();
+        for (SizeType i = 0; i < array.length(); ++i) {
+            cacheHash(array[i]);
+        }
+    }
+    else if (value.isMap()) {
+        const DatumMapRef map = value.theMap();
+        for (SizeType i = 0; i < map.size(); ++i) {
+            cacheHash(map[i].value());
+        }
+    }
+    else {
+        return;                                                       // RETURN
+    }
+
+    if (cache) {
+        *cache = Datum_HashUtil::digest(value);
+    }
+}
+
 const char *Datum::dataTypeToAscii(DataType type)
 {
 #define CASE(X) case(e_##X): return #X;
@@ -1183,6 +1373,12 @@ Datum Datum::clone(bslma::Allocator *basicAllocator) const
     return result;
 }
 
+bool Datum::hasCachedHash() const
+{
+    const unsigned int *cache = hashCache();
+    return cache && *cache;
+}
+
 #ifdef BSLS_PLATFORM_CPU_32_BIT
 bdldfp::Decimal64 Datum::theDecimal64() const
 {
@@ -1287,6 +1483,10 @@ bsl::ostream& DatumMapEntry::print(bsl::ostream& stream,
 // ACCESSORS
 const Datum *DatumMapRef::find(const bslstl::StringRef& key) const
 {
+    if (d_index_p) {
+        return Datum_MapIndex::find(key, d_index_p, d_indexSize, d_data_p);
+                                                                      // RETURN
+    }
     return d_sorted ? findElementBinary(key, *this):
                       findElementLinear(key, *this);
 }
@@ -1311,6 +1511,162 @@ bsl::ostream& DatumMapRef::print(bsl::ostream& stream,
     return stream << bsl::flush;
 }
 
+                           // ---------------------
+                           // struct Datum_HashUtil
+                           // ---------------------
+
+// CLASS METHODS
+unsigned int Datum_HashUtil::digest(const Datum& value)
+{
+    BSLS_ASSERT_SAFE(value.isArray() || value.isMap());
+
+    const unsigned int *cache = value.hashCache();
+    if (cache && *cache) {
+        return *cache;                                                // RETURN
+    }
+
+    using bslh::hashAppend;
+
+    bslh::DefaultHashAlgorithm hashAlg;
+
+    if (value.isArray()) {
+        const DatumArrayRef array = value.theArray();
+
+        hashAppend(hashAlg, static_cast<bsls::Types::Uint64>(array.length()));
+        for (Datum::SizeType i = 0; i < array.length(); ++i) {
+            hashAppend(hashAlg, array[i]);
+        }
+    }
+    else {
+        const DatumMapRef map = value.theMap();
+
+        hashAppend(hashAlg, static_cast<bsls::Types::Uint64>(map.size()));
+        for (Datum::SizeType i = 0; i < map.size(); ++i) {
+            hashAppend(hashAlg, map[i].key());
+            hashAppend(hashAlg, map[i].value());
+        }
+    }
+
+    const bsls::Types::Uint64 hash   = hashAlg.computeHash();
+    const unsigned int        result = static_cast<unsigned int>(hash)
+                                     ^ static_cast<unsigned int>(hash >> 32);
+
+    // 0 is reserved to indicate the absence of a cached digest.
+
+    return result ? result : 1;
+}
+
+                           // ---------------------
+                           // struct Datum_MapIndex
+                           // ---------------------
+
+// CLASS METHODS
+void Datum_MapIndex::build(Datum_MapHeader *header)
+{
+    BSLS_ASSERT(header);
+    BSLS_ASSERT(header->d_indexSize);
+
+    DatumMapEntry      *base      = reinterpret_cast<DatumMapEntry *>(header);
+    unsigned int       *index     = reinterpret_cast<unsigned int *>(base + 1);
+    const unsigned int  indexSize = header->d_indexSize;
+    const unsigned int  mask      = indexSize - 1;
+    const unsigned int  size      = static_cast<unsigned int>(header->d_size);
+
+    const DatumMapEntry *entries = base + 1 + numBlocks(indexSize);
+
+    BSLS_ASSERT(size < indexSize);
+
+    bsl::fill(index, index + indexSize, 0u);
+
+    for (unsigned int i = 0; i < size; ++i) {
+        const bslstl::StringRef& key = entries[i].key();
+
+        unsigned int slot = hashKey(key) & mask;
+        while (index[slot] && key != entries[index[slot] - 1].key()) {
+            slot = (slot + 1) & mask;
+        }
+
+        // The first of several elements having the same key is the one that
+        // is indexed.
+
+        if (!index[slot]) {
+            index[slot] = i + 1;
+        }
+    }
+}
+
+const Datum *Datum_MapIndex::find(const bslstl::StringRef&  key,
+                                  const unsigned int       *index,
+                                  unsigned int              indexSize,
+                                  const DatumMapEntry      *entries)
+{
+    BSLS_ASSERT_SAFE(index);
+    BSLS_ASSERT_SAFE(indexSize);
+
+    const unsigned int mask = indexSize - 1;
+
+    for (unsigned int slot = hashKey(key) & mask; index[slot];
+                                                   slot = (slot + 1) & mask) {
+        const DatumMapEntry& entry = entries[index[slot] - 1];
+
+        if (key == entry.key()) {
+            return &entry.value();                                    // RETURN
+        }
+    }
+    return 0;
+}
+
+bool Datum_HashUtil::haveDifferentCachedDigests(const Datum& lhs,
+                                                const Datum& rhs)
+{
+    const unsigned int *lhsCache = lhs.hashCache();
+    const unsigned int *rhsCache = rhs.hashCache();
+
+    return lhsCache && rhsCache && *lhsCache && *rhsCache
+        && *lhsCache != *rhsCache;
+}
+
+void Datum_HashUtil::normalizeDecimal64(int                 *sign,
+                                        bsls::Types::Uint64 *significand,
+                                        int                 *exponent,
+                                        bdldfp::Decimal64    value)
+{
+    BSLS_ASSERT_SAFE(sign);
+    BSLS_ASSERT_SAFE(significand);
+    BSLS_ASSERT_SAFE(exponent);
+
+    switch (bdldfp::DecimalUtil::decompose(sign,
+                                           significand,
+                                           exponent,
+                                           value)) {
+      case FP_ZERO: {
+        *sign        = 0;
+        *significand = 0;
+        *exponent    = 0;
+      } break;
+      case FP_INFINITE: {
+        *significand = 0;
+        *exponent    = INT_MAX;
+      } break;
+      case FP_NAN: {
+        // NaNs compare equal to nothing, so any representation will do.
+
+        *sign        = 0;
+        *significand = 0;
+        *exponent    = INT_MIN;
+      } break;
+      default: {
+        // Remove the trailing zeros, which distinguish the members of a
+        // cohort (e.g., '1.0' and '1.00') but not their value.
+
+        while (0 == *significand % 10) {
+            *significand /= 10;
+            ++*exponent;
+        }
+      } break;
+    }
+}
+
 }  // close package namespace
 
 // FREE OPERATORS
@@ -1356,6 +1712,9 @@ bool bdld::operator==(const Datum& lhs, const Datum& rhs)
       case Datum::e_DECIMAL64:
         return (lhs.theDecimal64() == rhs.theDecimal64());            // RETURN
       case Datum::e_ARRAY: {
+        if (Datum_HashUtil::haveDifferentCachedDigests(lhs, rhs)) {
+            return false;                                             // RETURN
+        }
         DatumArrayRef lval = lhs.theArray();
         DatumArrayRef rval = rhs.theArray();
         return (lval.length() == rval.length())
@@ -1367,7 +1726,8 @@ bool bdld::operator==(const Datum& lhs, const Datum& rhs)
                     : false;                                          // RETURN
         }
       case Datum::e_MAP:
-        return (lhs.theMap() == rhs.theMap());                        // RETURN
+        return !Datum_HashUtil::haveDifferentCachedDigests(lhs, rhs)
+            && lhs.theMap() == rhs.theMap();                          // RETURN
       case Datum::e_USERDEFINED:
         return (lhs.theUdt() == rhs.theUdt());                        // RETURN
       default:
@@ -224,6 +224,45 @@ BSLS_IDENT("$Id$ $CSID$")
 // determined by the application, which is responsible for ensuring the set of
 // "user-defined" type identifiers remains unique.
 //
+///Indexed Maps
+///- - - - - - -
+// 'DatumMapRef::find' performs a binary search if the map is sorted, and a
+// linear search otherwise.  For large maps whose keys are looked up
+// repeatedly, 'createUninitializedIndexedMap' creates a map whose storage
+// additionally reserves an open-addressed hash table of the keys.  The table
+// is placed between the meta-information and the elements of the map, in the
+// same allocation, and is built by 'adoptMap'; 'find' on the resulting map
+// hashes the key and examines (on average) one or two elements.  An indexed
+// map is otherwise indistinguishable from any other map: it has the same
+// type, compares equal to a non-indexed map having the same elements, and is
+// released by 'destroy'.  When a map has several elements having the same key,
+// 'find' on an indexed map returns the value of the first of them.
+//
+///Hashing
+///-------
+// This component provides a free function, 'hashAppend', that allows 'Datum'
+// objects to be hashed using the 'bslh' modular hashing system (e.g., to be
+// used as keys of a 'bsl::unordered_map').  Values that compare equal hash
+// identically.  In addition, 'Datum' objects holding 'int', 'Int64', and
+// 'double' values that are numerically equal (e.g., 'createInteger(1)' and
+// 'createDouble(1.0)') hash identically, even though they do not compare
+// equal, so that numeric keys may be looked up irrespective of the numeric
+// type with which they were stored.
+//
+// The value of an array or a map contributes to the hash through a 32-bit
+// digest of its elements.  Computing this digest requires visiting every
+// (transitively) contained element, which is expensive for large aggregates
+// that are hashed or compared repeatedly.  The class method
+// 'Datum::cacheHash' computes the digest of an array or map (and of every
+// array or map contained within it) once, and stores it within the memory
+// already allocated for the aggregate.  Subsequently, 'hashAppend' uses the
+// stored digest, and 'operator==' immediately reports two arrays or maps
+// having different stored digests as unequal.  A cached digest is not
+// updated if the aggregate is modified: 'cacheHash' should be called only on
+// aggregates that will not be modified for as long as they are used, and,
+// because it writes to the aggregate, must not be called while the aggregate
+// is accessed from another thread.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -535,6 +574,10 @@ BSLS_IDENT("$Id$ $CSID$")
 #include <bsl_algorithm.h>
 #endif
 
+#ifndef INCLUDED_BSLH_HASH
+#include <bslh_hash.h>
+#endif
+
 #ifndef INCLUDED_BSLMF_ISBITWISEMOVEABLE
 #include <bslmf_isbitwisemoveable.h>
 #endif
@@ -1206,6 +1249,7 @@ class Datum {
     friend bool operator==(const Datum& lhs, const Datum& rhs);
     friend bool operator!=(const Datum& lhs, const Datum& rhs);
     friend bsl::ostream& operator<<(bsl::ostream& stream, const Datum& rhs);
+    friend struct Datum_HashUtil;
 
     // PRIVATE CLASS METHODS
     static void destroyMemory(const Datum&      value,
@@ -1214,6 +1258,14 @@ class Datum {
         // specified 'value' using the specified 'basicAllocator'.
 
     // PRIVATE ACCESSORS
+    unsigned int *hashCache() const;
+        // Return the address of the storage reserved for the cached hash
+        // digest of the array or map held by this object, or 0 if this object
+        // does not hold an array or map having such storage (i.e., it holds an
+        // array reference, an array or map having no allocated storage, or a
+        // value of some other type).  Note that a stored value of 0 indicates
+        // that no digest has been cached.
+
     InternalDataType internalType() const;
         // Return the internal type of value stored in this object as one of
         // the enumeration values defined in 'InternalDataType'.
@@ -1404,18 +1456,22 @@ class Datum {
         // called on the returned object.
 
     static Datum adoptMap(const DatumMutableMapRef& map);
-        // Return, by value, a datum that refers to the specified 'map'.  The
-        // behavior is undefined unless 'map' was created using
-        // 'createUninitializedMap' method.  The behavior is also undefined
-        // unless each element in the held map has been assigned a value and
-        // the size of the map has been set accordingly.  Note that the adopted
-        // map is owned and will be freed if 'Datum::destroy' is called on the
-        // returned object.
+        // Return, by value, a datum that refers to the specified 'map'.  If
+        // 'map' was created using 'createUninitializedIndexedMap', build the
+        // index of its keys.  The behavior is undefined unless 'map' was
+        // created using the 'createUninitializedMap' or
+        // 'createUninitializedIndexedMap' method.  The behavior is also
+        // undefined unless each element in the held map has been assigned a
+        // value and the size of the map has been set accordingly.  Note that
+        // the adopted map is owned and will be freed if 'Datum::destroy' is
+        // called on the returned object.
 
     static Datum adoptMap(const DatumMutableMapOwningKeysRef& map);
-        // Return, by value, a datum that refers to the specified 'map'.  The
-        // behavior is undefined unless 'map' was created using
-        // 'createUninitializedMapOwningKeys' method.  The behavior is also
+        // Return, by value, a datum that refers to the specified 'map'.  If
+        // 'map' was created using 'createUninitializedIndexedMap', build the
+        // index of its keys.  The behavior is undefined unless 'map' was
+        // created using the 'createUninitializedMap' or
+        // 'createUninitializedIndexedMap' method.  The behavior is also
         // undefined unless each element in the held map has been assigned a
         // value and the size of the map has been set accordingly.  The
         // behavior is also undefined unless keys have been copied into the
@@ -1466,6 +1522,27 @@ class Datum {
         // in the datum-key-owning map that need dynamic memory, should also be
         // allocated with 'basicAllocator'.
 
+    static void createUninitializedIndexedMap(
+                                   DatumMutableMapRef *result,
+                                   SizeType            capacity,
+                                   bslma::Allocator   *basicAllocator);
+    static void createUninitializedIndexedMap(
+                                 DatumMutableMapOwningKeysRef *result,
+                                 SizeType                      capacity,
+                                 SizeType                      keysCapacity,
+                                 bslma::Allocator             *basicAllocator);
+        // Load the specified 'result' with a reference to a newly created
+        // datum map (respectively datum-key-owning map having the specified
+        // 'keysCapacity') having the specified 'capacity', whose storage also
+        // holds a hash index of the keys of the map, using the specified
+        // 'basicAllocator' to supply memory.  The index is built by
+        // 'adoptMap', after which 'DatumMapRef::find' on the map has constant
+        // average complexity.  The behavior is undefined unless
+        // 'capacity < UINT_MAX / 4', and the elements of the map are not
+        // modified after the map is adopted.  Note that, apart from the index
+        // (and the additional memory it occupies), the map behaves as if it
+        // were created using 'createUninitializedMap'.  See {Indexed Maps}.
+
     static char *createUninitializedString(Datum            *result,
                                            SizeType          length,
                                            bslma::Allocator *basicAllocator);
@@ -1476,6 +1553,19 @@ class Datum {
         // that the caller is responsible for initializing the returned buffer
         // with a UTF-8 encoded string.
 
+    static void cacheHash(const Datum& value);
+        // Compute the hash digest of the array or map held by the specified
+        // 'value', and of every array or map (transitively) contained within
+        // it, and store each digest within the memory allocated for the
+        // corresponding aggregate, so that 'hashAppend' and 'operator==' need
+        // not visit the elements of these aggregates again.  This method has
+        // no effect on aggregates whose digest is already cached, and on
+        // aggregates (e.g., array references) having no storage for a digest;
+        // it has no effect at all unless 'value' holds an array or map.  The
+        // behavior is undefined if any aggregate whose digest is cached is
+        // subsequently modified, or if this method is called while 'value' is
+        // accessed from another thread.  See {Hashing}.
+
     static const char *dataTypeToAscii(DataType type);
         // Return the non-modifiable string representation corresponding to the
         // specified 'type', if it exists, and a unique (error) string
@@ -1571,7 +1661,12 @@ class Datum {
 
     Datum clone(bslma::Allocator *basicAllocator) const;
         // Return a datum holding a "deep-copy" of this object, using the
-        // specified 'basicAllocator' to supply memory.
+        // specified 'basicAllocator' to supply memory.  Note that cached hash
+        // digests (see 'cacheHash') are not copied.
+
+    bool hasCachedHash() const;
+        // Return 'true' if this object holds an array or map whose hash digest
+        // has been cached by 'cacheHash', and 'false' otherwise.
 
                                // Type-Identifiers
 
@@ -1834,6 +1929,16 @@ bsl::ostream& operator<<(bsl::ostream& stream, Datum::DataType rhs);
     // to the modifyable 'stream'.  See 'dataTypeToAscii' for what constitutes
     // the string representation of a 'Datum::DataType' value.
 
+// FREE FUNCTIONS
+template <class HASHALG>
+void hashAppend(HASHALG& hashAlg, const Datum& input);
+    // Pass the specified 'input' to the specified 'hashAlg'.  This function
+    // integrates with the 'bslh' modular hashing system and effectively
+    // provides a 'bsl::hash' specialization for 'Datum'.  Datums that compare
+    // equal, as well as datums holding numerically equal 'int', 'Int64', and
+    // 'double' values, hash identically.  Arrays and maps are hashed through
+    // the digest computed (or cached) by 'Datum::cacheHash'.  See {Hashing}.
+
                          // ==========================
                          // class DatumMutableArrayRef
                          // ==========================
@@ -1898,6 +2003,85 @@ struct Datum_MapHeader{
     Datum::SizeType d_size;      // size of the map
     bool            d_sorted;    // sorted flag
     bool            d_ownsKeys;  // owns keys flag
+    unsigned int    d_hash;      // cached hash digest, or 0 if none
+    unsigned int    d_indexSize; // number of slots in the key index, or 0
+                                 // if the map is not indexed
+};
+
+                           // =====================
+                           // struct Datum_HashUtil
+                           // =====================
+
+struct Datum_HashUtil {
+    // This component-private 'struct' provides a namespace for functions used
+    // in the implementation of 'hashAppend' for 'Datum'.
+
+    // CLASS METHODS
+    static unsigned int digest(const Datum& value);
+        // Return the non-zero 32-bit digest of the elements of the array or
+        // map held by the specified 'value', using the digest cached by
+        // 'Datum::cacheHash' if there is one.  The behavior is undefined
+        // unless 'value' holds an array or a map.
+
+    static bool haveDifferentCachedDigests(const Datum& lhs,
+                                           const Datum& rhs);
+        // Return 'true' if the specified 'lhs' and 'rhs' both hold arrays or
+        // maps whose digests are cached and the digests differ, and 'false'
+        // otherwise.  Note that a 'true' result implies that 'lhs' and 'rhs'
+        // do not compare equal.
+
+    static void normalizeDecimal64(int                 *sign,
+                                   bsls::Types::Uint64 *significand,
+                                   int                 *exponent,
+                                   bdldfp::Decimal64    value);
+        // Load into the specified 'sign', 'significand', and 'exponent' a
+        // representation of the specified 'value' that is the same for all
+        // 'Decimal64' values comparing equal to 'value' (e.g., '1.0' and
+        // '1.00').
+
+    static bool toInteger64(bsls::Types::Int64 *result, double value);
+        // Load into the specified 'result' the value of the specified 'value'
+        // and return 'true' if 'value' is integral and representable as an
+        // 'Int64'; otherwise, return 'false' with no effect on 'result'.
+};
+
+                           // =====================
+                           // struct Datum_MapIndex
+                           // =====================
+
+struct Datum_MapIndex {
+    // This component-private 'struct' provides a namespace for functions that
+    // lay out, build, and search the hash index of the keys of an indexed map.
+    // The index is an open-addressed (linear probing) table of 'unsigned int'
+    // slots, whose number is a power of two more than twice the capacity of
+    // the map, occupying the 'DatumMapEntry'-sized blocks between the map
+    // header and the map elements.  Each slot holds 0 if it is empty, and one
+    // more than the position of an element otherwise.
+
+    // CLASS METHODS
+    static void build(Datum_MapHeader *header);
+        // Build the index of the map having the specified 'header' from the
+        // elements of the map.  The behavior is undefined unless the map was
+        // created by 'Datum::createUninitializedIndexedMap' and its size has
+        // been set.
+
+    static const Datum *find(const bslstl::StringRef&  key,
+                             const unsigned int       *index,
+                             unsigned int              indexSize,
+                             const DatumMapEntry      *entries);
+        // Return the address of the value of the first of the specified
+        // 'entries' having the specified 'key', using the specified 'index'
+        // having the specified 'indexSize' slots, or 0 if there is no such
+        // element.
+
+    static Datum::SizeType numBlocks(unsigned int indexSize);
+        // Return the number of 'DatumMapEntry'-sized blocks occupied by an
+        // index having the specified 'indexSize' slots.
+
+    static unsigned int sizeForCapacity(Datum::SizeType capacity);
+        // Return the number of slots of the index of a map having the
+        // specified 'capacity'.  The behavior is undefined unless
+        // 'capacity < UINT_MAX / 4'.
 };
 
                           // ========================
@@ -2242,6 +2426,27 @@ class DatumMapRef {
     bool                 d_ownsKeys; // flag indicating whether the map owns
                                      // the keys or not
 
+    const unsigned int  *d_index_p;  // hash index of the keys, or 0 if the
+                                     // map is not indexed (not owned)
+
+    unsigned int         d_indexSize;
+                                     // number of slots in 'd_index_p'
+
+    // FRIENDS
+    friend class Datum;
+
+    // PRIVATE CREATORS
+    DatumMapRef(const DatumMapEntry *data,
+                SizeType             size,
+                bool                 sorted,
+                bool                 ownsKeys,
+                const unsigned int  *index,
+                unsigned int         indexSize);
+        // Create a 'DatumMapRef' object having the specified 'data' of the
+        // specified 'size', the specified 'sorted' and 'ownsKeys' flags, and
+        // the specified hash 'index' of the keys having the specified
+        // 'indexSize' slots (see 'Datum_MapIndex').
+
   public:
     // CREATORS
     DatumMapRef(const DatumMapEntry *data,
@@ -2263,6 +2468,10 @@ class DatumMapRef {
     const DatumMapEntry *data() const;
         // Return pointer to the first element in the map.
 
+    bool isIndexed() const;
+        // Return 'true' if underlying map has a hash index of its keys (see
+        // {Indexed Maps}), and 'false' otherwise.
+
     bool isSorted() const;
         // Return 'true' if underlying map is sorted and 'false' otherwise.
 
@@ -2277,7 +2486,8 @@ class DatumMapRef {
         // Return a const pointer to the datum having the specified 'key', if
         // it exists and 0 otherwise.  Note that the 'find' has order of 'O(n)'
         // if the data is not sorted based on the keys.  If the data is sorted,
-        // it has order of 'O(log(n))'.
+        // it has order of 'O(log(n))'.  If the map is indexed, it has constant
+        // average complexity.
 
     bsl::ostream& print(bsl::ostream& stream,
                         int           level          = 0,
@@ -3099,7 +3309,13 @@ Datum Datum::adoptMap(const DatumMutableMapRef& map)
 {
     // Note that 'map.size' contains the *address* of the 'size' information
     // for the map, which precedes the 'map' data in a contiguously allocated
-    // block (see 'DatumMutableMapRef').
+    // block (see 'DatumMutableMapRef').  The 'size' is the first member of
+    // the map header.
+
+    Datum_MapHeader *header = reinterpret_cast<Datum_MapHeader *>(map.size());
+    if (header && header->d_indexSize) {
+        Datum_MapIndex::build(header);
+    }
 
 #ifdef BSLS_PLATFORM_CPU_32_BIT
     return createExtendedDataObject(e_EXTENDED_INTERNAL_MAP, map.size());
@@ -3113,7 +3329,13 @@ Datum Datum::adoptMap(const DatumMutableMapOwningKeysRef& map)
 {
     // Note that 'map.size' contains the *address* of the 'size' information
     // for the map, which precedes the 'map' data in a contiguously allocated
-    // block (see 'DatumMutableMapOwningKeysRefRef').
+    // block (see 'DatumMutableMapOwningKeysRefRef').  The 'size' is the first
+    // member of the map header.
+
+    Datum_MapHeader *header = reinterpret_cast<Datum_MapHeader *>(map.size());
+    if (header && header->d_indexSize) {
+        Datum_MapIndex::build(header);
+    }
 
 #ifdef BSLS_PLATFORM_CPU_32_BIT
     return createExtendedDataObject(e_EXTENDED_INTERNAL_OWNED_MAP,
@@ -3513,6 +3735,18 @@ DatumMapRef Datum::theMap() const
         const Datum_MapHeader *header =
                                 reinterpret_cast<const Datum_MapHeader *>(map);
 
+        if (header->d_indexSize) {
+            const SizeType indexBlocks =
+                             Datum_MapIndex::numBlocks(header->d_indexSize);
+
+            return DatumMapRef(map + 1 + indexBlocks,
+                               header->d_size,
+                               header->d_sorted,
+                               header->d_ownsKeys,
+                               reinterpret_cast<const unsigned int *>(map + 1),
+                               header->d_indexSize);                  // RETURN
+        }
+
         return DatumMapRef(map + 1,
                            header->d_size,
                            header->d_sorted,
@@ -3917,6 +4151,8 @@ DatumMapRef::DatumMapRef(const DatumMapEntry *data,
 , d_size(size)
 , d_sorted(sorted)
 , d_ownsKeys(ownsKeys)
+, d_index_p(0)
+, d_indexSize(0)
 {
     BSLS_ASSERT_SAFE((size && data) || !size);
     if (0 == size) {
@@ -3924,6 +4160,27 @@ DatumMapRef::DatumMapRef(const DatumMapEntry *data,
     }
 }
 
+inline
+DatumMapRef::DatumMapRef(const DatumMapEntry *data,
+                         SizeType             size,
+                         bool                 sorted,
+                         bool                 ownsKeys,
+                         const unsigned int  *index,
+                         unsigned int         indexSize)
+: d_data_p(data)
+, d_size(size)
+, d_sorted(sorted)
+, d_ownsKeys(ownsKeys)
+, d_index_p(index)
+, d_indexSize(indexSize)
+{
+    BSLS_ASSERT_SAFE((size && data) || !size);
+    BSLS_ASSERT_SAFE(index && indexSize);
+    if (0 == size) {
+        d_ownsKeys = false;
+    }
+}
+
 // ACCESSORS
 inline
 const DatumMapEntry& DatumMapRef::operator[](SizeType index) const
@@ -3938,6 +4195,12 @@ const DatumMapEntry *DatumMapRef::data() const
     return d_data_p;
 }
 
+inline
+bool DatumMapRef::isIndexed() const
+{
+    return 0 != d_index_p;
+}
+
 inline
 bool DatumMapRef::isSorted() const
 {
@@ -4083,6 +4346,51 @@ bool *DatumMutableMapOwningKeysRef::sorted() const
     return d_sorted_p;
 }
 
+                           // ---------------------
+                           // struct Datum_HashUtil
+                           // ---------------------
+
+// CLASS METHODS
+inline
+bool Datum_HashUtil::toInteger64(bsls::Types::Int64 *result, double value)
+{
+    BSLS_ASSERT_SAFE(result);
+
+    // The bounds are '-2^63' and '2^63', both exactly representable.  Note
+    // that the comparisons are 'false' for NaN.
+
+    if (value >= -9223372036854775808.0 && value < 9223372036854775808.0) {
+        const bsls::Types::Int64 integer =
+                                      static_cast<bsls::Types::Int64>(value);
+        if (static_cast<double>(integer) == value) {
+            *result = integer;
+            return true;                                              // RETURN
+        }
+    }
+    return false;
+}
+
+                           // ---------------------
+                           // struct Datum_MapIndex
+                           // ---------------------
+
+// CLASS METHODS
+inline
+Datum::SizeType Datum_MapIndex::numBlocks(unsigned int indexSize)
+{
+    return (indexSize * sizeof(unsigned int) + sizeof(DatumMapEntry) - 1)
+                                                       / sizeof(DatumMapEntry);
+}
+
+inline
+unsigned int Datum_MapIndex::sizeForCapacity(Datum::SizeType capacity)
+{
+    unsigned int size = 1;
+    while (size <= capacity * 2) {
+        size *= 2;
+    }
+    return size;
+}
 
 }  // close package namespace
 
@@ -4141,6 +4449,104 @@ bsl::ostream& bdld::operator<<(bsl::ostream& stream, const DatumMapRef& rhs)
     return rhs.print(stream, 0 , -1);
 }
 
+// FREE FUNCTIONS
+template <class HASHALG>
+void bdld::hashAppend(HASHALG& hashAlg, const Datum& input)
+{
+    using ::BloombergLP::bslh::hashAppend;
+
+    // Numerically equal 'int', 'Int64', and integral 'double' values are all
+    // hashed as 'Int64' values, tagged as such.
+
+    const Datum::DataType type = input.type();
+
+    switch (type) {
+      case Datum::e_INTEGER: {
+        hashAppend(hashAlg, static_cast<int>(Datum::e_INTEGER64));
+        hashAppend(hashAlg,
+                   static_cast<bsls::Types::Int64>(input.theInteger()));
+      } break;
+      case Datum::e_INTEGER64: {
+        hashAppend(hashAlg, static_cast<int>(Datum::e_INTEGER64));
+        hashAppend(hashAlg, input.theInteger64());
+      } break;
+      case Datum::e_DOUBLE: {
+        bsls::Types::Int64 integer;
+        if (Datum_HashUtil::toInteger64(&integer, input.theDouble())) {
+            hashAppend(hashAlg, static_cast<int>(Datum::e_INTEGER64));
+            hashAppend(hashAlg, integer);
+        }
+        else {
+            hashAppend(hashAlg, static_cast<int>(type));
+            hashAppend(hashAlg, input.theDouble());
+        }
+      } break;
+      case Datum::e_STRING: {
+        hashAppend(hashAlg, static_cast<int>(type));
+        hashAppend(hashAlg, input.theString());
+      } break;
+      case Datum::e_BOOLEAN: {
+        hashAppend(hashAlg, static_cast<int>(type));
+        hashAppend(hashAlg, input.theBoolean());
+      } break;
+      case Datum::e_ERROR: {
+        const DatumError error = input.theError();
+        hashAppend(hashAlg, static_cast<int>(type));
+        hashAppend(hashAlg, error.code());
+        hashAppend(hashAlg, error.message());
+      } break;
+      case Datum::e_DATE: {
+        hashAppend(hashAlg, static_cast<int>(type));
+        hashAppend(hashAlg, input.theDate());
+      } break;
+      case Datum::e_TIME: {
+        hashAppend(hashAlg, static_cast<int>(type));
+        hashAppend(hashAlg, input.theTime());
+      } break;
+      case Datum::e_DATETIME: {
+        hashAppend(hashAlg, static_cast<int>(type));
+        hashAppend(hashAlg, input.theDatetime());
+      } break;
+      case Datum::e_DATETIME_INTERVAL: {
+        hashAppend(hashAlg, static_cast<int>(type));
+        hashAppend(hashAlg, input.theDatetimeInterval());
+      } break;
+      case Datum::e_USERDEFINED: {
+        const DatumUdt udt = input.theUdt();
+        hashAppend(hashAlg, static_cast<int>(type));
+        hashAppend(hashAlg, udt.data());
+        hashAppend(hashAlg, udt.type());
+      } break;
+      case Datum::e_ARRAY:
+      case Datum::e_MAP: {
+        hashAppend(hashAlg, static_cast<int>(type));
+        hashAppend(hashAlg, Datum_HashUtil::digest(input));
+      } break;
+      case Datum::e_BINARY: {
+        const DatumBinaryRef binary = input.theBinary();
+        hashAppend(hashAlg, static_cast<int>(type));
+        hashAppend(hashAlg, static_cast<bsls::Types::Uint64>(binary.size()));
+        hashAlg(binary.data(), binary.size());
+      } break;
+      case Datum::e_DECIMAL64: {
+        int                 sign;
+        bsls::Types::Uint64 significand;
+        int                 exponent;
+        Datum_HashUtil::normalizeDecimal64(&sign,
+                                           &significand,
+                                           &exponent,
+                                           input.theDecimal64());
+        hashAppend(hashAlg, static_cast<int>(type));
+        hashAppend(hashAlg, sign);
+        hashAppend(hashAlg, significand);
+        hashAppend(hashAlg, exponent);
+      } break;
+      default: {
+        hashAppend(hashAlg, static_cast<int>(type));
+      } break;
+    }
+}
+
 }  // close enterprise namespace
 
 #endif
@@ -19,6 +19,7 @@
 #include <bdlma_bufferedsequentialallocator.h>
 #include <bslma_testallocator.h>
 #include <bslma_testallocatormonitor.h>
+#include <bslh_hash.h>
 #include <bsl_algorithm.h>
 #include <bsl_cstddef.h>                        // 'size_t'
 #include <bsl_cstdlib.h>                        // 'atoi'
@@ -28,6 +29,7 @@
 #include <bsl_limits.h>
 #include <bsl_memory.h>
 #include <bsl_sstream.h>
+#include <bsl_unordered_map.h>
 #include <bsl_vector.h>
 #include <bsls_stopwatch.h>
 #include <bsls_timeutil.h>
@@ -188,7 +190,10 @@ using bdldfp::Decimal64;
 // [14] void createUninitializedArray(DatumMutableArrayRef*,SizeType,...);
 // [15] void createUninitializedMap(DatumMutableMapRef*, SizeType, ...);
 // [15] void createUninitializedMap(DatumMutableMapOwningKeysRef *, ...);
+// [33] void createUninitializedIndexedMap(DatumMutableMapRef *, ...);
+// [33] void createUninitializedIndexedMap(DatumMutableMapOwningKeysRef*,...);
 // [16] char* createUninitializedString(Datum&, SizeType, Allocator *);
+// [32] void cacheHash(const Datum& value);
 // [26] const char* dataTypeToAscii(Datum::DataType);
 // [ 3] void destroy(const Datum&, bslma::Allocator *);
 // [24] void disposeUninitializedArray(Datum *, basicAllocator *);
@@ -200,6 +205,7 @@ using bdldfp::Decimal64;
 //
 // ACCESSORS
 // [21] Datum clone(bslma::Allocator *basicAllocator) const;
+// [32] bool hasCachedHash() const;
 // [14] bool isArray() const;
 // [ 3] bool isBoolean() const;
 // [ 3] bool isBinary() const;
@@ -246,6 +252,9 @@ using bdldfp::Decimal64;
 // [17] bsl::ostream& operator<<(ostream&, const Datum&); // aggregate
 // [27] bsl::ostream& operator<<(ostream&, const Datum::DataType);
 //
+// FREE FUNCTIONS
+// [32] void hashAppend(HASHALG& hashAlg, const Datum& input);
+//
 //                            // -------------------
 //                            // class DatumMapEntry
 //                            // -------------------
@@ -331,6 +340,7 @@ using bdldfp::Decimal64;
 // ACCESSORS
 // [13] const DatumMapEntry& operator[](SizeType index) const;
 // [13] const DatumMapEntry *data() const;
+// [33] bool isIndexed() const;
 // [13] bool isSorted() const;
 // [13] SizeType size() const;
 // [13] const Datum *find(const bslstl::StringRef& key) const;
@@ -342,7 +352,7 @@ using bdldfp::Decimal64;
 // [13] bsl::ostream& operator<<(bsl::ostream&, const DatumMapRef&);
 // ----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [31] USAGE EXAMPLE
+// [34] USAGE EXAMPLE
 // [22] Datum_ArrayProctor
 // [30] MISALIGNED MEMORY ACCESS TEST (only on SUN machines)
 // [29] COMPRESSIBILITY OF DECIMAL64
@@ -1573,7 +1583,7 @@ int main(int argc, char *argv[])
     srand(static_cast<unsigned int>(time(static_cast<time_t *>(0))));
 
     switch (test) { case 0:
-      case 32: {
+      case 34: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -1864,6 +1874,584 @@ int main(int argc, char *argv[])
 //..
 // Note, that the bytes have been copied.
       } break;
+      case 33: {
+        // --------------------------------------------------------------------
+        // INDEXED MAPS
+        //
+        // Concerns:
+        //: 1 An indexed map, with or without owned keys, holds the elements
+        //:   loaded into it, reports 'isIndexed', and 'find' returns the
+        //:   value of every key present and 0 for every key absent, for maps
+        //:   of various sizes, including empty maps and maps whose size is
+        //:   less than their capacity.
+        //:
+        //: 2 When several elements have the same key, 'find' returns the
+        //:   value of the first of them, as it does for a non-indexed map.
+        //:
+        //: 3 An indexed map compares equal to, and hashes identically to, a
+        //:   non-indexed map having the same elements.
+        //:
+        //: 4 'clone' of a non-empty indexed map produces an indexed map.
+        //:
+        //: 5 All memory is allocated from the specified allocator and is
+        //:   released by 'destroy'.
+        //:
+        //: 6 Maps created by 'createUninitializedMap' are not indexed.
+        //
+        // Plan:
+        //: 1 For a set of sizes and capacities, create indexed maps having
+        //:   and not having owned keys, adopt them, and verify 'isIndexed'
+        //:   and the result of 'find' for present and absent keys.  Create
+        //:   the equivalent non-indexed map and compare the two using
+        //:   'operator==' and 'bslh::Hash'.  Clone the indexed maps and
+        //:   verify the clones.  Destroy all maps and verify using a test
+        //:   allocator that no memory is outstanding.  (C-1, 3..6)
+        //:
+        //: 2 Create an indexed map having duplicate keys and verify that
+        //:   'find' returns the value of the first element having the key.
+        //:   (C-2)
+        //
+        // Testing:
+        //   void createUninitializedIndexedMap(DatumMutableMapRef *, ...);
+        //   void createUninitializedIndexedMap(DatumMutableMapOwningKeysRef*);
+        //   bool isIndexed() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INDEXED MAPS" << endl
+                          << "============" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+        bslma::TestAllocator         oa("object", veryVeryVeryVerbose);
+        bslma::TestAllocator         sa("scratch", veryVeryVeryVerbose);
+
+        const bslh::Hash<> hasher = bslh::Hash<>();
+
+        if (verbose) cout << "\nTesting maps of various sizes." << endl;
+        {
+            const struct {
+                int      d_line;
+                SizeType d_size;
+                SizeType d_capacity;
+            } DATA[] = {
+                //LINE  SIZE  CAPACITY
+                //----  ----  --------
+                { L_,      0,        0 },
+                { L_,      0,        4 },
+                { L_,      1,        1 },
+                { L_,      2,        2 },
+                { L_,      3,        8 },
+                { L_,     17,       17 },
+                { L_,    100,      200 },
+                { L_,   1000,     1000 },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int      LINE     = DATA[ti].d_line;
+                const SizeType SIZE     = DATA[ti].d_size;
+                const SizeType CAPACITY = DATA[ti].d_capacity;
+
+                if (veryVerbose) { T_ P_(LINE) P_(SIZE) P(CAPACITY) }
+
+                bsl::vector<bsl::string> keys(&sa);
+                SizeType                 keysLength = 0;
+                for (SizeType i = 0; i < SIZE; ++i) {
+                    bsl::ostringstream oss(&sa);
+                    oss << "key" << i * 7;
+                    keys.push_back(oss.str());
+                    keysLength += static_cast<SizeType>(keys.back().length());
+                }
+
+                DatumMutableMapRef plain;
+                DatumMutableMapRef indexed;
+                Datum::createUninitializedMap(&plain, CAPACITY, &oa);
+                Datum::createUninitializedIndexedMap(&indexed, CAPACITY, &oa);
+
+                DatumMutableMapOwningKeysRef owning;
+                Datum::createUninitializedIndexedMap(&owning,
+                                                     CAPACITY,
+                                                     keysLength,
+                                                     &oa);
+                char *nextKey = owning.keys();
+
+                for (SizeType i = 0; i < SIZE; ++i) {
+                    const int       VALUE = static_cast<int>(i);
+                    const StringRef KEY(keys[i]);
+
+                    plain.data()[i]   = DatumMapEntry(
+                                                 KEY,
+                                                 Datum::createInteger(VALUE));
+                    indexed.data()[i] = DatumMapEntry(
+                                                 KEY,
+                                                 Datum::createInteger(VALUE));
+
+                    bsl::memcpy(nextKey, KEY.data(), KEY.length());
+                    owning.data()[i] = DatumMapEntry(
+                                                 StringRef(nextKey,
+                                                           KEY.length()),
+                                                 Datum::createInteger(VALUE));
+                    nextKey += KEY.length();
+                }
+                *plain.size()   = SIZE;
+                *indexed.size() = SIZE;
+                *owning.size()  = SIZE;
+
+                const Datum P = Datum::adoptMap(plain);
+                const Datum I = Datum::adoptMap(indexed);
+                const Datum O = Datum::adoptMap(owning);
+
+                ASSERTV(LINE, !P.theMap().isIndexed());
+                ASSERTV(LINE,  I.theMap().isIndexed());
+                ASSERTV(LINE,  O.theMap().isIndexed());
+
+                ASSERTV(LINE, SIZE == I.theMap().size());
+                ASSERTV(LINE, SIZE == O.theMap().size());
+
+                for (SizeType i = 0; i < SIZE; ++i) {
+                    const Datum EXPECTED =
+                                  Datum::createInteger(static_cast<int>(i));
+
+                    const Datum *resultI = I.theMap().find(keys[i]);
+                    const Datum *resultO = O.theMap().find(keys[i]);
+
+                    ASSERTV(LINE, i, resultI);
+                    ASSERTV(LINE, i, resultO);
+                    if (resultI && resultO) {
+                        ASSERTV(LINE, i, EXPECTED == *resultI);
+                        ASSERTV(LINE, i, EXPECTED == *resultO);
+                    }
+
+                    bsl::ostringstream oss(&sa);
+                    oss << "key" << i * 7 + 1;
+                    const bsl::string ABSENT = oss.str();
+
+                    ASSERTV(LINE, i, 0 == I.theMap().find(ABSENT));
+                    ASSERTV(LINE, i, 0 == O.theMap().find(ABSENT));
+                }
+                ASSERTV(LINE, 0 == I.theMap().find(""));
+                ASSERTV(LINE, 0 == O.theMap().find(""));
+
+                ASSERTV(LINE, P == I);
+                ASSERTV(LINE, P == O);
+                ASSERTV(LINE, hasher(P) == hasher(I));
+                ASSERTV(LINE, hasher(P) == hasher(O));
+
+                const Datum CI = I.clone(&oa);
+                const Datum CO = O.clone(&oa);
+
+                // Note that a clone of an empty map does not allocate.
+
+                ASSERTV(LINE, (0 < SIZE) == CI.theMap().isIndexed());
+                ASSERTV(LINE, (0 < SIZE) == CO.theMap().isIndexed());
+                ASSERTV(LINE, I == CI);
+                ASSERTV(LINE, O == CO);
+
+                for (SizeType i = 0; i < SIZE; ++i) {
+                    const Datum *resultCI = CI.theMap().find(keys[i]);
+                    const Datum *resultCO = CO.theMap().find(keys[i]);
+
+                    const Datum EXPECTED =
+                                  Datum::createInteger(static_cast<int>(i));
+
+                    ASSERTV(LINE, i, resultCI && EXPECTED == *resultCI);
+                    ASSERTV(LINE, i, resultCO && EXPECTED == *resultCO);
+                }
+
+                Datum::destroy(P,  &oa);
+                Datum::destroy(I,  &oa);
+                Datum::destroy(O,  &oa);
+                Datum::destroy(CI, &oa);
+                Datum::destroy(CO, &oa);
+
+                ASSERTV(LINE, 0 == oa.numBytesInUse());
+            }
+        }
+
+        if (verbose) cout << "\nTesting duplicate keys." << endl;
+        {
+            const char     *KEYS[]   = { "a", "b", "a", "c", "b", "a" };
+            const SizeType  NUM_KEYS = sizeof KEYS / sizeof *KEYS;
+
+            DatumMutableMapRef plain;
+            DatumMutableMapRef indexed;
+            Datum::createUninitializedMap(&plain, NUM_KEYS, &oa);
+            Datum::createUninitializedIndexedMap(&indexed, NUM_KEYS, &oa);
+
+            for (SizeType i = 0; i < NUM_KEYS; ++i) {
+                const Datum VALUE = Datum::createInteger(static_cast<int>(i));
+
+                plain.data()[i]   = DatumMapEntry(KEYS[i], VALUE);
+                indexed.data()[i] = DatumMapEntry(KEYS[i], VALUE);
+            }
+            *plain.size()   = NUM_KEYS;
+            *indexed.size() = NUM_KEYS;
+
+            const Datum P = Datum::adoptMap(plain);
+            const Datum I = Datum::adoptMap(indexed);
+
+            const struct {
+                int         d_line;
+                const char *d_key;
+                int         d_value;
+            } DATA[] = {
+                //LINE  KEY  VALUE
+                //----  ---  -----
+                { L_,   "a",     0 },
+                { L_,   "b",     1 },
+                { L_,   "c",     3 },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int   LINE  = DATA[ti].d_line;
+                const char *KEY   = DATA[ti].d_key;
+                const int   VALUE = DATA[ti].d_value;
+
+                const Datum *resultP = P.theMap().find(KEY);
+                const Datum *resultI = I.theMap().find(KEY);
+
+                ASSERTV(LINE, resultP && VALUE == resultP->theInteger());
+                ASSERTV(LINE, resultI && VALUE == resultI->theInteger());
+            }
+            ASSERT(0 == I.theMap().find("d"));
+
+            Datum::destroy(P, &oa);
+            Datum::destroy(I, &oa);
+        }
+
+        ASSERT(0 == oa.numBytesInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 32: {
+        // --------------------------------------------------------------------
+        // HASHING
+        //
+        // Concerns:
+        //: 1 Datums that compare equal produce the same hash, for every type
+        //:   of value, including strings held in different representations,
+        //:   'Decimal64' values of the same cohort, '0.0' and '-0.0', and
+        //:   arrays and maps held both directly and by reference.
+        //:
+        //: 2 Datums holding numerically equal 'int', 'Int64', and 'double'
+        //:   values produce the same hash.
+        //:
+        //: 3 Datums having distinct values produce (with overwhelming
+        //:   probability) distinct hashes.
+        //:
+        //: 4 'cacheHash' caches the digest of an array or map and of all
+        //:   aggregates nested within it, does not allocate memory, and does
+        //:   not change the hash of any datum.
+        //:
+        //: 5 'cacheHash' has no effect on datums that are not arrays or maps
+        //:   and on aggregates having no storage for a digest.
+        //:
+        //: 6 Equality of arrays and maps is unaffected by cached digests,
+        //:   including for aggregates holding 'NaN' values.
+        //:
+        //: 7 'Datum' can be used as the key of a 'bsl::unordered_map'.
+        //
+        // Plan:
+        //: 1 Using the table-driven technique, create pairs of equal datums
+        //:   of every type, held in different representations, and verify
+        //:   that their hashes are equal.  (C-1)
+        //:
+        //: 2 Verify that 'int', 'Int64', and 'double' datums having the same
+        //:   integral value hash identically.  (C-2)
+        //:
+        //: 3 Verify that the hashes of the first members of the pairs of P-1
+        //:   are all distinct.  (C-3)
+        //:
+        //: 4 Create nested arrays and maps, record their hashes, call
+        //:   'cacheHash' on the outermost aggregate, and verify using
+        //:   'hasCachedHash', a test allocator, and the recorded hashes that
+        //:   every aggregate is cached, nothing is allocated, and the hashes
+        //:   are unchanged.  (C-4)
+        //:
+        //: 5 Call 'cacheHash' on scalars, on an empty map, and on an array
+        //:   reference, and verify using 'hasCachedHash' the expected
+        //:   (absence of) effect.  (C-5)
+        //:
+        //: 6 Compare equal and unequal cached aggregates, and aggregates
+        //:   holding 'NaN', using 'operator=='.  (C-6)
+        //:
+        //: 7 Insert aggregates into a 'bsl::unordered_map' and look them up
+        //:   by equal aggregates.  (C-7)
+        //
+        // Testing:
+        //   void hashAppend(HASHALG& hashAlg, const Datum& input);
+        //   void cacheHash(const Datum& value);
+        //   bool hasCachedHash() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "HASHING" << endl
+                          << "=======" << endl;
+
+        bslma::TestAllocator         da("default", veryVeryVeryVerbose);
+        bslma::DefaultAllocatorGuard guard(&da);
+        bslma::TestAllocator         oa("object", veryVeryVeryVerbose);
+
+        const bslh::Hash<> hasher = bslh::Hash<>();
+
+        if (verbose) cout << "\nTesting equal values of every type." << endl;
+
+        const int  k_NUM_ELEMENTS = 3;
+        const char BLOB[]         = { 1, 2, 3, 4 };
+        int        udtObject      = 0;
+
+        Datum elements[k_NUM_ELEMENTS] = {
+            Datum::createInteger(1),
+            Datum::createStringRef("element", &oa),
+            Datum::createDouble(2.5)
+        };
+
+        DatumMutableArrayRef array;
+        Datum::createUninitializedArray(&array, k_NUM_ELEMENTS, &oa);
+        bsl::copy(elements, elements + k_NUM_ELEMENTS, array.data());
+        *array.length() = k_NUM_ELEMENTS;
+
+        DatumMutableMapRef map;
+        Datum::createUninitializedMap(&map, 2, &oa);
+        map.data()[0] = DatumMapEntry("first", elements[0]);
+        map.data()[1] = DatumMapEntry("second", elements[2]);
+        *map.size() = 2;
+
+        DatumMutableMapOwningKeysRef ownedMap;
+        Datum::createUninitializedMap(&ownedMap, 2, 11, &oa);
+        bsl::memcpy(ownedMap.keys(), "firstsecond", 11);
+        ownedMap.data()[0] = DatumMapEntry(StringRef(ownedMap.keys(), 5),
+                                           elements[0]);
+        ownedMap.data()[1] = DatumMapEntry(StringRef(ownedMap.keys() + 5, 6),
+                                           elements[2]);
+        *ownedMap.size() = 2;
+
+        const struct {
+            int   d_line;
+            Datum d_first;
+            Datum d_second;
+        } DATA[] = {
+            { L_, Datum::createNull(),          Datum::createNull()          },
+            { L_, Datum::createBoolean(true),   Datum::createBoolean(true)   },
+            { L_, Datum::createBoolean(false),  Datum::createBoolean(false)  },
+            { L_, Datum::createInteger(-7),     Datum::createInteger(-7)     },
+            { L_, Datum::createDouble(0.0),     Datum::createDouble(-0.0)    },
+            { L_, Datum::createDouble(0.5),     Datum::createDouble(0.5)     },
+            { L_, Datum::createDouble(1e300),   Datum::createDouble(1e300)   },
+            { L_, Datum::createInteger64(1LL << 40, &oa),
+                  Datum::createInteger64(1LL << 40, &oa)                     },
+            { L_, Datum::copyString("short", &oa),
+                  Datum::createStringRef("short", &oa)                       },
+            { L_, Datum::copyString("a longer string value", &oa),
+                  Datum::createStringRef("a longer string value", &oa)       },
+            { L_, Datum::createError(3, "error", &oa),
+                  Datum::createError(3, "error", &oa)                        },
+            { L_, Datum::createDate(Date(2016, 2, 29)),
+                  Datum::createDate(Date(2016, 2, 29))                       },
+            { L_, Datum::createTime(Time(12, 34, 56)),
+                  Datum::createTime(Time(12, 34, 56))                        },
+            { L_, Datum::createDatetime(Datetime(2016, 2, 29, 1), &oa),
+                  Datum::createDatetime(Datetime(2016, 2, 29, 1), &oa)       },
+            { L_, Datum::createDatetimeInterval(DatetimeInterval(1, 2), &oa),
+                  Datum::createDatetimeInterval(DatetimeInterval(1, 2), &oa) },
+            { L_, Datum::createUdt(&udtObject, 5),
+                  Datum::createUdt(&udtObject, 5)                            },
+            { L_, Datum::copyBinary(BLOB, sizeof BLOB, &oa),
+                  Datum::copyBinary(BLOB, sizeof BLOB, &oa)                  },
+            { L_, Datum::createDecimal64(BDLDFP_DECIMAL_DD(1.5), &oa),
+                  Datum::createDecimal64(BDLDFP_DECIMAL_DD(1.500), &oa)      },
+            { L_, Datum::createDecimal64(BDLDFP_DECIMAL_DD(0.0), &oa),
+                  Datum::createDecimal64(BDLDFP_DECIMAL_DD(-0.00), &oa)      },
+            { L_, Datum::adoptArray(array),
+                  Datum::createArrayReference(elements, k_NUM_ELEMENTS, &oa) },
+            { L_, Datum::adoptMap(map),
+                  Datum::adoptMap(ownedMap)                                  },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int i = 0; i < NUM_DATA; ++i) {
+            const int    LINE = DATA[i].d_line;
+            const Datum& X    = DATA[i].d_first;
+            const Datum& Y    = DATA[i].d_second;
+
+            if (veryVerbose) { T_ P_(LINE) P_(X) P(Y) }
+
+            ASSERTV(LINE, X == Y);
+            ASSERTV(LINE, hasher(X) == hasher(Y));
+
+            for (int j = 0; j < i; ++j) {
+                const Datum& Z = DATA[j].d_first;
+
+                ASSERTV(LINE, DATA[j].d_line, hasher(X) != hasher(Z));
+            }
+        }
+
+        if (verbose) cout << "\nTesting numerically equal values." << endl;
+        {
+            const double VALUES[] = { 0, 1, -1, 42, 2147483647, -2147483648.0,
+                                      9007199254740992.0 };
+            const int    NUM_VALUES =
+                            static_cast<int>(sizeof VALUES / sizeof *VALUES);
+
+            for (int i = 0; i < NUM_VALUES; ++i) {
+                const double V = VALUES[i];
+                const Datum  D = Datum::createDouble(V);
+                const Datum  L = Datum::createInteger64(
+                                             static_cast<Int64>(V), &oa);
+
+                ASSERTV(V, hasher(D) == hasher(L));
+
+                if (V == static_cast<double>(static_cast<int>(V))) {
+                    const Datum I = Datum::createInteger(static_cast<int>(V));
+
+                    ASSERTV(V, hasher(D) == hasher(I));
+                }
+                Datum::destroy(L, &oa);
+            }
+
+            ASSERT(hasher(Datum::createDouble(1.5))
+                                       != hasher(Datum::createInteger(1)));
+            ASSERT(hasher(Datum::createDouble(-0.0))
+                                       == hasher(Datum::createInteger(0)));
+        }
+
+        if (verbose) cout << "\nTesting 'cacheHash'." << endl;
+        {
+            const Datum& ARRAY     = DATA[NUM_DATA - 2].d_first;
+            const Datum& ARRAY_REF = DATA[NUM_DATA - 2].d_second;
+            const Datum& MAP       = DATA[NUM_DATA - 1].d_first;
+
+            // Build '[ ARRAY, MAP, ARRAY_REF ]'.
+
+            DatumMutableArrayRef outer;
+            Datum::createUninitializedArray(&outer, 3, &oa);
+            outer.data()[0] = ARRAY;
+            outer.data()[1] = MAP;
+            outer.data()[2] = ARRAY_REF;
+            *outer.length() = 3;
+
+            const Datum OUTER = Datum::adoptArray(outer);
+
+            const bsl::size_t outerHash = hasher(OUTER);
+            const bsl::size_t arrayHash = hasher(ARRAY);
+            const bsl::size_t mapHash   = hasher(MAP);
+
+            ASSERT(!OUTER.hasCachedHash());
+            ASSERT(!ARRAY.hasCachedHash());
+            ASSERT(!MAP.hasCachedHash());
+
+            bslma::TestAllocatorMonitor oam(&oa), dam(&da);
+
+            Datum::cacheHash(OUTER);
+
+            ASSERT(oam.isTotalSame());
+            ASSERT(dam.isTotalSame());
+
+            ASSERT(OUTER.hasCachedHash());
+            ASSERT(ARRAY.hasCachedHash());
+            ASSERT(MAP.hasCachedHash());
+            ASSERT(!ARRAY_REF.hasCachedHash());
+
+            ASSERT(outerHash == hasher(OUTER));
+            ASSERT(arrayHash == hasher(ARRAY));
+            ASSERT(mapHash   == hasher(MAP));
+            ASSERT(arrayHash == hasher(ARRAY_REF));
+
+            // Scalars, empty maps, and array references are unaffected.
+
+            const Datum       INTEGER = Datum::createInteger(5);
+            const bsl::size_t intHash = hasher(INTEGER);
+            Datum::cacheHash(INTEGER);
+            ASSERT(!INTEGER.hasCachedHash());
+            ASSERT(intHash == hasher(INTEGER));
+
+            const Datum EMPTY = Datum::adoptMap(DatumMutableMapRef());
+            Datum::cacheHash(EMPTY);
+            ASSERT(!EMPTY.hasCachedHash());
+
+            Datum::cacheHash(ARRAY_REF);
+            ASSERT(!ARRAY_REF.hasCachedHash());
+
+            // Equality in the presence of cached digests.
+
+            DatumMutableArrayRef copy;
+            Datum::createUninitializedArray(&copy, 3, &oa);
+            copy.data()[0] = ARRAY_REF;
+            copy.data()[1] = MAP;
+            copy.data()[2] = ARRAY;
+            *copy.length() = 3;
+
+            const Datum COPY = Datum::adoptArray(copy);
+
+            ASSERT(OUTER == COPY);
+            Datum::cacheHash(COPY);
+            ASSERT(COPY.hasCachedHash());
+            ASSERT(OUTER == COPY);
+            ASSERT(hasher(OUTER) == hasher(COPY));
+
+            ASSERT(OUTER != ARRAY);
+            ASSERT(ARRAY != MAP);
+
+            DatumMutableArrayRef other;
+            Datum::createUninitializedArray(&other, 3, &oa);
+            other.data()[0] = ARRAY;
+            other.data()[1] = MAP;
+            other.data()[2] = Datum::createNull();
+            *other.length() = 3;
+
+            const Datum OTHER = Datum::adoptArray(other);
+
+            Datum::cacheHash(OTHER);
+            ASSERT(OUTER != OTHER);
+            ASSERT(OTHER != OUTER);
+            ASSERT(hasher(OUTER) != hasher(OTHER));
+
+            DatumMutableArrayRef nan;
+            Datum::createUninitializedArray(&nan, 1, &oa);
+            nan.data()[0] = Datum::createDouble(
+                                     bsl::numeric_limits<double>::quiet_NaN());
+            *nan.length() = 1;
+
+            const Datum NAN_ARRAY = Datum::adoptArray(nan);
+
+            ASSERT(NAN_ARRAY != NAN_ARRAY);
+            Datum::cacheHash(NAN_ARRAY);
+            ASSERT(NAN_ARRAY != NAN_ARRAY);
+
+            if (verbose) cout << "\nTesting use as a hash key." << endl;
+
+            bsl::unordered_map<Datum, int> index(&oa);
+
+            index[OUTER]   = 1;
+            index[ARRAY]   = 2;
+            index[MAP]     = 3;
+            index[INTEGER] = 4;
+
+            ASSERT(4 == index.size());
+            ASSERT(1 == index[COPY]);
+            ASSERT(2 == index[ARRAY_REF]);
+            ASSERT(4 == index[Datum::createInteger(5)]);
+            ASSERT(index.end() == index.find(OTHER));
+
+            index.clear();
+
+            // Only the outer arrays are destroyed: their elements are
+            // destroyed with 'DATA' or require no deallocation.
+
+            Datum::disposeUninitializedArray(outer, &oa);
+            Datum::disposeUninitializedArray(copy, &oa);
+            Datum::disposeUninitializedArray(other, &oa);
+            Datum::destroy(NAN_ARRAY, &oa);
+        }
+
+        // Note that destroying the adopted array destroys 'elements'.
+
+        for (int i = 0; i < NUM_DATA; ++i) {
+            Datum::destroy(DATA[i].d_first, &oa);
+            Datum::destroy(DATA[i].d_second, &oa);
+        }
+      } break;
 
       case 31: {
         // --------------------------------------------------------------------
@@ -0,0 +1,167 @@
+// bdlma_arenaregistry.cpp                                            -*-C++-*-
+#include <bdlma_arenaregistry.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_arenaregistry_cpp,"$Id$ $CSID$")
+
+#include <bslma_deallocatorproctor.h>
+
+#include <bsls_performancehint.h>
+
+#include <new>           // placement 'new'
+
+namespace BloombergLP {
+namespace bdlma {
+
+                            // -------------------
+                            // class ArenaRegistry
+                            // -------------------
+
+// PRIVATE TYPES
+ArenaRegistry::Arena::Arena(bslma::Allocator *basicAllocator)
+: SequentialAllocator(basicAllocator)
+, d_next_p(0)
+{
+}
+
+// PRIVATE CLASS METHODS
+void ArenaRegistry::releaseCache(void *cache, void *registry)
+{
+    Cache         *c = static_cast<Cache *>(cache);
+    ArenaRegistry *r = static_cast<ArenaRegistry *>(registry);
+
+    while (c->d_arenas_p) {
+        Arena *next = c->d_arenas_p->d_next_p;
+        r->destroyArena(c->d_arenas_p);
+        c->d_arenas_p = next;
+    }
+}
+
+// PRIVATE MANIPULATORS
+void ArenaRegistry::destroyArena(Arena *arena)
+{
+    arena->~Arena();
+    d_caches.allocator()->deallocate(arena);
+
+    d_numArenas.addRelaxed(-1);
+}
+
+ArenaRegistry::Cache *ArenaRegistry::localCache()
+{
+    Cache *cache = static_cast<Cache *>(d_caches.localCache());
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(cache)) {
+        return cache;                                                 // RETURN
+    }
+
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+    cache = static_cast<Cache *>(d_caches.allocateCache());
+
+    cache->d_arenas_p  = 0;
+    cache->d_numArenas = 0;
+
+    d_caches.registerCache(cache);
+
+    return cache;
+}
+
+// CREATORS
+ArenaRegistry::ArenaRegistry(bslma::Allocator *basicAllocator)
+: d_maxRetainedSize(0)
+, d_caches(sizeof(Cache), &ArenaRegistry::releaseCache, this, basicAllocator)
+, d_numArenas(0)
+{
+}
+
+ArenaRegistry::ArenaRegistry(bsls::Types::size_type  maxRetainedSize,
+                             bslma::Allocator       *basicAllocator)
+: d_maxRetainedSize(maxRetainedSize)
+, d_caches(sizeof(Cache), &ArenaRegistry::releaseCache, this, basicAllocator)
+, d_numArenas(0)
+{
+}
+
+ArenaRegistry::~ArenaRegistry()
+{
+    d_caches.releaseCaches();
+
+    BSLS_ASSERT(0 == d_numArenas);
+}
+
+// MANIPULATORS
+SequentialAllocator *ArenaRegistry::acquireArena()
+{
+    // Note that the cache of the calling thread is created (if needed) here,
+    // so that returning the arena from this thread does not allocate.
+
+    Cache *cache = localCache();
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(cache->d_arenas_p)) {
+        Arena *arena      = cache->d_arenas_p;
+        cache->d_arenas_p = arena->d_next_p;
+        --cache->d_numArenas;
+
+        return arena;                                                 // RETURN
+    }
+
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+    bslma::Allocator *allocator = d_caches.allocator();
+
+    Arena *arena = static_cast<Arena *>(allocator->allocate(sizeof(Arena)));
+
+    bslma::DeallocatorProctor<bslma::Allocator> proctor(arena, allocator);
+
+    // Note that 'arena' is converted to 'void *' so that placement 'new' is
+    // not resolved to the overload taking a 'bslma::Allocator *'.
+
+    new (static_cast<void *>(arena)) Arena(allocator);
+
+    proctor.release();
+
+    d_numArenas.addRelaxed(1);
+
+    return arena;
+}
+
+void ArenaRegistry::releaseArena(SequentialAllocator *arena)
+{
+    BSLS_ASSERT(arena);
+
+    Arena *a     = static_cast<Arena *>(arena);
+    Cache *cache = localCache();
+
+    a->rewind(d_maxRetainedSize);
+
+    a->d_next_p       = cache->d_arenas_p;
+    cache->d_arenas_p = a;
+    ++cache->d_numArenas;
+}
+
+// ACCESSORS
+int ArenaRegistry::numCachedArenas() const
+{
+    const Cache *cache = static_cast<const Cache *>(d_caches.localCache());
+
+    return cache ? cache->d_numArenas : 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,366 @@
+// bdlma_arenaregistry.h                                              -*-C++-*-
+#ifndef INCLUDED_BDLMA_ARENAREGISTRY
+#define INCLUDED_BDLMA_ARENAREGISTRY
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a registry of reusable per-thread sequential allocators.
+//
+//@CLASSES:
+//  bdlma::ArenaRegistry: thread-safe registry of per-thread arenas
+//  bdlma::ArenaGuard: scoped acquisition of an arena from a registry
+//
+//@SEE_ALSO: bdlma_sequentialallocator, bdlma_threadcachingallocator
+//
+//@DESCRIPTION: This component provides a thread-safe mechanism,
+// 'bdlma::ArenaRegistry', that supplies "arenas" -- sequential allocators
+// ('bdlma::SequentialAllocator') -- for the exclusive use of the calling
+// thread, and a guard, 'bdlma::ArenaGuard', that acquires an arena from a
+// registry on construction and returns it on destruction.
+//
+// A server creating a 'bdlma::SequentialAllocator' for each request it
+// processes, and destroying it when the request is complete, obtains the
+// chain of internal buffers of the allocator from the underlying allocator
+// anew for each request.  Instead, an arena returned to the registry is
+// rewound (see 'bdlma_sequentialpool'), retaining its largest internal buffers
+// up to a "maximum retained size" specified at construction of the registry,
+// and cached by the returning thread, to be acquired again by the next request
+// processed by that thread.  Once the retained buffers of the arenas have
+// grown to the high-water mark of the requests, processing a request obtains
+// no memory from the underlying allocator, and acquiring and returning an
+// arena does not access any memory shared between threads.
+//
+///Caches and Thread Exit
+///----------------------
+// Each thread that has acquired an arena from (or returned an arena to) the
+// registry holds a cache of arenas.  'acquireArena' takes the arena most
+// recently returned by the calling thread, and creates a new arena only if the
+// cache of the calling thread is empty; each thread therefore holds as many
+// arenas as the maximum number of arenas it has acquired at the same time
+// (usually one, or a few if acquisitions are nested).  An arena may be
+// returned by a thread other than the one that acquired it, in which case it
+// joins the cache of the returning thread.  When a thread that holds a cache
+// exits, the arenas in its cache are destroyed, releasing their memory to the
+// underlying allocator.  All other arenas are destroyed with the registry.
+//
+///Thread Safety
+///-------------
+// 'bdlma::ArenaRegistry' is *fully thread-safe*, meaning any operation on the
+// same object can be safely invoked from any thread.  The behavior is
+// undefined if the registry is destroyed while any other thread is using it,
+// or while any arena acquired from it has not been returned.  A registry may
+// be destroyed while threads that have acquired or returned an arena exit.
+// The arenas supplied by the registry are *not* thread-safe: an arena must be
+// used by at most one thread at a time.  The underlying allocator need not be
+// thread-safe; accesses to it are serialized by the registry.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocating the Memory of Each Request from a Warm Arena
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that the worker threads of a server process requests, each request
+// building short-lived data structures that are discarded when it completes.
+// We supply the memory of each request from an arena acquired from a registry
+// shared by all workers, which a worker reuses across the requests it
+// processes.
+//
+// First, we define the function processing a request, which acquires an arena
+// for the duration of the request:
+//..
+//  int processRequest(bdlma::ArenaRegistry *registry, int numFields)
+//      // Process a request having the specified 'numFields' fields, using
+//      // memory supplied by an arena acquired from the specified 'registry',
+//      // and return the total length of the fields.
+//  {
+//      bdlma::ArenaGuard arena(registry);
+//
+//      bsl::vector<bsl::string> fields(arena.allocator());
+//      for (int i = 0; i < numFields; ++i) {
+//          fields.push_back(bsl::string(100, 'x', arena.allocator()));
+//      }
+//
+//      int length = 0;
+//      for (int i = 0; i < numFields; ++i) {
+//          length += static_cast<int>(fields[i].length());
+//      }
+//      return length;
+//  }
+//..
+// Note that the objects allocated from the arena must be destroyed before
+// the arena is returned to the registry by the destructor of the guard.
+//
+// Then, we create a registry, supplying it a test allocator to observe the
+// memory obtained by the arenas:
+//..
+//  bslma::TestAllocator upstream;
+//  bdlma::ArenaRegistry registry(&upstream);
+//..
+// Next, we process a few requests, which grow the buffer retained by the
+// arena of this thread to the size required by a request:
+//..
+//  for (int i = 0; i < 3; ++i) {
+//      assert(10000 == processRequest(&registry, 100));
+//  }
+//  assert(1 == registry.numArenas());
+//..
+// Now, we process many more requests of the same size, and observe that they
+// obtain no memory from the underlying allocator:
+//..
+//  const bsls::Types::Int64 numAllocations = upstream.numAllocations();
+//
+//  for (int i = 0; i < 1000; ++i) {
+//      assert(10000 == processRequest(&registry, 100));
+//  }
+//  assert(numAllocations == upstream.numAllocations());
+//..
+// Finally, we observe that the arena retains a single internal buffer between
+// requests (as the registry was created with a maximum retained size of 0):
+//..
+//  assert(1 == registry.numCachedArenas());
+//  assert(3 == upstream.numBlocksInUse());  // cache, arena, and buffer
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_SEQUENTIALALLOCATOR
+#include <bdlma_sequentialallocator.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_THREADCACHEREGISTRY
+#include <bdlma_threadcacheregistry.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                            // ===================
+                            // class ArenaRegistry
+                            // ===================
+
+class ArenaRegistry {
+    // This class provides a thread-safe registry supplying sequential
+    // allocators ("arenas") that are rewound and cached by the calling thread
+    // for reuse when returned.  See {Caches and Thread Exit}.
+
+    // PRIVATE TYPES
+    struct Arena : SequentialAllocator {
+        // This 'struct' extends an arena with a link to the next arena cached
+        // by the same thread.
+
+        Arena *d_next_p;  // next arena of cache
+
+        // CREATORS
+        explicit Arena(bslma::Allocator *basicAllocator);
+            // Create an arena obtaining memory from the specified
+            // 'basicAllocator'.
+    };
+
+    struct Cache {
+        // This 'struct' holds the arenas cached by one thread.
+
+        Arena *d_arenas_p;    // cached arenas, most recent first
+        int    d_numArenas;   // number of cached arenas
+    };
+
+    // DATA
+    const bsls::Types::size_type d_maxRetainedSize;  // retained by 'rewind'
+
+    ThreadCacheRegistry          d_caches;           // cache of each thread,
+                                                     // and thread-safe
+                                                     // adapter of the
+                                                     // underlying allocator
+
+    bsls::AtomicInt              d_numArenas;        // number of arenas
+
+    // PRIVATE CLASS METHODS
+    static void releaseCache(void *cache, void *registry);
+        // Destroy the arenas held by the specified 'cache' of the specified
+        // 'registry'.  Note that this method is called on exit of each thread
+        // having a cache.
+
+    // PRIVATE MANIPULATORS
+    void destroyArena(Arena *arena);
+        // Destroy the specified 'arena', releasing its memory.
+
+    Cache *localCache();
+        // Return the address of the cache of the calling thread, creating it
+        // if it does not exist.
+
+  private:
+    // NOT IMPLEMENTED
+    ArenaRegistry(const ArenaRegistry&);
+    ArenaRegistry& operator=(const ArenaRegistry&);
+
+  public:
+    // CREATORS
+    explicit ArenaRegistry(bslma::Allocator *basicAllocator = 0);
+    explicit ArenaRegistry(bsls::Types::size_type  maxRetainedSize,
+                           bslma::Allocator       *basicAllocator = 0);
+        // Create an arena registry.  Optionally specify a 'maxRetainedSize'
+        // (in bytes) bounding the total size of the internal buffers retained
+        // by an arena returned to this registry, its largest buffer included;
+        // the largest buffer is retained even if it exceeds
+        // 'maxRetainedSize' (see 'bdlma::SequentialAllocator::rewind').  If
+        // 'maxRetainedSize' is not specified, 0 is used: each arena retains
+        // only its largest buffer.  Optionally specify a 'basicAllocator'
+        // used to supply memory.  If 'basicAllocator' is 0, the currently
+        // installed default allocator is used.
+
+    ~ArenaRegistry();
+        // Destroy this registry and all of its arenas.  The behavior is
+        // undefined unless all arenas acquired from this registry have been
+        // returned to it, and no other thread is using this registry.
+
+    // MANIPULATORS
+    SequentialAllocator *acquireArena();
+        // Return the address of an arena for the exclusive use of the calling
+        // thread, taken from the cache of the calling thread if it is not
+        // empty, and created otherwise.  The arena must be returned to this
+        // registry by 'releaseArena'.
+
+    void releaseArena(SequentialAllocator *arena);
+        // Rewind the specified 'arena', releasing all memory allocated from
+        // it and retaining its largest internal buffers up to
+        // 'maxRetainedSize()', and add it to the cache of the calling thread.
+        // The behavior is undefined unless 'arena' was acquired from this
+        // registry and has not already been returned to it.
+
+    // ACCESSORS
+    bsls::Types::size_type maxRetainedSize() const;
+        // Return the bound on the total size (in bytes) of the internal
+        // buffers retained by the arenas returned to this registry, their
+        // largest buffer included (which is retained regardless).
+
+    int numArenas() const;
+        // Return the number of arenas of this registry, whether acquired or
+        // cached by any thread.
+
+    int numCachedArenas() const;
+        // Return the number of arenas held by the cache of the calling
+        // thread.
+};
+
+                             // ================
+                             // class ArenaGuard
+                             // ================
+
+class ArenaGuard {
+    // This class implements a guard that acquires an arena from a registry
+    // on construction, and returns it to the registry on destruction.
+
+    // DATA
+    ArenaRegistry       *d_registry_p;  // registry (held, not owned)
+    SequentialAllocator *d_arena_p;     // acquired arena
+
+  private:
+    // NOT IMPLEMENTED
+    ArenaGuard(const ArenaGuard&);
+    ArenaGuard& operator=(const ArenaGuard&);
+
+  public:
+    // CREATORS
+    explicit ArenaGuard(ArenaRegistry *registry);
+        // Create a guard acquiring an arena from the specified 'registry' for
+        // the exclusive use of the calling thread.
+
+    ~ArenaGuard();
+        // Return the arena of this guard to its registry, releasing all memory
+        // allocated from it, and destroy this guard.
+
+    // ACCESSORS
+    SequentialAllocator *allocator() const;
+        // Return the address of the arena of this guard.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                            // -------------------
+                            // class ArenaRegistry
+                            // -------------------
+
+// ACCESSORS
+inline
+bsls::Types::size_type ArenaRegistry::maxRetainedSize() const
+{
+    return d_maxRetainedSize;
+}
+
+inline
+int ArenaRegistry::numArenas() const
+{
+    return d_numArenas;
+}
+
+                             // ----------------
+                             // class ArenaGuard
+                             // ----------------
+
+// CREATORS
+inline
+ArenaGuard::ArenaGuard(ArenaRegistry *registry)
+: d_registry_p(registry)
+, d_arena_p(0)
+{
+    BSLS_ASSERT_SAFE(registry);
+
+    d_arena_p = registry->acquireArena();
+}
+
+inline
+ArenaGuard::~ArenaGuard()
+{
+    d_registry_p->releaseArena(d_arena_p);
+}
+
+// ACCESSORS
+inline
+SequentialAllocator *ArenaGuard::allocator() const
+{
+    return d_arena_p;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
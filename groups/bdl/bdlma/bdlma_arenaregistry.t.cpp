@@ -0,0 +1,939 @@
+// bdlma_arenaregistry.t.cpp                                          -*-C++-*-
+#include <bdlma_arenaregistry.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_threadutil.h>
+
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>     // 'atoi'
+#include <bsl_cstring.h>     // 'memset'
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a thread-safe registry supplying sequential
+// allocators ("arenas") that are cached by the calling thread when returned,
+// and a guard acquiring an arena from a registry.  We verify that arenas are
+// reused by the thread returning them, that nested acquisitions obtain
+// distinct arenas, that returned arenas are rewound retaining the expected
+// internal buffers, that repeated requests reach a steady state obtaining no
+// memory from the underlying allocator, and that all memory is released on
+// thread exit and on destruction of the registry, also when the registry is
+// used concurrently by many threads.
+//-----------------------------------------------------------------------------
+// CLASS 'bdlma::ArenaRegistry'
+//
+// CREATORS
+// [ 2] ArenaRegistry(Allocator *ba = 0);
+// [ 2] ArenaRegistry(size_type maxRetainedSize, Allocator *ba = 0);
+// [ 2] ~ArenaRegistry();
+//
+// MANIPULATORS
+// [ 3] SequentialAllocator *acquireArena();
+// [ 3] void releaseArena(SequentialAllocator *arena);
+//
+// ACCESSORS
+// [ 2] size_type maxRetainedSize() const;
+// [ 3] int numArenas() const;
+// [ 3] int numCachedArenas() const;
+//
+// CLASS 'bdlma::ArenaGuard'
+//
+// CREATORS
+// [ 4] explicit ArenaGuard(ArenaRegistry *registry);
+// [ 4] ~ArenaGuard();
+//
+// ACCESSORS
+// [ 4] SequentialAllocator *allocator() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] THREAD EXIT AND CROSS-THREAD RETURN
+// [ 6] CONCURRENCY
+// [ 7] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::ArenaRegistry   Obj;
+typedef bdlma::ArenaGuard      Guard;
+typedef bsls::Types::size_type size_type;
+
+// ============================================================================
+//                      HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+                            // ==================
+                            // struct RequestArgs
+                            // ==================
+
+struct RequestArgs {
+    // This 'struct' holds the arguments of 'requestThread'.
+
+    Obj *d_registry_p;    // registry under test
+    int  d_numRequests;   // number of requests to process
+    int  d_numBlocks;     // number of blocks allocated by each request
+    int  d_numErrors;     // number of corrupted blocks found
+    int  d_maxArenas;     // maximum number of arenas observed
+};
+
+extern "C" void *requestThread(void *arg)
+    // Process the requests described by the specified 'arg', which must be
+    // the address of a 'RequestArgs' object, each request acquiring an arena
+    // (and, every other request, a nested arena) from the registry,
+    // allocating blocks of varying size from it, each scribbled with a
+    // distinct byte, and verifying the blocks before returning the arena.
+{
+    RequestArgs *args = static_cast<RequestArgs *>(arg);
+
+    void *blocks[64];
+    BSLS_ASSERT(args->d_numBlocks <= 64);
+
+    for (int r = 0; r < args->d_numRequests; ++r) {
+        Guard outer(args->d_registry_p);
+
+        for (int i = 0; i < args->d_numBlocks; ++i) {
+            const size_type size = 1 + (r * 7 + i * 13) % 500;
+
+            blocks[i] = outer.allocator()->allocate(size);
+            memset(blocks[i], i, size);
+        }
+
+        if (r % 2) {
+            Guard inner(args->d_registry_p);
+
+            ASSERT(inner.allocator() != outer.allocator());
+
+            void *block = inner.allocator()->allocate(1000);
+            memset(block, 0xff, 1000);
+        }
+
+        const int numArenas = args->d_registry_p->numArenas();
+        if (numArenas > args->d_maxArenas) {
+            args->d_maxArenas = numArenas;
+        }
+
+        for (int i = 0; i < args->d_numBlocks; ++i) {
+            const size_type    size = 1 + (r * 7 + i * 13) % 500;
+            const char        *p    = static_cast<const char *>(blocks[i]);
+
+            for (size_type j = 0; j < size; ++j) {
+                if (static_cast<char>(i) != p[j]) {
+                    ++args->d_numErrors;
+                    break;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+                            // ==================
+                            // struct ReleaseArgs
+                            // ==================
+
+struct ReleaseArgs {
+    // This 'struct' holds the arguments of 'releaseThread'.
+
+    Obj                        *d_registry_p;      // registry under test
+    bdlma::SequentialAllocator *d_arena_p;         // arena to return
+    int                         d_numCachedArenas; // number of arenas
+                                                   // cached by the thread
+                                                   // after returning
+};
+
+extern "C" void *releaseThread(void *arg)
+    // Return the arena described by the specified 'arg', which must be the
+    // address of a 'ReleaseArgs' object, to the registry, and record the
+    // number of arenas then cached by the calling thread.
+{
+    ReleaseArgs *args = static_cast<ReleaseArgs *>(arg);
+
+    args->d_registry_p->releaseArena(args->d_arena_p);
+    args->d_numCachedArenas = args->d_registry_p->numCachedArenas();
+
+    return 0;
+}
+
+extern "C" void *acquireThread(void *arg)
+    // Acquire, then return, an arena from the registry at the specified
+    // 'arg', allocating a block from it, so that the calling thread caches an
+    // arena on exit.
+{
+    Obj *registry = static_cast<Obj *>(arg);
+
+    Guard guard(registry);
+    guard.allocator()->allocate(100);
+
+    return 0;
+}
+
+                          // =====================
+                          // function perRequest...
+                          // =====================
+
+int perRequestAllocator(int numFields)
+    // Process a request having the specified 'numFields' fields using a
+    // sequential allocator created for the request, and return the total
+    // length of the fields.
+{
+    bdlma::SequentialAllocator arena;
+
+    bsl::vector<bsl::string> fields(&arena);
+    for (int i = 0; i < numFields; ++i) {
+        fields.push_back(bsl::string(100, 'x', &arena));
+    }
+
+    int length = 0;
+    for (int i = 0; i < numFields; ++i) {
+        length += static_cast<int>(fields[i].length());
+    }
+    return length;
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocating the Memory of Each Request from a Warm Arena
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that the worker threads of a server process requests, each request
+// building short-lived data structures that are discarded when it completes.
+// We supply the memory of each request from an arena acquired from a registry
+// shared by all workers, which a worker reuses across the requests it
+// processes.
+//
+// First, we define the function processing a request, which acquires an arena
+// for the duration of the request:
+//..
+int processRequest(bdlma::ArenaRegistry *registry, int numFields)
+    // Process a request having the specified 'numFields' fields, using
+    // memory supplied by an arena acquired from the specified 'registry',
+    // and return the total length of the fields.
+{
+    bdlma::ArenaGuard arena(registry);
+
+    bsl::vector<bsl::string> fields(arena.allocator());
+    for (int i = 0; i < numFields; ++i) {
+        fields.push_back(bsl::string(100, 'x', arena.allocator()));
+    }
+
+    int length = 0;
+    for (int i = 0; i < numFields; ++i) {
+        length += static_cast<int>(fields[i].length());
+    }
+    return length;
+}
+//..
+// Note that the objects allocated from the arena must be destroyed before
+// the arena is returned to the registry by the destructor of the guard.
+//
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int  test            = argc > 1 ? atoi(argv[1]) : 0;
+    const bool verbose         = argc > 2;
+    const bool veryVerbose     = argc > 3;
+    const bool veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator da("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we create a registry, supplying it a test allocator to observe the
+// memory obtained by the arenas:
+//..
+    bslma::TestAllocator upstream;
+    bdlma::ArenaRegistry registry(&upstream);
+//..
+// Next, we process a few requests, which grow the buffer retained by the
+// arena of this thread to the size required by a request:
+//..
+    for (int i = 0; i < 3; ++i) {
+        ASSERT(10000 == processRequest(&registry, 100));
+    }
+    ASSERT(1 == registry.numArenas());
+//..
+// Now, we process many more requests of the same size, and observe that they
+// obtain no memory from the underlying allocator:
+//..
+    const bsls::Types::Int64 numAllocations = upstream.numAllocations();
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT(10000 == processRequest(&registry, 100));
+    }
+    ASSERT(numAllocations == upstream.numAllocations());
+//..
+// Finally, we observe that the arena retains a single internal buffer between
+// requests (as the registry was created with a maximum retained size of 0):
+//..
+    ASSERT(1 == registry.numCachedArenas());
+    ASSERT(3 == upstream.numBlocksInUse());  // cache, arena, and buffer
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY
+        //
+        // Concerns:
+        //: 1 Arenas acquired concurrently by several threads are distinct,
+        //:   and the memory allocated from them does not overlap.
+        //:
+        //: 2 Each thread reuses the arenas it returns, so that the number of
+        //:   arenas does not exceed twice the number of threads.
+        //:
+        //: 3 All arenas are destroyed when the threads exit, and all memory
+        //:   is released when the registry is destroyed.
+        //
+        // Plan:
+        //: 1 Run several threads, each processing many requests acquiring
+        //:   one or two arenas, scribbling and verifying the blocks allocated
+        //:   from them, and tracking the number of arenas.  (C-1..2)
+        //:
+        //: 2 After joining the threads, verify that there are no arenas, and
+        //:   that the test allocator has no blocks in use after the registry
+        //:   is destroyed.  (C-3)
+        //
+        // Testing:
+        //   CONCURRENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY" << endl
+                          << "===========" << endl;
+
+        enum { k_NUM_THREADS = 8 };
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            RequestArgs               args[k_NUM_THREADS];
+            bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                args[i].d_registry_p  = &mX;
+                args[i].d_numRequests = 2000;
+                args[i].d_numBlocks   = 32;
+                args[i].d_numErrors   = 0;
+                args[i].d_maxArenas   = 0;
+
+                ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                      requestThread,
+                                                      &args[i]));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                if (veryVerbose) {
+                    T_ P_(i) P_(args[i].d_numErrors) P(args[i].d_maxArenas)
+                }
+                ASSERTV(i, args[i].d_numErrors, 0 == args[i].d_numErrors);
+                ASSERTV(i,
+                        args[i].d_maxArenas,
+                        args[i].d_maxArenas <= 2 * k_NUM_THREADS);
+            }
+
+            ASSERTV(X.numArenas(), 0 == X.numArenas());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // THREAD EXIT AND CROSS-THREAD RETURN
+        //
+        // Concerns:
+        //: 1 The arenas cached by a thread are destroyed when the thread
+        //:   exits.
+        //:
+        //: 2 An arena acquired by one thread may be returned by another, in
+        //:   whose cache it is then held.
+        //:
+        //: 3 The registry may be destroyed while the calling thread holds
+        //:   arenas in its cache.
+        //
+        // Plan:
+        //: 1 Run a thread acquiring and returning an arena, and verify that
+        //:   there are no arenas after joining it.  (C-1)
+        //:
+        //: 2 Acquire an arena in the main thread, return it from another
+        //:   thread, and verify that the other thread cached it, that the
+        //:   main thread did not, and that it is destroyed when the other
+        //:   thread exits.  (C-2)
+        //:
+        //: 3 Destroy a registry while the main thread caches arenas, and
+        //:   verify that all memory is released.  (C-3)
+        //
+        // Testing:
+        //   THREAD EXIT AND CROSS-THREAD RETURN
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "THREAD EXIT AND CROSS-THREAD RETURN" << endl
+                          << "===================================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        if (verbose) cout << "\nDestroying the cache on thread exit." << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  acquireThread,
+                                                  &mX));
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+            ASSERTV(X.numArenas(), 0 == X.numArenas());
+            ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nReturning an arena from another thread."
+                          << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            bdlma::SequentialAllocator *arena = mX.acquireArena();
+            arena->allocate(100);
+
+            ASSERTV(X.numArenas(), 1 == X.numArenas());
+
+            ReleaseArgs args;
+            args.d_registry_p      = &mX;
+            args.d_arena_p         = arena;
+            args.d_numCachedArenas = -1;
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  releaseThread,
+                                                  &args));
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+            ASSERTV(args.d_numCachedArenas, 1 == args.d_numCachedArenas);
+            ASSERTV(X.numCachedArenas(), 0 == X.numCachedArenas());
+            ASSERTV(X.numArenas(), 0 == X.numArenas());
+
+            // The cache of the main thread, created by 'acquireArena',
+            // remains.
+
+            ASSERTV(ta.numBlocksInUse(), 1 == ta.numBlocksInUse());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nDestroying a registry with cached arenas."
+                          << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            bdlma::SequentialAllocator *a = mX.acquireArena();
+            bdlma::SequentialAllocator *b = mX.acquireArena();
+            a->allocate(100);
+            b->allocate(100);
+            mX.releaseArena(b);
+            mX.releaseArena(a);
+
+            ASSERTV(X.numArenas(), 2 == X.numArenas());
+            ASSERTV(X.numCachedArenas(), 2 == X.numCachedArenas());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // CLASS 'bdlma::ArenaGuard'
+        //
+        // Concerns:
+        //: 1 A guard acquires an arena from the registry on construction, and
+        //:   returns it on destruction.
+        //:
+        //: 2 Nested guards supply distinct arenas.
+        //:
+        //: 3 'allocator' returns the acquired arena.
+        //
+        // Plan:
+        //: 1 Create guards, nested and in sequence, verifying the number of
+        //:   arenas and cached arenas of the registry, and the addresses of
+        //:   the arenas supplied.  (C-1..3)
+        //
+        // Testing:
+        //   explicit ArenaGuard(ArenaRegistry *registry);
+        //   ~ArenaGuard();
+        //   SequentialAllocator *allocator() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CLASS 'bdlma::ArenaGuard'" << endl
+                          << "=========================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            bdlma::SequentialAllocator *first;
+            {
+                Guard outer(&mX);
+
+                first = outer.allocator();
+                ASSERT(first);
+                ASSERTV(X.numArenas(), 1 == X.numArenas());
+                ASSERTV(X.numCachedArenas(), 0 == X.numCachedArenas());
+
+                {
+                    Guard inner(&mX);
+
+                    ASSERT(inner.allocator());
+                    ASSERT(first != inner.allocator());
+                    ASSERTV(X.numArenas(), 2 == X.numArenas());
+
+                    inner.allocator()->allocate(100);
+                }
+                ASSERTV(X.numCachedArenas(), 1 == X.numCachedArenas());
+
+                outer.allocator()->allocate(100);
+            }
+            ASSERTV(X.numArenas(), 2 == X.numArenas());
+            ASSERTV(X.numCachedArenas(), 2 == X.numCachedArenas());
+            {
+                Guard guard(&mX);
+
+                ASSERT(first == guard.allocator());
+                ASSERTV(X.numCachedArenas(), 1 == X.numCachedArenas());
+            }
+            ASSERTV(X.numCachedArenas(), 2 == X.numCachedArenas());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // 'acquireArena' AND 'releaseArena'
+        //
+        // Concerns:
+        //: 1 An arena returned by a thread is supplied again to that thread.
+        //:
+        //: 2 Arenas acquired while others are held are distinct.
+        //:
+        //: 3 'numArenas' and 'numCachedArenas' report the number of arenas
+        //:   and the number of arenas cached by the calling thread.
+        //:
+        //: 4 A returned arena releases the memory allocated from it,
+        //:   retaining its largest internal buffer and further buffers up to
+        //:   the maximum retained size.
+        //:
+        //: 5 Returning an arena from the thread that acquired it obtains no
+        //:   memory.
+        //:
+        //: 6 All memory is released when the registry is destroyed.
+        //
+        // Plan:
+        //: 1 Acquire and return arenas, in sequence and nested, verifying
+        //:   their addresses and the values of the accessors.  (C-1..3)
+        //:
+        //: 2 For registries having a maximum retained size of 0 and of
+        //:   1 MB, allocate many blocks from an arena, return it, and
+        //:   verify the number of blocks in use of the test allocator.
+        //:   Repeat this, verifying that the underlying allocator is no
+        //:   longer used after the first rounds.  (C-4..5)
+        //:
+        //: 3 Verify that the test allocator has no blocks in use after the
+        //:   registry is destroyed.  (C-6)
+        //
+        // Testing:
+        //   SequentialAllocator *acquireArena();
+        //   void releaseArena(SequentialAllocator *arena);
+        //   int numArenas() const;
+        //   int numCachedArenas() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'acquireArena' AND 'releaseArena'" << endl
+                          << "=================================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        if (verbose) cout << "\nReusing and nesting arenas." << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            bdlma::SequentialAllocator *a = mX.acquireArena();
+            ASSERT(a);
+            ASSERTV(X.numArenas(), 1 == X.numArenas());
+            ASSERTV(X.numCachedArenas(), 0 == X.numCachedArenas());
+
+            // Cache and arena.
+
+            ASSERTV(ta.numBlocksInUse(), 2 == ta.numBlocksInUse());
+
+            const bsls::Types::Int64 numAllocations = ta.numAllocations();
+
+            mX.releaseArena(a);
+            ASSERTV(X.numArenas(), 1 == X.numArenas());
+            ASSERTV(X.numCachedArenas(), 1 == X.numCachedArenas());
+            ASSERT(numAllocations == ta.numAllocations());
+
+            bdlma::SequentialAllocator *b = mX.acquireArena();
+            ASSERT(a == b);
+            ASSERTV(X.numCachedArenas(), 0 == X.numCachedArenas());
+
+            bdlma::SequentialAllocator *c = mX.acquireArena();
+            ASSERT(c);
+            ASSERT(b != c);
+            ASSERTV(X.numArenas(), 2 == X.numArenas());
+
+            mX.releaseArena(c);
+            mX.releaseArena(b);
+            ASSERTV(X.numArenas(), 2 == X.numArenas());
+            ASSERTV(X.numCachedArenas(), 2 == X.numCachedArenas());
+
+            // Arenas are supplied most recently returned first.
+
+            ASSERT(b == mX.acquireArena());
+            ASSERT(c == mX.acquireArena());
+            ASSERTV(X.numCachedArenas(), 0 == X.numCachedArenas());
+
+            mX.releaseArena(b);
+            mX.releaseArena(c);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nRetaining memory." << endl;
+        {
+            static const struct {
+                int       d_line;           // source line number
+                size_type d_maxRetained;    // maximum retained size
+                int       d_minBlocks;      // minimum blocks retained
+                int       d_maxBlocks;      // maximum blocks retained
+            } DATA[] = {
+                //LINE  MAX RETAINED  MIN  MAX
+                //----  ------------  ---  ---
+                { L_,             0,    1,   1 },
+                { L_,       1 << 20,    8, 100 },
+            };
+            const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int       LINE = DATA[ti].d_line;
+                const size_type MAX  = DATA[ti].d_maxRetained;
+                const int       MINB = DATA[ti].d_minBlocks;
+                const int       MAXB = DATA[ti].d_maxBlocks;
+
+                Obj mX(MAX, &ta);  const Obj& X = mX;
+
+                ASSERTV(LINE, MAX == X.maxRetainedSize());
+
+                for (int round = 0; round < 4; ++round) {
+                    const bsls::Types::Int64 numAllocations =
+                                                          ta.numAllocations();
+
+                    bdlma::SequentialAllocator *arena = mX.acquireArena();
+                    for (int i = 0; i < 1000; ++i) {
+                        arena->allocate(64);
+                    }
+                    mX.releaseArena(arena);
+
+                    // Exclude the cache and the arena itself.
+
+                    const int numBuffers =
+                               static_cast<int>(ta.numBlocksInUse()) - 2;
+
+                    if (veryVerbose) {
+                        T_ P_(LINE) P_(round) P(numBuffers)
+                    }
+                    ASSERTV(LINE, round, numBuffers, MINB <= numBuffers);
+                    ASSERTV(LINE, round, numBuffers, numBuffers <= MAXB);
+
+                    if (2 <= round) {
+                        // Once the retained buffer has grown to the size
+                        // required, it satisfies all allocations.
+
+                        ASSERTV(LINE,
+                                round,
+                                numAllocations == ta.numAllocations());
+                    }
+                }
+            }
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A registry created without a maximum retained size has a
+        //:   maximum retained size of 0, and otherwise has the value
+        //:   specified.
+        //:
+        //: 2 A newly created registry has no arenas.
+        //:
+        //: 3 The registry uses the allocator supplied at construction, or
+        //:   the default allocator if none is supplied, and allocates no
+        //:   memory until an arena is acquired.
+        //
+        // Plan:
+        //: 1 Create registries using each constructor, with and without an
+        //:   allocator, and verify the values of the accessors and the use
+        //:   of the test allocators.  (C-1..3)
+        //
+        // Testing:
+        //   ArenaRegistry(Allocator *ba = 0);
+        //   ArenaRegistry(size_type maxRetainedSize, Allocator *ba = 0);
+        //   ~ArenaRegistry();
+        //   size_type maxRetainedSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CREATORS AND BASIC ACCESSORS" << endl
+                          << "============================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERTV(X.maxRetainedSize(), 0 == X.maxRetainedSize());
+            ASSERTV(X.numArenas(),       0 == X.numArenas());
+            ASSERTV(X.numCachedArenas(), 0 == X.numCachedArenas());
+            ASSERTV(ta.numBlocksTotal(), 0 == ta.numBlocksTotal());
+        }
+        {
+            Obj mX(4096, &ta);  const Obj& X = mX;
+
+            ASSERTV(X.maxRetainedSize(), 4096 == X.maxRetainedSize());
+            ASSERTV(X.numArenas(),       0 == X.numArenas());
+            ASSERTV(X.numCachedArenas(), 0 == X.numCachedArenas());
+            ASSERTV(ta.numBlocksTotal(), 0 == ta.numBlocksTotal());
+        }
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERTV(X.maxRetainedSize(), 0 == X.maxRetainedSize());
+
+            mX.releaseArena(mX.acquireArena());
+
+            ASSERTV(da.numBlocksInUse(), 0 < da.numBlocksInUse());
+        }
+        ASSERTV(da.numBlocksInUse(), 0 == da.numBlocksInUse());
+        ASSERTV(ta.numBlocksTotal(), 0 == ta.numBlocksTotal());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Acquire arenas from a registry, allocate from them, and return
+        //:   them.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        {
+            Obj mX(&ta);
+
+            for (int i = 0; i < 10; ++i) {
+                Guard guard(&mX);
+
+                bsl::vector<int> v(guard.allocator());
+                for (int j = 0; j < 1000; ++j) {
+                    v.push_back(j);
+                }
+                ASSERT(1000 == v.size());
+            }
+            ASSERTV(mX.numArenas(), 1 == mX.numArenas());
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //   Compare the time taken to process requests using a sequential
+        //   allocator created for each request with that using an arena
+        //   acquired from a registry.
+        //
+        //   Usage: <driver> -1 [numRequests]
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST" << endl
+                          << "================" << endl;
+
+        const int NUM_REQUESTS = argc > 2 ? atoi(argv[2]) : 100000;
+
+        bslma::Allocator *na = bslma::NewDeleteAllocator::allocator(0);
+        bslma::DefaultAllocatorGuard nag(na);
+
+        const int FIELDS[] = { 1, 10, 100, 1000 };
+
+        printf("%8s %14s %14s\n", "fields", "per-request", "registry");
+
+        for (int fi = 0; fi < 4; ++fi) {
+            const int NUM_FIELDS = FIELDS[fi];
+            const int N          = NUM_REQUESTS / NUM_FIELDS + 1;
+
+            double times[2];
+
+            bsls::Stopwatch timer;
+            int             length = 0;
+
+            timer.start(true);
+            for (int i = 0; i < N; ++i) {
+                length += perRequestAllocator(NUM_FIELDS);
+            }
+            timer.stop();
+            times[0] = timer.accumulatedWallTime();
+
+            Obj registry(na);
+
+            timer.reset();
+            timer.start(true);
+            for (int i = 0; i < N; ++i) {
+                length -= processRequest(&registry, NUM_FIELDS);
+            }
+            timer.stop();
+            times[1] = timer.accumulatedWallTime();
+
+            ASSERT(0 == length);
+
+            // Report nanoseconds per request.
+
+            printf("%8d %14.0f %14.0f\n",
+                   NUM_FIELDS,
+                   times[0] / N * 1e9,
+                   times[1] / N * 1e9);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,365 @@
+// bdlma_hugepageallocator.cpp                                        -*-C++-*-
+#include <bdlma_hugepageallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_hugepageallocator_cpp,"$Id$ $CSID$")
+
+#include <bslma_default.h>
+
+#include <bslmt_lockguard.h>
+
+#include <bsls_assert.h>
+#include <bsls_exceptionutil.h>      // 'BSLS_THROW'
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+
+#include <bsl_new.h>                 // 'bsl::bad_alloc'
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+#include <sys/mman.h>                // 'mmap', 'munmap', 'madvise'
+
+#endif
+
+namespace BloombergLP {
+namespace {
+
+typedef bsls::Types::size_type size_type;
+
+enum Source {
+    // Enumerate the sources of regions.
+
+    e_HUGETLB,      // mapped from explicitly reserved huge pages
+    e_TRANSPARENT,  // mapped from ordinary memory, advised to use huge pages
+    e_ALLOCATOR     // obtained from the underlying allocator
+};
+
+const size_type k_2MB = static_cast<size_type>(1) << 21;
+const size_type k_1GB = static_cast<size_type>(1) << 30;
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+const int k_MAP_HUGE_SHIFT = 26;  // 'MAP_HUGE_SHIFT' of '<linux/mman.h>'
+
+void *mapHugeTlb(size_type size, size_type pageSize)
+    // Map the specified 'size' bytes from the explicitly reserved huge pages
+    // of the specified 'pageSize', and return their address, or 0 if the
+    // mapping fails.  The behavior is undefined unless 'size' is a multiple of
+    // 'pageSize'.
+{
+#ifdef MAP_HUGETLB
+
+    const int log2PageSize = k_1GB == pageSize ? 30 : 21;
+
+    void *address = mmap(0,
+                         size,
+                         PROT_READ | PROT_WRITE,
+                         MAP_ANONYMOUS | MAP_PRIVATE | MAP_HUGETLB
+                                          | log2PageSize << k_MAP_HUGE_SHIFT,
+                         -1,
+                         0);
+
+    return MAP_FAILED == address ? 0 : address;
+
+#else
+
+    (void)size;
+    (void)pageSize;
+    return 0;
+
+#endif
+}
+
+void *mapTransparent(size_type size)
+    // Map the specified 'size' bytes of ordinary memory aligned on a 2 MB
+    // boundary, advise the kernel to back them by transparent huge pages, and
+    // return their address, or 0 if the mapping fails.  The behavior is
+    // undefined unless 'size' is a multiple of 2 MB.
+{
+    // Map an extra 2 MB, and unmap the unaligned excess at both ends.
+
+    char *address = static_cast<char *>(mmap(0,
+                                             size + k_2MB,
+                                             PROT_READ | PROT_WRITE,
+                                             MAP_ANONYMOUS | MAP_PRIVATE,
+                                             -1,
+                                             0));
+    if (MAP_FAILED == static_cast<void *>(address)) {
+        return 0;                                                     // RETURN
+    }
+
+    const size_type offset =
+                reinterpret_cast<bsls::Types::UintPtr>(address) & (k_2MB - 1);
+    char *aligned = offset ? address + (k_2MB - offset) : address;
+
+    if (aligned != address) {
+        munmap(address, aligned - address);
+    }
+    if (aligned + size != address + size + k_2MB) {
+        munmap(aligned + size, address + size + k_2MB - (aligned + size));
+    }
+
+#ifdef MADV_HUGEPAGE
+
+    madvise(aligned, size, MADV_HUGEPAGE);
+
+#endif
+
+    return aligned;
+}
+
+#endif
+
+}  // close unnamed namespace
+
+namespace bdlma {
+
+                          // -----------------------
+                          // class HugePageAllocator
+                          // -----------------------
+
+// PRIVATE MANIPULATORS
+HugePageAllocator::Region *HugePageAllocator::allocateRegion(size_type size)
+{
+    BSLS_ASSERT(0 == size % d_pageSize);
+
+    void *address = 0;
+    int   source  = e_ALLOCATOR;
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+    if (e_EXPLICIT_OR_TRANSPARENT == d_policy) {
+        address = mapHugeTlb(size, d_pageSize);
+        source  = e_HUGETLB;
+    }
+    if (!address) {
+        address = mapTransparent(size);
+        source  = e_TRANSPARENT;
+    }
+    if (!address) {
+        BSLS_THROW(bsl::bad_alloc());
+    }
+
+#else
+
+    address = d_allocator_p->allocate(size);
+
+#endif
+
+    Region *region = static_cast<Region *>(address);
+
+    region->d_region.d_next_p    = d_regions_p;
+    region->d_region.d_prev_p    = 0;
+    region->d_region.d_size      = size;
+    region->d_region.d_numBlocks = 0;
+    region->d_region.d_source    = source;
+
+    if (d_regions_p) {
+        d_regions_p->d_region.d_prev_p = region;
+    }
+    d_regions_p = region;
+
+    ++d_numRegions;
+    d_numBytes += size;
+    if (e_HUGETLB == source) {
+        d_numHugeTlbBytes += size;
+    }
+
+    return region;
+}
+
+void HugePageAllocator::releaseRegion(Region *region)
+{
+    BSLS_ASSERT(region);
+
+    if (region->d_region.d_prev_p) {
+        region->d_region.d_prev_p->d_region.d_next_p =
+                                                    region->d_region.d_next_p;
+    }
+    else {
+        d_regions_p = region->d_region.d_next_p;
+    }
+    if (region->d_region.d_next_p) {
+        region->d_region.d_next_p->d_region.d_prev_p =
+                                                    region->d_region.d_prev_p;
+    }
+
+    const size_type size   = region->d_region.d_size;
+    const int       source = region->d_region.d_source;
+
+    --d_numRegions;
+    d_numBytes -= size;
+    if (e_HUGETLB == source) {
+        d_numHugeTlbBytes -= size;
+    }
+
+    if (e_ALLOCATOR == source) {
+        d_allocator_p->deallocate(region);
+    }
+    else {
+#ifdef BSLS_PLATFORM_OS_LINUX
+        munmap(reinterpret_cast<char *>(region), size);
+#endif
+    }
+}
+
+// CREATORS
+HugePageAllocator::HugePageAllocator(bslma::Allocator *basicAllocator)
+: d_pageSize(k_2MB)
+, d_policy(e_EXPLICIT_OR_TRANSPARENT)
+, d_regions_p(0)
+, d_current_p(0)
+, d_cursor_p(0)
+, d_end_p(0)
+, d_numRegions(0)
+, d_numBytes(0)
+, d_numHugeTlbBytes(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+HugePageAllocator::HugePageAllocator(PageSize          pageSize,
+                                     PagePolicy        policy,
+                                     bslma::Allocator *basicAllocator)
+: d_pageSize(e_PAGE_1GB == pageSize ? k_1GB : k_2MB)
+, d_policy(policy)
+, d_regions_p(0)
+, d_current_p(0)
+, d_cursor_p(0)
+, d_end_p(0)
+, d_numRegions(0)
+, d_numBytes(0)
+, d_numHugeTlbBytes(0)
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+HugePageAllocator::~HugePageAllocator()
+{
+    while (d_regions_p) {
+        releaseRegion(d_regions_p);
+    }
+}
+
+// MANIPULATORS
+void *HugePageAllocator::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return 0;                                                     // RETURN
+    }
+
+    const size_type blockSize =
+                          bsls::AlignmentUtil::roundUpToMaximalAlignment(size)
+                        + sizeof(Header);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    Region *region;
+    Header *header;
+
+    if (blockSize > d_pageSize - sizeof(Region)) {
+        // The block does not fit in a page: supply it from a region of its
+        // own.
+
+        const size_type regionSize =
+                     (blockSize + sizeof(Region) + d_pageSize - 1)
+                                                   / d_pageSize * d_pageSize;
+
+        region = allocateRegion(regionSize);
+        header = reinterpret_cast<Header *>(region + 1);
+    }
+    else {
+        if (blockSize > static_cast<size_type>(d_end_p - d_cursor_p)) {
+            // Note that the previous current region (if any) supplies at
+            // least one outstanding block, as its cursor would otherwise have
+            // been reset by 'deallocate'; it is released when its last block
+            // is deallocated.
+
+            d_current_p = allocateRegion(d_pageSize);
+            d_cursor_p  = reinterpret_cast<char *>(d_current_p + 1);
+            d_end_p     = reinterpret_cast<char *>(d_current_p) + d_pageSize;
+        }
+
+        region      = d_current_p;
+        header      = reinterpret_cast<Header *>(d_cursor_p);
+        d_cursor_p += blockSize;
+    }
+
+    ++region->d_region.d_numBlocks;
+    header->d_region_p = region;
+
+    return header + 1;
+}
+
+void HugePageAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return;                                                       // RETURN
+    }
+
+    Header *header = static_cast<Header *>(address) - 1;
+    Region *region = header->d_region_p;
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    BSLS_ASSERT(0 < region->d_region.d_numBlocks);
+
+    if (0 == --region->d_region.d_numBlocks) {
+        if (region == d_current_p) {
+            d_cursor_p = reinterpret_cast<char *>(d_current_p + 1);
+        }
+        else {
+            releaseRegion(region);
+        }
+    }
+}
+
+// ACCESSORS
+bsls::Types::Int64 HugePageAllocator::numBytesInHugeTlbRegions() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_numHugeTlbBytes;
+}
+
+bsls::Types::Int64 HugePageAllocator::numBytesInRegions() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_numBytes;
+}
+
+int HugePageAllocator::numRegions() const
+{
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    return d_numRegions;
+}
+
+HugePageAllocator::size_type HugePageAllocator::pageSize() const
+{
+    return d_pageSize;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,329 @@
+// bdlma_hugepageallocator.h                                          -*-C++-*-
+#ifndef INCLUDED_BDLMA_HUGEPAGEALLOCATOR
+#define INCLUDED_BDLMA_HUGEPAGEALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an allocator supplying memory backed by huge pages.
+//
+//@CLASSES:
+//  bdlma::HugePageAllocator: allocator carving blocks from huge pages
+//
+//@SEE_ALSO: bdlma_sequentialallocator, bdlma_pool, bdlma_multipool
+//
+//@DESCRIPTION: This component provides a thread-safe allocator,
+// 'bdlma::HugePageAllocator', implementing the 'bslma::Allocator' protocol,
+// that supplies memory from regions backed by huge pages (2 MB, or optionally
+// 1 GB, on x86-64) rather than by the base pages (typically 4 KB) of the
+// operating system.  Accessing a large data structure backed by base pages
+// incurs frequent misses of the translation lookaside buffer (TLB) of the
+// processor, each costing a walk of the page tables; huge pages reduce the
+// number of TLB entries needed to map the same memory by a factor of 512 (or
+// more).
+//
+// The allocator is intended to be used as the underlying allocator of the
+// pools and sequential allocators of 'bdlma' (e.g., 'bdlma::Pool',
+// 'bdlma::Multipool', 'bdlma::SequentialAllocator'), which request memory in
+// chunks that they subdivide themselves, so that the data structures built by
+// those allocators are backed by huge pages.
+//..
+//  ,------------------------.
+// ( bdlma::HugePageAllocator )
+//  `------------------------'
+//               |         ctor/dtor
+//               |         numBytesInHugeTlbRegions
+//               |         numBytesInRegions
+//               |         numRegions
+//               |         pageSize
+//               V
+//       ,----------------.
+//      ( bslma::Allocator )
+//       `----------------'
+//                       allocate
+//                       deallocate
+//..
+//
+///Regions
+///-------
+// Memory is obtained from the operating system in "regions" whose size is a
+// multiple of 'pageSize()'.  Blocks that fit in a single huge page are carved
+// sequentially from the current region; when a block does not fit in the
+// remainder of the current region, a new region of one page becomes current.
+// Each larger block is supplied by a region of its own.  The number of blocks
+// supplied by each region is counted, and a region is released when all of
+// its blocks have been deallocated (the current region is then reused from
+// its beginning instead).  Note that deallocating some, but not all, of the
+// blocks of a region does not make their memory available for reuse: the
+// allocator is designed for the large, long-lived chunks requested by pools,
+// not for general-purpose allocation of small blocks.
+//
+// On Linux, each region is obtained as follows:
+//
+//: 1 Unless 'e_TRANSPARENT_ONLY' is specified at construction, the region is
+//:   mapped from the pool of explicitly reserved huge pages of the requested
+//:   size (the 'MAP_HUGETLB' flag of 'mmap').  This requires huge pages to
+//:   have been reserved by the administrator (e.g., in
+//:   '/proc/sys/vm/nr_hugepages'), and fails otherwise.
+//:
+//: 2 Otherwise, the region is mapped from ordinary memory, aligned on a 2 MB
+//:   boundary, and advised to be backed by transparent huge pages
+//:   ('madvise(MADV_HUGEPAGE)'), which the kernel honors when its transparent
+//:   huge page support is enabled in "always" or "madvise" mode (see
+//:   '/sys/kernel/mm/transparent_hugepage/enabled').  Transparent huge pages
+//:   are always 2 MB.
+//
+// On other platforms, regions are obtained from the underlying allocator
+// supplied at construction, without any huge page support.
+//
+///Thread Safety
+///-------------
+// 'bdlma::HugePageAllocator' is *fully thread-safe*, meaning any operation on
+// the same object can be safely invoked from any thread.  The underlying
+// allocator need not be thread-safe.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Backing a Large Pool with Huge Pages
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we maintain a large in-memory table of orders, accessed in
+// random order, whose nodes are allocated from a 'bdlma::Pool'.  To reduce the
+// TLB misses incurred by accesses to the table, we supply the chunks of the
+// pool from huge pages.
+//
+// First, we define the type of the nodes of the table:
+//..
+//  struct OrderNode {
+//      OrderNode          *d_next_p;
+//      bsls::Types::Int64  d_orderId;
+//      double              d_price;
+//      int                 d_quantity;
+//  };
+//..
+// Then, we create a huge page allocator, and a pool using it:
+//..
+//  bdlma::HugePageAllocator hugePages;
+//  bdlma::Pool              pool(sizeof(OrderNode),
+//                                bsls::BlockGrowth::BSLS_GEOMETRIC,
+//                                1024,
+//                                &hugePages);
+//..
+// Next, we create some nodes:
+//..
+//  OrderNode *head = 0;
+//  for (int i = 0; i < 10000; ++i) {
+//      OrderNode *node = static_cast<OrderNode *>(pool.allocate());
+//
+//      node->d_next_p   = head;
+//      node->d_orderId  = i;
+//      node->d_price    = 100.0;
+//      node->d_quantity = 10;
+//
+//      head = node;
+//  }
+//..
+// Now, we observe that the chunks of the pool have been supplied by a single
+// region of huge pages:
+//..
+//  assert(1 == hugePages.numRegions());
+//..
+// Finally, we release the nodes, which returns the chunks of the pool to the
+// huge page allocator.  The single region that supplied them, being the
+// current region, is retained for reuse until the huge page allocator is
+// destroyed:
+//..
+//  pool.release();
+//
+//  assert(1 == hugePages.numRegions());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_MUTEX
+#include <bslmt_mutex.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                          // =======================
+                          // class HugePageAllocator
+                          // =======================
+
+class HugePageAllocator : public bslma::Allocator {
+    // This class implements the 'bslma::Allocator' protocol to provide a
+    // thread-safe allocator that supplies memory from regions backed by huge
+    // pages.  See {Regions}.
+
+  public:
+    // TYPES
+    enum PageSize {
+        // Enumerate the sizes of huge pages.
+
+        e_PAGE_2MB,  // 2 MB pages
+        e_PAGE_1GB   // 1 GB pages
+    };
+
+    enum PagePolicy {
+        // Enumerate the ways of obtaining huge pages.
+
+        e_EXPLICIT_OR_TRANSPARENT,  // reserved huge pages, or else
+                                    // transparent huge pages
+
+        e_TRANSPARENT_ONLY          // transparent huge pages
+    };
+
+  private:
+    // PRIVATE TYPES
+    union Region {
+        // This 'union' provides the header of each region.
+
+        struct {
+            Region    *d_next_p;     // next region
+            Region    *d_prev_p;     // previous region
+            size_type  d_size;       // size of region, including header
+            int        d_numBlocks;  // number of outstanding blocks
+            int        d_source;     // how the region was obtained
+        } d_region;
+        bsls::AlignmentUtil::MaxAlignedType d_dummy;  // force alignment
+    };
+
+    union Header {
+        // This 'union' provides the header of each block.
+
+        Region                              *d_region_p;  // region of block
+        bsls::AlignmentUtil::MaxAlignedType  d_dummy;     // force alignment
+    };
+
+    // DATA
+    size_type                   d_pageSize;          // size of huge pages
+
+    PagePolicy                  d_policy;            // how to obtain pages
+
+    mutable bslmt::Mutex        d_mutex;             // serializes all
+                                                     // operations
+
+    Region                     *d_regions_p;         // list of regions
+
+    Region                     *d_current_p;         // region from which
+                                                     // small blocks are
+                                                     // carved, or 0
+
+    char                       *d_cursor_p;          // next free byte of
+                                                     // 'd_current_p'
+
+    char                       *d_end_p;             // end of 'd_current_p'
+
+    int                         d_numRegions;        // number of regions
+
+    bsls::Types::Int64          d_numBytes;          // bytes in regions
+
+    bsls::Types::Int64          d_numHugeTlbBytes;   // bytes in regions of
+                                                     // reserved huge pages
+
+    bslma::Allocator           *d_allocator_p;       // underlying allocator
+                                                     // (held, not owned)
+
+    // PRIVATE MANIPULATORS
+    Region *allocateRegion(size_type size);
+        // Obtain a region of the specified 'size' bytes, add it to the list of
+        // regions, and return its address.  The behavior is undefined unless
+        // 'size' is a multiple of 'd_pageSize'.
+
+    void releaseRegion(Region *region);
+        // Remove the specified 'region' from the list of regions, and return
+        // its memory to the source from which it was obtained.
+
+  private:
+    // NOT IMPLEMENTED
+    HugePageAllocator(const HugePageAllocator&);
+    HugePageAllocator& operator=(const HugePageAllocator&);
+
+  public:
+    // CREATORS
+    explicit HugePageAllocator(bslma::Allocator *basicAllocator = 0);
+    explicit HugePageAllocator(
+                          PageSize          pageSize,
+                          PagePolicy        policy = e_EXPLICIT_OR_TRANSPARENT,
+                          bslma::Allocator *basicAllocator = 0);
+        // Create a huge page allocator.  Optionally specify a 'pageSize'
+        // indicating the size of the huge pages to use.  If 'pageSize' is not
+        // specified, 2 MB pages are used.  Optionally specify a 'policy'
+        // indicating how huge pages are obtained.  If 'policy' is not
+        // specified, explicitly reserved huge pages are used if available,
+        // and transparent huge pages otherwise.  Optionally specify a
+        // 'basicAllocator' used to supply memory on platforms without huge
+        // page support.  If 'basicAllocator' is 0, the currently installed
+        // default allocator is used.  See {Regions}.
+
+    virtual ~HugePageAllocator();
+        // Destroy this allocator, releasing all memory allocated through it.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return the address of a contiguous block of maximally-aligned memory
+        // of (at least) the specified 'size' (in bytes), supplied by a region
+        // of huge pages.  If 'size' is 0, no memory is allocated and 0 is
+        // returned.  Throw 'bsl::bad_alloc' if no region can be obtained.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' to this
+        // allocator, releasing its region if it supplies no other outstanding
+        // block.  If 'address' is 0, this function has no effect.  The
+        // behavior is undefined unless 'address' was allocated using this
+        // allocator object and has not already been deallocated.
+
+    // ACCESSORS
+    bsls::Types::Int64 numBytesInHugeTlbRegions() const;
+        // Return the number of bytes in the regions of this allocator mapped
+        // from explicitly reserved huge pages.
+
+    bsls::Types::Int64 numBytesInRegions() const;
+        // Return the number of bytes in the regions of this allocator.
+
+    int numRegions() const;
+        // Return the number of regions of this allocator.
+
+    size_type pageSize() const;
+        // Return the size (in bytes) of the huge pages requested by this
+        // allocator.
+};
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
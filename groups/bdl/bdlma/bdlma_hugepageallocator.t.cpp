@@ -0,0 +1,1031 @@
+// bdlma_hugepageallocator.t.cpp                                      -*-C++-*-
+#include <bdlma_hugepageallocator.h>
+
+#include <bdlma_multipool.h>                // for testing only
+#include <bdlma_pool.h>                     // for testing only
+#include <bdlma_sequentialallocator.h>      // for testing only
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_blockgrowth.h>
+#include <bsls_platform.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>     // 'atoi'
+#include <bsl_cstring.h>     // 'memset'
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a thread-safe allocator supplying blocks from
+// regions of huge pages.  Whether the kernel actually backs a region by huge
+// pages depends on the configuration of the machine, and cannot be relied
+// upon by this test driver, so we verify that the allocator dispenses
+// maximally-aligned, non-overlapping blocks of at least the requested size,
+// carved from regions whose sizes are multiples of the page size, that
+// regions are created, reused, and released as documented, and that all
+// regions are released on destruction, also when the allocator is used
+// concurrently by many threads and as the underlying allocator of the pools
+// of 'bdlma'.  On Linux, we also verify that the regions are mapped directly
+// from the operating system (the underlying allocator being unused), and, on
+// other platforms, that they are obtained from the underlying allocator.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] HugePageAllocator(Allocator *ba = 0);
+// [ 2] HugePageAllocator(PageSize, PagePolicy = e_EXP..., Allocator *ba = 0);
+// [ 2] ~HugePageAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+//
+// ACCESSORS
+// [ 2] bsls::Types::Int64 numBytesInHugeTlbRegions() const;
+// [ 2] bsls::Types::Int64 numBytesInRegions() const;
+// [ 2] int numRegions() const;
+// [ 2] size_type pageSize() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] UNDERLYING ALLOCATOR OF POOLS
+// [ 5] CONCURRENCY
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::HugePageAllocator Obj;
+typedef bsls::Types::size_type   size_type;
+typedef bsls::Types::Int64       Int64;
+
+const int       MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+const size_type PAGE_2MB  = static_cast<size_type>(1) << 21;
+const size_type PAGE_1GB  = static_cast<size_type>(1) << 30;
+
+// ============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+bool isMaxAligned(const void *address)
+    // Return 'true' if the specified 'address' is maximally aligned, and
+    // 'false' otherwise.
+{
+    return 0 == reinterpret_cast<bsls::Types::UintPtr>(address) % MAX_ALIGN;
+}
+
+size_type offsetInPage(const void *address, size_type pageSize)
+    // Return the offset of the specified 'address' from the beginning of the
+    // (aligned) page of the specified 'pageSize' containing it.
+{
+    return reinterpret_cast<bsls::Types::UintPtr>(address) % pageSize;
+}
+
+void scribble(void *address, size_type size, int value)
+    // Assign the low-order byte of the specified 'value' to each of the
+    // specified 'size' bytes starting at the specified 'address'.
+{
+    bsl::memset(address, value, size);
+}
+
+bool isScribbled(const void *address, size_type size, int value)
+    // Return 'true' if each of the specified 'size' bytes starting at the
+    // specified 'address' has the low-order byte of the specified 'value',
+    // and 'false' otherwise.
+{
+    const unsigned char *p = static_cast<const unsigned char *>(address);
+    for (size_type i = 0; i < size; ++i) {
+        if (static_cast<unsigned char>(value) != p[i]) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+                             // =================
+                             // struct StressArgs
+                             // =================
+
+struct StressArgs {
+    // This 'struct' holds the arguments of 'stressThread'.
+
+    Obj *d_allocator_p;  // allocator under test
+    int  d_index;        // index of this thread
+    int  d_numSlots;     // number of blocks held at once
+    int  d_numRounds;    // number of rounds
+    int  d_numErrors;    // number of corrupted blocks found
+};
+
+size_type stressSize(int thread, int slot, int round)
+    // Return the size of the block allocated by the specified 'thread' in the
+    // specified 'slot' during the specified 'round'.  Every 64th block is
+    // larger than a 2 MB page.
+{
+    const int n = thread * 7 + slot * 13 + round * 29;
+
+    return 0 == n % 64 ? PAGE_2MB + n % 1000 : 1 + n % 20000;
+}
+
+extern "C" void *stressThread(void *arg)
+    // In each round, allocate a block of varying size (scribbled with the
+    // index of this thread) for each of the slots of this thread, then verify
+    // and deallocate them, in an order differing from that of allocation.  The
+    // specified 'arg' must be the address of a 'StressArgs' object.
+{
+    StressArgs *args = static_cast<StressArgs *>(arg);
+    Obj        *mX   = args->d_allocator_p;
+
+    const int N = args->d_numSlots;
+
+    bsl::vector<void *> slots(N,
+                              static_cast<void *>(0),
+                              bslma::NewDeleteAllocator::allocator(0));
+
+    for (int round = 0; round < args->d_numRounds; ++round) {
+        for (int i = 0; i < N; ++i) {
+            const size_type SIZE = stressSize(args->d_index, i, round);
+
+            slots[i] = mX->allocate(SIZE);
+            scribble(slots[i], SIZE, args->d_index);
+        }
+        for (int j = 0; j < N; ++j) {
+            const int       i    = (j * 7 + round) % N;
+            const size_type SIZE = stressSize(args->d_index, i, round);
+
+            if (!isMaxAligned(slots[i])
+             || !isScribbled(slots[i], SIZE, args->d_index)) {
+                ++args->d_numErrors;
+            }
+            mX->deallocate(slots[i]);
+        }
+    }
+    return 0;
+}
+
+                              // ================
+                              // struct ChaseNode
+                              // ================
+
+struct ChaseNode {
+    // This 'struct' provides a node, occupying a cache line, of the cyclic
+    // list traversed by 'chase'.
+
+    ChaseNode *d_next_p;                                // next node
+    char       d_padding[64 - sizeof(ChaseNode *)];     // fill cache line
+};
+
+ChaseNode *buildCycle(void *buffer, size_type numNodes)
+    // Link the specified 'numNodes' nodes of the array at the specified
+    // 'buffer' into a single cycle visiting them in a random order, and return
+    // the address of the first node.
+{
+    ChaseNode *nodes = static_cast<ChaseNode *>(buffer);
+
+    bsl::vector<size_type> order(numNodes,
+                                 0,
+                                 bslma::NewDeleteAllocator::allocator(0));
+    for (size_type i = 0; i < numNodes; ++i) {
+        order[i] = i;
+    }
+
+    // Sattolo's algorithm, yielding a permutation consisting of one cycle.
+
+    bsls::Types::Uint64 seed = 0x2545F4914F6CDD1DULL;
+    for (size_type i = numNodes - 1; 0 < i; --i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        const size_type j   = static_cast<size_type>(seed >> 33) % i;
+        const size_type tmp = order[i];
+
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    for (size_type i = 0; i < numNodes; ++i) {
+        nodes[i].d_next_p = &nodes[order[i]];
+    }
+    return nodes;
+}
+
+double chase(bslma::Allocator *allocator,
+             size_type         bufferSize,
+             int               numHops)
+    // Allocate a buffer of the specified 'bufferSize' bytes from the specified
+    // 'allocator', link its cache lines into a random cycle, and return the
+    // average time (in nanoseconds) taken by each of the specified 'numHops'
+    // dependent loads traversing the cycle.
+{
+    const size_type NUM_NODES = bufferSize / sizeof(ChaseNode);
+
+    void      *buffer = allocator->allocate(NUM_NODES * sizeof(ChaseNode));
+    ChaseNode *node   = buildCycle(buffer, NUM_NODES);
+
+    // Warm up the caches and the TLB.
+
+    for (size_type i = 0; i < NUM_NODES; ++i) {
+        node = node->d_next_p;
+    }
+
+    bsls::Stopwatch timer;
+    timer.start();
+    for (int i = 0; i < numHops; ++i) {
+        node = node->d_next_p;
+    }
+    timer.stop();
+
+    // Use 'node', so that the traversal is not optimized away.
+
+    if (!node) {
+        printf("unreachable\n");
+    }
+
+    allocator->deallocate(buffer);
+
+    return timer.elapsedTime() * 1e9 / numHops;
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int  test        = argc > 1 ? atoi(argv[1]) : 0;
+    const bool verbose     = argc > 2;
+    const bool veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator da("default", veryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Backing a Large Pool with Huge Pages
+///- - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that we maintain a large in-memory table of orders, accessed in
+// random order, whose nodes are allocated from a 'bdlma::Pool'.  To reduce the
+// TLB misses incurred by accesses to the table, we supply the chunks of the
+// pool from huge pages.
+//
+// First, we define the type of the nodes of the table:
+//..
+    struct OrderNode {
+        OrderNode          *d_next_p;
+        bsls::Types::Int64  d_orderId;
+        double              d_price;
+        int                 d_quantity;
+    };
+//..
+// Then, we create a huge page allocator, and a pool using it:
+//..
+    bdlma::HugePageAllocator hugePages;
+    bdlma::Pool              pool(sizeof(OrderNode),
+                                  bsls::BlockGrowth::BSLS_GEOMETRIC,
+                                  1024,
+                                  &hugePages);
+//..
+// Next, we create some nodes:
+//..
+    OrderNode *head = 0;
+    for (int i = 0; i < 10000; ++i) {
+        OrderNode *node = static_cast<OrderNode *>(pool.allocate());
+
+        node->d_next_p   = head;
+        node->d_orderId  = i;
+        node->d_price    = 100.0;
+        node->d_quantity = 10;
+
+        head = node;
+    }
+//..
+// Now, we observe that the chunks of the pool have been supplied by a single
+// region of huge pages:
+//..
+    ASSERT(1 == hugePages.numRegions());
+//..
+// Finally, we release the nodes, which returns the chunks of the pool to the
+// huge page allocator.  The single region that supplied them, being the
+// current region, is retained for reuse until the huge page allocator is
+// destroyed:
+//..
+    pool.release();
+
+    ASSERT(1 == hugePages.numRegions());
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY
+        //
+        // Concerns:
+        //: 1 Blocks allocated concurrently by several threads, including
+        //:   blocks larger than a page, do not overlap, and are not corrupted
+        //:   by the allocator while in use.
+        //:
+        //: 2 Regions are released when their blocks are deallocated, also
+        //:   under concurrent use.
+        //
+        // Plan:
+        //: 1 Run several threads that, in each round, allocate blocks of
+        //:   varying sizes, scribbling over each the index of the thread, and
+        //:   then verify and deallocate them.  (C-1)
+        //:
+        //: 2 Verify that at most the current region remains after all threads
+        //:   have completed.  (C-2)
+        //
+        // Testing:
+        //   CONCURRENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY" << endl
+                          << "===========" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+
+        enum { k_NUM_THREADS = 8, k_NUM_SLOTS = 100, k_NUM_ROUNDS = 20 };
+
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            StressArgs                args[k_NUM_THREADS];
+            bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                args[i].d_allocator_p = &mX;
+                args[i].d_index       = i;
+                args[i].d_numSlots    = k_NUM_SLOTS;
+                args[i].d_numRounds   = k_NUM_ROUNDS;
+                args[i].d_numErrors   = 0;
+
+                ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                      stressThread,
+                                                      &args[i]));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                bslmt::ThreadUtil::join(handles[i]);
+                ASSERTV(i, 0 == args[i].d_numErrors);
+            }
+
+            if (veryVerbose) { T_ P(X.numRegions()) }
+
+            ASSERTV(X.numRegions(), 1 >= X.numRegions());
+            ASSERTV(X.numBytesInRegions(),
+                    static_cast<Int64>(PAGE_2MB) * X.numRegions()
+                                                   == X.numBytesInRegions());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // UNDERLYING ALLOCATOR OF POOLS
+        //
+        // Concerns:
+        //: 1 The allocator can supply the chunks of 'bdlma::Pool',
+        //:   'bdlma::SequentialAllocator', and 'bdlma::Multipool', including
+        //:   chunks larger than a page.
+        //:
+        //: 2 Releasing the pool returns all regions but the current one (and,
+        //:   for 'bdlma::Multipool', the one holding its array of pools), and
+        //:   destroying it returns all regions but the current one.
+        //
+        // Plan:
+        //: 1 Using each pool with a huge page allocator, allocate enough
+        //:   blocks to require several regions, scribble over them, verify
+        //:   them, and release the pool.  (C-1)
+        //:
+        //: 2 Verify the number of regions remaining after releasing, and after
+        //:   destroying, each pool.  (C-2)
+        //
+        // Testing:
+        //   UNDERLYING ALLOCATOR OF POOLS
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "UNDERLYING ALLOCATOR OF POOLS" << endl
+                          << "=============================" << endl;
+
+        enum { k_NUM_BLOCKS = 20000 };
+
+        bslma::Allocator *na = bslma::NewDeleteAllocator::allocator(0);
+
+        bsl::vector<void *> blocks(k_NUM_BLOCKS, static_cast<void *>(0), na);
+
+        if (verbose) cout << "\t'bdlma::Pool'" << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+            {
+                bdlma::Pool pool(200,
+                                 bsls::BlockGrowth::BSLS_GEOMETRIC,
+                                 4096,
+                                 &mX);
+
+                for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                    blocks[i] = pool.allocate();
+                    scribble(blocks[i], 200, i);
+                }
+                ASSERTV(X.numRegions(), 1 < X.numRegions());
+
+                for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                    ASSERTV(i, isScribbled(blocks[i], 200, i));
+                }
+                pool.release();
+
+                ASSERTV(X.numRegions(), 1 >= X.numRegions());
+            }
+            ASSERTV(X.numRegions(), 1 >= X.numRegions());
+        }
+
+        if (verbose) cout << "\t'bdlma::SequentialAllocator'" << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+            {
+                bdlma::SequentialAllocator sa(&mX);
+
+                for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                    const size_type SIZE = 1 + i % 500;
+
+                    blocks[i] = sa.allocate(SIZE);
+                    scribble(blocks[i], SIZE, i);
+                }
+                ASSERTV(X.numRegions(), 1 <= X.numRegions());
+
+                for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                    ASSERTV(i, isScribbled(blocks[i], 1 + i % 500, i));
+                }
+                sa.release();
+
+                ASSERTV(X.numRegions(), 1 >= X.numRegions());
+            }
+            ASSERTV(X.numRegions(), 1 >= X.numRegions());
+        }
+
+        if (verbose) cout << "\t'bdlma::Multipool'" << endl;
+        {
+            Obj mX;  const Obj& X = mX;
+            {
+                bdlma::Multipool mp(8, &mX);
+
+                for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                    const size_type SIZE = 1 + i % 1000;
+
+                    blocks[i] = mp.allocate(SIZE);
+                    scribble(blocks[i], SIZE, i);
+                }
+                ASSERTV(X.numRegions(), 1 <= X.numRegions());
+
+                for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                    ASSERTV(i, isScribbled(blocks[i], 1 + i % 1000, i));
+                }
+                mp.release();
+
+                // The array of pools of 'mp', allocated at construction, may
+                // keep the region that supplied it.
+
+                ASSERTV(X.numRegions(), 2 >= X.numRegions());
+            }
+            ASSERTV(X.numRegions(), 1 >= X.numRegions());
+        }
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // ALLOCATE AND DEALLOCATE
+        //
+        // Concerns:
+        //: 1 'allocate' returns maximally-aligned, non-overlapping blocks of
+        //:   at least the requested size, or 0 if the requested size is 0.
+        //:
+        //: 2 Blocks that fit in a page are carved sequentially from the
+        //:   current region, a new one-page region becoming current when a
+        //:   block does not fit in its remainder.
+        //:
+        //: 3 Each block larger than a page is supplied by a region of its own,
+        //:   whose size is the smallest sufficient multiple of the page size,
+        //:   and which is released when the block is deallocated.
+        //:
+        //: 4 A region other than the current one is released when all of its
+        //:   blocks are deallocated; the current region is then reused from
+        //:   its beginning.
+        //:
+        //: 5 'deallocate' has no effect on a null address.
+        //:
+        //: 6 On Linux, regions are aligned on a 2 MB boundary, and are not
+        //:   obtained from the underlying allocator; on other platforms, they
+        //:   are obtained from the underlying allocator.
+        //
+        // Plan:
+        //: 1 Allocate blocks of various sizes, verifying their alignment and
+        //:   scribbling over them, and verify the number and size of the
+        //:   regions after each allocation and deallocation.  (C-1..5)
+        //:
+        //: 2 Verify the offset of the blocks in their pages and the use of
+        //:   the underlying allocator.  (C-6)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ALLOCATE AND DEALLOCATE" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+
+        const Int64 PAGE = static_cast<Int64>(PAGE_2MB);
+
+        if (verbose) cout << "\tSmall blocks." << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(0 == mX.allocate(0));
+            ASSERT(0 == X.numRegions());
+
+            mX.deallocate(0);
+
+            void *p1 = mX.allocate(1);
+            void *p2 = mX.allocate(100);
+            void *p3 = mX.allocate(1000);
+
+            ASSERT(isMaxAligned(p1));
+            ASSERT(isMaxAligned(p2));
+            ASSERT(isMaxAligned(p3));
+
+            ASSERT(static_cast<char *>(p1) + 1   <= p2);
+            ASSERT(static_cast<char *>(p2) + 100 <= p3);
+
+            scribble(p1, 1,    1);
+            scribble(p2, 100,  2);
+            scribble(p3, 1000, 3);
+
+            ASSERT(1    == X.numRegions());
+            ASSERT(PAGE == X.numBytesInRegions());
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+            ASSERTV(offsetInPage(p1, PAGE_2MB),
+                    256 > offsetInPage(p1, PAGE_2MB));
+            ASSERT(0 == ta.numBlocksTotal());
+#else
+            ASSERT(1 == ta.numBlocksInUse());
+#endif
+
+            mX.deallocate(p2);
+            mX.deallocate(p1);
+
+            ASSERT(isScribbled(p3, 1000, 3));
+            ASSERT(1 == X.numRegions());
+
+            mX.deallocate(p3);
+
+            ASSERT(1 == X.numRegions());
+
+            // The current region is reused from its beginning.
+
+            void *p4 = mX.allocate(50);
+
+            ASSERT(p1 == p4);
+            ASSERT(1  == X.numRegions());
+
+            mX.deallocate(p4);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tFilling regions." << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            const size_type SIZE = PAGE_2MB / 4;
+
+            // Three quarter-page blocks fit in a region, but not four.
+
+            void *p[5];
+            for (int i = 0; i < 5; ++i) {
+                p[i] = mX.allocate(SIZE);
+                ASSERTV(i, isMaxAligned(p[i]));
+                scribble(p[i], SIZE, i);
+
+                const int EXP = i < 3 ? 1 : 2;
+
+                ASSERTV(i, X.numRegions(), EXP == X.numRegions());
+                ASSERTV(i, EXP * PAGE == X.numBytesInRegions());
+            }
+            for (int i = 0; i < 5; ++i) {
+                ASSERTV(i, isScribbled(p[i], SIZE, i));
+            }
+
+            // Deallocating the blocks of the first region releases it.
+
+            mX.deallocate(p[1]);
+            mX.deallocate(p[0]);
+            ASSERT(2 == X.numRegions());
+
+            mX.deallocate(p[2]);
+            ASSERT(1    == X.numRegions());
+            ASSERT(PAGE == X.numBytesInRegions());
+
+            ASSERT(isScribbled(p[3], SIZE, 3));
+            ASSERT(isScribbled(p[4], SIZE, 4));
+
+            mX.deallocate(p[3]);
+            mX.deallocate(p[4]);
+            ASSERT(1 == X.numRegions());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\tLarge blocks." << endl;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            void *small = mX.allocate(10);
+
+            static const struct {
+                int       d_line;     // source line number
+                size_type d_size;     // requested size
+                int       d_pages;    // expected pages of dedicated region
+            } DATA[] = {
+                //LINE  SIZE                 PAGES
+                //----  -------------------  -----
+                { L_,   PAGE_2MB - 16,           2 },
+                { L_,   PAGE_2MB,                2 },
+                { L_,   PAGE_2MB + 1,            2 },
+                { L_,   3 * PAGE_2MB,            4 },
+                { L_,   5 * PAGE_2MB - 256,      5 },
+            };
+            const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+            for (int ti = 0; ti < NUM_DATA; ++ti) {
+                const int       LINE  = DATA[ti].d_line;
+                const size_type SIZE  = DATA[ti].d_size;
+                const int       PAGES = DATA[ti].d_pages;
+
+                void *p = mX.allocate(SIZE);
+
+                ASSERTV(LINE, isMaxAligned(p));
+                ASSERTV(LINE, X.numRegions(), 2 == X.numRegions());
+                ASSERTV(LINE, X.numBytesInRegions(),
+                        (1 + PAGES) * PAGE == X.numBytesInRegions());
+
+                scribble(p, SIZE, ti);
+                ASSERTV(LINE, isScribbled(p, SIZE, ti));
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+                ASSERTV(LINE, 256 > offsetInPage(p, PAGE_2MB));
+#endif
+
+                mX.deallocate(p);
+
+                ASSERTV(LINE, 1    == X.numRegions());
+                ASSERTV(LINE, PAGE == X.numBytesInRegions());
+            }
+
+            // Large blocks do not disturb the current region.
+
+            void *next = mX.allocate(10);
+
+            ASSERT(static_cast<char *>(small) + 10 <= next);
+            ASSERT(1 == X.numRegions());
+
+            mX.deallocate(small);
+            mX.deallocate(next);
+
+            // Outstanding regions are released by the destructor.
+
+            mX.allocate(100);
+            mX.allocate(3 * PAGE_2MB);
+
+            ASSERT(2 == X.numRegions());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CONSTRUCTORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 The page size is 2 MB by default, and as specified otherwise.
+        //:
+        //: 2 A newly created allocator has no regions.
+        //:
+        //: 3 Regions are sized in multiples of the page size.
+        //:
+        //: 4 Only the regions mapped from explicitly reserved huge pages are
+        //:   counted by 'numBytesInHugeTlbRegions', and no region is mapped
+        //:   from them if 'e_TRANSPARENT_ONLY' is specified.
+        //:
+        //: 5 The default allocator is used only if no underlying allocator is
+        //:   specified, and only on platforms without huge page support.
+        //:
+        //: 6 The destructor releases all regions.
+        //
+        // Plan:
+        //: 1 Create allocators using each constructor, and verify the values
+        //:   of the accessors before and after allocating a block.  (C-1..6)
+        //
+        // Testing:
+        //   HugePageAllocator(Allocator *ba = 0);
+        //   HugePageAllocator(PageSize, PagePolicy = e_EXP..., Allocator *ba);
+        //   ~HugePageAllocator();
+        //   bsls::Types::Int64 numBytesInHugeTlbRegions() const;
+        //   bsls::Types::Int64 numBytesInRegions() const;
+        //   int numRegions() const;
+        //   size_type pageSize() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONSTRUCTORS AND ACCESSORS" << endl
+                          << "==========================" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+
+        static const struct {
+            int             d_line;      // source line number
+            int             d_ctor;      // constructor to use
+            Obj::PageSize   d_pageSize;  // page size (unless 'd_ctor' is 0)
+            Obj::PagePolicy d_policy;    // policy (if 'd_ctor' is 2)
+            size_type       d_expSize;   // expected page size
+        } DATA[] = {
+            //LINE CTOR PAGE SIZE         POLICY
+            //---- ---- ----------------- -----------------------------
+            { L_,    0, Obj::e_PAGE_2MB,  Obj::e_EXPLICIT_OR_TRANSPARENT,
+                                                                  PAGE_2MB },
+            { L_,    1, Obj::e_PAGE_2MB,  Obj::e_EXPLICIT_OR_TRANSPARENT,
+                                                                  PAGE_2MB },
+            { L_,    1, Obj::e_PAGE_1GB,  Obj::e_EXPLICIT_OR_TRANSPARENT,
+                                                                  PAGE_1GB },
+            { L_,    2, Obj::e_PAGE_2MB,  Obj::e_TRANSPARENT_ONLY,
+                                                                  PAGE_2MB },
+            { L_,    2, Obj::e_PAGE_1GB,  Obj::e_TRANSPARENT_ONLY,
+                                                                  PAGE_1GB },
+        };
+        const int NUM_DATA = static_cast<int>(sizeof DATA / sizeof *DATA);
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int             LINE   = DATA[ti].d_line;
+            const int             CTOR   = DATA[ti].d_ctor;
+            const Obj::PageSize   SIZE   = DATA[ti].d_pageSize;
+            const Obj::PagePolicy POLICY = DATA[ti].d_policy;
+            const size_type       EXP    = DATA[ti].d_expSize;
+
+            if (veryVerbose) { T_ P_(LINE) P_(CTOR) P(EXP) }
+
+            for (int useDefault = 0; useDefault < 2; ++useDefault) {
+                bslma::Allocator *ba = useDefault ? 0 : &ta;
+
+                Obj *objPtr = 0;
+                switch (CTOR) {
+                  case 0: {
+                    objPtr = new (*bslma::NewDeleteAllocator::allocator(0))
+                                                                      Obj(ba);
+                  } break;
+                  case 1: {
+                    objPtr = new (*bslma::NewDeleteAllocator::allocator(0))
+                                                 Obj(SIZE,
+                                                     Obj::
+                                                     e_EXPLICIT_OR_TRANSPARENT,
+                                                     ba);
+                  } break;
+                  default: {
+                    objPtr = new (*bslma::NewDeleteAllocator::allocator(0))
+                                                      Obj(SIZE, POLICY, ba);
+                  } break;
+                }
+                Obj& mX = *objPtr;  const Obj& X = mX;
+
+                ASSERTV(LINE, EXP == X.pageSize());
+                ASSERTV(LINE, 0   == X.numRegions());
+                ASSERTV(LINE, 0   == X.numBytesInRegions());
+                ASSERTV(LINE, 0   == X.numBytesInHugeTlbRegions());
+
+                void *p = mX.allocate(64);
+
+                ASSERTV(LINE, 1 == X.numRegions());
+                ASSERTV(LINE, static_cast<Int64>(EXP)
+                                                   == X.numBytesInRegions());
+
+                const Int64 HUGETLB = X.numBytesInHugeTlbRegions();
+
+                ASSERTV(LINE, HUGETLB, 0 == HUGETLB
+                                        || X.numBytesInRegions() == HUGETLB);
+
+                if (Obj::e_TRANSPARENT_ONLY == POLICY && 2 == CTOR) {
+                    ASSERTV(LINE, 0 == HUGETLB);
+                }
+                if (veryVerbose) { T_ T_ P(HUGETLB) }
+
+                mX.deallocate(p);
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+                ASSERTV(LINE, 0 == ta.numBlocksTotal());
+                ASSERTV(LINE, 0 == da.numBlocksTotal());
+#else
+                ASSERTV(LINE, useDefault ? 1 == da.numBlocksInUse()
+                                         : 1 == ta.numBlocksInUse());
+#endif
+
+                bslma::NewDeleteAllocator::allocator(0)->deleteObject(objPtr);
+
+                ASSERTV(LINE, 0 == ta.numBlocksInUse());
+                ASSERTV(LINE, 0 == da.numBlocksInUse());
+            }
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks of various sizes.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(PAGE_2MB == X.pageSize());
+
+            void *p1 = mX.allocate(1);
+            void *p2 = mX.allocate(100);
+            void *p3 = mX.allocate(3 * PAGE_2MB);
+
+            ASSERT(p1);  ASSERT(p2);  ASSERT(p3);
+            ASSERT(p1 != p2);
+
+            scribble(p3, 3 * PAGE_2MB, 0xab);
+
+            ASSERT(2 == X.numRegions());
+
+            mX.deallocate(p1);
+            mX.deallocate(p2);
+            mX.deallocate(p3);
+
+            ASSERT(1 == X.numRegions());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //   Compare the average latency of the dependent loads of a traversal
+        //   in random order of the cache lines of a large buffer, supplied by
+        //   the new-delete allocator and by 'bdlma::HugePageAllocator', for
+        //   buffers of increasing size.  The traversal of buffers exceeding
+        //   the reach of the TLB with base pages (e.g., 6 MB for 1536 entries
+        //   of 4 KB) incurs TLB misses, which huge pages avoid.
+        //
+        //   Usage: <driver> -1 [maxBufferMB [numHops]]
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST" << endl
+                          << "================" << endl;
+
+        const int MAX_MB   = argc > 2 ? atoi(argv[2]) : 256;
+        const int NUM_HOPS = argc > 3 ? atoi(argv[3]) : 10000000;
+
+        bslma::Allocator *na = bslma::NewDeleteAllocator::allocator(0);
+
+        Obj hugePages(na);
+
+        printf("%10s %12s %12s\n", "buffer MB", "new-delete", "huge pages");
+
+        for (int mb = 1; mb <= MAX_MB; mb *= 2) {
+            const size_type SIZE = static_cast<size_type>(mb) << 20;
+
+            const double T0 = chase(na,         SIZE, NUM_HOPS);
+            const double T1 = chase(&hugePages, SIZE, NUM_HOPS);
+
+            // Report nanoseconds per dependent load.
+
+            printf("%10d %12.2f %12.2f\n", mb, T0, T1);
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1033 @@
+// bdlma_intrusiveptr.h                                               -*-C++-*-
+#ifndef INCLUDED_BDLMA_INTRUSIVEPTR
+#define INCLUDED_BDLMA_INTRUSIVEPTR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide an intrusive shared pointer with selectable counting.
+//
+//@CLASSES:
+//  bdlma::IntrusivePtr: shared pointer to an intrusively counted object
+//  bdlma::IntrusivePtrBase: base class holding a reference count and allocator
+//  bdlma::IntrusivePtrAtomicCounter: thread-safe reference count
+//  bdlma::IntrusivePtrLocalCounter: reference count for thread-confined object
+//  bdlma::IntrusivePtrBiasedCounter: count biased toward one owner thread
+//
+//@SEE_ALSO: bslstl_sharedptr, bslma_sharedptrrep
+//
+//@DESCRIPTION: This component provides a smart pointer class template,
+// 'bdlma::IntrusivePtr', that shares ownership of an object holding its own
+// reference count, a base class template, 'bdlma::IntrusivePtrBase', from
+// which such objects derive, and three "counter" classes, one of which is
+// selected by the template parameter of 'bdlma::IntrusivePtrBase' to define
+// how the reference count is maintained:
+//..
+//  Counter                           Suitable For
+//  --------------------------------  -----------------------------------------
+//  bdlma::IntrusivePtrAtomicCounter  objects shared by any number of threads
+//
+//  bdlma::IntrusivePtrLocalCounter   objects used by a single thread only
+//
+//  bdlma::IntrusivePtrBiasedCounter  objects mostly used by the thread that
+//                                    first shares them, occasionally by others
+//..
+// Every copy of a 'bsl::shared_ptr' updates the reference count of its
+// representation ('bslma::SharedPtrRep') using atomic operations, as the
+// count may be shared between threads.  For objects that never leave the
+// thread that created them (e.g., the buffers of a message being assembled by
+// one thread), these atomic operations, and the separate allocation of the
+// representation when the object is not created in-place, are unnecessary.
+// An object derived from 'bdlma::IntrusivePtrBase' holds its own reference
+// count and the allocator that supplied its memory, so that a
+// 'bdlma::IntrusivePtr' is the size of a raw pointer, and copying it updates
+// the count with a plain increment when the object uses a
+// 'bdlma::IntrusivePtrLocalCounter'.
+//
+///Biased Reference Counting
+///-------------------------
+// A 'bdlma::IntrusivePtrBiasedCounter' holds two counts: a "biased" count,
+// updated with plain (non-atomic) operations by the thread that acquired the
+// first reference to the object (its "owner" thread), and an atomic "shared"
+// count updated by all other threads.  Copying and destroying pointers to an
+// object in its owner thread therefore costs about as much as for a
+// thread-confined object, while the object may still be shared with other
+// threads.  When the biased count of the owner thread drops to 0, the owner
+// thread relinquishes its bias by atomically marking the shared count, and
+// the object is destroyed by whichever thread releases its last reference.
+// Once relinquished, the bias is not reacquired: references subsequently
+// acquired by the former owner thread (e.g., from a pointer received from
+// another thread) are counted in the shared count.  Note that identifying the
+// calling thread adds a small cost to each update of the count.
+//
+// As the biased count is not accessible to other threads, each reference to
+// an object using a 'bdlma::IntrusivePtrBiasedCounter' must be released by the
+// thread that acquired it: a 'bdlma::IntrusivePtr' referring to such an object
+// may be copied by any thread, but must be destroyed, reset, or assigned by
+// the thread that created it (or last assigned it).  An object is passed to
+// another thread by having that thread make its own copy of a pointer that is
+// kept alive until the copy is made.  In particular, the owner thread must
+// release all its references before it exits.  A thread other than the owner
+// thread releasing a reference acquired by the owner thread would leave the
+// biased count of the owner thread permanently positive, leaking the object;
+// such a release drives the shared count negative, which
+// 'bdlma::IntrusivePtrBiasedCounter' detects in all build modes (using
+// 'BSLS_ASSERT_OPT'), unless it is offset by the owner thread releasing a
+// reference acquired by another thread, in which case the count remains
+// correct.
+//
+///Requirements on the Managed Type
+///--------------------------------
+// 'bdlma::IntrusivePtr<TYPE>' requires that the following expressions be
+// valid for a 'const TYPE *' 'p' (which is the case if 'TYPE' derives
+// publicly from an instantiation of 'bdlma::IntrusivePtrBase'):
+//..
+//  Expression         Semantics
+//  -----------------  -------------------------------------------------------
+//  p->acquireRef()    acquire a reference to '*p'
+//
+//  p->releaseRef()    release a reference to '*p', and return 'true' if it
+//                     was the last reference, and 'false' otherwise
+//
+//  p->allocator()     return the 'bslma::Allocator *' that supplied the
+//                     memory of '*p'
+//..
+// When the last reference to an object is released, the object is destroyed
+// and its memory deallocated using 'bslma::DeleterHelper::deleteObject' with
+// the allocator returned by 'allocator()'.  Therefore, either the object must
+// be managed by a pointer to its most-derived type, or its destructor must be
+// virtual.  Note that the reference count of an object is not transferred when
+// the object is copied or assigned.
+//
+///Thread Safety
+///-------------
+// Distinct 'bdlma::IntrusivePtr' objects referring to the same object that
+// uses a 'bdlma::IntrusivePtrAtomicCounter' or a
+// 'bdlma::IntrusivePtrBiasedCounter' may be copied, assigned, and destroyed
+// concurrently by different threads (subject, for the latter, to the
+// restrictions described in {Biased Reference Counting}).  All the
+// 'bdlma::IntrusivePtr' objects referring to an object that uses a
+// 'bdlma::IntrusivePtrLocalCounter' must be used by a single thread (or by
+// several threads with external synchronization ensuring that they are not
+// used concurrently).  A single 'bdlma::IntrusivePtr' object is not
+// thread-safe.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sharing Buffers Within a Single Thread
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a thread assembling a message shares the buffers holding the
+// data of the message between the several views of the message it builds.
+// The buffers never leave the thread, so their reference counts need not be
+// atomic.
+//
+// First, we define a buffer type holding its reference count:
+//..
+//  typedef bdlma::IntrusivePtrBase<bdlma::IntrusivePtrLocalCounter>
+//                                                                  LocalBase;
+//
+//  class Buffer : public LocalBase {
+//      // This class holds a fixed-size array of bytes.
+//
+//      // DATA
+//      char *d_data_p;  // data (owned)
+//      int   d_size;    // size of 'd_data_p'
+//
+//    private:
+//      // NOT IMPLEMENTED
+//      Buffer(const Buffer&);
+//      Buffer& operator=(const Buffer&);
+//
+//    public:
+//      // CREATORS
+//      explicit Buffer(int size, bslma::Allocator *basicAllocator = 0)
+//          // Create a buffer of the specified 'size' bytes.  Optionally
+//          // specify a 'basicAllocator' used to supply memory.  If
+//          // 'basicAllocator' is 0, the currently installed default allocator
+//          // is used.
+//      : LocalBase(basicAllocator)
+//      , d_data_p(static_cast<char *>(allocator()->allocate(size)))
+//      , d_size(size)
+//      {
+//      }
+//
+//      ~Buffer()
+//          // Destroy this buffer.
+//      {
+//          allocator()->deallocate(d_data_p);
+//      }
+//
+//      // ACCESSORS
+//      char *data() const { return d_data_p; }
+//          // Return the address of the data of this buffer.
+//
+//      int size() const { return d_size; }
+//          // Return the size of this buffer.
+//  };
+//..
+// Note that 'allocator()', supplied by the base class, returns the allocator
+// of the buffer, which the buffer uses to allocate its data.
+//
+// Then, we create a buffer, managed by an intrusive pointer:
+//..
+//  bslma::TestAllocator ta;
+//
+//  bdlma::IntrusivePtr<Buffer> buffer(new (ta) Buffer(1024, &ta));
+//  assert(1 == buffer->numReferences());
+//  assert(2 == ta.numBlocksInUse());
+//..
+// Note that, unlike a 'bsl::shared_ptr' adopting an object, the intrusive
+// pointer allocates no representation.
+//
+// Next, we share the buffer between two views of the message; copying the
+// pointer increments the reference count of the buffer with a plain,
+// non-atomic, increment:
+//..
+//  bdlma::IntrusivePtr<Buffer> header(buffer);
+//  bdlma::IntrusivePtr<Buffer> body(buffer);
+//  assert(3 == buffer->numReferences());
+//  assert(header.get() == body.get());
+//..
+// Now, we release the original pointer, leaving the views sharing the buffer:
+//..
+//  buffer.reset();
+//  assert(2 == header->numReferences());
+//  assert(2 == ta.numBlocksInUse());
+//..
+// Finally, we release the views, and observe that the buffer is destroyed
+// with the last reference, its memory returned to its allocator:
+//..
+//  header.reset();
+//  body.reset();
+//  assert(0 == ta.numBlocksInUse());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DEFAULT
+#include <bslma_default.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_DELETERHELPER
+#include <bslma_deleterhelper.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ENABLEIF
+#include <bslmf_enableif.h>
+#endif
+
+#ifndef INCLUDED_BSLMF_ISCONVERTIBLE
+#include <bslmf_isconvertible.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADUTIL
+#include <bslmt_threadutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ASSERT
+#include <bsls_assert.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_PERFORMANCEHINT
+#include <bsls_performancehint.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSLS_UNSPECIFIEDBOOL
+#include <bsls_unspecifiedbool.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                      // ===============================
+                      // class IntrusivePtrAtomicCounter
+                      // ===============================
+
+class IntrusivePtrAtomicCounter {
+    // This class provides a reference count that may be updated concurrently
+    // by any number of threads.
+
+    // DATA
+    bsls::AtomicInt d_count;  // number of references
+
+  private:
+    // NOT IMPLEMENTED
+    IntrusivePtrAtomicCounter(const IntrusivePtrAtomicCounter&);
+    IntrusivePtrAtomicCounter& operator=(const IntrusivePtrAtomicCounter&);
+
+  public:
+    // CREATORS
+    IntrusivePtrAtomicCounter();
+        // Create a counter having a count of 0.
+
+    //! ~IntrusivePtrAtomicCounter() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    void increment();
+        // Increment the count of this counter.
+
+    bool decrement();
+        // Decrement the count of this counter, and return 'true' if the
+        // resulting count is 0, and 'false' otherwise.  The behavior is
+        // undefined unless the count of this counter is positive.
+
+    // ACCESSORS
+    int count() const;
+        // Return the count of this counter.  Note that the returned value may
+        // be obsolete by the time it is returned if other threads update the
+        // count.
+};
+
+                       // ==============================
+                       // class IntrusivePtrLocalCounter
+                       // ==============================
+
+class IntrusivePtrLocalCounter {
+    // This class provides a reference count updated with non-atomic
+    // operations, for objects confined to a single thread.
+
+    // DATA
+    int d_count;  // number of references
+
+  private:
+    // NOT IMPLEMENTED
+    IntrusivePtrLocalCounter(const IntrusivePtrLocalCounter&);
+    IntrusivePtrLocalCounter& operator=(const IntrusivePtrLocalCounter&);
+
+  public:
+    // CREATORS
+    IntrusivePtrLocalCounter();
+        // Create a counter having a count of 0.
+
+    //! ~IntrusivePtrLocalCounter() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    void increment();
+        // Increment the count of this counter.
+
+    bool decrement();
+        // Decrement the count of this counter, and return 'true' if the
+        // resulting count is 0, and 'false' otherwise.  The behavior is
+        // undefined unless the count of this counter is positive.
+
+    // ACCESSORS
+    int count() const;
+        // Return the count of this counter.
+};
+
+                      // ===============================
+                      // class IntrusivePtrBiasedCounter
+                      // ===============================
+
+class IntrusivePtrBiasedCounter {
+    // This class provides a reference count updated with non-atomic
+    // operations by the thread that first increments it (the "owner" thread),
+    // and with atomic operations by all other threads.  See {Biased Reference
+    // Counting}.
+
+    // DATA
+    bsls::Types::Uint64 d_ownerId;      // id of the owner thread
+
+    int                 d_biasedCount;  // references of the owner thread
+
+    bool                d_hasOwner;     // 'true' once the owner thread is
+                                        // set
+
+    bool                d_ownerDone;    // 'true' once the owner thread has
+                                        // relinquished its bias (accessed by
+                                        // the owner thread only)
+
+    bsls::AtomicInt     d_sharedCount;  // twice the number of references of
+                                        // the other threads (which may be
+                                        // negative), plus 1 once the owner
+                                        // thread relinquished its bias
+
+    // PRIVATE ACCESSORS
+    bool isBiasedToCallingThread() const;
+        // Return 'true' if the calling thread is the owner thread and has not
+        // relinquished its bias, and 'false' otherwise.
+
+  private:
+    // NOT IMPLEMENTED
+    IntrusivePtrBiasedCounter(const IntrusivePtrBiasedCounter&);
+    IntrusivePtrBiasedCounter& operator=(const IntrusivePtrBiasedCounter&);
+
+  public:
+    // CREATORS
+    IntrusivePtrBiasedCounter();
+        // Create a counter having a count of 0 and no owner thread.
+
+    //! ~IntrusivePtrBiasedCounter() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    void increment();
+        // Increment the count of this counter.  If the count of this counter
+        // is 0, the calling thread becomes the owner thread of this counter.
+
+    bool decrement();
+        // Decrement the count of this counter, and return 'true' if the
+        // resulting count is 0, and 'false' otherwise.  If the calling thread
+        // is the owner thread and releases its last reference, it relinquishes
+        // its bias.  The behavior is undefined unless the calling thread
+        // holds a reference it acquired by incrementing this counter.  Note
+        // that a thread other than the owner thread releasing a reference
+        // acquired by the owner thread is detected in all build modes when it
+        // makes the count of the references of the other threads negative.
+
+    // ACCESSORS
+    int count() const;
+        // Return the count of this counter.  The behavior is undefined if the
+        // owner thread updates the count concurrently with this call, unless
+        // the calling thread is the owner thread.  Note that the returned
+        // value may be obsolete by the time it is returned if other threads
+        // update the count.
+
+    bool isOwnedByCallingThread() const;
+        // Return 'true' if the calling thread is the owner thread of this
+        // counter and has not relinquished its bias, and 'false' otherwise.
+};
+
+                           // ======================
+                           // class IntrusivePtrBase
+                           // ======================
+
+template <class COUNTER = IntrusivePtrAtomicCounter>
+class IntrusivePtrBase {
+    // This class template provides a base class for objects managed by
+    // 'IntrusivePtr', holding the reference count of the object, maintained
+    // by an object of the (template parameter) type 'COUNTER', and the
+    // allocator that supplied the memory of the object.  'COUNTER' must be
+    // one of 'IntrusivePtrAtomicCounter', 'IntrusivePtrLocalCounter', and
+    // 'IntrusivePtrBiasedCounter', or provide the same interface.
+
+    // DATA
+    mutable COUNTER   d_counter;      // reference count
+    bslma::Allocator *d_allocator_p;  // memory allocator of this object
+                                      // (held, not owned)
+
+  protected:
+    // CREATORS
+    explicit IntrusivePtrBase(bslma::Allocator *basicAllocator = 0);
+        // Create a base object having a reference count of 0.  Optionally
+        // specify a 'basicAllocator', which must be the allocator that
+        // supplies the memory of the derived object.  If 'basicAllocator' is
+        // 0, the currently installed default allocator is used.
+
+    IntrusivePtrBase(const IntrusivePtrBase&  original,
+                     bslma::Allocator        *basicAllocator = 0);
+        // Create a base object having a reference count of 0.  Optionally
+        // specify a 'basicAllocator', which must be the allocator that
+        // supplies the memory of the derived object.  If 'basicAllocator' is
+        // 0, the currently installed default allocator is used.  Note that
+        // the reference count of the specified 'original' object is not
+        // copied.
+
+    ~IntrusivePtrBase();
+        // Destroy this object.  The behavior is undefined unless the
+        // reference count of this object is 0.
+
+    // MANIPULATORS
+    IntrusivePtrBase& operator=(const IntrusivePtrBase& rhs);
+        // Return a reference providing modifiable access to this object,
+        // leaving both its reference count and allocator unchanged.  Note
+        // that this operator is provided so that derived classes may be
+        // assignable; the specified 'rhs' is ignored.
+
+  public:
+    // ACCESSORS
+    void acquireRef() const;
+        // Acquire a reference to this object.
+
+    bool releaseRef() const;
+        // Release a reference to this object, and return 'true' if it was the
+        // last reference, and 'false' otherwise.  The behavior is undefined
+        // unless a reference to this object is held.
+
+    bslma::Allocator *allocator() const;
+        // Return the allocator used to supply the memory of this object.
+
+    int numReferences() const;
+        // Return the number of references to this object.  Note that the
+        // returned value may be obsolete by the time it is returned if other
+        // threads acquire or release references to this object.
+};
+
+                             // ==================
+                             // class IntrusivePtr
+                             // ==================
+
+template <class TYPE>
+class IntrusivePtr {
+    // This class template provides a smart pointer sharing ownership of an
+    // object of the (template parameter) type 'TYPE' holding its own
+    // reference count.  See {Requirements on the Managed Type}.
+
+    // PRIVATE TYPES
+    typedef typename bsls::UnspecifiedBool<IntrusivePtr>::BoolType BoolType;
+
+    // DATA
+    TYPE *d_ptr_p;  // managed object (shared ownership)
+
+    // PRIVATE CLASS METHODS
+    static void release(TYPE *ptr);
+        // Release a reference to the specified 'ptr', destroying it if the
+        // reference was the last one.  Do nothing if 'ptr' is 0.
+
+    // FRIENDS
+    template <class OTHER_TYPE>
+    friend class IntrusivePtr;
+
+  public:
+    // TYPES
+    typedef TYPE ElementType;
+
+    // CREATORS
+    IntrusivePtr();
+        // Create an empty pointer.
+
+    explicit IntrusivePtr(TYPE *ptr);
+        // Create a pointer that shares ownership of the specified 'ptr', and
+        // acquire a reference to it.  If 'ptr' is 0, create an empty pointer.
+
+    IntrusivePtr(const IntrusivePtr& original);
+        // Create a pointer that shares ownership of the object managed by the
+        // specified 'original' pointer (if any).
+
+    template <class OTHER_TYPE>
+    IntrusivePtr(const IntrusivePtr<OTHER_TYPE>& original,
+                 typename bsl::enable_if<
+                     bsl::is_convertible<OTHER_TYPE *, TYPE *>::value,
+                     void>::type * = 0);
+        // Create a pointer that shares ownership of the object managed by the
+        // specified 'original' pointer (if any).  This constructor does not
+        // participate in overload resolution unless 'OTHER_TYPE *' is
+        // convertible to 'TYPE *'.
+
+    ~IntrusivePtr();
+        // Destroy this object, releasing the reference to the object it
+        // manages (if any), and destroying that object if the reference was
+        // the last one.
+
+    // MANIPULATORS
+    IntrusivePtr& operator=(const IntrusivePtr& rhs);
+        // Make this pointer share ownership of the object managed by the
+        // specified 'rhs' (if any), releasing the object previously managed by
+        // this pointer (if any), and return a reference providing modifiable
+        // access to this pointer.
+
+    template <class OTHER_TYPE>
+    typename bsl::enable_if<bsl::is_convertible<OTHER_TYPE *, TYPE *>::value,
+                            IntrusivePtr&>::type
+    operator=(const IntrusivePtr<OTHER_TYPE>& rhs);
+        // Make this pointer share ownership of the object managed by the
+        // specified 'rhs' (if any), releasing the object previously managed by
+        // this pointer (if any), and return a reference providing modifiable
+        // access to this pointer.  This operator does not participate in
+        // overload resolution unless 'OTHER_TYPE *' is convertible to
+        // 'TYPE *'.
+
+    void reset();
+        // Release the object managed by this pointer (if any), and make this
+        // pointer empty.
+
+    void reset(TYPE *ptr);
+        // Make this pointer share ownership of the specified 'ptr', acquiring
+        // a reference to it, and release the object previously managed by this
+        // pointer (if any).  If 'ptr' is 0, make this pointer empty.
+
+    void swap(IntrusivePtr& other);
+        // Efficiently exchange the states of this pointer and the specified
+        // 'other' pointer.  This method provides the no-throw exception-safety
+        // guarantee.
+
+    // ACCESSORS
+    operator BoolType() const;
+        // Return a value of an "unspecified bool" type that evaluates to
+        // 'false' if this pointer is empty, and 'true' otherwise.
+
+    TYPE& operator*() const;
+        // Return a reference providing modifiable access to the object managed
+        // by this pointer.  The behavior is undefined if this pointer is
+        // empty.
+
+    TYPE *operator->() const;
+        // Return the address providing modifiable access to the object managed
+        // by this pointer.  The behavior is undefined if this pointer is
+        // empty.
+
+    TYPE *get() const;
+        // Return the address providing modifiable access to the object managed
+        // by this pointer, or 0 if this pointer is empty.
+};
+
+// FREE OPERATORS
+template <class LHS_TYPE, class RHS_TYPE>
+bool operator==(const IntrusivePtr<LHS_TYPE>& lhs,
+                const IntrusivePtr<RHS_TYPE>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' pointers refer to the
+    // same object (or are both empty), and 'false' otherwise.
+
+template <class LHS_TYPE, class RHS_TYPE>
+bool operator!=(const IntrusivePtr<LHS_TYPE>& lhs,
+                const IntrusivePtr<RHS_TYPE>& rhs);
+    // Return 'true' if the specified 'lhs' and 'rhs' pointers do not refer to
+    // the same object (and are not both empty), and 'false' otherwise.
+
+// FREE FUNCTIONS
+template <class TYPE>
+void swap(IntrusivePtr<TYPE>& a, IntrusivePtr<TYPE>& b);
+    // Efficiently exchange the states of the specified 'a' and 'b' pointers.
+    // This function provides the no-throw exception-safety guarantee.
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                      // -------------------------------
+                      // class IntrusivePtrAtomicCounter
+                      // -------------------------------
+
+// CREATORS
+inline
+IntrusivePtrAtomicCounter::IntrusivePtrAtomicCounter()
+: d_count(0)
+{
+}
+
+// MANIPULATORS
+inline
+void IntrusivePtrAtomicCounter::increment()
+{
+    d_count.addRelaxed(1);
+}
+
+inline
+bool IntrusivePtrAtomicCounter::decrement()
+{
+    BSLS_ASSERT_SAFE(0 < d_count.loadRelaxed());
+
+    return 0 == d_count.add(-1);
+}
+
+// ACCESSORS
+inline
+int IntrusivePtrAtomicCounter::count() const
+{
+    return d_count.loadRelaxed();
+}
+
+                       // ------------------------------
+                       // class IntrusivePtrLocalCounter
+                       // ------------------------------
+
+// CREATORS
+inline
+IntrusivePtrLocalCounter::IntrusivePtrLocalCounter()
+: d_count(0)
+{
+}
+
+// MANIPULATORS
+inline
+void IntrusivePtrLocalCounter::increment()
+{
+    ++d_count;
+}
+
+inline
+bool IntrusivePtrLocalCounter::decrement()
+{
+    BSLS_ASSERT_SAFE(0 < d_count);
+
+    return 0 == --d_count;
+}
+
+// ACCESSORS
+inline
+int IntrusivePtrLocalCounter::count() const
+{
+    return d_count;
+}
+
+                      // -------------------------------
+                      // class IntrusivePtrBiasedCounter
+                      // -------------------------------
+
+// PRIVATE ACCESSORS
+inline
+bool IntrusivePtrBiasedCounter::isBiasedToCallingThread() const
+{
+    return d_ownerId == bslmt::ThreadUtil::selfIdAsUint64() && !d_ownerDone;
+}
+
+// CREATORS
+inline
+IntrusivePtrBiasedCounter::IntrusivePtrBiasedCounter()
+: d_ownerId(0)
+, d_biasedCount(0)
+, d_hasOwner(false)
+, d_ownerDone(false)
+, d_sharedCount(0)
+{
+}
+
+// MANIPULATORS
+inline
+void IntrusivePtrBiasedCounter::increment()
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!d_hasOwner)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        // The count is 0, so no other thread can access this counter.
+
+        d_ownerId  = bslmt::ThreadUtil::selfIdAsUint64();
+        d_hasOwner = true;
+    }
+
+    if (isBiasedToCallingThread()) {
+        ++d_biasedCount;
+    }
+    else {
+        d_sharedCount.addRelaxed(2);
+    }
+}
+
+inline
+bool IntrusivePtrBiasedCounter::decrement()
+{
+    BSLS_ASSERT_SAFE(d_hasOwner);
+
+    if (isBiasedToCallingThread()) {
+        BSLS_ASSERT_SAFE(0 < d_biasedCount);
+
+        if (--d_biasedCount) {
+            return false;                                             // RETURN
+        }
+
+        // Relinquish the bias: the object is released if no other thread
+        // holds a reference to it.
+
+        d_ownerDone = true;
+        return 1 == d_sharedCount.add(1);                             // RETURN
+    }
+
+    const int sharedCount = d_sharedCount.add(-2);
+
+    // A negative count indicates that this thread released a reference
+    // acquired by the owner thread, which would otherwise leak the object, as
+    // the biased count of the owner thread can no longer reach 0.
+
+    BSLS_ASSERT_OPT(0 <= sharedCount);
+
+    return 1 == sharedCount;
+}
+
+// ACCESSORS
+inline
+int IntrusivePtrBiasedCounter::count() const
+{
+    const int shared = d_sharedCount.load();
+
+    return (shared - (shared & 1)) / 2 + d_biasedCount;
+}
+
+inline
+bool IntrusivePtrBiasedCounter::isOwnedByCallingThread() const
+{
+    return d_hasOwner && isBiasedToCallingThread();
+}
+
+                           // ----------------------
+                           // class IntrusivePtrBase
+                           // ----------------------
+
+// CREATORS
+template <class COUNTER>
+inline
+IntrusivePtrBase<COUNTER>::IntrusivePtrBase(bslma::Allocator *basicAllocator)
+: d_counter()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class COUNTER>
+inline
+IntrusivePtrBase<COUNTER>::IntrusivePtrBase(const IntrusivePtrBase&,
+                                            bslma::Allocator *basicAllocator)
+: d_counter()
+, d_allocator_p(bslma::Default::allocator(basicAllocator))
+{
+}
+
+template <class COUNTER>
+inline
+IntrusivePtrBase<COUNTER>::~IntrusivePtrBase()
+{
+    BSLS_ASSERT_SAFE(0 == d_counter.count());
+}
+
+// MANIPULATORS
+template <class COUNTER>
+inline
+IntrusivePtrBase<COUNTER>&
+IntrusivePtrBase<COUNTER>::operator=(const IntrusivePtrBase&)
+{
+    return *this;
+}
+
+// ACCESSORS
+template <class COUNTER>
+inline
+void IntrusivePtrBase<COUNTER>::acquireRef() const
+{
+    d_counter.increment();
+}
+
+template <class COUNTER>
+inline
+bool IntrusivePtrBase<COUNTER>::releaseRef() const
+{
+    return d_counter.decrement();
+}
+
+template <class COUNTER>
+inline
+bslma::Allocator *IntrusivePtrBase<COUNTER>::allocator() const
+{
+    return d_allocator_p;
+}
+
+template <class COUNTER>
+inline
+int IntrusivePtrBase<COUNTER>::numReferences() const
+{
+    return d_counter.count();
+}
+
+                             // ------------------
+                             // class IntrusivePtr
+                             // ------------------
+
+// PRIVATE CLASS METHODS
+template <class TYPE>
+inline
+void IntrusivePtr<TYPE>::release(TYPE *ptr)
+{
+    if (ptr && ptr->releaseRef()) {
+        bslma::DeleterHelper::deleteObject(ptr, ptr->allocator());
+    }
+}
+
+// CREATORS
+template <class TYPE>
+inline
+IntrusivePtr<TYPE>::IntrusivePtr()
+: d_ptr_p(0)
+{
+}
+
+template <class TYPE>
+inline
+IntrusivePtr<TYPE>::IntrusivePtr(TYPE *ptr)
+: d_ptr_p(ptr)
+{
+    if (ptr) {
+        ptr->acquireRef();
+    }
+}
+
+template <class TYPE>
+inline
+IntrusivePtr<TYPE>::IntrusivePtr(const IntrusivePtr& original)
+: d_ptr_p(original.d_ptr_p)
+{
+    if (d_ptr_p) {
+        d_ptr_p->acquireRef();
+    }
+}
+
+template <class TYPE>
+template <class OTHER_TYPE>
+inline
+IntrusivePtr<TYPE>::IntrusivePtr(
+    const IntrusivePtr<OTHER_TYPE>& original,
+    typename bsl::enable_if<bsl::is_convertible<OTHER_TYPE *, TYPE *>::value,
+                            void>::type *)
+: d_ptr_p(original.d_ptr_p)
+{
+    if (d_ptr_p) {
+        d_ptr_p->acquireRef();
+    }
+}
+
+template <class TYPE>
+inline
+IntrusivePtr<TYPE>::~IntrusivePtr()
+{
+    release(d_ptr_p);
+}
+
+// MANIPULATORS
+template <class TYPE>
+inline
+IntrusivePtr<TYPE>& IntrusivePtr<TYPE>::operator=(const IntrusivePtr& rhs)
+{
+    // Acquiring the reference to 'rhs' first makes self-assignment safe.
+
+    TYPE *ptr = rhs.d_ptr_p;
+    if (ptr) {
+        ptr->acquireRef();
+    }
+    release(d_ptr_p);
+    d_ptr_p = ptr;
+
+    return *this;
+}
+
+template <class TYPE>
+template <class OTHER_TYPE>
+inline
+typename bsl::enable_if<bsl::is_convertible<OTHER_TYPE *, TYPE *>::value,
+                        IntrusivePtr<TYPE>&>::type
+IntrusivePtr<TYPE>::operator=(const IntrusivePtr<OTHER_TYPE>& rhs)
+{
+    TYPE *ptr = rhs.d_ptr_p;
+    if (ptr) {
+        ptr->acquireRef();
+    }
+    release(d_ptr_p);
+    d_ptr_p = ptr;
+
+    return *this;
+}
+
+template <class TYPE>
+inline
+void IntrusivePtr<TYPE>::reset()
+{
+    TYPE *ptr = d_ptr_p;
+    d_ptr_p = 0;
+    release(ptr);
+}
+
+template <class TYPE>
+inline
+void IntrusivePtr<TYPE>::reset(TYPE *ptr)
+{
+    if (ptr) {
+        ptr->acquireRef();
+    }
+    release(d_ptr_p);
+    d_ptr_p = ptr;
+}
+
+template <class TYPE>
+inline
+void IntrusivePtr<TYPE>::swap(IntrusivePtr& other)
+{
+    TYPE *ptr     = d_ptr_p;
+    d_ptr_p       = other.d_ptr_p;
+    other.d_ptr_p = ptr;
+}
+
+// ACCESSORS
+template <class TYPE>
+inline
+IntrusivePtr<TYPE>::operator BoolType() const
+{
+    return d_ptr_p ? bsls::UnspecifiedBool<IntrusivePtr>::trueValue()
+                   : bsls::UnspecifiedBool<IntrusivePtr>::falseValue();
+}
+
+template <class TYPE>
+inline
+TYPE& IntrusivePtr<TYPE>::operator*() const
+{
+    BSLS_ASSERT_SAFE(d_ptr_p);
+
+    return *d_ptr_p;
+}
+
+template <class TYPE>
+inline
+TYPE *IntrusivePtr<TYPE>::operator->() const
+{
+    BSLS_ASSERT_SAFE(d_ptr_p);
+
+    return d_ptr_p;
+}
+
+template <class TYPE>
+inline
+TYPE *IntrusivePtr<TYPE>::get() const
+{
+    return d_ptr_p;
+}
+
+}  // close package namespace
+
+// FREE OPERATORS
+template <class LHS_TYPE, class RHS_TYPE>
+inline
+bool bdlma::operator==(const IntrusivePtr<LHS_TYPE>& lhs,
+                       const IntrusivePtr<RHS_TYPE>& rhs)
+{
+    return lhs.get() == rhs.get();
+}
+
+template <class LHS_TYPE, class RHS_TYPE>
+inline
+bool bdlma::operator!=(const IntrusivePtr<LHS_TYPE>& lhs,
+                       const IntrusivePtr<RHS_TYPE>& rhs)
+{
+    return lhs.get() != rhs.get();
+}
+
+// FREE FUNCTIONS
+template <class TYPE>
+inline
+void bdlma::swap(IntrusivePtr<TYPE>& a, IntrusivePtr<TYPE>& b)
+{
+    a.swap(b);
+}
+
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
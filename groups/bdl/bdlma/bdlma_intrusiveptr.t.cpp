@@ -0,0 +1,1376 @@
+// bdlma_intrusiveptr.t.cpp                                           -*-C++-*-
+#include <bdlma_intrusiveptr.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bslmf_isconvertible.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>     // 'atoi'
+#include <bsl_iostream.h>
+#include <bsl_memory.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test provides three reference counters, a base class
+// holding a reference count and an allocator, and a smart pointer sharing
+// ownership of objects derived from the base class.  We verify the counts
+// maintained by each counter, including the biased counter updated by its
+// owner thread and by other threads, that the base class supplies its
+// allocator and does not copy its count, and that the smart pointer acquires
+// and releases references as it is created, copied, assigned, reset, and
+// destroyed, destroying the managed object (using its allocator) exactly once
+// when the last reference is released, also when the pointers are copied and
+// destroyed concurrently by several threads.
+//-----------------------------------------------------------------------------
+// CLASS 'bdlma::IntrusivePtrAtomicCounter'
+// CLASS 'bdlma::IntrusivePtrLocalCounter'
+//
+// [ 2] IntrusivePtrAtomicCounter();
+// [ 2] void increment();
+// [ 2] bool decrement();
+// [ 2] int count() const;
+// [ 2] IntrusivePtrLocalCounter();
+// [ 2] void increment();
+// [ 2] bool decrement();
+// [ 2] int count() const;
+//
+// CLASS 'bdlma::IntrusivePtrBiasedCounter'
+//
+// [ 3] IntrusivePtrBiasedCounter();
+// [ 3] void increment();
+// [ 3] bool decrement();
+// [ 3] int count() const;
+// [ 3] bool isOwnedByCallingThread() const;
+//
+// CLASS 'bdlma::IntrusivePtrBase'
+//
+// [ 4] IntrusivePtrBase(Allocator *basicAllocator = 0);
+// [ 4] IntrusivePtrBase(const IntrusivePtrBase& o, Allocator *ba = 0);
+// [ 4] IntrusivePtrBase& operator=(const IntrusivePtrBase& rhs);
+// [ 4] void acquireRef() const;
+// [ 4] bool releaseRef() const;
+// [ 4] bslma::Allocator *allocator() const;
+// [ 4] int numReferences() const;
+//
+// CLASS 'bdlma::IntrusivePtr'
+//
+// CREATORS
+// [ 5] IntrusivePtr();
+// [ 5] explicit IntrusivePtr(TYPE *ptr);
+// [ 5] IntrusivePtr(const IntrusivePtr& original);
+// [ 5] IntrusivePtr(const IntrusivePtr<OTHER_TYPE>& original);
+// [ 5] ~IntrusivePtr();
+//
+// MANIPULATORS
+// [ 5] IntrusivePtr& operator=(const IntrusivePtr& rhs);
+// [ 5] IntrusivePtr& operator=(const IntrusivePtr<OTHER_TYPE>& rhs);
+// [ 5] void reset();
+// [ 5] void reset(TYPE *ptr);
+// [ 5] void swap(IntrusivePtr& other);
+//
+// ACCESSORS
+// [ 5] operator BoolType() const;
+// [ 5] TYPE& operator*() const;
+// [ 5] TYPE *operator->() const;
+// [ 5] TYPE *get() const;
+//
+// FREE OPERATORS
+// [ 5] bool operator==(const IntrusivePtr<L>&, const IntrusivePtr<R>&);
+// [ 5] bool operator!=(const IntrusivePtr<L>&, const IntrusivePtr<R>&);
+// [ 5] void swap(IntrusivePtr<TYPE>& a, IntrusivePtr<TYPE>& b);
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 6] CONCURRENCY
+// [ 7] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST: COPYING BUFFER HANDLES
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_PASS(EXPR)     BSLS_ASSERTTEST_ASSERT_PASS(EXPR)
+#define ASSERT_OPT_FAIL(EXPR) BSLS_ASSERTTEST_ASSERT_OPT_FAIL(EXPR)
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::IntrusivePtrAtomicCounter AtomicCounter;
+typedef bdlma::IntrusivePtrLocalCounter  LocalCounter;
+typedef bdlma::IntrusivePtrBiasedCounter BiasedCounter;
+
+// ============================================================================
+//                      HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+                             // ================
+                             // class TestObject
+                             // ================
+
+template <class COUNTER>
+class TestObject : public bdlma::IntrusivePtrBase<COUNTER> {
+    // This class counts its destructions and holds a value.
+
+    // PRIVATE TYPES
+    typedef bdlma::IntrusivePtrBase<COUNTER> Base;
+
+    // DATA
+    bsls::AtomicInt *d_numDestroyed_p;  // incremented on destruction
+    int              d_value;           // value
+
+  public:
+    // CREATORS
+    TestObject(bsls::AtomicInt  *numDestroyed,
+               int               value,
+               bslma::Allocator *basicAllocator = 0)
+        // Create an object having the specified 'value' and incrementing the
+        // specified 'numDestroyed' when destroyed.  Optionally specify a
+        // 'basicAllocator' supplying the memory of this object.
+    : Base(basicAllocator)
+    , d_numDestroyed_p(numDestroyed)
+    , d_value(value)
+    {
+    }
+
+    TestObject(const TestObject& original, bslma::Allocator *basicAllocator)
+        // Create an object having the value of the specified 'original'
+        // object, using the specified 'basicAllocator'.
+    : Base(original, basicAllocator)
+    , d_numDestroyed_p(original.d_numDestroyed_p)
+    , d_value(original.d_value)
+    {
+    }
+
+    ~TestObject()
+        // Destroy this object.
+    {
+        ++*d_numDestroyed_p;
+    }
+
+    // MANIPULATORS
+    TestObject& operator=(const TestObject& rhs)
+        // Assign the value of the specified 'rhs' to this object.
+    {
+        Base::operator=(rhs);
+        d_value = rhs.d_value;
+        return *this;
+    }
+
+    // ACCESSORS
+    int value() const
+        // Return the value of this object.
+    {
+        return d_value;
+    }
+};
+
+                           // ===================
+                           // class TestBaseClass
+                           // ===================
+
+class TestBaseClass : public bdlma::IntrusivePtrBase<> {
+    // This polymorphic class counts its destructions.
+
+    // DATA
+    bsls::AtomicInt *d_numDestroyed_p;  // incremented on destruction
+
+  public:
+    // CREATORS
+    TestBaseClass(bsls::AtomicInt *numDestroyed, bslma::Allocator *ba)
+        // Create an object incrementing the specified 'numDestroyed' when
+        // destroyed, and whose memory is supplied by the specified 'ba'.
+    : bdlma::IntrusivePtrBase<>(ba)
+    , d_numDestroyed_p(numDestroyed)
+    {
+    }
+
+    virtual ~TestBaseClass()
+        // Destroy this object.
+    {
+        ++*d_numDestroyed_p;
+    }
+};
+
+                         // ======================
+                         // class TestDerivedClass
+                         // ======================
+
+class TestDerivedClass : public TestBaseClass {
+    // This class derives from 'TestBaseClass', and counts its own
+    // destructions.
+
+    // DATA
+    bsls::AtomicInt *d_numDerivedDestroyed_p;  // incremented on destruction
+    int              d_padding[8];             // makes the size differ
+
+  public:
+    // CREATORS
+    TestDerivedClass(bsls::AtomicInt  *numDestroyed,
+                     bsls::AtomicInt  *numDerivedDestroyed,
+                     bslma::Allocator *ba)
+        // Create an object incrementing the specified 'numDestroyed' and
+        // 'numDerivedDestroyed' when destroyed, and whose memory is supplied
+        // by the specified 'ba'.
+    : TestBaseClass(numDestroyed, ba)
+    , d_numDerivedDestroyed_p(numDerivedDestroyed)
+    {
+        d_padding[0] = 0;
+    }
+
+    ~TestDerivedClass()
+        // Destroy this object.
+    {
+        ++*d_numDerivedDestroyed_p;
+    }
+};
+
+                          // ======================
+                          // struct BiasedThreadArgs
+                          // ======================
+
+struct BiasedThreadArgs {
+    // This 'struct' holds the arguments and results of 'biasedThread'.
+
+    BiasedCounter  *d_counter_p;       // counter under test
+    int             d_numIncrements;   // number of increments to perform
+    int             d_numDecrements;   // number of decrements to perform
+    bool            d_isOwned;         // result of 'isOwnedByCallingThread'
+    int             d_count;           // count after the increments
+    bool            d_lastDecrement;   // result of the last decrement
+    bslmt::Barrier *d_barrier_p;       // if not 0, waited on twice between
+                                       // the increments and decrements
+};
+
+extern "C" void *biasedThread(void *arg)
+    // Increment, then decrement, the counter described by the specified
+    // 'arg', which must be the address of a 'BiasedThreadArgs' object, and
+    // record the observed results.  If a barrier is supplied, wait on it
+    // twice after the increments.
+{
+    BiasedThreadArgs *args = static_cast<BiasedThreadArgs *>(arg);
+
+    for (int i = 0; i < args->d_numIncrements; ++i) {
+        args->d_counter_p->increment();
+    }
+    args->d_isOwned = args->d_counter_p->isOwnedByCallingThread();
+    args->d_count   = args->d_counter_p->count();
+
+    if (args->d_barrier_p) {
+        args->d_barrier_p->wait();
+        args->d_barrier_p->wait();
+    }
+
+    for (int i = 0; i < args->d_numDecrements; ++i) {
+        args->d_lastDecrement = args->d_counter_p->decrement();
+    }
+    return 0;
+}
+
+extern "C" void *misusingThread(void *arg)
+    // Increment the specified 'arg', which must be the address of a
+    // 'BiasedCounter' object holding a reference of its owner thread, then
+    // decrement it twice, verifying that the second decrement, releasing the
+    // reference of the owner thread, is detected.
+{
+    BiasedCounter *counter = static_cast<BiasedCounter *>(arg);
+
+    counter->increment();
+
+    ASSERT_PASS(counter->decrement());
+    ASSERT_OPT_FAIL(counter->decrement());
+
+    return 0;
+}
+
+                               // =============
+                               // class CopyJob
+                               // =============
+
+template <class COUNTER>
+class CopyJob {
+    // This class provides a thread function that takes a copy of a shared
+    // pointer, and then repeatedly copies and releases it.
+
+    // PRIVATE TYPES
+    typedef bdlma::IntrusivePtr<TestObject<COUNTER> > Ptr;
+
+    // DATA
+    const Ptr      *d_source_p;       // pointer to copy
+    bslmt::Barrier *d_barrier_p;      // reached once 'd_source_p' is copied
+    int             d_numIterations;  // number of iterations
+
+  public:
+    // CREATORS
+    CopyJob(const Ptr *source, bslmt::Barrier *barrier, int numIterations)
+        // Create a job copying the specified 'source' and then waiting on the
+        // specified 'barrier', before performing the specified
+        // 'numIterations'.
+    : d_source_p(source)
+    , d_barrier_p(barrier)
+    , d_numIterations(numIterations)
+    {
+    }
+
+    // ACCESSORS
+    void operator()() const
+        // Run this job.
+    {
+        Ptr local(*d_source_p);
+        d_barrier_p->wait();
+
+        Ptr copies[8];
+        for (int i = 0; i < d_numIterations; ++i) {
+            for (int j = 0; j < 8; ++j) {
+                copies[j] = local;
+            }
+            ASSERT(7 == copies[i % 8]->value());
+            for (int j = 0; j < 8; ++j) {
+                copies[j].reset();
+            }
+        }
+    }
+};
+
+template <class COUNTER>
+void testConcurrency(bool ownerReleasesFirst, bool veryVerbose)
+    // Share an object using a 'COUNTER' between the main thread, which
+    // creates it, and several threads repeatedly copying and releasing
+    // pointers to it, releasing the reference of the main thread before
+    // joining the threads if the specified 'ownerReleasesFirst' is 'true',
+    // and after otherwise, and verify that the object is destroyed once.
+    // Print the progress if the specified 'veryVerbose' is 'true'.
+{
+    typedef bdlma::IntrusivePtr<TestObject<COUNTER> > Ptr;
+
+    enum { k_NUM_THREADS = 4, k_NUM_ITERATIONS = 20000 };
+
+    bslma::TestAllocator ta("object", false);
+    bsls::AtomicInt      numDestroyed(0);
+    {
+        Ptr mainPtr(new (ta) TestObject<COUNTER>(&numDestroyed, 7, &ta));
+
+        bslmt::Barrier barrier(k_NUM_THREADS + 1);
+
+        const CopyJob<COUNTER> job(&mainPtr, &barrier, k_NUM_ITERATIONS);
+
+        bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            ASSERT(0 == bslmt::ThreadUtil::create(&handles[i], job));
+        }
+        barrier.wait();
+
+        {
+            Ptr copies[8];
+            for (int i = 0; i < k_NUM_ITERATIONS; ++i) {
+                for (int j = 0; j < 8; ++j) {
+                    copies[j] = mainPtr;
+                }
+                for (int j = 0; j < 8; ++j) {
+                    copies[j].reset();
+                }
+            }
+        }
+
+        if (ownerReleasesFirst) {
+            mainPtr.reset();
+        }
+        for (int i = 0; i < k_NUM_THREADS; ++i) {
+            ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+        }
+        if (veryVerbose) {
+            P_(ownerReleasesFirst) P(numDestroyed);
+        }
+        ASSERTV(numDestroyed, ownerReleasesFirst == (1 == numDestroyed));
+    }
+    ASSERTV(numDestroyed, 1 == numDestroyed);
+    ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+}
+
+                              // ===============
+                              // class BufferRep
+                              // ===============
+
+template <class COUNTER>
+class BufferRep : public bdlma::IntrusivePtrBase<COUNTER> {
+    // This class holds a buffer of bytes whose reference count is maintained
+    // by a 'COUNTER'.
+
+    // PRIVATE TYPES
+    typedef bdlma::IntrusivePtrBase<COUNTER> Base;
+
+    // DATA
+    char *d_data_p;  // data (owned)
+
+  private:
+    // NOT IMPLEMENTED
+    BufferRep(const BufferRep&);
+    BufferRep& operator=(const BufferRep&);
+
+  public:
+    // CREATORS
+    BufferRep(int size, bslma::Allocator *basicAllocator)
+        // Create a buffer of the specified 'size', using the specified
+        // 'basicAllocator'.
+    : Base(basicAllocator)
+    , d_data_p(static_cast<char *>(basicAllocator->allocate(size)))
+    {
+    }
+
+    ~BufferRep()
+        // Destroy this object.
+    {
+        Base::allocator()->deallocate(d_data_p);
+    }
+};
+
+struct SharedBufferHandle {
+    // This 'struct' models a 'btlb::BlobBuffer': a shared pointer to a buffer
+    // and the size of the buffer.
+
+    bsl::shared_ptr<char> d_buffer;  // buffer
+    int                   d_size;    // size of 'd_buffer'
+};
+
+template <class COUNTER>
+struct IntrusiveBufferHandle {
+    // This 'struct' models a 'btlb::BlobBuffer' holding an intrusive pointer
+    // to a buffer.
+
+    bdlma::IntrusivePtr<BufferRep<COUNTER> > d_buffer;  // buffer
+    int                                      d_size;    // size of buffer
+};
+
+template <class HANDLE>
+double timeCopies(const HANDLE& source, int numCopies)
+    // Return the wall time, in seconds, taken to assign the specified
+    // 'source' to, and then reset, elements of an array, repeatedly, the
+    // specified 'numCopies' times in total.
+{
+    enum { k_NUM_HANDLES = 64 };
+
+    bsl::vector<HANDLE> handles(k_NUM_HANDLES);
+    const HANDLE        empty = HANDLE();
+
+    bsls::Stopwatch timer;
+    timer.start();
+
+    for (int i = 0; i < numCopies / k_NUM_HANDLES; ++i) {
+        for (int j = 0; j < k_NUM_HANDLES; ++j) {
+            handles[j] = source;
+        }
+        for (int j = 0; j < k_NUM_HANDLES; ++j) {
+            handles[j] = empty;
+        }
+    }
+
+    timer.stop();
+    return timer.accumulatedWallTime();
+}
+
+// ============================================================================
+//                                USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace BDLMA_INTRUSIVEPTR_USAGE_EXAMPLE {
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sharing Buffers Within a Single Thread
+///- - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a thread assembling a message shares the buffers holding the
+// data of the message between the several views of the message it builds.
+// The buffers never leave the thread, so their reference counts need not be
+// atomic.
+//
+// First, we define a buffer type holding its reference count:
+//..
+typedef bdlma::IntrusivePtrBase<bdlma::IntrusivePtrLocalCounter>
+                                                                LocalBase;
+
+class Buffer : public LocalBase {
+    // This class holds a fixed-size array of bytes.
+
+    // DATA
+    char *d_data_p;  // data (owned)
+    int   d_size;    // size of 'd_data_p'
+
+  private:
+    // NOT IMPLEMENTED
+    Buffer(const Buffer&);
+    Buffer& operator=(const Buffer&);
+
+  public:
+    // CREATORS
+    explicit Buffer(int size, bslma::Allocator *basicAllocator = 0)
+        // Create a buffer of the specified 'size' bytes.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator
+        // is used.
+    : LocalBase(basicAllocator)
+    , d_data_p(static_cast<char *>(allocator()->allocate(size)))
+    , d_size(size)
+    {
+    }
+
+    ~Buffer()
+        // Destroy this buffer.
+    {
+        allocator()->deallocate(d_data_p);
+    }
+
+    // ACCESSORS
+    char *data() const { return d_data_p; }
+        // Return the address of the data of this buffer.
+
+    int size() const { return d_size; }
+        // Return the size of this buffer.
+};
+//..
+// Note that 'allocator()', supplied by the base class, returns the allocator
+// of the buffer, which the buffer uses to allocate its data.
+//
+
+}  // close namespace BDLMA_INTRUSIVEPTR_USAGE_EXAMPLE
+
+// ============================================================================
+//                            MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int  test            = argc > 1 ? atoi(argv[1]) : 0;
+    const bool verbose         = argc > 2;
+    const bool veryVerbose     = argc > 3;
+    const bool veryVeryVerbose = argc > 4;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator da("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    switch (test) { case 0:
+      case 7: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+        using namespace BDLMA_INTRUSIVEPTR_USAGE_EXAMPLE;
+
+// Then, we create a buffer, managed by an intrusive pointer:
+//..
+    bslma::TestAllocator ta;
+
+    bdlma::IntrusivePtr<Buffer> buffer(new (ta) Buffer(1024, &ta));
+    ASSERT(1 == buffer->numReferences());
+    ASSERT(2 == ta.numBlocksInUse());
+//..
+// Note that, unlike a 'bsl::shared_ptr' adopting an object, the intrusive
+// pointer allocates no representation.
+//
+// Next, we share the buffer between two views of the message; copying the
+// pointer increments the reference count of the buffer with a plain,
+// non-atomic, increment:
+//..
+    bdlma::IntrusivePtr<Buffer> header(buffer);
+    bdlma::IntrusivePtr<Buffer> body(buffer);
+    ASSERT(3 == buffer->numReferences());
+    ASSERT(header.get() == body.get());
+//..
+// Now, we release the original pointer, leaving the views sharing the buffer:
+//..
+    buffer.reset();
+    ASSERT(2 == header->numReferences());
+    ASSERT(2 == ta.numBlocksInUse());
+//..
+// Finally, we release the views, and observe that the buffer is destroyed
+// with the last reference, its memory returned to its allocator:
+//..
+    header.reset();
+    body.reset();
+    ASSERT(0 == ta.numBlocksInUse());
+//..
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY
+        //
+        // Concerns:
+        //: 1 Pointers to an object using an atomic or a biased counter may be
+        //:   copied and destroyed concurrently by several threads.
+        //:
+        //: 2 The object is destroyed exactly once, by the thread releasing
+        //:   the last reference, whether it is the thread that created the
+        //:   object (the owner thread of a biased counter) or another thread.
+        //
+        // Plan:
+        //: 1 For each of the atomic and biased counters, create an object in
+        //:   the main thread, and run several threads copying a pointer to it
+        //:   and then repeatedly copying and releasing their copy, while the
+        //:   main thread does the same.  (C-1)
+        //:
+        //: 2 Release the pointer of the main thread before or after joining
+        //:   the threads, and verify that the object is destroyed once, and
+        //:   only after the last pointer is released.  (C-2)
+        //
+        // Testing:
+        //   CONCURRENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY" << endl
+                          << "===========" << endl;
+
+        if (verbose) cout << "\nAtomic counter." << endl;
+
+        testConcurrency<AtomicCounter>(true,  veryVerbose);
+        testConcurrency<AtomicCounter>(false, veryVerbose);
+
+        if (verbose) cout << "\nBiased counter." << endl;
+
+        testConcurrency<BiasedCounter>(true,  veryVerbose);
+        testConcurrency<BiasedCounter>(false, veryVerbose);
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // INTRUSIVE POINTER
+        //
+        // Concerns:
+        //: 1 A default-constructed pointer is empty, and converts to 'false'.
+        //:
+        //: 2 Creating a pointer to an object, or copying a pointer, acquires
+        //:   a reference to the object, and destroying the pointer releases
+        //:   it.
+        //:
+        //: 3 The object is destroyed, and its memory returned to its
+        //:   allocator, when the last reference to it is released, and not
+        //:   before.
+        //:
+        //: 4 Assignment (including self-assignment), 'reset', and 'swap'
+        //:   update the references as expected.
+        //:
+        //: 5 A pointer to a derived class converts to a pointer to a base
+        //:   class (but not the reverse), and an object having a virtual
+        //:   destructor is destroyed through a pointer to its base class, its
+        //:   memory deallocated correctly.
+        //:
+        //: 6 The accessors and comparison operators return the managed
+        //:   object.
+        //
+        // Plan:
+        //: 1 Using objects counting their destructions, allocated from a test
+        //:   allocator, exercise each creator, manipulator, and accessor,
+        //:   verifying the reference counts, the number of destructions, and
+        //:   the memory in use after each operation.  (C-1..6)
+        //
+        // Testing:
+        //   IntrusivePtr();
+        //   explicit IntrusivePtr(TYPE *ptr);
+        //   IntrusivePtr(const IntrusivePtr& original);
+        //   IntrusivePtr(const IntrusivePtr<OTHER_TYPE>& original);
+        //   ~IntrusivePtr();
+        //   IntrusivePtr& operator=(const IntrusivePtr& rhs);
+        //   IntrusivePtr& operator=(const IntrusivePtr<OTHER_TYPE>& rhs);
+        //   void reset();
+        //   void reset(TYPE *ptr);
+        //   void swap(IntrusivePtr& other);
+        //   operator BoolType() const;
+        //   TYPE& operator*() const;
+        //   TYPE *operator->() const;
+        //   TYPE *get() const;
+        //   bool operator==(const IntrusivePtr<L>&, const IntrusivePtr<R>&);
+        //   bool operator!=(const IntrusivePtr<L>&, const IntrusivePtr<R>&);
+        //   void swap(IntrusivePtr<TYPE>& a, IntrusivePtr<TYPE>& b);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INTRUSIVE POINTER" << endl
+                          << "=================" << endl;
+
+        typedef TestObject<LocalCounter>       Object;
+        typedef bdlma::IntrusivePtr<Object>    Ptr;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        bsls::AtomicInt      numDestroyed(0);
+
+        if (verbose) cout << "\nEmpty pointers." << endl;
+        {
+            const Ptr X;
+            ASSERT(0 == X.get());
+            ASSERT(!X);
+            ASSERT(X == Ptr());
+
+            const Ptr Y(0);
+            ASSERT(0 == Y.get());
+            ASSERT(X == Y);
+        }
+
+        if (verbose) cout << "\nCreating, copying, and destroying." << endl;
+        {
+            Object *p = new (ta) Object(&numDestroyed, 1, &ta);
+            ASSERT(0 == p->numReferences());
+            {
+                const Ptr X(p);
+                ASSERT(p == X.get());
+                ASSERT(X);
+                ASSERT(1 == p->numReferences());
+                ASSERT(p == &*X);
+                ASSERT(1 == X->value());
+                {
+                    const Ptr Y(X);
+                    ASSERT(p == Y.get());
+                    ASSERT(2 == p->numReferences());
+                    ASSERT(X == Y);
+                    ASSERT(!(X != Y));
+                }
+                ASSERT(1 == p->numReferences());
+                ASSERT(0 == numDestroyed);
+                ASSERT(1 == ta.numBlocksInUse());
+            }
+            ASSERT(1 == numDestroyed);
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nAssignment." << endl;
+        {
+            numDestroyed = 0;
+
+            Object *p = new (ta) Object(&numDestroyed, 1, &ta);
+            Object *q = new (ta) Object(&numDestroyed, 2, &ta);
+
+            Ptr mX(p);  const Ptr& X = mX;
+            Ptr mY(q);  const Ptr& Y = mY;
+            ASSERT(X != Y);
+
+            Ptr *mR = &(mX = X);
+            ASSERT(mR == &mX);
+            ASSERT(p == X.get());
+            ASSERT(1 == p->numReferences());
+
+            mR = &(mX = Y);
+            ASSERT(mR == &mX);
+            ASSERT(1 == numDestroyed);
+            ASSERT(q == X.get());
+            ASSERT(2 == q->numReferences());
+            ASSERT(1 == ta.numBlocksInUse());
+
+            mX = Ptr();
+            ASSERT(!X);
+            ASSERT(1 == q->numReferences());
+
+            mY = X;
+            ASSERT(2 == numDestroyed);
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nReset and swap." << endl;
+        {
+            numDestroyed = 0;
+
+            Object *p = new (ta) Object(&numDestroyed, 1, &ta);
+            Object *q = new (ta) Object(&numDestroyed, 2, &ta);
+
+            Ptr mX(p);  const Ptr& X = mX;
+            Ptr mY;     const Ptr& Y = mY;
+
+            mX.swap(mY);
+            ASSERT(!X);
+            ASSERT(p == Y.get());
+            ASSERT(1 == p->numReferences());
+
+            bdlma::swap(mX, mY);
+            ASSERT(p == X.get());
+            ASSERT(!Y);
+
+            mY.reset(p);
+            ASSERT(2 == p->numReferences());
+
+            mX.reset(p);
+            ASSERT(2 == p->numReferences());
+
+            mX.reset(q);
+            ASSERT(1 == p->numReferences());
+            ASSERT(1 == q->numReferences());
+
+            mY.reset(0);
+            ASSERT(!Y);
+            ASSERT(1 == numDestroyed);
+
+            mX.reset();
+            ASSERT(!X);
+            ASSERT(2 == numDestroyed);
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+
+        if (verbose) cout << "\nDerived to base conversion." << endl;
+        {
+            typedef bdlma::IntrusivePtr<TestBaseClass>    BasePtr;
+            typedef bdlma::IntrusivePtr<TestDerivedClass> DerivedPtr;
+
+            numDestroyed = 0;
+            bsls::AtomicInt numDerivedDestroyed(0);
+
+            TestDerivedClass *p = new (ta) TestDerivedClass(
+                                                          &numDestroyed,
+                                                          &numDerivedDestroyed,
+                                                          &ta);
+            {
+                DerivedPtr mD(p);
+                BasePtr    mB(mD);
+                ASSERT(p == mB.get());
+                ASSERT(mB == mD);
+                ASSERT(2 == p->numReferences());
+
+                BasePtr mC;
+                mC = mD;
+                ASSERT(3 == p->numReferences());
+
+                mD.reset();
+                mC.reset();
+                ASSERT(1 == p->numReferences());
+                ASSERT(0 == numDestroyed);
+            }
+            ASSERT(1 == numDestroyed);
+            ASSERT(1 == numDerivedDestroyed);
+
+            // A pointer to a base class does not convert to a pointer to a
+            // derived class.
+
+            ASSERT( (bsl::is_convertible<DerivedPtr, BasePtr>::value));
+            ASSERT(!(bsl::is_convertible<BasePtr, DerivedPtr>::value));
+            ASSERT(0 == ta.numBlocksInUse());
+        }
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // INTRUSIVE POINTER BASE
+        //
+        // Concerns:
+        //: 1 The base class supplies the allocator passed at construction, or
+        //:   the default allocator if none is passed.
+        //:
+        //: 2 The reference count of a newly created object is 0, and is
+        //:   updated by 'acquireRef' and 'releaseRef', the latter returning
+        //:   'true' when releasing the last reference.
+        //:
+        //: 3 Copying or assigning an object neither copies the reference
+        //:   count nor changes the allocator.
+        //:
+        //: 4 Each counter may be used.
+        //
+        // Plan:
+        //: 1 Create objects of a class derived from the base class, using
+        //:   each counter, with and without an allocator, copy and assign
+        //:   them, and verify their allocators and reference counts.
+        //:   (C-1..4)
+        //
+        // Testing:
+        //   IntrusivePtrBase(Allocator *basicAllocator = 0);
+        //   IntrusivePtrBase(const IntrusivePtrBase& o, Allocator *ba = 0);
+        //   IntrusivePtrBase& operator=(const IntrusivePtrBase& rhs);
+        //   void acquireRef() const;
+        //   bool releaseRef() const;
+        //   bslma::Allocator *allocator() const;
+        //   int numReferences() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "INTRUSIVE POINTER BASE" << endl
+                          << "======================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        bslma::TestAllocator tb("other", veryVeryVerbose);
+        bsls::AtomicInt      numDestroyed(0);
+
+        if (verbose) cout << "\nAllocator." << endl;
+        {
+            const TestObject<AtomicCounter> X(&numDestroyed, 1);
+            ASSERT(&da == X.allocator());
+
+            const TestObject<LocalCounter>  Y(&numDestroyed, 2, &ta);
+            ASSERT(&ta == Y.allocator());
+
+            const TestObject<BiasedCounter> Z(&numDestroyed, 3, 0);
+            ASSERT(&da == Z.allocator());
+        }
+
+        if (verbose) cout << "\nReference count." << endl;
+        {
+            const TestObject<AtomicCounter> X(&numDestroyed, 1, &ta);
+            const TestObject<LocalCounter>  Y(&numDestroyed, 2, &ta);
+            const TestObject<BiasedCounter> Z(&numDestroyed, 3, &ta);
+
+            ASSERT(0 == X.numReferences());
+            ASSERT(0 == Y.numReferences());
+            ASSERT(0 == Z.numReferences());
+
+            for (int i = 1; i <= 3; ++i) {
+                X.acquireRef();
+                Y.acquireRef();
+                Z.acquireRef();
+
+                ASSERTV(i, X.numReferences(), i == X.numReferences());
+                ASSERTV(i, Y.numReferences(), i == Y.numReferences());
+                ASSERTV(i, Z.numReferences(), i == Z.numReferences());
+            }
+            for (int i = 2; i >= 0; --i) {
+                ASSERTV(i, (0 == i) == X.releaseRef());
+                ASSERTV(i, (0 == i) == Y.releaseRef());
+                ASSERTV(i, (0 == i) == Z.releaseRef());
+
+                ASSERTV(i, X.numReferences(), i == X.numReferences());
+                ASSERTV(i, Y.numReferences(), i == Y.numReferences());
+                ASSERTV(i, Z.numReferences(), i == Z.numReferences());
+            }
+        }
+
+        if (verbose) cout << "\nCopying and assigning." << endl;
+        {
+            TestObject<LocalCounter> mX(&numDestroyed, 1, &ta);
+            const TestObject<LocalCounter>& X = mX;
+
+            X.acquireRef();
+            X.acquireRef();
+
+            TestObject<LocalCounter> mY(X, &tb);
+            const TestObject<LocalCounter>& Y = mY;
+            ASSERT(1   == Y.value());
+            ASSERT(&tb == Y.allocator());
+            ASSERT(0   == Y.numReferences());
+            ASSERT(2   == X.numReferences());
+
+            TestObject<LocalCounter> mZ(&numDestroyed, 3, &tb);
+            const TestObject<LocalCounter>& Z = mZ;
+            Z.acquireRef();
+
+            mZ = X;
+            ASSERT(1   == Z.value());
+            ASSERT(&tb == Z.allocator());
+            ASSERT(1   == Z.numReferences());
+            ASSERT(2   == X.numReferences());
+
+            mX = Z;
+            ASSERT(&ta == X.allocator());
+            ASSERT(2   == X.numReferences());
+
+            X.releaseRef();
+            X.releaseRef();
+            Z.releaseRef();
+        }
+        ASSERTV(da.numBlocksTotal(), 0 == da.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // BIASED COUNTER
+        //
+        // Concerns:
+        //: 1 A newly created counter has a count of 0 and no owner thread.
+        //:
+        //: 2 The thread first incrementing the counter becomes its owner
+        //:   thread, and other threads are not owners.
+        //:
+        //: 3 The count includes the references of the owner thread and of
+        //:   the other threads.
+        //:
+        //: 4 'decrement' returns 'true' only when the last reference is
+        //:   released, whether by the owner thread or by another thread.
+        //:
+        //: 5 Once the owner thread has released its references, it no longer
+        //:   owns the counter, and the references it acquires afterwards are
+        //:   counted with those of the other threads.
+        //:
+        //: 6 The owner thread is the thread first incrementing the counter,
+        //:   not the thread creating it.
+        //:
+        //: 7 Another thread releasing a reference acquired by the owner
+        //:   thread is detected in all build modes.
+        //
+        // Plan:
+        //: 1 Increment and decrement counters from the main thread and from
+        //:   other threads, verifying the ownership, the count, and the
+        //:   result of each decrement.  (C-1..6)
+        //:
+        //: 2 Have another thread release one more reference than it
+        //:   acquired, and verify that the release is detected using the
+        //:   'BSLS_ASSERTTEST_*' macros.  (C-7)
+        //
+        // Testing:
+        //   IntrusivePtrBiasedCounter();
+        //   void increment();
+        //   bool decrement();
+        //   int count() const;
+        //   bool isOwnedByCallingThread() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BIASED COUNTER" << endl
+                          << "==============" << endl;
+
+        bslmt::ThreadUtil::Handle handle;
+
+        if (verbose) cout << "\nOwner thread only." << endl;
+        {
+            BiasedCounter mX;  const BiasedCounter& X = mX;
+            ASSERT(0 == X.count());
+            ASSERT(!X.isOwnedByCallingThread());
+
+            mX.increment();
+            ASSERT(X.isOwnedByCallingThread());
+            ASSERT(1 == X.count());
+
+            mX.increment();
+            ASSERT(2 == X.count());
+
+            ASSERT(!mX.decrement());
+            ASSERT(1 == X.count());
+            ASSERT(X.isOwnedByCallingThread());
+
+            ASSERT(mX.decrement());
+            ASSERT(0 == X.count());
+            ASSERT(!X.isOwnedByCallingThread());
+        }
+
+        if (verbose) cout << "\nOwner thread releases last." << endl;
+        {
+            BiasedCounter mX;  const BiasedCounter& X = mX;
+            mX.increment();
+
+            BiasedThreadArgs args = { &mX, 3, 3, true, 0, true, 0 };
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  &biasedThread,
+                                                  &args));
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+            ASSERT(!args.d_isOwned);
+            ASSERTV(args.d_count, 4 == args.d_count);
+            ASSERT(!args.d_lastDecrement);
+
+            ASSERT(X.isOwnedByCallingThread());
+            ASSERT(1 == X.count());
+            ASSERT(mX.decrement());
+        }
+
+        if (verbose) cout << "\nOther thread releases last." << endl;
+        {
+            BiasedCounter mX;  const BiasedCounter& X = mX;
+            mX.increment();
+            mX.increment();
+
+            bslmt::Barrier   barrier(2);
+            BiasedThreadArgs args = { &mX, 1, 1, true, 0, false, &barrier };
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  &biasedThread,
+                                                  &args));
+            barrier.wait();
+
+            ASSERT(!args.d_isOwned);
+            ASSERTV(args.d_count, 3 == args.d_count);
+
+            ASSERT(!mX.decrement());
+            ASSERT(!mX.decrement());
+            ASSERT(!X.isOwnedByCallingThread());
+            ASSERT(1 == X.count());
+
+            // The former owner now counts its references as another thread.
+
+            mX.increment();
+            ASSERT(!X.isOwnedByCallingThread());
+            ASSERT(2 == X.count());
+            ASSERT(!mX.decrement());
+            ASSERT(1 == X.count());
+
+            barrier.wait();
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+            ASSERT(args.d_lastDecrement);
+            ASSERT(0 == X.count());
+        }
+
+        if (verbose) cout << "\nOwned by the first incrementing thread."
+                          << endl;
+        {
+            BiasedCounter mX;  const BiasedCounter& X = mX;
+
+            BiasedThreadArgs args = { &mX, 2, 2, false, 0, false, 0 };
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  &biasedThread,
+                                                  &args));
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+            ASSERT(args.d_isOwned);
+            ASSERTV(args.d_count, 2 == args.d_count);
+            ASSERT(args.d_lastDecrement);
+            ASSERT(!X.isOwnedByCallingThread());
+            ASSERT(0 == X.count());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertFailureHandlerGuard hG(
+                                             bsls::AssertTest::failTestDriver);
+
+            // The counter is left inconsistent, and is not used afterwards.
+
+            BiasedCounter mX;
+            mX.increment();
+
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  &misusingThread,
+                                                  &mX));
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // ATOMIC AND LOCAL COUNTERS
+        //
+        // Concerns:
+        //: 1 A newly created counter has a count of 0.
+        //:
+        //: 2 'increment' and 'decrement' update the count, and 'decrement'
+        //:   returns 'true' only when the count reaches 0.
+        //
+        // Plan:
+        //: 1 Increment counters up to a number of references, and decrement
+        //:   them back to 0, verifying the count and the result of each
+        //:   decrement.  (C-1..2)
+        //
+        // Testing:
+        //   IntrusivePtrAtomicCounter();
+        //   void increment();
+        //   bool decrement();
+        //   int count() const;
+        //   IntrusivePtrLocalCounter();
+        //   void increment();
+        //   bool decrement();
+        //   int count() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ATOMIC AND LOCAL COUNTERS" << endl
+                          << "=========================" << endl;
+
+        for (int n = 1; n <= 5; ++n) {
+            AtomicCounter mA;  const AtomicCounter& A = mA;
+            LocalCounter  mL;  const LocalCounter&  L = mL;
+
+            ASSERT(0 == A.count());
+            ASSERT(0 == L.count());
+
+            for (int i = 1; i <= n; ++i) {
+                mA.increment();
+                mL.increment();
+                ASSERTV(n, i, A.count(), i == A.count());
+                ASSERTV(n, i, L.count(), i == L.count());
+            }
+            for (int i = n - 1; i >= 0; --i) {
+                ASSERTV(n, i, (0 == i) == mA.decrement());
+                ASSERTV(n, i, (0 == i) == mL.decrement());
+                ASSERTV(n, i, A.count(), i == A.count());
+                ASSERTV(n, i, L.count(), i == L.count());
+            }
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object managed by intrusive pointers, copy and release
+        //:   the pointers, and verify that the object is destroyed with the
+        //:   last pointer.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        typedef TestObject<AtomicCounter>   Object;
+        typedef bdlma::IntrusivePtr<Object> Ptr;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        bsls::AtomicInt      numDestroyed(0);
+        {
+            Ptr mX(new (ta) Object(&numDestroyed, 5, &ta));
+            ASSERT(5 == mX->value());
+
+            Ptr mY(mX);
+            ASSERT(2 == mX->numReferences());
+
+            mX.reset();
+            ASSERT(1 == mY->numReferences());
+            ASSERT(0 == numDestroyed);
+        }
+        ASSERT(1 == numDestroyed);
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST: COPYING BUFFER HANDLES
+        //   Compare the time taken to copy and release buffer handles modeled
+        //   on 'btlb::BlobBuffer', holding a 'bsl::shared_ptr<char>', with
+        //   that for handles holding an intrusive pointer using each counter,
+        //   all handles being copied in a single thread.
+        //
+        //   Usage: <driver> -1 [numCopies]
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST: COPYING BUFFER HANDLES" << endl
+                          << "========================================"
+                          << endl;
+
+        const int NUM_COPIES = argc > 2 ? atoi(argv[2]) : 10000000;
+        const int SIZE       = 1024;
+
+        bslma::TestAllocator ta("object", false);
+
+        SharedBufferHandle sharedHandle;
+        sharedHandle.d_buffer.reset(static_cast<char *>(ta.allocate(SIZE)),
+                                    &ta);
+        sharedHandle.d_size = SIZE;
+
+        IntrusiveBufferHandle<AtomicCounter> atomicHandle;
+        atomicHandle.d_buffer.reset(new (ta) BufferRep<AtomicCounter>(SIZE,
+                                                                      &ta));
+        atomicHandle.d_size = SIZE;
+
+        IntrusiveBufferHandle<LocalCounter> localHandle;
+        localHandle.d_buffer.reset(new (ta) BufferRep<LocalCounter>(SIZE,
+                                                                    &ta));
+        localHandle.d_size = SIZE;
+
+        IntrusiveBufferHandle<BiasedCounter> biasedHandle;
+        biasedHandle.d_buffer.reset(new (ta) BufferRep<BiasedCounter>(SIZE,
+                                                                      &ta));
+        biasedHandle.d_size = SIZE;
+
+        const double shared = timeCopies(sharedHandle, NUM_COPIES);
+        const double atomic = timeCopies(atomicHandle, NUM_COPIES);
+        const double local  = timeCopies(localHandle,  NUM_COPIES);
+        const double biased = timeCopies(biasedHandle, NUM_COPIES);
+
+        // Report nanoseconds per copy (including the release of the copy).
+
+        printf("%12s %12s %12s %12s\n",
+               "shared_ptr", "atomic", "local", "biased");
+        printf("%12.2f %12.2f %12.2f %12.2f\n",
+               shared / NUM_COPIES * 1e9,
+               atomic / NUM_COPIES * 1e9,
+               local  / NUM_COPIES * 1e9,
+               biased / NUM_COPIES * 1e9);
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
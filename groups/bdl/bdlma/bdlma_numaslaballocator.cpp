@@ -0,0 +1,657 @@
+// bdlma_numaslaballocator.cpp                                        -*-C++-*-
+#include <bdlma_numaslaballocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_numaslaballocator_cpp,"$Id$ $CSID$")
+
+#include <bdlma_concurrentpool.h>
+
+#include <bdlb_bitutil.h>
+
+#include <bslmt_lockguard.h>
+
+#include <bslma_autodestructor.h>
+#include <bslma_deallocatorproctor.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_assert.h>
+#include <bsls_blockgrowth.h>
+#include <bsls_exceptionutil.h>      // 'BSLS_THROW'
+#include <bsls_performancehint.h>
+#include <bsls_platform.h>
+
+#include <bsl_cstdint.h>
+#include <bsl_cstdio.h>              // 'fopen', 'fgets'
+#include <bsl_cstdlib.h>             // 'strtol'
+#include <bsl_new.h>                 // 'bsl::bad_alloc'
+
+#include <new>                       // placement 'new'
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+#include <sched.h>                   // 'sched_getcpu'
+#include <sys/mman.h>                // 'mmap', 'munmap'
+#include <sys/syscall.h>             // 'SYS_mbind'
+#include <unistd.h>                  // 'syscall'
+
+#endif
+
+namespace BloombergLP {
+namespace {
+
+typedef bsls::Types::size_type size_type;
+
+enum {
+    k_DEFAULT_NUM_POOLS      = 10,
+    k_DEFAULT_MAX_CHUNK_SIZE = 32,
+    k_MIN_BLOCK_SIZE         = 8,
+    k_MAX_NUM_POOLS          = 29,
+    k_MIN_REGION_SIZE        = 64 * 1024,        // size of first region
+    k_MAX_REGION_SIZE        = 4 * 1024 * 1024   // size of regions once grown
+};
+
+// HELPER FUNCTIONS
+inline
+int findPool(size_type size)
+    // Return the index of the pool dispensing blocks of the smallest size not
+    // less than the specified 'size'.  The behavior is undefined unless
+    // '0 < size'.
+{
+    return 31 - bdlb::BitUtil::numLeadingUnsetBits(static_cast<bsl::uint32_t>(
+                                ((size + k_MIN_BLOCK_SIZE - 1) >> 3) * 2 - 1));
+}
+
+int parseList(bsl::vector<int> *result, const char *text)
+    // Append to the specified 'result' the integers in the specified 'text',
+    // having the format of the lists of the Linux 'sysfs' file system (e.g.,
+    // "0-3,8,10-11").  Return 0 on success, and a non-zero value otherwise.
+{
+    while (*text && '\n' != *text) {
+        char *end;
+        long  first = bsl::strtol(text, &end, 10);
+        if (end == text || first < 0) {
+            return -1;                                                // RETURN
+        }
+        long last = first;
+        text      = end;
+        if ('-' == *text) {
+            ++text;
+            last = bsl::strtol(text, &end, 10);
+            if (end == text || last < first) {
+                return -1;                                            // RETURN
+            }
+            text = end;
+        }
+        for (long i = first; i <= last; ++i) {
+            result->push_back(static_cast<int>(i));
+        }
+        if (',' == *text) {
+            ++text;
+        }
+    }
+    return 0;
+}
+
+int readList(bsl::vector<int> *result, const char *path)
+    // Append to the specified 'result' the integers in the list held by the
+    // file at the specified 'path' (see 'parseList').  Return 0 on success,
+    // and a non-zero value otherwise.
+{
+    bsl::FILE *file = bsl::fopen(path, "r");
+    if (!file) {
+        return -1;                                                    // RETURN
+    }
+
+    char buffer[4096];
+    const bool isRead = 0 != bsl::fgets(buffer, sizeof buffer, file);
+    bsl::fclose(file);
+
+    return isRead ? parseList(result, buffer) : -1;
+}
+
+int loadTopology(bsl::vector<int> *cpuNodes)
+    // Load into the specified 'cpuNodes' the index of the NUMA node of each
+    // processor of the machine, and return the number of nodes of the machine
+    // (i.e., one more than the largest node index).  If the topology cannot be
+    // determined, clear 'cpuNodes' and return 1.
+{
+    cpuNodes->clear();
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+    bsl::vector<int> nodes(cpuNodes->get_allocator());
+    if (0 != readList(&nodes, "/sys/devices/system/node/online")
+     || nodes.empty()) {
+        return 1;                                                     // RETURN
+    }
+
+    int numNodes = 1;
+    for (bsl::size_t i = 0; i < nodes.size(); ++i) {
+        char path[64];
+        bsl::sprintf(path,
+                     "/sys/devices/system/node/node%d/cpulist",
+                     nodes[i]);
+
+        bsl::vector<int> cpus(cpuNodes->get_allocator());
+        if (0 != readList(&cpus, path)) {
+            cpuNodes->clear();
+            return 1;                                                 // RETURN
+        }
+        for (bsl::size_t j = 0; j < cpus.size(); ++j) {
+            if (cpuNodes->size() <= static_cast<bsl::size_t>(cpus[j])) {
+                cpuNodes->resize(cpus[j] + 1, 0);
+            }
+            (*cpuNodes)[cpus[j]] = nodes[i];
+        }
+        if (numNodes <= nodes[i]) {
+            numNodes = nodes[i] + 1;
+        }
+    }
+    return numNodes;
+
+#else
+
+    return 1;
+
+#endif
+}
+
+void *mapRegion(size_type size)
+    // Map the specified 'size' bytes of memory from the operating system, and
+    // return their address, or 0 if the mapping fails.
+{
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+    void *address = mmap(0,
+                         size,
+                         PROT_READ | PROT_WRITE,
+                         MAP_ANONYMOUS | MAP_PRIVATE,
+                         -1,
+                         0);
+
+    return MAP_FAILED == address ? 0 : address;
+
+#else
+
+    (void)size;
+    return 0;
+
+#endif
+}
+
+void unmapRegion(void *address, size_type size)
+    // Unmap the specified 'size' bytes of memory at the specified 'address'.
+    // The behavior is undefined unless the memory was mapped by 'mapRegion'.
+{
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+    munmap(static_cast<char *>(address), size);
+
+#else
+
+    (void)address;
+    (void)size;
+
+#endif
+}
+
+void bindRegion(void *address, size_type size, int node)
+    // Set the memory policy of the specified 'size' bytes of memory at the
+    // specified 'address' to prefer the specified 'node'.  Failures are
+    // ignored.  The behavior is undefined unless the memory was mapped by
+    // 'mapRegion'.
+{
+#if defined(BSLS_PLATFORM_OS_LINUX) && defined(SYS_mbind)
+
+    enum {
+        k_MPOL_PREFERRED = 1,                         // from '<numaif.h>'
+        k_MAX_NODES      = 1024,
+        k_WORD_BITS      = sizeof(unsigned long) * 8
+    };
+
+    if (node < k_MAX_NODES) {
+        unsigned long mask[k_MAX_NODES / k_WORD_BITS] = { 0 };
+        mask[node / k_WORD_BITS] |= 1UL << (node % k_WORD_BITS);
+
+        syscall(SYS_mbind,
+                address,
+                size,
+                static_cast<int>(k_MPOL_PREFERRED),
+                mask,
+                static_cast<unsigned long>(k_MAX_NODES + 1),
+                0U);
+    }
+
+#else
+
+    (void)address;
+    (void)size;
+    (void)node;
+
+#endif
+}
+
+                           // =====================
+                           // class RegionAllocator
+                           // =====================
+
+class RegionAllocator : public bslma::Allocator {
+    // This class implements the 'bslma::Allocator' protocol to supply,
+    // sequentially, the chunks of the pools of an arena from regions of memory
+    // that are either mapped from the operating system and bound to a node,
+    // or obtained from an underlying allocator.  Deallocation has no effect:
+    // all regions are released on destruction.
+
+    // PRIVATE TYPES
+    union Region {
+        // This 'union' provides the header of each region.
+
+        struct {
+            Region    *d_next_p;  // next region
+            size_type  d_size;    // size of region, including header
+        } d_region;
+        bsls::AlignmentUtil::MaxAlignedType d_dummy;  // force alignment
+    };
+
+    // DATA
+    bslmt::Mutex      d_mutex;            // serializes all operations
+
+    char             *d_cursor_p;         // next free byte of current region
+
+    char             *d_end_p;            // end of current region
+
+    size_type         d_nextRegionSize;   // size of the next region
+
+    Region           *d_regions_p;        // list of regions
+
+    int               d_node;             // node to which to bind regions, or
+                                          // -1 if regions are obtained from
+                                          // 'd_allocator_p'
+
+    bslma::Allocator *d_allocator_p;      // underlying allocator (held)
+
+    // PRIVATE MANIPULATORS
+    Region *allocateRegion(size_type size);
+        // Obtain a region of the specified 'size' bytes, and add it to the
+        // list of regions.
+
+  private:
+    // NOT IMPLEMENTED
+    RegionAllocator(const RegionAllocator&);
+    RegionAllocator& operator=(const RegionAllocator&);
+
+  public:
+    // CREATORS
+    RegionAllocator(int node, bslma::Allocator *basicAllocator);
+        // Create a region allocator that binds its regions to the specified
+        // 'node', or, if 'node' is negative, obtains them from the specified
+        // 'basicAllocator'.  The behavior is undefined unless
+        // 'basicAllocator' is thread-safe.
+
+    virtual ~RegionAllocator();
+        // Destroy this allocator, releasing all of its regions.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return the address of a contiguous block of maximally-aligned memory
+        // of (at least) the specified 'size' (in bytes).  If 'size' is 0, no
+        // memory is allocated and 0 is returned.
+
+    virtual void deallocate(void *address);
+        // This method has no effect; the memory at the specified 'address' is
+        // released when this allocator is destroyed.
+};
+
+                           // ---------------------
+                           // class RegionAllocator
+                           // ---------------------
+
+// PRIVATE MANIPULATORS
+RegionAllocator::Region *RegionAllocator::allocateRegion(size_type size)
+{
+    Region *region;
+    if (0 <= d_node) {
+        region = static_cast<Region *>(mapRegion(size));
+        if (!region) {
+            BSLS_THROW(bsl::bad_alloc());
+        }
+        bindRegion(region, size, d_node);
+    }
+    else {
+        region = static_cast<Region *>(d_allocator_p->allocate(size));
+    }
+
+    region->d_region.d_next_p = d_regions_p;
+    region->d_region.d_size   = size;
+    d_regions_p               = region;
+
+    return region;
+}
+
+// CREATORS
+RegionAllocator::RegionAllocator(int node, bslma::Allocator *basicAllocator)
+: d_cursor_p(0)
+, d_end_p(0)
+, d_nextRegionSize(k_MIN_REGION_SIZE)
+, d_regions_p(0)
+, d_node(node)
+, d_allocator_p(basicAllocator)
+{
+    BSLS_ASSERT(basicAllocator);
+}
+
+RegionAllocator::~RegionAllocator()
+{
+    while (d_regions_p) {
+        Region *next = d_regions_p->d_region.d_next_p;
+        if (0 <= d_node) {
+            unmapRegion(d_regions_p, d_regions_p->d_region.d_size);
+        }
+        else {
+            d_allocator_p->deallocate(d_regions_p);
+        }
+        d_regions_p = next;
+    }
+}
+
+// MANIPULATORS
+void *RegionAllocator::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == size)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return 0;                                                     // RETURN
+    }
+
+    size = bsls::AlignmentUtil::roundUpToMaximalAlignment(size);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    if (size > static_cast<size_type>(d_end_p - d_cursor_p)) {
+        if (size + sizeof(Region) > k_MAX_REGION_SIZE) {
+            // The request is too large to share a region: obtain a dedicated
+            // region, and keep the current one.
+
+            const size_type regionSize =
+                   (size + sizeof(Region) + k_MIN_REGION_SIZE - 1)
+                                  / k_MIN_REGION_SIZE * k_MIN_REGION_SIZE;
+
+            return allocateRegion(regionSize) + 1;                    // RETURN
+        }
+
+        while (size + sizeof(Region) > d_nextRegionSize) {
+            d_nextRegionSize *= 2;
+        }
+
+        Region *region = allocateRegion(d_nextRegionSize);
+
+        d_cursor_p = reinterpret_cast<char *>(region + 1);
+        d_end_p    = reinterpret_cast<char *>(region) + d_nextRegionSize;
+
+        if (d_nextRegionSize < k_MAX_REGION_SIZE) {
+            d_nextRegionSize *= 2;
+        }
+    }
+
+    void *result = d_cursor_p;
+    d_cursor_p += size;
+    return result;
+}
+
+void RegionAllocator::deallocate(void *)
+{
+}
+
+}  // close unnamed namespace
+
+namespace bdlma {
+
+                      // ==============================
+                      // struct NumaSlabAllocator::Arena
+                      // ==============================
+
+struct NumaSlabAllocator::Arena {
+    // This 'struct' holds the pools of one node, and the regions of memory
+    // from which the pools obtain their chunks.  The pool objects themselves
+    // are also allocated from those regions.
+
+    // DATA
+    RegionAllocator  d_regions;   // supplies memory of the node
+    ConcurrentPool  *d_pools_p;   // array of pools
+    int              d_numPools;  // number of constructed pools
+
+    // CREATORS
+    Arena(int numPools, int node, bslma::Allocator *basicAllocator);
+        // Create an arena having the specified 'numPools' pools, whose regions
+        // are bound to the specified 'node' or, if 'node' is negative,
+        // obtained from the specified 'basicAllocator'.
+
+    ~Arena();
+        // Destroy this arena, releasing all of its memory.
+};
+
+                      // ------------------------------
+                      // struct NumaSlabAllocator::Arena
+                      // ------------------------------
+
+// CREATORS
+NumaSlabAllocator::Arena::Arena(int               numPools,
+                                int               node,
+                                bslma::Allocator *basicAllocator)
+: d_regions(node, basicAllocator)
+, d_pools_p(0)
+, d_numPools(0)
+{
+    d_pools_p = static_cast<ConcurrentPool *>(
+                             d_regions.allocate(numPools * sizeof *d_pools_p));
+
+    size_type blockSize = k_MIN_BLOCK_SIZE;
+    for (; d_numPools < numPools; ++d_numPools) {
+        new (d_pools_p + d_numPools) ConcurrentPool(
+                                             blockSize + sizeof(Header),
+                                             bsls::BlockGrowth::BSLS_GEOMETRIC,
+                                             k_DEFAULT_MAX_CHUNK_SIZE,
+                                             &d_regions);
+        blockSize *= 2;
+    }
+}
+
+NumaSlabAllocator::Arena::~Arena()
+{
+    for (int i = 0; i < d_numPools; ++i) {
+        d_pools_p[i].~ConcurrentPool();
+    }
+}
+
+                          // -----------------------
+                          // class NumaSlabAllocator
+                          // -----------------------
+
+// PRIVATE MANIPULATORS
+void NumaSlabAllocator::initialize(int numNodes)
+{
+    BSLS_ASSERT(1 <= d_numPools);
+    BSLS_ASSERT(d_numPools <= k_MAX_NUM_POOLS);
+    BSLS_ASSERT(0 <= numNodes);
+
+    const int numSystemNodes = loadTopology(&d_cpuNodes);
+
+    d_numNodes     = numNodes ? numNodes : numSystemNodes;
+    d_isPlaced     = 1 < numSystemNodes;
+    d_maxBlockSize = static_cast<size_type>(k_MIN_BLOCK_SIZE)
+                                                        << (d_numPools - 1);
+
+    d_arenas_p = static_cast<Arena *>(
+                    d_allocAdapter.allocate(d_numNodes * sizeof *d_arenas_p));
+
+    bslma::DeallocatorProctor<bslma::Allocator> autoArenasDeallocator(
+                                                              d_arenas_p,
+                                                              &d_allocAdapter);
+    bslma::AutoDestructor<Arena> autoDtor(d_arenas_p, 0);
+
+    for (int i = 0; i < d_numNodes; ++i, ++autoDtor) {
+        const int node = d_isPlaced && i < numSystemNodes ? i : -1;
+
+        new (d_arenas_p + i) Arena(d_numPools, node, &d_allocAdapter);
+    }
+
+    autoDtor.release();
+    autoArenasDeallocator.release();
+}
+
+// CREATORS
+NumaSlabAllocator::NumaSlabAllocator(bslma::Allocator *basicAllocator)
+: d_numNodes(0)
+, d_numPools(k_DEFAULT_NUM_POOLS)
+, d_maxBlockSize(0)
+, d_isPlaced(false)
+, d_cpuNodes(basicAllocator)
+, d_allocAdapter(&d_mutex, basicAllocator)
+, d_blockList(basicAllocator)
+, d_arenas_p(0)
+{
+    initialize(0);
+}
+
+NumaSlabAllocator::NumaSlabAllocator(int               numPools,
+                                     bslma::Allocator *basicAllocator)
+: d_numNodes(0)
+, d_numPools(numPools)
+, d_maxBlockSize(0)
+, d_isPlaced(false)
+, d_cpuNodes(basicAllocator)
+, d_allocAdapter(&d_mutex, basicAllocator)
+, d_blockList(basicAllocator)
+, d_arenas_p(0)
+{
+    initialize(0);
+}
+
+NumaSlabAllocator::NumaSlabAllocator(int               numPools,
+                                     int               numNodes,
+                                     bslma::Allocator *basicAllocator)
+: d_numNodes(0)
+, d_numPools(numPools)
+, d_maxBlockSize(0)
+, d_isPlaced(false)
+, d_cpuNodes(basicAllocator)
+, d_allocAdapter(&d_mutex, basicAllocator)
+, d_blockList(basicAllocator)
+, d_arenas_p(0)
+{
+    BSLS_ASSERT(1 <= numNodes);
+
+    initialize(numNodes);
+}
+
+NumaSlabAllocator::~NumaSlabAllocator()
+{
+    d_blockList.release();
+
+    for (int i = 0; i < d_numNodes; ++i) {
+        d_arenas_p[i].~Arena();
+    }
+    d_allocAdapter.deallocate(d_arenas_p);
+}
+
+// MANIPULATORS
+void *NumaSlabAllocator::allocate(size_type size)
+{
+    return allocateOnNode(size, currentNode());
+}
+
+void *NumaSlabAllocator::allocateOnNode(size_type size, int node)
+{
+    BSLS_ASSERT(0 <= node);
+    BSLS_ASSERT(node < d_numNodes);
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(size)) {
+        if (size <= d_maxBlockSize) {
+            const int pool = findPool(size);
+
+            Arena&  arena = d_arenas_p[node];
+            Header *p     = static_cast<Header *>(
+                                             arena.d_pools_p[pool].allocate());
+
+            p->d_header.d_index.d_poolIdx = pool;
+            p->d_header.d_index.d_nodeIdx = node;
+
+            return p + 1;                                             // RETURN
+        }
+
+        // The requested size is large and will not be pooled.
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        Header *p = static_cast<Header *>(
+                d_blockList.allocate(size + static_cast<int>(sizeof(Header))));
+
+        p->d_header.d_index.d_poolIdx = -1;
+        p->d_header.d_index.d_nodeIdx = -1;
+
+        return p + 1;                                                 // RETURN
+    }
+
+    return 0;
+}
+
+void NumaSlabAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return;                                                       // RETURN
+    }
+
+    Header *h = static_cast<Header *>(address) - 1;
+
+    const int pool = h->d_header.d_index.d_poolIdx;
+
+    if (-1 == pool) {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_blockList.deallocate(h);
+    }
+    else {
+        Arena& arena = d_arenas_p[h->d_header.d_index.d_nodeIdx];
+
+        arena.d_pools_p[pool].deallocate(h);
+    }
+}
+
+// ACCESSORS
+int NumaSlabAllocator::currentNode() const
+{
+    if (1 == d_numNodes) {
+        return 0;                                                     // RETURN
+    }
+
+#ifdef BSLS_PLATFORM_OS_LINUX
+
+    const int cpu = sched_getcpu();
+    if (0 <= cpu && cpu < static_cast<int>(d_cpuNodes.size())) {
+        return d_cpuNodes[cpu] % d_numNodes;                          // RETURN
+    }
+
+#endif
+
+    return 0;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,336 @@
+// bdlma_numaslaballocator.h                                          -*-C++-*-
+#ifndef INCLUDED_BDLMA_NUMASLABALLOCATOR
+#define INCLUDED_BDLMA_NUMASLABALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a thread-safe pooling allocator with per-NUMA-node arenas.
+//
+//@CLASSES:
+//  bdlma::NumaSlabAllocator: pooling allocator with node-local arenas
+//
+//@SEE_ALSO: bdlma_concurrentmultipoolallocator, bdlma_concurrentpool
+//
+//@DESCRIPTION: This component provides a thread-safe allocator,
+// 'bdlma::NumaSlabAllocator', implementing the 'bslma::Allocator' protocol,
+// that places the memory it dispenses on the NUMA (non-uniform memory access)
+// node of the thread requesting it.  The allocator maintains one "arena" for
+// each node, consisting, like a 'bdlma::ConcurrentMultipoolAllocator', of an
+// array of 'bdlma::ConcurrentPool' objects dispensing blocks whose sizes are
+// successive powers of two, starting at 8 bytes.  The pools of an arena carve
+// their chunks ("slabs") of blocks from large regions of memory bound to the
+// node of the arena.
+//..
+//  ,------------------------.
+// ( bdlma::NumaSlabAllocator )
+//  `------------------------'
+//               |         ctor/dtor
+//               |         allocateOnNode
+//               |         currentNode
+//               |         isNodePlacementEnabled
+//               |         maxPooledBlockSize
+//               |         numNodes
+//               |         numPools
+//               V
+//       ,----------------.
+//      ( bslma::Allocator )
+//       `----------------'
+//                       allocate
+//                       deallocate
+//..
+//
+///Node Placement
+///--------------
+// 'allocate' dispenses blocks from the arena of the node of the processor on
+// which the calling thread is running, and 'allocateOnNode' from the arena of
+// a specified node.  A deallocated block is always returned to the arena from
+// which it was allocated, so that memory allocated on a node remains there,
+// whichever thread deallocates it.
+//
+// On Linux machines having more than one NUMA node, the regions of each arena
+// are mapped directly from the operating system, and bound to the node of the
+// arena using the 'mbind' system call, with a "preferred" policy (so that
+// memory of another node is used if the node is exhausted).  Binding failures
+// are ignored, the memory then being placed according to the default policy
+// of the process.  On other machines (including Linux machines having a
+// single node), the regions are obtained from the underlying allocator, and
+// 'isNodePlacementEnabled' returns 'false'.
+//
+// The number of arenas is, by default, the number of nodes of the machine; a
+// different number may be specified at construction, in which case threads
+// running on node 'n' allocate from arena 'n % numNodes()', and only the
+// arenas corresponding to nodes of the machine are bound to them.
+//
+// Blocks larger than 'maxPooledBlockSize()' are obtained directly from the
+// underlying allocator, and are not placed on any particular node.  The memory
+// of the regions is released only when the allocator is destroyed.
+//
+///Thread Safety
+///-------------
+// 'bdlma::NumaSlabAllocator' is *fully thread-safe*, meaning any operation on
+// the same object can be safely invoked from any thread.  The underlying
+// allocator need not be thread-safe.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocating Node-Local Memory for Worker Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that each of our worker threads, running on a particular NUMA node,
+// builds a table of records from messages it receives.  Using a single
+// 'bdlma::NumaSlabAllocator' for all workers places the records of each worker
+// on its own node, without any per-node configuration.
+//
+// First, we create the allocator, and observe the number of its arenas:
+//..
+//  bdlma::NumaSlabAllocator allocator;
+//
+//  assert(1 <= allocator.numNodes());
+//  assert(allocator.currentNode() < allocator.numNodes());
+//..
+// Then, we create a vector of strings using the allocator, whose memory (being
+// allocated by this thread) is dispensed by the arena of the current node:
+//..
+//  bsl::vector<bsl::string> records(&allocator);
+//  for (int i = 0; i < 10; ++i) {
+//      records.push_back("a string long enough to require an allocation");
+//  }
+//..
+// Finally, a thread preparing data for a worker running on another node can
+// allocate that memory on the node of the worker explicitly:
+//..
+//  const int  node   = allocator.numNodes() - 1;
+//  void      *buffer = allocator.allocateOnNode(256, node);
+//  assert(buffer);
+//
+//  allocator.deallocate(buffer);
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_BLOCKLIST
+#include <bdlma_blocklist.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_CONCURRENTALLOCATORADAPTER
+#include <bdlma_concurrentallocatoradapter.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_MUTEX
+#include <bslmt_mutex.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_VECTOR
+#include <bsl_vector.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                          // =======================
+                          // class NumaSlabAllocator
+                          // =======================
+
+class NumaSlabAllocator : public bslma::Allocator {
+    // This class implements the 'bslma::Allocator' protocol to provide a
+    // thread-safe allocator that pools blocks of sizes that are powers of two
+    // in arenas bound to the NUMA nodes of the machine.  See
+    // {Node Placement}.
+
+    // PRIVATE TYPES
+    struct Header {
+        // This 'struct' provides header information for each allocated memory
+        // block.  The header stores the indices of the arena and pool of the
+        // block; the pool index is -1 if the block was obtained directly from
+        // the underlying allocator.
+
+        union {
+            struct {
+                int d_poolIdx;   // pool of block
+                int d_nodeIdx;   // arena of block
+            } d_index;
+            bsls::AlignmentUtil::MaxAlignedType d_dummy;  // force alignment
+        } d_header;
+    };
+
+    struct Arena;
+        // This 'struct', defined in the implementation file, holds the pools
+        // and the regions of memory of one node.
+
+    // DATA
+    int                         d_numNodes;      // number of arenas
+
+    int                         d_numPools;      // number of pools per arena
+
+    bsls::Types::size_type      d_maxBlockSize;  // largest pooled block size
+
+    bool                        d_isPlaced;      // 'true' if the regions of
+                                                 // arenas are bound to nodes
+
+    bsl::vector<int>            d_cpuNodes;      // node of each processor
+
+    bslmt::Mutex                d_mutex;         // serializes access to the
+                                                 // underlying allocator and
+                                                 // 'd_blockList'
+
+    ConcurrentAllocatorAdapter  d_allocAdapter;  // thread-safe adapter of the
+                                                 // underlying allocator
+
+    BlockList                   d_blockList;     // memory manager for
+                                                 // "large" memory blocks
+
+    Arena                      *d_arenas_p;      // array of arenas, one for
+                                                 // each node
+
+    // PRIVATE MANIPULATORS
+    void initialize(int numNodes);
+        // Determine the topology of the machine, and create the specified
+        // 'numNodes' arenas, or, if 'numNodes' is 0, one arena for each node
+        // of the machine.
+
+  private:
+    // NOT IMPLEMENTED
+    NumaSlabAllocator(const NumaSlabAllocator&);
+    NumaSlabAllocator& operator=(const NumaSlabAllocator&);
+
+  public:
+    // CREATORS
+    explicit NumaSlabAllocator(bslma::Allocator *basicAllocator = 0);
+    explicit NumaSlabAllocator(int               numPools,
+                               bslma::Allocator *basicAllocator = 0);
+    NumaSlabAllocator(int               numPools,
+                      int               numNodes,
+                      bslma::Allocator *basicAllocator = 0);
+        // Create a NUMA-aware slab allocator.  Optionally specify 'numPools',
+        // indicating the number of pools of each arena; the block size of the
+        // first pool is 8 bytes, with the block size of each additional pool
+        // successively doubling.  If 'numPools' is not specified, an
+        // implementation-defined number of pools is created.  Optionally
+        // specify 'numNodes', indicating the number of arenas.  If 'numNodes'
+        // is not specified, one arena is created for each NUMA node of the
+        // machine.  Optionally specify a 'basicAllocator' used to supply
+        // memory.  If 'basicAllocator' is 0, the currently installed default
+        // allocator is used.  The behavior is undefined unless
+        // '1 <= numPools <= 29' and '1 <= numNodes'.  See {Node Placement}.
+
+    virtual ~NumaSlabAllocator();
+        // Destroy this allocator, releasing all memory allocated through it.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return the address of a contiguous block of maximally-aligned memory
+        // of (at least) the specified 'size' (in bytes), allocated from the
+        // arena of the node of the calling thread (see 'currentNode').  If
+        // 'size > maxPooledBlockSize()', the block is obtained directly from
+        // the underlying allocator.  If 'size' is 0, no memory is allocated
+        // and 0 is returned.
+
+    void *allocateOnNode(size_type size, int node);
+        // Return the address of a contiguous block of maximally-aligned memory
+        // of (at least) the specified 'size' (in bytes), allocated from the
+        // arena of the specified 'node'.  If 'size > maxPooledBlockSize()',
+        // the block is obtained directly from the underlying allocator.  If
+        // 'size' is 0, no memory is allocated and 0 is returned.  The
+        // behavior is undefined unless '0 <= node < numNodes()'.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' to the arena from
+        // which it was allocated.  If 'address' is 0, this function has no
+        // effect.  The behavior is undefined unless 'address' was allocated
+        // using this allocator object and has not already been deallocated.
+
+    // ACCESSORS
+    int currentNode() const;
+        // Return the index of the arena used by 'allocate' when called from
+        // the calling thread, as determined by the processor on which the
+        // thread is currently running.  Note that the returned value may be
+        // out of date as soon as it is returned, if the thread is not bound to
+        // the processors of a single node.
+
+    bool isNodePlacementEnabled() const;
+        // Return 'true' if the regions of memory of the arenas of this
+        // allocator (corresponding to nodes of the machine) are bound to their
+        // nodes, and 'false' otherwise.
+
+    bsls::Types::size_type maxPooledBlockSize() const;
+        // Return the maximum size of memory blocks that are pooled by this
+        // allocator.  Note that the maximum value is '2 ^ (numPools + 2)'.
+
+    int numNodes() const;
+        // Return the number of arenas of this allocator.
+
+    int numPools() const;
+        // Return the number of pools of each arena of this allocator.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                          // -----------------------
+                          // class NumaSlabAllocator
+                          // -----------------------
+
+// ACCESSORS
+inline
+bool NumaSlabAllocator::isNodePlacementEnabled() const
+{
+    return d_isPlaced;
+}
+
+inline
+bsls::Types::size_type NumaSlabAllocator::maxPooledBlockSize() const
+{
+    return d_maxBlockSize;
+}
+
+inline
+int NumaSlabAllocator::numNodes() const
+{
+    return d_numNodes;
+}
+
+inline
+int NumaSlabAllocator::numPools() const
+{
+    return d_numPools;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
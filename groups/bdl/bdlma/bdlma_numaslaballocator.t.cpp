@@ -0,0 +1,853 @@
+// bdlma_numaslaballocator.t.cpp                                      -*-C++-*-
+#include <bdlma_numaslaballocator.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>     // 'atoi'
+#include <bsl_cstring.h>     // 'memset'
+#include <bsl_iostream.h>
+#include <bsl_string.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a thread-safe allocator dispensing blocks from
+// per-node arenas.  The placement of memory on nodes cannot be observed
+// portably (nor on the single-node machines typically running this test
+// driver), so we verify that the allocator dispenses maximally-aligned,
+// non-overlapping blocks of at least the requested size, that each block is
+// returned to, and reused by, the arena from which it was allocated
+// (whichever thread deallocates it), and that all memory is released on
+// destruction, also when the allocator is used concurrently by many threads.
+// On single-node machines, we also verify that the regions of the arenas are
+// obtained from the underlying allocator.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] NumaSlabAllocator(Allocator *ba = 0);
+// [ 2] NumaSlabAllocator(int numPools, Allocator *ba = 0);
+// [ 2] NumaSlabAllocator(int numPools, int numNodes, Allocator *ba = 0);
+// [ 2] ~NumaSlabAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 4] void *allocateOnNode(size_type size, int node);
+// [ 3] void deallocate(void *address);
+//
+// ACCESSORS
+// [ 2] int currentNode() const;
+// [ 2] bool isNodePlacementEnabled() const;
+// [ 2] bsls::Types::size_type maxPooledBlockSize() const;
+// [ 2] int numNodes() const;
+// [ 2] int numPools() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 5] CONCURRENCY
+// [ 6] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::NumaSlabAllocator Obj;
+typedef bsls::Types::size_type   size_type;
+
+const int MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+// ============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+bool isMaxAligned(const void *address)
+    // Return 'true' if the specified 'address' is maximally aligned, and
+    // 'false' otherwise.
+{
+    return 0 == reinterpret_cast<bsls::Types::UintPtr>(address) % MAX_ALIGN;
+}
+
+void scribble(void *address, size_type size, int value)
+    // Assign the low-order byte of the specified 'value' to each of the
+    // specified 'size' bytes starting at the specified 'address'.
+{
+    bsl::memset(address, value, size);
+}
+
+bool isScribbled(const void *address, size_type size, int value)
+    // Return 'true' if each of the specified 'size' bytes starting at the
+    // specified 'address' has the low-order byte of the specified 'value',
+    // and 'false' otherwise.
+{
+    const unsigned char *p = static_cast<const unsigned char *>(address);
+    for (size_type i = 0; i < size; ++i) {
+        if (static_cast<unsigned char>(value) != p[i]) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+extern "C" void *deallocateBlock(void *arg)
+    // Deallocate the block whose address and allocator are held by the
+    // specified 'arg', which must be the address of an array of two pointers,
+    // the first to an 'Obj', and the second to the block.
+{
+    void **args = static_cast<void **>(arg);
+
+    static_cast<Obj *>(args[0])->deallocate(args[1]);
+    return 0;
+}
+
+                             // =================
+                             // struct StressArgs
+                             // =================
+
+struct StressArgs {
+    // This 'struct' holds the arguments of 'stressThread'.
+
+    Obj               *d_allocator_p;  // allocator under test
+    bslmt::Barrier    *d_barrier_p;    // barrier shared by all threads
+    void             **d_slots_p;      // blocks exchanged between threads,
+                                       // 'd_numThreads * d_numSlots'
+    int                d_index;        // index of this thread
+    int                d_numThreads;   // number of threads
+    int                d_numSlots;     // number of slots per thread
+    int                d_numRounds;    // number of rounds
+    int                d_numErrors;    // number of corrupted blocks found
+};
+
+size_type stressSize(int thread, int slot, int round)
+    // Return the size of the block allocated by the specified 'thread' in the
+    // specified 'slot' during the specified 'round'.
+{
+    return 1 + (thread * 7 + slot * 13 + round * 29) % 300;
+}
+
+extern "C" void *stressThread(void *arg)
+    // In each round, allocate a block of varying size (scribbled with the
+    // index of the allocating thread) for each of the slots of this thread,
+    // from the arena of the current node or of a node chosen by the slot, also
+    // allocating and deallocating a few short-lived blocks, then, after all
+    // threads have done so, verify and deallocate the blocks of the slots of
+    // the next thread.  The specified 'arg' must be the address of a
+    // 'StressArgs' object.
+{
+    StressArgs *args = static_cast<StressArgs *>(arg);
+    Obj        *mX   = args->d_allocator_p;
+
+    const int  N    = args->d_numSlots;
+    void     **mine = args->d_slots_p + args->d_index * N;
+
+    const int  NEXT     = (args->d_index + 1) % args->d_numThreads;
+    void     **neighbor = args->d_slots_p + NEXT * N;
+
+    for (int round = 0; round < args->d_numRounds; ++round) {
+        for (int i = 0; i < N; ++i) {
+            const size_type SIZE = stressSize(args->d_index, i, round);
+
+            mine[i] = i % 3 ? mX->allocate(SIZE)
+                            : mX->allocateOnNode(SIZE, i % mX->numNodes());
+            scribble(mine[i], SIZE, args->d_index);
+
+            void *temp = mX->allocate(SIZE + 1000 * (i % 2));
+            mX->deallocate(temp);
+        }
+
+        args->d_barrier_p->wait();
+
+        for (int i = 0; i < N; ++i) {
+            const size_type SIZE = stressSize(NEXT, i, round);
+
+            if (!isMaxAligned(neighbor[i])
+             || !isScribbled(neighbor[i], SIZE, NEXT)) {
+                ++args->d_numErrors;
+            }
+            mX->deallocate(neighbor[i]);
+        }
+
+        args->d_barrier_p->wait();
+    }
+    return 0;
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int  test        = argc > 1 ? atoi(argv[1]) : 0;
+    const bool verbose     = argc > 2;
+    const bool veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator da("default", veryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Allocating Node-Local Memory for Worker Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that each of our worker threads, running on a particular NUMA node,
+// builds a table of records from messages it receives.  Using a single
+// 'bdlma::NumaSlabAllocator' for all workers places the records of each worker
+// on its own node, without any per-node configuration.
+//
+// First, we create the allocator, and observe the number of its arenas:
+//..
+    bdlma::NumaSlabAllocator allocator;
+
+    ASSERT(1 <= allocator.numNodes());
+    ASSERT(allocator.currentNode() < allocator.numNodes());
+//..
+// Then, we create a vector of strings using the allocator, whose memory (being
+// allocated by this thread) is dispensed by the arena of the current node:
+//..
+    bsl::vector<bsl::string> records(&allocator);
+    for (int i = 0; i < 10; ++i) {
+        records.push_back("a string long enough to require an allocation");
+    }
+//..
+// Finally, a thread preparing data for a worker running on another node can
+// allocate that memory on the node of the worker explicitly:
+//..
+    const int  node   = allocator.numNodes() - 1;
+    void      *buffer = allocator.allocateOnNode(256, node);
+    ASSERT(buffer);
+
+    allocator.deallocate(buffer);
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY
+        //
+        // Concerns:
+        //: 1 Blocks allocated concurrently by several threads, from the same
+        //:   or different arenas, do not overlap, and are not corrupted by the
+        //:   allocator while in use, also when deallocated by a thread other
+        //:   than the allocating one.
+        //:
+        //: 2 All memory is released on destruction.
+        //
+        // Plan:
+        //: 1 Run several threads that, in each round, allocate blocks of
+        //:   varying sizes from several arenas, scribbling over each the index
+        //:   of the thread, and, after all threads have done so, verify and
+        //:   deallocate the blocks of another thread.  (C-1)
+        //:
+        //: 2 Verify that no memory remains in use after destroying the
+        //:   allocator.  (C-2)
+        //
+        // Testing:
+        //   CONCURRENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY" << endl
+                          << "===========" << endl;
+
+        bslma::TestAllocator  ta("object", veryVerbose);
+        bslma::Allocator     *na = bslma::NewDeleteAllocator::allocator(0);
+
+        enum { k_NUM_THREADS = 8, k_NUM_SLOTS = 200, k_NUM_ROUNDS = 50 };
+
+        for (int numNodes = 1; numNodes <= 4; numNodes += 3) {
+            if (veryVerbose) { T_ P(numNodes) }
+
+            {
+                Obj mX(7, numNodes, &ta);
+
+                bsl::vector<void *>     slots(k_NUM_THREADS * k_NUM_SLOTS,
+                                              static_cast<void *>(0),
+                                              na);
+                bsl::vector<StressArgs> args(k_NUM_THREADS, na);
+                bslmt::Barrier          barrier(k_NUM_THREADS);
+
+                bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    args[i].d_allocator_p = &mX;
+                    args[i].d_barrier_p   = &barrier;
+                    args[i].d_slots_p     = slots.data();
+                    args[i].d_index       = i;
+                    args[i].d_numThreads  = k_NUM_THREADS;
+                    args[i].d_numSlots    = k_NUM_SLOTS;
+                    args[i].d_numRounds   = k_NUM_ROUNDS;
+                    args[i].d_numErrors   = 0;
+
+                    ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                          stressThread,
+                                                          &args[i]));
+                }
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    bslmt::ThreadUtil::join(handles[i]);
+                    ASSERTV(numNodes, i, 0 == args[i].d_numErrors);
+                }
+            }
+            ASSERTV(numNodes, 0 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // ALLOCATE ON NODE
+        //
+        // Concerns:
+        //: 1 'allocateOnNode' dispenses blocks from the arena of the specified
+        //:   node, which are returned to that arena when deallocated, by any
+        //:   thread, and are not reused by other arenas.
+        //:
+        //: 2 'allocate' dispenses blocks from the arena of 'currentNode()'.
+        //:
+        //: 3 'allocateOnNode' obtains large blocks, and handles zero sizes,
+        //:   as 'allocate' does.
+        //:
+        //: 4 Chunks of pools too large to share a region are supported.
+        //
+        // Plan:
+        //: 1 For each node of an allocator having several arenas, allocate a
+        //:   block, deallocate it (in the main thread or another one), and
+        //:   verify that allocating from the other arenas does not return it,
+        //:   and that allocating from its arena does.  (C-1)
+        //:
+        //: 2 Deallocate a block allocated from the arena of 'currentNode()',
+        //:   and verify that 'allocate' returns it, unless the thread has
+        //:   moved to another node.  (C-2)
+        //:
+        //: 3 Allocate large blocks, and blocks of size 0, from each arena.
+        //:   (C-3)
+        //:
+        //: 4 Allocate the largest pooled block of an allocator having many
+        //:   pools, and verify that smaller blocks can still be allocated.
+        //:   (C-4)
+        //
+        // Testing:
+        //   void *allocateOnNode(size_type size, int node);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ALLOCATE ON NODE" << endl
+                          << "================" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+
+        if (verbose) cout << "\nArena of each block." << endl;
+        {
+            enum { k_NUM_NODES = 3 };
+
+            Obj mX(5, k_NUM_NODES, &ta);  const Obj& X = mX;
+
+            ASSERT(k_NUM_NODES == X.numNodes());
+
+            for (int node = 0; node < k_NUM_NODES; ++node) {
+                for (int remote = 0; remote < 2; ++remote) {
+                    void *p = mX.allocateOnNode(24, node);
+                    ASSERTV(node, isMaxAligned(p));
+
+                    if (remote) {
+                        void *args[2] = { &mX, p };
+
+                        bslmt::ThreadUtil::Handle handle;
+                        ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                              deallocateBlock,
+                                                              args));
+                        bslmt::ThreadUtil::join(handle);
+                    }
+                    else {
+                        mX.deallocate(p);
+                    }
+
+                    bsl::vector<void *> others(&ta);
+                    for (int other = 0; other < k_NUM_NODES; ++other) {
+                        if (other != node) {
+                            void *q = mX.allocateOnNode(32, other);
+                            ASSERTV(node, other, p != q);
+                            others.push_back(q);
+                        }
+                    }
+
+                    ASSERTV(node, remote, p == mX.allocateOnNode(17, node));
+                    mX.deallocate(p);
+
+                    for (size_type i = 0; i < others.size(); ++i) {
+                        mX.deallocate(others[i]);
+                    }
+                }
+            }
+
+            if (verbose) cout << "\nCurrent node." << endl;
+
+            const int NODE = X.currentNode();
+            ASSERTV(NODE, 0 <= NODE && NODE < k_NUM_NODES);
+
+            void *p = mX.allocateOnNode(100, NODE);
+            mX.deallocate(p);
+
+            void *q = mX.allocate(100);
+            if (NODE == X.currentNode()) {
+                ASSERT(p == q);
+            }
+            mX.deallocate(q);
+
+            if (verbose) cout << "\nLarge and empty blocks." << endl;
+
+            for (int node = 0; node < k_NUM_NODES; ++node) {
+                ASSERTV(node, 0 == mX.allocateOnNode(0, node));
+
+                const bsls::Types::Int64 IN_USE = ta.numBlocksInUse();
+
+                void *r = mX.allocateOnNode(X.maxPooledBlockSize() + 1, node);
+                ASSERTV(node, isMaxAligned(r));
+                ASSERTV(node, IN_USE + 1 == ta.numBlocksInUse());
+
+                scribble(r, X.maxPooledBlockSize() + 1, 0x22);
+                mX.deallocate(r);
+                ASSERTV(node, IN_USE == ta.numBlocksInUse());
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nChunks larger than a region." << endl;
+        {
+            Obj mX(22, 2, &ta);  const Obj& X = mX;
+
+            ASSERT((size_type(1) << 24) == X.maxPooledBlockSize());
+
+            for (int node = 0; node < 2; ++node) {
+                void *p = mX.allocateOnNode(X.maxPooledBlockSize(), node);
+                void *q = mX.allocateOnNode(8, node);
+
+                scribble(p, X.maxPooledBlockSize(), 0x11);
+                scribble(q, 8, 0x44);
+                ASSERTV(node, isScribbled(p, X.maxPooledBlockSize(), 0x11));
+
+                mX.deallocate(p);
+                mX.deallocate(q);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // ALLOCATE AND DEALLOCATE
+        //
+        // Concerns:
+        //: 1 'allocate' returns maximally-aligned, non-overlapping blocks of
+        //:   at least the requested size, for sizes pooled or not.
+        //:
+        //: 2 'allocate(0)' returns 0, and 'deallocate(0)' has no effect.
+        //:
+        //: 3 Deallocated blocks are reused.
+        //:
+        //: 4 Blocks larger than 'maxPooledBlockSize()' are obtained from, and
+        //:   returned to, the underlying allocator.
+        //:
+        //: 5 Unless node placement is enabled, the regions of the arenas are
+        //:   obtained from the underlying allocator, in a number growing
+        //:   logarithmically with the memory used.
+        //
+        // Plan:
+        //: 1 For each size in a table, allocate several blocks, scribbling
+        //:   over each a distinct value, and verify their alignment, and that
+        //:   they are not modified by subsequent allocations.  (C-1)
+        //:
+        //: 2 Call 'allocate(0)' and 'deallocate(0)'.  (C-2)
+        //:
+        //: 3 Deallocate and reallocate a block.  (C-3)
+        //:
+        //: 4 Allocate and deallocate large blocks, verifying the number of
+        //:   blocks in use in the underlying allocator.  (C-4)
+        //:
+        //: 5 Allocate many small blocks, and verify the number of blocks
+        //:   obtained from the underlying allocator.  (C-5)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ALLOCATE AND DEALLOCATE" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator  ta("object", veryVerbose);
+        bslma::Allocator     *na = bslma::NewDeleteAllocator::allocator(0);
+
+        if (verbose) cout << "\nAlignment and independence." << endl;
+        {
+            static const size_type SIZES[] = {
+                1, 2, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65,
+                100, 127, 128, 129, 255, 256, 257, 1000, 4095, 4096, 4097,
+                10000
+            };
+            const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+            enum { k_NUM_PER_SIZE = 40 };
+
+            Obj mX(10, &ta);
+
+            bsl::vector<void *>    blocks(na);
+            bsl::vector<size_type> sizes(na);
+
+            for (int ti = 0; ti < NUM_SIZES; ++ti) {
+                for (int j = 0; j < k_NUM_PER_SIZE; ++j) {
+                    const size_type SIZE = SIZES[ti];
+                    void *p = mX.allocate(SIZE);
+
+                    ASSERTV(SIZE, p);
+                    ASSERTV(SIZE, isMaxAligned(p));
+
+                    scribble(p, SIZE, static_cast<int>(blocks.size()));
+                    blocks.push_back(p);
+                    sizes.push_back(SIZE);
+                }
+            }
+            for (size_type i = 0; i < blocks.size(); ++i) {
+                ASSERTV(i, isScribbled(blocks[i],
+                                       sizes[i],
+                                       static_cast<int>(i)));
+            }
+            for (size_type i = 0; i < blocks.size(); ++i) {
+                mX.deallocate(blocks[i]);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nZero size, null address, and reuse." << endl;
+        {
+            Obj mX(1, 1, &ta);
+
+            const bsls::Types::Int64 TOTAL = ta.numBlocksTotal();
+
+            ASSERT(0 == mX.allocate(0));
+            mX.deallocate(0);
+
+            ASSERT(TOTAL == ta.numBlocksTotal());
+
+            void *p = mX.allocate(8);
+            mX.deallocate(p);
+            ASSERT(p == mX.allocate(1));
+            mX.deallocate(p);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nLarge blocks." << endl;
+        {
+            Obj mX(3, &ta);
+
+            ASSERT(32 == mX.maxPooledBlockSize());
+
+            mX.deallocate(mX.allocate(32));
+
+            const bsls::Types::Int64 IN_USE = ta.numBlocksInUse();
+
+            void *q = mX.allocate(33);
+            ASSERT(isMaxAligned(q));
+            ASSERT(IN_USE + 1 == ta.numBlocksInUse());
+
+            void *r = mX.allocate(100000);
+            ASSERT(isMaxAligned(r));
+            ASSERT(IN_USE + 2 == ta.numBlocksInUse());
+            scribble(r, 100000, 0x33);
+
+            mX.deallocate(q);
+            ASSERT(IN_USE + 1 == ta.numBlocksInUse());
+
+            mX.deallocate(r);
+            ASSERT(IN_USE == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nRegions." << endl;
+        {
+            Obj mX(4, 1, &ta);  const Obj& X = mX;
+
+            if (!X.isNodePlacementEnabled()) {
+                const bsls::Types::Int64 IN_USE = ta.numBlocksInUse();
+
+                // Allocate about 16 MB: regions grow from 64 KB to 4 MB.
+
+                enum { k_NUM_BLOCKS = 16 * 1024 * 1024 / 64 };
+
+                bsl::vector<void *> blocks(na);
+                blocks.reserve(k_NUM_BLOCKS);
+                for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                    blocks.push_back(mX.allocate(32));
+                }
+
+                const bsls::Types::Int64 NUM_REGIONS =
+                                               ta.numBlocksInUse() - IN_USE;
+                ASSERTV(NUM_REGIONS, 5 <= NUM_REGIONS && NUM_REGIONS <= 12);
+
+                for (int i = 0; i < k_NUM_BLOCKS; ++i) {
+                    mX.deallocate(blocks[i]);
+                }
+                ASSERT(NUM_REGIONS == ta.numBlocksInUse() - IN_USE);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CONSTRUCTORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates an allocator having the specified (or
+        //:   default) number of pools, and the specified number of arenas, or
+        //:   one for each node of the machine.
+        //:
+        //: 2 'maxPooledBlockSize' is '2 ^ (numPools() + 2)'.
+        //:
+        //: 3 'currentNode' returns the index of an arena.
+        //:
+        //: 4 Node placement is disabled on machines having a single node.
+        //:
+        //: 5 The supplied (or default) allocator is used to supply memory, and
+        //:   all of it is released on destruction.
+        //
+        // Plan:
+        //: 1 Create allocators using each constructor, with and without an
+        //:   allocator, and verify the accessors and the use of memory.
+        //:   (C-1..5)
+        //
+        // Testing:
+        //   NumaSlabAllocator(Allocator *ba = 0);
+        //   NumaSlabAllocator(int numPools, Allocator *ba = 0);
+        //   NumaSlabAllocator(int numPools, int numNodes, Allocator *ba = 0);
+        //   ~NumaSlabAllocator();
+        //   int currentNode() const;
+        //   bool isNodePlacementEnabled() const;
+        //   bsls::Types::size_type maxPooledBlockSize() const;
+        //   int numNodes() const;
+        //   int numPools() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONSTRUCTORS AND ACCESSORS" << endl
+                          << "==========================" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+
+        int numSystemNodes;
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            numSystemNodes = X.numNodes();
+
+            if (verbose) {
+                P_(numSystemNodes) P(X.isNodePlacementEnabled())
+            }
+
+            ASSERT(1  <= X.numNodes());
+            ASSERT(10 == X.numPools());
+            ASSERT(4096 == X.maxPooledBlockSize());
+            ASSERT(X.isNodePlacementEnabled() == (1 < X.numNodes()));
+            ASSERT(0 <= X.currentNode() && X.currentNode() < X.numNodes());
+
+            mX.deallocate(mX.allocate(100));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+
+        for (int numPools = 1; numPools <= 12; ++numPools) {
+            {
+                Obj mX(numPools, &ta);  const Obj& X = mX;
+
+                ASSERTV(numPools, numPools == X.numPools());
+                ASSERTV(numPools, numSystemNodes == X.numNodes());
+                ASSERTV(numPools,
+                        (size_type(4) << numPools) == X.maxPooledBlockSize());
+
+                mX.deallocate(mX.allocate(X.maxPooledBlockSize()));
+            }
+            for (int numNodes = 1; numNodes <= 4; ++numNodes) {
+                Obj mX(numPools, numNodes, &ta);  const Obj& X = mX;
+
+                ASSERTV(numPools, numPools == X.numPools());
+                ASSERTV(numPools, numNodes == X.numNodes());
+                ASSERTV(numPools,
+                        (size_type(4) << numPools) == X.maxPooledBlockSize());
+                ASSERTV(numNodes, X.currentNode() < numNodes);
+
+                for (int node = 0; node < numNodes; ++node) {
+                    mX.deallocate(
+                         mX.allocateOnNode(X.maxPooledBlockSize(), node));
+                }
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(10 == X.numPools());
+            ASSERT(0  <  da.numBlocksInUse());
+        }
+        {
+            Obj mX(4);  const Obj& X = mX;
+
+            ASSERT(4 == X.numPools());
+        }
+        {
+            Obj mX(4, 3);  const Obj& X = mX;
+
+            ASSERT(3 == X.numNodes());
+        }
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks of various sizes.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+        {
+            Obj mX(&ta);
+
+            void *p1 = mX.allocate(1);
+            void *p2 = mX.allocate(100);
+            void *p3 = mX.allocate(100000);
+            void *p4 = mX.allocateOnNode(64, mX.numNodes() - 1);
+
+            ASSERT(p1);  ASSERT(p2);  ASSERT(p3);  ASSERT(p4);
+            ASSERT(p1 != p2);
+
+            mX.deallocate(p1);
+            mX.deallocate(p2);
+            mX.deallocate(p3);
+            mX.deallocate(p4);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
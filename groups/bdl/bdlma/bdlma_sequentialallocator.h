@@ -47,8 +47,11 @@ BSLS_IDENT("$Id: $")
 // allocator, as does the destructor.  The 'rewind' method releases all memory
 // allocated through the allocator and returns to the underlying allocator
 // *only* memory that was allocated outside of the typical internal buffer
-// growth of the allocator (i.e., large blocks).  Note that individually
-// allocated memory blocks cannot be separately deallocated.
+// growth of the allocator (i.e., large blocks).  An overload of 'rewind'
+// additionally limits the memory retained to the largest internal buffer and
+// the further internal buffers fitting within a specified size (see
+// 'bdlma_sequentialpool').  Note that individually allocated memory blocks
+// cannot be separately deallocated.
 //
 // The main difference between a 'bdlma::SequentialAllocator' and a
 // 'bdlma::SequentialPool' is that, very often, a 'bdlma::SequentialAllocator'
@@ -397,6 +400,20 @@ class SequentialAllocator : public ManagedAllocator {
         // 'rewind' - using a pointer obtained from this object prior to this
         // call to 'rewind' is undefined.
 
+    void rewind(bsls::Types::size_type maxRetainedSize);
+        // Release all memory allocated through this allocator and return to
+        // the underlying allocator all memory except the largest internal
+        // buffer and, in decreasing order of size, the further internal
+        // buffers whose total size (with that of the largest buffer) does not
+        // exceed the specified 'maxRetainedSize' (in bytes).  Memory allocated
+        // outside of the typical internal buffer growth of this allocator
+        // (i.e., large blocks) is always returned.  All retained memory will
+        // be used to satisfy subsequent allocations, and, until the next call
+        // to 'rewind' or 'release', internal buffers grown geometrically are
+        // larger than the retained ones.  The effect of subsequently - to this
+        // invokation of 'rewind' - using a pointer obtained from this object
+        // prior to this call to 'rewind' is undefined.
+
     void reserveCapacity(bsls::Types::size_type numBytes);
         // Reserve sufficient memory to satisfy allocation requests for at
         // least the specified 'numBytes' without replenishment (i.e., without
@@ -605,6 +622,12 @@ void SequentialAllocator::rewind()
     d_sequentialPool.rewind();
 }
 
+inline
+void SequentialAllocator::rewind(bsls::Types::size_type maxRetainedSize)
+{
+    d_sequentialPool.rewind(maxRetainedSize);
+}
+
 inline
 bsls::Types::size_type SequentialAllocator::truncate(
                                           void                   *address,
@@ -75,11 +75,12 @@ using namespace bsl;
 // [ 3] void deallocate(void *address);
 // [ 4] void release();
 // [ 5] void rewind();
+// [ 8] void rewind(size_type maxRetainedSize);
 // [ 7] void reserveCapacity(int numBytes);
 // [ 6] int truncate(void *address, int originalSize, int newSize);
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
-// [ 8] USAGE TEST
+// [ 9] USAGE TEST
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -282,7 +283,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 8: {
+      case 9: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -313,6 +314,59 @@ int main(int argc, char *argv[])
 //..
 
       } break;
+      case 8: {
+        // --------------------------------------------------------------------
+        // 'rewind(maxRetainedSize)' TEST
+        //
+        // Concerns:
+        //   1) That 'rewind(maxRetainedSize)' retains only the largest
+        //      internal buffer when 'maxRetainedSize' is 0, and returns all
+        //      other memory to the underlying allocator.
+        //
+        //   2) That repeating the same set of allocations between calls to
+        //      'rewind(0)' reaches a steady state in which no memory is
+        //      obtained from the underlying allocator, and a single buffer is
+        //      retained.
+        //
+        // Plan:
+        //   Repeatedly perform the same set of allocations followed by
+        //   'rewind(0)', and verify, using a 'bslma::TestAllocator', the
+        //   number of buffers retained after each 'rewind', and that the
+        //   allocations of the last rounds obtain no memory from the
+        //   underlying allocator.
+        //
+        // Testing:
+        //   void rewind(size_type maxRetainedSize);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "'rewind(maxRetainedSize)' TEST" << endl
+                                  << "==============================" << endl;
+
+        {
+            Obj mX(&objectAllocator);
+
+            bsls::Types::Int64 numBlocksTotal = 0;
+
+            for (int round = 0; round < 5; ++round) {
+                for (int i = 0; i < 100; ++i) {
+                    mX.allocate(100);
+                }
+                if (2 <= round) {
+                    LOOP_ASSERT(round, numBlocksTotal ==
+                                             objectAllocator.numBlocksTotal());
+                }
+                numBlocksTotal = objectAllocator.numBlocksTotal();
+
+                mX.rewind(0);
+
+                LOOP_ASSERT(round, 1 == objectAllocator.numBlocksInUse());
+            }
+            ASSERT(100 * 100 <= objectAllocator.numBytesInUse());
+        }
+        ASSERT(0 == objectAllocator.numBytesInUse());
+        ASSERT(0 == defaultAllocator.numBlocksTotal());
+        ASSERT(0 == globalAllocator.numBlocksTotal());
+      } break;
       case 7: {
         // --------------------------------------------------------------------
         // 'reserveCapacity' TEST
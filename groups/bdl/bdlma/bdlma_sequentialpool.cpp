@@ -8,8 +8,10 @@
 #include <bsl_cstring.h>
 
 enum {
-    k_INITIAL_SIZE      =  256  // default constant growth strategy allocation
-                                // size (in bytes)
+    k_INITIAL_SIZE         =  256,  // default constant growth strategy
+                                    // allocation size (in bytes)
+
+    k_NUM_BITS_IN_BIN_MASK =   64   // number of bits in the bitmasks of bins
 };
 
 namespace BloombergLP {
@@ -604,6 +606,72 @@ void SequentialPool::rewind()
     }
 }
 
+void SequentialPool::rewind(bsls::Types::size_type maxRetainedSize)
+{
+    rewind();
+
+    // Retain the geometric growth blocks, largest first, within
+    // 'maxRetainedSize' (always retaining the largest block), and return the
+    // others to the underlying allocator.
+
+    bsls::Types::size_type retainedSize = 0;
+    bool                   retainedAny  = false;
+
+    uint64_t remaining = d_allocated;
+    while (remaining) {
+        const int index = k_NUM_BITS_IN_BIN_MASK - 1
+                        - bdlb::BitUtil::numLeadingUnsetBits(remaining);
+        const bsls::Types::size_type size =
+                                           static_cast<bsls::Types::size_type>(
+                                                     static_cast<uint64_t>(1)
+                                                                     << index);
+
+        remaining = bdlb::BitUtil::withBitCleared(remaining, index);
+
+        if (!retainedAny || retainedSize + size <= maxRetainedSize) {
+            retainedSize += size;
+            retainedAny   = true;
+        }
+        else {
+            d_allocator_p->deallocate(d_geometricBin[index]);
+            d_allocated = bdlb::BitUtil::withBitCleared(d_allocated, index);
+        }
+    }
+
+    // Make the bins smaller than the retained geometric growth blocks
+    // unavailable, so that growth beyond the retained blocks allocates a
+    // block larger than any of them, which the next 'rewind' can retain in
+    // their stead.
+
+    if (d_allocated) {
+        d_unavailable |= (static_cast<uint64_t>(1)
+                          << bdlb::BitUtil::numTrailingUnsetBits(d_allocated))
+                       - 1;
+    }
+
+    // Retain the leading constant growth blocks within the remainder of
+    // 'maxRetainedSize' (retaining at least one block if no geometric growth
+    // block was retained), and return the others to the underlying allocator.
+
+    Block **next = &d_head_p;
+    while (*next
+        && (   !retainedAny
+            || retainedSize + d_constantGrowthSize <= maxRetainedSize)) {
+        retainedSize += d_constantGrowthSize;
+        retainedAny   = true;
+        next          = &(*next)->d_next_p;
+    }
+
+    Block *block = *next;
+    *next        = 0;
+
+    while (block) {
+        void *lastBlock = block;
+        block           = block->d_next_p;
+        d_allocator_p->deallocate(lastBlock);
+    }
+}
+
 }  // close package namespace
 }  // close enterprise namespace
 
@@ -25,8 +25,9 @@ BSLS_IDENT("$Id: $")
 // as does the destructor.  The 'rewind' method releases all memory allocated
 // through the pool and returns to the underlying allocator *only* memory that
 // was allocated outside of the typical internal buffer growth of the pool
-// (i.e., large blocks).  Note that individually allocated memory blocks cannot
-// be separately deallocated.
+// (i.e., large blocks).  An overload of 'rewind' additionally limits the
+// memory retained (see {Retaining Memory Across 'rewind'}).  Note that
+// individually allocated memory blocks cannot be separately deallocated.
 //
 // A 'bdlma::SequentialPool' is typically used when fast allocation and
 // deallocation is needed, but the user does not know in advance the maximum
@@ -67,6 +68,25 @@ BSLS_IDENT("$Id: $")
 // 'alignmentStrategy' is not specified, natural alignment is used.  See
 // 'bsls_alignment' for more details.
 //
+///Retaining Memory Across 'rewind'
+///---------------------------------
+// A pool that is repeatedly filled and rewound (e.g., a pool supplying the
+// memory of each request processed by a server) reaches a steady state in
+// which its internal buffers satisfy all allocations, and no memory is
+// obtained from the underlying allocator.  'rewind()' retains *all* internal
+// buffers, which, with geometric growth, include every buffer of the chain
+// grown by the largest fill since construction.  'rewind(maxRetainedSize)'
+// instead retains the largest internal buffer, and further internal buffers,
+// in decreasing order of size, only as long as the total size of the retained
+// buffers does not exceed 'maxRetainedSize'.  Until the next 'rewind' or
+// 'release', growth beyond the retained buffers then allocates buffers larger
+// than any of them (rather than restarting the chain from the initial size),
+// so that the retained buffers converge to the high-water mark of the fills.
+// In particular, with a 'maxRetainedSize' of 0, only the largest buffer is
+// retained, and, once a fill has grown it to the high-water mark, that single
+// buffer satisfies each subsequent fill without any allocation from the
+// underlying allocator.
+//
 ///Usage
 ///-----
 // This section illustrates intended use of this component.
@@ -608,6 +628,21 @@ class SequentialPool {
         // a pointer obtained from this object prior to this call to 'rewind'
         // is undefined.
 
+    void rewind(bsls::Types::size_type maxRetainedSize);
+        // Release all memory allocated through this pool and return to the
+        // underlying allocator all memory except the largest internal buffer
+        // and, in decreasing order of size, the further internal buffers whose
+        // total size (with that of the largest buffer) does not exceed the
+        // specified 'maxRetainedSize' (in bytes).  Memory allocated outside of
+        // the typical internal buffer growth of this pool (i.e., large blocks)
+        // is always returned.  All retained memory will be used to satisfy
+        // subsequent allocations, and, until the next call to 'rewind' or
+        // 'release', internal buffers grown geometrically are larger than the
+        // retained ones.  The effect of subsequently - to this invokation of
+        // 'rewind' - using a pointer obtained from this object prior to this
+        // call to 'rewind' is undefined.  See {Retaining Memory Across
+        // 'rewind'}.
+
     void reserveCapacity(bsls::Types::size_type numBytes);
         // Reserve sufficient memory to satisfy allocation requests for at
         // least the specified 'numBytes' without replenishment (i.e., without
@@ -85,13 +85,14 @@ using namespace bsl;
 // [ 6] void deleteObject(const TYPE *object);
 // [ 5] void release();
 // [11] void rewind();
+// [12] void rewind(size_type maxRetainedSize);
 // [ 9] void reserveCapacity(int numBytes);
 // [ 8] int truncate(void *address, int originalSize, int newSize);
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 2] HELPER FUNCTION: 'int blockSize(numBytes)'
 // [10] FREE FUNCTION: 'operator new(size_t, bdlma::SequentialPool)'
-// [12] USAGE EXAMPLE
+// [13] USAGE EXAMPLE
 
 //=============================================================================
 //                      STANDARD BDE ASSERT TEST MACRO
@@ -462,7 +463,7 @@ int main(int argc, char *argv[])
     bslma::Default::setGlobalAllocator(&globalAllocator);
 
     switch (test) { case 0:
-      case 12: {
+      case 13: {
         // --------------------------------------------------------------------
         // USAGE EXAMPLE
         //   Extracted from component header file.
@@ -485,6 +486,199 @@ int main(int argc, char *argv[])
                           << "=============" << endl;
 
       } break;
+      case 12: {
+        // -------------------------------------------------------------------
+        // TESTING 'rewind(maxRetainedSize)'
+        //   Ensure this manipulator retains the expected internal buffers.
+        //
+        // Concerns:
+        //: 1 The method retains the largest internal buffer, and further
+        //:   internal buffers, in decreasing order of size, as long as their
+        //:   total size does not exceed 'maxRetainedSize', and returns all
+        //:   other memory to the underlying allocator.
+        //:
+        //: 2 The retained memory is reused by subsequent allocations.
+        //:
+        //: 3 Repeating the same set of allocations between calls to the
+        //:   method reaches a steady state in which no memory is obtained from
+        //:   the underlying allocator.
+        //:
+        //: 4 Large blocks are always returned to the underlying allocator.
+        //:
+        //: 5 All memory is returned to the underlying allocator on
+        //:   destruction.
+        //
+        // Plan:
+        //: 1 For both growth strategies and several values of
+        //:   'maxRetainedSize', repeatedly perform a set of allocations
+        //:   followed by 'rewind(maxRetainedSize)', and verify, using a
+        //:   'bslma::TestAllocator', the number and size of the buffers
+        //:   retained, and that the first allocation following 'rewind'
+        //:   reuses a retained buffer.  (C-1..2)
+        //:
+        //: 2 Verify that no memory is allocated from the underlying allocator
+        //:   after a small number of repetitions.  (C-3)
+        //:
+        //: 3 Allocate a block exceeding the maximum buffer size, and verify it
+        //:   is returned by 'rewind(maxRetainedSize)'.  (C-4)
+        //:
+        //: 4 Allow each object to go out-of-scope and verify all memory has
+        //:   been returned to the underlying allocator.  (C-5)
+        //
+        // Testing:
+        //   void rewind(size_type maxRetainedSize);
+        // -------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'rewind(maxRetainedSize)'" << endl
+                          << "=================================" << endl;
+
+        typedef bsls::Types::Int64 Int64;
+
+        enum { k_NUM_ALLOCATIONS = 100, k_ALLOCATION_SIZE = 100 };
+
+        if (verbose) cout << "\nTesting geometric growth." << endl;
+        {
+            const bsl::size_t MAX_RETAINED[] = { 0, 1024, 16384, 1 << 20 };
+
+            for (int ti = 0; ti < 4; ++ti) {
+                const bsl::size_t MAX = MAX_RETAINED[ti];
+
+                if (veryVerbose) { T_ P(MAX) }
+
+                bslma::TestAllocator allocator("Local Allocator",
+                                               veryVeryVeryVerbose);
+                {
+                    Obj mX(&allocator);
+
+                    Int64 numBlocksTotal = -1;
+
+                    for (int round = 0; round < 5; ++round) {
+                        for (int i = 0; i < k_NUM_ALLOCATIONS; ++i) {
+                            mX.allocate(k_ALLOCATION_SIZE);
+                        }
+
+                        // The memory allocated by the last two rounds is the
+                        // same.
+
+                        if (round >= 3) {
+                            ASSERTV(MAX, round, numBlocksTotal ==
+                                                  allocator.numBlocksTotal());
+                        }
+                        numBlocksTotal = allocator.numBlocksTotal();
+
+                        const Int64 numBlocksInUse =
+                                                    allocator.numBlocksInUse();
+
+                        mX.rewind(MAX);
+
+                        const Int64 numBytesRetained =
+                                                    allocator.numBytesInUse();
+
+                        ASSERTV(MAX, round, 1 <= allocator.numBlocksInUse());
+                        ASSERTV(MAX, round,
+                                numBlocksInUse >= allocator.numBlocksInUse());
+
+                        // Buffers other than the largest are retained only
+                        // within 'MAX'.
+
+                        if (1 < allocator.numBlocksInUse()) {
+                            ASSERTV(MAX, round, numBytesRetained,
+                                    numBytesRetained <= static_cast<Int64>(
+                                                                       MAX));
+                        }
+
+                        // The first allocation following 'rewind' reuses a
+                        // retained buffer.
+
+                        void *next = mX.allocate(k_ALLOCATION_SIZE);
+                        ASSERTV(MAX, round,
+                                numBlocksTotal == allocator.numBlocksTotal());
+                        ASSERTV(MAX, round, next);
+
+                        mX.rewind(MAX);
+
+                        ASSERTV(MAX, round,
+                              numBytesRetained == allocator.numBytesInUse());
+                    }
+
+                    // In the steady state, the retained memory holds all the
+                    // allocations of a round.
+
+                    ASSERTV(MAX, allocator.numBytesInUse(),
+                            k_NUM_ALLOCATIONS * k_ALLOCATION_SIZE
+                                                 <= allocator.numBytesInUse());
+                    if (0 == MAX) {
+                        ASSERTV(MAX, 1 == allocator.numBlocksInUse());
+                    }
+                }
+                ASSERTV(MAX, 0 == allocator.numBytesInUse());
+            }
+        }
+
+        if (verbose) cout << "\nTesting constant growth." << endl;
+        {
+            const bsl::size_t MAX_RETAINED[] = { 0, 1024, 4096, 1 << 20 };
+            const Int64       EXP_BLOCKS[]   = { 1,    4,   16,      40 };
+
+            for (int ti = 0; ti < 4; ++ti) {
+                const bsl::size_t MAX = MAX_RETAINED[ti];
+                const Int64       EXP = EXP_BLOCKS[ti];
+
+                if (veryVerbose) { T_ P_(MAX) P(EXP) }
+
+                bslma::TestAllocator allocator("Local Allocator",
+                                               veryVeryVeryVerbose);
+                {
+                    Obj mX(256,
+                           bsls::BlockGrowth::BSLS_CONSTANT,
+                           &allocator);
+
+                    // Each block holds two allocations.
+
+                    for (int i = 0; i < 80; ++i) {
+                        mX.allocate(k_ALLOCATION_SIZE);
+                    }
+                    ASSERTV(MAX, 40 == allocator.numBlocksInUse());
+
+                    mX.rewind(MAX);
+
+                    ASSERTV(MAX, allocator.numBlocksInUse(),
+                            EXP == allocator.numBlocksInUse());
+
+                    const Int64 numBlocksTotal = allocator.numBlocksTotal();
+
+                    for (int i = 0; i < 2 * EXP; ++i) {
+                        mX.allocate(k_ALLOCATION_SIZE);
+                    }
+                    ASSERTV(MAX, numBlocksTotal == allocator.numBlocksTotal());
+                }
+                ASSERTV(MAX, 0 == allocator.numBytesInUse());
+            }
+        }
+
+        if (verbose) cout << "\nTesting large blocks." << endl;
+        {
+            bslma::TestAllocator allocator("Local Allocator",
+                                           veryVeryVeryVerbose);
+            {
+                Obj mX(256, 1024, &allocator);
+
+                mX.allocate(100);
+
+                const Int64 numBytesInUse = allocator.numBytesInUse();
+
+                mX.allocate(4096);
+
+                ASSERT(numBytesInUse < allocator.numBytesInUse());
+
+                mX.rewind(1 << 20);
+
+                ASSERT(numBytesInUse == allocator.numBytesInUse());
+            }
+            ASSERT(0 == allocator.numBytesInUse());
+        }
+      } break;
       case 11: {
         // -------------------------------------------------------------------
         // TESTING 'rewind'
@@ -0,0 +1,355 @@
+// bdlma_threadcacheregistry.cpp                                      -*-C++-*-
+#include <bdlma_threadcacheregistry.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_threadcacheregistry_cpp,"$Id$ $CSID$")
+
+#include <bslma_newdeleteallocator.h>
+
+#include <bslmt_lockguard.h>
+#include <bslmt_once.h>
+
+#include <bsls_assert.h>
+
+#include <bsl_algorithm.h>
+#include <bsl_cstring.h>
+#include <bsl_vector.h>
+
+namespace BloombergLP {
+namespace bdlma {
+
+namespace {
+
+                         // ============
+                         // struct Slots
+                         // ============
+
+struct Slots {
+    // This 'struct' holds the state shared by all registries: the key of the
+    // table of each thread, and the registry having each slot.
+
+    // DATA
+    bslmt::ThreadUtil::Key             d_key;         // key of the table of
+                                                      // each thread
+
+    bslmt::Mutex                       d_mutex;       // protects the members
+                                                      // below
+
+    bsl::vector<ThreadCacheRegistry *> d_registries;  // registry having each
+                                                      // slot, or 0
+
+    bsl::vector<int>                   d_freeSlots;   // slots having no
+                                                      // registry
+
+    bsls::Types::Uint64                d_nextSerial;  // serial number of the
+                                                      // next registry
+
+    // CREATORS
+    explicit Slots(bslma::Allocator *basicAllocator)
+        // Create an object having no slots, using the specified
+        // 'basicAllocator' to supply memory.
+    : d_registries(basicAllocator)
+    , d_freeSlots(basicAllocator)
+    , d_nextSerial(1)
+    {
+    }
+};
+
+Slots *g_slots_p = 0;  // created with the first registry, never destroyed
+
+}  // close unnamed namespace
+
+                         // -------------------------
+                         // class ThreadCacheRegistry
+                         // -------------------------
+
+// PRIVATE CLASS METHODS
+void ThreadCacheRegistry::releaseTable(void *table)
+{
+    // The registry having the slot of an entry is looked up, and kept from
+    // completing 'releaseCaches' by 'd_numExiting', under the mutex of the
+    // slots, so that the entry is released either here or by 'releaseCaches'
+    // (which first gives up the slot under that mutex), but not by both.
+    // Note that a release function may register a cache for this thread in
+    // another registry, which creates a new table to be released on a later
+    // iteration of the thread-specific storage destructors.
+
+    Table *t = static_cast<Table *>(table);
+    Entry *e = entries(t);
+
+    for (bsls::Types::Uint64 i = 0; i < t->d_numEntries; ++i) {
+        if (!e[i].d_cache_p) {
+            continue;
+        }
+
+        ThreadCacheRegistry *registry = 0;
+        {
+            bslmt::LockGuard<bslmt::Mutex> guard(&g_slots_p->d_mutex);
+
+            ThreadCacheRegistry *candidate = g_slots_p->d_registries[i];
+
+            if (candidate && candidate->d_serial == e[i].d_serial) {
+                candidate->d_numExiting.addRelaxed(1);
+                registry = candidate;
+            }
+        }
+
+        if (registry) {
+            Header *header = static_cast<Header *>(e[i].d_cache_p) - 1;
+
+            registry->release(&header->d_link);
+
+            // 'registry' may be destroyed as soon as 'd_numExiting' drops.
+
+            registry->d_numExiting.add(-1);
+        }
+    }
+
+    bslma::NewDeleteAllocator::singleton().deallocate(t);
+}
+
+// PRIVATE MANIPULATORS
+void ThreadCacheRegistry::release(Link *link)
+{
+    // The cache is unlinked before it is released, so that 'visitCaches'
+    // never observes a cache whose content has been destroyed.
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        if (link->d_prev_p) {
+            link->d_prev_p->d_next_p = link->d_next_p;
+        }
+        else {
+            d_caches_p = link->d_next_p;
+        }
+        if (link->d_next_p) {
+            link->d_next_p->d_prev_p = link->d_prev_p;
+        }
+    }
+    d_numCaches.addRelaxed(-1);
+
+    Header *header = reinterpret_cast<Header *>(link);
+
+    d_releaseFunction(header + 1, d_context_p);
+
+    d_allocAdapter.deallocate(header);
+}
+
+// CREATORS
+ThreadCacheRegistry::ThreadCacheRegistry(bsl::size_t       cacheSize,
+                                         ReleaseFunction   releaseFunction,
+                                         void             *context,
+                                         bslma::Allocator *basicAllocator)
+: d_cacheSize(cacheSize)
+, d_releaseFunction(releaseFunction)
+, d_context_p(context)
+, d_allocAdapter(&d_allocMutex, basicAllocator)
+, d_caches_p(0)
+, d_numCaches(0)
+, d_slot(0)
+, d_serial(0)
+, d_numExiting(0)
+{
+    BSLS_ASSERT(0 < cacheSize);
+    BSLS_ASSERT(releaseFunction);
+
+    BSLMT_ONCE_DO {
+        bslma::Allocator *allocator = &bslma::NewDeleteAllocator::singleton();
+
+        g_slots_p = new (*allocator) Slots(allocator);
+
+        int rc = bslmt::ThreadUtil::createKey(
+                                        &g_slots_p->d_key,
+                                        (bslmt::ThreadUtil::Destructor)
+                                        &ThreadCacheRegistry::releaseTable);
+        BSLS_ASSERT_OPT(0 == rc);
+    }
+
+    d_key = g_slots_p->d_key;
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&g_slots_p->d_mutex);
+
+    d_serial = g_slots_p->d_nextSerial++;
+
+    if (g_slots_p->d_freeSlots.empty()) {
+        d_slot = static_cast<int>(g_slots_p->d_registries.size());
+        g_slots_p->d_registries.push_back(this);
+    }
+    else {
+        d_slot = g_slots_p->d_freeSlots.back();
+        g_slots_p->d_freeSlots.pop_back();
+        g_slots_p->d_registries[d_slot] = this;
+    }
+}
+
+ThreadCacheRegistry::~ThreadCacheRegistry()
+{
+    releaseCaches();
+}
+
+// MANIPULATORS
+void *ThreadCacheRegistry::allocateCache()
+{
+    Header *header = static_cast<Header *>(d_allocAdapter.allocate(
+                                                sizeof(Header) + d_cacheSize));
+
+    header->d_link.d_registry_p = this;
+
+    return header + 1;
+}
+
+void ThreadCacheRegistry::registerCache(void *cache)
+{
+    BSLS_ASSERT(cache);
+    BSLS_ASSERT(d_serial);
+    BSLS_ASSERT(0 == localCache());
+
+    Link *link = &(static_cast<Header *>(cache) - 1)->d_link;
+
+    BSLS_ASSERT(this == link->d_registry_p);
+
+    const bsls::Types::Uint64 slot = static_cast<bsls::Types::Uint64>(d_slot);
+
+    Table *table = static_cast<Table *>(bslmt::ThreadUtil::getSpecific(d_key));
+
+    if (!table || table->d_numEntries <= slot) {
+        // Grow the table of this thread to hold the entry of this registry.
+        // Note that the table is accessed only by this thread.
+
+        typedef bsls::Types::Uint64 Uint64;
+
+        const Uint64 k_MIN_NUM_ENTRIES = 8;
+
+        const Uint64 numEntries    = table ? table->d_numEntries : 0;
+        const Uint64 newNumEntries = bsl::max(
+                                      slot + 1,
+                                      bsl::max(numEntries * 2,
+                                               k_MIN_NUM_ENTRIES));
+
+        bslma::Allocator *allocator = &bslma::NewDeleteAllocator::singleton();
+
+        Table *newTable = static_cast<Table *>(allocator->allocate(
+                           sizeof(Table)
+                         + static_cast<bsl::size_t>(newNumEntries)
+                                                            * sizeof(Entry)));
+
+        newTable->d_numEntries = newNumEntries;
+        bsl::memset(entries(newTable),
+                    0,
+                    static_cast<bsl::size_t>(newNumEntries) * sizeof(Entry));
+
+        if (table) {
+            bsl::memcpy(entries(newTable),
+                        entries(table),
+                        static_cast<bsl::size_t>(numEntries) * sizeof(Entry));
+        }
+
+        int rc = bslmt::ThreadUtil::setSpecific(d_key, newTable);
+        BSLS_ASSERT_OPT(0 == rc);
+
+        if (table) {
+            allocator->deallocate(table);
+        }
+        table = newTable;
+    }
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        link->d_prev_p = 0;
+        link->d_next_p = d_caches_p;
+        if (d_caches_p) {
+            d_caches_p->d_prev_p = link;
+        }
+        d_caches_p = link;
+    }
+    d_numCaches.addRelaxed(1);
+
+    Entry& entry = entries(table)[slot];
+
+    entry.d_serial  = d_serial;
+    entry.d_cache_p = cache;
+}
+
+void ThreadCacheRegistry::releaseCaches()
+{
+    if (!d_serial) {
+        return;                                                       // RETURN
+    }
+
+    // Once the slot is given up, no exiting thread starts releasing a cache
+    // of this registry (see 'releaseTable'); the caches of the threads that
+    // have started are unlinked once 'd_numExiting' drops to 0, so that the
+    // caches remaining in the list are released only here.
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&g_slots_p->d_mutex);
+
+        g_slots_p->d_registries[d_slot] = 0;
+        g_slots_p->d_freeSlots.push_back(d_slot);
+    }
+    d_serial = 0;
+
+    while (d_numExiting.loadAcquire()) {
+        bslmt::ThreadUtil::yield();
+    }
+
+    while (d_caches_p) {
+        release(d_caches_p);
+    }
+}
+
+void ThreadCacheRegistry::releaseLocalCache()
+{
+    void *cache = localCache();
+
+    if (!cache) {
+        return;                                                       // RETURN
+    }
+
+    Table *table = static_cast<Table *>(bslmt::ThreadUtil::getSpecific(d_key));
+    Entry& entry = entries(table)[d_slot];
+
+    entry.d_serial  = 0;
+    entry.d_cache_p = 0;
+
+    release(&(static_cast<Header *>(cache) - 1)->d_link);
+}
+
+// ACCESSORS
+bool ThreadCacheRegistry::visitCaches(VisitFunction  visitor,
+                                      void          *context) const
+{
+    BSLS_ASSERT(visitor);
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+    for (const Link *link = d_caches_p; link; link = link->d_next_p) {
+        const Header *header = reinterpret_cast<const Header *>(link);
+
+        if (!visitor(header + 1, context)) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,475 @@
+// bdlma_threadcacheregistry.h                                        -*-C++-*-
+#ifndef INCLUDED_BDLMA_THREADCACHEREGISTRY
+#define INCLUDED_BDLMA_THREADCACHEREGISTRY
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a registry of per-thread caches released on thread exit.
+//
+//@CLASSES:
+//  bdlma::ThreadCacheRegistry: thread-safe registry of per-thread caches
+//
+//@SEE_ALSO: bdlma_threadcachingallocator, bdlma_arenaregistry
+//
+//@DESCRIPTION: This component provides a mechanism,
+// 'bdlma::ThreadCacheRegistry', that maintains, on behalf of an owning object,
+// one "cache" -- a block of memory of a size specified at construction, whose
+// content is defined by the owner -- for each thread that has registered one.
+// The cache of the calling thread is found through a table owned by that
+// thread (see "Thread-Specific Storage Keys" below), without accessing any
+// memory shared between threads.
+// The registry links the caches of all threads, so that they can be visited
+// (e.g., to inspect state published by each thread) and released when the
+// owner is destroyed.
+//
+// A "release function" supplied at construction is invoked on the cache of a
+// thread when that thread exits (or calls 'releaseLocalCache'), and on every
+// remaining cache when 'releaseCaches' is called (or the registry is
+// destroyed), after which the memory of the cache is reclaimed by the
+// registry.  The release function is expected to hand the content of the
+// cache back to its owner (e.g., return cached memory blocks to a shared
+// pool) and to destroy any object constructed in the cache.
+//
+// The registry also supplies, through 'allocator', a thread-safe adapter of
+// its underlying allocator, from which the caches are allocated, and which the
+// owner can use for its other memory.  The adapter is serialized by a mutex
+// distinct from the one protecting the list of caches, and may therefore be
+// used while 'visitCaches' is in progress.
+//
+///Thread-Specific Storage Keys
+///----------------------------
+// The number of thread-specific storage keys available to a process is
+// limited (see 'bslmt::ThreadUtil::createKey', and 'PTHREAD_KEYS_MAX' on POSIX
+// platforms), so registries do not use a key each.  All registries share a
+// single key, created with the first registry and never deleted, whose value
+// in each thread is a table of the caches of that thread, indexed by a "slot"
+// that each registry holds for its lifetime (and that is reused by registries
+// created afterwards).  The number of registries that may exist at once is
+// therefore not bounded by the number of keys, and creating a registry only
+// takes a lock shared by all registries.  The table of a thread grows to hold
+// the highest slot for which the thread has registered a cache, and is freed
+// (after the caches it holds are released) when the thread exits.
+//
+///Thread Safety
+///-------------
+// 'bdlma::ThreadCacheRegistry' is *fully thread-safe*, meaning any operation
+// on the same object can be safely invoked from any thread, except
+// 'releaseCaches', which must not be called concurrently with any other
+// operation.  The behavior is undefined if the registry is destroyed while
+// any other thread is using it.  A registry may be destroyed (or
+// 'releaseCaches' called) while threads that have registered a cache exit:
+// each cache is released exactly once, either by its exiting thread, in
+// which case 'releaseCaches' waits for that release to complete, or by
+// 'releaseCaches'.  The caches themselves are accessed without
+// synchronization by the registry: the content of a cache is intended to be
+// modified only by its thread, and read by other threads (in 'visitCaches')
+// only through atomic members.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Counting Events per Thread
+///- - - - - - - - - - - - - - - - - - -
+// Suppose that many threads increment a counter, and that the total is read
+// rarely.  Rather than contending on a single atomic counter, each thread
+// increments a counter in its own cache, and the total is computed by visiting
+// the caches.  The counts of exited threads are accumulated by the release
+// function.
+//
+// First, we define the counter, using a registry of caches each holding one
+// 'bsls::AtomicInt64':
+//..
+//  class EventCounter {
+//      // This class counts events recorded by any number of threads.
+//
+//      // DATA
+//      bdlma::ThreadCacheRegistry d_registry;  // per-thread counts
+//      bsls::AtomicInt64          d_retired;   // counts of exited threads
+//
+//      // PRIVATE CLASS METHODS
+//      static void releaseCount(void *cache, void *counter)
+//          // Add the count held in the specified 'cache' to the counts of
+//          // exited threads of the specified 'counter'.
+//      {
+//          static_cast<EventCounter *>(counter)->d_retired.addRelaxed(
+//                           static_cast<bsls::AtomicInt64 *>(cache)->load());
+//      }
+//
+//      static bool addCount(const void *cache, void *total)
+//          // Add the count held in the specified 'cache' to the specified
+//          // 'total', and return 'true'.
+//      {
+//          *static_cast<bsls::Types::Int64 *>(total) +=
+//                     static_cast<const bsls::AtomicInt64 *>(cache)->load();
+//          return true;
+//      }
+//
+//    public:
+//      // CREATORS
+//      explicit EventCounter(bslma::Allocator *basicAllocator = 0)
+//          // Create a counter having no events.  Optionally specify a
+//          // 'basicAllocator' used to supply memory.  If 'basicAllocator'
+//          // is 0, the currently installed default allocator is used.
+//      : d_registry(sizeof(bsls::AtomicInt64),
+//                   &EventCounter::releaseCount,
+//                   this,
+//                   basicAllocator)
+//      , d_retired(0)
+//      {
+//      }
+//
+//      // MANIPULATORS
+//      void increment()
+//          // Record an event for the calling thread.
+//      {
+//          bsls::AtomicInt64 *count =
+//                  static_cast<bsls::AtomicInt64 *>(d_registry.localCache());
+//
+//          if (!count) {
+//              count = new (d_registry.allocateCache()) bsls::AtomicInt64(0);
+//              d_registry.registerCache(count);
+//          }
+//          count->storeRelaxed(count->loadRelaxed() + 1);
+//      }
+//
+//      // ACCESSORS
+//      bsls::Types::Int64 total() const
+//          // Return the number of events recorded.
+//      {
+//          bsls::Types::Int64 total = d_retired.load();
+//          d_registry.visitCaches(&EventCounter::addCount, &total);
+//          return total;
+//      }
+//  };
+//..
+// Note that the count of a thread is incremented by its thread only, so that
+// the increment need not be an atomic read-modify-write operation.
+//
+// Then, we create a counter and record a few events from this thread:
+//..
+//  bslma::TestAllocator allocator;
+//  {
+//      EventCounter counter(&allocator);
+//
+//      for (int i = 0; i < 10; ++i) {
+//          counter.increment();
+//      }
+//      assert(10 == counter.total());
+//..
+// Finally, we observe that the cache of this thread was allocated from the
+// supplied allocator, and is released with the counter:
+//..
+//      assert(1 == allocator.numBlocksInUse());
+//  }
+//  assert(0 == allocator.numBlocksInUse());
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_CONCURRENTALLOCATORADAPTER
+#include <bdlma_concurrentallocatoradapter.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_MUTEX
+#include <bslmt_mutex.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_THREADUTIL
+#include <bslmt_threadutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+#ifndef INCLUDED_BSL_CSTDDEF
+#include <bsl_cstddef.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+                         // =========================
+                         // class ThreadCacheRegistry
+                         // =========================
+
+class ThreadCacheRegistry {
+    // This class provides a thread-safe registry of per-thread caches, each
+    // found through a table owned by its thread, and released by a function
+    // supplied at construction when its thread exits.
+
+  public:
+    // TYPES
+    typedef void (*ReleaseFunction)(void *cache, void *context);
+        // 'ReleaseFunction' is an alias for the type of the function invoked
+        // on a cache, with the context supplied at construction, before the
+        // memory of the cache is reclaimed.
+
+    typedef bool (*VisitFunction)(const void *cache, void *context);
+        // 'VisitFunction' is an alias for the type of the function invoked by
+        // 'visitCaches' on each cache, returning 'false' to stop the visit.
+
+  private:
+    // PRIVATE TYPES
+    struct Link {
+        // This 'struct' links the caches of a registry.
+
+        ThreadCacheRegistry *d_registry_p;  // registry of the cache
+        Link                *d_next_p;      // next cache of registry
+        Link                *d_prev_p;      // previous cache of registry
+    };
+
+    union Header {
+        // This 'union' precedes each cache in memory, keeping the cache
+        // maximally aligned.
+
+        Link                                d_link;   // links of the cache
+        bsls::AlignmentUtil::MaxAlignedType d_dummy;  // force alignment
+    };
+
+    struct Entry {
+        // This 'struct' holds the cache of a thread for the registry having
+        // a slot.
+
+        bsls::Types::Uint64  d_serial;   // serial number of the registry of
+                                         // 'd_cache_p', or 0
+
+        void                *d_cache_p;  // cache of the thread, or 0
+    };
+
+    struct Table {
+        // This 'struct' precedes in memory the 'd_numEntries' entries holding
+        // the caches of a thread, indexed by slot.
+
+        bsls::Types::Uint64 d_numEntries;  // number of entries
+    };
+
+    // DATA
+    const bsl::size_t           d_cacheSize;        // size of each cache
+
+    const ReleaseFunction       d_releaseFunction;  // invoked on each
+                                                    // released cache
+
+    void                       *d_context_p;        // argument of
+                                                    // 'd_releaseFunction'
+                                                    // (held, not owned)
+
+    bslmt::Mutex                d_allocMutex;       // serializes the
+                                                    // underlying allocator
+                                                    // (may be locked while
+                                                    // 'd_mutex' is held)
+
+    ConcurrentAllocatorAdapter  d_allocAdapter;     // thread-safe adapter of
+                                                    // the underlying
+                                                    // allocator
+
+    mutable bslmt::Mutex        d_mutex;            // protects the list of
+                                                    // caches
+
+    Link                       *d_caches_p;         // caches of all threads
+
+    bsls::AtomicInt             d_numCaches;        // number of caches
+
+    bslmt::ThreadUtil::Key      d_key;              // key, shared by all
+                                                    // registries, of the
+                                                    // table of each thread
+
+    int                         d_slot;             // index of the entries
+                                                    // of this registry
+
+    bsls::Types::Uint64         d_serial;           // serial number of this
+                                                    // registry, or 0 once
+                                                    // 'releaseCaches' has
+                                                    // given up 'd_slot'
+
+    bsls::AtomicInt             d_numExiting;       // number of threads
+                                                    // releasing their cache
+                                                    // on exit
+
+    // PRIVATE CLASS METHODS
+    static Entry *entries(Table *table);
+    static const Entry *entries(const Table *table);
+        // Return the address of the entries of the specified 'table'.
+
+    static void releaseTable(void *table);
+        // Release the caches held by the specified 'table' whose registries
+        // have not released them, and deallocate 'table'.  Note that this
+        // method is called on exit of each thread having a table.
+
+    // PRIVATE MANIPULATORS
+    void release(Link *link);
+        // Remove the cache having the specified 'link' from the list of
+        // caches, invoke the release function on it, and deallocate it.
+
+  private:
+    // NOT IMPLEMENTED
+    ThreadCacheRegistry(const ThreadCacheRegistry&);
+    ThreadCacheRegistry& operator=(const ThreadCacheRegistry&);
+
+  public:
+    // CREATORS
+    ThreadCacheRegistry(bsl::size_t       cacheSize,
+                        ReleaseFunction   releaseFunction,
+                        void             *context,
+                        bslma::Allocator *basicAllocator = 0);
+        // Create a registry having no caches, whose caches have the specified
+        // 'cacheSize' (in bytes), and are released by invoking the specified
+        // 'releaseFunction' with the specified 'context'.  Optionally specify
+        // a 'basicAllocator' used to supply memory.  If 'basicAllocator' is
+        // 0, the currently installed default allocator is used.  The behavior
+        // is undefined unless '0 < cacheSize' and 'releaseFunction' is not 0.
+
+    ~ThreadCacheRegistry();
+        // Release the remaining caches of this registry (see
+        // 'releaseCaches'), and destroy it.
+
+    // MANIPULATORS
+    void *allocateCache();
+        // Return the address of a maximally-aligned block of 'cacheSize()'
+        // bytes, to be initialized by the caller and registered as the cache
+        // of the calling thread by 'registerCache'.
+
+    bslma::Allocator *allocator();
+        // Return the address of a thread-safe adapter of the underlying
+        // allocator of this registry.
+
+    void registerCache(void *cache);
+        // Register the specified 'cache' as the cache of the calling thread,
+        // to be released on exit of the calling thread.  The behavior is
+        // undefined unless 'cache' was returned by 'allocateCache', and the
+        // calling thread has no cache.
+
+    void releaseCaches();
+        // Stop releasing the caches of this registry on thread exit, wait for
+        // the releases by exiting threads in progress to complete, then
+        // invoke the release function on each remaining cache, and deallocate
+        // it.  No cache can be registered afterwards.  This method is intended
+        // to be called by the destructor of the owner of this registry, before
+        // the state that the release function accesses is destroyed.  The
+        // behavior is undefined if any other thread is using this registry.
+
+    void releaseLocalCache();
+        // Release the cache of the calling thread, if any, as on exit of the
+        // calling thread.
+
+    // ACCESSORS
+    bsl::size_t cacheSize() const;
+        // Return the size (in bytes) of each cache of this registry.
+
+    void *localCache() const;
+        // Return the address of the cache of the calling thread, or 0 if it
+        // has none.
+
+    int numCaches() const;
+        // Return the number of caches of this registry.
+
+    bool visitCaches(VisitFunction visitor, void *context) const;
+        // Invoke the specified 'visitor' with the specified 'context' on each
+        // cache of this registry, while the list of caches is locked, until
+        // 'visitor' returns 'false'.  Return 'true' if 'visitor' returned
+        // 'true' for every cache, and 'false' otherwise.  The behavior is
+        // undefined if 'visitor' registers or releases a cache of this
+        // registry.
+};
+
+// ============================================================================
+//                             INLINE DEFINITIONS
+// ============================================================================
+
+                         // -------------------------
+                         // class ThreadCacheRegistry
+                         // -------------------------
+
+// PRIVATE CLASS METHODS
+inline
+ThreadCacheRegistry::Entry *ThreadCacheRegistry::entries(Table *table)
+{
+    return reinterpret_cast<Entry *>(table + 1);
+}
+
+inline
+const ThreadCacheRegistry::Entry *
+ThreadCacheRegistry::entries(const Table *table)
+{
+    return reinterpret_cast<const Entry *>(table + 1);
+}
+
+// MANIPULATORS
+inline
+bslma::Allocator *ThreadCacheRegistry::allocator()
+{
+    return &d_allocAdapter;
+}
+
+// ACCESSORS
+inline
+bsl::size_t ThreadCacheRegistry::cacheSize() const
+{
+    return d_cacheSize;
+}
+
+inline
+void *ThreadCacheRegistry::localCache() const
+{
+    // An entry left by a released registry having had the same slot has a
+    // different serial number, and an empty entry, whose serial number is 0,
+    // holds no cache.
+
+    const Table *table = static_cast<const Table *>(
+                                       bslmt::ThreadUtil::getSpecific(d_key));
+
+    if (table
+     && static_cast<bsls::Types::Uint64>(d_slot) < table->d_numEntries) {
+        const Entry& entry = entries(table)[d_slot];
+
+        if (entry.d_serial == d_serial) {
+            return entry.d_cache_p;                                   // RETURN
+        }
+    }
+    return 0;
+}
+
+inline
+int ThreadCacheRegistry::numCaches() const
+{
+    return d_numCaches.loadRelaxed();
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,909 @@
+// bdlma_threadcacheregistry.t.cpp                                    -*-C++-*-
+#include <bdlma_threadcacheregistry.h>
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_atomic.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>     // 'atoi'
+#include <bsl_cstring.h>     // 'memset'
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+#include <new>               // placement 'new'
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a thread-safe registry of per-thread caches,
+// each released by a function supplied at construction when its thread exits.
+// We verify that a registered cache is found by its thread only, that the
+// release function is invoked exactly once on each cache -- on thread exit,
+// on 'releaseLocalCache', or on 'releaseCaches' and destruction -- with the
+// supplied context, that the caches are visited while registered, and that
+// all memory is returned to the underlying allocator, also when the registry
+// is used concurrently by many threads.  We also verify that more registries
+// than thread-specific storage keys available to a process can coexist, and
+// that a registry can be destroyed while threads having a cache exit.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] ThreadCacheRegistry(size_t, ReleaseFunction, void *, Allocator *);
+// [ 2] ~ThreadCacheRegistry();
+//
+// MANIPULATORS
+// [ 2] void *allocateCache();
+// [ 2] bslma::Allocator *allocator();
+// [ 2] void registerCache(void *cache);
+// [ 3] void releaseCaches();
+// [ 2] void releaseLocalCache();
+//
+// ACCESSORS
+// [ 2] size_t cacheSize() const;
+// [ 2] void *localCache() const;
+// [ 2] int numCaches() const;
+// [ 4] bool visitCaches(VisitFunction visitor, void *context) const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 3] THREAD EXIT
+// [ 5] CONCURRENCY
+// [ 6] MANY REGISTRIES
+// [ 7] DESTRUCTION DURING THREAD EXIT
+// [ 8] USAGE EXAMPLE
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                  GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::ThreadCacheRegistry Obj;
+
+// ============================================================================
+//                      HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+                             // ================
+                             // struct TestCache
+                             // ================
+
+struct TestCache {
+    // This 'struct' provides the content of the caches of the registries
+    // under test.
+
+    bsls::AtomicInt d_value;    // value published by the thread
+    char            d_pad[40];  // scribbled by the thread
+};
+
+                            // ===================
+                            // struct ReleaseCount
+                            // ===================
+
+struct ReleaseCount {
+    // This 'struct' is the context of 'releaseTestCache', recording the
+    // caches released.
+
+    bsls::AtomicInt d_numReleased;  // number of caches released
+    bsls::AtomicInt d_sumReleased;  // sum of the values of released caches
+    bsls::AtomicInt d_numErrors;    // number of corrupted caches released
+};
+
+void releaseTestCache(void *cache, void *context)
+    // Record the release of the specified 'cache', which must be the address
+    // of a 'TestCache' object, in the specified 'context', which must be the
+    // address of a 'ReleaseCount' object, and destroy the 'TestCache'.
+{
+    TestCache    *c     = static_cast<TestCache *>(cache);
+    ReleaseCount *count = static_cast<ReleaseCount *>(context);
+
+    for (int i = 0; i < static_cast<int>(sizeof c->d_pad); ++i) {
+        if (static_cast<char>(c->d_value.loadRelaxed()) != c->d_pad[i]) {
+            count->d_numErrors.addRelaxed(1);
+            break;
+        }
+    }
+
+    count->d_numReleased.addRelaxed(1);
+    count->d_sumReleased.addRelaxed(c->d_value.loadRelaxed());
+
+    c->~TestCache();
+}
+
+bool sumTestCache(const void *cache, void *context)
+    // Add the value of the specified 'cache', which must be the address of a
+    // 'TestCache' object, to the 'int' at the specified 'context', and return
+    // 'true' unless that value is negative.
+{
+    const TestCache *c = static_cast<const TestCache *>(cache);
+
+    *static_cast<int *>(context) += c->d_value.load();
+
+    return 0 <= c->d_value.load();
+}
+
+TestCache *createTestCache(Obj *registry, int value)
+    // Create a cache holding the specified 'value' in the specified
+    // 'registry', register it as the cache of the calling thread, and return
+    // its address.
+{
+    TestCache *cache = new (registry->allocateCache()) TestCache();
+
+    cache->d_value = value;
+    memset(cache->d_pad, value, sizeof cache->d_pad);
+
+    registry->registerCache(cache);
+
+    return cache;
+}
+
+                             // =================
+                             // struct ThreadArgs
+                             // =================
+
+struct ThreadArgs {
+    // This 'struct' holds the arguments of 'registerThread'.
+
+    Obj             *d_registry_p;   // registry under test
+    int              d_value;        // value of the cache of the thread
+    int              d_iterations;   // number of release/register cycles
+    bsls::AtomicInt *d_numErrors_p;  // number of errors observed
+};
+
+extern "C" void *registerThread(void *arg)
+    // Register and release the caches described by the specified 'arg',
+    // which must be the address of a 'ThreadArgs' object, leaving a cache
+    // registered on exit, and verify that the cache of the calling thread is
+    // not affected by other threads.
+{
+    ThreadArgs *args     = static_cast<ThreadArgs *>(arg);
+    Obj        *registry = args->d_registry_p;
+
+    for (int i = 0; i < args->d_iterations; ++i) {
+        if (registry->localCache()) {
+            args->d_numErrors_p->addRelaxed(1);
+        }
+
+        TestCache *cache = createTestCache(registry, args->d_value);
+
+        int sum = 0;
+        registry->visitCaches(&sumTestCache, &sum);
+
+        if (cache != registry->localCache()
+         || args->d_value != cache->d_value.loadRelaxed()) {
+            args->d_numErrors_p->addRelaxed(1);
+        }
+
+        if (i + 1 < args->d_iterations) {
+            registry->releaseLocalCache();
+        }
+    }
+    return 0;
+}
+
+                            // ==================
+                            // struct ExitingArgs
+                            // ==================
+
+struct ExitingArgs {
+    // This 'struct' holds the arguments of 'registerAndExit'.
+
+    Obj            *d_registry_p;  // registry under test
+    int             d_value;       // value of the cache of the thread
+    bslmt::Barrier *d_barrier_p;   // reached once the cache is registered
+};
+
+extern "C" void *registerAndExit(void *arg)
+    // Register a cache as described by the specified 'arg', which must be the
+    // address of an 'ExitingArgs' object, wait on its barrier, and exit
+    // without using the registry again.
+{
+    ExitingArgs *args = static_cast<ExitingArgs *>(arg);
+
+    createTestCache(args->d_registry_p, args->d_value);
+
+    args->d_barrier_p->wait();
+    return 0;
+}
+
+//=============================================================================
+//                                USAGE EXAMPLE
+//-----------------------------------------------------------------------------
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Counting Events per Thread
+///- - - - - - - - - - - - - - - - - - -
+// Suppose that many threads increment a counter, and that the total is read
+// rarely.  Rather than contending on a single atomic counter, each thread
+// increments a counter in its own cache, and the total is computed by visiting
+// the caches.  The counts of exited threads are accumulated by the release
+// function.
+//
+// First, we define the counter, using a registry of caches each holding one
+// 'bsls::AtomicInt64':
+//..
+class EventCounter {
+    // This class counts events recorded by any number of threads.
+
+    // DATA
+    bdlma::ThreadCacheRegistry d_registry;  // per-thread counts
+    bsls::AtomicInt64          d_retired;   // counts of exited threads
+
+    // PRIVATE CLASS METHODS
+    static void releaseCount(void *cache, void *counter)
+        // Add the count held in the specified 'cache' to the counts of
+        // exited threads of the specified 'counter'.
+    {
+        static_cast<EventCounter *>(counter)->d_retired.addRelaxed(
+                         static_cast<bsls::AtomicInt64 *>(cache)->load());
+    }
+
+    static bool addCount(const void *cache, void *total)
+        // Add the count held in the specified 'cache' to the specified
+        // 'total', and return 'true'.
+    {
+        *static_cast<bsls::Types::Int64 *>(total) +=
+                   static_cast<const bsls::AtomicInt64 *>(cache)->load();
+        return true;
+    }
+
+  public:
+    // CREATORS
+    explicit EventCounter(bslma::Allocator *basicAllocator = 0)
+        // Create a counter having no events.  Optionally specify a
+        // 'basicAllocator' used to supply memory.  If 'basicAllocator'
+        // is 0, the currently installed default allocator is used.
+    : d_registry(sizeof(bsls::AtomicInt64),
+                 &EventCounter::releaseCount,
+                 this,
+                 basicAllocator)
+    , d_retired(0)
+    {
+    }
+
+    // MANIPULATORS
+    void increment()
+        // Record an event for the calling thread.
+    {
+        bsls::AtomicInt64 *count =
+                static_cast<bsls::AtomicInt64 *>(d_registry.localCache());
+
+        if (!count) {
+            count = new (d_registry.allocateCache()) bsls::AtomicInt64(0);
+            d_registry.registerCache(count);
+        }
+        count->storeRelaxed(count->loadRelaxed() + 1);
+    }
+
+    // ACCESSORS
+    bsls::Types::Int64 total() const
+        // Return the number of events recorded.
+    {
+        bsls::Types::Int64 total = d_retired.load();
+        d_registry.visitCaches(&EventCounter::addCount, &total);
+        return total;
+    }
+};
+//..
+// Note that the count of a thread is incremented by its thread only, so that
+// the increment need not be an atomic read-modify-write operation.
+
+//=============================================================================
+//                              MAIN PROGRAM
+//-----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int  test            = argc > 1 ? atoi(argv[1]) : 0;
+    const bool verbose         = argc > 2;
+    const bool veryVerbose     = argc > 3;
+    const bool veryVeryVerbose = argc > 4;
+
+    (void)veryVerbose;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator da("default", veryVeryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we create a counter and record a few events from this thread:
+//..
+    bslma::TestAllocator allocator;
+    {
+        EventCounter counter(&allocator);
+
+        for (int i = 0; i < 10; ++i) {
+            counter.increment();
+        }
+        ASSERT(10 == counter.total());
+//..
+// Finally, we observe that the cache of this thread was allocated from the
+// supplied allocator, and is released with the counter:
+//..
+        ASSERT(1 == allocator.numBlocksInUse());
+    }
+    ASSERT(0 == allocator.numBlocksInUse());
+//..
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // DESTRUCTION DURING THREAD EXIT
+        //
+        // Concerns:
+        //: 1 A registry can be destroyed while threads having registered a
+        //:   cache exit, and each cache is then released exactly once, either
+        //:   by its thread or by the destructor.
+        //
+        // Plan:
+        //: 1 Repeatedly create a registry, run several threads each
+        //:   registering a cache and exiting once all threads have registered
+        //:   theirs, and destroy the registry as soon as the threads start
+        //:   exiting.  After joining the threads, verify the number and sum of
+        //:   the released caches, and that all memory was returned.  (C-1)
+        //
+        // Testing:
+        //   DESTRUCTION DURING THREAD EXIT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "DESTRUCTION DURING THREAD EXIT" << endl
+                          << "==============================" << endl;
+
+        enum { k_NUM_THREADS = 4, k_NUM_ITERATIONS = 200 };
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+
+        for (int ti = 0; ti < k_NUM_ITERATIONS; ++ti) {
+            ReleaseCount   count;
+            bslmt::Barrier barrier(k_NUM_THREADS + 1);
+
+            Obj *mX = new (ta) Obj(sizeof(TestCache),
+                                   &releaseTestCache,
+                                   &count,
+                                   &ta);
+
+            ExitingArgs               args[k_NUM_THREADS];
+            bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                args[i].d_registry_p = mX;
+                args[i].d_value      = i + 1;
+                args[i].d_barrier_p  = &barrier;
+
+                ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                      registerAndExit,
+                                                      &args[i]));
+            }
+
+            barrier.wait();
+
+            ta.deleteObject(mX);
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+
+            LOOP2_ASSERT(ti, count.d_numReleased,
+                         k_NUM_THREADS == count.d_numReleased);
+            LOOP2_ASSERT(ti, count.d_sumReleased,
+                         k_NUM_THREADS * (k_NUM_THREADS + 1) / 2
+                                                      == count.d_sumReleased);
+            LOOP2_ASSERT(ti, count.d_numErrors, 0 == count.d_numErrors);
+            LOOP2_ASSERT(ti, ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // MANY REGISTRIES
+        //
+        // Concerns:
+        //: 1 More registries than thread-specific storage keys available to
+        //:   a process (e.g., 'PTHREAD_KEYS_MAX', 1024 on Linux) can exist at
+        //:   once, each having its own cache for each thread.
+        //:
+        //: 2 A registry created after another was destroyed does not find the
+        //:   caches of the destroyed registry, and the caches of both are
+        //:   released exactly once.
+        //
+        // Plan:
+        //: 1 Create more registries than keys available, register a cache
+        //:   holding a distinct value in each of them, and verify the cache
+        //:   found in each of them.  (C-1)
+        //:
+        //: 2 Destroy the registries, create new ones (reusing the slots of the
+        //:   destroyed registries), and verify that they have no cache for
+        //:   this thread.  Register caches in the new registries, destroy
+        //:   them, and verify the number and sum of the released caches.
+        //:   (C-2)
+        //
+        // Testing:
+        //   MANY REGISTRIES
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "MANY REGISTRIES" << endl
+                          << "===============" << endl;
+
+        enum { k_NUM_REGISTRIES = 3000 };
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        ReleaseCount         count;
+
+        {
+            bsl::vector<Obj *> registries(&ta);
+
+            for (int i = 0; i < k_NUM_REGISTRIES; ++i) {
+                registries.push_back(new (ta) Obj(sizeof(TestCache),
+                                                  &releaseTestCache,
+                                                  &count,
+                                                  &ta));
+                createTestCache(registries.back(), i % 100);
+            }
+
+            for (int i = 0; i < k_NUM_REGISTRIES; ++i) {
+                const TestCache *cache = static_cast<const TestCache *>(
+                                                 registries[i]->localCache());
+
+                ASSERTV(i, cache);
+                ASSERTV(i, !cache || i % 100 == cache->d_value);
+            }
+
+            for (int i = 0; i < k_NUM_REGISTRIES; ++i) {
+                ta.deleteObject(registries[i]);
+            }
+            ASSERTV(count.d_numReleased,
+                    k_NUM_REGISTRIES == count.d_numReleased);
+
+            for (int i = 0; i < k_NUM_REGISTRIES; ++i) {
+                registries[i] = new (ta) Obj(sizeof(TestCache),
+                                             &releaseTestCache,
+                                             &count,
+                                             &ta);
+                ASSERTV(i, 0 == registries[i]->localCache());
+            }
+
+            for (int i = 0; i < k_NUM_REGISTRIES; ++i) {
+                createTestCache(registries[i], 1);
+                ta.deleteObject(registries[i]);
+            }
+
+            ASSERTV(count.d_numReleased,
+                    2 * k_NUM_REGISTRIES == count.d_numReleased);
+            ASSERTV(count.d_sumReleased,
+                    k_NUM_REGISTRIES / 100 * 4950 + k_NUM_REGISTRIES
+                                                      == count.d_sumReleased);
+            ASSERTV(count.d_numErrors, 0 == count.d_numErrors);
+        }
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY
+        //
+        // Concerns:
+        //: 1 Caches registered and released concurrently by several threads
+        //:   are found by their thread only, and are not corrupted.
+        //:
+        //: 2 Each cache is released exactly once, and all memory is returned
+        //:   to the underlying allocator.
+        //
+        // Plan:
+        //: 1 Run several threads, each repeatedly registering a cache holding
+        //:   a distinct value, visiting the caches, and releasing its cache,
+        //:   leaving a cache registered on exit.  Verify the cache of the
+        //:   calling thread after each registration.  (C-1)
+        //:
+        //: 2 After joining the threads, verify the number and sum of the
+        //:   released caches, and that the test allocator has no blocks in
+        //:   use after the registry is destroyed.  (C-2)
+        //
+        // Testing:
+        //   CONCURRENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY" << endl
+                          << "===========" << endl;
+
+        enum { k_NUM_THREADS = 8, k_NUM_ITERATIONS = 500 };
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        ReleaseCount         count;
+        bsls::AtomicInt      numErrors(0);
+        {
+            Obj mX(sizeof(TestCache), &releaseTestCache, &count, &ta);
+            const Obj& X = mX;
+
+            ThreadArgs                args[k_NUM_THREADS];
+            bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                args[i].d_registry_p  = &mX;
+                args[i].d_value       = i + 1;
+                args[i].d_iterations  = k_NUM_ITERATIONS;
+                args[i].d_numErrors_p = &numErrors;
+
+                ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                      registerThread,
+                                                      &args[i]));
+            }
+            for (int i = 0; i < k_NUM_THREADS; ++i) {
+                ASSERT(0 == bslmt::ThreadUtil::join(handles[i]));
+            }
+
+            ASSERTV(X.numCaches(), 0 == X.numCaches());
+        }
+        ASSERTV(numErrors, 0 == numErrors);
+        ASSERTV(count.d_numErrors, 0 == count.d_numErrors);
+        ASSERTV(count.d_numReleased,
+                k_NUM_THREADS * k_NUM_ITERATIONS == count.d_numReleased);
+        ASSERTV(count.d_sumReleased,
+                k_NUM_ITERATIONS * k_NUM_THREADS * (k_NUM_THREADS + 1) / 2
+                                                      == count.d_sumReleased);
+        ASSERTV(ta.numBlocksInUse(), 0 == ta.numBlocksInUse());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // 'visitCaches'
+        //
+        // Concerns:
+        //: 1 'visitCaches' invokes the visitor, with the supplied context, on
+        //:   each registered cache, and on no released cache.
+        //:
+        //: 2 The visit stops, returning 'false', when the visitor returns
+        //:   'false', and returns 'true' otherwise (including when there is
+        //:   no cache).
+        //
+        // Plan:
+        //: 1 Visit the caches of a registry having no cache, then after each
+        //:   of several threads has registered a cache holding a distinct
+        //:   value and exited, and after this thread has registered a cache,
+        //:   summing the values of the caches.  (C-1..2)
+        //:
+        //: 2 Register a cache holding a negative value, and verify that the
+        //:   visit returns 'false'.  (C-2)
+        //
+        // Testing:
+        //   bool visitCaches(VisitFunction visitor, void *context) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "'visitCaches'" << endl
+                          << "=============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        ReleaseCount         count;
+        {
+            Obj mX(sizeof(TestCache), &releaseTestCache, &count, &ta);
+            const Obj& X = mX;
+
+            int sum = 0;
+            ASSERT(true == X.visitCaches(&sumTestCache, &sum));
+            ASSERT(0    == sum);
+
+            createTestCache(&mX, 5);
+
+            sum = 0;
+            ASSERT(true == X.visitCaches(&sumTestCache, &sum));
+            ASSERT(5    == sum);
+
+            mX.releaseLocalCache();
+
+            sum = 0;
+            ASSERT(true == X.visitCaches(&sumTestCache, &sum));
+            ASSERT(0    == sum);
+
+            createTestCache(&mX, -1);
+
+            sum = 0;
+            ASSERT(false == X.visitCaches(&sumTestCache, &sum));
+            ASSERT(-1    == sum);
+        }
+        ASSERT(2 == count.d_numReleased);
+        ASSERT(0 == count.d_numErrors);
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // THREAD EXIT
+        //
+        // Concerns:
+        //: 1 The cache of a thread is released, and its memory returned to
+        //:   the underlying allocator, when the thread exits.
+        //:
+        //: 2 'releaseCaches' releases the caches of the threads that have not
+        //:   exited, and caches are not released again on thread exit
+        //:   afterwards.
+        //:
+        //: 3 Destroying a registry after 'releaseCaches' has no effect on the
+        //:   released caches.
+        //
+        // Plan:
+        //: 1 Run a thread registering a cache and exiting, and verify that the
+        //:   cache was released.  (C-1)
+        //:
+        //: 2 Register a cache from this thread, call 'releaseCaches', and
+        //:   verify that it was released once, also after the registry is
+        //:   destroyed.  (C-2..3)
+        //
+        // Testing:
+        //   void releaseCaches();
+        //   THREAD EXIT
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "THREAD EXIT" << endl
+                          << "===========" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        ReleaseCount         count;
+        bsls::AtomicInt      numErrors(0);
+        {
+            Obj mX(sizeof(TestCache), &releaseTestCache, &count, &ta);
+            const Obj& X = mX;
+
+            ThreadArgs args = { &mX, 7, 1, &numErrors };
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  registerThread,
+                                                  &args));
+            ASSERT(0 == bslmt::ThreadUtil::join(handle));
+
+            ASSERT(0 == numErrors);
+            ASSERT(1 == count.d_numReleased);
+            ASSERT(7 == count.d_sumReleased);
+            ASSERT(0 == X.numCaches());
+            ASSERT(0 == ta.numBlocksInUse());
+
+            createTestCache(&mX, 3);
+            ASSERT(1 == X.numCaches());
+
+            mX.releaseCaches();
+
+            ASSERT(2  == count.d_numReleased);
+            ASSERT(10 == count.d_sumReleased);
+            ASSERT(0  == X.numCaches());
+            ASSERT(0  == ta.numBlocksInUse());
+        }
+        ASSERT(2 == count.d_numReleased);
+        ASSERT(0 == count.d_numErrors);
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // PRIMARY MANIPULATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 A registry has no cache when created, and reports the supplied
+        //:   cache size.
+        //:
+        //: 2 'allocateCache' returns maximally-aligned memory from the
+        //:   supplied allocator (or the default allocator), which becomes the
+        //:   cache of the calling thread when registered.
+        //:
+        //: 3 'allocator' returns an adapter of the supplied allocator.
+        //:
+        //: 4 'releaseLocalCache' invokes the release function, with the
+        //:   supplied context, on the cache of the calling thread, after which
+        //:   the thread has no cache, and has no effect if it has none.
+        //:
+        //: 5 A cache registered again after 'releaseLocalCache' is released
+        //:   on destruction.
+        //
+        // Plan:
+        //: 1 Create registries with and without an allocator, register and
+        //:   release caches from this thread, checking the accessors, the
+        //:   release counts, and the blocks in use of the allocators.
+        //:   (C-1..5)
+        //
+        // Testing:
+        //   ThreadCacheRegistry(size_t, ReleaseFunction, void *, Allocator *);
+        //   ~ThreadCacheRegistry();
+        //   void *allocateCache();
+        //   bslma::Allocator *allocator();
+        //   void registerCache(void *cache);
+        //   void releaseLocalCache();
+        //   size_t cacheSize() const;
+        //   void *localCache() const;
+        //   int numCaches() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout
+                        << endl
+                        << "PRIMARY MANIPULATORS AND BASIC ACCESSORS" << endl
+                        << "========================================" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        ReleaseCount         count;
+        {
+            Obj mX(sizeof(TestCache), &releaseTestCache, &count, &ta);
+            const Obj& X = mX;
+
+            ASSERT(sizeof(TestCache) == X.cacheSize());
+            ASSERT(0                 == X.localCache());
+            ASSERT(0                 == X.numCaches());
+
+            void *memory = mX.allocateCache();
+            ASSERT(memory);
+            ASSERT(0 == reinterpret_cast<bsls::Types::UintPtr>(memory)
+                              % bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT);
+            ASSERT(1 == ta.numBlocksInUse());
+            ASSERT(0 == X.localCache());
+
+            TestCache *cache = new (memory) TestCache();
+            cache->d_value = 1;
+            memset(cache->d_pad, 1, sizeof cache->d_pad);
+
+            mX.registerCache(cache);
+            ASSERT(cache == X.localCache());
+            ASSERT(1     == X.numCaches());
+
+            void *block = mX.allocator()->allocate(10);
+            ASSERT(2 == ta.numBlocksInUse());
+            mX.allocator()->deallocate(block);
+
+            mX.releaseLocalCache();
+            ASSERT(1 == count.d_numReleased);
+            ASSERT(0 == X.localCache());
+            ASSERT(0 == X.numCaches());
+            ASSERT(0 == ta.numBlocksInUse());
+
+            mX.releaseLocalCache();
+            ASSERT(1 == count.d_numReleased);
+
+            createTestCache(&mX, 2);
+            ASSERT(1 == X.numCaches());
+        }
+        ASSERT(2 == count.d_numReleased);
+        ASSERT(3 == count.d_sumReleased);
+        ASSERT(0 == count.d_numErrors);
+        ASSERT(0 == ta.numBlocksInUse());
+
+        {
+            Obj mX(sizeof(TestCache), &releaseTestCache, &count);
+
+            createTestCache(&mX, 4);
+            ASSERT(1 == da.numBlocksInUse());
+        }
+        ASSERT(3 == count.d_numReleased);
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create a registry, register a cache, and release it on
+        //:   destruction.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVeryVerbose);
+        ReleaseCount         count;
+        {
+            Obj mX(sizeof(TestCache), &releaseTestCache, &count, &ta);
+
+            ASSERT(0 == mX.localCache());
+
+            TestCache *cache = createTestCache(&mX, 9);
+            ASSERT(cache == mX.localCache());
+        }
+        ASSERT(1 == count.d_numReleased);
+        ASSERT(9 == count.d_sumReleased);
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
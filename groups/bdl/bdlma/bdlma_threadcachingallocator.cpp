@@ -0,0 +1,368 @@
+// bdlma_threadcachingallocator.cpp                                   -*-C++-*-
+#include <bdlma_threadcachingallocator.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(bdlma_threadcachingallocator_cpp,"$Id$ $CSID$")
+
+#include <bdlma_concurrentpool.h>
+
+#include <bdlb_bitutil.h>
+
+#include <bslmt_lockguard.h>
+
+#include <bslma_autodestructor.h>
+#include <bslma_deallocatorproctor.h>
+
+#include <bslmf_assert.h>
+
+#include <bsls_assert.h>
+#include <bsls_blockgrowth.h>
+#include <bsls_performancehint.h>
+
+#include <bsl_cstdint.h>
+
+#include <new>           // placement 'new'
+
+namespace BloombergLP {
+
+enum {
+    k_DEFAULT_NUM_POOLS      = 10,
+    k_DEFAULT_MAGAZINE_SIZE  = 32,
+    k_DEFAULT_MAX_CHUNK_SIZE = 32,
+    k_MIN_BLOCK_SIZE         = 8,
+    k_MAX_NUM_POOLS          = 29
+};
+
+namespace bdlma {
+
+                        // ----------------------------
+                        // class ThreadCachingAllocator
+                        // ----------------------------
+
+// PRIVATE CLASS METHODS
+void ThreadCachingAllocator::releaseCache(void *cache, void *allocator)
+{
+    Cache                  *c = static_cast<Cache *>(cache);
+    ThreadCachingAllocator *a = static_cast<ThreadCachingAllocator *>(
+                                                                   allocator);
+
+    for (int i = 0; i < a->d_numPools; ++i) {
+        Bin& bin = c->d_bins[i];
+
+        if (bin.d_numLoaded) {
+            a->pushMagazine(i, bin.d_loaded_p, bin.d_numLoaded);
+        }
+        if (bin.d_numPrevious) {
+            a->pushMagazine(i, bin.d_previous_p, bin.d_numPrevious);
+        }
+    }
+}
+
+// PRIVATE MANIPULATORS
+void ThreadCachingAllocator::initialize()
+{
+    BSLMF_ASSERT(sizeof(Link) <= sizeof(Header) + k_MIN_BLOCK_SIZE);
+
+    BSLS_ASSERT(1 <= d_numPools);
+    BSLS_ASSERT(d_numPools <= k_MAX_NUM_POOLS);
+    BSLS_ASSERT(1 <= d_magazineSize);
+
+    d_maxBlockSize = k_MIN_BLOCK_SIZE;
+
+    bslma::Allocator *allocator = d_caches.allocator();
+
+    d_pools_p = static_cast<ConcurrentPool *>(
+                          allocator->allocate(d_numPools * sizeof *d_pools_p));
+
+    bslma::DeallocatorProctor<bslma::Allocator> autoPoolsDeallocator(
+                                                                  d_pools_p,
+                                                                  allocator);
+    bslma::AutoDestructor<ConcurrentPool> autoDtor(d_pools_p, 0);
+
+    for (int i = 0; i < d_numPools; ++i, ++autoDtor) {
+        new (d_pools_p + i) ConcurrentPool(
+                             d_maxBlockSize + static_cast<int>(sizeof(Header)),
+                             bsls::BlockGrowth::BSLS_GEOMETRIC,
+                             k_DEFAULT_MAX_CHUNK_SIZE,
+                             allocator);
+
+        d_maxBlockSize *= 2;
+    }
+
+    d_maxBlockSize /= 2;
+
+    d_depots_p = static_cast<Depot *>(
+                         allocator->allocate(d_numPools * sizeof *d_depots_p));
+
+    for (int i = 0; i < d_numPools; ++i) {
+        new (d_depots_p + i) Depot();
+        d_depots_p[i].d_magazines_p = 0;
+    }
+
+    autoDtor.release();
+    autoPoolsDeallocator.release();
+}
+
+ThreadCachingAllocator::Cache *ThreadCachingAllocator::createCache()
+{
+    Cache *cache = static_cast<Cache *>(d_caches.allocateCache());
+
+    for (int i = 0; i < d_numPools; ++i) {
+        Bin& bin = cache->d_bins[i];
+
+        bin.d_loaded_p    = 0;
+        bin.d_numLoaded   = 0;
+        bin.d_previous_p  = 0;
+        bin.d_numPrevious = 0;
+    }
+
+    d_caches.registerCache(cache);
+
+    return cache;
+}
+
+void ThreadCachingAllocator::exchangeEmpty(Bin *bin, int poolIdx)
+{
+    BSLS_ASSERT(0 == bin->d_numLoaded);
+
+    if (bin->d_numPrevious) {
+        bin->d_loaded_p    = bin->d_previous_p;
+        bin->d_numLoaded   = bin->d_numPrevious;
+        bin->d_previous_p  = 0;
+        bin->d_numPrevious = 0;
+        return;                                                       // RETURN
+    }
+
+    Depot& depot = d_depots_p[poolIdx];
+    {
+        bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+
+        Link *magazine = depot.d_magazines_p;
+        if (magazine) {
+            depot.d_magazines_p = magazine->d_nextMagazine_p;
+
+            bin->d_loaded_p  = magazine;
+            bin->d_numLoaded = magazine->d_numBlocks;
+            return;                                                   // RETURN
+        }
+    }
+
+    // The depot is empty: fill the magazine from the pool, one block at a
+    // time, so that the blocks obtained so far are cached if the pool throws.
+
+    ConcurrentPool& pool = d_pools_p[poolIdx];
+    for (int i = 0; i < d_magazineSize; ++i) {
+        Link *link = static_cast<Link *>(pool.allocate());
+
+        link->d_next_p  = bin->d_loaded_p;
+        bin->d_loaded_p = link;
+        ++bin->d_numLoaded;
+    }
+}
+
+void ThreadCachingAllocator::exchangeFull(Bin *bin, int poolIdx)
+{
+    BSLS_ASSERT(d_magazineSize == bin->d_numLoaded);
+
+    if (bin->d_numPrevious) {
+        pushMagazine(poolIdx, bin->d_previous_p, bin->d_numPrevious);
+    }
+
+    bin->d_previous_p  = bin->d_loaded_p;
+    bin->d_numPrevious = bin->d_numLoaded;
+    bin->d_loaded_p    = 0;
+    bin->d_numLoaded   = 0;
+}
+
+inline
+ThreadCachingAllocator::Cache *ThreadCachingAllocator::localCache()
+{
+    Cache *cache = static_cast<Cache *>(d_caches.localCache());
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == cache)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        cache = createCache();
+    }
+    return cache;
+}
+
+void ThreadCachingAllocator::pushMagazine(int   poolIdx,
+                                          Link *magazine,
+                                          int   numBlocks)
+{
+    magazine->d_numBlocks = numBlocks;
+
+    Depot& depot = d_depots_p[poolIdx];
+
+    bslmt::LockGuard<bslmt::Mutex> guard(&depot.d_mutex);
+
+    magazine->d_nextMagazine_p = depot.d_magazines_p;
+    depot.d_magazines_p        = magazine;
+}
+
+// PRIVATE ACCESSORS
+inline
+int ThreadCachingAllocator::findPool(bsls::Types::size_type size) const
+{
+    return 31 - bdlb::BitUtil::numLeadingUnsetBits(static_cast<bsl::uint32_t>(
+                                ((size + k_MIN_BLOCK_SIZE - 1) >> 3) * 2 - 1));
+}
+
+// CREATORS
+ThreadCachingAllocator::ThreadCachingAllocator(
+                                              bslma::Allocator *basicAllocator)
+: d_numPools(k_DEFAULT_NUM_POOLS)
+, d_magazineSize(k_DEFAULT_MAGAZINE_SIZE)
+, d_caches(sizeof(Cache) + (d_numPools - 1) * sizeof(Bin),
+           &ThreadCachingAllocator::releaseCache,
+           this,
+           basicAllocator)
+, d_blockList(d_caches.allocator())
+{
+    initialize();
+}
+
+ThreadCachingAllocator::ThreadCachingAllocator(
+                                              int               numPools,
+                                              bslma::Allocator *basicAllocator)
+: d_numPools(numPools)
+, d_magazineSize(k_DEFAULT_MAGAZINE_SIZE)
+, d_caches(sizeof(Cache) + (d_numPools - 1) * sizeof(Bin),
+           &ThreadCachingAllocator::releaseCache,
+           this,
+           basicAllocator)
+, d_blockList(d_caches.allocator())
+{
+    initialize();
+}
+
+ThreadCachingAllocator::ThreadCachingAllocator(
+                                              int               numPools,
+                                              int               magazineSize,
+                                              bslma::Allocator *basicAllocator)
+: d_numPools(numPools)
+, d_magazineSize(magazineSize)
+, d_caches(sizeof(Cache) + (d_numPools - 1) * sizeof(Bin),
+           &ThreadCachingAllocator::releaseCache,
+           this,
+           basicAllocator)
+, d_blockList(d_caches.allocator())
+{
+    initialize();
+}
+
+ThreadCachingAllocator::~ThreadCachingAllocator()
+{
+    // The blocks cached by all threads are returned to the depots, then
+    // released with the pools.
+
+    d_caches.releaseCaches();
+
+    d_blockList.release();
+
+    for (int i = 0; i < d_numPools; ++i) {
+        d_depots_p[i].~Depot();
+    }
+    d_caches.allocator()->deallocate(d_depots_p);
+
+    for (int i = 0; i < d_numPools; ++i) {
+        d_pools_p[i].release();
+        d_pools_p[i].~ConcurrentPool();
+    }
+    d_caches.allocator()->deallocate(d_pools_p);
+}
+
+// MANIPULATORS
+void *ThreadCachingAllocator::allocate(size_type size)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(size)) {
+        if (size <= d_maxBlockSize) {
+            const int  poolIdx = findPool(size);
+            Bin       *bin     = localCache()->d_bins + poolIdx;
+
+            if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == bin->d_numLoaded)) {
+                BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+                exchangeEmpty(bin, poolIdx);
+            }
+
+            Link *link = bin->d_loaded_p;
+
+            bin->d_loaded_p = link->d_next_p;
+            --bin->d_numLoaded;
+
+            Header *p = static_cast<Header *>(static_cast<void *>(link));
+
+            p->d_header.d_poolIdx = poolIdx;
+
+            return p + 1;                                             // RETURN
+        }
+
+        // The requested size is large and will not be pooled.
+
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+
+        Header *p = static_cast<Header *>(
+                d_blockList.allocate(size + static_cast<int>(sizeof(Header))));
+
+        p->d_header.d_poolIdx = -1;
+
+        return p + 1;                                                 // RETURN
+    }
+
+    return 0;
+}
+
+void ThreadCachingAllocator::deallocate(void *address)
+{
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(0 == address)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        return;                                                       // RETURN
+    }
+
+    Header *h = static_cast<Header *>(address) - 1;
+
+    const int poolIdx = h->d_header.d_poolIdx;
+
+    if (-1 == poolIdx) {
+        bslmt::LockGuard<bslmt::Mutex> guard(&d_mutex);
+        d_blockList.deallocate(h);
+        return;                                                       // RETURN
+    }
+
+    Bin *bin = localCache()->d_bins + poolIdx;
+
+    if (BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(
+                                       d_magazineSize == bin->d_numLoaded)) {
+        BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+        exchangeFull(bin, poolIdx);
+    }
+
+    Link *link = static_cast<Link *>(static_cast<void *>(h));
+
+    link->d_next_p  = bin->d_loaded_p;
+    bin->d_loaded_p = link;
+    ++bin->d_numLoaded;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,415 @@
+// bdlma_threadcachingallocator.h                                     -*-C++-*-
+#ifndef INCLUDED_BDLMA_THREADCACHINGALLOCATOR
+#define INCLUDED_BDLMA_THREADCACHINGALLOCATOR
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a thread-safe pooling allocator with per-thread caches.
+//
+//@CLASSES:
+//  bdlma::ThreadCachingAllocator: pooling allocator with per-thread caches
+//
+//@SEE_ALSO: bdlma_concurrentpool, bdlma_concurrentmultipoolallocator
+//
+//@DESCRIPTION: This component provides a thread-safe allocator,
+// 'bdlma::ThreadCachingAllocator', implementing the 'bslma::Allocator'
+// protocol, that, like 'bdlma::ConcurrentMultipoolAllocator', maintains an
+// array of 'bdlma::ConcurrentPool' objects dispensing blocks whose sizes are
+// successive powers of two, starting at 8 bytes, and obtains larger blocks
+// directly from the underlying allocator.  Unlike
+// 'bdlma::ConcurrentMultipoolAllocator', however, most allocation and
+// deallocation requests do not access any memory shared between threads:
+// blocks of each size are allocated from, and deallocated to, a cache private
+// to the calling thread, and blocks move between the caches of different
+// threads only in bulk.
+//..
+//  ,-----------------------------.
+// ( bdlma::ThreadCachingAllocator )
+//  `-----------------------------'
+//                 |         ctor/dtor
+//                 |         magazineSize
+//                 |         maxPooledBlockSize
+//                 |         numPools
+//                 V
+//        ,----------------.
+//       ( bslma::Allocator )
+//        `----------------'
+//                         allocate
+//                         deallocate
+//..
+//
+///Magazines
+///---------
+// The cache of each thread holds, for each block size, up to two chains
+// ("magazines") of at most 'magazineSize()' free blocks.  'allocate' removes a
+// block from the current magazine and 'deallocate' adds one to it, without
+// synchronization.  When the current magazine is empty (on allocation) or full
+// (on deallocation), it is exchanged with the other magazine, if that is full
+// (respectively empty), and otherwise with a shared "depot" of full magazines
+// (one for each block size) protected by a mutex, so that the depot is
+// accessed at most once for every 'magazineSize()' requests of the thread.
+// When the depot has no magazine to supply, a magazine is filled from the
+// 'bdlma::ConcurrentPool' of the block size.
+//
+// A block deallocated by a thread other than the one that allocated it is
+// simply added to the cache of the deallocating thread: no thread ever
+// modifies the cache of another, and magazines are exchanged with the depot
+// only while holding its mutex, so the allocator is not subject to the ABA
+// problem that affects lock-free free lists.
+//
+// When a thread that has used the allocator exits, the blocks in its cache are
+// returned to the depots, and the cache itself is deallocated.  Memory
+// dispensed by the pools is released only when the allocator is destroyed.
+//
+// Note that the cache of a thread is found through a thread-specific storage
+// key shared by all users of 'bdlma_threadcacheregistry', so that the number
+// of allocators that may exist at once is not bounded by the number of keys
+// available to a process (see 'bslmt::ThreadUtil::createKey').  An allocator
+// is nevertheless intended to be long-lived and shared, rather than created
+// for a short-lived task, as the blocks it caches for each thread are not
+// available to other threads.
+//
+///Thread Safety
+///-------------
+// 'bdlma::ThreadCachingAllocator' is *fully thread-safe*, meaning any
+// operation on the same object can be safely invoked from any thread.  The
+// behavior is undefined if the allocator is destroyed while any other thread
+// is using it.  An allocator may be destroyed while threads that have used it
+// exit.  The underlying allocator need not be thread-safe.
+//
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sharing an Allocator Between Worker Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a number of worker threads frequently create and destroy small
+// objects, sometimes destroying objects created by another thread.  A single
+// 'bdlma::ThreadCachingAllocator' serves all of them, without the contention
+// on shared free lists that a 'bdlma::ConcurrentMultipoolAllocator' would
+// incur.
+//
+// First, we define the function executed by each worker thread, which
+// allocates some blocks, and deallocates blocks allocated by another thread:
+//..
+//  struct WorkerArgs {
+//      bdlma::ThreadCachingAllocator  *d_allocator_p;
+//      bslmt::Barrier                 *d_barrier_p;
+//      void                          **d_blocks_p;     // this thread's blocks
+//      void                          **d_neighbor_p;   // another's blocks
+//      int                             d_numBlocks;
+//  };
+//
+//  extern "C" void *workerThread(void *arg)
+//  {
+//      WorkerArgs *args = static_cast<WorkerArgs *>(arg);
+//
+//      for (int i = 0; i < args->d_numBlocks; ++i) {
+//          args->d_blocks_p[i] = args->d_allocator_p->allocate(24 + i % 40);
+//      }
+//
+//      args->d_barrier_p->wait();
+//
+//      for (int i = 0; i < args->d_numBlocks; ++i) {
+//          args->d_allocator_p->deallocate(args->d_neighbor_p[i]);
+//      }
+//      return 0;
+//  }
+//..
+// Then, we create the allocator and the arguments of two worker threads, each
+// of which deallocates the blocks allocated by the other:
+//..
+//  bdlma::ThreadCachingAllocator allocator;
+//
+//  enum { k_NUM_BLOCKS = 100 };
+//
+//  void           *blocks[2][k_NUM_BLOCKS];
+//  bslmt::Barrier  barrier(2);
+//
+//  WorkerArgs args[2];
+//  for (int i = 0; i < 2; ++i) {
+//      args[i].d_allocator_p = &allocator;
+//      args[i].d_barrier_p   = &barrier;
+//      args[i].d_blocks_p    = blocks[i];
+//      args[i].d_neighbor_p  = blocks[1 - i];
+//      args[i].d_numBlocks   = k_NUM_BLOCKS;
+//  }
+//..
+// Finally, we run the threads, and wait for them to complete; on exit, each
+// thread returns the blocks in its cache to the allocator, which releases all
+// memory when it is destroyed:
+//..
+//  bslmt::ThreadUtil::Handle handles[2];
+//  for (int i = 0; i < 2; ++i) {
+//      bslmt::ThreadUtil::create(&handles[i], workerThread, &args[i]);
+//  }
+//  for (int i = 0; i < 2; ++i) {
+//      bslmt::ThreadUtil::join(handles[i]);
+//  }
+//..
+
+#ifndef INCLUDED_BDLSCM_VERSION
+#include <bdlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_BLOCKLIST
+#include <bdlma_blocklist.h>
+#endif
+
+#ifndef INCLUDED_BDLMA_THREADCACHEREGISTRY
+#include <bdlma_threadcacheregistry.h>
+#endif
+
+#ifndef INCLUDED_BSLMA_ALLOCATOR
+#include <bslma_allocator.h>
+#endif
+
+#ifndef INCLUDED_BSLMT_MUTEX
+#include <bslmt_mutex.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ALIGNMENTUTIL
+#include <bsls_alignmentutil.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace bdlma {
+
+class ConcurrentPool;
+
+                        // ============================
+                        // class ThreadCachingAllocator
+                        // ============================
+
+class ThreadCachingAllocator : public bslma::Allocator {
+    // This class implements the 'bslma::Allocator' protocol to provide a
+    // thread-safe allocator that pools blocks of sizes that are powers of two
+    // and serves most requests from a cache private to the calling thread.
+    // See {Magazines}.
+
+    // PRIVATE TYPES
+    struct Header {
+        // This 'struct' provides header information for each allocated memory
+        // block.  The header stores the index of the pool of the block, or -1
+        // if the block was obtained directly from the underlying allocator.
+
+        union {
+            int                                 d_poolIdx;  // pool of block
+            bsls::AlignmentUtil::MaxAlignedType d_dummy;    // force alignment
+        } d_header;
+    };
+
+    struct Link {
+        // This 'struct' overlays the header (and the beginning of the body) of
+        // each free block held in a magazine.
+
+        Link *d_next_p;           // next block in the same magazine
+        Link *d_nextMagazine_p;   // first block of the next magazine in a
+                                  // depot (meaningful only for the first
+                                  // block of a magazine in a depot)
+        int   d_numBlocks;        // number of blocks in the magazine
+                                  // (meaningful only for the first block of a
+                                  // magazine in a depot)
+    };
+
+    struct Bin {
+        // This 'struct' holds the magazines of the blocks of one size cached
+        // by a thread.  'd_numPrevious' is always 0 or the magazine size.
+
+        Link *d_loaded_p;     // current magazine
+        int   d_numLoaded;    // number of blocks in the current magazine
+        Link *d_previous_p;   // other magazine
+        int   d_numPrevious;  // number of blocks in the other magazine
+    };
+
+    struct Cache {
+        // This 'struct' holds the blocks cached by one thread.  It is
+        // allocated with as many bins as the allocator has pools.
+
+        Bin d_bins[1];  // first bin
+    };
+
+    struct Depot {
+        // This 'struct' holds the full magazines of blocks of one size that
+        // are not cached by any thread.
+
+        bslmt::Mutex  d_mutex;        // serializes access to 'd_magazines_p'
+        Link         *d_magazines_p;  // first block of first magazine
+    };
+
+    // DATA
+    int                         d_numPools;      // number of pools
+
+    int                         d_magazineSize;  // maximum number of blocks
+                                                 // in a magazine
+
+    bsls::Types::size_type      d_maxBlockSize;  // largest pooled block size
+
+    bslmt::Mutex                d_mutex;         // serializes access to
+                                                 // 'd_blockList'
+
+    ThreadCacheRegistry         d_caches;        // cache of each thread, and
+                                                 // thread-safe adapter of the
+                                                 // underlying allocator
+
+    ConcurrentPool             *d_pools_p;       // array of pools supplying
+                                                 // blocks of each size
+
+    Depot                      *d_depots_p;      // array of depots, one for
+                                                 // each pool
+
+    BlockList                   d_blockList;     // memory manager for
+                                                 // "large" memory blocks
+
+    // PRIVATE CLASS METHODS
+    static void releaseCache(void *cache, void *allocator);
+        // Return the blocks held by the specified 'cache' to the depots of
+        // the specified 'allocator'.  Note that this method is called on exit
+        // of each thread having a cache.
+
+    // PRIVATE MANIPULATORS
+    Cache *createCache();
+        // Create a cache for the calling thread, and return its address.
+
+    void exchangeEmpty(Bin *bin, int poolIdx);
+        // Replace the empty current magazine of the specified 'bin' of the
+        // pool having the specified 'poolIdx' with a non-empty one, taken
+        // from the other magazine of 'bin' if it is full, from the depot of
+        // the pool if it is not empty, and filled from the pool otherwise.
+
+    void exchangeFull(Bin *bin, int poolIdx);
+        // Replace the full current magazine of the specified 'bin' of the
+        // pool having the specified 'poolIdx' with an empty one, storing the
+        // current magazine as the other magazine of 'bin' if that is empty,
+        // and otherwise moving the other magazine to the depot of the pool.
+
+    Cache *localCache();
+        // Return the address of the cache of the calling thread, creating it
+        // if it does not exist.
+
+    void initialize();
+        // Create the pools and depots of this allocator, as specified by
+        // 'd_numPools'.
+
+    void pushMagazine(int poolIdx, Link *magazine, int numBlocks);
+        // Add the specified 'magazine' holding the specified 'numBlocks'
+        // blocks to the depot of the pool having the specified 'poolIdx'.
+
+    // PRIVATE ACCESSORS
+    int findPool(bsls::Types::size_type size) const;
+        // Return the index of the pool dispensing blocks of the smallest size
+        // not less than the specified 'size'.
+
+  private:
+    // NOT IMPLEMENTED
+    ThreadCachingAllocator(const ThreadCachingAllocator&);
+    ThreadCachingAllocator& operator=(const ThreadCachingAllocator&);
+
+  public:
+    // CREATORS
+    explicit ThreadCachingAllocator(bslma::Allocator *basicAllocator = 0);
+    explicit ThreadCachingAllocator(int               numPools,
+                                    bslma::Allocator *basicAllocator = 0);
+    ThreadCachingAllocator(int               numPools,
+                           int               magazineSize,
+                           bslma::Allocator *basicAllocator = 0);
+        // Create a thread-caching allocator.  Optionally specify 'numPools',
+        // indicating the number of internally created pools; the block size
+        // of the first pool is 8 bytes, with the block size of each additional
+        // pool successively doubling.  If 'numPools' is not specified, an
+        // implementation-defined number of pools is created.  Optionally
+        // specify 'magazineSize', indicating the maximum number of blocks in
+        // each magazine (see {Magazines}).  If 'magazineSize' is not
+        // specified, an implementation-defined value is used.  Optionally
+        // specify a 'basicAllocator' used to supply memory.  If
+        // 'basicAllocator' is 0, the currently installed default allocator is
+        // used.  The behavior is undefined unless '1 <= numPools <= 29' and
+        // '1 <= magazineSize'.
+
+    virtual ~ThreadCachingAllocator();
+        // Destroy this allocator, releasing all memory allocated through it.
+        // The behavior is undefined if any other thread is using this
+        // allocator, or if a thread that has used it exits, during the
+        // destruction.
+
+    // MANIPULATORS
+    virtual void *allocate(size_type size);
+        // Return the address of a contiguous block of maximally-aligned memory
+        // of (at least) the specified 'size' (in bytes).  If
+        // 'size > maxPooledBlockSize()', the block is obtained directly from
+        // the underlying allocator.  If 'size' is 0, no memory is allocated
+        // and 0 is returned.
+
+    virtual void deallocate(void *address);
+        // Return the memory block at the specified 'address' to this
+        // allocator.  If 'address' is 0, this function has no effect.  The
+        // behavior is undefined unless 'address' was allocated using this
+        // allocator object and has not already been deallocated.
+
+    // ACCESSORS
+    int magazineSize() const;
+        // Return the maximum number of blocks in a magazine of this
+        // allocator.
+
+    bsls::Types::size_type maxPooledBlockSize() const;
+        // Return the maximum size of memory blocks that are pooled by this
+        // allocator.  Note that the maximum value is '2 ^ (numPools + 2)'.
+
+    int numPools() const;
+        // Return the number of pools of this allocator.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                        // ----------------------------
+                        // class ThreadCachingAllocator
+                        // ----------------------------
+
+// ACCESSORS
+inline
+int ThreadCachingAllocator::magazineSize() const
+{
+    return d_magazineSize;
+}
+
+inline
+bsls::Types::size_type ThreadCachingAllocator::maxPooledBlockSize() const
+{
+    return d_maxBlockSize;
+}
+
+inline
+int ThreadCachingAllocator::numPools() const
+{
+    return d_numPools;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,1098 @@
+// bdlma_threadcachingallocator.t.cpp                                 -*-C++-*-
+#include <bdlma_threadcachingallocator.h>
+
+#include <bdlma_concurrentmultipoolallocator.h>  // for testing only
+
+#include <bslim_testutil.h>
+
+#include <bslma_default.h>
+#include <bslma_defaultallocatorguard.h>
+#include <bslma_newdeleteallocator.h>
+#include <bslma_testallocator.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_threadutil.h>
+
+#include <bsls_alignmentutil.h>
+#include <bsls_stopwatch.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdio.h>
+#include <bsl_cstdlib.h>     // 'atoi'
+#include <bsl_cstring.h>     // 'memset'
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+//=============================================================================
+//                                  TEST PLAN
+//-----------------------------------------------------------------------------
+//                                  Overview
+//                                  --------
+// The component under test is a thread-safe allocator that serves most
+// requests from a cache private to the calling thread.  We verify that the
+// allocator dispenses maximally-aligned, non-overlapping blocks of at least
+// the requested size, that it reuses deallocated blocks (including blocks
+// deallocated by threads other than the allocating one and blocks held by the
+// cache of a thread that has exited) without obtaining more memory from the
+// underlying allocator, and that all memory is released on destruction, also
+// when the allocator is used concurrently by many threads.
+//-----------------------------------------------------------------------------
+// CREATORS
+// [ 2] ThreadCachingAllocator(Allocator *ba = 0);
+// [ 2] ThreadCachingAllocator(int numPools, Allocator *ba = 0);
+// [ 2] ThreadCachingAllocator(int numPools, int magSize, Allocator *ba = 0);
+// [ 2] ~ThreadCachingAllocator();
+//
+// MANIPULATORS
+// [ 3] void *allocate(size_type size);
+// [ 3] void deallocate(void *address);
+//
+// ACCESSORS
+// [ 2] int magazineSize() const;
+// [ 2] bsls::Types::size_type maxPooledBlockSize() const;
+// [ 2] int numPools() const;
+//-----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 4] THREAD EXIT AND CROSS-THREAD DEALLOCATION
+// [ 5] CONCURRENCY
+// [ 6] USAGE EXAMPLE
+// [-1] PERFORMANCE TEST
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef bdlma::ThreadCachingAllocator Obj;
+typedef bsls::Types::size_type        size_type;
+
+const int MAX_ALIGN = bsls::AlignmentUtil::BSLS_MAX_ALIGNMENT;
+
+// ============================================================================
+//                       HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace {
+
+bool isMaxAligned(const void *address)
+    // Return 'true' if the specified 'address' is maximally aligned, and
+    // 'false' otherwise.
+{
+    return 0 == reinterpret_cast<bsls::Types::UintPtr>(address) % MAX_ALIGN;
+}
+
+void scribble(void *address, size_type size, int value)
+    // Assign the low-order byte of the specified 'value' to each of the
+    // specified 'size' bytes starting at the specified 'address'.
+{
+    bsl::memset(address, value, size);
+}
+
+bool isScribbled(const void *address, size_type size, int value)
+    // Return 'true' if each of the specified 'size' bytes starting at the
+    // specified 'address' has the low-order byte of the specified 'value',
+    // and 'false' otherwise.
+{
+    const unsigned char *p = static_cast<const unsigned char *>(address);
+    for (size_type i = 0; i < size; ++i) {
+        if (static_cast<unsigned char>(value) != p[i]) {
+            return false;                                             // RETURN
+        }
+    }
+    return true;
+}
+
+                           // ======================
+                           // struct AllocateAndFree
+                           // ======================
+
+struct AllocateAndFree {
+    // This 'struct' holds the arguments of 'allocateAndFree'.
+
+    bslma::Allocator *d_allocator_p;  // allocator to use
+    int               d_numBlocks;    // number of blocks to allocate
+    size_type         d_size;         // size of each block
+};
+
+extern "C" void *allocateAndFree(void *arg)
+    // Allocate, then deallocate, the blocks described by the specified 'arg',
+    // which must be the address of an 'AllocateAndFree' object.
+{
+    AllocateAndFree *args = static_cast<AllocateAndFree *>(arg);
+
+    bsl::vector<void *> blocks(args->d_numBlocks,
+                               static_cast<void *>(0),
+                               bslma::NewDeleteAllocator::allocator(0));
+
+    for (int i = 0; i < args->d_numBlocks; ++i) {
+        blocks[i] = args->d_allocator_p->allocate(args->d_size);
+    }
+    for (int i = 0; i < args->d_numBlocks; ++i) {
+        args->d_allocator_p->deallocate(blocks[i]);
+    }
+    return 0;
+}
+
+extern "C" void *allocateOnly(void *arg)
+    // Allocate the blocks described by the specified 'arg', which must be the
+    // address of an 'AllocateAndFree' object, scribbling the value 0x5a over
+    // each, and return the address of an array, allocated with the new-delete
+    // allocator, holding their addresses.
+{
+    AllocateAndFree *args = static_cast<AllocateAndFree *>(arg);
+
+    void **blocks = static_cast<void **>(
+                      bslma::NewDeleteAllocator::allocator(0)->allocate(
+                                          args->d_numBlocks * sizeof(void *)));
+
+    for (int i = 0; i < args->d_numBlocks; ++i) {
+        blocks[i] = args->d_allocator_p->allocate(args->d_size);
+        scribble(blocks[i], args->d_size, 0x5a);
+    }
+    return blocks;
+}
+
+                             // =================
+                             // struct StressArgs
+                             // =================
+
+struct StressArgs {
+    // This 'struct' holds the arguments of 'stressThread'.
+
+    bslma::Allocator  *d_allocator_p;  // allocator under test
+    bslmt::Barrier    *d_barrier_p;    // barrier shared by all threads
+    void             **d_slots_p;      // blocks exchanged between threads,
+                                       // 'd_numThreads * d_numSlots'
+    int                d_index;        // index of this thread
+    int                d_numThreads;   // number of threads
+    int                d_numSlots;     // number of slots per thread
+    int                d_numRounds;    // number of rounds
+    int                d_numErrors;    // number of corrupted blocks found
+};
+
+size_type stressSize(int thread, int slot, int round)
+    // Return the size of the block allocated by the specified 'thread' in the
+    // specified 'slot' during the specified 'round'.
+{
+    return 1 + (thread * 7 + slot * 13 + round * 29) % 300;
+}
+
+extern "C" void *stressThread(void *arg)
+    // In each round, allocate a block of varying size (scribbled with the
+    // index of the allocating thread) for each of the slots of this thread,
+    // also allocating and deallocating a few short-lived blocks, then, after
+    // all threads have done so, verify and deallocate the blocks of the slots
+    // of the next thread.  The specified 'arg' must be the address of a
+    // 'StressArgs' object.
+{
+    StressArgs *args = static_cast<StressArgs *>(arg);
+
+    const int  N    = args->d_numSlots;
+    void     **mine = args->d_slots_p + args->d_index * N;
+
+    const int  NEXT       = (args->d_index + 1) % args->d_numThreads;
+    void     **neighbor   = args->d_slots_p + NEXT * N;
+
+    for (int round = 0; round < args->d_numRounds; ++round) {
+        for (int i = 0; i < N; ++i) {
+            const size_type SIZE = stressSize(args->d_index, i, round);
+
+            mine[i] = args->d_allocator_p->allocate(SIZE);
+            scribble(mine[i], SIZE, args->d_index);
+
+            void *temp = args->d_allocator_p->allocate(SIZE + 1000 * (i % 2));
+            args->d_allocator_p->deallocate(temp);
+        }
+
+        args->d_barrier_p->wait();
+
+        for (int i = 0; i < N; ++i) {
+            const size_type SIZE = stressSize(NEXT, i, round);
+
+            if (!isMaxAligned(neighbor[i])
+             || !isScribbled(neighbor[i], SIZE, NEXT)) {
+                ++args->d_numErrors;
+            }
+            args->d_allocator_p->deallocate(neighbor[i]);
+        }
+
+        args->d_barrier_p->wait();
+    }
+    return 0;
+}
+
+                              // ================
+                              // struct BenchArgs
+                              // ================
+
+struct BenchArgs {
+    // This 'struct' holds the arguments of 'benchThread'.
+
+    bslma::Allocator  *d_allocator_p;  // allocator under test
+    bslmt::Barrier    *d_barrier_p;    // barrier shared by all threads, or 0
+                                       // if blocks are deallocated locally
+    void             **d_slots_p;      // blocks exchanged between threads
+    int                d_index;        // index of this thread
+    int                d_numThreads;   // number of threads
+    int                d_numSlots;     // number of slots per thread
+    int                d_numRounds;    // number of rounds
+};
+
+extern "C" void *benchThread(void *arg)
+    // In each round, allocate a block of varying small size for each of the
+    // slots of this thread, and deallocate them, or, if a barrier is
+    // specified, deallocate the blocks of the next thread after all threads
+    // have allocated theirs.  The specified 'arg' must be the address of a
+    // 'BenchArgs' object.
+{
+    BenchArgs *args = static_cast<BenchArgs *>(arg);
+
+    const int  N    = args->d_numSlots;
+    void     **mine = args->d_slots_p + args->d_index * N;
+    void     **next = args->d_slots_p
+                    + (args->d_index + 1) % args->d_numThreads * N;
+
+    for (int round = 0; round < args->d_numRounds; ++round) {
+        for (int i = 0; i < N; ++i) {
+            mine[i] = args->d_allocator_p->allocate(8 + (i * 8) % 120);
+        }
+
+        if (args->d_barrier_p) {
+            args->d_barrier_p->wait();
+
+            for (int i = 0; i < N; ++i) {
+                args->d_allocator_p->deallocate(next[i]);
+            }
+
+            args->d_barrier_p->wait();
+        }
+        else {
+            for (int i = 0; i < N; ++i) {
+                args->d_allocator_p->deallocate(mine[i]);
+            }
+        }
+    }
+    return 0;
+}
+
+double runBenchmark(bslma::Allocator *allocator,
+                    int               numThreads,
+                    bool              crossThread,
+                    int               numSlots,
+                    int               numRounds)
+    // Run the specified 'numThreads' threads, each performing the specified
+    // 'numRounds' rounds of allocating and deallocating the specified
+    // 'numSlots' blocks using the specified 'allocator', deallocating the
+    // blocks of another thread if the specified 'crossThread' is 'true', and
+    // return the elapsed wall time (in seconds).
+{
+    bslma::Allocator *na = bslma::NewDeleteAllocator::allocator(0);
+
+    bsl::vector<void *>                    slots(numThreads * numSlots,
+                                                 static_cast<void *>(0),
+                                                 na);
+    bsl::vector<BenchArgs>                 args(numThreads, na);
+    bsl::vector<bslmt::ThreadUtil::Handle> handles(numThreads, na);
+    bslmt::Barrier                         barrier(numThreads);
+
+    for (int i = 0; i < numThreads; ++i) {
+        args[i].d_allocator_p = allocator;
+        args[i].d_barrier_p   = crossThread ? &barrier : 0;
+        args[i].d_slots_p     = slots.data();
+        args[i].d_index       = i;
+        args[i].d_numThreads  = numThreads;
+        args[i].d_numSlots    = numSlots;
+        args[i].d_numRounds   = numRounds;
+    }
+
+    bsls::Stopwatch timer;
+    timer.start(true);
+
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::create(&handles[i], benchThread, &args[i]);
+    }
+    for (int i = 0; i < numThreads; ++i) {
+        bslmt::ThreadUtil::join(handles[i]);
+    }
+
+    timer.stop();
+    return timer.elapsedTime();
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                              USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace {
+
+///Usage
+///-----
+// This section illustrates intended use of this component.
+//
+///Example 1: Sharing an Allocator Between Worker Threads
+///- - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Suppose that a number of worker threads frequently create and destroy small
+// objects, sometimes destroying objects created by another thread.  A single
+// 'bdlma::ThreadCachingAllocator' serves all of them, without the contention
+// on shared free lists that a 'bdlma::ConcurrentMultipoolAllocator' would
+// incur.
+//
+// First, we define the function executed by each worker thread, which
+// allocates some blocks, and deallocates blocks allocated by another thread:
+//..
+    struct WorkerArgs {
+        bdlma::ThreadCachingAllocator  *d_allocator_p;
+        bslmt::Barrier                 *d_barrier_p;
+        void                          **d_blocks_p;     // this thread's blocks
+        void                          **d_neighbor_p;   // another's blocks
+        int                             d_numBlocks;
+    };
+
+    extern "C" void *workerThread(void *arg)
+    {
+        WorkerArgs *args = static_cast<WorkerArgs *>(arg);
+
+        for (int i = 0; i < args->d_numBlocks; ++i) {
+            args->d_blocks_p[i] = args->d_allocator_p->allocate(24 + i % 40);
+        }
+
+        args->d_barrier_p->wait();
+
+        for (int i = 0; i < args->d_numBlocks; ++i) {
+            args->d_allocator_p->deallocate(args->d_neighbor_p[i]);
+        }
+        return 0;
+    }
+//..
+
+}  // close unnamed namespace
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    const int  test        = argc > 1 ? atoi(argv[1]) : 0;
+    const bool verbose     = argc > 2;
+    const bool veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    bslma::TestAllocator da("default", veryVerbose);
+    bslma::DefaultAllocatorGuard dag(&da);
+
+    switch (test) { case 0:
+      case 6: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //   Extracted from component header file.
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, remove
+        //:   leading comment characters, and replace 'assert' with 'ASSERT'.
+        //:   (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "USAGE EXAMPLE" << endl
+                          << "=============" << endl;
+
+// Then, we create the allocator and the arguments of two worker threads, each
+// of which deallocates the blocks allocated by the other:
+//..
+    bdlma::ThreadCachingAllocator allocator;
+
+    enum { k_NUM_BLOCKS = 100 };
+
+    void           *blocks[2][k_NUM_BLOCKS];
+    bslmt::Barrier  barrier(2);
+
+    WorkerArgs args[2];
+    for (int i = 0; i < 2; ++i) {
+        args[i].d_allocator_p = &allocator;
+        args[i].d_barrier_p   = &barrier;
+        args[i].d_blocks_p    = blocks[i];
+        args[i].d_neighbor_p  = blocks[1 - i];
+        args[i].d_numBlocks   = k_NUM_BLOCKS;
+    }
+//..
+// Finally, we run the threads, and wait for them to complete; on exit, each
+// thread returns the blocks in its cache to the allocator, which releases all
+// memory when it is destroyed:
+//..
+    bslmt::ThreadUtil::Handle handles[2];
+    for (int i = 0; i < 2; ++i) {
+        bslmt::ThreadUtil::create(&handles[i], workerThread, &args[i]);
+    }
+    for (int i = 0; i < 2; ++i) {
+        bslmt::ThreadUtil::join(handles[i]);
+    }
+//..
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY
+        //
+        // Concerns:
+        //: 1 Blocks allocated concurrently by several threads do not overlap,
+        //:   and are not corrupted by the allocator while in use, also when
+        //:   deallocated by a thread other than the allocating one.
+        //:
+        //: 2 All memory is released on destruction.
+        //
+        // Plan:
+        //: 1 Run several threads that, in each round, allocate blocks of
+        //:   varying sizes, scribbling over each the index of the thread, and,
+        //:   after all threads have done so, verify and deallocate the blocks
+        //:   of another thread.  Use a small magazine size, so that magazines
+        //:   are frequently exchanged with the depots.  (C-1)
+        //:
+        //: 2 Verify that no memory remains in use after destroying the
+        //:   allocator.  (C-2)
+        //
+        // Testing:
+        //   CONCURRENCY
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONCURRENCY" << endl
+                          << "===========" << endl;
+
+        bslma::TestAllocator  ta("object", veryVerbose);
+        bslma::Allocator     *na = bslma::NewDeleteAllocator::allocator(0);
+
+        enum { k_NUM_THREADS = 8, k_NUM_SLOTS = 200, k_NUM_ROUNDS = 50 };
+
+        const int MAGAZINE_SIZES[] = { 1, 4, 32 };
+
+        for (int ti = 0; ti < 3; ++ti) {
+            const int MAGAZINE_SIZE = MAGAZINE_SIZES[ti];
+
+            if (veryVerbose) { T_ P(MAGAZINE_SIZE) }
+
+            {
+                Obj mX(7, MAGAZINE_SIZE, &ta);
+
+                bsl::vector<void *>     slots(k_NUM_THREADS * k_NUM_SLOTS,
+                                              static_cast<void *>(0),
+                                              na);
+                bsl::vector<StressArgs> args(k_NUM_THREADS, na);
+                bslmt::Barrier          barrier(k_NUM_THREADS);
+
+                bslmt::ThreadUtil::Handle handles[k_NUM_THREADS];
+
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    args[i].d_allocator_p = &mX;
+                    args[i].d_barrier_p   = &barrier;
+                    args[i].d_slots_p     = slots.data();
+                    args[i].d_index       = i;
+                    args[i].d_numThreads  = k_NUM_THREADS;
+                    args[i].d_numSlots    = k_NUM_SLOTS;
+                    args[i].d_numRounds   = k_NUM_ROUNDS;
+                    args[i].d_numErrors   = 0;
+
+                    ASSERT(0 == bslmt::ThreadUtil::create(&handles[i],
+                                                          stressThread,
+                                                          &args[i]));
+                }
+                for (int i = 0; i < k_NUM_THREADS; ++i) {
+                    bslmt::ThreadUtil::join(handles[i]);
+                    ASSERTV(MAGAZINE_SIZE, i, 0 == args[i].d_numErrors);
+                }
+            }
+            ASSERTV(MAGAZINE_SIZE, 0 == ta.numBlocksInUse());
+        }
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // THREAD EXIT AND CROSS-THREAD DEALLOCATION
+        //
+        // Concerns:
+        //: 1 On exit of a thread, the blocks held by its cache are made
+        //:   available to other threads, and the cache is deallocated.
+        //:
+        //: 2 Blocks allocated by one thread can be deallocated by another, and
+        //:   are then reused by the deallocating thread.
+        //:
+        //: 3 The allocator can be destroyed while threads that have used it
+        //:   are running, or after they have exited.
+        //
+        // Plan:
+        //: 1 In a thread, allocate and deallocate a number of blocks equal to
+        //:   several magazines.  After the thread exits, verify that the cache
+        //:   has been deallocated, and that allocating as many blocks in the
+        //:   main thread obtains no memory from the underlying allocator
+        //:   other than for the cache of the main thread.  (C-1)
+        //:
+        //: 2 In a thread, allocate (and scribble over) a number of blocks.
+        //:   After it exits, verify and deallocate them in the main thread,
+        //:   and verify that allocating as many blocks again obtains no more
+        //:   memory from the underlying allocator.  (C-2)
+        //:
+        //: 3 Destroy allocators, and verify that all memory is released.
+        //:   (C-3)
+        //
+        // Testing:
+        //   THREAD EXIT AND CROSS-THREAD DEALLOCATION
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "THREAD EXIT AND CROSS-THREAD DEALLOCATION"
+                          << endl
+                          << "========================================="
+                          << endl;
+
+        bslma::TestAllocator  ta("object", veryVerbose);
+        bslma::Allocator     *na = bslma::NewDeleteAllocator::allocator(0);
+
+        if (verbose) cout << "\nBlocks cached by an exited thread." << endl;
+        {
+            const int MAGAZINE_SIZE = 4;
+            const int NUM_BLOCKS    = 5 * MAGAZINE_SIZE;
+
+            Obj mX(5, MAGAZINE_SIZE, &ta);
+
+            const bsls::Types::Int64 IN_USE0 = ta.numBlocksInUse();
+
+            AllocateAndFree args = { &mX, NUM_BLOCKS, 16 };
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  allocateAndFree,
+                                                  &args));
+            bslmt::ThreadUtil::join(handle);
+
+            // The cache of the thread has been deallocated, and only memory
+            // obtained by the pool remains in use.
+
+            const bsls::Types::Int64 IN_USE1 = ta.numBlocksInUse();
+            const bsls::Types::Int64 TOTAL1  = ta.numBlocksTotal();
+
+            ASSERTV(IN_USE0, IN_USE1, IN_USE0 < IN_USE1);
+            ASSERTV(IN_USE1, TOTAL1, IN_USE1 < TOTAL1);
+
+            bsl::vector<void *> blocks(na);
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks.push_back(mX.allocate(16));
+            }
+
+            // Only the cache of the main thread is allocated.
+
+            ASSERTV(TOTAL1, ta.numBlocksTotal(),
+                    TOTAL1 + 1 == ta.numBlocksTotal());
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nCross-thread deallocation." << endl;
+        {
+            const int MAGAZINE_SIZE = 8;
+            const int NUM_BLOCKS    = 3 * MAGAZINE_SIZE + 5;
+
+            Obj mX(5, MAGAZINE_SIZE, &ta);
+
+            AllocateAndFree args = { &mX, NUM_BLOCKS, 40 };
+
+            bslmt::ThreadUtil::Handle handle;
+            ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                  allocateOnly,
+                                                  &args));
+            void *result = 0;
+            bslmt::ThreadUtil::join(handle, &result);
+
+            void **blocks = static_cast<void **>(result);
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                ASSERTV(i, isScribbled(blocks[i], 40, 0x5a));
+                mX.deallocate(blocks[i]);
+            }
+
+            const bsls::Types::Int64 TOTAL = ta.numBlocksTotal();
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                blocks[i] = mX.allocate(40);
+            }
+            ASSERTV(TOTAL, ta.numBlocksTotal(),
+                    TOTAL == ta.numBlocksTotal());
+
+            for (int i = 0; i < NUM_BLOCKS; ++i) {
+                mX.deallocate(blocks[i]);
+            }
+            na->deallocate(blocks);
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nDestruction with outstanding caches." << endl;
+        {
+            bslma::TestAllocator sa("supplied", veryVerbose);
+            {
+                Obj mX(&sa);
+
+                AllocateAndFree args = { &mX, 10, 100 };
+
+                bslmt::ThreadUtil::Handle handle;
+                ASSERT(0 == bslmt::ThreadUtil::create(&handle,
+                                                      allocateOnly,
+                                                      &args));
+                void *result = 0;
+                bslmt::ThreadUtil::join(handle, &result);
+                na->deallocate(result);
+
+                // Leave blocks in the cache of the main thread, and blocks
+                // allocated by the exited thread outstanding.
+
+                mX.deallocate(mX.allocate(8));
+                mX.allocate(10000);
+            }
+            ASSERT(0 == sa.numBlocksInUse());
+        }
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // ALLOCATE AND DEALLOCATE
+        //
+        // Concerns:
+        //: 1 'allocate' returns maximally-aligned, non-overlapping blocks of
+        //:   at least the requested size, for sizes pooled or not.
+        //:
+        //: 2 'allocate(0)' returns 0, and 'deallocate(0)' has no effect.
+        //:
+        //: 3 Deallocated blocks are reused, in the order of deallocation
+        //:   reversed, without obtaining more memory from the underlying
+        //:   allocator.
+        //:
+        //: 4 Blocks larger than 'maxPooledBlockSize()' are obtained from, and
+        //:   returned to, the underlying allocator.
+        //
+        // Plan:
+        //: 1 For each size in a table, allocate several blocks, scribbling
+        //:   over each a distinct value, and verify their alignment, and that
+        //:   they are not modified by subsequent allocations.  (C-1)
+        //:
+        //: 2 Call 'allocate(0)' and 'deallocate(0)'.  (C-2)
+        //:
+        //: 3 Deallocate and reallocate blocks, verifying the addresses
+        //:   returned, and that the underlying allocator is not used.  (C-3)
+        //:
+        //: 4 Allocate and deallocate large blocks, verifying the number of
+        //:   blocks in use in the underlying allocator.  (C-4)
+        //
+        // Testing:
+        //   void *allocate(size_type size);
+        //   void deallocate(void *address);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "ALLOCATE AND DEALLOCATE" << endl
+                          << "=======================" << endl;
+
+        bslma::TestAllocator  ta("object", veryVerbose);
+        bslma::Allocator     *na = bslma::NewDeleteAllocator::allocator(0);
+
+        if (verbose) cout << "\nAlignment and independence." << endl;
+        {
+            static const size_type SIZES[] = {
+                1, 2, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65,
+                100, 127, 128, 129, 255, 256, 257, 1000, 4095, 4096, 4097,
+                10000
+            };
+            const int NUM_SIZES = sizeof SIZES / sizeof *SIZES;
+
+            enum { k_NUM_PER_SIZE = 40 };
+
+            Obj mX(10, 4, &ta);
+
+            bsl::vector<void *>    blocks(na);
+            bsl::vector<size_type> sizes(na);
+
+            for (int ti = 0; ti < NUM_SIZES; ++ti) {
+                for (int j = 0; j < k_NUM_PER_SIZE; ++j) {
+                    const size_type SIZE = SIZES[ti];
+                    void *p = mX.allocate(SIZE);
+
+                    ASSERTV(SIZE, p);
+                    ASSERTV(SIZE, isMaxAligned(p));
+
+                    scribble(p, SIZE, static_cast<int>(blocks.size()));
+                    blocks.push_back(p);
+                    sizes.push_back(SIZE);
+                }
+            }
+            for (size_type i = 0; i < blocks.size(); ++i) {
+                ASSERTV(i, isScribbled(blocks[i],
+                                       sizes[i],
+                                       static_cast<int>(i)));
+            }
+            for (size_type i = 0; i < blocks.size(); ++i) {
+                mX.deallocate(blocks[i]);
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nZero size and null address." << endl;
+        {
+            Obj mX(&ta);
+
+            const bsls::Types::Int64 TOTAL = ta.numBlocksTotal();
+
+            ASSERT(0 == mX.allocate(0));
+            mX.deallocate(0);
+
+            ASSERT(TOTAL == ta.numBlocksTotal());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nReuse of deallocated blocks." << endl;
+        {
+            const int MAGAZINE_SIZES[] = { 1, 2, 3, 8, 32 };
+
+            for (int ti = 0; ti < 5; ++ti) {
+                const int MAGAZINE_SIZE = MAGAZINE_SIZES[ti];
+                const int NUM_BLOCKS    = 4 * MAGAZINE_SIZE + 3;
+
+                Obj mX(4, MAGAZINE_SIZE, &ta);
+
+                void *p = mX.allocate(24);
+                mX.deallocate(p);
+                ASSERTV(MAGAZINE_SIZE, p == mX.allocate(32));
+                mX.deallocate(p);
+
+                bsl::vector<void *> blocks(na);
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    blocks.push_back(mX.allocate(20));
+                }
+
+                const bsls::Types::Int64 TOTAL = ta.numBlocksTotal();
+
+                for (int round = 0; round < 3; ++round) {
+                    for (int i = 0; i < NUM_BLOCKS; ++i) {
+                        mX.deallocate(blocks[i]);
+                    }
+                    for (int i = NUM_BLOCKS - 1; 0 <= i; --i) {
+                        void *q = mX.allocate(17);
+                        ASSERTV(MAGAZINE_SIZE, round, i, blocks[i] == q);
+                    }
+                }
+
+                ASSERTV(MAGAZINE_SIZE, TOTAL == ta.numBlocksTotal());
+
+                for (int i = 0; i < NUM_BLOCKS; ++i) {
+                    mX.deallocate(blocks[i]);
+                }
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+
+        if (verbose) cout << "\nLarge blocks." << endl;
+        {
+            Obj mX(3, &ta);
+
+            ASSERT(32 == mX.maxPooledBlockSize());
+
+            void *p = mX.allocate(32);
+            mX.deallocate(p);
+
+            const bsls::Types::Int64 IN_USE = ta.numBlocksInUse();
+
+            void *q = mX.allocate(33);
+            ASSERT(isMaxAligned(q));
+            ASSERT(IN_USE + 1 == ta.numBlocksInUse());
+
+            void *r = mX.allocate(100000);
+            ASSERT(isMaxAligned(r));
+            ASSERT(IN_USE + 2 == ta.numBlocksInUse());
+            scribble(r, 100000, 0x33);
+
+            mX.deallocate(q);
+            ASSERT(IN_USE + 1 == ta.numBlocksInUse());
+
+            mX.deallocate(r);
+            ASSERT(IN_USE == ta.numBlocksInUse());
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // CONSTRUCTORS AND ACCESSORS
+        //
+        // Concerns:
+        //: 1 Each constructor creates an allocator having the specified (or
+        //:   default) number of pools and magazine size.
+        //:
+        //: 2 'maxPooledBlockSize' is '2 ^ (numPools() + 2)'.
+        //:
+        //: 3 The supplied (or default) allocator is used to supply memory, and
+        //:   all of it is released on destruction.
+        //
+        // Plan:
+        //: 1 Create allocators using each constructor, with and without an
+        //:   allocator, and verify the accessors and the use of memory.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   ThreadCachingAllocator(Allocator *ba = 0);
+        //   ThreadCachingAllocator(int numPools, Allocator *ba = 0);
+        //   ThreadCachingAllocator(int numPools, int magSize, *ba = 0);
+        //   ~ThreadCachingAllocator();
+        //   int magazineSize() const;
+        //   bsls::Types::size_type maxPooledBlockSize() const;
+        //   int numPools() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "CONSTRUCTORS AND ACCESSORS" << endl
+                          << "==========================" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+
+        {
+            Obj mX(&ta);  const Obj& X = mX;
+
+            ASSERT(10   == X.numPools());
+            ASSERT(32   == X.magazineSize());
+            ASSERT(4096 == X.maxPooledBlockSize());
+            ASSERT(0    <  ta.numBlocksInUse());
+
+            mX.deallocate(mX.allocate(100));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+
+        for (int numPools = 1; numPools <= 12; ++numPools) {
+            {
+                Obj mX(numPools, &ta);  const Obj& X = mX;
+
+                ASSERTV(numPools, numPools == X.numPools());
+                ASSERTV(numPools, 32 == X.magazineSize());
+                ASSERTV(numPools,
+                        (size_type(4) << numPools) == X.maxPooledBlockSize());
+
+                mX.deallocate(mX.allocate(X.maxPooledBlockSize()));
+            }
+            {
+                Obj mX(numPools, numPools * 3, &ta);  const Obj& X = mX;
+
+                ASSERTV(numPools, numPools == X.numPools());
+                ASSERTV(numPools, numPools * 3 == X.magazineSize());
+                ASSERTV(numPools,
+                        (size_type(4) << numPools) == X.maxPooledBlockSize());
+
+                mX.deallocate(mX.allocate(X.maxPooledBlockSize()));
+            }
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+        ASSERT(0 == da.numBlocksTotal());
+
+        {
+            Obj mX;  const Obj& X = mX;
+
+            ASSERT(10 == X.numPools());
+            ASSERT(0  <  da.numBlocksInUse());
+        }
+        {
+            Obj mX(4);  const Obj& X = mX;
+
+            ASSERT(4 == X.numPools());
+        }
+        {
+            Obj mX(4, 7);  const Obj& X = mX;
+
+            ASSERT(7 == X.magazineSize());
+        }
+        ASSERT(0 == da.numBlocksInUse());
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Allocate and deallocate blocks of various sizes.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "BREATHING TEST" << endl
+                          << "==============" << endl;
+
+        bslma::TestAllocator ta("object", veryVerbose);
+        {
+            Obj mX(&ta);
+
+            void *p1 = mX.allocate(1);
+            void *p2 = mX.allocate(100);
+            void *p3 = mX.allocate(100000);
+
+            ASSERT(p1);  ASSERT(p2);  ASSERT(p3);
+            ASSERT(p1 != p2);
+
+            mX.deallocate(p1);
+            mX.deallocate(p2);
+            mX.deallocate(p3);
+
+            ASSERT(p2 == mX.allocate(128));
+            ASSERT(p1 == mX.allocate(8));
+        }
+        ASSERT(0 == ta.numBlocksInUse());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE TEST
+        //   Compare the throughput of 'bdlma::ThreadCachingAllocator' with
+        //   that of 'bdlma::ConcurrentMultipoolAllocator' and the new-delete
+        //   allocator, for 1 to 32 threads each allocating and deallocating
+        //   small blocks, deallocating either their own blocks or those of
+        //   another thread.
+        //
+        //   Usage: <driver> -1 [numRounds [numSlots]]
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE TEST" << endl
+                          << "================" << endl;
+
+        const int NUM_ROUNDS = argc > 2 ? atoi(argv[2]) : 2000;
+        const int NUM_SLOTS  = argc > 3 ? atoi(argv[3]) : 100;
+
+        bslma::Allocator *na = bslma::NewDeleteAllocator::allocator(0);
+
+        const int THREADS[] = { 1, 2, 4, 8, 16, 32 };
+
+        printf("%8s %6s %12s %12s %12s\n",
+               "threads", "frees", "new-delete", "multipool", "caching");
+
+        for (int ti = 0; ti < 6; ++ti) {
+            const int NUM_THREADS = THREADS[ti];
+
+            for (int cross = 0; cross < 2; ++cross) {
+                double times[3];
+                {
+                    times[0] = runBenchmark(na,
+                                            NUM_THREADS,
+                                            cross,
+                                            NUM_SLOTS,
+                                            NUM_ROUNDS);
+                }
+                {
+                    bdlma::ConcurrentMultipoolAllocator mX(na);
+                    times[1] = runBenchmark(&mX,
+                                            NUM_THREADS,
+                                            cross,
+                                            NUM_SLOTS,
+                                            NUM_ROUNDS);
+                }
+                {
+                    Obj mX(na);
+                    times[2] = runBenchmark(&mX,
+                                            NUM_THREADS,
+                                            cross,
+                                            NUM_SLOTS,
+                                            NUM_ROUNDS);
+                }
+
+                // Report millions of allocate/deallocate pairs per second.
+
+                const double OPS = static_cast<double>(NUM_THREADS)
+                                 * NUM_ROUNDS * NUM_SLOTS / 1e6;
+
+                printf("%8d %6s %12.2f %12.2f %12.2f\n",
+                       NUM_THREADS,
+                       cross ? "remote" : "local",
+                       OPS / times[0],
+                       OPS / times[1],
+                       OPS / times[2]);
+            }
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -12,6 +12,8 @@ BSLS_IDENT_RCSID(bdlt_iso8601util_cpp,"$Id$ $CSID$")
 #include <bdlt_time.h>
 #include <bdlt_timetz.h>
 
+#include <bdlb_numerictextutil.h>
+
 #include <bsl_algorithm.h>
 #include <bsl_cctype.h>
 #include <bsl_cstring.h>
@@ -381,12 +383,9 @@ int generateInt(char *buffer, int value, int paddedLen)
     BSLS_ASSERT(0 <= value);
     BSLS_ASSERT(0 <= paddedLen);
 
-    char *p = buffer + paddedLen;
-
-    while (p > buffer) {
-        *--p = static_cast<char>('0' + value % 10);
-        value /= 10;
-    }
+    bdlb::NumericTextUtil::formatUintFixedWidth(buffer,
+                                                static_cast<unsigned>(value),
+                                                paddedLen);
 
     return paddedLen;
 }
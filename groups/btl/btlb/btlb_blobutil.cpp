@@ -277,6 +277,80 @@ void BlobUtil::insert(Blob        *dest,
     *dest = result;
 }
 
+void BlobUtil::prepend(Blob        *dest,
+                       const Blob&  source,
+                       int          offset,
+                       int          length)
+{
+    BSLS_ASSERT(0 != dest);
+    BSLS_ASSERT(dest != &source);
+    BSLS_ASSERT(0 <= offset);
+    BSLS_ASSERT(0 <= length);
+    BSLS_ASSERT(offset <= source.length());
+    BSLS_ASSERT(length <= source.length() - offset);
+
+    if (0 == length) {
+        return;                                                       // RETURN
+    }
+
+    const bsl::pair<int, int> first = findBufferIndexAndOffset(source,
+                                                               offset);
+    const bsl::pair<int, int> last  = findBufferIndexAndOffset(
+                                                     source,
+                                                     offset + length - 1);
+
+    dest->reserveBufferCapacity(dest->numBuffers()
+                                + last.first - first.first + 1);
+
+    // Prepend aliased source buffers, starting with the one holding the last
+    // byte of the range, so that they end up in their original order.
+
+    for (int i = last.first; first.first <= i; --i) {
+        BlobBuffer src = source.buffer(i);
+
+        if (0 == src.size()) {
+            continue;
+        }
+
+        const int begin = i == first.first ? first.second : 0;
+        const int end   = i == last.first  ? last.second + 1 : src.size();
+
+        if (0 < begin) {
+            src.buffer().loadAlias(src.buffer(), src.data() + begin);
+        }
+        src.setSize(end - begin);
+
+        dest->prependDataBuffer(src);
+    }
+}
+
+void BlobUtil::moveAndPrepend(Blob *dest, Blob *source)
+{
+    BSLS_ASSERT(0 != dest);
+    BSLS_ASSERT(0 != source);
+    BSLS_ASSERT(dest != source);
+
+    if (0 == source->length()) {
+        return;                                                       // RETURN
+    }
+
+    source->trimLastDataBuffer();
+
+    const int numSourceDataBuffers = source->numDataBuffers();
+
+    dest->reserveBufferCapacity(dest->numBuffers() + numSourceDataBuffers);
+
+    for (int i = numSourceDataBuffers - 1; 0 <= i; --i) {
+        const BlobBuffer& src = source->buffer(i);
+
+        if (0 < src.size()) {
+            dest->prependDataBuffer(src);
+        }
+    }
+
+    source->removeBuffers(0, numSourceDataBuffers);
+}
+
 bsl::pair<int, int> BlobUtil::findBufferIndexAndOffset(const Blob& blob,
                                                        int         position)
 {
@@ -425,6 +499,23 @@ char *BlobUtil::getContiguousRangeOrCopy(char        *dstBuffer,
     return p;
 }
 
+const char *BlobUtil::getContiguousRange(const Blob& srcBlob,
+                                         int         position,
+                                         int         length)
+{
+    BSLS_ASSERT(0 <= position);
+    BSLS_ASSERT(0 < length);
+    BSLS_ASSERT(length <= srcBlob.totalSize());
+    BSLS_ASSERT(position <= srcBlob.totalSize() - length);
+
+    bsl::pair<int, int> place = findBufferIndexAndOffset(srcBlob, position);
+    const BlobBuffer& buffer = srcBlob.buffer(place.first);
+
+    return buffer.size() - place.second < length
+           ? 0
+           : buffer.data() + place.second;
+}
+
 char *BlobUtil::getContiguousDataBuffer(Blob              *blob,
                                         int                addLength,
                                         BlobBufferFactory *factory)
@@ -454,6 +545,30 @@ char *BlobUtil::getContiguousDataBuffer(Blob              *blob,
     return blob->buffer(index).data() + offset;
 }
 
+void BlobUtil::compact(Blob *blob, BlobBufferFactory *factory)
+{
+    BSLS_ASSERT(0 != blob);
+    BSLS_ASSERT(0 != factory);
+
+    if (2 > blob->numDataBuffers()) {
+        return;                                                       // RETURN
+    }
+
+    const int length = blob->length();
+
+    Blob compacted(factory);
+    compacted.setLength(length);
+    copy(&compacted, 0, *blob, 0, length);
+
+    // Retain the capacity buffers of 'blob'.
+
+    for (int i = blob->numDataBuffers(); i < blob->numBuffers(); ++i) {
+        compacted.appendBuffer(blob->buffer(i));
+    }
+
+    blob->moveBuffers(&compacted);
+}
+
 bsl::ostream& BlobUtil::asciiDump(bsl::ostream& stream, const Blob& source)
 {
     int numBytes = source.length();
@@ -23,8 +23,9 @@ BSLS_IDENT("$Id: $")
 //@SEE_ALSO: btlb_blob
 //
 //@DESCRIPTION: This 'struct' provides a variety of utilities for 'btlb::Blob'
-// objects, 'btlb::BlobUtil', such as I/O functions, comparison functions, and
-// streaming functions.
+// objects, 'btlb::BlobUtil', such as I/O functions, comparison functions,
+// streaming functions, and functions to obtain contiguous views of, compact,
+// and splice the buffers of blobs.
 
 #ifndef INCLUDED_BDLSCM_VERSION
 #include <bdlscm_version.h>
@@ -134,6 +135,44 @@ struct BlobUtil {
         // Insert the specified 'source' to the specified 'destOffset' in the
         // specified 'dest'.
 
+    static void prepend(Blob        *dest,
+                        const Blob&  source,
+                        int          offset,
+                        int          length);
+        // Prepend the specified 'length' bytes from the specified 'offset' in
+        // the specified 'source' to the specified 'dest'.  No data bytes are
+        // copied: 'dest' shares (aliases) the buffers of 'source'.  The
+        // behavior is undefined unless '0 <= offset', '0 <= length',
+        // 'offset + length <= source.length()', and 'dest != &source'.  Note
+        // that, unlike 'insert' at position 0, the existing buffers of 'dest'
+        // are not rebuilt.
+
+    static void prepend(Blob *dest, const Blob& source, int offset);
+        // Prepend from the specified 'offset' in the specified 'source' to the
+        // specified 'dest'.  The behavior is undefined unless
+        // '0 <= offset <= source.length()'.
+
+    static void prepend(Blob *dest, const Blob& source);
+        // Prepend the specified 'source' to the specified 'dest'.
+
+    static void moveAndAppend(Blob *dest, Blob *source);
+        // Move the data buffers of the specified 'source' after the data
+        // buffers of the specified 'dest', leaving 'source' with a length of
+        // 0.  The length of 'dest' is incremented by the original length of
+        // 'source'.  No data bytes are copied and the buffers are transferred
+        // without adjusting their reference counts.  Capacity buffers of
+        // 'source' remain in 'source'.  The behavior is undefined unless
+        // 'dest != source'.
+
+    static void moveAndPrepend(Blob *dest, Blob *source);
+        // Move the data buffers of the specified 'source' before the data
+        // buffers of the specified 'dest', leaving 'source' with a length of
+        // 0.  The length of 'dest' is incremented by the original length of
+        // 'source'.  No data bytes are copied.  The last data buffer of
+        // 'source' is trimmed before the move, and capacity buffers of
+        // 'source' remain in 'source'.  The behavior is undefined unless
+        // 'dest != source'.
+
     static bsl::pair<int,int> findBufferIndexAndOffset(const Blob& blob,
                                                        int         position);
         // Return a value, designated here as 'p', such that for the specified
@@ -196,6 +235,18 @@ struct BlobUtil {
         // aligned as required, 'dstBuffer' has room for 'length' bytes, and
         // 'position <= srcBlob.totalSize() - length'.
 
+    static const char *getContiguousRange(const Blob& srcBlob,
+                                          int         position,
+                                          int         length);
+        // Return the address of the byte at the specified 'position' in the
+        // specified 'srcBlob' if the specified 'length' bytes starting at
+        // 'position' are stored contiguously (i.e., within a single buffer),
+        // and 0 otherwise.  No data is copied.  The behavior is undefined
+        // unless '0 < length', '0 <= position', and
+        // 'position <= srcBlob.totalSize() - length'.  Note that
+        // 'getContiguousRangeOrCopy' can be used to fall back to copying into
+        // a caller-supplied scratch buffer when this function returns 0.
+
     static char *getContiguousDataBuffer(Blob              *blob,
                                          int                addLength,
                                          BlobBufferFactory *factory);
@@ -209,6 +260,18 @@ struct BlobUtil {
         // 'factory->allocate()', if called, yields a block of memory of a size
         // at least as large as 'addLength'.
 
+    static void compact(Blob *blob, BlobBufferFactory *factory);
+        // Copy the data of the specified 'blob' into buffers obtained from the
+        // specified 'factory', filling each new buffer to capacity, and
+        // replace the data buffers of 'blob' with these new buffers.  The
+        // length and data of 'blob' are unchanged, the last new buffer may be
+        // only partially filled, and the capacity buffers of 'blob' (if any)
+        // are retained after the new data buffers.  This method has no effect
+        // if 'blob' has fewer than two data buffers.  Note that compacting a
+        // blob having many small or partially used buffers reduces the number
+        // of buffers (and hence of shared references) it holds, at the cost
+        // of copying its data once.
+
     static bsl::ostream& asciiDump(bsl::ostream& stream, const Blob& source);
         // Write to the specified 'stream' an ascii dump of the specified
         // 'source', and return a reference to the modifiable 'stream'.
@@ -411,6 +474,28 @@ void BlobUtil::insert(Blob *dest, int destOffset, const Blob& source)
     insert(dest, destOffset, source, 0, source.length());
 }
 
+inline
+void BlobUtil::prepend(Blob *dest, const Blob& source, int offset)
+{
+    prepend(dest, source, offset, source.length() - offset);
+}
+
+inline
+void BlobUtil::prepend(Blob *dest, const Blob& source)
+{
+    prepend(dest, source, 0, source.length());
+}
+
+inline
+void BlobUtil::moveAndAppend(Blob *dest, Blob *source)
+{
+    BSLS_ASSERT(0 != dest);
+    BSLS_ASSERT(0 != source);
+    BSLS_ASSERT(dest != source);
+
+    dest->moveAndAppendDataBuffers(source);
+}
+
 inline
 bsl::ostream& BlobUtil::hexDump(bsl::ostream& stream, const Blob& source)
 {
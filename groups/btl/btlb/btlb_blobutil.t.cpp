@@ -29,6 +29,7 @@
 #include <bsl_memory.h>
 #include <bsl_sstream.h>
 #include <bsl_string.h>
+#include <bsl_vector.h>
 
 using namespace BloombergLP;
 using namespace bsl;  // automatically added by script
@@ -37,6 +38,9 @@ using namespace bsl;  // automatically added by script
 //                                  TEST PLAN
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
+// [13] Testing compact
+// [12] Testing prepend, moveAndAppend, and moveAndPrepend
+// [11] Testing getContiguousRange
 // [10] Testing copy to a blob
 // [ 9] Testing getContiguousRangeOrCopy
 // [ 8] Testing getContiguousDataBuffer
@@ -341,6 +345,412 @@ int main(int argc, char *argv[]) {
     cout << "TEST " << __FILE__ << " CASE " << test << endl;
 
     switch (test) { case 0:
+      case 13: {
+        // --------------------------------------------------------------------
+        // TESTING 'compact'
+        //
+        // Concerns:
+        //: 1 The data of the blob is unchanged by compaction.
+        //:
+        //: 2 The data is held by the minimum number of buffers obtainable from
+        //:   the factory.
+        //:
+        //: 3 Capacity buffers of the blob are retained.
+        //:
+        //: 4 Blobs having fewer than two data buffers are not modified.
+        //:
+        //: 5 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Build blobs of varying lengths out of small buffers, compact them
+        //:   using a factory of larger buffers, and verify the resulting data
+        //:   and buffer count.  (C-1..2)
+        //:
+        //: 2 Add capacity buffers to the source blob and verify that they are
+        //:   found after the compacted data buffers.  (C-3)
+        //:
+        //: 3 Compact blobs having zero or one data buffer and verify that the
+        //:   blob is unchanged.  (C-4)
+        //:
+        //: 4 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-5)
+        //
+        // Testing:
+        //   void compact(Blob *blob, BlobBufferFactory *factory);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING 'compact'"
+                          << "\n=================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        for (int smallSize = 1; smallSize <= 5; ++smallSize) {
+            for (int largeSize = 1; largeSize <= 16; ++largeSize) {
+                for (int length = 0; length <= 40; ++length) {
+                    BlobBufferFactory smallFactory(smallSize, &ta);
+                    BlobBufferFactory largeFactory(largeSize, &ta);
+
+                    const bsl::string EXPECTED = g(length);
+
+                    Blob mX(&smallFactory, &ta);  const Blob& X = mX;
+                    copyStringToBlob(&mX, EXPECTED);
+
+                    const int NUM_DATA_BUFFERS = X.numDataBuffers();
+
+                    Util::compact(&mX, &largeFactory);
+
+                    bsl::string result;
+                    copyBlobToString(&result, X);
+
+                    ASSERTV(smallSize, largeSize, length, EXPECTED == result);
+                    ASSERTV(smallSize, largeSize, length, length == X.length());
+
+                    const int EXP_NUM_BUFFERS =
+                                  NUM_DATA_BUFFERS < 2
+                                  ? NUM_DATA_BUFFERS
+                                  : (length + largeSize - 1) / largeSize;
+
+                    ASSERTV(smallSize, largeSize, length,
+                            EXP_NUM_BUFFERS == X.numDataBuffers());
+                    ASSERTV(smallSize, largeSize, length,
+                            X.numDataBuffers() == X.numBuffers());
+                }
+            }
+        }
+
+        if (verbose) cout << "\tRetaining capacity buffers." << endl;
+        {
+            BlobBufferFactory smallFactory(3, &ta);
+            BlobBufferFactory largeFactory(8, &ta);
+
+            const bsl::string EXPECTED = g(20);
+
+            Blob mX(&smallFactory, &ta);  const Blob& X = mX;
+            copyStringToBlob(&mX, EXPECTED);
+
+            btlb::BlobBuffer capacity;
+            smallFactory.allocate(&capacity);
+            mX.appendBuffer(capacity);
+
+            ASSERT(7 == X.numDataBuffers());
+            ASSERT(8 == X.numBuffers());
+
+            Util::compact(&mX, &largeFactory);
+
+            bsl::string result;
+            copyBlobToString(&result, X);
+
+            ASSERT(EXPECTED == result);
+            ASSERT(3        == X.numDataBuffers());
+            ASSERT(4        == X.numBuffers());
+            ASSERT(capacity == X.buffer(3));
+        }
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            BlobBufferFactory factory(4, &ta);
+            Blob              blob(&factory, &ta);
+
+            ASSERT_FAIL(Util::compact(0, &factory));
+            ASSERT_FAIL(Util::compact(&blob, 0));
+            ASSERT_PASS(Util::compact(&blob, &factory));
+        }
+      } break;
+      case 12: {
+        // --------------------------------------------------------------------
+        // TESTING 'prepend', 'moveAndAppend', AND 'moveAndPrepend'
+        //
+        // Concerns:
+        //: 1 'prepend' places the specified range of the source before the
+        //:   data of the destination, and shares the source buffers rather
+        //:   than copying their data.
+        //:
+        //: 2 'moveAndAppend' and 'moveAndPrepend' transfer all data buffers of
+        //:   the source to the destination, leaving the source empty of data.
+        //:
+        //: 3 Capacity buffers of the destination and source are retained.
+        //:
+        //: 4 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For all ranges of source blobs of varying lengths, prepend the
+        //:   range to destination blobs of varying lengths and verify the
+        //:   resulting data and that the first buffer aliases the source.
+        //:   (C-1)
+        //:
+        //: 2 Move source blobs to destination blobs of varying lengths, and
+        //:   verify the resulting data of the source and destination.
+        //:   (C-2..3)
+        //:
+        //: 3 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-4)
+        //
+        // Testing:
+        //   void prepend(Blob *, const Blob&, int offset, int length);
+        //   void prepend(Blob *, const Blob&, int offset);
+        //   void prepend(Blob *, const Blob&);
+        //   void moveAndAppend(Blob *dest, Blob *source);
+        //   void moveAndPrepend(Blob *dest, Blob *source);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING 'prepend' AND 'moveAnd*'"
+                          << "\n================================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        if (verbose) cout << "\tTesting 'prepend'." << endl;
+
+        for (int srcLength = 0; srcLength <= 12; ++srcLength) {
+            for (int dstLength = 0; dstLength <= 8; ++dstLength) {
+                for (int offset = 0; offset <= srcLength; ++offset) {
+                    for (int length = 0;
+                         length <= srcLength - offset;
+                         ++length) {
+                        BlobBufferFactory srcFactory(5, &ta);
+                        BlobBufferFactory dstFactory(3, &ta);
+
+                        const bsl::string SRC = g(srcLength);
+                        const bsl::string DST(dstLength, 'X');
+
+                        Blob source(&srcFactory, &ta);
+                        copyStringToBlob(&source, SRC);
+
+                        Blob mX(&dstFactory, &ta);  const Blob& X = mX;
+                        copyStringToBlob(&mX, DST);
+
+                        Util::prepend(&mX, source, offset, length);
+
+                        bsl::string result;
+                        copyBlobToString(&result, X);
+
+                        ASSERTV(srcLength, dstLength, offset, length,
+                                result == SRC.substr(offset, length) + DST);
+                        ASSERTV(srcLength, dstLength, offset, length,
+                                dstLength + length == X.length());
+
+                        if (0 < length) {
+                            const int POS = offset % 5;
+                            ASSERTV(srcLength, dstLength, offset, length,
+                                    source.buffer(offset / 5).data() + POS ==
+                                                          X.buffer(0).data());
+                        }
+                    }
+                }
+
+                BlobBufferFactory srcFactory(5, &ta);
+                BlobBufferFactory dstFactory(3, &ta);
+
+                const bsl::string SRC = g(srcLength);
+                const bsl::string DST(dstLength, 'X');
+
+                Blob source(&srcFactory, &ta);
+                copyStringToBlob(&source, SRC);
+
+                Blob mX(&dstFactory, &ta);  const Blob& X = mX;
+                copyStringToBlob(&mX, DST);
+
+                Util::prepend(&mX, source, srcLength / 2);
+
+                bsl::string result;
+                copyBlobToString(&result, X);
+                ASSERTV(srcLength, dstLength,
+                        result == SRC.substr(srcLength / 2) + DST);
+
+                Util::prepend(&mX, source);
+
+                copyBlobToString(&result, X);
+                ASSERTV(srcLength, dstLength,
+                        result == SRC + SRC.substr(srcLength / 2) + DST);
+            }
+        }
+
+        if (verbose) cout << "\tTesting 'moveAndAppend' and 'moveAndPrepend'."
+                          << endl;
+
+        for (int srcLength = 0; srcLength <= 12; ++srcLength) {
+            for (int dstLength = 0; dstLength <= 8; ++dstLength) {
+                for (int prepend = 0; prepend < 2; ++prepend) {
+                    BlobBufferFactory srcFactory(5, &ta);
+                    BlobBufferFactory dstFactory(3, &ta);
+
+                    const bsl::string SRC = g(srcLength);
+                    const bsl::string DST(dstLength, 'X');
+
+                    Blob mS(&srcFactory, &ta);  const Blob& S = mS;
+                    copyStringToBlob(&mS, SRC);
+                    mS.setLength(srcLength + 7);  // add capacity
+                    mS.setLength(srcLength);
+
+                    const int SRC_CAPACITY = S.numBuffers()
+                                                        - S.numDataBuffers();
+
+                    Blob mX(&dstFactory, &ta);  const Blob& X = mX;
+                    copyStringToBlob(&mX, DST);
+                    mX.setLength(dstLength + 4);  // add capacity
+                    mX.setLength(dstLength);
+
+                    const int DST_CAPACITY = X.totalSize() - X.length();
+
+                    if (prepend) {
+                        Util::moveAndPrepend(&mX, &mS);
+                    }
+                    else {
+                        Util::moveAndAppend(&mX, &mS);
+                    }
+
+                    bsl::string result;
+                    copyBlobToString(&result, X);
+
+                    ASSERTV(srcLength, dstLength, prepend,
+                            result == (prepend ? SRC + DST : DST + SRC));
+                    ASSERTV(srcLength, dstLength, prepend,
+                            srcLength + dstLength == X.length());
+                    ASSERTV(srcLength, dstLength, prepend, 0 == S.length());
+                    ASSERTV(srcLength, dstLength, prepend,
+                            SRC_CAPACITY == S.numBuffers());
+
+                    if (prepend) {
+                        ASSERTV(srcLength, dstLength,
+                                DST_CAPACITY == X.totalSize() - X.length());
+                    }
+                }
+            }
+        }
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            BlobBufferFactory factory(4, &ta);
+            Blob              source(&factory, &ta);
+            Blob              dest(&factory, &ta);
+
+            source.setLength(8);
+
+            ASSERT_FAIL(Util::prepend(0, source, 0, 0));
+            ASSERT_FAIL(Util::prepend(&source, source, 0, 0));
+            ASSERT_FAIL(Util::prepend(&dest, source, -1, 0));
+            ASSERT_FAIL(Util::prepend(&dest, source, 0, -1));
+            ASSERT_FAIL(Util::prepend(&dest, source, 0, 9));
+            ASSERT_FAIL(Util::prepend(&dest, source, 9, 0));
+            ASSERT_PASS(Util::prepend(&dest, source, 0, 8));
+
+            ASSERT_FAIL(Util::moveAndAppend(0, &source));
+            ASSERT_FAIL(Util::moveAndAppend(&dest, 0));
+            ASSERT_FAIL(Util::moveAndAppend(&dest, &dest));
+            ASSERT_PASS(Util::moveAndAppend(&dest, &source));
+
+            ASSERT_FAIL(Util::moveAndPrepend(0, &source));
+            ASSERT_FAIL(Util::moveAndPrepend(&dest, 0));
+            ASSERT_FAIL(Util::moveAndPrepend(&dest, &dest));
+            ASSERT_PASS(Util::moveAndPrepend(&dest, &source));
+        }
+      } break;
+      case 11: {
+        // --------------------------------------------------------------------
+        // TESTING 'getContiguousRange'
+        //
+        // Concerns:
+        //: 1 The address of the first byte is returned if and only if the
+        //:   range lies within a single buffer.
+        //:
+        //: 2 Zero-size buffers are handled correctly.
+        //:
+        //: 3 QoI: Asserted precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 For every range of blobs made of buffers of varying sizes,
+        //:   including zero-size buffers, compare the result of
+        //:   'getContiguousRange' with the expected address computed from the
+        //:   buffer layout.  (C-1..2)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid arguments.  (C-3)
+        //
+        // Testing:
+        //   const char *getContiguousRange(const Blob&, int pos, int length);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << "\nTESTING 'getContiguousRange'"
+                          << "\n============================" << endl;
+
+        bslma::TestAllocator ta(veryVeryVerbose);
+
+        static const struct {
+            int d_line;
+            int d_sizes[4];
+        } DATA[] = {
+            //LINE  SIZES
+            //----  ------------
+            { L_,   { 1, 0, 0, 0 } },
+            { L_,   { 4, 0, 0, 0 } },
+            { L_,   { 1, 1, 1, 1 } },
+            { L_,   { 3, 0, 2, 0 } },
+            { L_,   { 0, 3, 0, 3 } },
+            { L_,   { 2, 5, 1, 4 } },
+            { L_,   { 4, 4, 4, 4 } },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int  LINE  = DATA[ti].d_line;
+            const int *SIZES = DATA[ti].d_sizes;
+
+            Blob mX(&ta);  const Blob& X = mX;
+
+            bsl::vector<int> bufferIndex;   // buffer index of each byte
+
+            for (int i = 0; i < 4; ++i) {
+                bsl::shared_ptr<char> shptr(
+                               static_cast<char *>(ta.allocate(SIZES[i] + 1)),
+                               &ta);
+                btlb::BlobBuffer buffer(shptr, SIZES[i]);
+                mX.appendBuffer(buffer);
+                for (int j = 0; j < SIZES[i]; ++j) {
+                    bufferIndex.push_back(i);
+                }
+            }
+            mX.setLength(X.totalSize());
+
+            const int TOTAL = X.totalSize();
+
+            for (int pos = 0; pos < TOTAL; ++pos) {
+                for (int len = 1; len <= TOTAL - pos; ++len) {
+                    const int   FIRST    = bufferIndex[pos];
+                    const int   LAST     = bufferIndex[pos + len - 1];
+                    int         offset   = pos;
+                    for (int i = 0; i < FIRST; ++i) {
+                        offset -= SIZES[i];
+                    }
+                    const char *EXPECTED = FIRST == LAST
+                                           ? X.buffer(FIRST).data() + offset
+                                           : 0;
+
+                    ASSERTV(LINE, pos, len,
+                            EXPECTED == Util::getContiguousRange(X, pos, len));
+                }
+            }
+        }
+
+        if (verbose) cout << "\tNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            BlobBufferFactory factory(4, &ta);
+            Blob              blob(&factory, &ta);
+
+            blob.setLength(8);
+
+            ASSERT_FAIL(Util::getContiguousRange(blob, -1, 1));
+            ASSERT_FAIL(Util::getContiguousRange(blob,  0, 0));
+            ASSERT_FAIL(Util::getContiguousRange(blob,  8, 1));
+            ASSERT_FAIL(Util::getContiguousRange(blob,  0, 9));
+            ASSERT_PASS(Util::getContiguousRange(blob,  7, 1));
+            ASSERT_PASS(Util::getContiguousRange(blob,  0, 8));
+        }
+      } break;
       case 10: {
         // -------------------------------------------------------------------
         // TESTING 'copy' FUNCTIONS WRITING TO BLOB
@@ -25,10 +25,12 @@ BSLS_IDENT("$Id$ $CSID$")
 
 #include <bdlma_concurrentpool.h>
 #include <btlb_blob.h>
+#include <btlb_blobutil.h>
 #include <btlb_pooledblobbufferfactory.h>
 #include <bdlma_deleter.h>
 #include <bslmt_lockguard.h>
 #include <bslmt_mutex.h>
+#include <bslmt_platform.h>
 #include <bslmt_threadattributes.h>
 #include <bslmt_threadutil.h>
 #include <btlb_blobstreambuf.h>
@@ -38,6 +40,7 @@ BSLS_IDENT("$Id$ $CSID$")
 #include <bdlf_bind.h>
 #include <bdlf_memfn.h>
 
+#include <bdlb_bitutil.h>
 #include <bdlb_nullablevalue.h>
 
 #include <bslma_default.h>
@@ -48,9 +51,11 @@ BSLS_IDENT("$Id$ $CSID$")
 #include <bsls_performancehint.h>
 #include <bsls_platform.h>
 #include <bsls_systemtime.h>
+#include <bsls_timeutil.h>
 #include <bsls_types.h>
 
 #include <bsl_algorithm.h>
+#include <bsl_cstdint.h>
 #include <bsl_functional.h>
 #include <bsl_string.h>
 #include <bsl_utility.h>
@@ -109,7 +114,9 @@ enum {
 // channel) are:
 //..
 //  btlmt::Channel::readTimeoutCb              // via registerTimer
+//  btlmt::Channel::writeDelayTimeoutCb        // via registerTimer
 //  btlmt::Channel::registerWriteCb            // via execute
+//  btlmt::Channel::registerWriteDelayTimer    // via execute
 //  btlmt::Channel::disableRead                // via execute
 //  btlmt::Channel::initiateReadSequence       // via execute
 //  btlmt::Channel::invokeChannelDown          // via execute
@@ -222,6 +229,46 @@ enum {
 //   should be enqueued then.
 //..
 
+// Write coalescing
+// ----------------
+//
+// If 'writeCoalesceSize' is positive, a message of at most that many bytes
+// that must be enqueued (i.e., that cannot be written directly) is *copied*
+// into a staging buffer at the end of 'd_writeEnqueuedData' instead of having
+// its buffers shared.  Consecutive small messages therefore end up in the same
+// buffer, and are written by 'writeCb' using a single iovec rather than one
+// iovec (and, once 'k_MAX_IOVEC_SIZE' is reached, one 'writev') per message.
+// 'd_isEnqueuedDataStaged' indicates that the last data buffer of
+// 'd_writeEnqueuedData' is such a staging buffer (obtained from
+// 'd_writeBlobFactory_p'), so that its unused capacity can be filled without
+// overwriting a buffer shared with a client; it is reset when a shared buffer
+// is appended, and when 'd_writeEnqueuedData' is swapped in
+// 'refillOutgoingMsg'.
+//
+// If in addition 'writeCoalesceDelay' is positive, a small message written
+// while no write is active is not written directly: it is copied into
+// 'd_writeActiveData', 'd_isWriteDelayed' is set, and
+// 'registerWriteDelayTimer' is executed in the dispatcher thread to register
+// 'writeDelayTimeoutCb' as a timer.  While 'd_isWriteDelayed' is set,
+// 'writeCb' is not registered, so 'writeMessage' (holding 'd_writeMutex')
+// appends directly to 'd_writeActiveData'.  The first of the following events
+// clears 'd_isWriteDelayed' (under 'd_writeMutex') and registers 'writeCb':
+//..
+// o the timer expires ('writeDelayTimeoutCb'),
+// o the staged data no longer fits in a single buffer, or
+// o a message larger than 'writeCoalesceSize' is written.
+//..
+// Since only the thread that clears 'd_isWriteDelayed' registers 'writeCb', a
+// timer that fires after the flag was cleared by 'writeMessage' is a no-op.
+// The id of the timer is kept in 'd_writeDelayTimerId', which is accessed
+// only in the dispatcher thread, so that at most one timer (holding a handle
+// to the channel) is pending per channel: 'registerWriteCb' deregisters the
+// timer when the data is flushed early, and 'invokeChannelDown' when the
+// channel is closed for writing.  Since 'execute' preserves the order of
+// functors, 'registerWriteDelayTimer' always runs before the
+// 'registerWriteCb' that flushes the same delayed data, and so cannot arm a
+// timer after the data was flushed.
+
 // ============================================================================
 //                     LOCAL CLASS DEFINITIONS
 // ============================================================================
@@ -276,6 +323,257 @@ int getPlatformErrorCode()
 #endif
 }
 
+                    // ============================
+                    // local class LatencyHistogram
+                    // ============================
+
+class LatencyHistogram {
+    // This class records latency samples (in microseconds) into buckets of
+    // exponentially increasing width, and provides an estimate of the
+    // percentiles of the recorded samples.  Bucket 'i' (for '0 < i') counts
+    // the samples having a value in the range '[2^(i - 1), 2^i)'; bucket 0
+    // counts the samples having a non-positive value.  Samples must be
+    // recorded by a single thread at a time; accessors can be called
+    // concurrently from any thread.
+
+    // PRIVATE TYPES
+    enum { k_NUM_BUCKETS = 40 };
+
+    // DATA
+    bsls::AtomicInt64 d_buckets[k_NUM_BUCKETS];  // sample counts
+    bsls::AtomicInt64 d_numSamples;              // total sample count
+    bsls::AtomicInt64 d_max;                     // largest sample
+
+  private:
+    // NOT IMPLEMENTED
+    LatencyHistogram(const LatencyHistogram&);
+    LatencyHistogram& operator=(const LatencyHistogram&);
+
+  public:
+    // CREATORS
+    LatencyHistogram();
+        // Create a latency histogram having no samples.
+
+    // MANIPULATORS
+    void record(bsls::Types::Int64 microseconds);
+        // Record a sample of the specified 'microseconds'.
+
+    // ACCESSORS
+    bsls::Types::Int64 max() const;
+        // Return the largest sample recorded, or 0 if no sample was recorded.
+
+    bsls::Types::Int64 numSamples() const;
+        // Return the number of samples recorded.
+
+    bsls::Types::Int64 percentile(int percent) const;
+        // Return an upper bound of the specified 'percent' percentile of the
+        // samples recorded, or 0 if no sample was recorded.  The value
+        // returned is the upper limit of the bucket containing that
+        // percentile, or the largest sample if smaller.  The behavior is
+        // undefined unless '0 <= percent <= 100'.
+};
+
+// CREATORS
+LatencyHistogram::LatencyHistogram()
+: d_numSamples(0)
+, d_max(0)
+{
+}
+
+// MANIPULATORS
+inline
+void LatencyHistogram::record(bsls::Types::Int64 microseconds)
+{
+    int index = 0 < microseconds
+                ? 64 - bdlb::BitUtil::numLeadingUnsetBits(
+                                      static_cast<bsl::uint64_t>(microseconds))
+                : 0;
+    if (index >= k_NUM_BUCKETS) {
+        index = k_NUM_BUCKETS - 1;
+    }
+
+    d_buckets[index].addRelaxed(1);
+    d_numSamples.addRelaxed(1);
+
+    if (d_max.loadRelaxed() < microseconds) {
+        d_max.storeRelaxed(microseconds);
+    }
+}
+
+// ACCESSORS
+inline
+bsls::Types::Int64 LatencyHistogram::max() const
+{
+    return d_max.loadRelaxed();
+}
+
+inline
+bsls::Types::Int64 LatencyHistogram::numSamples() const
+{
+    return d_numSamples.loadRelaxed();
+}
+
+bsls::Types::Int64 LatencyHistogram::percentile(int percent) const
+{
+    BSLS_ASSERT(0 <= percent);
+    BSLS_ASSERT(percent <= 100);
+
+    const bsls::Types::Int64 numSamples = d_numSamples.loadRelaxed();
+    if (0 == numSamples) {
+        return 0;                                                     // RETURN
+    }
+
+    // Rank of the requested sample, rounded up, and at least 1.
+
+    const bsls::Types::Int64 rank =
+                          bsl::max((numSamples * percent + 99) / 100,
+                                   static_cast<bsls::Types::Int64>(1));
+
+    const bsls::Types::Int64 maxValue = d_max.loadRelaxed();
+
+    bsls::Types::Int64 count = 0;
+    for (int i = 0; i < k_NUM_BUCKETS; ++i) {
+        count += d_buckets[i].loadRelaxed();
+        if (count >= rank) {
+            const bsls::Types::Int64 upper =
+                    0 == i ? 0 : (static_cast<bsls::Types::Int64>(1) << i) - 1;
+            return bsl::min(upper, maxValue);                         // RETURN
+        }
+    }
+    return maxValue;
+}
+
+                       // ======================
+                       // local class WriteLease
+                       // ======================
+
+class WriteLease {
+    // This class holds units of the write rate limiter of a channel pool
+    // leased for the channels of one event manager, so that writes on these
+    // channels consult the shared rate limiter only when the lease runs out.
+    // See the "Write Rate Limiting" section in the component-level
+    // documentation.  This class is fully thread-safe.
+
+    // PRIVATE TYPES
+    enum {
+        k_PADDING = bslmt::Platform::e_CACHE_LINE_SIZE
+                                                   - sizeof(bsls::AtomicInt64)
+    };
+
+    // DATA
+    const char        d_leadingPadding[k_PADDING];   // keep 'd_numUnits' off
+                                                     // the cache line of any
+                                                     // preceding object
+
+    bsls::AtomicInt64 d_numUnits;                    // leased units not yet
+                                                     // spent
+
+    const char        d_trailingPadding[k_PADDING];  // keep 'd_numUnits' off
+                                                     // the cache line of any
+                                                     // following object
+
+  private:
+    // NOT IMPLEMENTED
+    WriteLease(const WriteLease&);
+    WriteLease& operator=(const WriteLease&);
+
+  public:
+    // CREATORS
+    WriteLease();
+        // Create an empty lease.
+
+    // MANIPULATORS
+    void reset(btls::ConcurrentRateLimiter *rateLimiter);
+        // Return the units held by this lease to the specified 'rateLimiter',
+        // from which they were leased, and empty this lease.  Do nothing but
+        // empty this lease if 'rateLimiter' is 0.
+
+    bool tryConsume(bsls::Types::Uint64          numUnits,
+                    btls::ConcurrentRateLimiter *rateLimiter,
+                    bsls::Types::Uint64          leaseSize);
+        // Spend the specified 'numUnits' from this lease if it holds that
+        // many, and otherwise spend the units it holds together with the
+        // missing units consumed from the specified 'rateLimiter', also
+        // leasing up to the specified 'leaseSize' additional units from
+        // 'rateLimiter'.  Return 'true' if 'numUnits' were spent, and 'false'
+        // (leaving the units held by this lease unchanged) if 'rateLimiter'
+        // does not admit the missing units.
+};
+
+// CREATORS
+WriteLease::WriteLease()
+: d_leadingPadding()
+, d_numUnits(0)
+, d_trailingPadding()
+{
+    // Leases are not allocated on cache line boundaries: padding both sides
+    // of 'd_numUnits' by a cache line less its size keeps any other object
+    // (notably the lease of another event manager) off its cache line,
+    // whatever the alignment of the lease.
+}
+
+// MANIPULATORS
+void WriteLease::reset(btls::ConcurrentRateLimiter *rateLimiter)
+{
+    const bsls::Types::Int64 numUnits = d_numUnits.swap(0);
+
+    if (rateLimiter && 0 < numUnits) {
+        rateLimiter->release(static_cast<bsls::Types::Uint64>(numUnits));
+    }
+}
+
+inline
+bool WriteLease::tryConsume(bsls::Types::Uint64          numUnits,
+                            btls::ConcurrentRateLimiter *rateLimiter,
+                            bsls::Types::Uint64          leaseSize)
+{
+    BSLS_ASSERT(rateLimiter);
+
+    typedef bsls::Types::Int64  Int64;
+    typedef bsls::Types::Uint64 Uint64;
+
+    const Int64 requested = static_cast<Int64>(numUnits);
+
+    Int64 available = d_numUnits.loadRelaxed();
+    while (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(requested <= available)) {
+        const Int64 previous = d_numUnits.testAndSwap(available,
+                                                      available - requested);
+        if (previous == available) {
+            return true;                                              // RETURN
+        }
+        available = previous;
+    }
+
+    BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
+
+    // The lease has run out: take what remains of it, and consume the missing
+    // units, and a new batch, from the shared rate limiter.  Note that other
+    // threads may have added units to the lease in the meantime.
+
+    const Int64 remaining = d_numUnits.swap(0);
+
+    if (requested <= remaining) {
+        d_numUnits.add(remaining - requested);
+        return true;                                                  // RETURN
+    }
+
+    const Uint64 missing = static_cast<Uint64>(requested - remaining);
+    const Uint64 leased  = rateLimiter->tryConsumeUpTo(
+                                                    missing + leaseSize,
+                                                    bdlt::CurrentTime::now());
+
+    if (leased < missing) {
+        if (leased) {
+            rateLimiter->release(leased);
+        }
+        d_numUnits.add(remaining);
+        return false;                                                 // RETURN
+    }
+
+    d_numUnits.add(static_cast<Int64>(leased - missing));
+    return true;
+}
+
                     // ===================
                     // local class Channel
                     // ===================
@@ -433,6 +731,24 @@ class Channel {
 
     const int                        d_minIncomingMessageSize;
 
+    const int                        d_writeCoalesceSize;
+                                                         // maximum size of a
+                                                         // message copied into
+                                                         // a staging buffer
+
+    const bool                       d_useWriteCoalesceDelay;
+                                                         // 'true' if small
+                                                         // messages may be
+                                                         // delayed
+
+    bsls::TimeInterval               d_writeCoalesceDelay;
+                                                         // maximum delay of a
+                                                         // small message
+
+    const bool                       d_collectMetrics;   // 'true' if latency
+                                                         // metrics are
+                                                         // collected
+
     // Channel state section (continued)
 
     bsls::AtomicInt                  d_channelDownFlag;  // are we down?
@@ -449,8 +765,20 @@ class Channel {
 
     TcpTimerEventManager            *d_eventManager_p;   // (held)
 
+    WriteLease                      *d_writeLease_p;     // lease of write
+                                                         // rate limiter units
+                                                         // for the channels of
+                                                         // 'd_eventManager_p'
+                                                         // (held)
+
     void                            *d_readTimeoutTimerId;
 
+    void                            *d_writeDelayTimerId;// timer of the
+                                                         // coalescing delay,
+                                                         // or 0 (accessed only
+                                                         // in the dispatcher
+                                                         // thread)
+
     // Channel statistics section
     bsls::TimeInterval               d_creationTime;     // time this object
                                                          // was created
@@ -485,6 +813,41 @@ class Channel {
                                                          // size of the write
                                                          // queue
 
+    bsls::AtomicInt64                d_numWriteSyscalls; // number of 'writev'
+                                                         // calls issued on the
+                                                         // underlying socket
+
+    bsls::AtomicInt64                d_numBytesCoalesced;// bytes copied into
+                                                         // staging buffers
+                                                         // rather than
+                                                         // enqueued by
+                                                         // reference
+
+    bsls::AtomicInt64                d_numReadSyscalls;  // number of 'readv'
+                                                         // calls issued on the
+                                                         // underlying socket
+
+    bsls::AtomicInt64                d_numBytesThrottled;// bytes refused by
+                                                         // the pool's write
+                                                         // rate limiter
+
+    LatencyHistogram                 d_writeQueueLatency;// time (in
+                                                         // microseconds) from
+                                                         // enqueuing the
+                                                         // oldest data of a
+                                                         // batch until it is
+                                                         // fully written
+                                                         // (only if
+                                                         // 'd_collectMetrics')
+
+    LatencyHistogram                 d_dispatchLatency;  // time (in
+                                                         // microseconds) from
+                                                         // 'execute' to the
+                                                         // dispatch of
+                                                         // 'registerWriteCb'
+                                                         // (only if
+                                                         // 'd_collectMetrics')
+
     // DO NOT CHANGE THE ORDER OF THESE TWO DATA MEMBERS
 
     btlb::BlobBufferFactory         *d_readBlobFactory_p;// factory for
@@ -520,6 +883,28 @@ class Channel {
     bool                             d_isWriteActive;    // a thread is
                                                          // actively writing
 
+    bool                             d_isWriteDelayed;   // data in
+                                                         // 'd_writeActiveData'
+                                                         // is held until the
+                                                         // coalescing delay
+                                                         // expires
+
+    bool                             d_isEnqueuedDataStaged;
+                                                         // last buffer of the
+                                                         // enqueued data is a
+                                                         // staging buffer
+                                                         // owned by this
+                                                         // channel
+
+    bsls::Types::Int64               d_writeEnqueuedTime;// timer value when
+                                                         // the oldest enqueued
+                                                         // data was enqueued
+
+    bsls::Types::Int64               d_writeActiveTime;  // timer value when
+                                                         // the oldest data in
+                                                         // 'd_writeActiveData'
+                                                         // was enqueued
+
     bsls::AtomicInt                  d_writeActiveQueueSize;
                                                          // number of bytes
                                                          // currently being
@@ -567,6 +952,12 @@ class Channel {
         // underlying this channel in the event manager associated with this
         // channel.
 
+    void deregisterWriteDelayTimer();
+        // Deregister the timer of the write coalescing delay of this channel,
+        // if any.  Note that this function should always be executed in the
+        // dispatcher thread of the event manager associated with this
+        // channel.
+
     void invokeChannelDown(ChannelHandle              self,
                            ChannelPool::ChannelEvents type);
         // Invoke user-installed channel state callback with the specified
@@ -651,6 +1042,35 @@ class Channel {
         // also that the specified 'self' is guaranteed to live throughout the
         // lifetime of this function call.
 
+    void registerWriteDelayTimer(ChannelHandle      self,
+                                 bsls::TimeInterval timeout);
+        // Register 'writeDelayTimeoutCb' to be called by the manager in its
+        // dispatcher thread at the absolute 'timeout', unless the data staged
+        // in the outgoing message was already released, or this channel is
+        // closed for writing.  Note that this function should always be
+        // executed in the dispatcher thread of the event manager associated
+        // with this channel.
+
+    void scheduleRegisterWriteCb(const ChannelHandle& self);
+        // Enqueue 'registerWriteCb' for execution in the dispatcher thread of
+        // the event manager associated with this channel, recording the
+        // dispatch latency if metrics are collected.
+
+    void timedRegisterWriteCb(ChannelHandle      self,
+                              bsls::Types::Int64 executeTime);
+        // Record the time elapsed since the specified 'executeTime' (as
+        // returned by 'bsls::TimeUtil::getTimer') in the dispatch latency
+        // histogram of this channel, and invoke 'registerWriteCb' with the
+        // specified 'self'.
+
+    void writeDelayTimeoutCb(ChannelHandle self);
+        // Stop holding the data staged in the outgoing message, if any, and
+        // register 'writeCb' so that it is written to the underlying socket.
+        // This callback is registered as a timer when a small message is
+        // staged for write coalescing (see 'writeMessage').  Note that this
+        // function should always be executed in the dispatcher thread of the
+        // event manager associated with this channel.
+
     void writeCb(ChannelHandle self);
         // Write the first message(s) enqueued for this channel to the
         // underlying 'StreamSocket'.  If more data is available for writing
@@ -813,6 +1233,19 @@ class Channel {
         // Return the number of bytes request to be written to this channel
         // since its construction or since the last reset.
 
+    bsls::Types::Int64 numWriteSyscalls() const;
+        // Return the number of 'writev' system calls issued on the socket
+        // underlying this channel since its construction.
+
+    bsls::Types::Int64 numBytesCoalesced() const;
+        // Return the number of bytes that were copied into a staging buffer
+        // (rather than enqueued by reference) for this channel since its
+        // construction.
+
+    void loadMetrics(ChannelPool::ChannelMetrics *result) const;
+        // Load into the specified 'result' a snapshot of the statistics of
+        // this channel.
+
     int currentWriteQueueSize() const;
         // Return a snapshot of the number of bytes currently queued to be
         // written to this channel.
@@ -853,6 +1286,15 @@ void Channel::deregisterSocketWrite(ChannelHandle)
     }
 }
 
+inline
+void Channel::deregisterWriteDelayTimer()
+{
+    if (d_writeDelayTimerId) {
+        d_eventManager_p->deregisterTimer(d_writeDelayTimerId);
+        d_writeDelayTimerId = 0;
+    }
+}
+
 // MANIPULATORS
 inline
 void Channel::setUserData(void *userData)
@@ -915,6 +1357,43 @@ bsls::Types::Int64 Channel::numBytesRequestedToBeWritten() const
     return d_numBytesRequestedToBeWritten.loadRelaxed();
 }
 
+inline
+bsls::Types::Int64 Channel::numWriteSyscalls() const
+{
+    return d_numWriteSyscalls.loadRelaxed();
+}
+
+inline
+bsls::Types::Int64 Channel::numBytesCoalesced() const
+{
+    return d_numBytesCoalesced.loadRelaxed();
+}
+
+void Channel::loadMetrics(ChannelPool::ChannelMetrics *result) const
+{
+    BSLS_ASSERT(result);
+
+    result->d_channelId                 = d_channelId;
+    result->d_currentWriteQueueSize     = currentWriteQueueSize();
+    result->d_recordedMaxWriteQueueSize = recordedMaxWriteQueueSize();
+    result->d_numBytesRead              = numBytesRead();
+    result->d_numBytesWritten           = numBytesWritten();
+    result->d_numReadSyscalls           = d_numReadSyscalls.loadRelaxed();
+    result->d_numWriteSyscalls          = numWriteSyscalls();
+
+    result->d_numWriteQueueLatencySamples = d_writeQueueLatency.numSamples();
+    result->d_writeQueueLatencyP50        = d_writeQueueLatency.percentile(50);
+    result->d_writeQueueLatencyP99        = d_writeQueueLatency.percentile(99);
+    result->d_writeQueueLatencyMax        = d_writeQueueLatency.max();
+
+    result->d_numDispatchLatencySamples = d_dispatchLatency.numSamples();
+    result->d_dispatchLatencyP50        = d_dispatchLatency.percentile(50);
+    result->d_dispatchLatencyP99        = d_dispatchLatency.percentile(99);
+    result->d_dispatchLatencyMax        = d_dispatchLatency.max();
+
+    result->d_numBytesThrottled = d_numBytesThrottled.loadRelaxed();
+}
+
 inline
 int Channel::currentWriteQueueSize() const
 {
@@ -1307,6 +1786,12 @@ void Channel::invokeChannelDown(ChannelHandle              self,
         d_eventManager_p->deregisterSocket(socket()->handle());
     }
 
+    // Do not deregister the coalescing delay if not closing the write part.
+
+    if (ChannelPool::e_CHANNEL_DOWN_READ != type) {
+        deregisterWriteDelayTimer();
+    }
+
     // Do not deregister the read time out if not closing the read part.
 
     if (ChannelPool::e_CHANNEL_DOWN_WRITE != type) {
@@ -1614,6 +2099,7 @@ void Channel::readCb(ChannelHandle self)
         int totalBufferSize = populateIVecs();
 
         readRet = socket()->readv(d_ivecs, d_numUsedIVecs);
+        d_numReadSyscalls.addRelaxed(1);
 
         if (readRet < 0) {
             if (btlso::SocketHandle::e_ERROR_WOULDBLOCK == readRet) {
@@ -1711,6 +2197,8 @@ int Channel::refillOutgoingMsg()
 
     d_writeEnqueuedData.swap(d_writeActiveData);
     d_writeActiveQueueSize.addRelaxed(d_writeActiveData->length());
+    d_isEnqueuedDataStaged = false;
+    d_writeActiveTime      = d_writeEnqueuedTime;
 
     return 1;
 }
@@ -1735,7 +2223,9 @@ void Channel::registerReadTimeoutCallback(bsls::TimeInterval   timeout,
 void Channel::registerWriteCb(ChannelHandle self)
 {
     // This callback is executed whenever data is available in
-    // 'd_writeActiveData'.
+    // 'd_writeActiveData', which is then no longer delayed.
+
+    deregisterWriteDelayTimer();
 
     if (0 != protectAndCheckCallback(self, e_CLOSED_SEND_MASK)) {
         return;                                                       // RETURN
@@ -1766,6 +2256,81 @@ void Channel::registerWriteCb(ChannelHandle self)
     // We simply wait until the socket calls us back.
 }
 
+void Channel::registerWriteDelayTimer(ChannelHandle      self,
+                                      bsls::TimeInterval timeout)
+{
+    if (0 != protectAndCheckCallback(self, e_CLOSED_SEND_MASK)) {
+        return;                                                       // RETURN
+    }
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> oGuard(&d_writeMutex);
+
+        if (!d_isWriteDelayed) {
+            // The outgoing message was already released by 'writeMessage'.
+
+            return;                                                   // RETURN
+        }
+    }
+
+    BSLS_ASSERT(0 == d_writeDelayTimerId);
+
+    bsl::function<void()> delayFunctor(bdlf::BindUtil::bind(
+                                                 &Channel::writeDelayTimeoutCb,
+                                                 this,
+                                                 self));
+
+    d_writeDelayTimerId = d_eventManager_p->registerTimer(timeout,
+                                                          delayFunctor);
+}
+
+void Channel::scheduleRegisterWriteCb(const ChannelHandle& self)
+{
+    bsl::function<void()> initWriteFunctor;
+
+    if (d_collectMetrics) {
+        initWriteFunctor = bdlf::BindUtil::bind(&Channel::timedRegisterWriteCb,
+                                                this,
+                                                self,
+                                                bsls::TimeUtil::getTimer());
+    }
+    else {
+        initWriteFunctor = bdlf::BindUtil::bind(&Channel::registerWriteCb,
+                                                this,
+                                                self);
+    }
+
+    d_eventManager_p->execute(initWriteFunctor);
+}
+
+void Channel::timedRegisterWriteCb(ChannelHandle      self,
+                                   bsls::Types::Int64 executeTime)
+{
+    d_dispatchLatency.record((bsls::TimeUtil::getTimer() - executeTime)
+                                                                       / 1000);
+
+    registerWriteCb(self);
+}
+
+void Channel::writeDelayTimeoutCb(ChannelHandle self)
+{
+    d_writeDelayTimerId = 0;
+
+    {
+        bslmt::LockGuard<bslmt::Mutex> oGuard(&d_writeMutex);
+
+        if (!d_isWriteDelayed) {
+            // The outgoing message was already released by 'writeMessage'.
+
+            return;                                                   // RETURN
+        }
+
+        d_isWriteDelayed = false;
+    }
+
+    registerWriteCb(self);
+}
+
 void Channel::writeCb(ChannelHandle self)
 {
     // This callback is executed whenever the write buffer of 'd_socket_p' has
@@ -1834,6 +2399,7 @@ void Channel::writeCb(ChannelHandle self)
         }
 
         int writeRet = socket()->writev(d_ovecs, numVecs);
+        d_numWriteSyscalls.addRelaxed(1);
 
         if (btlso::SocketHandle::e_ERROR_WOULDBLOCK == writeRet) {
             // In theory, this is the only writing thread so if 'writeCb' we
@@ -1968,6 +2534,11 @@ void Channel::writeCb(ChannelHandle self)
         else {
             BSLS_ASSERT(0 == currentOffset);
 
+            if (d_collectMetrics) {
+                d_writeQueueLatency.record(
+                      (bsls::TimeUtil::getTimer() - d_writeActiveTime) / 1000);
+            }
+
             // There is no more data to write from 'd_writeActiveData'.  Empty
             // the outgoing message since all the data there has been written.
 
@@ -2048,23 +2619,38 @@ Channel::Channel(bslma::ManagedPtr<StreamSocket> *socket,
 , d_writeQueueLowWater(config.writeQueueLowWatermark())
 , d_writeQueueHighWater(config.writeQueueHighWatermark())
 , d_minIncomingMessageSize(config.minIncomingMessageSize())
+, d_writeCoalesceSize(config.writeCoalesceSize())
+, d_useWriteCoalesceDelay(config.writeCoalesceSize() > 0
+                       && config.writeCoalesceDelay() > 0.0)
+, d_writeCoalesceDelay(config.writeCoalesceDelay())
+, d_collectMetrics(config.collectChannelMetrics())
 , d_channelDownFlag(0)
 , d_channelUpFlag(0)
 , d_shutdownSendWhenQueueDrained(0)
 , d_channelPool_p(channelPool)
 , d_eventManager_p(eventManager)
+, d_writeLease_p(channelPool->writeLease(eventManager))
 , d_readTimeoutTimerId(0)
+, d_writeDelayTimerId(0)
 , d_creationTime(bdlt::CurrentTime::now())
 , d_numBytesRead(0)
 , d_numBytesWritten(0)
 , d_numBytesRequestedToBeWritten(0)
 , d_recordedMaxWriteQueueSize(0)
+, d_numWriteSyscalls(0)
+, d_numBytesCoalesced(0)
+, d_numReadSyscalls(0)
+, d_numBytesThrottled(0)
 , d_readBlobFactory_p(readBlobBufferPool)
 , d_blobReadData(d_readBlobFactory_p, basicAllocator)
 , d_writeBlobFactory_p(writeBlobBufferPool)
 , d_writeActiveDataCurrentBuffer(0)
 , d_writeActiveDataCurrentOffset(0)
 , d_isWriteActive(false)
+, d_isWriteDelayed(false)
+, d_isEnqueuedDataStaged(false)
+, d_writeEnqueuedTime(0)
+, d_writeActiveTime(0)
 , d_writeActiveQueueSize(0)
 , d_sharedPtrRepAllocator_p(sharedPtrAllocator)
 , d_allocator_p(basicAllocator)
@@ -2250,10 +2836,32 @@ int Channel::writeMessage(const MessageType&   msg,
             : ChannelStatus::e_QUEUE_HIGHWATER;                       // RETURN
     }
 
+    // See the "Write Rate Limiting" section in the component-level
+    // documentation.  The lease and the limiter are lock-free, so consulting
+    // them while holding this channel's write mutex does not serialize writes
+    // on other channels.
+
+    btls::ConcurrentRateLimiter *rateLimiter =
+                                           d_channelPool_p->writeRateLimiter();
+
+    if (rateLimiter
+     && BSLS_PERFORMANCEHINT_PREDICT_UNLIKELY(!d_writeLease_p->tryConsume(
+                               static_cast<bsls::Types::Uint64>(dataLength),
+                               rateLimiter,
+                               d_channelPool_p->d_writeLeaseSize))) {
+        d_numBytesThrottled.addRelaxed(dataLength);
+        return ChannelStatus::e_WRITE_THROTTLED;                      // RETURN
+    }
+
     if (d_recordedMaxWriteQueueSize.loadRelaxed() < writeQueueSize) {
         d_recordedMaxWriteQueueSize.storeRelaxed(writeQueueSize);
     }
 
+    // See the 'Write coalescing' section in the implementation notes.
+
+    const bool isCoalescable = 0 < dataLength
+                            && dataLength <= d_writeCoalesceSize;
+
     if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(!d_isWriteActive)) {
         // This message is the first and only in the outgoing queue.  Note that
         // if 'blob' were a 'bsl::shared_ptr<btlb::Blob> msg' instead, we could
@@ -2279,11 +2887,41 @@ int Channel::writeMessage(const MessageType&   msg,
 
         d_writeActiveQueueSize.addRelaxed(static_cast<int>(dataLength));
 
+        if (d_useWriteCoalesceDelay && isCoalescable) {
+            // Hold this message in a staging buffer for at most
+            // 'd_writeCoalesceDelay', so that messages written in the
+            // meantime can be sent with the same system call.
+
+            d_isWriteDelayed = true;
+
+            if (d_collectMetrics) {
+                d_writeActiveTime = bsls::TimeUtil::getTimer();
+            }
+
+            MessageUtil::copyToBlob(d_writeActiveData.get(), msg);
+            d_numBytesCoalesced.addRelaxed(dataLength);
+
+            oGuard.release()->unlock();
+
+            // The timer is registered in the dispatcher thread, which owns
+            // 'd_writeDelayTimerId'.
+
+            bsl::function<void()> delayFunctor(bdlf::BindUtil::bind(
+                             &Channel::registerWriteDelayTimer,
+                             this,
+                             self,
+                             bdlt::CurrentTime::now() + d_writeCoalesceDelay));
+
+            d_eventManager_p->execute(delayFunctor);
+            return ChannelStatus::e_SUCCESS;                          // RETURN
+        }
+
         oGuard.release()->unlock();
 
         // Let's first attempt to write the blob directly using iovec.
 
         int writeRet = MessageUtil::write(this->socket(), d_ovecs, msg);
+        d_numWriteSyscalls.addRelaxed(1);
 
         if (BSLS_PERFORMANCEHINT_PREDICT_LIKELY(0 < writeRet)) {
             // 'd_numBytesWritten' is modified only in the 'writeCb' or
@@ -2337,22 +2975,51 @@ int Channel::writeMessage(const MessageType&   msg,
                                                       msg,
                                                       writeRet);
 
+            if (d_collectMetrics) {
+                d_writeActiveTime = bsls::TimeUtil::getTimer();
+            }
+
             d_writeActiveDataCurrentBuffer = 0;
             d_writeActiveDataCurrentOffset = startingIndex;
         }
 
         // There is data available, let the event manager know.
 
-        bsl::function<void()> initWriteFunctor(bdlf::BindUtil::bind(
-                                                     &Channel::registerWriteCb,
-                                                     this,
-                                                     self));
-
-        d_eventManager_p->execute(initWriteFunctor);
+        scheduleRegisterWriteCb(self);
         return ChannelStatus::e_SUCCESS;                              // RETURN
     }
     BSLS_PERFORMANCEHINT_UNLIKELY_HINT;
 
+    if (d_isWriteDelayed) {
+        // The outgoing message is held in a staging buffer and 'writeCb' is
+        // not registered, so 'd_writeActiveData' can be appended to directly.
+        // The outgoing message is released once it no longer fits in a
+        // single buffer, or once a message too large to be coalesced is
+        // written.
+
+        d_writeActiveQueueSize.addRelaxed(static_cast<int>(dataLength));
+
+        if (isCoalescable) {
+            MessageUtil::copyToBlob(d_writeActiveData.get(), msg);
+            d_numBytesCoalesced.addRelaxed(dataLength);
+
+            if (1 == d_writeActiveData->numDataBuffers()) {
+                return ChannelStatus::e_SUCCESS;                      // RETURN
+            }
+        }
+        else {
+            d_writeActiveData->trimLastDataBuffer();
+            MessageUtil::appendToBlob(d_writeActiveData.get(), msg);
+        }
+
+        d_isWriteDelayed = false;
+
+        oGuard.release()->unlock();
+
+        scheduleRegisterWriteCb(self);
+        return ChannelStatus::e_SUCCESS;                              // RETURN
+    }
+
     // There are already outgoing messages in the 'd_writeActiveData' and
     // perhaps 'd_writeEnqueuedData', so we simply have to append those buffers
     // into 'd_writeEnqueuedData'.  Note that we are still holding the lock.
@@ -2366,7 +3033,29 @@ int Channel::writeMessage(const MessageType&   msg,
     BSLS_ASSERT(d_writeEnqueuedData->numDataBuffers() ==
                                             d_writeEnqueuedData->numBuffers());
 
+    if (d_collectMetrics && 0 == d_writeEnqueuedData->length()) {
+        d_writeEnqueuedTime = bsls::TimeUtil::getTimer();
+    }
+
+    if (isCoalescable) {
+        // Copy small messages into a staging buffer owned by this channel
+        // rather than sharing their buffers, so that a burst of small
+        // messages is written using few iovecs.  The last buffer is not
+        // trimmed if it is already a staging buffer.
+
+        if (!d_isEnqueuedDataStaged) {
+            d_writeEnqueuedData->trimLastDataBuffer();
+            d_isEnqueuedDataStaged = true;
+        }
+
+        MessageUtil::copyToBlob(d_writeEnqueuedData.get(), msg);
+        d_numBytesCoalesced.addRelaxed(dataLength);
+
+        return ChannelStatus::e_SUCCESS;                              // RETURN
+    }
+
     d_writeEnqueuedData->trimLastDataBuffer();
+    d_isEnqueuedDataStaged = false;
 
     MessageUtil::appendToBlob(d_writeEnqueuedData.get(), msg);
 
@@ -2590,6 +3279,7 @@ void ChannelPool::init()
             manager->disable();
         }
         d_managers.push_back(manager);
+        d_writeLeases.push_back(new (*d_allocator_p) WriteLease());
     }
 
     // Initialize metrics.
@@ -3532,6 +4222,9 @@ ChannelPool::ChannelPool(ChannelStateChangeCallback       channelStateCb,
 , d_config(parameters)
 , d_startFlag(0)
 , d_collectTimeMetrics(parameters.collectTimeMetrics())
+, d_writeRateLimiter_p(0)
+, d_writeLeases(basicAllocator)
+, d_writeLeaseSize(0)
 , d_channelStateCb(channelStateCb)
 , d_poolStateCb(poolStateCb)
 , d_blobBasedReadCb(blobBasedReadCb)
@@ -3566,6 +4259,9 @@ ChannelPool::ChannelPool(btlb::BlobBufferFactory         *blobBufferFactory,
 , d_config(parameters)
 , d_startFlag(0)
 , d_collectTimeMetrics(parameters.collectTimeMetrics())
+, d_writeRateLimiter_p(0)
+, d_writeLeases(basicAllocator)
+, d_writeLeaseSize(0)
 , d_channelStateCb(channelStateCb)
 , d_poolStateCb(poolStateCb)
 , d_blobBasedReadCb(blobBasedReadCb)
@@ -3609,6 +4305,14 @@ ChannelPool::~ChannelPool()
     for (size_type i = 0; i < numEventManagers; ++i) {
         d_allocator_p->deleteObjectRaw(d_managers[i]);
     }
+
+    // Deallocate write leases, returning their units.
+
+    setWriteRateLimiter(0);
+
+    for (bsl::size_t i = 0; i < d_writeLeases.size(); ++i) {
+        d_allocator_p->deleteObjectRaw(d_writeLeases[i]);
+    }
 }
 
                        // *** Server related section ***
@@ -4052,6 +4756,31 @@ void ChannelPool::setChannelContext(int channelId, void *context)
     }
 }
 
+void ChannelPool::setWriteRateLimiter(btls::ConcurrentRateLimiter *rateLimiter)
+{
+    btls::ConcurrentRateLimiter *previous = d_writeRateLimiter_p.loadAcquire();
+
+    for (bsl::size_t i = 0; i < d_writeLeases.size(); ++i) {
+        d_writeLeases[i]->reset(previous);
+    }
+
+    // Lease a quarter of the burst capacity among the event managers, so that
+    // units left leased to idle event managers throttle busy ones only
+    // marginally.
+
+    const bsls::Types::Uint64 k_MAX_LEASE_SIZE = 64 * 1024;
+
+    d_writeLeaseSize = 0;
+    if (rateLimiter && !d_writeLeases.empty()) {
+        const bsls::Types::Uint64 numLeases = d_writeLeases.size();
+
+        d_writeLeaseSize = bsl::min(k_MAX_LEASE_SIZE,
+                                    rateLimiter->capacity() / (4 * numLeases));
+    }
+
+    d_writeRateLimiter_p.storeRelease(rateLimiter);
+}
+
 int ChannelPool::write(int               channelId,
                        const btlb::Blob& blob,
                        int               enqueueWatermark)
@@ -4481,6 +5210,20 @@ void ChannelPool::totalBytesRequestedToBeWrittenReset(
     d_totalBytesRequestedWrittenAdjustment = -total;
 }
 
+// PRIVATE ACCESSORS
+WriteLease *ChannelPool::writeLease(
+                                const TcpTimerEventManager *eventManager) const
+{
+    for (bsl::size_t i = 0; i < d_managers.size(); ++i) {
+        if (d_managers[i] == eventManager) {
+            return d_writeLeases[i];                                  // RETURN
+        }
+    }
+
+    BSLS_ASSERT(0 && "Unknown event manager");
+    return 0;
+}
+
 // ACCESSORS
 
 void *ChannelPool::channelContext(int channelId) const
@@ -4540,6 +5283,55 @@ int ChannelPool::getChannelWriteQueueStatistics(int *recordedMaxWriteQueueSize,
     return 1;
 }
 
+int ChannelPool::getChannelWriteCoalescingStatistics(
+                                   bsls::Types::Int64 *numBytesWritten,
+                                   bsls::Types::Int64 *numWriteSyscalls,
+                                   bsls::Types::Int64 *numBytesCoalesced,
+                                   int                 channelId) const
+{
+    BSLS_ASSERT(numBytesWritten);
+    BSLS_ASSERT(numWriteSyscalls);
+    BSLS_ASSERT(numBytesCoalesced);
+
+    ChannelHandle channelHandle;
+    if (0 == findChannelHandle(&channelHandle, channelId)) {
+        Channel *channel = channelHandle.get();
+
+        *numBytesWritten   = channel->numBytesWritten();
+        *numWriteSyscalls  = channel->numWriteSyscalls();
+        *numBytesCoalesced = channel->numBytesCoalesced();
+
+        return 0;                                                     // RETURN
+    }
+    return 1;
+}
+
+int ChannelPool::getChannelMetrics(ChannelMetrics *result,
+                                   int             channelId) const
+{
+    BSLS_ASSERT(result);
+
+    ChannelHandle channelHandle;
+    if (0 == findChannelHandle(&channelHandle, channelId)) {
+        channelHandle->loadMetrics(result);
+        return 0;                                                     // RETURN
+    }
+    return 1;
+}
+
+void ChannelPool::getChannelMetrics(bsl::vector<ChannelMetrics> *result) const
+{
+    BSLS_ASSERT(result);
+
+    for (bdlcc::ObjectCatalogIter<bsl::shared_ptr<Channel> >
+                                              iter(d_channels); iter; ++iter) {
+        if (iter().second) {
+            result->resize(result->size() + 1);
+            iter().second->loadMetrics(&result->back());
+        }
+    }
+}
+
 void ChannelPool::getHandleStatistics(
                                      bsl::vector<HandleInfo> *handleInfo) const
 {
@@ -4856,6 +5648,20 @@ void ChannelPool_MessageUtil::appendToBlob(btlb::Blob        *dest,
     dest->trimLastDataBuffer();
 }
 
+void ChannelPool_MessageUtil::copyToBlob(btlb::Blob        *dest,
+                                         const btlb::Blob&  msg)
+{
+    const int numDataBuffers = msg.numDataBuffers();
+
+    for (int bufIdx = 0; bufIdx < numDataBuffers; ++bufIdx) {
+        const int size = bufIdx < numDataBuffers - 1
+                         ? msg.buffer(bufIdx).size()
+                         : msg.lastDataBufferLength();
+
+        btlb::BlobUtil::append(dest, msg.buffer(bufIdx).data(), size);
+    }
+}
+
 }  // close package namespace
 
 }  // close enterprise namespace
@@ -157,6 +157,61 @@ BSLS_IDENT("$Id: $")
 //            T
 //..
 //
+///Per-Channel Metrics
+///-------------------
+// In addition, 'getChannelMetrics' loads a 'ChannelPool::ChannelMetrics'
+// snapshot for one channel (or for all channels) containing the current and
+// maximum write-queue depth, and the number of bytes and of system calls
+// issued in each direction.  If the 'collectChannelMetrics' attribute of the
+// 'btlmt::ChannelPoolConfiguration' supplied at construction is 'true', the
+// snapshot also contains estimates of the 50th and 99th percentiles (and the
+// maximum) of two latencies, in microseconds:
+//
+//: o the *write-queue* latency: the time from when data is enqueued (because
+//:   it could not be written directly) until the batch containing that data
+//:   is fully written to the socket, measured for the oldest data of each
+//:   batch; and
+//:
+//: o the *dispatch* latency: the time from when a channel hands work off to
+//:   its event manager (via 'execute') until that work is dispatched in the
+//:   event manager's thread, which reflects how busy the event loop is.
+//
+// Percentiles are estimated from histograms having buckets of exponentially
+// increasing width, and are thus reported as the (power of two minus one)
+// upper bound of the bucket containing them.  If 'collectChannelMetrics' is
+// 'false' (the default), no timestamp is taken on the read and write paths
+// and the latency fields are 0.  These snapshots can be polled periodically
+// and published to a metrics framework (e.g., a 'balm' metrics collector
+// callback), keyed by channel id.
+//
+///Write Rate Limiting
+///-------------------
+// A single aggregate egress rate can be enforced across all channels, and
+// therefore across all event-manager threads, by supplying a
+// 'btls::ConcurrentRateLimiter' to 'setWriteRateLimiter'.  Before a message is
+// enqueued for writing, its length (in bytes) is consumed from the rate
+// limiter, using the current time as returned by 'bdlt::CurrentTime::now'
+// (the rate limiter must therefore be created using the same clock).  If the
+// rate limiter does not admit the message, the write fails with
+// 'btlmt::ChannelStatus::e_WRITE_THROTTLED', the message is not enqueued, and
+// its length is added to the 'd_numBytesThrottled' field of the channel's
+// 'ChannelMetrics'; the caller may retry after the delay returned by the rate
+// limiter's 'calculateTimeToSubmit'.  A message rejected because the write
+// queue is above its high-water mark does not consume from the rate limiter.
+//
+// So that writes do not all contend on the shared rate limiter, the channels
+// managed by each event manager (i.e., each thread of the channel pool) spend
+// units leased in batches from the rate limiter: a write consumes from the
+// lease of the event manager of its channel, and consults the shared rate
+// limiter (using 'tryConsumeUpTo') only when the lease runs out, leasing the
+// missing units together with a new batch.  A batch is a quarter of the
+// burst capacity of the rate limiter divided by the number of threads, and at
+// most 64 KB.  Leased units count as consumed by the rate limiter, so that
+// the aggregate rate is never exceeded, but a write may be throttled while
+// units remain leased to other event managers.  The units remaining in the
+// leases are returned to the rate limiter (using 'release') when it is
+// replaced by 'setWriteRateLimiter'.
+//
 ///Thread Safety
 ///-------------
 // The channel pool is *thread-enabled* meaning that any operation on the same
@@ -568,6 +623,10 @@ BSLS_IDENT("$Id: $")
 #include <btlmt_tcptimereventmanager.h>
 #endif
 
+#ifndef INCLUDED_BTLS_CONCURRENTRATELIMITER
+#include <btls_concurrentratelimiter.h>
+#endif
+
 #ifndef INCLUDED_BTLS_IOVECUTIL
 #include <btls_iovecutil.h>
 #endif
@@ -680,6 +739,7 @@ namespace btlmt {
 class Channel;
 class Connector;
 class ServerState;
+class WriteLease;
 
                        //==================
                        // struct TimerState
@@ -878,6 +938,57 @@ class ChannelPool {
         int                         d_userId;       // 'serverId' or 'sourceId'
     };
 
+    struct ChannelMetrics {
+        // This 'struct' contains a snapshot of the statistics of a channel
+        // (see the "Per-Channel Metrics" section in the component-level
+        // documentation).  Latencies are expressed in microseconds, and are 0
+        // unless the 'collectChannelMetrics' configuration attribute is
+        // 'true'.  Note that the values are not captured atomically.
+
+        int                d_channelId;             // channel id
+
+        int                d_currentWriteQueueSize; // bytes in write queue
+
+        int                d_recordedMaxWriteQueueSize;
+                                                    // maximum bytes in write
+                                                    // queue
+
+        bsls::Types::Int64 d_numBytesRead;          // bytes read
+
+        bsls::Types::Int64 d_numBytesWritten;       // bytes written
+
+        bsls::Types::Int64 d_numReadSyscalls;       // 'readv' calls
+
+        bsls::Types::Int64 d_numWriteSyscalls;      // 'writev' calls
+
+        bsls::Types::Int64 d_numWriteQueueLatencySamples;
+                                                    // batches written from
+                                                    // the write queue
+
+        bsls::Types::Int64 d_writeQueueLatencyP50;  // median time in queue
+
+        bsls::Types::Int64 d_writeQueueLatencyP99;  // 99th percentile time
+                                                    // in queue
+
+        bsls::Types::Int64 d_writeQueueLatencyMax;  // maximum time in queue
+
+        bsls::Types::Int64 d_numDispatchLatencySamples;
+                                                    // number of dispatches
+                                                    // measured
+
+        bsls::Types::Int64 d_dispatchLatencyP50;    // median dispatch
+                                                    // latency
+
+        bsls::Types::Int64 d_dispatchLatencyP99;    // 99th percentile
+                                                    // dispatch latency
+
+        bsls::Types::Int64 d_dispatchLatencyMax;    // maximum dispatch
+                                                    // latency
+
+        bsls::Types::Int64 d_numBytesThrottled;     // bytes refused by the
+                                                    // write rate limiter
+    };
+
   private:
     // PRIVATE TYPES
     typedef bsl::shared_ptr<Channel>     ChannelHandle;
@@ -927,6 +1038,24 @@ class ChannelPool {
                                                // whether to collect time
                                                // metrics
 
+    bsls::AtomicPointer<btls::ConcurrentRateLimiter>
+                                        d_writeRateLimiter_p;
+                                               // limiter consulted by every
+                                               // write, or 0 (held, not
+                                               // owned)
+
+    bsl::vector<WriteLease *>           d_writeLeases;
+                                               // units of the write rate
+                                               // limiter leased for the
+                                               // channels of each event
+                                               // manager (indexed as
+                                               // 'd_managers', owned)
+
+    bsls::Types::Uint64                 d_writeLeaseSize;
+                                               // number of units leased at a
+                                               // time (published by
+                                               // 'd_writeRateLimiter_p')
+
                                         // *** Capacity monitoring ***
 
     bdlb::NullableValue<void *>         d_metricsTimerId;
@@ -1153,6 +1282,11 @@ class ChannelPool {
         // Note that a channel handle in 'd_channels' may be null, if the
         // channel has been added but not yet initialized.
 
+    WriteLease *writeLease(const TcpTimerEventManager *eventManager) const;
+        // Return the address of the lease of write rate limiter units for the
+        // channels of the specified 'eventManager'.  The behavior is undefined
+        // unless 'eventManager' is an event manager of this channel pool.
+
   private:
     // NOT IMPLEMENTED
     ChannelPool(const ChannelPool& original);
@@ -1407,6 +1541,18 @@ class ChannelPool {
         // function resets the recorded max write queue size and does not
         // change the write queue high-water mark for 'channelId'.
 
+    void setWriteRateLimiter(btls::ConcurrentRateLimiter *rateLimiter);
+        // Consult the specified 'rateLimiter' before enqueuing any message
+        // for writing on any channel managed by this channel pool, or, if
+        // 'rateLimiter' is 0, stop limiting the rate of writes.  Writes that
+        // 'rateLimiter' does not admit fail with
+        // 'ChannelStatus::e_WRITE_THROTTLED'.  The units remaining leased
+        // from the previous rate limiter (if any) are returned to it.  The
+        // behavior is undefined unless 'rateLimiter' (if not 0) remains valid
+        // until it is replaced and no write that may be using it is in
+        // progress.  See the "Write Rate Limiting" section in the
+        // component-level documentation.
+
                                   // *** Thread management ***
 
     int start();
@@ -1618,6 +1764,35 @@ class ChannelPool {
         // the time one of the values is captured, another may already have
         // changed.
 
+    int getChannelWriteCoalescingStatistics(
+                                   bsls::Types::Int64 *numBytesWritten,
+                                   bsls::Types::Int64 *numWriteSyscalls,
+                                   bsls::Types::Int64 *numBytesCoalesced,
+                                   int                 channelId) const;
+        // Load into the specified 'numBytesWritten', 'numWriteSyscalls', and
+        // 'numBytesCoalesced' respectively the number of bytes written, the
+        // number of 'writev' system calls issued, and the number of bytes
+        // copied into a staging buffer (see the "Write Coalescing" section of
+        // 'btlmt_channelpoolconfiguration') for the channel identified by the
+        // specified 'channelId' since its creation, and return 0 if
+        // 'channelId' is a valid channel id.  Otherwise, return a non-zero
+        // value.  Note that the average number of bytes written per system
+        // call is '*numBytesWritten / *numWriteSyscalls'.  Also note that for
+        // performance reasons this *sequence* is not captured atomically: by
+        // the time one of the values is captured, another may already have
+        // changed.
+
+    int getChannelMetrics(ChannelMetrics *result, int channelId) const;
+        // Load into the specified 'result' a snapshot of the statistics of
+        // the channel identified by the specified 'channelId', and return 0
+        // if 'channelId' is a valid channel id.  Otherwise, return a non-zero
+        // value with no effect on 'result'.  See the "Per-Channel Metrics"
+        // section in the component-level documentation.
+
+    void getChannelMetrics(bsl::vector<ChannelMetrics> *result) const;
+        // Append to the specified 'result' a snapshot of the statistics of
+        // each channel currently managed by this channel pool.
+
     void getHandleStatistics(bsl::vector<HandleInfo> *handleInfo) const;
         // Append to the specified 'handleInfo' array a snapshot of the
         // information per socket handle currently in use by this channel pool.
@@ -1706,6 +1881,10 @@ class ChannelPool {
         // therefore, the number of threads is the number of active event
         // managers.
 
+    btls::ConcurrentRateLimiter *writeRateLimiter() const;
+        // Return the address of the rate limiter consulted before enqueuing
+        // messages for writing, or 0 if writes are not rate limited.
+
     bsl::shared_ptr<const btlso::StreamSocket<btlso::IPv4Address> >
                                              streamSocket(int channelId) const;
         // Return a shared pointer to the non-modifiable stream socket
@@ -1894,6 +2073,17 @@ struct ChannelPool_MessageUtil {
         // Append, to the specified 'dest' blob, the data buffers in the
         // specified 'msg'.  The behavior is undefined unless the last buffer
         // in 'dest' is trimmed.
+
+    template <class IOVEC>
+    static void copyToBlob(btlb::Blob                           *dest,
+                           const ChannelPool_IovecArray<IOVEC>&  msg);
+    static void copyToBlob(btlb::Blob                           *dest,
+                           const btlb::Blob&                     msg);
+        // Append, to the specified 'dest' blob, a copy of the data in the
+        // specified 'msg', filling the unused capacity of the last data buffer
+        // in 'dest' before adding new buffers obtained from the blob buffer
+        // factory of 'dest'.  Note that, unlike 'appendToBlob', no buffer of
+        // 'msg' is shared with 'dest'.
 };
 
 // ============================================================================
@@ -1971,6 +2161,12 @@ int ChannelPool::numThreads() const
     return d_startFlag ? static_cast<int>(d_managers.size()) : 0;
 }
 
+inline
+btls::ConcurrentRateLimiter *ChannelPool::writeRateLimiter() const
+{
+    return d_writeRateLimiter_p.loadAcquire();
+}
+
                  // ----------------------------
                  // class ChannelPool_IovecArray
                  // ----------------------------
@@ -2103,6 +2299,15 @@ void ChannelPool_MessageUtil::appendToBlob(
     btls::IovecUtil::appendToBlob(dest, msg.iovecs(), msg.numIovecs());
 }
 
+template <class IOVEC>
+inline
+void ChannelPool_MessageUtil::copyToBlob(
+                                    btlb::Blob                           *dest,
+                                    const ChannelPool_IovecArray<IOVEC>&  msg)
+{
+    btls::IovecUtil::appendToBlob(dest, msg.iovecs(), msg.numIovecs());
+}
+
 
 
 }  // close package namespace
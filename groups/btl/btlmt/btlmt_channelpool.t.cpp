@@ -13,6 +13,7 @@
 #include <btlmt_channelpoolconfiguration.h>
 #include <btlmt_asyncchannel.h>
 
+#include <btls_concurrentratelimiter.h>
 #include <btls_iovecutil.h>
 #include <btlso_flag.h>
 #include <btlso_inetstreamsocketfactory.h>
@@ -43,6 +44,7 @@
 #include <bdlb_hashutil.h>
 #include <bdlb_print.h>
 #include <bdlb_tokenizer.h>
+#include <bdlt_currenttime.h>
 
 #include <bslma_allocator.h>
 #include <bslma_default.h>
@@ -139,6 +141,10 @@ using namespace bdlf::PlaceHolders;
 // [14]  int btlmt::ChannelPool::getChannelStatistics*(...);
 // [14]  int btlmt::ChannelPool::numBytes*(...);
 // [14]  int btlmt::ChannelPool::totalBytes*(...);
+// [41]  int btlmt::ChannelPool::getChannelWriteCoalescingStatistics(...);
+// [42]  int btlmt::ChannelPool::getChannelMetrics(...);
+// [43]  void btlmt::ChannelPool::setWriteRateLimiter(...);
+// [43]  btls::ConcurrentRateLimiter *ChannelPool::writeRateLimiter() const;
 // [  ]  const btlso::IPv4Address *ChannelPool::serverAddress(...) const;
 //
 // CLASS 'btlmt::ChannelPool_MessageUtil'
@@ -149,6 +155,7 @@ using namespace bdlf::PlaceHolders;
 // [26] static int loadIovec(btls::Iovec *, ... );
 // [26] static int loadBlob(btlb::Blob *, ... );
 // [26] static void appendToBlob(btlb::Blob *, ... );
+// [41] static void copyToBlob(btlb::Blob *, ... );
 //-----------------------------------------------------------------------------
 // [ 1] BREATHING TEST
 // [ 7] CONCERN: Import half-closed socket pair
@@ -166,6 +173,8 @@ using namespace bdlf::PlaceHolders;
 // [28] TESTING: 'busyMetrics' and time metrics collection.
 // [28] CONCERN: Event Manager Allocation
 // [30] Implementing a QueueProcessor
+// [41] CONCERN: Write coalescing
+// [43] CONCERN: Write rate limiting shared across channels
 // [37] USAGE EXAMPLE
 //=============================================================================
 //                       STANDARD BDE ASSERT TEST MACROS
@@ -713,6 +722,273 @@ void populateMessage(btlb::Blob       *msg,
     msg->appendDataBuffer(blobBuffer);
 }
 
+//-----------------------------------------------------------------------------
+// TEST_CASE_WRITE_COALESCING
+//-----------------------------------------------------------------------------
+
+namespace TEST_CASE_WRITE_COALESCING {
+
+void channelStateCb(int             channelId,
+                    int             serverId,
+                    int             state,
+                    void           *,
+                    int            *cid,
+                    bslmt::Barrier *barrier)
+{
+    if (veryVerbose) {
+        MTCOUT << "Channel state callback called with"
+               << " Channel Id: " << channelId
+               << " Server Id: "  << serverId
+               << " State: " << state << MTENDL;
+    }
+
+    if (btlmt::ChannelPool::e_CHANNEL_UP == state) {
+        *cid = channelId;
+        barrier->wait();
+    }
+}
+
+void poolStateCb(int, int, int)
+{
+}
+
+void blobBasedReadCb(int *needed, btlb::Blob *msg, int, void *)
+{
+    *needed = 1;
+    msg->removeAll();
+}
+
+void runTest(bsls::Types::Int64 *numBytesWritten,
+             bsls::Types::Int64 *numWriteSyscalls,
+             bsls::Types::Int64 *numBytesCoalesced,
+             int                 coalesceSize,
+             double              coalesceDelay,
+             int                 numMessages,
+             int                 messageSize)
+    // Write the specified 'numMessages' messages of the specified
+    // 'messageSize' bytes each on a channel of a channel pool configured
+    // with the specified 'coalesceSize' and 'coalesceDelay', verify that the
+    // peer receives them in order, and load the write coalescing statistics
+    // of the channel into the specified 'numBytesWritten',
+    // 'numWriteSyscalls', and 'numBytesCoalesced'.
+{
+    btlso::InetStreamSocketFactory<btlso::IPv4Address> factory;
+
+    btlmt::ChannelPoolConfiguration config;
+    config.setMaxThreads(1);
+    config.setWriteCoalesceSize(coalesceSize);
+    config.setWriteCoalesceDelay(coalesceDelay);
+    if (veryVerbose) { P(config); }
+
+    bslmt::Barrier barrier(2);
+    int            channelId = -1;
+
+    btlmt::ChannelPool::ChannelStateChangeCallback channelCb(
+                                     bdlf::BindUtil::bind(&channelStateCb,
+                                                          _1, _2, _3, _4,
+                                                          &channelId,
+                                                          &barrier));
+
+    btlmt::ChannelPool::PoolStateChangeCallback poolCb(&poolStateCb);
+    btlmt::ChannelPool::BlobBasedReadCallback   dataCb(&blobBasedReadCb);
+
+    btlmt::ChannelPool mX(channelCb, dataCb, poolCb, config);
+    ASSERT(0 == mX.start());
+
+    const int SID = 101;
+
+    btlmt::ListenOptions options;
+    options.setServerAddress(btlso::IPv4Address("127.0.0.1", 0));
+    options.setBacklog(1);
+
+    ASSERT(0 == mX.listen(SID, options));
+
+    btlso::IPv4Address peer;
+    mX.getServerAddress(&peer, SID);
+
+    btlso::StreamSocket<btlso::IPv4Address> *clientSocket =
+                                                            factory.allocate();
+    ASSERT(clientSocket);
+    ASSERT(0 == clientSocket->connect(peer));
+
+    barrier.wait();
+
+    for (int i = 0; i < numMessages; ++i) {
+        bsl::shared_ptr<char> buffer =
+                 bslstl::SharedPtrUtil::createInplaceUninitializedBuffer(
+                                                  messageSize,
+                                                  bslma::Default::allocator());
+        bsl::memset(buffer.get(), 'a' + i % 26, messageSize);
+
+        btlb::Blob msg;
+        msg.appendDataBuffer(btlb::BlobBuffer(buffer, messageSize));
+
+        LOOP_ASSERT(i, 0 == mX.write(channelId, msg));
+    }
+
+    const int         totalSize = numMessages * messageSize;
+    bsl::vector<char> received(totalSize);
+
+    int numRead = 0;
+    while (numRead < totalSize) {
+        int rc = clientSocket->read(&received[numRead], totalSize - numRead);
+        ASSERT(0 < rc);
+        if (rc <= 0) {
+            break;
+        }
+        numRead += rc;
+    }
+
+    for (int i = 0; i < numRead; ++i) {
+        LOOP_ASSERT(i, 'a' + (i / messageSize) % 26 == received[i]);
+    }
+
+    // 'numBytesWritten' is updated by the dispatcher thread after the data is
+    // written to the socket.
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT(0 == mX.getChannelWriteCoalescingStatistics(numBytesWritten,
+                                                           numWriteSyscalls,
+                                                           numBytesCoalesced,
+                                                           channelId));
+        if (totalSize == *numBytesWritten) {
+            break;
+        }
+        bslmt::ThreadUtil::microSleep(10 * 1000);
+    }
+
+    bsls::Types::Int64 dummy;
+    ASSERT(0 != mX.getChannelWriteCoalescingStatistics(&dummy,
+                                                       &dummy,
+                                                       &dummy,
+                                                       channelId + 1));
+
+    factory.deallocate(clientSocket);
+    mX.stopAndRemoveAllChannels();
+}
+
+int waitForNumEvents(const btlmt::ChannelPool& pool, int numEvents)
+    // Wait for at most one second until the single event manager of the
+    // specified 'pool' has the specified 'numEvents' registered, and return
+    // the number of events registered.
+{
+    int result = pool.numEvents(0);
+    for (int i = 0; i < 100 && numEvents != result; ++i) {
+        bslmt::ThreadUtil::microSleep(10 * 1000);
+        result = pool.numEvents(0);
+    }
+    return result;
+}
+
+void runTimerTest()
+    // Verify that the timer of the coalescing delay of a channel is
+    // registered while a small message is delayed, and deregistered once the
+    // message is flushed by a larger message, or the channel is shut down.
+{
+    enum {
+        COALESCE_SIZE = 64,
+        SMALL_SIZE    = 10,
+        LARGE_SIZE    = 100
+    };
+
+    btlso::InetStreamSocketFactory<btlso::IPv4Address> factory;
+
+    btlmt::ChannelPoolConfiguration config;
+    config.setMaxThreads(1);
+    config.setWriteCoalesceSize(COALESCE_SIZE);
+    config.setWriteCoalesceDelay(60.0);  // never expires during the test
+
+    bslmt::Barrier barrier(2);
+    int            channelId = -1;
+
+    btlmt::ChannelPool::ChannelStateChangeCallback channelCb(
+                                     bdlf::BindUtil::bind(&channelStateCb,
+                                                          _1, _2, _3, _4,
+                                                          &channelId,
+                                                          &barrier));
+
+    btlmt::ChannelPool::PoolStateChangeCallback poolCb(&poolStateCb);
+    btlmt::ChannelPool::BlobBasedReadCallback   dataCb(&blobBasedReadCb);
+
+    btlmt::ChannelPool mX(channelCb, dataCb, poolCb, config);
+    const btlmt::ChannelPool& X = mX;
+    ASSERT(0 == mX.start());
+
+    const int SID = 101;
+
+    btlmt::ListenOptions options;
+    options.setServerAddress(btlso::IPv4Address("127.0.0.1", 0));
+    options.setBacklog(1);
+
+    ASSERT(0 == mX.listen(SID, options));
+
+    btlso::IPv4Address peer;
+    mX.getServerAddress(&peer, SID);
+
+    // Let the server register for accepting connections.
+
+    bslmt::ThreadUtil::microSleep(100 * 1000);
+
+    const int NUM_SERVER_EVENTS = X.numEvents(0);
+
+    btlso::StreamSocket<btlso::IPv4Address> *clientSocket =
+                                                            factory.allocate();
+    ASSERT(clientSocket);
+    ASSERT(0 == clientSocket->connect(peer));
+
+    barrier.wait();
+
+    // Let the channel register for reading.
+
+    bslmt::ThreadUtil::microSleep(100 * 1000);
+
+    const int NUM_EVENTS = X.numEvents(0);
+    if (veryVerbose) { T_() P_(NUM_SERVER_EVENTS) P(NUM_EVENTS) }
+
+    btlb::Blob smallMsg;
+    populateMessage(&smallMsg, SMALL_SIZE, bslma::Default::allocator());
+
+    btlb::Blob largeMsg;
+    populateMessage(&largeMsg, LARGE_SIZE, bslma::Default::allocator());
+
+    // A delayed message registers a timer, which is deregistered when the
+    // message is flushed early.
+
+    ASSERT(0 == mX.write(channelId, smallMsg));
+    ASSERT(NUM_EVENTS + 1 == waitForNumEvents(X, NUM_EVENTS + 1));
+
+    ASSERT(0 == mX.write(channelId, largeMsg));
+
+    const int         totalSize = SMALL_SIZE + LARGE_SIZE;
+    bsl::vector<char> received(totalSize);
+
+    int numRead = 0;
+    while (numRead < totalSize) {
+        int rc = clientSocket->read(&received[numRead], totalSize - numRead);
+        ASSERT(0 < rc);
+        if (rc <= 0) {
+            break;
+        }
+        numRead += rc;
+    }
+
+    ASSERT(NUM_EVENTS == waitForNumEvents(X, NUM_EVENTS));
+
+    // Shutting down the channel deregisters the timer of a delayed message
+    // along with the events of the channel.
+
+    ASSERT(0 == mX.write(channelId, smallMsg));
+    ASSERT(NUM_EVENTS + 1 == waitForNumEvents(X, NUM_EVENTS + 1));
+
+    ASSERT(0 == mX.shutdown(channelId, btlmt::ChannelPool::e_IMMEDIATE));
+    ASSERT(NUM_SERVER_EVENTS == waitForNumEvents(X, NUM_SERVER_EVENTS));
+
+    factory.deallocate(clientSocket);
+    mX.stopAndRemoveAllChannels();
+}
+
+}  // close namespace TEST_CASE_WRITE_COALESCING
+
 //-----------------------------------------------------------------------------
 // TEST_CASE_WATERMARK_SEQUENCING
 //-----------------------------------------------------------------------------
@@ -8103,6 +8379,15 @@ class TestDriver {
 
   public:
     // TEST CASES
+    static void testCase43();
+        // Test write rate limiting.
+
+    static void testCase42();
+        // Test per-channel metrics.
+
+    static void testCase41();
+        // Test write coalescing.
+
     static void testCase40();
         // Test usage example.
 
@@ -8241,6 +8526,452 @@ class TestDriver {
                                // TEST APPARATUS
                                // --------------
 
+void TestDriver::testCase43()
+{
+    // --------------------------------------------------------------------
+    // TESTING: Write rate limiting
+    //
+    // Concerns:
+    //: 1 By default, writes are not rate limited.
+    //:
+    //: 2 A rate limiter supplied to 'setWriteRateLimiter' is shared by all
+    //:   channels: writes on any channel consume from it, and a write that
+    //:   it does not admit fails with 'e_WRITE_THROTTLED' regardless of the
+    //:   channel.
+    //:
+    //: 3 A throttled message is not written, and its length is reported in
+    //:   the 'd_numBytesThrottled' field of the metrics of the channel on
+    //:   which it was written.
+    //:
+    //: 4 Supplying a null rate limiter disables rate limiting.
+    //:
+    //: 5 Writes consume from the rate limiter in batches leased for the
+    //:   event manager of the channel, and the units remaining leased are
+    //:   returned to the rate limiter when it is replaced.
+    //
+    // Plan:
+    //: 1 Create a channel pool with two channels, and install a rate
+    //:   limiter whose burst capacity is 1000 bytes and whose rate is low
+    //:   enough that nothing measurable drains during the test.  Write 400
+    //:   bytes on each channel, then 400 more on the first channel, and
+    //:   verify the return codes, the per-channel metrics, the statistics of
+    //:   the limiter, and the data received by the peers.  With a single
+    //:   thread, a batch is 250 bytes, so that the limiter has admitted its
+    //:   whole capacity after the second write.  (C-2..3, 5)
+    //:
+    //: 2 Verify 'writeRateLimiter' before and after installing and removing
+    //:   the limiter, that the units remaining leased are returned to the
+    //:   limiter, and that writes succeed once it is removed.  (C-1, 4..5)
+    //
+    // Testing:
+    //   void setWriteRateLimiter(btls::ConcurrentRateLimiter *);
+    //   btls::ConcurrentRateLimiter *writeRateLimiter() const;
+    // --------------------------------------------------------------------
+
+    if (verbose) cout << "TESTING: Write rate limiting" << endl
+                      << "============================" << endl;
+
+    using namespace TEST_CASE_WRITE_COALESCING;
+
+    enum {
+        NUM_CHANNELS = 2,
+        MESSAGE_SIZE = 400,
+        RATE         = 100,  // bytes/s
+        WINDOW       = 10    // seconds
+    };
+
+    btlso::InetStreamSocketFactory<btlso::IPv4Address> factory;
+
+    btlmt::ChannelPoolConfiguration config;
+    config.setMaxThreads(1);
+
+    bslmt::Barrier barrier(2);
+    int            channelId = -1;
+
+    btlmt::ChannelPool::ChannelStateChangeCallback channelCb(
+                                     bdlf::BindUtil::bind(&channelStateCb,
+                                                          _1, _2, _3, _4,
+                                                          &channelId,
+                                                          &barrier));
+
+    btlmt::ChannelPool::PoolStateChangeCallback poolCb(&poolStateCb);
+    btlmt::ChannelPool::BlobBasedReadCallback   dataCb(&blobBasedReadCb);
+
+    Obj mX(channelCb, dataCb, poolCb, config);  const Obj& X = mX;
+    ASSERT(0 == mX.start());
+
+    ASSERT(0 == X.writeRateLimiter());
+
+    const int SID = 101;
+
+    btlmt::ListenOptions options;
+    options.setServerAddress(btlso::IPv4Address("127.0.0.1", 0));
+    options.setBacklog(NUM_CHANNELS);
+
+    ASSERT(0 == mX.listen(SID, options));
+
+    btlso::IPv4Address peer;
+    mX.getServerAddress(&peer, SID);
+
+    btlso::StreamSocket<btlso::IPv4Address> *clientSockets[NUM_CHANNELS];
+    int                                      channelIds[NUM_CHANNELS];
+
+    for (int i = 0; i < NUM_CHANNELS; ++i) {
+        clientSockets[i] = factory.allocate();
+        ASSERT(clientSockets[i]);
+        ASSERT(0 == clientSockets[i]->connect(peer));
+
+        barrier.wait();
+        channelIds[i] = channelId;
+    }
+
+    btls::ConcurrentRateLimiter limiter(RATE,
+                                        bsls::TimeInterval(WINDOW),
+                                        bdlt::CurrentTime::now());
+    ASSERT(RATE * WINDOW == limiter.capacity());
+
+    mX.setWriteRateLimiter(&limiter);
+    ASSERT(&limiter == X.writeRateLimiter());
+
+    btlb::Blob msg;
+    populateMessage(&msg, MESSAGE_SIZE, bslma::Default::allocator());
+
+    ASSERT(0 == mX.write(channelIds[0], msg));
+    ASSERT(0 == mX.write(channelIds[1], msg));
+
+    ASSERT(btlmt::ChannelStatus::e_WRITE_THROTTLED ==
+                                               mX.write(channelIds[0], msg));
+
+    ASSERT(RATE * WINDOW == limiter.numUnitsAdmitted());
+    ASSERT(0             == limiter.numUnitsRejected());
+
+    // Each peer receives exactly one message.
+
+    for (int i = 0; i < NUM_CHANNELS; ++i) {
+        bsl::vector<char> received(MESSAGE_SIZE);
+
+        int numRead = 0;
+        while (numRead < MESSAGE_SIZE) {
+            int rc = clientSockets[i]->read(&received[numRead],
+                                            MESSAGE_SIZE - numRead);
+            ASSERT(0 < rc);
+            if (rc <= 0) {
+                break;
+            }
+            numRead += rc;
+        }
+    }
+
+    btlmt::ChannelPool::ChannelMetrics metrics[NUM_CHANNELS];
+    for (int i = 0; i < NUM_CHANNELS; ++i) {
+        for (int j = 0; j < 100; ++j) {
+            ASSERT(0 == X.getChannelMetrics(&metrics[i], channelIds[i]));
+            if (MESSAGE_SIZE == metrics[i].d_numBytesWritten) {
+                break;
+            }
+            bslmt::ThreadUtil::microSleep(10 * 1000);
+        }
+        LOOP_ASSERT(i, MESSAGE_SIZE == metrics[i].d_numBytesWritten);
+    }
+
+    ASSERT(MESSAGE_SIZE == metrics[0].d_numBytesThrottled);
+    ASSERT(0            == metrics[1].d_numBytesThrottled);
+
+    // Removing the limiter disables rate limiting.
+
+    mX.setWriteRateLimiter(0);
+    ASSERT(0 == X.writeRateLimiter());
+    ASSERT(2 * MESSAGE_SIZE == limiter.numUnitsAdmitted());
+
+    ASSERT(0 == mX.write(channelIds[0], msg));
+    ASSERT(2 * MESSAGE_SIZE == limiter.numUnitsAdmitted());
+
+    for (int i = 0; i < NUM_CHANNELS; ++i) {
+        factory.deallocate(clientSockets[i]);
+    }
+    mX.stopAndRemoveAllChannels();
+}
+
+void TestDriver::testCase42()
+{
+    // --------------------------------------------------------------------
+    // TESTING: Per-channel metrics
+    //
+    // Concerns:
+    //: 1 'getChannelMetrics' reports the bytes and system calls issued in
+    //:   each direction, and the write queue depth.
+    //:
+    //: 2 If 'collectChannelMetrics' is 'true', data that could not be
+    //:   written directly yields write-queue and dispatch latency samples,
+    //:   and the reported percentiles are ordered.
+    //:
+    //: 3 If 'collectChannelMetrics' is 'false', all latency fields are 0.
+    //:
+    //: 4 'getChannelMetrics' returns a non-zero value for an invalid channel
+    //:   id, and the overload taking a vector reports every channel.
+    //
+    // Plan:
+    //: 1 With and without 'collectChannelMetrics', write a message larger
+    //:   than the socket send buffer on a channel so that part of it is
+    //:   enqueued, read it from the peer, and send some data from the peer.
+    //:   Then verify the snapshots returned by both 'getChannelMetrics'
+    //:   overloads.  (C-1..4)
+    //
+    // Testing:
+    //   int getChannelMetrics(ChannelMetrics *, int) const;
+    //   void getChannelMetrics(bsl::vector<ChannelMetrics> *) const;
+    // --------------------------------------------------------------------
+
+    if (verbose) cout << "TESTING: Per-channel metrics" << endl
+                      << "============================" << endl;
+
+    using namespace TEST_CASE_WRITE_COALESCING;
+
+    enum {
+        MESSAGE_SIZE = 4 * 1024 * 1024,
+        READ_SIZE    = 100
+    };
+
+    for (int ti = 0; ti < 2; ++ti) {
+        const bool COLLECT = 1 == ti;
+
+        if (veryVerbose) { T_() P(COLLECT) }
+
+        btlso::InetStreamSocketFactory<btlso::IPv4Address> factory;
+
+        btlmt::ChannelPoolConfiguration config;
+        config.setMaxThreads(1);
+        config.setCollectChannelMetrics(COLLECT);
+
+        bslmt::Barrier barrier(2);
+        int            channelId = -1;
+
+        btlmt::ChannelPool::ChannelStateChangeCallback channelCb(
+                                     bdlf::BindUtil::bind(&channelStateCb,
+                                                          _1, _2, _3, _4,
+                                                          &channelId,
+                                                          &barrier));
+
+        btlmt::ChannelPool::PoolStateChangeCallback poolCb(&poolStateCb);
+        btlmt::ChannelPool::BlobBasedReadCallback   dataCb(&blobBasedReadCb);
+
+        Obj mX(channelCb, dataCb, poolCb, config);  const Obj& X = mX;
+        ASSERT(0 == mX.start());
+
+        const int SID = 101;
+
+        btlmt::ListenOptions options;
+        options.setServerAddress(btlso::IPv4Address("127.0.0.1", 0));
+        options.setBacklog(1);
+
+        ASSERT(0 == mX.listen(SID, options));
+
+        btlso::IPv4Address peer;
+        mX.getServerAddress(&peer, SID);
+
+        btlso::StreamSocket<btlso::IPv4Address> *clientSocket =
+                                                            factory.allocate();
+        ASSERT(clientSocket);
+        ASSERT(0 == clientSocket->connect(peer));
+
+        barrier.wait();
+
+        btlb::Blob msg;
+        populateMessage(&msg, MESSAGE_SIZE, bslma::Default::allocator());
+        ASSERT(0 == mX.write(channelId, msg));
+
+        bsl::vector<char> received(MESSAGE_SIZE);
+
+        int numRead = 0;
+        while (numRead < MESSAGE_SIZE) {
+            int rc = clientSocket->read(&received[numRead],
+                                        MESSAGE_SIZE - numRead);
+            ASSERT(0 < rc);
+            if (rc <= 0) {
+                break;
+            }
+            numRead += rc;
+        }
+
+        char data[READ_SIZE] = { 0 };
+        ASSERT(READ_SIZE == clientSocket->write(data, READ_SIZE));
+
+        btlmt::ChannelPool::ChannelMetrics metrics;
+        for (int i = 0; i < 100; ++i) {
+            ASSERT(0 == X.getChannelMetrics(&metrics, channelId));
+            if (MESSAGE_SIZE == metrics.d_numBytesWritten
+             && READ_SIZE    == metrics.d_numBytesRead) {
+                break;
+            }
+            bslmt::ThreadUtil::microSleep(10 * 1000);
+        }
+
+        if (veryVerbose) {
+            T_() P_(metrics.d_numWriteSyscalls) P(metrics.d_numReadSyscalls)
+            T_() P_(metrics.d_writeQueueLatencyP50)
+                 P_(metrics.d_writeQueueLatencyP99)
+                 P(metrics.d_writeQueueLatencyMax)
+            T_() P_(metrics.d_dispatchLatencyP50)
+                 P_(metrics.d_dispatchLatencyP99)
+                 P(metrics.d_dispatchLatencyMax)
+        }
+
+        LOOP_ASSERT(COLLECT, channelId    == metrics.d_channelId);
+        LOOP_ASSERT(COLLECT, MESSAGE_SIZE == metrics.d_numBytesWritten);
+        LOOP_ASSERT(COLLECT, READ_SIZE    == metrics.d_numBytesRead);
+        LOOP_ASSERT(COLLECT, 0 == metrics.d_currentWriteQueueSize);
+        LOOP_ASSERT(COLLECT, 0 <= metrics.d_recordedMaxWriteQueueSize);
+        LOOP_ASSERT(COLLECT, 1 <= metrics.d_numWriteSyscalls);
+        LOOP_ASSERT(COLLECT, 1 <= metrics.d_numReadSyscalls);
+
+        const bool ENQUEUED = 1 < metrics.d_numWriteSyscalls;
+
+        if (COLLECT && ENQUEUED) {
+            ASSERT(1 <= metrics.d_numWriteQueueLatencySamples);
+            ASSERT(1 <= metrics.d_numDispatchLatencySamples);
+        }
+        if (!COLLECT) {
+            ASSERT(0 == metrics.d_numWriteQueueLatencySamples);
+            ASSERT(0 == metrics.d_numDispatchLatencySamples);
+            ASSERT(0 == metrics.d_writeQueueLatencyMax);
+            ASSERT(0 == metrics.d_dispatchLatencyMax);
+        }
+        ASSERT(metrics.d_writeQueueLatencyP50 <=
+                                              metrics.d_writeQueueLatencyP99);
+        ASSERT(metrics.d_writeQueueLatencyP99 <=
+                                              metrics.d_writeQueueLatencyMax);
+        ASSERT(metrics.d_dispatchLatencyP50 <= metrics.d_dispatchLatencyP99);
+        ASSERT(metrics.d_dispatchLatencyP99 <= metrics.d_dispatchLatencyMax);
+
+        btlmt::ChannelPool::ChannelMetrics dummy;
+        ASSERT(0 != X.getChannelMetrics(&dummy, channelId + 1));
+
+        bsl::vector<btlmt::ChannelPool::ChannelMetrics> all;
+        X.getChannelMetrics(&all);
+        ASSERT(1         == all.size());
+        ASSERT(channelId == all[0].d_channelId);
+
+        factory.deallocate(clientSocket);
+        mX.stopAndRemoveAllChannels();
+    }
+}
+
+void TestDriver::testCase41()
+{
+    // --------------------------------------------------------------------
+    // TESTING: Write coalescing
+    //
+    // Concerns:
+    //: 1 If 'writeCoalesceSize' is 0 (the default), no message is copied.
+    //:
+    //: 2 If 'writeCoalesceSize' is positive, every message of at most that
+    //:   many bytes is copied into a staging buffer, and the data is received
+    //:   by the peer unchanged and in order.
+    //:
+    //: 3 If 'writeCoalesceDelay' is also positive, a burst of small messages
+    //:   is written using fewer system calls than messages.
+    //:
+    //: 4 'getChannelWriteCoalescingStatistics' returns a non-zero value for
+    //:   an invalid channel id.
+    //:
+    //: 5 At most one timer is registered for the coalescing delay of a
+    //:   channel, and it is deregistered when the delayed data is flushed
+    //:   early or the channel is shut down.
+    //
+    // Plan:
+    //: 1 For each of a set of configurations, write a burst of small
+    //:   messages on a channel, read them from the peer socket and verify
+    //:   their contents.  Then verify the statistics returned by
+    //:   'getChannelWriteCoalescingStatistics'.  (C-1..4)
+    //:
+    //: 2 Using a coalescing delay that does not expire during the test,
+    //:   write a small message and verify that the number of events
+    //:   registered with the event manager grows by one.  Then flush it with
+    //:   a larger message, and verify that the number of events is restored.
+    //:   Finally, delay another small message, shut down the channel, and
+    //:   verify that the number of events is that before the channel was
+    //:   created.  (C-5)
+    //
+    // Testing:
+    //   int getChannelWriteCoalescingStatistics(...) const;
+    //   CONCERN: Write coalescing
+    // --------------------------------------------------------------------
+
+    if (verbose) cout << "TESTING: Write coalescing" << endl
+                      << "=========================" << endl;
+
+    using namespace TEST_CASE_WRITE_COALESCING;
+
+    enum {
+        NUM_MESSAGES = 100,
+        MESSAGE_SIZE =  10
+    };
+
+    const int TOTAL_SIZE = NUM_MESSAGES * MESSAGE_SIZE;
+
+    static const struct {
+        int    d_line;
+        int    d_coalesceSize;
+        double d_coalesceDelay;
+    } DATA[] = {
+        //LINE  SIZE  DELAY
+        //----  ----  -----
+        { L_,      0, 0.0  },
+        { L_,      0, 0.1  },
+        { L_,      9, 0.0  },
+        { L_,     10, 0.0  },
+        { L_,     64, 0.0  },
+        { L_,     64, 0.1  },
+    };
+    const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+    for (int ti = 0; ti < NUM_DATA; ++ti) {
+        const int    LINE  = DATA[ti].d_line;
+        const int    SIZE  = DATA[ti].d_coalesceSize;
+        const double DELAY = DATA[ti].d_coalesceDelay;
+
+        if (veryVerbose) { T_() P_(LINE) P_(SIZE) P(DELAY) }
+
+        bsls::Types::Int64 numBytesWritten   = 0;
+        bsls::Types::Int64 numWriteSyscalls  = 0;
+        bsls::Types::Int64 numBytesCoalesced = 0;
+
+        runTest(&numBytesWritten,
+                &numWriteSyscalls,
+                &numBytesCoalesced,
+                SIZE,
+                DELAY,
+                NUM_MESSAGES,
+                MESSAGE_SIZE);
+
+        if (veryVerbose) {
+            T_() P_(numBytesWritten) P_(numWriteSyscalls) P(numBytesCoalesced)
+        }
+
+        LOOP2_ASSERT(LINE, numBytesWritten, TOTAL_SIZE == numBytesWritten);
+        LOOP2_ASSERT(LINE, numWriteSyscalls, 0 < numWriteSyscalls);
+
+        if (MESSAGE_SIZE > SIZE) {
+            LOOP2_ASSERT(LINE, numBytesCoalesced, 0 == numBytesCoalesced);
+        }
+        else if (DELAY > 0.0) {
+            LOOP2_ASSERT(LINE, numBytesCoalesced,
+                         TOTAL_SIZE == numBytesCoalesced);
+            LOOP2_ASSERT(LINE, numWriteSyscalls,
+                         NUM_MESSAGES > numWriteSyscalls);
+        }
+        else {
+            LOOP2_ASSERT(LINE, numBytesCoalesced,
+                         TOTAL_SIZE >= numBytesCoalesced);
+        }
+    }
+
+    if (verbose) cout << "\tTesting the timer of the coalescing delay."
+                      << endl;
+
+    runTimerTest();
+}
+
 void TestDriver::testCase40()
 {
         // --------------------------------------------------------------------
@@ -16540,6 +17271,9 @@ int main(int argc, char **argv)
 
     switch (test) { case 0:  // Zero is always the leading case.
 #define CASE(NUMBER) case NUMBER: TestDriver::testCase##NUMBER(); break
+      CASE(43);
+      CASE(42);
+      CASE(41);
       CASE(38);
       CASE(37);
       CASE(36);
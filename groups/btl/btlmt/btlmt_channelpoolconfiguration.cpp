@@ -128,6 +128,27 @@ const bdlat_AttributeInfo
         sizeof("CollectTimeMetrics") - 1,      // name length
         "",// annotation
         bdlat_FormattingMode::e_DEFAULT
+    },
+    {
+        e_ATTRIBUTE_ID_WRITE_COALESCE_SIZE,
+        "WriteCoalesceSize",                   // name
+        sizeof("WriteCoalesceSize") - 1,       // name length
+        "",// annotation
+        bdlat_FormattingMode::e_DEFAULT
+    },
+    {
+        e_ATTRIBUTE_ID_WRITE_COALESCE_DELAY,
+        "WriteCoalesceDelay",                  // name
+        sizeof("WriteCoalesceDelay") - 1,      // name length
+        "",// annotation
+        bdlat_FormattingMode::e_DEFAULT
+    },
+    {
+        e_ATTRIBUTE_ID_COLLECT_CHANNEL_METRICS,
+        "CollectChannelMetrics",               // name
+        sizeof("CollectChannelMetrics") - 1,   // name length
+        "",// annotation
+        bdlat_FormattingMode::e_DEFAULT
     }
 };
 
@@ -455,9 +476,81 @@ const bdlat_AttributeInfo *ChannelPoolConfiguration::lookupAttributeInfo(
                                                                       // RETURN
             }
           } break;
+          case 'W': {
+            if (bsl::toupper(name[1])=='R'
+             && bsl::toupper(name[2])=='I'
+             && bsl::toupper(name[3])=='T'
+             && bsl::toupper(name[4])=='E'
+             && bsl::toupper(name[5])=='C'
+             && bsl::toupper(name[6])=='O'
+             && bsl::toupper(name[7])=='A'
+             && bsl::toupper(name[8])=='L'
+             && bsl::toupper(name[9])=='E'
+             && bsl::toupper(name[10])=='S'
+             && bsl::toupper(name[11])=='C'
+             && bsl::toupper(name[12])=='E'
+             && bsl::toupper(name[13])=='S'
+             && bsl::toupper(name[14])=='I'
+             && bsl::toupper(name[15])=='Z'
+             && bsl::toupper(name[16])=='E') {
+                return
+                  &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_SIZE];
+                                                                      // RETURN
+            }
+          } break;
         }
       } break;
       case 18: {
+        switch(bsl::toupper(name[0])) {
+          case 'C': {
+            if (bsl::toupper(name[1])=='O'
+             && bsl::toupper(name[2])=='L'
+             && bsl::toupper(name[3])=='L'
+             && bsl::toupper(name[4])=='E'
+             && bsl::toupper(name[5])=='C'
+             && bsl::toupper(name[6])=='T'
+             && bsl::toupper(name[7])=='T'
+             && bsl::toupper(name[8])=='I'
+             && bsl::toupper(name[9])=='M'
+             && bsl::toupper(name[10])=='E'
+             && bsl::toupper(name[11])=='M'
+             && bsl::toupper(name[12])=='E'
+             && bsl::toupper(name[13])=='T'
+             && bsl::toupper(name[14])=='R'
+             && bsl::toupper(name[15])=='I'
+             && bsl::toupper(name[16])=='C'
+             && bsl::toupper(name[17])=='S') {
+                return &ATTRIBUTE_INFO_ARRAY[
+                                       e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS];
+                                                                      // RETURN
+            }
+          } break;
+          case 'W': {
+            if (bsl::toupper(name[1])=='R'
+             && bsl::toupper(name[2])=='I'
+             && bsl::toupper(name[3])=='T'
+             && bsl::toupper(name[4])=='E'
+             && bsl::toupper(name[5])=='C'
+             && bsl::toupper(name[6])=='O'
+             && bsl::toupper(name[7])=='A'
+             && bsl::toupper(name[8])=='L'
+             && bsl::toupper(name[9])=='E'
+             && bsl::toupper(name[10])=='S'
+             && bsl::toupper(name[11])=='C'
+             && bsl::toupper(name[12])=='E'
+             && bsl::toupper(name[13])=='D'
+             && bsl::toupper(name[14])=='E'
+             && bsl::toupper(name[15])=='L'
+             && bsl::toupper(name[16])=='A'
+             && bsl::toupper(name[17])=='Y') {
+                return
+                 &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_DELAY];
+                                                                      // RETURN
+            }
+          } break;
+        }
+      } break;
+      case 21: {
         if (bsl::toupper(name[0])=='C'
          && bsl::toupper(name[1])=='O'
          && bsl::toupper(name[2])=='L'
@@ -465,19 +558,22 @@ const bdlat_AttributeInfo *ChannelPoolConfiguration::lookupAttributeInfo(
          && bsl::toupper(name[4])=='E'
          && bsl::toupper(name[5])=='C'
          && bsl::toupper(name[6])=='T'
-         && bsl::toupper(name[7])=='T'
-         && bsl::toupper(name[8])=='I'
-         && bsl::toupper(name[9])=='M'
-         && bsl::toupper(name[10])=='E'
-         && bsl::toupper(name[11])=='M'
+         && bsl::toupper(name[7])=='C'
+         && bsl::toupper(name[8])=='H'
+         && bsl::toupper(name[9])=='A'
+         && bsl::toupper(name[10])=='N'
+         && bsl::toupper(name[11])=='N'
          && bsl::toupper(name[12])=='E'
-         && bsl::toupper(name[13])=='T'
-         && bsl::toupper(name[14])=='R'
-         && bsl::toupper(name[15])=='I'
-         && bsl::toupper(name[16])=='C'
-         && bsl::toupper(name[17])=='S') {
+         && bsl::toupper(name[13])=='L'
+         && bsl::toupper(name[14])=='M'
+         && bsl::toupper(name[15])=='E'
+         && bsl::toupper(name[16])=='T'
+         && bsl::toupper(name[17])=='R'
+         && bsl::toupper(name[18])=='I'
+         && bsl::toupper(name[19])=='C'
+         && bsl::toupper(name[20])=='S') {
             return &ATTRIBUTE_INFO_ARRAY[
-                                       e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS];
+                                    e_ATTRIBUTE_INDEX_COLLECT_CHANNEL_METRICS];
                                                                       // RETURN
         }
       } break;
@@ -543,6 +639,19 @@ ChannelPoolConfiguration::lookupAttributeInfo(int id)
         return &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS];
                                                                       // RETURN
       }
+      case e_ATTRIBUTE_ID_WRITE_COALESCE_SIZE: {
+        return &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_SIZE];
+                                                                      // RETURN
+      }
+      case e_ATTRIBUTE_ID_WRITE_COALESCE_DELAY: {
+        return &ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_DELAY];
+                                                                      // RETURN
+      }
+      case e_ATTRIBUTE_ID_COLLECT_CHANNEL_METRICS: {
+        return &ATTRIBUTE_INFO_ARRAY[
+                                    e_ATTRIBUTE_INDEX_COLLECT_CHANNEL_METRICS];
+                                                                      // RETURN
+      }
 
       default:
         return 0;                                                     // RETURN
@@ -565,6 +674,9 @@ ChannelPoolConfiguration::ChannelPoolConfiguration()
 , d_maxMessageSizeIn(1024)
 , d_threadStackSize(k_DEFAULT_THREAD_STACK_SIZE)
 , d_collectTimeMetrics(true)
+, d_writeCoalesceSize(0)
+, d_writeCoalesceDelay(0)
+, d_collectChannelMetrics(false)
 {
 }
 
@@ -584,6 +696,9 @@ ChannelPoolConfiguration::ChannelPoolConfiguration(
 , d_maxMessageSizeIn(original.d_maxMessageSizeIn)
 , d_threadStackSize(original.d_threadStackSize)
 , d_collectTimeMetrics(original.d_collectTimeMetrics)
+, d_writeCoalesceSize(original.d_writeCoalesceSize)
+, d_writeCoalesceDelay(original.d_writeCoalesceDelay)
+, d_collectChannelMetrics(original.d_collectChannelMetrics)
 {
 }
 
@@ -602,6 +717,8 @@ ChannelPoolConfiguration::~ChannelPoolConfiguration()
              && d_minMessageSizeIn <= d_typMessageSizeIn
              && d_typMessageSizeIn <= d_maxMessageSizeIn);
     BSLS_ASSERT(0 <= d_threadStackSize);
+    BSLS_ASSERT(0 <= d_writeCoalesceSize);
+    BSLS_ASSERT(0 <= d_writeCoalesceDelay);
 }
 
 // MANIPULATORS
@@ -623,6 +740,9 @@ ChannelPoolConfiguration::operator=(const ChannelPoolConfiguration& rhs)
         d_maxMessageSizeIn   = rhs.d_maxMessageSizeIn;
         d_threadStackSize    = rhs.d_threadStackSize;
         d_collectTimeMetrics = rhs.d_collectTimeMetrics;
+        d_writeCoalesceSize  = rhs.d_writeCoalesceSize;
+        d_writeCoalesceDelay = rhs.d_writeCoalesceDelay;
+        d_collectChannelMetrics = rhs.d_collectChannelMetrics;
     }
     return *this;
 }
@@ -646,7 +766,10 @@ bool btlmt::operator==(const ChannelPoolConfiguration& lhs,
         && lhs.d_typMessageSizeIn   == rhs.d_typMessageSizeIn
         && lhs.d_maxMessageSizeIn   == rhs.d_maxMessageSizeIn
         && lhs.d_threadStackSize    == rhs.d_threadStackSize
-        && lhs.d_collectTimeMetrics == rhs.d_collectTimeMetrics;
+        && lhs.d_collectTimeMetrics == rhs.d_collectTimeMetrics
+        && lhs.d_writeCoalesceSize  == rhs.d_writeCoalesceSize
+        && lhs.d_writeCoalesceDelay == rhs.d_writeCoalesceDelay
+        && lhs.d_collectChannelMetrics == rhs.d_collectChannelMetrics;
 }
 
 bsl::ostream& btlmt::operator<<(bsl::ostream&                   output,
@@ -669,6 +792,11 @@ bsl::ostream& btlmt::operator<<(bsl::ostream&                   output,
            << "\tmaxIncomingMessageSize : " << config.d_maxMessageSizeIn <<"\n"
            << "\tthreadStackSize        : " << config.d_threadStackSize  <<"\n"
            << "\tcollectTimeMetrics     : " << config.d_collectTimeMetrics
+                                                                         <<"\n"
+           << "\twriteCoalesceSize      : " << config.d_writeCoalesceSize<<"\n"
+           << "\twriteCoalesceDelay     : " << config.d_writeCoalesceDelay
+                                                                         <<"\n"
+           << "\tcollectChannelMetrics  : " << config.d_collectChannelMetrics
            << "\n]\n";
 
     return output;
@@ -85,6 +85,32 @@ BSLS_IDENT("$Id: $")
 //                               processing data, and if this value
 //                               is 'false', those metrics will not
 //                               be collected.
+//
+//   int     writeCoalesceSize   maximum size (in bytes) of an                0
+//                               outgoing message that is copied
+//                               into a per-channel staging buffer
+//                               rather than enqueued by reference,
+//                               so that consecutive small messages
+//                               are written with fewer system
+//                               calls.  If this value is 0, write
+//                               coalescing is disabled.
+//
+//   double  writeCoalesceDelay  maximum delay (in seconds) for which         0
+//                               a small message written to a channel
+//                               having an empty write queue may be
+//                               held in the staging buffer, so that
+//                               it can be batched with subsequent
+//                               small messages.  If this value is 0,
+//                               such messages are written
+//                               immediately.
+//
+//   bool    collectChannel-     indicates whether the configured         false
+//           Metrics             channel pool will collect per-channel
+//                               latency and syscall statistics (see
+//                               'btlmt::ChannelPool::
+//                               getChannelMetrics').  If this value
+//                               is 'false', no timestamp is taken on
+//                               the read and write paths.
 //..
 // The constraints are as follows:
 //..
@@ -111,8 +137,35 @@ BSLS_IDENT("$Id: $")
 //   +--------------------+---------------------------------------------+
 //   | threadStackSize    | 0 <= threadStackSize                        |
 //   +--------------------+---------------------------------------------+
+//   | writeCoalesceSize  | 0 <= writeCoalesceSize                      |
+//   +--------------------+---------------------------------------------+
+//   | writeCoalesceDelay | 0 <= writeCoalesceDelay                     |
+//   +--------------------+---------------------------------------------+
 //..
 //
+///Write Coalescing
+///----------------
+// Applications that write many small messages (e.g., a few hundred bytes or
+// less) to a channel pay for one 'iovec' entry per blob buffer, and quickly
+// exhaust the maximum number of buffers that can be passed to a single
+// 'writev' system call.  When 'writeCoalesceSize' is positive, a message whose
+// length does not exceed 'writeCoalesceSize' and that cannot be written
+// immediately is *copied* into a staging buffer owned by the channel (instead
+// of sharing the buffers of the message), and subsequent small messages are
+// appended to the same staging buffer until it is full.  Messages larger than
+// 'writeCoalesceSize' are still enqueued without copying.
+//
+// In addition, when 'writeCoalesceDelay' is positive, a small message written
+// to a channel whose write queue is empty is not written right away; instead
+// it is held in the staging buffer for at most 'writeCoalesceDelay' seconds
+// (similar to Nagle's algorithm), or until either the staging buffer fills up
+// or a message larger than 'writeCoalesceSize' is written, whichever happens
+// first.  This trades a bounded amount of latency for fewer, larger writes.
+// Channel pools report the number of 'writev' system calls issued for each
+// channel (see 'btlmt::ChannelPool::getChannelWriteCoalescingStatistics'),
+// which can be used to monitor the average number of bytes written per system
+// call.
+//
 ///Thread Safety
 ///-------------
 // This constrained-attribute component is *thread-safe* but not
@@ -167,6 +220,12 @@ BSLS_IDENT("$Id: $")
 //
 //  assert(0    == cpc.setThreadStackSize(1024));
 //  assert(1024 == cpc.threadStackSize());
+//
+//  assert(0   == cpc.setWriteCoalesceSize(256));
+//  assert(256 == cpc.writeCoalesceSize());
+//
+//  assert(0     == cpc.setWriteCoalesceDelay(0.001));
+//  assert(0.001 == cpc.writeCoalesceDelay());
 //..
 // The configuration object is now validly configured with our choice of
 // parameters.  If, however, we attempt to set an invalid configuration, the
@@ -199,6 +258,9 @@ BSLS_IDENT("$Id: $")
 //         maxIncomingMessageSize : 3
 //         threadStackSize        : 1024
 //         collectTimeMetrics     : 1
+//         writeCoalesceSize      : 256
+//         writeCoalesceDelay     : 0.001
+//         collectChannelMetrics  : 0
 // ]
 //..
 
@@ -308,6 +370,18 @@ class ChannelPoolConfiguration {
 
     bool                  d_collectTimeMetrics;
 
+    // Write coalescing
+    int                   d_writeCoalesceSize; // maximum size of a message
+                                               // copied into a staging buffer
+
+    double                d_writeCoalesceDelay;
+                                               // maximum delay before a
+                                               // staged message is written
+
+    bool                  d_collectChannelMetrics;
+                                               // whether to collect
+                                               // per-channel statistics
+
     friend bsl::ostream& operator<<(bsl::ostream&,
                                     const ChannelPoolConfiguration&);
 
@@ -317,7 +391,7 @@ class ChannelPoolConfiguration {
   public:
     // TYPES
     enum {
-        k_NUM_ATTRIBUTES = 14 // the number of attributes in this class
+        k_NUM_ATTRIBUTES = 17 // the number of attributes in this class
 
 
     };
@@ -362,9 +436,18 @@ class ChannelPoolConfiguration {
         e_ATTRIBUTE_INDEX_THREAD_STACK_SIZE    = 12,
             // index for 'ThreadStackSize' attribute
 
-        e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS = 13
+        e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS = 13,
             // index for 'CollectTimeMetrics' attribute
 
+        e_ATTRIBUTE_INDEX_WRITE_COALESCE_SIZE  = 14,
+            // index for 'WriteCoalesceSize' attribute
+
+        e_ATTRIBUTE_INDEX_WRITE_COALESCE_DELAY = 15,
+            // index for 'WriteCoalesceDelay' attribute
+
+        e_ATTRIBUTE_INDEX_COLLECT_CHANNEL_METRICS = 16
+            // index for 'CollectChannelMetrics' attribute
+
 
     };
 
@@ -408,9 +491,18 @@ class ChannelPoolConfiguration {
         e_ATTRIBUTE_ID_THREAD_STACK_SIZE       = 13,
             // id for 'ThreadStackSize' attribute
 
-        e_ATTRIBUTE_ID_COLLECT_TIME_METRICS    = 14
+        e_ATTRIBUTE_ID_COLLECT_TIME_METRICS    = 14,
             // id for 'CollectTimeMetrics' attribute
 
+        e_ATTRIBUTE_ID_WRITE_COALESCE_SIZE     = 15,
+            // id for 'WriteCoalesceSize' attribute
+
+        e_ATTRIBUTE_ID_WRITE_COALESCE_DELAY    = 16,
+            // id for 'WriteCoalesceDelay' attribute
+
+        e_ATTRIBUTE_ID_COLLECT_CHANNEL_METRICS = 17
+            // id for 'CollectChannelMetrics' attribute
+
 
     };
 
@@ -516,6 +608,28 @@ class ChannelPoolConfiguration {
         // estimate of work-load when it attempts to distribute work amongst
         // its managed threads.
 
+    int setWriteCoalesceSize(int numBytes);
+        // Set the write coalescing size attribute of this object to the
+        // specified 'numBytes' if '0 <= numBytes'.  Return 0 on success, and a
+        // non-zero value (with no effect on the state of this object)
+        // otherwise.  Outgoing messages of at most 'numBytes' bytes are copied
+        // into a per-channel staging buffer rather than enqueued by reference.
+        // A value of 0 disables write coalescing.
+
+    int setWriteCoalesceDelay(double maxDelay);
+        // Set the write coalescing delay attribute of this object to the
+        // specified 'maxDelay' value (in seconds) if '0 <= maxDelay'.  Return
+        // 0 on success, and a non-zero value (with no effect on the state of
+        // this object) otherwise.  A value of 0 indicates that small messages
+        // written to a channel having an empty write queue are not delayed.
+        // Note that this attribute has no effect unless the write coalescing
+        // size attribute is positive.
+
+    int setCollectChannelMetrics(bool collectChannelMetricsFlag);
+        // Set to the specified 'collectChannelMetricsFlag' whether the
+        // configured channel pool will collect per-channel latency and
+        // system call statistics.  Return 0.
+
     template<class MANIPULATOR>
     int manipulateAttributes(MANIPULATOR& manipulator);
         // Invoke the specified 'manipulator' sequentially on the address of
@@ -594,6 +708,19 @@ class ChannelPoolConfiguration {
     int threadStackSize() const;
         // Return the thread stack size attribute of this object.
 
+    int writeCoalesceSize() const;
+        // Return the write coalescing size attribute of this object.  A value
+        // of 0 indicates that write coalescing is disabled.
+
+    const double& writeCoalesceDelay() const;
+        // Return the write coalescing delay attribute of this object.  A value
+        // of 0 indicates that small messages are never delayed.
+
+    bool collectChannelMetrics() const;
+        // Return 'true' if the configured channel pool will collect
+        // per-channel latency and system call statistics, and 'false'
+        // otherwise.
+
     bsl::ostream& streamOut(bsl::ostream& stream) const;
         // Write the specified 'configuration' value to the specified 'output'
         // stream in a reasonable multi-line format.
@@ -755,6 +882,34 @@ int ChannelPoolConfiguration::setCollectTimeMetrics(
     return 0;
 }
 
+inline
+int ChannelPoolConfiguration::setWriteCoalesceSize(int numBytes)
+{
+    if (0 <= numBytes) {
+        d_writeCoalesceSize = numBytes;
+        return 0;                                                     // RETURN
+    }
+    return -1;
+}
+
+inline
+int ChannelPoolConfiguration::setWriteCoalesceDelay(double maxDelay)
+{
+    if (0 <= maxDelay) {
+        d_writeCoalesceDelay = maxDelay;
+        return 0;                                                     // RETURN
+    }
+    return -1;
+}
+
+inline
+int ChannelPoolConfiguration::setCollectChannelMetrics(
+                                                bool collectChannelMetricsFlag)
+{
+    d_collectChannelMetrics = collectChannelMetricsFlag;
+    return 0;
+}
+
 template <class MANIPULATOR>
 int ChannelPoolConfiguration::manipulateAttributes(MANIPULATOR& manipulator)
 {
@@ -855,6 +1010,27 @@ int ChannelPoolConfiguration::manipulateAttributes(MANIPULATOR& manipulator)
         return ret;                                                   // RETURN
     }
 
+    ret = manipulator(
+                  &d_writeCoalesceSize,
+                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_SIZE]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
+    ret = manipulator(
+                 &d_writeCoalesceDelay,
+                 ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_DELAY]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
+    ret = manipulator(
+              &d_collectChannelMetrics,
+              ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COLLECT_CHANNEL_METRICS]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
     return ret;
 }
 
@@ -949,6 +1125,24 @@ int ChannelPoolConfiguration::manipulateAttribute(MANIPULATOR& manipulator,
                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS]);
                                                                       // RETURN
       } break;
+      case e_ATTRIBUTE_ID_WRITE_COALESCE_SIZE: {
+        return manipulator(
+                  &d_writeCoalesceSize,
+                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_SIZE]);
+                                                                      // RETURN
+      } break;
+      case e_ATTRIBUTE_ID_WRITE_COALESCE_DELAY: {
+        return manipulator(
+                 &d_writeCoalesceDelay,
+                 ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_DELAY]);
+                                                                      // RETURN
+      } break;
+      case e_ATTRIBUTE_ID_COLLECT_CHANNEL_METRICS: {
+        return manipulator(
+              &d_collectChannelMetrics,
+              ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COLLECT_CHANNEL_METRICS]);
+                                                                      // RETURN
+      } break;
 
       default:
         return k_NOT_FOUND;                                           // RETURN
@@ -1059,6 +1253,21 @@ bool ChannelPoolConfiguration::collectTimeMetrics() const {
     return d_collectTimeMetrics;
 }
 
+inline
+int ChannelPoolConfiguration::writeCoalesceSize() const {
+    return d_writeCoalesceSize;
+}
+
+inline
+const double& ChannelPoolConfiguration::writeCoalesceDelay() const {
+    return d_writeCoalesceDelay;
+}
+
+inline
+bool ChannelPoolConfiguration::collectChannelMetrics() const {
+    return d_collectChannelMetrics;
+}
+
 template <class ACCESSOR>
 int ChannelPoolConfiguration::accessAttributes(ACCESSOR& accessor) const
 {
@@ -1157,6 +1366,27 @@ int ChannelPoolConfiguration::accessAttributes(ACCESSOR& accessor) const
         return ret;                                                   // RETURN
     }
 
+    ret = accessor(
+                  d_writeCoalesceSize,
+                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_SIZE]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
+    ret = accessor(
+                 d_writeCoalesceDelay,
+                 ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_DELAY]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
+    ret = accessor(
+              d_collectChannelMetrics,
+              ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COLLECT_CHANNEL_METRICS]);
+    if (ret) {
+        return ret;                                                   // RETURN
+    }
+
     return ret;
 }
 
@@ -1249,6 +1479,24 @@ ChannelPoolConfiguration::accessAttribute(ACCESSOR& accessor, int id) const
                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COLLECT_TIME_METRICS]);
                                                                       // RETURN
       } break;
+      case e_ATTRIBUTE_ID_WRITE_COALESCE_SIZE: {
+        return accessor(
+                  d_writeCoalesceSize,
+                  ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_SIZE]);
+                                                                      // RETURN
+      } break;
+      case e_ATTRIBUTE_ID_WRITE_COALESCE_DELAY: {
+        return accessor(
+                 d_writeCoalesceDelay,
+                 ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_WRITE_COALESCE_DELAY]);
+                                                                      // RETURN
+      } break;
+      case e_ATTRIBUTE_ID_COLLECT_CHANNEL_METRICS: {
+        return accessor(
+              d_collectChannelMetrics,
+              ATTRIBUTE_INFO_ARRAY[e_ATTRIBUTE_INDEX_COLLECT_CHANNEL_METRICS]);
+                                                                      // RETURN
+      } break;
 
       default:
         return k_NOT_FOUND;                                           // RETURN
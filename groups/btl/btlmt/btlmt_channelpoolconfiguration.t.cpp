@@ -41,6 +41,9 @@ using namespace bsl;  // automatically added by script
 // [ 2] int setMaxThreads(int maxThreads);
 // [ 2] int setMetricsInterval(double metricsInterval);
 // [ 2] int setReadTimeout(double readTimeout);
+// [ 2] int setWriteCoalesceSize(int numBytes);
+// [ 2] int setWriteCoalesceDelay(double maxDelay);
+// [ 3] int setCollectChannelMetrics(bool collectChannelMetricsFlag);
 // [ 1] int minIncomingMessageSize() const;
 // [ 1] int typicalIncomingMessageSize() const;
 // [ 1] int maxIncomingMessageSize() const;
@@ -51,6 +54,9 @@ using namespace bsl;  // automatically added by script
 // [ 1] int maxThreads() const;
 // [ 1] double metricsInterval() const;
 // [ 1] double readTimeout() const;
+// [ 1] int writeCoalesceSize() const;
+// [ 1] const double& writeCoalesceDelay() const;
+// [ 1] bool collectChannelMetrics() const;
 //
 // [ 1] bool operator==(const btlmt::ChannelPoolConfiguration& lhs, ...
 // [ 1] bool operator!=(const btlmt::ChannelPoolConfiguration& lhs, ...
@@ -142,6 +148,12 @@ const int THREADSTACKSIZE[NUM_VALUES]  = { 1048576, 512, 600, 700, 800, 900,
                                                                          999 };
 const bool COLLECTMETRICS[NUM_VALUES] =
                                      { true, false, true, false, true, false };
+const int COALESCESIZE[NUM_VALUES]     = { 0,   40,  64,  128, 200, 256,
+                                                                        1024 };
+const TI  COALESCEDELAY[NUM_VALUES]    = { 0.0, 0.001, 0.002, 0.005, 0.01,
+                                                                  0.05, 0.1 };
+const bool CHANNELMETRICS[NUM_VALUES] =
+                              { false, true, false, true, false, true, false };
 
 //=============================================================================
 //                             HELPER CLASSES
@@ -323,6 +335,12 @@ int main(int argc, char *argv[])
         ASSERT(0 == cpc.setThreadStackSize(1024));
         ASSERT(1024 == cpc.threadStackSize());
 
+        ASSERT(0 == cpc.setWriteCoalesceSize(256));
+        ASSERT(256 == cpc.writeCoalesceSize());
+
+        ASSERT(0 == cpc.setWriteCoalesceDelay(0.001));
+        ASSERT(0.001 == cpc.writeCoalesceDelay());
+
         ASSERT(0 != cpc.setIncomingMessageSizes(8, 4, 256));
         ASSERT(1 == cpc.minIncomingMessageSize());
         ASSERT(2 == cpc.typicalIncomingMessageSize());
@@ -348,6 +366,9 @@ int main(int argc, char *argv[])
                 "\tmaxIncomingMessageSize : 3" NL
                 "\tthreadStackSize        : 1024" NL
                 "\tcollectTimeMetrics     : 1" NL
+                "\twriteCoalesceSize      : 256" NL
+                "\twriteCoalesceDelay     : 0.001" NL
+                "\tcollectChannelMetrics  : 0" NL
                 "]" NL
                 ;
             ASSERT(os.str().c_str() == s);
@@ -380,7 +401,7 @@ int main(int argc, char *argv[])
                           << "\n==========================" << endl;
 
         enum {
-            NUM_ATTRIBUTES = 14
+            NUM_ATTRIBUTES = 17
         };
 
         ASSERT(NUM_ATTRIBUTES == Obj::k_NUM_ATTRIBUTES);
@@ -390,7 +411,8 @@ int main(int argc, char *argv[])
         "MinMessageSizeOut", "TypMessageSizeOut", "MaxMessageSizeOut",
         "MinMessageSizeIn", "TypMessageSizeIn", "MaxMessageSizeIn",
         "WriteQueueLowWater", "WriteQueueHighWater", "ThreadStackSize",
-        "CollectTimeMetrics"
+        "CollectTimeMetrics", "WriteCoalesceSize", "WriteCoalesceDelay",
+        "CollectChannelMetrics"
         };
 
         const int NUM_NAMES = sizeof NAMES / sizeof *NAMES;
@@ -564,13 +586,38 @@ int main(int argc, char *argv[])
                                                                     visitor,
                                                                     j + 1));
                   } break;
+                  case 14: {
+                    ASSERT(0 == mA.setWriteCoalesceSize(COALESCESIZE[i]));
+                    AssignValue<int> visitor(COALESCESIZE[i]);
+                    LOOP2_ASSERT(i, j, 0 ==
+                       bdlat_SequenceFunctions::manipulateAttribute(&mB,
+                                                                    visitor,
+                                                                    j + 1));
+                  } break;
+                  case 15: {
+                    ASSERT(0 == mA.setWriteCoalesceDelay(COALESCEDELAY[i]));
+                    AssignValue<double> visitor(COALESCEDELAY[i]);
+                    LOOP2_ASSERT(i, j, 0 ==
+                       bdlat_SequenceFunctions::manipulateAttribute(&mB,
+                                                                    visitor,
+                                                                    j + 1));
+                  } break;
+                  case 16: {
+                    ASSERT(0 ==
+                             mA.setCollectChannelMetrics(CHANNELMETRICS[i]));
+                    AssignValue<bool> visitor(CHANNELMETRICS[i]);
+                    LOOP2_ASSERT(i, j, 0 ==
+                       bdlat_SequenceFunctions::manipulateAttribute(&mB,
+                                                                    visitor,
+                                                                    j + 1));
+                  } break;
 
                   default:
                     ASSERT(0);
                 }
                 LOOP2_ASSERT(i, j, mA == mB);
 
-                if (j == 2 || j == 3) {
+                if (j == 2 || j == 3 || j == 15) {
                     double value;
                     GetValue<double> gvisitor(&value);
                     ASSERT(0 ==
@@ -582,7 +629,7 @@ int main(int argc, char *argv[])
                                                                   avisitor,
                                                                   j + 1));
                 }
-                else if (j == 13) {
+                else if (j == 13 || j == 16) {
                     bool value;
                     GetValue<bool> gvisitor(&value);
                     ASSERT(0 ==
@@ -731,6 +778,24 @@ int main(int argc, char *argv[])
             ASSERT(1 == X1.typicalOutgoingMessageSize());
             ASSERT(2 == X1.maxOutgoingMessageSize());
         }
+        if (verbose) cout << "\t Check writeCoalesceSize contraint. " << endl;
+        {
+            ASSERT(0 != mX1.setWriteCoalesceSize(-1));
+            ASSERT(COALESCESIZE[0] == X1.writeCoalesceSize());
+            ASSERT(0 == mX1.setWriteCoalesceSize(0));
+            ASSERT(0 == X1.writeCoalesceSize());
+            ASSERT(0 == mX1.setWriteCoalesceSize(1));
+            ASSERT(1 == X1.writeCoalesceSize());
+        }
+        if (verbose) cout << "\t Check writeCoalesceDelay contraint. " << endl;
+        {
+            ASSERT(0 != mX1.setWriteCoalesceDelay(-0.1));
+            ASSERT(COALESCEDELAY[0] == X1.writeCoalesceDelay());
+            ASSERT(0 == mX1.setWriteCoalesceDelay(0.0));
+            ASSERT(0.0 == X1.writeCoalesceDelay());
+            ASSERT(0 == mX1.setWriteCoalesceDelay(0.1));
+            ASSERT(0.1 == X1.writeCoalesceDelay());
+        }
       } break;
       case 1: {
         // --------------------------------------------------------------------
@@ -769,6 +834,9 @@ int main(int argc, char *argv[])
         ASSERT(      READTIMEOUT[0] == X1.readTimeout());
         ASSERT(  THREADSTACKSIZE[0] == X1.threadStackSize());
         ASSERT(   COLLECTMETRICS[0] == X1.collectTimeMetrics());
+        ASSERT(     COALESCESIZE[0] == X1.writeCoalesceSize());
+        ASSERT(    COALESCEDELAY[0] == X1.writeCoalesceDelay());
+        ASSERT(   CHANNELMETRICS[0] == X1.collectChannelMetrics());
         ASSERT(1 == (X1 == X1));          ASSERT(0 == (X1 != X1));
         ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
         ASSERT(1 == (Z1 == Y1));          ASSERT(0 == (Z1 != Y1));
@@ -1136,6 +1204,74 @@ int main(int argc, char *argv[])
 
         // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+        if (verbose) cout << "\t Change attribute 8." << endl;
+
+        ASSERT(0 == mX1.setWriteCoalesceSize(COALESCESIZE[1]));
+        ASSERT(0 == mX1.setWriteCoalesceDelay(COALESCEDELAY[1]));
+        ASSERT(   MAXCONNECTIONS[0] == X1.maxConnections());
+        ASSERT(    MAXNUMTHREADS[0] == X1.maxThreads());
+        ASSERT(  THREADSTACKSIZE[0] == X1.threadStackSize());
+        ASSERT(   COLLECTMETRICS[0] == X1.collectTimeMetrics());
+        ASSERT(     COALESCESIZE[1] == X1.writeCoalesceSize());
+        ASSERT(    COALESCEDELAY[1] == X1.writeCoalesceDelay());
+
+        ASSERT(1 == (X1 == X1));          ASSERT(0 == (X1 != X1));
+        ASSERT(0 == (X1 == Z1));          ASSERT(1 == (X1 != Z1));
+        ASSERT(0 == (Z1 == X1));          ASSERT(1 == (Z1 != X1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+        {
+            Obj C(X1);
+            ASSERT(C == X1 == 1);          ASSERT(C != X1 == 0);
+        }
+
+        mY1 = X1;
+        ASSERT(1 == (Y1 == Y1));          ASSERT(0 == (Y1 != Y1));
+        ASSERT(1 == (Y1 == X1));          ASSERT(0 == (Y1 != X1));
+        ASSERT(0 == (Y1 == Z1));          ASSERT(1 == (Y1 != Z1));
+
+        ASSERT(0 == mX1.setWriteCoalesceSize(COALESCESIZE[0]));
+        ASSERT(0 == (X1 == Z1));          ASSERT(1 == (X1 != Z1));
+        ASSERT(0 == mX1.setWriteCoalesceDelay(COALESCEDELAY[0]));
+        ASSERT(1 == (X1 == X1));          ASSERT(0 == (X1 != X1));
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+        ASSERT(0 == (Y1 == Z1));          ASSERT(1 == (Y1 != Z1));
+
+        mX1 = mY1 = Z1;
+        ASSERT(1 == (X1 == X1));          ASSERT(0 == (X1 != X1));
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+        if (verbose) cout << "\t Change attribute 9." << endl;
+
+        ASSERT(0 == mX1.setCollectChannelMetrics(CHANNELMETRICS[1]));
+        ASSERT(   COLLECTMETRICS[0] == X1.collectTimeMetrics());
+        ASSERT(     COALESCESIZE[0] == X1.writeCoalesceSize());
+        ASSERT(   CHANNELMETRICS[1] == X1.collectChannelMetrics());
+
+        ASSERT(1 == (X1 == X1));          ASSERT(0 == (X1 != X1));
+        ASSERT(0 == (X1 == Z1));          ASSERT(1 == (X1 != Z1));
+        ASSERT(0 == (Z1 == X1));          ASSERT(1 == (Z1 != X1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+        {
+            Obj C(X1);
+            ASSERT(C == X1 == 1);          ASSERT(C != X1 == 0);
+        }
+
+        mY1 = X1;
+        ASSERT(1 == (Y1 == X1));          ASSERT(0 == (Y1 != X1));
+        ASSERT(0 == (Y1 == Z1));          ASSERT(1 == (Y1 != Z1));
+
+        ASSERT(0 == mX1.setCollectChannelMetrics(CHANNELMETRICS[0]));
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+
+        mX1 = mY1 = Z1;
+        ASSERT(1 == (X1 == Z1));          ASSERT(0 == (X1 != Z1));
+        ASSERT(1 == (Y1 == Z1));          ASSERT(0 == (Y1 != Z1));
+
+        // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
         if (verbose) cout << "Testing output operator (<<)." << endl;
 
         ASSERT(0 == mY1.setIncomingMessageSizes(MINMESSAGESIZEIN[1],
@@ -1173,6 +1309,9 @@ int main(int argc, char *argv[])
                 "\tmaxIncomingMessageSize : 1024" NL
                 "\tthreadStackSize        : 1048576" NL
                 "\tcollectTimeMetrics     : 1" NL
+                "\twriteCoalesceSize      : 0" NL
+                "\twriteCoalesceDelay     : 0" NL
+                "\tcollectChannelMetrics  : 0" NL
                 "]" NL
                 ;
             ASSERT(buf == s);
@@ -1198,6 +1337,9 @@ int main(int argc, char *argv[])
                 "\tmaxIncomingMessageSize : 17" NL
                 "\tthreadStackSize        : 512" NL
                 "\tcollectTimeMetrics     : 1" NL
+                "\twriteCoalesceSize      : 0" NL
+                "\twriteCoalesceDelay     : 0" NL
+                "\tcollectChannelMetrics  : 0" NL
                 "]" NL
                 ;
             ASSERT(buf == s);
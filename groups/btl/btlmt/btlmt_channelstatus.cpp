@@ -51,6 +51,7 @@ const char *ChannelStatus::toAscii(ChannelStatus::Enum value)
       CASE(WRITE_CHANNEL_DOWN)
       CASE(ENQUEUE_HIGHWATER)
       CASE(UNKNOWN_ID)
+      CASE(WRITE_THROTTLED)
       default: return "(* UNKNOWN *)";
     }
 
@@ -56,6 +56,10 @@ BSLS_IDENT("$Id: $")
 //
 //  e_UNKNOWN_ID              The write request failed because the channel
 //                            identified by an specified id does not exist.
+//
+//  e_WRITE_THROTTLED         The write request failed because writing the
+//                            message would exceed the rate limit configured
+//                            for outgoing data.
 //..
 //
 ///Usage
@@ -175,10 +179,15 @@ struct ChannelStatus {
                                     // write-queue size limit provided as a
                                     // function argument.
 
-        e_UNKNOWN_ID         = -5   // The write request failed because the
+        e_UNKNOWN_ID         = -5,  // The write request failed because the
                                     // channel identified by a specified
                                     // id does not exist.
 
+        e_WRITE_THROTTLED    = -7   // The write request failed because
+                                    // writing the message would exceed the
+                                    // rate limit configured for outgoing
+                                    // data.
+
     };
 
   public:
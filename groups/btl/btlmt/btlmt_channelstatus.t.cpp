@@ -308,6 +308,7 @@ int main(int argc, char *argv[])
         { L_,   0,  4, Obj::e_WRITE_CHANNEL_DOWN, "WRITE_CHANNEL_DOWN" NL},
         { L_,   0,  4, Obj::e_ENQUEUE_HIGHWATER,  "ENQUEUE_HIGHWATER" NL },
         { L_,   0,  4, Obj::e_UNKNOWN_ID,         "UNKNOWN_ID" NL        },
+        { L_,   0,  4, Obj::e_WRITE_THROTTLED,    "WRITE_THROTTLED" NL   },
         { L_,   0,  4, (Obj::Enum) 1,                 UNKNOWN_FORMAT NL      },
 
         { L_,   0,  0, Obj::e_SUCCESS,            "SUCCESS" NL           },
@@ -465,6 +466,7 @@ int main(int argc, char *argv[])
             { L_,   Obj::e_WRITE_CHANNEL_DOWN,  "WRITE_CHANNEL_DOWN" },
             { L_,   Obj::e_ENQUEUE_HIGHWATER,   "ENQUEUE_HIGHWATER"  },
             { L_,   Obj::e_UNKNOWN_ID,          "UNKNOWN_ID"         },
+            { L_,   Obj::e_WRITE_THROTTLED,     "WRITE_THROTTLED"    },
 
             { L_,   (Obj::Enum) 1,                  UNKNOWN_FORMAT       },
         };
@@ -608,6 +610,7 @@ int main(int argc, char *argv[])
          { L_,   Obj::e_WRITE_CHANNEL_DOWN,    -3,  "WRITE_CHANNEL_DOWN" },
          { L_,   Obj::e_ENQUEUE_HIGHWATER,     -4,  "ENQUEUE_HIGHWATER"  },
          { L_,   Obj::e_UNKNOWN_ID,            -5,  "UNKNOWN_ID"         },
+         { L_,   Obj::e_WRITE_THROTTLED,       -7,  "WRITE_THROTTLED"    },
         };
         const int NUM_DATA = sizeof DATA / sizeof *DATA;
 
@@ -0,0 +1,224 @@
+// btls_concurrentratelimiter.cpp                                     -*-C++-*-
+#include <btls_concurrentratelimiter.h>
+
+#include <bsls_ident.h>
+BSLS_IDENT_RCSID(btls_concurrentratelimiter_cpp,"$Id$ $CSID$")
+
+#include <btls_leakybucket.h>
+
+#include <bsls_assert.h>
+
+#include <bsl_c_limits.h>
+
+namespace BloombergLP {
+namespace {
+
+const bsls::Types::Int64 k_NANOSECONDS_PER_SECOND = 1000000000LL;
+
+// The cost of a single request is capped so that adding it to any
+// theoretical arrival time derived from a valid 'bsls::TimeInterval' (whose
+// total nanoseconds lie in roughly +/- 2^63) cannot overflow in practice:
+// 2^62 nanoseconds is more than 146 years.
+
+const bsls::Types::Int64 k_MAX_COST = 1LL << 62;
+
+}  // close unnamed namespace
+
+namespace btls {
+
+                        // ---------------------------
+                        // class ConcurrentRateLimiter
+                        // ---------------------------
+
+// PRIVATE ACCESSORS
+bsls::Types::Int64
+ConcurrentRateLimiter::costOf(bsls::Types::Uint64 numUnits) const
+{
+    const double cost = static_cast<double>(numUnits) * d_nanosecondsPerUnit;
+
+    return cost >= static_cast<double>(k_MAX_COST)
+           ? k_MAX_COST
+           : static_cast<bsls::Types::Int64>(cost + 0.5);
+}
+
+// CREATORS
+ConcurrentRateLimiter::ConcurrentRateLimiter(
+                                         bsls::Types::Uint64       rate,
+                                         const bsls::TimeInterval& window,
+                                         const bsls::TimeInterval& currentTime)
+: d_theoreticalArrivalTime(currentTime.totalNanoseconds())
+, d_nanosecondsPerUnit(0)
+, d_windowNanoseconds(window.totalNanoseconds())
+, d_rate(rate)
+, d_capacity(0)
+, d_numUnitsAdmitted(0)
+, d_numUnitsRejected(0)
+{
+    BSLS_ASSERT(0 < rate);
+    BSLS_ASSERT(bsls::TimeInterval() < window);
+
+    d_nanosecondsPerUnit = static_cast<double>(k_NANOSECONDS_PER_SECOND) /
+                                                     static_cast<double>(rate);
+    d_capacity           = LeakyBucket::calculateCapacity(rate, window);
+}
+
+// MANIPULATORS
+bool ConcurrentRateLimiter::tryConsume(bsls::Types::Uint64       numUnits,
+                                       const bsls::TimeInterval& currentTime)
+{
+    const bsls::Types::Int64 now  = currentTime.totalNanoseconds();
+    const bsls::Types::Int64 cost = costOf(numUnits);
+
+    bsls::Types::Int64 tat = d_theoreticalArrivalTime.loadRelaxed();
+    for (;;) {
+        const bool               isIdle = tat <= now;
+        const bsls::Types::Int64 newTat = (isIdle ? now : tat) + cost;
+
+        if (!isIdle && newTat - now > d_windowNanoseconds) {
+            d_numUnitsRejected.addRelaxed(
+                                    static_cast<bsls::Types::Int64>(numUnits));
+            return false;                                             // RETURN
+        }
+
+        const bsls::Types::Int64 prev =
+                       d_theoreticalArrivalTime.testAndSwapAcqRel(tat, newTat);
+        if (prev == tat) {
+            break;
+        }
+        tat = prev;
+    }
+
+    d_numUnitsAdmitted.addRelaxed(static_cast<bsls::Types::Int64>(numUnits));
+    return true;
+}
+
+bsls::Types::Uint64 ConcurrentRateLimiter::tryConsumeUpTo(
+                                         bsls::Types::Uint64       maxNumUnits,
+                                         const bsls::TimeInterval& currentTime)
+{
+    const bsls::Types::Int64 now = currentTime.totalNanoseconds();
+
+    bsls::Types::Int64  tat = d_theoreticalArrivalTime.loadRelaxed();
+    bsls::Types::Uint64 numUnits;
+    for (;;) {
+        const bsls::Types::Int64 base  = tat <= now ? now : tat;
+        const bsls::Types::Int64 slack = now + d_windowNanoseconds - base;
+        if (slack <= 0) {
+            return 0;                                                 // RETURN
+        }
+
+        const bsls::Types::Uint64 available =
+                 static_cast<bsls::Types::Uint64>(
+                            static_cast<double>(slack) / d_nanosecondsPerUnit);
+
+        numUnits = available < maxNumUnits ? available : maxNumUnits;
+        if (0 == numUnits) {
+            return 0;                                                 // RETURN
+        }
+
+        const bsls::Types::Int64 newTat = base + costOf(numUnits);
+        const bsls::Types::Int64 prev   =
+                       d_theoreticalArrivalTime.testAndSwapAcqRel(tat, newTat);
+        if (prev == tat) {
+            break;
+        }
+        tat = prev;
+    }
+
+    d_numUnitsAdmitted.addRelaxed(static_cast<bsls::Types::Int64>(numUnits));
+    return numUnits;
+}
+
+void ConcurrentRateLimiter::consume(bsls::Types::Uint64       numUnits,
+                                    const bsls::TimeInterval& currentTime)
+{
+    const bsls::Types::Int64 now  = currentTime.totalNanoseconds();
+    const bsls::Types::Int64 cost = costOf(numUnits);
+
+    bsls::Types::Int64 tat = d_theoreticalArrivalTime.loadRelaxed();
+    for (;;) {
+        const bsls::Types::Int64 newTat = (tat <= now ? now : tat) + cost;
+        const bsls::Types::Int64 prev   =
+                       d_theoreticalArrivalTime.testAndSwapAcqRel(tat, newTat);
+        if (prev == tat) {
+            break;
+        }
+        tat = prev;
+    }
+
+    d_numUnitsAdmitted.addRelaxed(static_cast<bsls::Types::Int64>(numUnits));
+}
+
+void ConcurrentRateLimiter::release(bsls::Types::Uint64 numUnits)
+{
+    d_theoreticalArrivalTime.addAcqRel(-costOf(numUnits));
+    d_numUnitsAdmitted.addRelaxed(-static_cast<bsls::Types::Int64>(numUnits));
+}
+
+void ConcurrentRateLimiter::reset(const bsls::TimeInterval& currentTime)
+{
+    d_theoreticalArrivalTime.storeRelease(currentTime.totalNanoseconds());
+    d_numUnitsAdmitted.storeRelaxed(0);
+    d_numUnitsRejected.storeRelaxed(0);
+}
+
+// ACCESSORS
+bsls::TimeInterval ConcurrentRateLimiter::calculateTimeToSubmit(
+                                   bsls::Types::Uint64       numUnits,
+                                   const bsls::TimeInterval& currentTime) const
+{
+    const bsls::Types::Int64 now = currentTime.totalNanoseconds();
+    const bsls::Types::Int64 tat = d_theoreticalArrivalTime.loadAcquire();
+
+    bsls::Types::Int64 wait;
+    if (numUnits > d_capacity) {
+        wait = tat - now;
+    }
+    else {
+        wait = tat + costOf(numUnits) - d_windowNanoseconds - now;
+    }
+
+    bsls::TimeInterval result;
+    if (0 < wait) {
+        result.setTotalNanoseconds(wait);
+    }
+    return result;
+}
+
+bsls::Types::Uint64 ConcurrentRateLimiter::numUnitsAvailable(
+                                   const bsls::TimeInterval& currentTime) const
+{
+    const bsls::Types::Int64 now   = currentTime.totalNanoseconds();
+    const bsls::Types::Int64 tat   = d_theoreticalArrivalTime.loadAcquire();
+    const bsls::Types::Int64 slack = now + d_windowNanoseconds -
+                                                      (tat <= now ? now : tat);
+
+    if (slack <= 0) {
+        return 0;                                                     // RETURN
+    }
+
+    const bsls::Types::Uint64 available =
+                 static_cast<bsls::Types::Uint64>(
+                            static_cast<double>(slack) / d_nanosecondsPerUnit);
+
+    return available < d_capacity ? available : d_capacity;
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,337 @@
+// btls_concurrentratelimiter.h                                       -*-C++-*-
+#ifndef INCLUDED_BTLS_CONCURRENTRATELIMITER
+#define INCLUDED_BTLS_CONCURRENTRATELIMITER
+
+#ifndef INCLUDED_BSLS_IDENT
+#include <bsls_ident.h>
+#endif
+BSLS_IDENT("$Id: $")
+
+//@PURPOSE: Provide a lock-free token-bucket rate limiter shared by threads.
+//
+//@CLASSES:
+//  btls::ConcurrentRateLimiter: thread-safe token-bucket rate limiter
+//
+//@SEE_ALSO: btls_ratelimiter, btls_leakybucket
+//
+//@DESCRIPTION: This component provides a mechanism,
+// 'btls::ConcurrentRateLimiter', that enforces a single aggregate consumption
+// rate on a resource that is used concurrently by many threads.  Unlike
+// 'btls::RateLimiter' and 'btls::LeakyBucket', which are not thread-safe and
+// must be guarded by a mutex in order to be shared, every manipulator of a
+// 'btls::ConcurrentRateLimiter' may be invoked concurrently, and none of them
+// acquires a lock: the complete state of the limiter is held in one atomic
+// 64-bit integer that is updated with a compare-and-swap loop.
+//
+// A concurrent rate limiter is configured with a rate (measured in
+// 'units/s') and a time window.  The product of the two is the *burst*
+// *capacity* of the limiter: the number of units that may be consumed
+// back-to-back after the limiter has been idle for at least one time window.
+// Over any sufficiently long period the average consumption rate does not
+// exceed the configured rate.  As with 'btls::RateLimiter', 'unit' is a
+// generic unit of measurement (e.g., bytes, messages, packets).
+//
+///Internal Model
+///--------------
+// Rather than storing a number of tokens together with the time at which that
+// number was last updated (which would require two words to be updated
+// atomically), the limiter stores a single *theoretical* *arrival* *time*
+// ('TAT'), in nanoseconds: the time at which all units consumed so far would
+// have been drained had they been consumed at exactly the configured rate.
+// Consuming 'N' units advances 'TAT' by 'N / rate' seconds, starting from the
+// later of the current 'TAT' and the current time.  A consumption is admitted
+// if the resulting 'TAT' is no later than the current time plus the time
+// window.  This formulation (known as the generic cell rate algorithm) is
+// equivalent to a token bucket holding at most 'rate * window' tokens, and the
+// number of tokens available at time 't' is '(t + window - TAT) * rate'.
+//
+// A request for more units than the burst capacity could never be admitted
+// under the above rule; to allow such requests to make progress, they are
+// admitted whenever the limiter is idle (i.e., 'TAT' is not later than the
+// current time), after which the limiter rejects further consumption until
+// the excess has drained.
+//
+///Token Leasing
+///-------------
+// Each admitted consumption costs one successful compare-and-swap on a cache
+// line shared by every consuming thread.  Threads that consume many small
+// amounts can amortize that cost by *leasing* a batch of units with
+// 'tryConsumeUpTo', spending the leased units locally without touching the
+// shared limiter, and returning any unused remainder with 'release'.  Leased
+// units count as consumed for the purpose of rate enforcement, so leases
+// should be kept small relative to the burst capacity and short-lived.
+//
+///Time Synchronization
+///--------------------
+// A concurrent rate limiter does not consult a clock; every operation that
+// depends on time takes the current time as an argument.  As with
+// 'btls::RateLimiter', the time intervals supplied may be relative to any
+// time origin, but all of them must refer to the same origin.  Clients are
+// encouraged to use the unix epoch time (such as the values returned by
+// 'bdlt::CurrentTime::now').  Times supplied by different threads need not be
+// monotonically increasing: a thread supplying a slightly stale time is
+// simply treated as if it had arrived slightly earlier.
+//
+///Usage
+///-----
+// This section illustrates the intended use of this component.
+//
+///Example 1: Limiting the Aggregate Rate of Several Producers
+///-----------------------------------------------------------
+// Suppose that several threads transmit messages over a shared network link,
+// and that the total transmission rate must not exceed 1024 bytes/s, with
+// bursts of at most 256 bytes.
+//
+// First, we create a 'btls::ConcurrentRateLimiter' having a rate of 1024
+// bytes/s and a time window of 0.25s (256 bytes / 1024 bytes/s) that is
+// shared by all of the transmitting threads:
+//..
+//  btls::ConcurrentRateLimiter rateLimiter(1024,
+//                                          bsls::TimeInterval(0.25),
+//                                          bdlt::CurrentTime::now());
+//..
+// Then, each transmitting thread, before sending a message of 'messageSize'
+// bytes, attempts to consume the corresponding number of units.  No lock is
+// required:
+//..
+//  bsls::TimeInterval now = bdlt::CurrentTime::now();
+//  if (rateLimiter.tryConsume(messageSize, now)) {
+//      sendData(message, messageSize);
+//  }
+//..
+// Finally, if the message could not be admitted, the thread waits for the
+// amount of time returned by 'calculateTimeToSubmit' before trying again:
+//..
+//  else {
+//      bsls::TimeInterval timeToSubmit =
+//                       rateLimiter.calculateTimeToSubmit(messageSize, now);
+//      bslmt::ThreadUtil::microSleep(
+//                     static_cast<int>(timeToSubmit.totalMicroseconds()) + 1);
+//  }
+//..
+
+#ifndef INCLUDED_BTLSCM_VERSION
+#include <btlscm_version.h>
+#endif
+
+#ifndef INCLUDED_BSLS_ATOMIC
+#include <bsls_atomic.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TIMEINTERVAL
+#include <bsls_timeinterval.h>
+#endif
+
+#ifndef INCLUDED_BSLS_TYPES
+#include <bsls_types.h>
+#endif
+
+namespace BloombergLP {
+namespace btls {
+
+                        // ===========================
+                        // class ConcurrentRateLimiter
+                        // ===========================
+
+class ConcurrentRateLimiter {
+    // This mechanism implements a token-bucket rate limiter whose manipulators
+    // may be invoked concurrently from any number of threads without external
+    // synchronization.  The behavior of a concurrent rate limiter is
+    // determined by two properties, fixed at construction: the rate (in
+    // units/s) and the time window (in seconds), whose product is the burst
+    // capacity.
+    //
+    // Units are consumed using 'tryConsume', which consumes the specified
+    // number of units only if doing so would not exceed the configured limits,
+    // 'tryConsumeUpTo', which consumes as many of the specified number of
+    // units as are currently available, or 'consume', which consumes units
+    // unconditionally.  Previously consumed units can be returned using
+    // 'release'.
+    //
+    // A concurrent rate limiter keeps statistics on the number of units it
+    // has admitted and rejected, which can be accessed using
+    // 'numUnitsAdmitted' and 'numUnitsRejected'.
+    //
+    // This class:
+    //: o is *exception* *neutral* (agnostic)
+    //: o is *fully* *thread-safe*
+    // For terminology see 'bsldoc_glossary'.
+
+    // DATA
+    bsls::AtomicInt64   d_theoreticalArrivalTime;
+                                        // time (in nanoseconds) at which all
+                                        // consumed units will have drained
+
+    double              d_nanosecondsPerUnit;
+                                        // time needed to drain one unit
+
+    bsls::Types::Int64  d_windowNanoseconds;
+                                        // time window, in nanoseconds
+
+    bsls::Types::Uint64 d_rate;         // configured rate, in units/s
+
+    bsls::Types::Uint64 d_capacity;     // burst capacity, in units
+
+    bsls::AtomicInt64   d_numUnitsAdmitted;
+                                        // units consumed successfully
+
+    bsls::AtomicInt64   d_numUnitsRejected;
+                                        // units refused by 'tryConsume'
+
+  private:
+    // NOT IMPLEMENTED
+    ConcurrentRateLimiter(const ConcurrentRateLimiter&);
+    ConcurrentRateLimiter& operator=(const ConcurrentRateLimiter&);
+
+    // PRIVATE ACCESSORS
+    bsls::Types::Int64 costOf(bsls::Types::Uint64 numUnits) const;
+        // Return the time, in nanoseconds, needed to drain the specified
+        // 'numUnits' at the configured rate, saturated to a value that cannot
+        // cause the theoretical arrival time to overflow.
+
+  public:
+    // CREATORS
+    ConcurrentRateLimiter(bsls::Types::Uint64       rate,
+                          const bsls::TimeInterval& window,
+                          const bsls::TimeInterval& currentTime);
+        // Create a concurrent rate limiter having the specified 'rate' (in
+        // units/s) and the specified time 'window', that is idle (i.e., has
+        // its full burst capacity available) at the specified 'currentTime'.
+        // The behavior is undefined unless '0 < rate', '0 < window', and the
+        // product of 'rate' and 'window' (the burst capacity) is at least 1
+        // and can be represented by a 64-bit unsigned integral type.
+
+    //! ~ConcurrentRateLimiter() = default;
+        // Destroy this object.
+
+    // MANIPULATORS
+    bool tryConsume(bsls::Types::Uint64       numUnits,
+                    const bsls::TimeInterval& currentTime);
+        // Consume the specified 'numUnits' if doing so at the specified
+        // 'currentTime' would not exceed the configured limits, or if
+        // 'numUnits' exceeds the burst capacity and this limiter is idle.
+        // Return 'true' if the units were consumed, and 'false' (leaving this
+        // limiter unchanged, other than its statistics) otherwise.
+
+    bsls::Types::Uint64 tryConsumeUpTo(
+                                     bsls::Types::Uint64       maxNumUnits,
+                                     const bsls::TimeInterval& currentTime);
+        // Consume as many of the specified 'maxNumUnits' as are available at
+        // the specified 'currentTime' without exceeding the configured limits,
+        // and return the number of units consumed.  Note that this method is
+        // intended for leasing a batch of units to be spent by the calling
+        // thread; unused units should be returned using 'release'.
+
+    void consume(bsls::Types::Uint64       numUnits,
+                 const bsls::TimeInterval& currentTime);
+        // Consume the specified 'numUnits' at the specified 'currentTime'
+        // regardless of whether the configured limits are exceeded.  Note that
+        // this method can be used to account for units whose consumption
+        // cannot be deferred.
+
+    void release(bsls::Types::Uint64 numUnits);
+        // Return the specified 'numUnits', previously consumed from this
+        // limiter but not actually used, to this limiter.  The behavior is
+        // undefined unless 'numUnits' does not exceed the number of units
+        // consumed from this limiter and not yet released.  Note that units
+        // released after they would already have drained have no effect.
+
+    void reset(const bsls::TimeInterval& currentTime);
+        // Reset this limiter to be idle at the specified 'currentTime', and
+        // reset its statistics to 0.
+
+    // ACCESSORS
+    bsls::TimeInterval calculateTimeToSubmit(
+                               bsls::Types::Uint64       numUnits,
+                               const bsls::TimeInterval& currentTime) const;
+        // Return the estimated time interval, relative to the specified
+        // 'currentTime', that must pass before the specified 'numUnits' can be
+        // consumed without exceeding the configured limits, or a zero interval
+        // if they can be consumed at 'currentTime'.  If 'numUnits' exceeds the
+        // burst capacity, return the time until this limiter becomes idle.
+
+    bsls::Types::Uint64 numUnitsAvailable(
+                                 const bsls::TimeInterval& currentTime) const;
+        // Return the number of units that can be consumed at the specified
+        // 'currentTime' without exceeding the configured limits.
+
+    bsls::Types::Uint64 capacity() const;
+        // Return the burst capacity of this limiter, in units.
+
+    bsls::Types::Uint64 rate() const;
+        // Return the rate of this limiter, in units/s.
+
+    bsls::TimeInterval window() const;
+        // Return the time window of this limiter.
+
+    bsls::Types::Uint64 numUnitsAdmitted() const;
+        // Return the number of units consumed from this limiter (by any of
+        // 'tryConsume', 'tryConsumeUpTo', and 'consume'), less those
+        // released, since construction or the last call to 'reset'.
+
+    bsls::Types::Uint64 numUnitsRejected() const;
+        // Return the number of units refused by 'tryConsume' since
+        // construction or the last call to 'reset'.
+};
+
+// ============================================================================
+//                            INLINE DEFINITIONS
+// ============================================================================
+
+                        // ---------------------------
+                        // class ConcurrentRateLimiter
+                        // ---------------------------
+
+// ACCESSORS
+inline
+bsls::Types::Uint64 ConcurrentRateLimiter::capacity() const
+{
+    return d_capacity;
+}
+
+inline
+bsls::Types::Uint64 ConcurrentRateLimiter::rate() const
+{
+    return d_rate;
+}
+
+inline
+bsls::TimeInterval ConcurrentRateLimiter::window() const
+{
+    bsls::TimeInterval result;
+    result.setTotalNanoseconds(d_windowNanoseconds);
+    return result;
+}
+
+inline
+bsls::Types::Uint64 ConcurrentRateLimiter::numUnitsAdmitted() const
+{
+    return static_cast<bsls::Types::Uint64>(d_numUnitsAdmitted.loadRelaxed());
+}
+
+inline
+bsls::Types::Uint64 ConcurrentRateLimiter::numUnitsRejected() const
+{
+    return static_cast<bsls::Types::Uint64>(d_numUnitsRejected.loadRelaxed());
+}
+
+}  // close package namespace
+}  // close enterprise namespace
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------
@@ -0,0 +1,855 @@
+// btls_concurrentratelimiter.t.cpp                                   -*-C++-*-
+#include <btls_concurrentratelimiter.h>
+
+#include <btls_ratelimiter.h>  // for testing only
+
+#include <bslim_testutil.h>
+
+#include <bslmt_barrier.h>
+#include <bslmt_mutex.h>
+#include <bslmt_lockguard.h>
+#include <bslmt_threadutil.h>
+
+#include <bdlf_bind.h>
+#include <bdlt_currenttime.h>
+
+#include <bsls_asserttest.h>
+#include <bsls_atomic.h>
+#include <bsls_stopwatch.h>
+#include <bsls_timeinterval.h>
+#include <bsls_types.h>
+
+#include <bsl_cstdlib.h>
+#include <bsl_iostream.h>
+#include <bsl_vector.h>
+
+using namespace BloombergLP;
+using namespace bsl;
+
+// ============================================================================
+//                              TEST PLAN
+// ----------------------------------------------------------------------------
+//                              Overview
+//                              --------
+// The component under test implements a thread-safe mechanism whose complete
+// state is a single atomic theoretical arrival time plus two statistics
+// counters.  All time-dependent operations take the current time as an
+// argument, so single-threaded behavior can be tested deterministically by
+// supplying synthetic times.  Thread-safety is tested by having many threads
+// consume concurrently at a single fixed time, in which case the total number
+// of admitted units must equal the burst capacity exactly.
+//
+// Primary Manipulators:
+//: o 'tryConsume'
+//
+// Basic Accessors:
+//: o 'rate'
+//: o 'window'
+//: o 'capacity'
+//: o 'numUnitsAvailable'
+//
+// Global Concerns:
+//: o ACCESSOR methods are declared 'const'.
+//: o Precondition violations are detected in appropriate build modes.
+// ----------------------------------------------------------------------------
+//
+// CREATORS
+// [ 2] ConcurrentRateLimiter(Uint64, const TimeInterval&, const TI&);
+//
+// MANIPULATORS
+// [ 3] bool tryConsume(Uint64 numUnits, const TimeInterval& currentTime);
+// [ 4] Uint64 tryConsumeUpTo(Uint64 maxNumUnits, const TI& now);
+// [ 4] void release(Uint64 numUnits);
+// [ 5] void consume(Uint64 numUnits, const TimeInterval& currentTime);
+// [ 6] void reset(const TimeInterval& currentTime);
+//
+// ACCESSORS
+// [ 5] TimeInterval calculateTimeToSubmit(Uint64, const TI&) const;
+// [ 3] Uint64 numUnitsAvailable(const TimeInterval& currentTime) const;
+// [ 2] Uint64 capacity() const;
+// [ 2] Uint64 rate() const;
+// [ 2] TimeInterval window() const;
+// [ 6] Uint64 numUnitsAdmitted() const;
+// [ 6] Uint64 numUnitsRejected() const;
+// ----------------------------------------------------------------------------
+// [ 1] BREATHING TEST
+// [ 7] CONCURRENCY TEST
+// [ 8] USAGE EXAMPLE
+// [-1] PERFORMANCE: COMPARISON WITH MUTEX-GUARDED 'btls::RateLimiter'
+// ============================================================================
+
+// ============================================================================
+//                     STANDARD BDE ASSERT TEST FUNCTION
+// ----------------------------------------------------------------------------
+
+namespace {
+
+int testStatus = 0;
+
+void aSsErT(bool condition, const char *message, int line)
+{
+    if (condition) {
+        cout << "Error " __FILE__ "(" << line << "): " << message
+             << "    (failed)" << endl;
+
+        if (0 <= testStatus && testStatus <= 100) {
+            ++testStatus;
+        }
+    }
+}
+
+}  // close unnamed namespace
+
+// ============================================================================
+//               STANDARD BDE TEST DRIVER MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT       BSLIM_TESTUTIL_ASSERT
+#define ASSERTV      BSLIM_TESTUTIL_ASSERTV
+
+#define LOOP_ASSERT  BSLIM_TESTUTIL_LOOP_ASSERT
+#define LOOP0_ASSERT BSLIM_TESTUTIL_LOOP0_ASSERT
+#define LOOP1_ASSERT BSLIM_TESTUTIL_LOOP1_ASSERT
+#define LOOP2_ASSERT BSLIM_TESTUTIL_LOOP2_ASSERT
+#define LOOP3_ASSERT BSLIM_TESTUTIL_LOOP3_ASSERT
+#define LOOP4_ASSERT BSLIM_TESTUTIL_LOOP4_ASSERT
+#define LOOP5_ASSERT BSLIM_TESTUTIL_LOOP5_ASSERT
+#define LOOP6_ASSERT BSLIM_TESTUTIL_LOOP6_ASSERT
+
+#define Q            BSLIM_TESTUTIL_Q   // Quote identifier literally.
+#define P            BSLIM_TESTUTIL_P   // Print identifier and value.
+#define P_           BSLIM_TESTUTIL_P_  // P(X) without '\n'.
+#define T_           BSLIM_TESTUTIL_T_  // Print a tab (w/o newline).
+#define L_           BSLIM_TESTUTIL_L_  // current Line number
+
+// ============================================================================
+//                     NEGATIVE-TEST MACRO ABBREVIATIONS
+// ----------------------------------------------------------------------------
+
+#define ASSERT_SAFE_FAIL(expr) BSLS_ASSERTTEST_ASSERT_SAFE_FAIL(expr)
+#define ASSERT_SAFE_PASS(expr) BSLS_ASSERTTEST_ASSERT_SAFE_PASS(expr)
+#define ASSERT_FAIL(expr)      BSLS_ASSERTTEST_ASSERT_FAIL(expr)
+#define ASSERT_PASS(expr)      BSLS_ASSERTTEST_ASSERT_PASS(expr)
+
+// ============================================================================
+//                   GLOBAL TYPEDEFS/CONSTANTS FOR TESTING
+// ----------------------------------------------------------------------------
+
+typedef btls::ConcurrentRateLimiter Obj;
+typedef bsls::TimeInterval          Ti;
+typedef bsls::Types::Uint64         Uint64;
+
+// ============================================================================
+//                      HELPER FUNCTIONS FOR TESTING
+// ----------------------------------------------------------------------------
+
+namespace CONCURRENCY_TEST {
+
+void consumeAtFixedTime(Obj                  *limiter,
+                        bsls::AtomicInt64    *numAdmitted,
+                        bslmt::Barrier       *barrier,
+                        const Ti&             now,
+                        Uint64                unitsPerCall,
+                        bool                  useLeasing)
+    // Wait on the specified 'barrier', then repeatedly consume the specified
+    // 'unitsPerCall' from the specified 'limiter' at the specified 'now',
+    // using 'tryConsumeUpTo' if the specified 'useLeasing' is 'true' and
+    // 'tryConsume' otherwise, until the limiter refuses a request.  Add the
+    // number of units consumed to the specified 'numAdmitted'.
+{
+    barrier->wait();
+
+    Uint64 total = 0;
+    for (;;) {
+        if (useLeasing) {
+            const Uint64 leased = limiter->tryConsumeUpTo(unitsPerCall, now);
+            if (0 == leased) {
+                break;
+            }
+            total += leased;
+        }
+        else {
+            if (!limiter->tryConsume(unitsPerCall, now)) {
+                break;
+            }
+            total += unitsPerCall;
+        }
+    }
+    numAdmitted->add(static_cast<bsls::Types::Int64>(total));
+}
+
+}  // close namespace CONCURRENCY_TEST
+
+namespace PERFORMANCE_TEST {
+
+void consumeLockFree(Obj *limiter, bslmt::Barrier *barrier, int numIterations)
+    // Wait on the specified 'barrier', then invoke 'tryConsume' on the
+    // specified 'limiter' the specified 'numIterations' times.
+{
+    barrier->wait();
+    for (int i = 0; i < numIterations; ++i) {
+        limiter->tryConsume(1, bdlt::CurrentTime::now());
+    }
+}
+
+void consumeLocked(btls::RateLimiter *limiter,
+                   bslmt::Mutex      *mutex,
+                   bslmt::Barrier    *barrier,
+                   int                numIterations)
+    // Wait on the specified 'barrier', then perform the equivalent of a
+    // 'tryConsume' of one unit on the specified 'limiter', while holding the
+    // specified 'mutex', the specified 'numIterations' times.
+{
+    barrier->wait();
+    for (int i = 0; i < numIterations; ++i) {
+        bslmt::LockGuard<bslmt::Mutex> guard(mutex);
+        if (!limiter->wouldExceedBandwidth(bdlt::CurrentTime::now())) {
+            limiter->submit(1);
+        }
+    }
+}
+
+}  // close namespace PERFORMANCE_TEST
+
+// ============================================================================
+//                               USAGE EXAMPLE
+// ----------------------------------------------------------------------------
+
+namespace USAGE_EXAMPLE {
+
+bool sendData(const char *message, Uint64 messageSize)
+    // Send the specified 'message' of the specified 'messageSize' over the
+    // network.  Return 'true' if the data was sent successfully and 'false'
+    // otherwise.
+{
+    (void)message;
+    (void)messageSize;
+
+    // For simplicity, 'sendData' will not actually send any data and will
+    // always return 'true'.
+
+    return true;
+}
+
+}  // close namespace USAGE_EXAMPLE
+
+// ============================================================================
+//                               MAIN PROGRAM
+// ----------------------------------------------------------------------------
+
+int main(int argc, char *argv[])
+{
+    int             test = argc > 1 ? atoi(argv[1]) : 0;
+    bool         verbose = argc > 2;
+    bool     veryVerbose = argc > 3;
+
+    cout << "TEST " << __FILE__ << " CASE " << test << endl;
+
+    switch (test) { case 0:
+      case 8: {
+        // --------------------------------------------------------------------
+        // USAGE EXAMPLE
+        //
+        // Concerns:
+        //: 1 The usage example provided in the component header file compiles,
+        //:   links, and runs as shown.
+        //
+        // Plan:
+        //: 1 Incorporate usage example from header into test driver, replace
+        //:   leading comment characters with spaces, and replace 'assert' with
+        //:   'ASSERT'.  (C-1)
+        //
+        // Testing:
+        //   USAGE EXAMPLE
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "USAGE EXAMPLE" << endl
+                                  << "=============" << endl;
+
+        using namespace USAGE_EXAMPLE;
+
+        const char   message[]   = "0123456789abcdef";
+        const Uint64 messageSize = sizeof message - 1;
+
+        btls::ConcurrentRateLimiter rateLimiter(1024,
+                                                bsls::TimeInterval(0.25),
+                                                bdlt::CurrentTime::now());
+
+        int numSent = 0;
+        while (numSent < 20) {
+            bsls::TimeInterval now = bdlt::CurrentTime::now();
+            if (rateLimiter.tryConsume(messageSize, now)) {
+                sendData(message, messageSize);
+                ++numSent;
+            }
+            else {
+                bsls::TimeInterval timeToSubmit =
+                         rateLimiter.calculateTimeToSubmit(messageSize, now);
+                bslmt::ThreadUtil::microSleep(
+                      static_cast<int>(timeToSubmit.totalMicroseconds()) + 1);
+            }
+        }
+        ASSERT(20 * messageSize == rateLimiter.numUnitsAdmitted());
+      } break;
+      case 7: {
+        // --------------------------------------------------------------------
+        // CONCURRENCY TEST
+        //
+        // Concerns:
+        //: 1 When many threads consume concurrently at the same time, the
+        //:   total number of units admitted equals the burst capacity; no
+        //:   consumption is lost or double-counted.
+        //:
+        //: 2 The same holds when the threads lease batches using
+        //:   'tryConsumeUpTo'.
+        //:
+        //: 3 The statistics agree with the units actually admitted.
+        //
+        // Plan:
+        //: 1 For both consumption methods, and for several request sizes that
+        //:   evenly divide the capacity, start a number of threads that all
+        //:   consume from one limiter at a single fixed time until refused,
+        //:   and verify that the sum of admitted units equals the capacity.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   CONCURRENCY TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "CONCURRENCY TEST" << endl
+                                  << "================" << endl;
+
+        using namespace CONCURRENCY_TEST;
+
+        const int    NUM_THREADS = 8;
+        const Uint64 CAPACITY    = 100000;
+        const Uint64 SIZES[]     = { 1, 4, 25, 1000 };
+        const int    NUM_SIZES   = sizeof SIZES / sizeof *SIZES;
+
+        for (int leasing = 0; leasing < 2; ++leasing) {
+            for (int si = 0; si < NUM_SIZES; ++si) {
+                const Ti  START(1000, 0);
+                Obj       mX(CAPACITY, Ti(1), START);
+                const Obj& X = mX;
+
+                bsls::AtomicInt64           numAdmitted(0);
+                bslmt::Barrier              barrier(NUM_THREADS);
+                bslmt::ThreadUtil::Handle   handles[NUM_THREADS];
+
+                for (int i = 0; i < NUM_THREADS; ++i) {
+                    ASSERT(0 == bslmt::ThreadUtil::create(
+                                      &handles[i],
+                                      bdlf::BindUtil::bind(&consumeAtFixedTime,
+                                                           &mX,
+                                                           &numAdmitted,
+                                                           &barrier,
+                                                           START,
+                                                           SIZES[si],
+                                                           0 != leasing)));
+                }
+                for (int i = 0; i < NUM_THREADS; ++i) {
+                    bslmt::ThreadUtil::join(handles[i]);
+                }
+
+                if (veryVerbose) {
+                    P_(leasing) P_(SIZES[si]) P(numAdmitted.load());
+                }
+
+                ASSERTV(leasing, SIZES[si], numAdmitted.load(),
+                        CAPACITY == static_cast<Uint64>(numAdmitted.load()));
+                ASSERTV(leasing, SIZES[si], CAPACITY == X.numUnitsAdmitted());
+                ASSERTV(leasing, SIZES[si], 0 == X.numUnitsAvailable(START));
+            }
+        }
+      } break;
+      case 6: {
+        // --------------------------------------------------------------------
+        // TESTING 'reset' AND STATISTICS
+        //
+        // Concerns:
+        //: 1 'numUnitsAdmitted' counts units consumed by every consuming
+        //:   manipulator, less units released.
+        //:
+        //: 2 'numUnitsRejected' counts units refused by 'tryConsume'.
+        //:
+        //: 3 'reset' makes the full capacity available at the specified time
+        //:   and resets both statistics.
+        //
+        // Plan:
+        //: 1 Exercise each manipulator and verify the statistics after each
+        //:   step.  (C-1..2)
+        //:
+        //: 2 Exhaust a limiter, reset it at an earlier time, and verify the
+        //:   available units and statistics.  (C-3)
+        //
+        // Testing:
+        //   void reset(const TimeInterval& currentTime);
+        //   Uint64 numUnitsAdmitted() const;
+        //   Uint64 numUnitsRejected() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING 'reset' AND STATISTICS" << endl
+                                  << "==============================" << endl;
+
+        const Ti   T(50, 0);
+        Obj        mX(100, Ti(1), T);  const Obj& X = mX;
+
+        ASSERT(0 == X.numUnitsAdmitted());
+        ASSERT(0 == X.numUnitsRejected());
+
+        ASSERT(true  == mX.tryConsume(60, T));
+        ASSERT(60    == X.numUnitsAdmitted());
+
+        ASSERT(false == mX.tryConsume(50, T));
+        ASSERT(60    == X.numUnitsAdmitted());
+        ASSERT(50    == X.numUnitsRejected());
+
+        ASSERT(40    == mX.tryConsumeUpTo(50, T));
+        ASSERT(100   == X.numUnitsAdmitted());
+
+        mX.release(10);
+        ASSERT(90    == X.numUnitsAdmitted());
+
+        mX.consume(30, T);
+        ASSERT(120   == X.numUnitsAdmitted());
+        ASSERT(50    == X.numUnitsRejected());
+        ASSERT(0     == X.numUnitsAvailable(T));
+
+        const Ti T2(60, 0);
+        mX.reset(T2);
+        ASSERT(0     == X.numUnitsAdmitted());
+        ASSERT(0     == X.numUnitsRejected());
+        ASSERT(100   == X.numUnitsAvailable(T2));
+        ASSERT(Ti(0) == X.calculateTimeToSubmit(100, T2));
+      } break;
+      case 5: {
+        // --------------------------------------------------------------------
+        // TESTING 'consume' AND 'calculateTimeToSubmit'
+        //
+        // Concerns:
+        //: 1 'consume' consumes units even when the limits are exceeded, and
+        //:   subsequent consumption is deferred until the excess drains.
+        //:
+        //: 2 'calculateTimeToSubmit' returns 0 when the units can be consumed
+        //:   immediately, and otherwise the time after which 'tryConsume' of
+        //:   the same number of units succeeds.
+        //:
+        //: 3 For requests exceeding the capacity, 'calculateTimeToSubmit'
+        //:   returns the time until the limiter is idle.
+        //
+        // Plan:
+        //: 1 Use a limiter with a rate of 1000 units/s (1 ms per unit) and a
+        //:   window of 100ms, overdraw it with 'consume', and verify the
+        //:   calculated waits against 'tryConsume' at the computed times.
+        //:   (C-1..3)
+        //
+        // Testing:
+        //   void consume(Uint64 numUnits, const TimeInterval& currentTime);
+        //   TimeInterval calculateTimeToSubmit(Uint64, const TI&) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                        << "TESTING 'consume' AND 'calculateTimeToSubmit'"
+                        << endl
+                        << "============================================="
+                        << endl;
+
+        const Ti T(10, 0);
+        Obj      mX(1000, Ti(0.1), T);  const Obj& X = mX;
+
+        ASSERT(100   == X.capacity());
+        ASSERT(Ti(0) == X.calculateTimeToSubmit(100, T));
+
+        mX.consume(250, T);
+        ASSERT(0     == X.numUnitsAvailable(T));
+
+        // 250 units take 250ms to drain; 1 unit fits once 'TAT' is within
+        // the 100ms window, i.e., after 151ms.
+
+        const Ti WAIT1 = X.calculateTimeToSubmit(1, T);
+        ASSERTV(WAIT1, Ti(0, 151000000) == WAIT1);
+
+        Ti t = T;
+        t.addNanoseconds(WAIT1.totalNanoseconds() - 1);
+        ASSERT(false == mX.tryConsume(1, t));
+
+        t = T + WAIT1;
+        ASSERT(true  == mX.tryConsume(1, t));
+
+        // A request exceeding the capacity waits for the limiter to be idle.
+
+        const Ti WAIT2 = X.calculateTimeToSubmit(500, t);
+        ASSERTV(WAIT2, Ti(0, 100000000) == WAIT2);
+        ASSERT(false == mX.tryConsume(500, t));
+        ASSERT(true  == mX.tryConsume(500, t + WAIT2));
+
+        // Once the excess has drained, everything is available again.
+
+        const Ti T3 = t + WAIT2 + Ti(0.5);
+        ASSERT(100   == X.numUnitsAvailable(T3));
+        ASSERT(Ti(0) == X.calculateTimeToSubmit(100, T3));
+      } break;
+      case 4: {
+        // --------------------------------------------------------------------
+        // TESTING 'tryConsumeUpTo' AND 'release'
+        //
+        // Concerns:
+        //: 1 'tryConsumeUpTo' consumes the lesser of the requested and the
+        //:   available number of units, and returns that number.
+        //:
+        //: 2 'tryConsumeUpTo' returns 0 and leaves the limiter unchanged when
+        //:   nothing is available.
+        //:
+        //: 3 'release' makes released units available again.
+        //:
+        //: 4 Releasing units that have already drained has no effect on the
+        //:   number of available units.
+        //
+        // Plan:
+        //: 1 Lease from a limiter in batches and verify the returned counts
+        //:   and the available units after each step.  (C-1..4)
+        //
+        // Testing:
+        //   Uint64 tryConsumeUpTo(Uint64 maxNumUnits, const TI& now);
+        //   void release(Uint64 numUnits);
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING 'tryConsumeUpTo' AND 'release'" << endl
+                          << "======================================" << endl;
+
+        const Ti T(1, 0);
+        Obj      mX(100, Ti(1), T);  const Obj& X = mX;
+
+        ASSERT(30  == mX.tryConsumeUpTo(30, T));
+        ASSERT(70  == X.numUnitsAvailable(T));
+
+        ASSERT(70  == mX.tryConsumeUpTo(1000, T));
+        ASSERT(0   == X.numUnitsAvailable(T));
+
+        ASSERT(0   == mX.tryConsumeUpTo(1, T));
+        ASSERT(0   == X.numUnitsAvailable(T));
+
+        mX.release(20);
+        ASSERT(20  == X.numUnitsAvailable(T));
+        ASSERT(20  == mX.tryConsumeUpTo(25, T));
+
+        // Half a second later, 50 units have drained.
+
+        const Ti T2 = T + Ti(0.5);
+        ASSERT(50  == X.numUnitsAvailable(T2));
+        ASSERT(50  == mX.tryConsumeUpTo(50, T2));
+
+        // Two seconds later the limiter is idle; releasing has no effect.
+
+        const Ti T3 = T + Ti(3);
+        mX.release(40);
+        ASSERT(100 == X.numUnitsAvailable(T3));
+        ASSERT(100 == mX.tryConsumeUpTo(200, T3));
+      } break;
+      case 3: {
+        // --------------------------------------------------------------------
+        // TESTING 'tryConsume'
+        //
+        // Concerns:
+        //: 1 An idle limiter admits up to its capacity at a single time.
+        //:
+        //: 2 A refused request leaves the limiter unchanged.
+        //:
+        //: 3 Units become available again at the configured rate.
+        //:
+        //: 4 A request exceeding the capacity is admitted only when the
+        //:   limiter is idle.
+        //:
+        //: 5 'numUnitsAvailable' reports the units that 'tryConsume' would
+        //:   admit, and never exceeds the capacity.
+        //
+        // Plan:
+        //: 1 Using a table of (time offset, request, expected result,
+        //:   expected available units after the request) rows applied in
+        //:   order to a single limiter, verify the result of each request and
+        //:   the available units.  (C-1..5)
+        //
+        // Testing:
+        //   bool tryConsume(Uint64 numUnits, const TimeInterval& currentTime);
+        //   Uint64 numUnitsAvailable(const TimeInterval& currentTime) const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "TESTING 'tryConsume'" << endl
+                                  << "====================" << endl;
+
+        static const struct {
+            int    d_line;
+            int    d_offsetMs;   // time since start, in milliseconds
+            Uint64 d_numUnits;   // units requested
+            bool   d_expected;   // expected result
+            Uint64 d_available;  // expected units available afterwards
+        } DATA[] = {
+            //LINE  MS   UNITS  EXP    AVAIL
+            //----  ---  -----  -----  -----
+            { L_,     0,    0,  true,  1000 },
+            { L_,     0,  400,  true,   600 },
+            { L_,     0,  600,  true,     0 },
+            { L_,     0,    1,  false,    0 },
+            { L_,   100,  101,  false,  100 },
+            { L_,   100,  100,  true,     0 },
+            { L_,   600,  500,  true,     0 },
+            { L_,  1000,  400,  true,     0 },
+            { L_,  1500, 2000,  false,  500 },
+            { L_,  2000, 2000,  true,     0 },
+            { L_,  2500,    1,  false,    0 },
+            { L_,  3000,    1,  false,    0 },
+            { L_,  3001,    1,  true,     0 },
+            { L_,  9000,    0,  true,  1000 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        const Ti START(1000, 0);
+        Obj      mX(1000, Ti(1), START);  const Obj& X = mX;
+
+        ASSERT(1000 == X.numUnitsAvailable(START));
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int    LINE  = DATA[ti].d_line;
+            const Uint64 UNITS = DATA[ti].d_numUnits;
+            const bool   EXP   = DATA[ti].d_expected;
+            const Uint64 AVAIL = DATA[ti].d_available;
+
+            Ti now = START;
+            now.addMilliseconds(DATA[ti].d_offsetMs);
+
+            if (veryVerbose) { P_(LINE) P_(now) P_(UNITS) P(EXP) }
+
+            ASSERTV(LINE, EXP == mX.tryConsume(UNITS, now));
+            ASSERTV(LINE, X.numUnitsAvailable(now),
+                    AVAIL == X.numUnitsAvailable(now));
+        }
+      } break;
+      case 2: {
+        // --------------------------------------------------------------------
+        // TESTING CREATORS AND BASIC ACCESSORS
+        //
+        // Concerns:
+        //: 1 The constructor sets the rate and window, and computes the
+        //:   capacity as their product.
+        //:
+        //: 2 A newly created limiter is idle at the specified time.
+        //:
+        //: 3 The accessors are declared 'const'.
+        //:
+        //: 4 Precondition violations are detected when enabled.
+        //
+        // Plan:
+        //: 1 Create objects from a table of rates and windows and verify the
+        //:   accessors through a 'const' reference.  (C-1..3)
+        //:
+        //: 2 Verify that, in appropriate build modes, defensive checks are
+        //:   triggered for invalid attribute values.  (C-4)
+        //
+        // Testing:
+        //   ConcurrentRateLimiter(Uint64, const TimeInterval&, const TI&);
+        //   Uint64 capacity() const;
+        //   Uint64 rate() const;
+        //   TimeInterval window() const;
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "TESTING CREATORS AND BASIC ACCESSORS" << endl
+                          << "====================================" << endl;
+
+        static const struct {
+            int    d_line;
+            Uint64 d_rate;
+            double d_window;
+            Uint64 d_capacity;
+        } DATA[] = {
+            //LINE  RATE         WINDOW  CAPACITY
+            //----  -----------  ------  ----------
+            { L_,            1,   1.0,           1 },
+            { L_,         1000,   0.5,         500 },
+            { L_,         1024,  0.25,         256 },
+            { L_,   1000000000,   2.0,  2000000000 },
+        };
+        const int NUM_DATA = sizeof DATA / sizeof *DATA;
+
+        for (int ti = 0; ti < NUM_DATA; ++ti) {
+            const int    LINE     = DATA[ti].d_line;
+            const Uint64 RATE     = DATA[ti].d_rate;
+            const Ti     WINDOW(DATA[ti].d_window);
+            const Uint64 CAPACITY = DATA[ti].d_capacity;
+            const Ti     NOW(12345, 678);
+
+            const Obj X(RATE, WINDOW, NOW);
+
+            ASSERTV(LINE, RATE     == X.rate());
+            ASSERTV(LINE, WINDOW   == X.window());
+            ASSERTV(LINE, CAPACITY == X.capacity());
+            ASSERTV(LINE, CAPACITY == X.numUnitsAvailable(NOW));
+            ASSERTV(LINE, 0        == X.numUnitsAdmitted());
+            ASSERTV(LINE, 0        == X.numUnitsRejected());
+        }
+
+        if (verbose) cout << "\nNegative Testing." << endl;
+        {
+            bsls::AssertTestHandlerGuard hG;
+
+            ASSERT_PASS(Obj(1, Ti(1),   Ti()));
+            ASSERT_FAIL(Obj(0, Ti(1),   Ti()));
+            ASSERT_FAIL(Obj(1, Ti(0),   Ti()));
+        }
+      } break;
+      case 1: {
+        // --------------------------------------------------------------------
+        // BREATHING TEST
+        //   This case exercises (but does not fully test) basic functionality.
+        //
+        // Concerns:
+        //: 1 The class is sufficiently functional to enable comprehensive
+        //:   testing in subsequent test cases.
+        //
+        // Plan:
+        //: 1 Create an object, consume from it at several times, and verify
+        //:   the results.  (C-1)
+        //
+        // Testing:
+        //   BREATHING TEST
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl << "BREATHING TEST" << endl
+                                  << "==============" << endl;
+
+        Ti  currentTime(100, 0);
+        Obj x(1000, Ti(1), currentTime);
+
+        ASSERT(1000  == x.rate());
+        ASSERT(1000  == x.capacity());
+
+        ASSERT(true  == x.tryConsume(500, currentTime));
+        ASSERT(250   == x.tryConsumeUpTo(250, currentTime));
+        ASSERT(true  == x.tryConsume(250, currentTime));
+        ASSERT(false == x.tryConsume(1, currentTime));
+        ASSERT(Ti(0, 1000000) == x.calculateTimeToSubmit(1, currentTime));
+
+        currentTime.addMilliseconds(500);
+        ASSERT(500   == x.numUnitsAvailable(currentTime));
+        ASSERT(true  == x.tryConsume(500, currentTime));
+        ASSERT(1500  == x.numUnitsAdmitted());
+        ASSERT(1     == x.numUnitsRejected());
+      } break;
+      case -1: {
+        // --------------------------------------------------------------------
+        // PERFORMANCE: COMPARISON WITH MUTEX-GUARDED 'btls::RateLimiter'
+        //
+        // Concerns:
+        //: 1 Under contention, 'tryConsume' is cheaper than the equivalent
+        //:   operation on a 'btls::RateLimiter' guarded by a mutex.
+        //
+        // Plan:
+        //: 1 For an increasing number of threads, time a fixed number of
+        //:   single-unit consumptions per thread against each limiter, using
+        //:   a rate high enough that most requests are admitted, and report
+        //:   the elapsed wall time.  (C-1)
+        //
+        // Testing:
+        //   PERFORMANCE: COMPARISON WITH MUTEX-GUARDED 'btls::RateLimiter'
+        // --------------------------------------------------------------------
+
+        if (verbose) cout << endl
+                          << "PERFORMANCE: COMPARISON WITH MUTEX-GUARDED "
+                          << "'btls::RateLimiter'" << endl
+                          << "==========================================="
+                          << "===================" << endl;
+
+        using namespace PERFORMANCE_TEST;
+
+        const int NUM_ITERATIONS = argc > 2 ? atoi(argv[2]) : 1000000;
+        const int MAX_THREADS    = 8;
+
+        for (int numThreads = 1; numThreads <= MAX_THREADS; numThreads *= 2) {
+            const Uint64 RATE = 1000000000;
+
+            bsl::vector<bslmt::ThreadUtil::Handle> handles(numThreads);
+
+            double lockFreeTime;
+            {
+                Obj            limiter(RATE, Ti(1), bdlt::CurrentTime::now());
+                bslmt::Barrier barrier(numThreads + 1);
+
+                for (int i = 0; i < numThreads; ++i) {
+                    bslmt::ThreadUtil::create(
+                                         &handles[i],
+                                         bdlf::BindUtil::bind(&consumeLockFree,
+                                                              &limiter,
+                                                              &barrier,
+                                                              NUM_ITERATIONS));
+                }
+                bsls::Stopwatch timer;
+                timer.start();
+                barrier.wait();
+                for (int i = 0; i < numThreads; ++i) {
+                    bslmt::ThreadUtil::join(handles[i]);
+                }
+                lockFreeTime = timer.elapsedTime();
+            }
+
+            double lockedTime;
+            {
+                btls::RateLimiter limiter(RATE,
+                                          Ti(1),
+                                          RATE,
+                                          Ti(1),
+                                          bdlt::CurrentTime::now());
+                bslmt::Mutex      mutex;
+                bslmt::Barrier    barrier(numThreads + 1);
+
+                for (int i = 0; i < numThreads; ++i) {
+                    bslmt::ThreadUtil::create(
+                                           &handles[i],
+                                           bdlf::BindUtil::bind(&consumeLocked,
+                                                                &limiter,
+                                                                &mutex,
+                                                                &barrier,
+                                                              NUM_ITERATIONS));
+                }
+                bsls::Stopwatch timer;
+                timer.start();
+                barrier.wait();
+                for (int i = 0; i < numThreads; ++i) {
+                    bslmt::ThreadUtil::join(handles[i]);
+                }
+                lockedTime = timer.elapsedTime();
+            }
+
+            cout << "threads: "     << numThreads
+                 << "\tlock-free: " << lockFreeTime << "s"
+                 << "\tmutex: "     << lockedTime   << "s" << endl;
+        }
+      } break;
+      default: {
+        cerr << "WARNING: CASE `" << test << "' NOT FOUND." << endl;
+        testStatus = -1;
+      }
+    }
+
+    if (testStatus > 0) {
+        cerr << "Error, non-zero test status = " << testStatus << "." << endl;
+    }
+
+    return testStatus;
+}
+
+// ----------------------------------------------------------------------------
+// Copyright 2016 Bloomberg Finance L.P.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+// ----------------------------- END-OF-FILE ----------------------------------